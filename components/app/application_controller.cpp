@@ -3,14 +3,20 @@
 #include "app/init_phase.hpp"
 #include "app/init_phases.hpp"
 #include "app/boot_failure_tracker.hpp"
+#include "app/ota_update.hpp"
 
 #include "audio_subsystem/audio_subsystem.hpp"
 #include "wifi_subsystem/wifi_subsystem.hpp"
 #include "ui/http_server.hpp"
-#include "morse_decoder/adaptive_timing_classifier.hpp"
-#include "morse_decoder/morse_decoder.hpp"
+#include "morse_decoder/decoder_service.hpp"
+#include "timeline/timeline_archive.hpp"
 #include "timeline/timeline_event_emitter.hpp"
 #include "text_keyer/text_keyer.hpp"
+#include "ui/serial_console.hpp"
+#include "usb_hid/hid_keyer_port.hpp"
+#include "winkeyer/winkeyer_port.hpp"
+#include "system_monitor/alloc_profiler.hpp"
+#include "system_monitor/task_topology.hpp"
 #include "driver/uart.h"
 #include "esp_err.h"
 #include "esp_log.h"
@@ -164,7 +170,7 @@ bool ApplicationController::Initialize() {
 
   // Phase 6-7: Diagnostics and USB initialization
   pipeline.AddPhase(std::make_unique<DiagnosticsSubsystemPhase>(&diagnostics_subsystem_, device_config_));
-  pipeline.AddPhase(std::make_unique<UsbEarlyInitPhase>(diagnostics_subsystem_.get()));
+  pipeline.AddPhase(std::make_unique<UsbEarlyInitPhase>(diagnostics_subsystem_.get(), device_config_));
 
   // Phase 8: Create subsystem instances
   pipeline.AddPhase(std::make_unique<SubsystemCreationPhase>(this));
@@ -175,15 +181,19 @@ bool ApplicationController::Initialize() {
   pipeline.AddPhase(std::make_unique<KeyingSubsystemPhase>(keying_subsystem_, device_config_));
   pipeline.AddPhase(std::make_unique<TxHalPhase>(tx_hal_, device_config_));
   pipeline.AddPhase(std::make_unique<PaddleHalPhase>(paddle_hal_, device_config_, this));
+  pipeline.AddPhase(std::make_unique<So2rHalPhase>(this));
   pipeline.AddPhase(std::make_unique<AudioSubsystemPhase>(audio_subsystem_, device_config_));
 
   // Phase 13: Wire subsystem dependencies
   pipeline.AddPhase(std::make_unique<SubsystemWiringPhase>(this));
+  pipeline.AddPhase(std::make_unique<TimelineArchivePhase>(this));
 
   // Phase 14-15.5: Network services
   pipeline.AddPhase(std::make_unique<WiFiSubsystemPhase>(wifi_subsystem_, device_config_, diagnostics_subsystem_.get()));
-  pipeline.AddPhase(std::make_unique<RemoteClientPhase>(remote_client_, device_config_, keying_subsystem_));
-  pipeline.AddPhase(std::make_unique<RemoteServerPhase>(remote_server_, device_config_, tx_hal_.get()));
+  pipeline.AddPhase(std::make_unique<RemoteClientPhase>(remote_client_, device_config_, keying_subsystem_,
+                                                       decoder_service_));
+  pipeline.AddPhase(std::make_unique<RemoteServerPhase>(remote_server_, device_config_, tx_hal_.get(),
+                                                       decoder_service_));
 
   // Phase 16-18: Web UI, Captive Portal, and Console
   pipeline.AddPhase(std::make_unique<HttpServerPhase>(http_server_, &device_config_, wifi_subsystem_, &config_storage_, &param_registry_, this));
@@ -205,6 +215,9 @@ bool ApplicationController::Initialize() {
   // This prevents entering safe mode on next boot if this boot succeeds
   ClearBootFailureCount();
 
+  // Same criterion for a freshly installed OTA image: keep it (cancel rollback)
+  ConfirmRunningFirmware();
+
   ESP_LOGI(kLogTag, "Initialization complete");
   return success;
 }
@@ -244,6 +257,15 @@ esp_err_t ApplicationController::ConfigureWatchdog() {
 void ApplicationController::Run() {
   ESP_LOGI(kLogTag, "Entering main loop");
 
+  // app_main runs at priority 1: raise the keying loop to its table priority, then
+  // check every task started so far against the topology table
+  vTaskPrioritySet(nullptr, system_monitor::TaskSpecFor(system_monitor::TaskId::kMainLoop).priority);
+  system_monitor::AuditTaskPlacement();
+
+  if (keying_subsystem_) {
+    keying_subsystem_->SetWakeTask(xTaskGetCurrentTaskHandle());
+  }
+
   ESP_LOGI(kLogTag, "PROFILING MODE ENABLED - Logging subsystem timing every 5 seconds");
 
   // Profiling variables
@@ -256,29 +278,67 @@ void ApplicationController::Run() {
   static int64_t total_diagnostics_us = 0;
   static int64_t total_loop_us = 0;
 
+  keying::DeadlineMonitor& deadline_monitor = keying_subsystem_->GetDeadlineMonitor();
+
   while (true) {
     const int64_t loop_start_us = esp_timer_get_time();
+    deadline_monitor.BeginLoop(loop_start_us);
 
 #ifdef PADDLE_USE_POLLING
     // Polling mode: Read GPIO pins and generate events for detected edges
     if (paddle_hal_) {
       paddle_hal_->Poll();
     }
+    for (auto& so2r_paddle : so2r_paddle_hals_) {
+      if (so2r_paddle) {
+        so2r_paddle->Poll();
+      }
+    }
 #endif
 
     // Drain paddle events and update keying engine
+    // Each stage charges its heap allocations to its subsystem (heap trace);
+    // allocations in the keying stages are flagged
     const int64_t t0 = esp_timer_get_time();
-    keying_subsystem_->DrainPaddleEvents();
+    {
+      const system_monitor::AllocScope alloc_scope(system_monitor::AllocTag::kKeying);
+      keying_subsystem_->DrainPaddleEvents();
+    }
     const int64_t t1 = esp_timer_get_time();
 
     const int64_t now_us = hal::HighPrecisionClock::NowMicros();
-    keying_subsystem_->Tick(now_us);
+    {
+      const system_monitor::AllocScope alloc_scope(system_monitor::AllocTag::kKeying);
+      keying_subsystem_->Tick(now_us);
+    }
     const int64_t t2 = esp_timer_get_time();
 
     // Monitor WiFi connection state (Task 5.4.0.7)
     const int64_t t3 = esp_timer_get_time();
     if (wifi_subsystem_) {
+      const system_monitor::AllocScope alloc_scope(system_monitor::AllocTag::kWifi);
       const uint32_t now_ms = static_cast<uint32_t>(now_us / 1000);
+      // Keep the radio on-channel while a remote keying session is up
+      const bool client_session =
+          remote_client_ && remote_client_->GetState() == remote::RemoteCwClientState::kConnected;
+      const bool server_session =
+          remote_server_ && remote_server_->state() == remote::RemoteCwServerState::kConnected;
+      wifi_subsystem_->SetScanSuppressed(client_session || server_session);
+
+      // Low-latency link profile: sockets pick it up at their next connect, the
+      // radio drops power-save only while a session using it is connected
+      const remote::LinkProfile profile = device_config_.remote.low_latency
+                                              ? remote::LinkProfile::kLowLatency
+                                              : remote::LinkProfile::kDefault;
+      if (remote_client_) {
+        remote_client_->SetLinkProfile(profile);
+      }
+      if (remote_server_) {
+        remote_server_->SetLinkProfile(profile);
+      }
+      wifi_subsystem_->SetLowLatency(
+          (client_session && remote_client_->GetSessionProfile() == remote::LinkProfile::kLowLatency) ||
+          (server_session && remote_server_->session_profile() == remote::LinkProfile::kLowLatency));
       wifi_subsystem_->Tick(now_ms);
 
       // Dynamically enable/disable captive portal based on WiFi mode and client count
@@ -318,31 +378,54 @@ void ApplicationController::Run() {
     // See: docs/plans/2025-11-15-remotecw-task-architecture-design.md
 
     // Tick remote CW server (accept connections, RX/TX I/O, PTT management)
-#ifdef CONFIG_ENABLE_MAIN_LOOP_PROFILING
     const int64_t t5 = esp_timer_get_time();
-#endif
     if (remote_server_) {
+      const system_monitor::AllocScope alloc_scope(system_monitor::AllocTag::kRemote);
       remote_server_->Tick(now_us);
     }
-#ifdef CONFIG_ENABLE_MAIN_LOOP_PROFILING
     const int64_t t6 = esp_timer_get_time();
-#endif
 
     // Tick text keyer (keyboard morse code sending state machine)
     if (text_keyer_) {
+      const system_monitor::AllocScope alloc_scope(system_monitor::AllocTag::kTextKeyer);
       text_keyer_->Tick(now_us);
     }
 
+    const int64_t t_text = esp_timer_get_time();
+
+    // WinKeyer on the console port: the console steps aside while it is enabled
+    if (winkeyer_port_) {
+      const system_monitor::AllocScope alloc_scope(system_monitor::AllocTag::kWinKeyer);
+      const bool winkeyer = device_config_.general.winkeyer;
+      if (winkeyer != winkeyer_port_->enabled()) {
+        if (serial_console_) {
+          serial_console_->SetPortReleased(winkeyer);
+        }
+        winkeyer_port_->SetEnabled(winkeyer, now_us);
+      }
+      winkeyer_port_->Tick(now_us, static_cast<uint8_t>(device_config_.keying.speed_wpm));
+    }
+
     // Update diagnostics (LED animations)
-#ifdef CONFIG_ENABLE_MAIN_LOOP_PROFILING
     const int64_t t7 = esp_timer_get_time();
-#endif
     if (diagnostics_subsystem_) {
+      const system_monitor::AllocScope alloc_scope(system_monitor::AllocTag::kDiagnostics);
       diagnostics_subsystem_->Tick();
     }
-#ifdef CONFIG_ENABLE_MAIN_LOOP_PROFILING
     const int64_t t8 = esp_timer_get_time();
 
+    // Stage timings of this iteration: a deadline miss carries the last one
+    uint32_t stage_us[keying::kLoopStageCount];
+    stage_us[static_cast<size_t>(keying::LoopStage::kPaddles)] = static_cast<uint32_t>(t1 - t0);
+    stage_us[static_cast<size_t>(keying::LoopStage::kKeying)] = static_cast<uint32_t>(t2 - t1);
+    stage_us[static_cast<size_t>(keying::LoopStage::kWifi)] = static_cast<uint32_t>(t4 - t3);
+    stage_us[static_cast<size_t>(keying::LoopStage::kRemoteServer)] = static_cast<uint32_t>(t6 - t5);
+    stage_us[static_cast<size_t>(keying::LoopStage::kTextKeyer)] = static_cast<uint32_t>(t_text - t6);
+    stage_us[static_cast<size_t>(keying::LoopStage::kWinKeyer)] = static_cast<uint32_t>(t7 - t_text);
+    stage_us[static_cast<size_t>(keying::LoopStage::kDiagnostics)] = static_cast<uint32_t>(t8 - t7);
+    deadline_monitor.EndLoop(t8, stage_us);
+
+#ifdef CONFIG_ENABLE_MAIN_LOOP_PROFILING
     const int64_t loop_end_us = esp_timer_get_time();
 
     // Accumulate timing statistics
@@ -401,7 +484,9 @@ void ApplicationController::Run() {
     // NOTE: Watchdog monitoring delegated to system IDLE tasks (CONFIG_ESP_TASK_WDT_INIT=y)
     // Main task no longer registered to avoid false triggers when serial_console busy
 
-    vTaskDelay(pdMS_TO_TICKS(kMainLoopDelayMs));
+    // Same 1 ms cadence as vTaskDelay(), but a manual key edge wakes the loop early
+    // (KeyingSubsystem::SetWakeTask) so the straight key bypasses the tick latency
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(kMainLoopDelayMs));
   }
 }
 
@@ -423,11 +508,14 @@ void ApplicationController::ApplyConfigChanges(const config::DeviceConfig& new_c
     diagnostics_subsystem_->ApplyConfig(new_config);
   }
 
-  // Apply decoder enabled state (can be toggled at runtime)
-  if (morse_decoder_) {
-    morse_decoder_->SetEnabled(new_config.keying.decoder_enabled);
+  // Apply decoder enabled state (can be toggled at runtime, all key streams)
+  if (decoder_service_) {
+    decoder_service_->SetEnabled(new_config.keying.decoder_enabled);
     ESP_LOGI("app", "Decoder %s from config update",
              new_config.keying.decoder_enabled ? "enabled" : "disabled");
+    decoder_service_->SetDecodingMode(new_config.keying.decoder_beam_search
+                                          ? morse_decoder::DecodingMode::kBeam
+                                          : morse_decoder::DecodingMode::kGreedy);
   }
 
   // Update internal config reference
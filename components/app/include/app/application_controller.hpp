@@ -54,6 +54,7 @@ class RemoteCwServer;
 
 namespace timeline {
 class TimelineEventEmitter;
+class TimelineArchive;
 }  // namespace timeline
 
 namespace text_keyer {
@@ -64,6 +65,14 @@ namespace captive_portal {
 class CaptivePortalManager;
 }  // namespace captive_portal
 
+namespace winkeyer {
+class WinKeyerPort;
+}  // namespace winkeyer
+
+namespace usb_hid {
+class HidKeyerPort;
+}  // namespace usb_hid
+
 namespace app {
 
 /**
@@ -158,6 +167,12 @@ class ApplicationController {
     return nullptr;
   }
 
+  /**
+   * @brief Get multi-stream decoder service (local + remote key streams).
+   * @return Pointer to DecoderService, or nullptr if not initialized.
+   */
+  morse_decoder::DecoderService* GetDecoderService() const { return decoder_service_.get(); }
+
   /**
    * @brief Get keying subsystem instance (for timeline API, Web UI).
    * @return Pointer to KeyingSubsystem, or nullptr if not initialized.
@@ -174,6 +189,14 @@ class ApplicationController {
     return timeline_emitter_.get();
   }
 
+  /**
+   * @brief Get flash timeline archive (general.timeline_archive).
+   * @return Pointer to TimelineArchive, or nullptr if disabled or no partition.
+   */
+  timeline::TimelineArchive* GetTimelineArchive() const {
+    return timeline_archive_.get();
+  }
+
   /**
    * @brief Get text keyer instance (for Web UI control).
    * @return Pointer to TextKeyer, or nullptr if not initialized.
@@ -198,6 +221,8 @@ class ApplicationController {
   friend class SubsystemCreationPhase;
   friend class SubsystemWiringPhase;
   friend class PaddleHalPhase;
+  friend class So2rHalPhase;
+  friend class TimelineArchivePhase;
   friend class RemoteClientPhase;
   friend class RemoteServerPhase;
 
@@ -226,6 +251,10 @@ class ApplicationController {
   std::unique_ptr<hal::PaddleHal> paddle_hal_;
   std::unique_ptr<hal::TxHal> tx_hal_;  // TX key output HAL
 
+  // SO2R radios 2..N (index 0 = radio 2); created only when so2r.channel_count > 1
+  std::unique_ptr<hal::TxHal> so2r_tx_hals_[config::kMaxKeyingChannels - 1];
+  std::unique_ptr<hal::PaddleHal> so2r_paddle_hals_[config::kMaxKeyingChannels - 1];
+
   // Functional subsystems
   std::unique_ptr<keying_subsystem::KeyingSubsystem> keying_subsystem_;
   std::unique_ptr<audio_subsystem::AudioSubsystem> audio_subsystem_;
@@ -236,16 +265,25 @@ class ApplicationController {
   std::unique_ptr<ui::HttpServer> http_server_;
   std::unique_ptr<ui::SerialConsole> serial_console_;
 
-  // Morse decoder subsystem (Phase 2 - integrated with KeyingSubsystem)
-  std::unique_ptr<morse_decoder::AdaptiveTimingClassifier> timing_classifier_;
-  std::unique_ptr<morse_decoder::MorseDecoder> morse_decoder_;
+  // Morse decoder service: classifier + decoder per key stream (local, remote client,
+  // remote server). The local stream is fed by KeyingSubsystem.
+  std::unique_ptr<morse_decoder::DecoderService> decoder_service_;
 
   // Timeline event emitter (real-time visualization and diagnostics)
   std::unique_ptr<timeline::TimelineEventEmitter> timeline_emitter_;
 
+  // Long-term timeline history in flash (optional, see timeline/timeline_archive.hpp)
+  std::unique_ptr<timeline::TimelineArchive> timeline_archive_;
+
   // Text keyer (keyboard morse code sending)
   std::unique_ptr<text_keyer::TextKeyer> text_keyer_;
 
+  // WinKeyer protocol on the console port (general.winkeyer)
+  std::unique_ptr<winkeyer::WinKeyerPort> winkeyer_port_;
+
+  // USB HID keyboard mirroring paddles or keyed output (general.usb_hid, boot-time)
+  std::unique_ptr<usb_hid::HidKeyerPort> usb_hid_keyer_;
+
   // Captive portal manager (WiFi setup in AP mode)
   std::unique_ptr<captive_portal::CaptivePortalManager> captive_portal_manager_;
 };
@@ -283,12 +283,14 @@ class DiagnosticsSubsystemPhase : public InitPhase {
  *
  * NON-CRITICAL: Logs warning on failure (UART debug still available).
  * LED SIGNAL: White LEDs for 1 second (gives user time to open COM port).
- * DEPENDS ON: DiagnosticsSubsystemPhase (for LED signal).
+ * DEPENDS ON: DiagnosticsSubsystemPhase (for LED signal), ConfigStoragePhase
+ *             (general.usb_hid adds the HID keyboard interface).
  */
 class UsbEarlyInitPhase : public InitPhase {
  public:
-  explicit UsbEarlyInitPhase(diagnostics_subsystem::DiagnosticsSubsystem* diagnostics)
-      : diagnostics_(diagnostics) {}
+  UsbEarlyInitPhase(diagnostics_subsystem::DiagnosticsSubsystem* diagnostics,
+                    const config::DeviceConfig& config)
+      : diagnostics_(diagnostics), config_(config) {}
 
   esp_err_t Execute() override;
   const char* GetName() const override { return "USB Early Init"; }
@@ -296,6 +298,7 @@ class UsbEarlyInitPhase : public InitPhase {
 
  private:
   diagnostics_subsystem::DiagnosticsSubsystem* diagnostics_;
+  const config::DeviceConfig& config_;  // general.usb_hid selects the descriptor
 };
 
 //=============================================================================
@@ -346,6 +349,30 @@ class PaddleHalPhase : public InitPhase {
   void* callback_context_;
 };
 
+//=============================================================================
+// Phase 9.5: SO2R channel HALs
+//=============================================================================
+/**
+ * @brief Initialize TX outputs and dedicated paddles of radios 2..N (so2r.*).
+ *
+ * All extra paddle HALs report through the same RecordPaddleEvent() callback and
+ * ISR queue as the main paddle; PaddleHalConfig::channel tags their events.
+ *
+ * NON-CRITICAL: Logs warning on failure (radio 1 keeps working).
+ * DEPENDS ON: KeyingSubsystemPhase (queue), ConfigStoragePhase (so2r GPIOs).
+ */
+class So2rHalPhase : public InitPhase {
+ public:
+  explicit So2rHalPhase(ApplicationController* controller) : controller_(controller) {}
+
+  esp_err_t Execute() override;
+  const char* GetName() const override { return "SO2R HAL"; }
+  bool IsCritical() const override { return false; }
+
+ private:
+  ApplicationController* controller_;
+};
+
 //=============================================================================
 // Phase 10: TX HAL
 //=============================================================================
@@ -441,6 +468,28 @@ class SubsystemWiringPhase : public InitPhase {
   ApplicationController* controller_;
 };
 
+//=============================================================================
+// Phase 13.5: Timeline Archive
+//=============================================================================
+/**
+ * @brief Start the flash timeline archive when general.timeline_archive is set.
+ *
+ * NON-CRITICAL: Logs warning on failure (no "timeline" partition, out of memory);
+ * the RAM timeline keeps working.
+ * DEPENDS ON: KeyingSubsystemPhase (timeline logger).
+ */
+class TimelineArchivePhase : public InitPhase {
+ public:
+  explicit TimelineArchivePhase(ApplicationController* controller) : controller_(controller) {}
+
+  esp_err_t Execute() override;
+  const char* GetName() const override { return "Timeline Archive"; }
+  bool IsCritical() const override { return false; }
+
+ private:
+  ApplicationController* controller_;
+};
+
 //=============================================================================
 // Phase 14: WiFi Subsystem
 //=============================================================================
@@ -482,8 +531,9 @@ class RemoteClientPhase : public InitPhase {
  public:
   RemoteClientPhase(std::unique_ptr<remote::RemoteCwClient>& client,
                     const config::DeviceConfig& config,
-                    std::unique_ptr<keying_subsystem::KeyingSubsystem>& keying)
-      : client_(client), config_(config), keying_(keying) {}
+                    std::unique_ptr<keying_subsystem::KeyingSubsystem>& keying,
+                    std::unique_ptr<morse_decoder::DecoderService>& decoder_service)
+      : client_(client), config_(config), keying_(keying), decoder_service_(decoder_service) {}
 
   esp_err_t Execute() override;
   const char* GetName() const override { return "Remote CW Client"; }
@@ -493,6 +543,7 @@ class RemoteClientPhase : public InitPhase {
   std::unique_ptr<remote::RemoteCwClient>& client_;
   const config::DeviceConfig& config_;
   std::unique_ptr<keying_subsystem::KeyingSubsystem>& keying_;
+  std::unique_ptr<morse_decoder::DecoderService>& decoder_service_;
 };
 
 //=============================================================================
@@ -509,8 +560,9 @@ class RemoteServerPhase : public InitPhase {
  public:
   RemoteServerPhase(std::unique_ptr<remote::RemoteCwServer>& server,
                     const config::DeviceConfig& config,
-                    hal::TxHal* tx_hal)
-      : server_(server), config_(config), tx_hal_(tx_hal) {}
+                    hal::TxHal* tx_hal,
+                    std::unique_ptr<morse_decoder::DecoderService>& decoder_service)
+      : server_(server), config_(config), tx_hal_(tx_hal), decoder_service_(decoder_service) {}
 
   esp_err_t Execute() override;
   const char* GetName() const override { return "Remote CW Server"; }
@@ -520,6 +572,7 @@ class RemoteServerPhase : public InitPhase {
   std::unique_ptr<remote::RemoteCwServer>& server_;
   const config::DeviceConfig& config_;
   hal::TxHal* tx_hal_;
+  std::unique_ptr<morse_decoder::DecoderService>& decoder_service_;
 };
 
 //=============================================================================
@@ -0,0 +1,110 @@
+#pragma once
+
+/**
+ * @file ota_update.hpp
+ * @brief Streaming firmware update into the inactive OTA partition
+ *
+ * The image arrives as a byte stream (HTTP request body) and is written to flash in
+ * kOtaChunkSize pieces through two buffers: while the writer task programs one chunk
+ * the caller is already receiving the next, so network and flash time overlap. RAM
+ * cost is fixed (two chunks, two small queues, one task stack) whatever the image
+ * size; the image is never held in memory.
+ *
+ * VERIFICATION:
+ * - SHA-256 of the received bytes is computed on the fly and compared with the
+ *   expected digest (when given) before the new partition is made bootable
+ * - esp_ota_end() additionally checks the ESP-IDF image header and checksum
+ *
+ * ROLLBACK (CONFIG_BOOTLOADER_APP_ROLLBACK_ENABLE):
+ * - A freshly written image boots in ESP_OTA_IMG_PENDING_VERIFY state
+ * - ConfirmRunningFirmware() marks it valid; it is called next to
+ *   ClearBootFailureCount() once init succeeds
+ * - If init never gets there, the reset rolls back to the previous image; a pending
+ *   image that reaches the bootloop threshold is rolled back explicitly by
+ *   RollbackPendingFirmware() instead of entering the UF2 bootloader
+ *
+ * PARTITION TABLE:
+ * - Requires two app slots (ota_0/ota_1). With a single app slot there is no
+ *   inactive partition and StreamFirmwareUpdate() fails with ESP_ERR_NOT_FOUND
+ *   (use the UF2 bootloader in that case)
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include "esp_err.h"
+
+namespace app {
+
+/// Flash write unit: one 4 KB sector, erased just ahead of the write
+constexpr size_t kOtaChunkSize = 4096;
+
+/// Receive/flash double buffering
+constexpr size_t kOtaBufferCount = 2;
+
+/**
+ * @brief Read callback feeding the image stream
+ *
+ * @return Bytes read (> 0), or <= 0 on error / premature end of stream
+ */
+using OtaReadFn = int (*)(void* context, char* buffer, size_t length);
+
+/**
+ * @brief Outcome and statistics of one update attempt
+ */
+struct OtaResult {
+  esp_err_t error = ESP_OK;
+  const char* message = "";           ///< Human-readable status (static string)
+  const char* partition = "";         ///< Target partition label
+  size_t bytes_written = 0;
+  uint32_t duration_ms = 0;
+  uint32_t throughput_kbps = 0;       ///< KB/s over the whole transfer
+  size_t heap_peak_bytes = 0;         ///< Peak heap used by the update (buffers included)
+  char sha256_hex[65] = {};           ///< Digest of the received image (lowercase hex)
+};
+
+/**
+ * @brief Stream an image into the inactive OTA partition
+ *
+ * On success the new partition is set as boot partition; the caller decides when to
+ * restart. On any failure the partially written partition is abandoned and the boot
+ * partition is unchanged.
+ *
+ * @param image_size Total image size in bytes (e.g. HTTP Content-Length)
+ * @param expected_sha256_hex Expected digest (64 hex chars) or nullptr to skip the check
+ * @param read Stream source
+ * @param read_context Passed through to read
+ * @return Result; error is ESP_ERR_INVALID_STATE if an update is already running
+ *
+ * Thread safety: Safe to call from any task; concurrent calls are rejected
+ */
+OtaResult StreamFirmwareUpdate(size_t image_size, const char* expected_sha256_hex,
+                               OtaReadFn read, void* read_context);
+
+/**
+ * @brief Check if an update is currently being streamed
+ */
+bool IsFirmwareUpdateInProgress();
+
+/**
+ * @brief Check if the running image was just installed and awaits confirmation
+ */
+bool IsRunningFirmwarePendingVerify();
+
+/**
+ * @brief Mark the running image valid, cancelling a pending rollback
+ *
+ * No-op when the running image is not pending verification.
+ */
+void ConfirmRunningFirmware();
+
+/**
+ * @brief Roll back a pending image to the previous one and restart
+ *
+ * Returns (without restarting) when there is nothing to roll back to.
+ *
+ * @param before_restart Called only when the rollback restart is issued
+ */
+void RollbackPendingFirmware(void (*before_restart)() = nullptr);
+
+}  // namespace app
@@ -9,8 +9,18 @@ extern "C" {
 /**
  * Initialize USB early (right after NVS) to avoid conflicts
  * Based on working example from tmp/
+ * @param hid_keyboard Add the HID keyboard interface (general.usb_hid != 0);
+ *        the configuration then has one CDC port (console) instead of two
  */
-esp_err_t usb_early_init();
+esp_err_t usb_early_init(bool hid_keyboard);
+
+/**
+ * CDC port carrying the console and the WinKeyer
+ * 1 (CDC1, COM7) normally; 0 when usb_early_init() added the HID keyboard,
+ * whose configuration has a single CDC port and keeps ESP_LOG on UART1
+ * @return tinyusb_cdcacm_itf_t value
+ */
+int usb_service_cdc_port(void);
 
 /**
  * Check if a CDC port has terminal connected (DTR+RTS from callback)
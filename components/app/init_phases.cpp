@@ -11,6 +11,7 @@
 #include "app/init_phases.hpp"
 #include "app/bootloader_entry.hpp"
 #include "app/boot_failure_tracker.hpp"
+#include "app/ota_update.hpp"
 
 // ESP-IDF includes
 #include "driver/uart.h"
@@ -25,13 +26,15 @@
 #include "hal/high_precision_clock.hpp"
 #include "ui/console_parameter_bridge.hpp"
 #include "ui/console_system_commands.hpp"
-#include "morse_decoder/adaptive_timing_classifier.hpp"
-#include "morse_decoder/morse_decoder.hpp"
+#include "morse_decoder/decoder_service.hpp"
+#include "timeline/timeline_archive.hpp"
 #include "timeline/timeline_event_emitter.hpp"
 #include "text_keyer/text_keyer.hpp"
+#include "usb_hid/hid_keyer_port.hpp"
+#include "winkeyer/winkeyer_port.hpp"
 
-// Forward declare usb_early_init() from usb_early_init.cpp
-extern "C" esp_err_t usb_early_init();
+// usb_early_init() and usb_service_cdc_port() from usb_early_init.cpp
+#include "app/usb_early_init.hpp"
 
 // Forward declare RegisterAllParameters() from parameter_registry.cpp
 namespace config {
@@ -43,6 +46,13 @@ namespace app {
 namespace {
 constexpr const char* kLogTag = "init_phases";
 constexpr uint32_t kWatchdogTimeoutMs = 20000;  // 20 seconds (from application_controller.cpp)
+
+// Consumers of keying received by RemoteCwServer (callback context, lives forever)
+struct ServerKeyingTargets {
+  hal::TxHal* tx_hal = nullptr;
+  morse_decoder::DecoderService* decoder_service = nullptr;
+};
+ServerKeyingTargets g_server_keying_targets;
 }
 
 //=============================================================================
@@ -92,6 +102,12 @@ esp_err_t BootFailureCheckPhase::Execute() {
 
   // Check if bootloop detected (threshold reached)
   if (IsBootloopDetected()) {
+    // A freshly installed OTA image that keeps failing goes back to the previous
+    // image rather than to the UF2 bootloader. The counter is cleared only when the
+    // rollback restart is issued, so the previous image starts fresh; with nothing
+    // to roll back to this returns and the bootloop state is kept
+    RollbackPendingFirmware(&ClearBootFailureCount);
+
     // CRITICAL: Bootloop detected - enter safe mode
     // At this point, we can't log yet (UART not initialized), so we rely on
     // the log messages in IncrementBootFailureCount() after UART init in next phase
@@ -257,7 +273,7 @@ esp_err_t UsbEarlyInitPhase::Execute() {
   }
 
   // Early USB initialization (after LED signal)
-  esp_err_t err = usb_early_init();
+  esp_err_t err = usb_early_init(config_.general.usb_hid != 0);
   if (err != ESP_OK) {
     ESP_LOGW(kLogTag, "Early USB init failed: %s (continuing)", esp_err_to_name(err));
   }
@@ -281,16 +297,18 @@ esp_err_t SubsystemCreationPhase::Execute() {
   controller_->remote_client_ = std::make_unique<remote::RemoteCwClient>();
   controller_->remote_server_ = std::make_unique<remote::RemoteCwServer>();
 
-  // Create morse decoder subsystem (Phase 2 - adaptive timing + decoding)
-  controller_->timing_classifier_ = std::make_unique<morse_decoder::AdaptiveTimingClassifier>(
-      25.0f);  // 25% timing tolerance (from config)
+  // Create morse decoder service: independent classifier + decoder per key stream
+  // (local keying, remote client RX, remote server TX)
+  morse_decoder::DecoderServiceConfig decoder_config{};
+  decoder_config.tolerance_percent = 25.0f;   // 25% timing tolerance (from config)
+  decoder_config.local_buffer_size = 100;     // Default buffer size
+  decoder_config.remote_buffer_size = 100;
+  decoder_config.enable_logging = false;      // Disable verbose logging by default
+  decoder_config.mode = controller_->device_config_.keying.decoder_beam_search
+                            ? morse_decoder::DecodingMode::kBeam
+                            : morse_decoder::DecodingMode::kGreedy;
 
-  morse_decoder::MorseDecoderConfig decoder_config{};
-  decoder_config.buffer_size = 100;              // Default buffer size
-  decoder_config.enable_logging = false;         // Disable verbose logging by default
-  decoder_config.timing_classifier = controller_->timing_classifier_.get();
-
-  controller_->morse_decoder_ = std::make_unique<morse_decoder::MorseDecoder>(decoder_config);
+  controller_->decoder_service_ = std::make_unique<morse_decoder::DecoderService>(decoder_config);
 
   // Create TimelineEventEmitter for real-time visualization
   auto& timeline = controller_->keying_subsystem_->GetTimeline();
@@ -305,6 +323,28 @@ esp_err_t SubsystemCreationPhase::Execute() {
   controller_->text_keyer_ = std::make_unique<text_keyer::TextKeyer>();
   ESP_LOGI(kLogTag, "Text keyer created");
 
+  // WinKeyer emulation: edges go out through the keying subsystem like a paddle memory
+  keying_subsystem::KeyingSubsystem* keying = controller_->keying_subsystem_.get();
+  // Same CDC port as the console, fixed by UsbEarlyInitPhase
+  controller_->winkeyer_port_ = std::make_unique<winkeyer::WinKeyerPort>(
+      usb_service_cdc_port(), [keying](bool key_active, int64_t timestamp_us) { keying->OutputHostKeyEdge(key_active, timestamp_us); });
+  keying->SetBreakIn(&winkeyer::WinKeyerPort::BreakIn, controller_->winkeyer_port_.get());
+
+  // USB HID keyboard output: the interface was added by UsbEarlyInitPhase from the same
+  // boot-time setting. Taps go in before PaddleHalPhase enables the paddle ISR.
+  const auto hid_mode = static_cast<usb_hid::HidKeyerMode>(controller_->device_config_.general.usb_hid);
+  if (hid_mode != usb_hid::HidKeyerMode::kOff) {
+    auto hid_port = std::make_unique<usb_hid::HidKeyerPort>(hid_mode);
+    if (hid_port->Start() == ESP_OK) {
+      keying->SetPaddleTap(&usb_hid::HidKeyerPort::PaddleTapFromIsr, hid_port.get());
+      keying->SetKeyTap(&usb_hid::HidKeyerPort::KeyTap, hid_port.get());
+      controller_->usb_hid_keyer_ = std::move(hid_port);
+      ui::SetUsbHidKeyer(controller_->usb_hid_keyer_.get());
+    } else {
+      ESP_LOGW(kLogTag, "USB HID keyboard output could not start");
+    }
+  }
+
   ESP_LOGI(kLogTag, "Subsystem instances created (including remote client/server, morse decoder, timeline emitter, and text keyer)");
   return ESP_OK;
 }
@@ -342,6 +382,14 @@ esp_err_t PaddleHalPhase::Execute() {
   hal_config.dah.pull_down = pins.use_pulldowns;
   hal_config.key.pull_down = pins.use_pulldowns;
 
+  // SO2R focus footswitch shares the paddle input electrical settings
+  if (config_.so2r.channel_count > 1) {
+    hal_config.focus.gpio = static_cast<gpio_num_t>(config_.so2r.focus_gpio);
+    hal_config.focus.active_low = pins.paddles_active_low;
+    hal_config.focus.pull_up = pins.use_pullups;
+    hal_config.focus.pull_down = pins.use_pulldowns;
+  }
+
   ESP_LOGI(kLogTag, "Calling paddle_hal_->Initialize()...");
   // Initialize paddle HAL with callback
   // Use ApplicationController::RecordPaddleEvent static method as callback
@@ -358,6 +406,62 @@ esp_err_t PaddleHalPhase::Execute() {
   return ESP_OK;
 }
 
+//=============================================================================
+// Phase 9.5: SO2R channel HALs
+//=============================================================================
+esp_err_t So2rHalPhase::Execute() {
+  const config::DeviceConfig& config = controller_->device_config_;
+  const config::So2rConfig& so2r = config.so2r;
+  if (so2r.channel_count <= 1) {
+    return ESP_OK;
+  }
+
+  esp_err_t result = ESP_OK;
+  const config::PaddlePins& pins = config.paddle_pins;
+  for (size_t channel = 1; channel < so2r.channel_count && channel < config::kMaxKeyingChannels;
+       ++channel) {
+    const config::So2rRadioConfig* radio = so2r.Radio(channel);
+    auto& tx_hal = controller_->so2r_tx_hals_[channel - 1];
+    auto& paddle_hal = controller_->so2r_paddle_hals_[channel - 1];
+
+    tx_hal = std::make_unique<hal::TxHal>();
+    esp_err_t err = tx_hal->Initialize(static_cast<gpio_num_t>(radio->tx_gpio),
+                                       config.output_pins.trx_active_high);
+    if (err != ESP_OK) {
+      ESP_LOGW(kLogTag, "Radio %u TX init failed: %s", static_cast<unsigned>(channel) + 1U,
+               esp_err_to_name(err));
+      tx_hal.reset();
+      result = err;
+    }
+
+    if (radio->dit_gpio < 0 && radio->dah_gpio < 0) {
+      continue;  // Keyed from the main paddle only
+    }
+    hal::PaddleHalConfig hal_config{};
+    hal_config.dit.gpio = static_cast<gpio_num_t>(radio->dit_gpio);
+    hal_config.dah.gpio = static_cast<gpio_num_t>(radio->dah_gpio);
+    for (hal::PaddlePinConfig* pin : {&hal_config.dit, &hal_config.dah}) {
+      pin->active_low = pins.paddles_active_low;
+      pin->pull_up = pins.use_pullups;
+      pin->pull_down = pins.use_pulldowns;
+    }
+    hal_config.channel = static_cast<uint8_t>(channel);
+
+    paddle_hal = std::make_unique<hal::PaddleHal>();
+    err = paddle_hal->Initialize(hal_config, ApplicationController::RecordPaddleEvent, controller_);
+    if (err != ESP_OK) {
+      ESP_LOGW(kLogTag, "Radio %u paddle init failed: %s", static_cast<unsigned>(channel) + 1U,
+               esp_err_to_name(err));
+      paddle_hal.reset();
+      result = err;
+    }
+  }
+
+  ESP_LOGI(kLogTag, "SO2R: %u keying channels, focus GPIO=%d",
+           static_cast<unsigned>(so2r.channel_count), static_cast<int>(so2r.focus_gpio));
+  return result;
+}
+
 //=============================================================================
 // Phase 10: TX HAL
 //=============================================================================
@@ -393,6 +497,8 @@ esp_err_t AudioSubsystemPhase::Execute() {
   esp_err_t err = subsystem_->Initialize(config_);
   if (err != ESP_OK) {
     ESP_LOGW(kLogTag, "Audio subsystem init failed (continuing without audio)");
+  } else {
+    ui::SetAudioSubsystem(subsystem_.get());
   }
   // Note: Do NOT call audio_subsystem_->Start() here!
   // The sidetone will be controlled by HandleKeyingStateChanged() in sync with TX
@@ -405,30 +511,29 @@ esp_err_t AudioSubsystemPhase::Execute() {
 esp_err_t SubsystemWiringPhase::Execute() {
   // Wire KeyingSubsystem with TxHal, AudioSubsystem, and DiagnosticsSubsystem
   controller_->keying_subsystem_->SetTxHal(controller_->tx_hal_.get());
+  for (size_t channel = 1; channel < config::kMaxKeyingChannels; ++channel) {
+    controller_->keying_subsystem_->SetChannelTxHal(
+        channel, controller_->so2r_tx_hals_[channel - 1].get());
+  }
   controller_->keying_subsystem_->SetAudioSubsystem(controller_->audio_subsystem_.get());
   controller_->keying_subsystem_->SetDiagnosticsSubsystem(controller_->diagnostics_subsystem_.get());
 
-  // Wire morse decoder subsystem into KeyingSubsystem (Phase 2)
-  controller_->keying_subsystem_->SetTimingClassifier(controller_->timing_classifier_.get());
-  controller_->keying_subsystem_->SetMorseDecoder(controller_->morse_decoder_.get());
+  // Wire morse decoder service into KeyingSubsystem (local stream + periodic tick)
+  controller_->keying_subsystem_->SetDecoderService(controller_->decoder_service_.get());
 
-  // Register decoder with console commands (enables "decoder" command)
-  if (controller_->morse_decoder_) {
-    ui::SetMorseDecoder(controller_->morse_decoder_.get());
-  }
+  if (controller_->decoder_service_) {
+    // Register local decoder with console commands (enables "decoder" command)
+    ui::SetMorseDecoder(controller_->keying_subsystem_->GetMorseDecoder());
 
-  // Apply decoder enabled state from configuration
-  if (controller_->morse_decoder_) {
-    controller_->morse_decoder_->SetEnabled(controller_->device_config_.keying.decoder_enabled);
+    // Apply decoder enabled state from configuration (all key streams)
+    controller_->decoder_service_->SetEnabled(controller_->device_config_.keying.decoder_enabled);
     ESP_LOGI(kLogTag, "Decoder %s from configuration",
              controller_->device_config_.keying.decoder_enabled ? "enabled" : "disabled");
-  }
 
-  // Wire TimelineLogger into MorseDecoder for gap marker emission
-  // (Note: TimelineEventEmitter already wired in SubsystemCreationPhase before engine init)
-  if (controller_->morse_decoder_) {
-    controller_->morse_decoder_->SetTimelineLogger(&controller_->keying_subsystem_->GetTimeline());
-    ESP_LOGI(kLogTag, "Timeline logger wired to MorseDecoder for gap markers");
+    // Wire TimelineLogger for gap markers, decoded characters and remote key edges
+    // (Note: TimelineEventEmitter already wired in SubsystemCreationPhase before engine init)
+    controller_->decoder_service_->SetTimelineLogger(&controller_->keying_subsystem_->GetTimeline());
+    ESP_LOGI(kLogTag, "Timeline logger wired to decoder service");
   }
 
   ESP_LOGI(kLogTag, "KeyingSubsystem wired with TX HAL, Audio, Diagnostics, Morse Decoder, and Timeline");
@@ -468,6 +573,25 @@ esp_err_t SubsystemWiringPhase::Execute() {
   return ESP_OK;
 }
 
+//=============================================================================
+// Phase 13.5: Timeline Archive
+//=============================================================================
+esp_err_t TimelineArchivePhase::Execute() {
+  if (!controller_->device_config_.general.timeline_archive) {
+    return ESP_OK;
+  }
+
+  auto archive = std::make_unique<timeline::TimelineArchive>();
+  esp_err_t err = archive->Start(&controller_->keying_subsystem_->GetTimeline());
+  if (err != ESP_OK) {
+    ESP_LOGW(kLogTag, "Timeline archive not started: %s", esp_err_to_name(err));
+    return err;
+  }
+  controller_->timeline_archive_ = std::move(archive);
+  ui::SetTimelineArchive(controller_->timeline_archive_.get());
+  return ESP_OK;
+}
+
 //=============================================================================
 // Phase 14: WiFi Subsystem
 //=============================================================================
@@ -509,10 +633,16 @@ esp_err_t RemoteClientPhase::Execute() {
   // Configure callbacks (minimal for now, will be enhanced later with console/Web UI integration)
   remote::RemoteCwClientCallbacks callbacks{};
   callbacks.on_state_changed = nullptr;      // TODO: Add state change handler for Web UI
-  callbacks.on_remote_key_event = nullptr;   // Not used in client-only mode
+  // Decode the other station's keying on its own stream
+  if (decoder_service_) {
+    callbacks.on_remote_key_event = [](bool key_down, int64_t timestamp_us, void* context) {
+      static_cast<morse_decoder::DecoderService*>(context)->OnKeyEdge(
+          morse_decoder::KeySource::kRemoteClient, key_down, timestamp_us);
+    };
+  }
   callbacks.on_latency_updated = nullptr;    // TODO: Add latency handler for Web UI
   callbacks.on_print_message = nullptr;      // TODO: Add print message handler for console
-  callbacks.context = nullptr;
+  callbacks.context = decoder_service_.get();
 
   ESP_EARLY_LOGW(kLogTag, "ABOUT TO CALL client_->Configure() - client_=%p", client_.get());
   client_->Configure(client_config, callbacks);
@@ -573,15 +703,21 @@ esp_err_t RemoteServerPhase::Execute() {
   remote::RemoteCwServerCallbacks callbacks{};
   callbacks.on_state_changed = nullptr;  // TODO: Add state change handler for Web UI
 
-  // Wire server received keying → TX HAL output
+  // Wire server received keying → TX HAL output + remote server decoder stream
+  g_server_keying_targets.tx_hal = tx_hal_;
+  g_server_keying_targets.decoder_service = decoder_service_.get();
+  callbacks.on_key_event = [](bool key_down, int64_t timestamp_us, void* context) {
+    auto* targets = static_cast<ServerKeyingTargets*>(context);
+    if (targets->tx_hal) {
+      targets->tx_hal->SetActive(key_down);
+    }
+    if (targets->decoder_service) {
+      targets->decoder_service->OnKeyEdge(morse_decoder::KeySource::kRemoteServer, key_down,
+                                          timestamp_us);
+    }
+  };
+  callbacks.context = &g_server_keying_targets;
   if (tx_hal_) {
-    callbacks.on_key_event = [](bool key_down, int64_t timestamp_us, void* context) {
-      auto* tx_hal = static_cast<hal::TxHal*>(context);
-      if (tx_hal) {
-        tx_hal->SetActive(key_down);
-      }
-    };
-    callbacks.context = tx_hal_;
     ESP_LOGI(kLogTag, "Remote CW server wired to TX HAL for keying output");
   } else {
     ESP_LOGW(kLogTag, "TX HAL not available, server keying will not drive output");
@@ -667,6 +803,7 @@ esp_err_t SerialConsolePhase::Execute() {
 
   // Register system commands (debug, reboot, factory-reset) - Task 4.0
   ui::RegisterSystemCommands(console_->get());
+  ui::SetConfigStorage(storage_);
 
   // Initialize console and start FreeRTOS task (AFTER commands are registered)
   (*console_)->Init();
@@ -0,0 +1,292 @@
+#include "app/ota_update.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdio>
+#include <memory>
+#include <new>
+
+extern "C" {
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_ota_ops.h"
+#include "esp_system.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "mbedtls/sha256.h"
+}
+
+#include "system_monitor/task_topology.hpp"
+
+namespace app {
+
+namespace {
+constexpr char kLogTag[] = "ota_update";
+
+std::atomic<bool> g_in_progress{false};
+
+/// One buffer travelling between receiver and writer; length 0 ends the stream
+struct Chunk {
+  uint8_t* data;
+  size_t length;
+};
+
+struct WriterContext {
+  esp_ota_handle_t handle = 0;
+  QueueHandle_t filled = nullptr;   ///< Receiver -> writer
+  QueueHandle_t empty = nullptr;    ///< Writer -> receiver
+  SemaphoreHandle_t done = nullptr;
+  std::atomic<esp_err_t> error{ESP_OK};
+};
+
+void WriterTask(void* arg) {
+  auto* ctx = static_cast<WriterContext*>(arg);
+  Chunk chunk;
+  while (xQueueReceive(ctx->filled, &chunk, portMAX_DELAY) == pdTRUE && chunk.length > 0) {
+    // After a failure keep cycling buffers so the receiver never blocks
+    if (ctx->error.load() == ESP_OK) {
+      const esp_err_t err = esp_ota_write(ctx->handle, chunk.data, chunk.length);
+      if (err != ESP_OK) {
+        ESP_LOGE(kLogTag, "Flash write failed: %s", esp_err_to_name(err));
+        ctx->error.store(err);
+      }
+    }
+    xQueueSend(ctx->empty, &chunk, portMAX_DELAY);
+  }
+  xSemaphoreGive(ctx->done);
+  vTaskDelete(nullptr);
+}
+
+void ToHex(const uint8_t* digest, char* out) {
+  for (size_t i = 0; i < 32; ++i) {
+    snprintf(out + i * 2, 3, "%02x", digest[i]);
+  }
+  out[64] = '\0';
+}
+
+bool DigestMatches(const char* actual_hex, const char* expected_hex) {
+  for (size_t i = 0; i < 64; ++i) {
+    if (expected_hex[i] == '\0' ||
+        std::tolower(static_cast<unsigned char>(expected_hex[i])) != actual_hex[i]) {
+      return false;
+    }
+  }
+  return expected_hex[64] == '\0';
+}
+
+/// Owns the FreeRTOS objects of one update; the writer task deletes itself
+struct Pipeline {
+  WriterContext ctx;
+  std::unique_ptr<uint8_t[]> storage;
+
+  ~Pipeline() {
+    if (ctx.filled) vQueueDelete(ctx.filled);
+    if (ctx.empty) vQueueDelete(ctx.empty);
+    if (ctx.done) vSemaphoreDelete(ctx.done);
+  }
+
+  bool Create() {
+    storage.reset(new (std::nothrow) uint8_t[kOtaChunkSize * kOtaBufferCount]);
+    // +1 slot so the end-of-stream marker never blocks
+    ctx.filled = xQueueCreate(kOtaBufferCount + 1, sizeof(Chunk));
+    ctx.empty = xQueueCreate(kOtaBufferCount, sizeof(Chunk));
+    ctx.done = xSemaphoreCreateBinary();
+    if (!storage || !ctx.filled || !ctx.empty || !ctx.done) {
+      return false;
+    }
+    for (size_t i = 0; i < kOtaBufferCount; ++i) {
+      Chunk chunk{storage.get() + i * kOtaChunkSize, 0};
+      xQueueSend(ctx.empty, &chunk, 0);
+    }
+    return true;
+  }
+};
+
+struct InProgressGuard {
+  ~InProgressGuard() { g_in_progress.store(false); }
+};
+}  // namespace
+
+OtaResult StreamFirmwareUpdate(size_t image_size, const char* expected_sha256_hex,
+                               OtaReadFn read, void* read_context) {
+  OtaResult result;
+  if (g_in_progress.exchange(true)) {
+    result.error = ESP_ERR_INVALID_STATE;
+    result.message = "Firmware update already in progress";
+    return result;
+  }
+  InProgressGuard guard;
+
+  const esp_partition_t* running = esp_ota_get_running_partition();
+  const esp_partition_t* target = esp_ota_get_next_update_partition(nullptr);
+  if (target == nullptr || target == running) {
+    result.error = ESP_ERR_NOT_FOUND;
+    result.message = "No inactive OTA partition (use the UF2 bootloader)";
+    return result;
+  }
+  result.partition = target->label;
+  if (image_size == 0 || image_size > target->size) {
+    result.error = ESP_ERR_INVALID_SIZE;
+    result.message = "Image size does not fit the OTA partition";
+    return result;
+  }
+
+  // Baseline before any allocation so the peak includes buffers, queues and stack
+  const size_t free_before = esp_get_free_heap_size();
+  size_t free_min = free_before;
+
+  Pipeline pipeline;
+  if (!pipeline.Create()) {
+    result.error = ESP_ERR_NO_MEM;
+    result.message = "Out of memory for update buffers";
+    return result;
+  }
+
+  // Sequential writes erase sector by sector as data arrives instead of erasing the
+  // whole partition up front (which would stall the connection for seconds)
+  esp_err_t err = esp_ota_begin(target, OTA_WITH_SEQUENTIAL_WRITES, &pipeline.ctx.handle);
+  if (err != ESP_OK) {
+    result.error = err;
+    result.message = "esp_ota_begin failed";
+    return result;
+  }
+
+  if (system_monitor::CreateTask(system_monitor::TaskId::kOtaWriter, WriterTask, &pipeline.ctx, nullptr) !=
+      pdPASS) {
+    esp_ota_abort(pipeline.ctx.handle);
+    result.error = ESP_ERR_NO_MEM;
+    result.message = "Failed to start writer task";
+    return result;
+  }
+  free_min = std::min(free_min, static_cast<size_t>(esp_get_free_heap_size()));
+
+  ESP_LOGI(kLogTag, "Streaming %u bytes into '%s'", static_cast<unsigned>(image_size),
+           target->label);
+
+  mbedtls_sha256_context sha;
+  mbedtls_sha256_init(&sha);
+  mbedtls_sha256_starts(&sha, 0);
+
+  const int64_t start_us = esp_timer_get_time();
+  size_t remaining = image_size;
+  while (remaining > 0 && pipeline.ctx.error.load() == ESP_OK) {
+    Chunk chunk;
+    xQueueReceive(pipeline.ctx.empty, &chunk, portMAX_DELAY);
+
+    const size_t wanted = std::min(kOtaChunkSize, remaining);
+    size_t filled = 0;
+    while (filled < wanted) {
+      const int n = read(read_context, reinterpret_cast<char*>(chunk.data) + filled,
+                         wanted - filled);
+      if (n <= 0) {
+        break;
+      }
+      filled += static_cast<size_t>(n);
+    }
+    if (filled < wanted) {
+      result.error = ESP_FAIL;
+      result.message = "Connection closed before end of image";
+      break;
+    }
+
+    // Hash here, on the receiving side, while the writer is busy with the other buffer
+    mbedtls_sha256_update(&sha, chunk.data, filled);
+    chunk.length = filled;
+    xQueueSend(pipeline.ctx.filled, &chunk, portMAX_DELAY);
+    remaining -= filled;
+    free_min = std::min(free_min, static_cast<size_t>(esp_get_free_heap_size()));
+  }
+
+  const Chunk end_of_stream{nullptr, 0};
+  xQueueSend(pipeline.ctx.filled, &end_of_stream, portMAX_DELAY);
+  xSemaphoreTake(pipeline.ctx.done, portMAX_DELAY);
+
+  uint8_t digest[32];
+  mbedtls_sha256_finish(&sha, digest);
+  mbedtls_sha256_free(&sha);
+  ToHex(digest, result.sha256_hex);
+
+  const int64_t elapsed_us = std::max<int64_t>(1, esp_timer_get_time() - start_us);
+  result.bytes_written = image_size - remaining;
+  result.duration_ms = static_cast<uint32_t>(elapsed_us / 1000);
+  result.throughput_kbps = static_cast<uint32_t>(
+      (static_cast<uint64_t>(result.bytes_written) * 1000000ULL) / (elapsed_us * 1024ULL));
+  result.heap_peak_bytes = free_before - free_min;
+
+  if (result.error == ESP_OK && pipeline.ctx.error.load() != ESP_OK) {
+    result.error = pipeline.ctx.error.load();
+    result.message = "Flash write failed";
+  }
+  if (result.error == ESP_OK && expected_sha256_hex != nullptr &&
+      !DigestMatches(result.sha256_hex, expected_sha256_hex)) {
+    result.error = ESP_ERR_INVALID_CRC;
+    result.message = "SHA-256 mismatch";
+  }
+  if (result.error != ESP_OK) {
+    esp_ota_abort(pipeline.ctx.handle);
+    ESP_LOGE(kLogTag, "Update failed after %u bytes: %s",
+             static_cast<unsigned>(result.bytes_written), result.message);
+    return result;
+  }
+
+  err = esp_ota_end(pipeline.ctx.handle);
+  if (err != ESP_OK) {
+    result.error = err;
+    result.message = "Image validation failed";
+    ESP_LOGE(kLogTag, "esp_ota_end: %s", esp_err_to_name(err));
+    return result;
+  }
+  err = esp_ota_set_boot_partition(target);
+  if (err != ESP_OK) {
+    result.error = err;
+    result.message = "Failed to set boot partition";
+    return result;
+  }
+
+  result.message = "Update written, restart to boot the new firmware";
+  ESP_LOGI(kLogTag, "Update OK: %u bytes in %u ms (%u KB/s), heap peak %u bytes, sha256 %s",
+           static_cast<unsigned>(result.bytes_written), static_cast<unsigned>(result.duration_ms),
+           static_cast<unsigned>(result.throughput_kbps),
+           static_cast<unsigned>(result.heap_peak_bytes), result.sha256_hex);
+  return result;
+}
+
+bool IsFirmwareUpdateInProgress() {
+  return g_in_progress.load();
+}
+
+bool IsRunningFirmwarePendingVerify() {
+  esp_ota_img_states_t state;
+  return esp_ota_get_state_partition(esp_ota_get_running_partition(), &state) == ESP_OK &&
+         state == ESP_OTA_IMG_PENDING_VERIFY;
+}
+
+void ConfirmRunningFirmware() {
+  if (!IsRunningFirmwarePendingVerify()) {
+    return;
+  }
+  const esp_err_t err = esp_ota_mark_app_valid_cancel_rollback();
+  if (err == ESP_OK) {
+    ESP_LOGI(kLogTag, "New firmware confirmed, rollback cancelled");
+  } else {
+    ESP_LOGE(kLogTag, "Failed to confirm firmware: %s", esp_err_to_name(err));
+  }
+}
+
+void RollbackPendingFirmware(void (*before_restart)()) {
+  if (!IsRunningFirmwarePendingVerify() || !esp_ota_check_rollback_is_possible()) {
+    return;
+  }
+  ESP_LOGW(kLogTag, "Rolling back unconfirmed firmware");
+  if (before_restart != nullptr) {
+    before_restart();
+  }
+  const esp_err_t err = esp_ota_mark_app_invalid_rollback_and_reboot();
+  ESP_LOGE(kLogTag, "Rollback failed: %s", esp_err_to_name(err));
+}
+
+}  // namespace app
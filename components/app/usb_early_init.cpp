@@ -4,7 +4,8 @@
  * 
  * This module manages dual CDC ACM interfaces:
  * - CDC0 (COM8): Debug logs via esp_log_set_vprintf hook
- * - CDC1 (COM7): Console/TUI interface
+ * - CDC1 (COM7): Console/TUI interface, or WinKeyer protocol (general.winkeyer)
+ * - Optional HID boot keyboard (general.usb_hid): paddles as Ctrl keys
  */
 
 #include "app/usb_early_init.hpp"
@@ -17,6 +18,8 @@
 #include "tinyusb.h"
 #include "tusb.h"  // Low-level TinyUSB API
 #include "tinyusb_cdc_acm.h"  // New API from esp_tinyusb 2.x
+#include "usb_hid/hid_keyer_port.hpp"
+#include "system_monitor/task_topology.hpp"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "esp_timer.h"
@@ -44,6 +47,7 @@ static struct {
     bool log_hook_installed;            // Track if esp_log hook is active
     uint32_t hook_call_count;           // DEBUG: Count hook calls
     uint32_t hook_write_count;          // DEBUG: Count successful writes
+    tinyusb_cdcacm_itf_t service_port;  // Console/WinKeyer port (CDC0 with the HID keyboard)
 } g_usb_state = {
     .heartbeat_task = nullptr,
     .cdc_ready = {false, false},
@@ -51,6 +55,7 @@ static struct {
     .log_hook_installed = false,
     .hook_call_count = 0,
     .hook_write_count = 0,
+    .service_port = kServicePort,
 };
 
 //==============================================================================
@@ -71,6 +76,13 @@ extern "C" bool usb_cdc_is_terminal_connected(int port_num) {
     return g_usb_state.cdc_ready[port_num];
 }
 
+/**
+ * CDC port of the console and the WinKeyer (fixed by usb_early_init())
+ */
+extern "C" int usb_service_cdc_port(void) {
+    return g_usb_state.service_port;
+}
+
 /**
  * DEBUG: Get ESP_LOG hook statistics
  * @param hook_calls Output: number of times hook was called
@@ -205,8 +217,10 @@ static int usb_debug_log_vprintf(const char *fmt, va_list args) {
 // Public initialization function
 //==============================================================================
 
-esp_err_t usb_early_init() {
-    // Config using new 2.x API - nullptr uses Kconfig defaults for dual CDC
+esp_err_t usb_early_init(bool hid_keyboard) {
+    // Config using new 2.x API - nullptr uses Kconfig defaults for dual CDC.
+    // With the HID keyboard the configuration descriptor comes from usb_hid instead.
+    const system_monitor::TaskSpec& tinyusb_task = system_monitor::TaskSpecFor(system_monitor::TaskId::kTinyUsb);
     const tinyusb_config_t tusb_cfg = {
         .port = TINYUSB_PORT_FULL_SPEED_0,
         .phy = {
@@ -215,16 +229,17 @@ esp_err_t usb_early_init() {
             .vbus_monitor_io = -1,
         },
         .task = {
-            .size = 4096,
-            .priority = 5,
-            .xCoreID = 0,              // Pin to core 0 (same as USB ISR)
+            .size = tinyusb_task.stack_bytes,
+            .priority = tinyusb_task.priority,
+            .xCoreID = tinyusb_task.core,  // Core 0 (same as USB ISR)
         },
         .descriptor = {
             .device = nullptr,         // Use Kconfig defaults
             .qualifier = nullptr,
             .string = nullptr,
             .string_count = 0,
-            .full_speed_config = nullptr,  // Use Kconfig defaults for dual CDC
+            .full_speed_config = hid_keyboard ? usb_hid::HidKeyerPort::FullSpeedConfigDescriptor()
+                                              : nullptr,  // nullptr: Kconfig defaults for dual CDC
             .high_speed_config = nullptr,
         },
         .event_cb = nullptr,
@@ -250,29 +265,32 @@ esp_err_t usb_early_init() {
         return err;
     }
 
-    // Initialize CDC ACM 1 (service/timeline) with line state callback
-    cdc_cfg.cdc_port = TINYUSB_CDC_ACM_1;
-    err = tinyusb_cdcacm_init(&cdc_cfg);
-    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
-        return err;
-    }
+    if (hid_keyboard) {
+        // The keyboard configuration has a single CDC port (no IN endpoints left for
+        // a second one): CDC0 is the console, ESP_LOG stays on UART1
+        g_usb_state.service_port = kDebugPort;
+    } else {
+        // Initialize CDC ACM 1 (service/timeline) with line state callback
+        cdc_cfg.cdc_port = kServicePort;
+        err = tinyusb_cdcacm_init(&cdc_cfg);
+        if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+            return err;
+        }
 
-    // Install log hook to redirect ESP_LOG to CDC0
-    if (!g_usb_state.log_hook_installed) {
-        g_usb_state.prev_vprintf = esp_log_set_vprintf(&usb_debug_log_vprintf);
-        g_usb_state.log_hook_installed = true;
+        // Install log hook to redirect ESP_LOG to CDC0
+        if (!g_usb_state.log_hook_installed) {
+            g_usb_state.prev_vprintf = esp_log_set_vprintf(&usb_debug_log_vprintf);
+            g_usb_state.log_hook_installed = true;
+        }
     }
 
     // Create heartbeat task to verify CDC is working
     if (!g_usb_state.heartbeat_task) {
-        xTaskCreate(usb_heartbeat_task,
-                   "usb_heartbeat",
-                   4096,  // Stack: 4KB (was 2KB, but task uses ~2.2KB causing overflow)
-                   nullptr,
-                   5,  // Priority
-                   &g_usb_state.heartbeat_task);
+        system_monitor::CreateTask(system_monitor::TaskId::kUsbHeartbeat, usb_heartbeat_task, nullptr,
+                                   &g_usb_state.heartbeat_task);
     }
 
-    ESP_LOGI(kLogTag, "TinyUSB dual CDC initialized with log hook and heartbeat");
+    ESP_LOGI(kLogTag, "TinyUSB %s initialized with heartbeat",
+             hid_keyboard ? "CDC console + HID keyboard (logs on UART1)" : "dual CDC with log hook");
     return ESP_OK;
 }
\ No newline at end of file
@@ -32,6 +32,7 @@ audio::SidetoneConfig AudioSubsystem::BuildSidetoneConfig(
   config.tone_settings.volume_percent = device_config.audio.sidetone_volume_percent;
   config.tone_settings.fade_in_ms = device_config.audio.sidetone_fade_in_ms;
   config.tone_settings.fade_out_ms = device_config.audio.sidetone_fade_out_ms;
+  config.idle_timeout_ms = device_config.audio.sidetone_idle_ms;
   return config;
 }
 
@@ -87,12 +88,20 @@ void AudioSubsystem::ApplyConfig(const config::DeviceConfig& device_config) {
   sidetone_service_.SetFrequency(audio_cfg.sidetone_frequency_hz);
   sidetone_service_.SetVolume(audio_cfg.sidetone_volume_percent);
   sidetone_service_.SetFade(audio_cfg.sidetone_fade_in_ms, audio_cfg.sidetone_fade_out_ms);
+  sidetone_service_.SetIdleTimeout(audio_cfg.sidetone_idle_ms);
 
   ESP_LOGI(kLogTag, "Audio config applied: freq=%u Hz, vol=%u%%, fade_in=%u ms, fade_out=%u ms",
            audio_cfg.sidetone_frequency_hz, audio_cfg.sidetone_volume_percent,
            audio_cfg.sidetone_fade_in_ms, audio_cfg.sidetone_fade_out_ms);
 }
 
+void AudioSubsystem::Wake() {
+  if (!initialized_) {
+    return;
+  }
+  sidetone_service_.Wake();
+}
+
 void AudioSubsystem::SetModeTX() {
   if (!initialized_) {
     return;
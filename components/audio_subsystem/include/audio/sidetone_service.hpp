@@ -45,7 +45,7 @@
  * - **Initialize/Deinitialize**: Must be called from main task context (not thread-safe)
  * - **Start/Stop**: Thread-safe via FreeRTOS task synchronization (vTaskDelete)
  * - **SetFrequency/SetVolume/SetFade**: Hot-reload safe (ToneGenerator uses atomic updates)
- * - **AudioTask**: Runs in dedicated FreeRTOS task (priority 5, 4KB stack)
+ * - **AudioTask**: Runs in dedicated FreeRTOS task (priority 8 on core 0, above the keying loop; 4KB stack)
  *
  * RESOURCE LIFECYCLE (RAII):
  * ===========================
@@ -61,6 +61,21 @@
  * - kCodecBufferCount (2): Double-buffering for DMA (prevents underruns)
  * - Audio Task Delay: 10ms idle (responsive), 5ms error retry (prevents log spam)
  *
+ * IDLE POWER-DOWN:
+ * ================
+ * After the first Start() the pump keeps writing (silent) chunks so the codec never
+ * sees a gap. With idle_timeout_ms > 0 the pump stops once the sidetone has been
+ * silent that long: the I2S channel is disabled (no DMA traffic) and the audio task
+ * blocks on a task notification instead of waking every 5 ms.
+ * - Wake(): called by KeyingSubsystem on the first paddle edge, before the engine
+ *   starts the element - re-enables I2S and resumes the pump (silence until Start())
+ * - Start() while powered down (text keyer, memories): the first kWakePrerollFrames of
+ *   the fade-in, precomputed at power-down, are preloaded into the DMA buffer before
+ *   the channel is enabled, so the tone starts without waiting for the audio task
+ * - Only the local tone generator powers down; remote audio (stream mode) keeps pumping
+ * - GetPowerStats(): wake latency (Wake/Start to first chunk queued) and time spent
+ *   powered down, to estimate the pump CPU saved
+ *
  * CONFIGURATION STRUCT (SidetoneConfig):
  * ======================================
  * - I2C: port (0), SDA/SCL GPIOs, codec address (0x18)
@@ -101,9 +116,11 @@
  */
 
 #include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <mutex>
 
 #include "audio/audio_stream_player.hpp"
 #include "audio/codec_driver.hpp"
@@ -134,6 +151,23 @@ struct SidetoneConfig {
   gpio_num_t i2s_dout = GPIO_NUM_NC;
   uint32_t sample_rate_hz = 16000;  // 16 kHz for sidetone
   ToneGeneratorSettings tone_settings{};
+  uint32_t idle_timeout_ms = 0;  // Silence before the pump powers down (0 = never)
+};
+
+/**
+ * @brief Idle power-down counters (see IDLE POWER-DOWN above)
+ */
+struct SidetonePowerStats {
+  bool powered_down = false;
+  uint32_t power_downs = 0;
+  uint32_t wakes = 0;                 ///< Includes preloaded wakes
+  uint32_t preloaded_wakes = 0;       ///< Start() while powered down (DMA preload path)
+  uint32_t last_wake_latency_us = 0;  ///< Wake()/Start() to the first chunk queued by the pump
+  uint32_t max_wake_latency_us = 0;
+  int64_t powered_down_us = 0;        ///< Total, including the current power-down
+  uint64_t chunks_pumped = 0;
+  uint64_t fill_us = 0;               ///< CPU time spent synthesizing pumped chunks
+  uint32_t chunk_period_us = 0;       ///< Audio time per chunk (powered_down_us / this = chunks saved)
 };
 
 class SidetoneService {
@@ -155,8 +189,25 @@ class SidetoneService {
 
   void SetFrequency(uint16_t frequency_hz);
   void SetVolume(uint8_t volume_percent);
+  void SetPan(int8_t pan);  ///< -100 (left) .. +100 (right), SO2R radio separation
   void SetFade(uint16_t fade_in_ms, uint16_t fade_out_ms);
 
+  /**
+   * @brief Silence before the pump stops and I2S is disabled (0 = pump forever)
+   */
+  void SetIdleTimeout(uint32_t timeout_ms);
+
+  /**
+   * @brief Resume the pump if it is powered down (no-op otherwise)
+   *
+   * Call as early as a tone becomes likely (paddle pressed) so I2S is running
+   * by the time Start() is called. Task context only.
+   */
+  void Wake();
+
+  bool IsPoweredDown() const { return powered_down_.load(std::memory_order_relaxed); }
+  SidetonePowerStats GetPowerStats() const;
+
   /**
    * @brief Enable/disable power amplifier (should be called at subsystem level, not per-tone).
    * @param enable true = enable PA, false = disable PA
@@ -190,6 +241,8 @@ class SidetoneService {
   static constexpr uint32_t kFramesPerChunk = 256;
   static constexpr uint8_t kCodecChannelCount = 2;
   static constexpr size_t kCodecBufferCount = 2;
+  /// Fade-in frames preloaded into DMA when Start() finds the pump powered down (4 ms at 16 kHz)
+  static constexpr uint32_t kWakePrerollFrames = 64;
 
   void SetCodecDriverForTesting(std::unique_ptr<CodecDriver> driver);
   esp_err_t PumpAudioOnceForTest();
@@ -203,6 +256,9 @@ class SidetoneService {
   esp_err_t ConfigureI2s();
   esp_err_t ConfigureCodec();
   uint32_t FramesPerChunk() const;
+  void PowerDownLocked(int64_t now_us);
+  void WakeLocked(bool preload, int64_t now_us);
+  void PrepareWakeChunk();
 
   SidetoneConfig config_{};
   ToneGenerator generator_{};
@@ -215,6 +271,16 @@ class SidetoneService {
   bool codec_driver_injected_for_test_ = false;
 
   AudioMode audio_mode_ = AudioMode::kToneGenerator;
+
+  // Idle power-down: powered_down_ and the wake fields change under power_mutex_
+  mutable std::mutex power_mutex_;
+  std::atomic<bool> powered_down_{false};
+  uint32_t idle_timeout_ms_ = 0;
+  int64_t last_audible_us_ = 0;      // Audio task only
+  int64_t powered_down_since_us_ = 0;
+  int64_t wake_requested_us_ = 0;    // 0 = no wake latency to measure
+  size_t wake_preroll_frames_ = 0;     // Preloaded frames the generator must skip
+  SidetonePowerStats power_stats_{};
   AudioStreamPlayer stream_player_{};
 
   // RAII handles for automatic resource cleanup (Task 9.3)
@@ -227,6 +293,7 @@ class SidetoneService {
   static constexpr size_t kSamplesPerChunk = kFramesPerChunk * kCodecChannelCount;
   using AudioChunk = std::array<int16_t, kSamplesPerChunk>;
   std::array<AudioChunk, kCodecBufferCount> audio_buffers_{};
+  std::array<int16_t, kWakePrerollFrames * kCodecChannelCount> wake_chunk_{};
   size_t next_buffer_index_ = 0;
   size_t bytes_per_chunk_ = kSamplesPerChunk * sizeof(int16_t);
 };
@@ -30,6 +30,10 @@ class ToneGenerator {
   void SetVolume(uint8_t percent);
   uint8_t Volume() const;
 
+  // Stereo balance: -100 = left only, 0 = centre (both channels full), +100 = right only
+  void SetPan(int8_t pan);
+  int8_t Pan() const;
+
   void SetFade(uint16_t fade_in_ms, uint16_t fade_out_ms);
   uint16_t FadeInMs() const;
   uint16_t FadeOutMs() const;
@@ -62,6 +66,9 @@ class ToneGenerator {
   float phase_ = 0.0f;
   float phase_step_ = 0.0f;
   int16_t amplitude_ = 0;
+  int8_t pan_ = 0;
+  float left_gain_ = 1.0f;
+  float right_gain_ = 1.0f;
 
   mutable std::mutex mutex_;  // Protects state machine and audio generation variables
 
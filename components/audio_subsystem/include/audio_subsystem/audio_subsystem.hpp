@@ -77,6 +77,7 @@ class AudioSubsystem {
    * - sidetone_frequency_hz
    * - sidetone_volume_percent
    * - sidetone_fade_in_ms, sidetone_fade_out_ms
+   * - sidetone_idle_ms (idle power-down)
    * - sidetone_enabled (start/stop)
    *
    * Hardware parameters (I2C, I2S pins) require device reset.
@@ -85,6 +86,13 @@ class AudioSubsystem {
    */
   void ApplyConfig(const config::DeviceConfig& device_config);
 
+  /**
+   * @brief Resume the sidetone pump after an idle power-down.
+   *
+   * Called by KeyingSubsystem on paddle presses, before the element starts.
+   */
+  void Wake();
+
   /**
    * @brief Switch to TX mode (local sidetone generation).
    *
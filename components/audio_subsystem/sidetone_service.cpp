@@ -8,10 +8,12 @@ extern "C" {
 #include "esp_check.h"
 #include "esp_io_expander_tca95xx_16bit.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 }
 
 #include "audio/codec_driver.hpp"
 #include "audio/tone_generator.hpp"
+#include "system_monitor/task_topology.hpp"
 
 namespace audio {
 
@@ -31,6 +33,10 @@ constexpr uint32_t kAudioTaskDelayIdleMs = 10;
 // If errors persist >100ms (20 retries), likely indicates hardware fault requiring power cycle.
 constexpr uint32_t kAudioTaskDelayErrorMs = 5;
 
+int64_t ElapsedUs(int64_t since_us, int64_t now_us) {
+  return now_us > since_us ? now_us - since_us : 0;
+}
+
 uint32_t PinMaskFromIndex(int8_t index) {
   if (index < 0 || index >= 32) {
     return 0;
@@ -72,11 +78,16 @@ void SidetoneService::Deinitialize() {
   initialized_ = false;
   pa_enabled_ = false;
   next_buffer_index_ = 0;
+  powered_down_.store(false, std::memory_order_relaxed);
+  wake_requested_us_ = 0;
+  wake_preroll_frames_ = 0;
 }
 
 esp_err_t SidetoneService::Initialize(const SidetoneConfig& config) {
   Deinitialize();
   config_ = config;
+  idle_timeout_ms_ = config_.idle_timeout_ms;
+  power_stats_ = SidetonePowerStats{};
 
   generator_.Configure(config_.tone_settings);
 
@@ -109,8 +120,8 @@ esp_err_t SidetoneService::Initialize(const SidetoneConfig& config) {
   }
   next_buffer_index_ = 0;
 
-  BaseType_t created = xTaskCreatePinnedToCore(&SidetoneService::AudioTaskThunk, "sidetone_loop", 4096, this, 4,
-                                               &task_handle_, tskNO_AFFINITY);
+  BaseType_t created = system_monitor::CreateTask(system_monitor::TaskId::kSidetone,
+                                                  &SidetoneService::AudioTaskThunk, this, &task_handle_);
   if (created != pdPASS) {
     ESP_LOGE(kLogTag, "Failed to create audio task");
     Deinitialize();
@@ -229,9 +240,14 @@ esp_err_t SidetoneService::Start() {
     // }
   }
 
-  generator_.Start();
-  running_ = true;
-  audio_started_ = true;  // Mark codec as active - keeps pumping audio even when silent
+  {
+    std::lock_guard<std::mutex> lock(power_mutex_);
+    generator_.Start();
+    running_ = true;
+    audio_started_ = true;  // Mark codec as active - keeps pumping audio even when silent
+    // No Wake() ahead of this tone (text keyer, memories): start it from the DMA preload
+    WakeLocked(true, esp_timer_get_time());
+  }
 
   next_buffer_index_ = 0;
 
@@ -258,6 +274,10 @@ bool SidetoneService::IsActive() const {
 
 void SidetoneService::SetFrequency(uint16_t frequency_hz) {
   generator_.SetFrequency(frequency_hz);
+  std::lock_guard<std::mutex> lock(power_mutex_);
+  if (powered_down_.load(std::memory_order_relaxed)) {
+    PrepareWakeChunk();
+  }
 }
 
 void SidetoneService::SetVolume(uint8_t volume_percent) {
@@ -268,12 +288,117 @@ void SidetoneService::SetVolume(uint8_t volume_percent) {
       ESP_LOGW(kLogTag, "Failed to propagate volume to codec (%s)", esp_err_to_name(rc));
     }
   }
+  std::lock_guard<std::mutex> lock(power_mutex_);
+  if (powered_down_.load(std::memory_order_relaxed)) {
+    PrepareWakeChunk();
+  }
+}
+
+void SidetoneService::SetPan(int8_t pan) {
+  generator_.SetPan(pan);
+  std::lock_guard<std::mutex> lock(power_mutex_);
+  if (powered_down_.load(std::memory_order_relaxed)) {
+    PrepareWakeChunk();
+  }
 }
 
 void SidetoneService::SetFade(uint16_t fade_in_ms, uint16_t fade_out_ms) {
   generator_.SetFade(fade_in_ms, fade_out_ms);
   config_.tone_settings.fade_in_ms = fade_in_ms;
   config_.tone_settings.fade_out_ms = fade_out_ms;
+  std::lock_guard<std::mutex> lock(power_mutex_);
+  if (powered_down_.load(std::memory_order_relaxed)) {
+    PrepareWakeChunk();
+  }
+}
+
+void SidetoneService::SetIdleTimeout(uint32_t timeout_ms) {
+  std::lock_guard<std::mutex> lock(power_mutex_);
+  idle_timeout_ms_ = timeout_ms;
+  if (timeout_ms == 0) {
+    WakeLocked(false, esp_timer_get_time());
+  }
+}
+
+void SidetoneService::Wake() {
+  if (!powered_down_.load(std::memory_order_relaxed)) {
+    return;  // Common case on every paddle edge: no lock
+  }
+  std::lock_guard<std::mutex> lock(power_mutex_);
+  WakeLocked(false, esp_timer_get_time());
+}
+
+SidetonePowerStats SidetoneService::GetPowerStats() const {
+  std::lock_guard<std::mutex> lock(power_mutex_);
+  SidetonePowerStats stats = power_stats_;
+  stats.powered_down = powered_down_.load(std::memory_order_relaxed);
+  stats.chunk_period_us = config_.sample_rate_hz > 0
+                              ? static_cast<uint32_t>(uint64_t{kFramesPerChunk} * 1000000U / config_.sample_rate_hz)
+                              : 0;
+  if (stats.powered_down) {
+    stats.powered_down_us += ElapsedUs(powered_down_since_us_, esp_timer_get_time());
+  }
+  return stats;
+}
+
+void SidetoneService::WakeLocked(bool preload, int64_t now_us) {
+  if (!powered_down_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  if (preload) {
+    // Preload is only accepted while the channel is disabled: the fade-in goes out
+    // the moment DMA starts, without waiting for the audio task to be scheduled
+    size_t loaded = 0;
+    if (i2s_channel_preload_data(i2s_tx_handle_.Get(), wake_chunk_.data(), sizeof(wake_chunk_), &loaded) ==
+        ESP_OK) {
+      wake_preroll_frames_ = loaded / (kCodecChannelCount * sizeof(int16_t));
+      if (wake_preroll_frames_ > 0) {
+        ++power_stats_.preloaded_wakes;
+      }
+    }
+  }
+  const esp_err_t rc = i2s_tx_handle_.Enable();
+  if (rc != ESP_OK) {
+    ESP_LOGW(kLogTag, "I2S enable on wake failed: %s", esp_err_to_name(rc));
+  }
+  powered_down_.store(false, std::memory_order_relaxed);
+  power_stats_.powered_down_us += ElapsedUs(powered_down_since_us_, now_us);
+  ++power_stats_.wakes;
+  wake_requested_us_ = now_us;
+  if (task_handle_ != nullptr) {
+    xTaskNotifyGive(task_handle_);
+  }
+}
+
+void SidetoneService::PowerDownLocked(int64_t now_us) {
+  // power_mutex_ held: Start() cannot slip in between the check and the disable
+  if (running_ || generator_.IsActive() || audio_mode_ != AudioMode::kToneGenerator) {
+    return;
+  }
+  PrepareWakeChunk();
+  const esp_err_t rc = i2s_tx_handle_.Disable();
+  if (rc != ESP_OK) {
+    ESP_LOGW(kLogTag, "I2S disable on idle failed: %s", esp_err_to_name(rc));
+    return;
+  }
+  powered_down_.store(true, std::memory_order_relaxed);
+  powered_down_since_us_ = now_us;
+  ++power_stats_.power_downs;
+}
+
+void SidetoneService::PrepareWakeChunk() {
+  // First frames of a tone started from silence with the current settings: exactly
+  // what generator_ produces after Start(), so the pump can continue seamlessly
+  ToneGeneratorSettings settings = config_.tone_settings;
+  settings.tone_frequency_hz = generator_.Frequency();
+  settings.volume_percent = generator_.Volume();
+  settings.fade_in_ms = generator_.FadeInMs();
+  settings.fade_out_ms = generator_.FadeOutMs();
+  ToneGenerator preroll;
+  preroll.Configure(settings);
+  preroll.SetPan(generator_.Pan());
+  preroll.Start();
+  preroll.Fill(wake_chunk_.data(), kWakePrerollFrames);
 }
 
 void SidetoneService::AudioTaskThunk(void* arg) {
@@ -287,7 +412,9 @@ void SidetoneService::AudioTaskThunk(void* arg) {
 void SidetoneService::AudioTask() {
   while (true) {
     const esp_err_t rc = PumpAudioChunk();
-    if (rc == ESP_ERR_INVALID_STATE) {
+    if (rc == ESP_ERR_INVALID_STATE && IsPoweredDown()) {
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);  // Until Wake()/Start()
+    } else if (rc == ESP_ERR_INVALID_STATE) {
       vTaskDelay(pdMS_TO_TICKS(kAudioTaskDelayIdleMs));
     } else if (rc != ESP_OK) {
       ESP_LOGW(kLogTag, "Codec write failed: %s", esp_err_to_name(rc));
@@ -365,14 +492,26 @@ esp_err_t SidetoneService::PumpAudioChunk() {
 
   // Keep pumping audio after first Start() - codec stays active even when silent
   // This eliminates init delays and ensures fade-out completes before FSM moves on
-  if (!audio_started_) {
+  if (!audio_started_ || powered_down_.load(std::memory_order_relaxed)) {
     return ESP_ERR_INVALID_STATE;
   }
 
   AudioChunk& buffer = audio_buffers_[next_buffer_index_];
+  const int64_t fill_start_us = esp_timer_get_time();
+  bool audible = true;
 
   if (audio_mode_ == AudioMode::kToneGenerator) {
     // TX mode: Generate local sidetone
+    size_t preroll_frames = 0;
+    {
+      std::lock_guard<std::mutex> lock(power_mutex_);
+      preroll_frames = wake_preroll_frames_;
+      wake_preroll_frames_ = 0;
+    }
+    if (preroll_frames > 0) {
+      generator_.Fill(buffer.data(), preroll_frames);  // Already played from the DMA preload
+    }
+    audible = running_ || generator_.IsActive();
     generator_.Fill(buffer.data(), FramesPerChunk());
   } else {
     // RX mode: Read from remote audio stream
@@ -385,10 +524,30 @@ esp_err_t SidetoneService::PumpAudioChunk() {
     }
   }
 
+  const int64_t fill_end_us = esp_timer_get_time();
+
   const esp_err_t rc = codec_driver_->Write(buffer.data(), bytes_per_chunk_);
   if (rc == ESP_OK) {
     next_buffer_index_ = (next_buffer_index_ + 1U) % audio_buffers_.size();
   }
+
+  const int64_t now_us = esp_timer_get_time();
+  std::lock_guard<std::mutex> lock(power_mutex_);
+  ++power_stats_.chunks_pumped;
+  power_stats_.fill_us += static_cast<uint64_t>(ElapsedUs(fill_start_us, fill_end_us));
+  if (wake_requested_us_ != 0 && rc == ESP_OK) {
+    const uint32_t latency_us = static_cast<uint32_t>(ElapsedUs(wake_requested_us_, now_us));
+    power_stats_.last_wake_latency_us = latency_us;
+    power_stats_.max_wake_latency_us = std::max(power_stats_.max_wake_latency_us, latency_us);
+    wake_requested_us_ = 0;
+    last_audible_us_ = now_us;  // Full timeout again after every wake
+  }
+  if (audible) {
+    last_audible_us_ = now_us;
+  } else if (idle_timeout_ms_ > 0 &&
+             ElapsedUs(last_audible_us_, now_us) >= static_cast<int64_t>(idle_timeout_ms_) * 1000) {
+    PowerDownLocked(now_us);
+  }
   return rc;
 }
 
@@ -402,6 +561,7 @@ void SidetoneService::SetAudioMode(AudioMode mode) {
            (mode == AudioMode::kToneGenerator) ? "ToneGenerator" : "StreamPlayer");
 
   audio_mode_ = mode;
+  Wake();  // Remote audio never powers down
 
   if (mode == AudioMode::kStreamPlayer) {
     // Entering RX mode: reset stream player buffer
@@ -116,6 +116,19 @@ uint8_t ToneGenerator::Volume() const {
   return settings_.volume_percent;
 }
 
+void ToneGenerator::SetPan(int8_t pan) {
+  const int clamped = pan < -100 ? -100 : (pan > 100 ? 100 : pan);
+  std::lock_guard<std::mutex> lock(mutex_);
+  pan_ = static_cast<int8_t>(clamped);
+  // Balance law: the far side is attenuated, the near side stays at full level
+  left_gain_ = clamped > 0 ? static_cast<float>(100 - clamped) / 100.0f : 1.0f;
+  right_gain_ = clamped < 0 ? static_cast<float>(100 + clamped) / 100.0f : 1.0f;
+}
+
+int8_t ToneGenerator::Pan() const {
+  return pan_;
+}
+
 void ToneGenerator::SetFade(uint16_t fade_in_ms, uint16_t fade_out_ms) {
   std::lock_guard<std::mutex> lock(mutex_);
   settings_.fade_in_ms = fade_in_ms;
@@ -147,6 +160,8 @@ void ToneGenerator::Fill(int16_t* stereo_buffer, size_t frames) {
   float local_phase;
   float local_phase_step;
   int16_t local_amplitude;
+  float local_left_gain;
+  float local_right_gain;
 
   {
     std::lock_guard<std::mutex> lock(mutex_);
@@ -158,6 +173,8 @@ void ToneGenerator::Fill(int16_t* stereo_buffer, size_t frames) {
     local_phase = phase_;
     local_phase_step = phase_step_;
     local_amplitude = amplitude_;
+    local_left_gain = left_gain_;
+    local_right_gain = right_gain_;
   }
   // Mutex released - Start()/Stop() can proceed immediately!
 
@@ -230,10 +247,9 @@ void ToneGenerator::Fill(int16_t* stereo_buffer, size_t frames) {
       local_phase -= static_cast<float>(kLutSize);
     }
 
-    const int16_t value = ConvertToSample(sample);
     const size_t base = idx * 2;
-    stereo_buffer[base] = value;
-    stereo_buffer[base + 1] = value;
+    stereo_buffer[base] = ConvertToSample(sample * local_left_gain);
+    stereo_buffer[base + 1] = ConvertToSample(sample * local_right_gain);
   }
 
   // ===== LOCK 2: Update state (~1µs) =====
@@ -9,6 +9,7 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "lwip/sockets.h"
+#include "system_monitor/task_topology.hpp"
 
 #include <cstring>
 #include <unordered_map>
@@ -90,7 +91,8 @@ bool DnsServer::Start() {
 
   // Create FreeRTOS task for server loop
   running_ = true;
-  BaseType_t result = xTaskCreate(ServerTask, "dns_server", 4096, this, 5, (TaskHandle_t*)&task_handle_);
+  BaseType_t result = system_monitor::CreateTask(system_monitor::TaskId::kDnsServer, ServerTask, this,
+                                                 (TaskHandle_t*)&task_handle_);
   if (result != pdPASS) {
     ESP_LOGE(kTag, "Failed to create DNS server task");
     running_ = false;
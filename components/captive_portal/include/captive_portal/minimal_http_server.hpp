@@ -130,6 +130,9 @@ class MinimalHttpServer {
 
   /**
    * @brief  Handler for WiFi scan API: GET /api/wifi/scan
+   *
+   * Serves the background scan cache immediately (networks, age_ms, scanning,
+   * suppressed) and requests a rate-limited refresh.
    * @return ESP_OK on success (returns JSON with network list).
    */
   static esp_err_t HandleWifiScan(httpd_req_t* req);
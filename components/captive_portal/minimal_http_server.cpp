@@ -283,10 +283,10 @@ esp_err_t MinimalHttpServer::HandleWifiScan(httpd_req_t* req) {
     return ESP_FAIL;
   }
 
-  // Perform WiFi scan
-  uint64_t scan_start_us = esp_timer_get_time();
+  // Cached results of the background scan (never scans in the handler)
   std::vector<wifi_subsystem::WifiScanResult> results;
-  esp_err_t err = server->wifi_subsystem_->ScanNetworks(results, 20);  // Max 20 networks
+  wifi_subsystem::WifiScanSnapshot scan_info;
+  esp_err_t err = server->wifi_subsystem_->ScanNetworks(results, 20, &scan_info);  // Max 20 networks
 
   if (err != ESP_OK) {
     ESP_LOGE(kTag, "WiFi scan failed: %s", esp_err_to_name(err));
@@ -296,8 +296,6 @@ esp_err_t MinimalHttpServer::HandleWifiScan(httpd_req_t* req) {
     return ESP_OK;  // Return OK to HTTP server (error is in JSON)
   }
 
-  uint64_t scan_time_ms = (esp_timer_get_time() - scan_start_us) / 1000;
-
   // Build JSON response
   cJSON* root = cJSON_CreateObject();
   cJSON* networks_array = cJSON_CreateArray();
@@ -342,7 +340,13 @@ esp_err_t MinimalHttpServer::HandleWifiScan(httpd_req_t* req) {
   }
 
   cJSON_AddItemToObject(root, "networks", networks_array);
-  cJSON_AddNumberToObject(root, "scan_time_ms", scan_time_ms);
+  // age_ms is -1 until the first scan completes. A request may start a background
+  // refresh (scanning = true); a client wanting the new list requests again later.
+  // No page in the tree polls this endpoint: the setup page is manual entry only
+  cJSON_AddNumberToObject(root, "age_ms",
+                          scan_info.age_ms == wifi_subsystem::kScanAgeNever ? -1.0 : scan_info.age_ms);
+  cJSON_AddBoolToObject(root, "scanning", scan_info.scanning);
+  cJSON_AddBoolToObject(root, "suppressed", scan_info.suppressed);
 
   char* json_string = cJSON_PrintUnformatted(root);
   cJSON_Delete(root);
@@ -353,7 +357,8 @@ esp_err_t MinimalHttpServer::HandleWifiScan(httpd_req_t* req) {
     return ESP_FAIL;
   }
 
-  ESP_LOGI(kTag, "WiFi scan complete: %d networks, %llu ms", results.size(), scan_time_ms);
+  ESP_LOGD(kTag, "WiFi scan cache: %u networks, age %u ms", static_cast<unsigned>(results.size()),
+           static_cast<unsigned>(scan_info.age_ms));
 
   httpd_resp_set_type(req, "application/json");
   httpd_resp_send(req, json_string, strlen(json_string));
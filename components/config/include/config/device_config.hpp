@@ -93,6 +93,7 @@
  * - driver/gpio.h: GPIO type definitions (gpio_num_t)
  */
 
+#include <cstddef>
 #include <cstdint>
 
 extern "C" {
@@ -170,6 +171,7 @@ struct AudioConfig {
   uint16_t sidetone_fade_in_ms = 8;
   uint16_t sidetone_fade_out_ms = 8;
   bool sidetone_enabled = false;
+  uint16_t sidetone_idle_ms = 5000;  ///< Silence before the sidetone pump powers down (0 = never)
 };
 
 /**
@@ -216,6 +218,9 @@ struct KeyingConfig {
   bool manual_use_state_latch = true;
   bool swap_paddles = false;  // Swap dit and dah GPIO assignments (for left-handed operators)
   bool decoder_enabled = true;  // Enable morse code decoder (Phase 2)
+  bool decoder_beam_search = false;  // Beam search + language model instead of greedy decoding
+  bool bug_mode = false;  // Dah paddle keys TX directly (semi-automatic bug); dit paddle stays iambic
+  uint8_t straight_key_debounce_ms = 5;  // Lockout after a manual key edge (0-20 ms, 0 = off)
 
   // L-S-P timing system (Linea-Spazio-Punto) - Industry-standard HST/QRQ timing parameters
   // Manual mode L-S-P parameters (saved to NVS with keys: key_manual_l, key_manual_s, key_manual_p)
@@ -233,6 +238,12 @@ struct KeyingConfig {
 
 struct GeneralConfig {
   char callsign[16] = "IU3QEZ";  // Station callsign displayed in status bar and logs
+  bool timeline_archive = false;  // Long-term timeline history in the "timeline" flash partition
+  uint8_t capture_triggers = 3;   // Timeline capture trigger bits (timeline::CaptureTriggerBit)
+  uint16_t capture_pre_ms = 2000;  // Timeline capture window before the trigger
+  uint16_t capture_post_ms = 500;  // Timeline capture window after the trigger
+  bool winkeyer = false;          // Console port (CDC1) speaks the WinKeyer protocol instead
+  uint8_t usb_hid = 0;            // USB HID keyboard output (usb_hid::HidKeyerMode)
   uint32_t config_version = 5;   // Configuration version for migration support (v5: per-preset L-S-P timing parameters)
 };
 
@@ -273,6 +284,7 @@ struct RemoteConfig {
   uint32_t ptt_tail_ms = 200;          // Base PTT tail delay (network latency added dynamically)
   bool stream_audio = false;           // Enable remote audio streaming (RX mode)
   uint8_t stream_volume = 100;         // Remote audio stream volume (0-100%, default 100)
+  bool low_latency = true;             // Low-latency link profile (radio + sockets) during sessions
 };
 
 struct ServerConfig {
@@ -294,6 +306,42 @@ struct StoredMessagesConfig {
   char message10[128] = "";             // F10: Custom message
 };
 
+// SO2R (single operator, two radios): up to four keying channels. Channel 1 uses the
+// main paddle/TX pins and keying/audio settings; channels 2-4 are configured here.
+constexpr size_t kMaxKeyingChannels = 4;
+
+struct So2rRadioConfig {
+  int32_t tx_gpio = -1;               // TX output of this radio (-1 = not keyed)
+  int32_t dit_gpio = -1;              // Dedicated paddle for this radio (-1 = main paddle only)
+  int32_t dah_gpio = -1;
+  uint16_t sidetone_frequency_hz = 0; // Sidetone pitch while this radio keys (0 = audio setting)
+  int8_t sidetone_pan = 0;            // -100 = left, 0 = centre, +100 = right
+  uint8_t speed_wpm = 0;              // Speed override (0 = keying.speed_wpm)
+};
+
+struct So2rConfig {
+  uint8_t channel_count = 1;          // Keying channels (1 = SO2R disabled)
+  int32_t focus_gpio = -1;            // Footswitch: pressed = radio 2, released = radio 1
+  int8_t radio1_pan = 0;              // Sidetone pan of radio 1
+  So2rRadioConfig radio2{};
+  So2rRadioConfig radio3{};
+  So2rRadioConfig radio4{};
+
+  /// Radio settings of channel 1..3 (radio 2..4); nullptr for channel 0 or out of range
+  const So2rRadioConfig* Radio(size_t channel) const {
+    switch (channel) {
+      case 1:
+        return &radio2;
+      case 2:
+        return &radio3;
+      case 3:
+        return &radio4;
+      default:
+        return nullptr;
+    }
+  }
+};
+
 struct DeviceConfig {
   GeneralConfig general{};       // General device settings (callsign, etc.)
   PaddlePins paddle_pins{};
@@ -309,6 +357,7 @@ struct DeviceConfig {
   RemoteConfig remote{};
   ServerConfig server{};
   StoredMessagesConfig stored_messages{};  // Stored CW messages (F1-F8 + keyer speed)
+  So2rConfig so2r{};             // Multi-radio keying channels
 };
 
 // Forward declaration for parameter_table.hpp types
@@ -342,6 +391,14 @@ class Storage {
   esp_err_t Clone(const char* source_namespace, const char* dest_namespace);
   bool HasBackup(const char* backup_namespace = "keyer_backup") const;
 
+  // Paddle memories: recorded key edge streams (timeline/edge_stream.hpp), one NVS
+  // blob per stored message slot (1-10, same numbering as message1-message10).
+  // Kept out of DeviceConfig so config copies stay small.
+  static constexpr size_t kPaddleMemorySlots = 10;
+  esp_err_t SavePaddleMemory(size_t slot, const uint8_t* data, size_t size);
+  esp_err_t LoadPaddleMemory(size_t slot, uint8_t* out, size_t capacity, size_t* size) const;
+  esp_err_t ErasePaddleMemory(size_t slot);
+
  private:
   // Table-driven Load/Save methods (Task 3.3, 3.4, 3.5, 3.8)
   bool LoadParameter(const ParameterDescriptor& desc, DeviceConfig& config) const;
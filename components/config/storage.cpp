@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <array>
+#include <cstdio>
 #include <cstring>
 
 extern "C" {
@@ -23,6 +24,16 @@ constexpr const char* kKeyPresets = "key_presets";      // Blob: 10 PresetConfig
 constexpr const char* kKeyManualL = "key_manual_l";     // Manual mode L parameter (uint8_t)
 constexpr const char* kKeyManualS = "key_manual_s";     // Manual mode S parameter (uint8_t)
 constexpr const char* kKeyManualP = "key_manual_p";     // Manual mode P parameter (uint8_t)
+constexpr const char* kKeyPaddleMemoryFormat = "pmem_%u"; // Blob: paddle memory slot 1-10
+
+// NVS key of a paddle memory slot; false if the slot is out of range
+bool PaddleMemoryKey(size_t slot, char (&key)[16]) {
+  if (slot < 1 || slot > Storage::kPaddleMemorySlots) {
+    return false;
+  }
+  snprintf(key, sizeof(key), kKeyPaddleMemoryFormat, static_cast<unsigned>(slot));
+  return true;
+}
 
 // Template helper for loading simple numeric types from NVS
 // Reduces code duplication across INT32, UINT32, UINT16, UINT8 cases
@@ -942,6 +953,76 @@ bool Storage::LoadManualLSP(DeviceConfig& config) {
   return true;
 }
 
+/**
+ * @brief Store a recorded paddle memory (edge stream blob) in a message slot
+ *
+ * The stream is opaque here; KeyingSubsystem validates it before replay.
+ *
+ * @return ESP_ERR_INVALID_ARG for a bad slot or empty data, NVS error otherwise
+ */
+esp_err_t Storage::SavePaddleMemory(size_t slot, const uint8_t* data, size_t size) {
+  char key[16];
+  if (!opened_) {
+    return ESP_ERR_INVALID_STATE;
+  }
+  if (!PaddleMemoryKey(slot, key) || data == nullptr || size == 0) {
+    return ESP_ERR_INVALID_ARG;
+  }
+
+  esp_err_t err = nvs_set_blob(handle_, key, data, size);
+  if (err == ESP_OK) {
+    err = nvs_commit(handle_);
+  }
+  if (err != ESP_OK) {
+    ESP_LOGE(kLogTag, "Failed to save paddle memory %u (%zu bytes): %s",
+             static_cast<unsigned>(slot), size, esp_err_to_name(err));
+    return err;
+  }
+  ESP_LOGI(kLogTag, "Saved paddle memory %u (%zu bytes)", static_cast<unsigned>(slot), size);
+  return ESP_OK;
+}
+
+/**
+ * @brief Load a paddle memory slot
+ *
+ * @param size Stream length (output)
+ * @return ESP_ERR_NVS_NOT_FOUND if the slot holds no recording,
+ *         ESP_ERR_NVS_INVALID_LENGTH if it does not fit capacity
+ */
+esp_err_t Storage::LoadPaddleMemory(size_t slot, uint8_t* out, size_t capacity,
+                                    size_t* size) const {
+  char key[16];
+  if (!opened_) {
+    return ESP_ERR_INVALID_STATE;
+  }
+  if (!PaddleMemoryKey(slot, key) || out == nullptr || size == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  *size = capacity;
+  return nvs_get_blob(handle_, key, out, size);
+}
+
+/**
+ * @brief Delete the recording of a paddle memory slot (no-op if empty)
+ */
+esp_err_t Storage::ErasePaddleMemory(size_t slot) {
+  char key[16];
+  if (!opened_) {
+    return ESP_ERR_INVALID_STATE;
+  }
+  if (!PaddleMemoryKey(slot, key)) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  esp_err_t err = nvs_erase_key(handle_, key);
+  if (err == ESP_ERR_NVS_NOT_FOUND) {
+    return ESP_OK;
+  }
+  if (err == ESP_OK) {
+    err = nvs_commit(handle_);
+  }
+  return err;
+}
+
 /**
  * @brief Initialize preset_definitions[10] from factory defaults
  *
@@ -142,6 +142,8 @@ void DiagnosticsSubsystem::UpdatePaddleActivity(hal::PaddleLine line, bool activ
     case hal::PaddleLine::kKey:
       paddle_activity_state_.last_transition_us = timestamp_us;
       break;
+    case hal::PaddleLine::kFocus:
+      break;  // SO2R footswitch: not a paddle
   }
   portEXIT_CRITICAL_ISR(&paddle_state_spinlock_);
 }
@@ -147,12 +147,12 @@ class DiagnosticsSubsystem {
   /**
    * @brief Get timeline logger reference for diagnostics export.
    */
-  timeline::EventLogger<1024>* GetTimelineLogger() { return timeline_logger_; }
+  timeline::EventLogger<timeline::kTimelineCapacity>* GetTimelineLogger() { return timeline_logger_; }
 
   /**
    * @brief Set timeline logger reference (injected from KeyingSubsystem).
    */
-  void SetTimelineLogger(timeline::EventLogger<1024>* logger) { timeline_logger_ = logger; }
+  void SetTimelineLogger(timeline::EventLogger<timeline::kTimelineCapacity>* logger) { timeline_logger_ = logger; }
 
   /**
    * @brief Apply runtime configuration changes (hot-reload).
@@ -244,7 +244,7 @@ class DiagnosticsSubsystem {
   int64_t last_render_us_ = 0;
 
   // Timeline logger (borrowed reference from KeyingSubsystem)
-  timeline::EventLogger<1024>* timeline_logger_;
+  timeline::EventLogger<timeline::kTimelineCapacity>* timeline_logger_;
 };
 
 }  // namespace diagnostics_subsystem
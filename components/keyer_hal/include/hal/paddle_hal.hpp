@@ -20,6 +20,7 @@ enum class PaddleLine : uint8_t {
   kDit = 0,
   kDah = 1,
   kKey = 2,
+  kFocus = 3,  ///< SO2R focus footswitch (see PaddleEvent::channel)
 };
 
 struct PaddleEvent {
@@ -27,6 +28,9 @@ struct PaddleEvent {
   bool active = false;
   int64_t timestamp_us = 0;
   uint32_t raw_level = 0;
+  /// SO2R: input set that produced the edge (0 = main paddle, follows focus).
+  /// For PaddleLine::kFocus, the keying channel to focus instead.
+  uint8_t channel = 0;
 };
 
 struct PaddlePinConfig {
@@ -40,6 +44,8 @@ struct PaddleHalConfig {
   PaddlePinConfig dit;
   PaddlePinConfig dah;
   PaddlePinConfig key;
+  PaddlePinConfig focus;  ///< SO2R footswitch: active = radio 2, released = radio 1
+  uint8_t channel = 0;    ///< Stamped into every PaddleEvent from this HAL
 };
 
 using PaddleEventCallback = void (*)(const PaddleEvent&, void* context);
@@ -77,19 +83,27 @@ class PaddleHal {
 
   esp_err_t ConfigurePin(const PaddlePinConfig& pin_config, PaddleLine line);
   const PaddlePinConfig& PinConfigFor(PaddleLine line) const;
+  // Inline: called from DispatchEdge() in ISR context
+  uint8_t FocusAwareChannel(PaddleLine line, bool active) const {
+    if (line == PaddleLine::kFocus) {
+      return active ? 1 : 0;
+    }
+    return config_.channel;
+  }
 
   PaddleHalConfig config_{};
   PaddleEventCallback callback_ = nullptr;
   void* callback_context_ = nullptr;
   bool initialized_ = false;
-  bool pin_configured_[3]{};
-  GpioIsrContext gpio_contexts_[3]{};
+  bool pin_configured_[4]{};
+  GpioIsrContext gpio_contexts_[4]{};
 
 #ifdef PADDLE_USE_POLLING
   // Previous GPIO levels for edge detection in polling mode
   int last_dit_level_ = -1;
   int last_dah_level_ = -1;
   int last_key_level_ = -1;
+  int last_focus_level_ = -1;
 #endif
 };
 
@@ -71,8 +71,9 @@ esp_err_t PaddleHal::Initialize(const PaddleHalConfig& config,
   ESP_LOGI(kLogTag, "Paddle HAL using POLLING mode (PADDLE_USE_POLLING defined)");
 #endif
 
-  const PaddlePinConfig pins[] = {config_.dit, config_.dah, config_.key};
-  const PaddleLine lines[] = {PaddleLine::kDit, PaddleLine::kDah, PaddleLine::kKey};
+  const PaddlePinConfig pins[] = {config_.dit, config_.dah, config_.key, config_.focus};
+  const PaddleLine lines[] = {PaddleLine::kDit, PaddleLine::kDah, PaddleLine::kKey,
+                              PaddleLine::kFocus};
   const size_t pin_count = sizeof(pins) / sizeof(pins[0]);
 
   for (size_t i = 0; i < pin_count; ++i) {
@@ -95,7 +96,8 @@ void PaddleHal::Shutdown() {
     return;
   }
 
-  const gpio_num_t pins[] = {config_.dit.gpio, config_.dah.gpio, config_.key.gpio};
+  const gpio_num_t pins[] = {config_.dit.gpio, config_.dah.gpio, config_.key.gpio,
+                             config_.focus.gpio};
   const size_t pin_count = sizeof(pins) / sizeof(pins[0]);
   for (size_t i = 0; i < pin_count; ++i) {
     if (!pin_configured_[i]) {
@@ -111,7 +113,7 @@ void PaddleHal::Shutdown() {
 }
 
 bool PaddleHal::HasConfiguredPins() const {
-  return pin_configured_[0] || pin_configured_[1] || pin_configured_[2];
+  return pin_configured_[0] || pin_configured_[1] || pin_configured_[2] || pin_configured_[3];
 }
 
 void IRAM_ATTR PaddleHal::HandleGpioInterrupt(void* arg) {
@@ -142,6 +144,7 @@ void PaddleHal::DispatchEdge(PaddleLine line) const {
       .active = is_active,
       .timestamp_us = esp_timer_get_time(),
       .raw_level = static_cast<uint32_t>(level),
+      .channel = FocusAwareChannel(line, is_active),
   };
   callback_(event, callback_context_);
 }
@@ -191,6 +194,9 @@ esp_err_t PaddleHal::ConfigurePin(const PaddlePinConfig& pin_config, PaddleLine
     case PaddleLine::kKey:
       last_key_level_ = current_level;
       break;
+    case PaddleLine::kFocus:
+      last_focus_level_ = current_level;
+      break;
   }
 #endif
 
@@ -199,8 +205,10 @@ esp_err_t PaddleHal::ConfigurePin(const PaddlePinConfig& pin_config, PaddleLine
   pin_configured_[index] = true;
   ESP_LOGI(kLogTag, "Configured GPIO %d for %s paddle input",
            static_cast<int>(pin_config.gpio),
-           line == PaddleLine::kDit ? "DIT"
-                                     : (line == PaddleLine::kDah ? "DAH" : "KEY"));
+           line == PaddleLine::kDit   ? "DIT"
+           : line == PaddleLine::kDah ? "DAH"
+           : line == PaddleLine::kKey ? "KEY"
+                                      : "FOCUS");
   return ESP_OK;
 }
 
@@ -212,6 +220,8 @@ const PaddlePinConfig& PaddleHal::PinConfigFor(PaddleLine line) const {
       return config_.dah;
     case PaddleLine::kKey:
       return config_.key;
+    case PaddleLine::kFocus:
+      return config_.focus;
   }
   return config_.dit;
 }
@@ -232,6 +242,7 @@ void PaddleHal::Poll() {
           .active = is_active,
           .timestamp_us = esp_timer_get_time(),
           .raw_level = static_cast<uint32_t>(current_level),
+          .channel = config_.channel,
       };
       callback_(event, callback_context_);
     }
@@ -248,6 +259,7 @@ void PaddleHal::Poll() {
           .active = is_active,
           .timestamp_us = esp_timer_get_time(),
           .raw_level = static_cast<uint32_t>(current_level),
+          .channel = config_.channel,
       };
       callback_(event, callback_context_);
     }
@@ -264,11 +276,29 @@ void PaddleHal::Poll() {
           .active = is_active,
           .timestamp_us = esp_timer_get_time(),
           .raw_level = static_cast<uint32_t>(current_level),
+          .channel = config_.channel,
       };
       callback_(event, callback_context_);
     }
     last_key_level_ = current_level;
   }
+
+  // Poll SO2R focus footswitch
+  if (config_.focus.gpio != GPIO_NUM_NC) {
+    const int current_level = gpio_get_level(config_.focus.gpio);
+    if (current_level != last_focus_level_ && last_focus_level_ != -1) {
+      const bool is_active = config_.focus.active_low ? (current_level == 0) : (current_level != 0);
+      PaddleEvent event{
+          .line = PaddleLine::kFocus,
+          .active = is_active,
+          .timestamp_us = esp_timer_get_time(),
+          .raw_level = static_cast<uint32_t>(current_level),
+          .channel = FocusAwareChannel(PaddleLine::kFocus, is_active),
+      };
+      callback_(event, callback_context_);
+    }
+    last_focus_level_ = current_level;
+  }
 }
 #endif
 
@@ -0,0 +1,162 @@
+#include "keying/deadline_monitor.hpp"
+
+#include <cstring>
+
+namespace keying {
+
+namespace {
+
+uint32_t ClampUs(int64_t us) {
+  if (us <= 0) {
+    return 0;
+  }
+  return us > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(us);
+}
+
+size_t BucketFor(uint32_t late_us) {
+  for (size_t i = 0; i < kLatenessBucketCount - 1; ++i) {
+    if (late_us < kLatenessBucketUs[i]) {
+      return i;
+    }
+  }
+  return kLatenessBucketCount - 1;
+}
+
+}  // namespace
+
+const char* DeadlineKindName(DeadlineKind kind) {
+  switch (kind) {
+    case DeadlineKind::kElementEnd:
+      return "element_end";
+    case DeadlineKind::kElementStart:
+      return "element_start";
+    case DeadlineKind::kSidetoneStart:
+      return "sidetone_start";
+  }
+  return "unknown";
+}
+
+const char* LoopStageName(LoopStage stage) {
+  switch (stage) {
+    case LoopStage::kPaddles:
+      return "paddles";
+    case LoopStage::kKeying:
+      return "keying";
+    case LoopStage::kWifi:
+      return "wifi";
+    case LoopStage::kRemoteServer:
+      return "remote_server";
+    case LoopStage::kTextKeyer:
+      return "text_keyer";
+    case LoopStage::kWinKeyer:
+      return "winkeyer";
+    case LoopStage::kDiagnostics:
+      return "diagnostics";
+  }
+  return "unknown";
+}
+
+void DeadlineMonitor::BeginLoop(int64_t now_us) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  loop_start_us_ = now_us;
+  wake_delay_us_ = loop_end_us_ != 0 ? ClampUs(now_us - loop_end_us_) : 0;
+  if (wake_delay_us_ > max_wake_delay_us_) {
+    max_wake_delay_us_ = wake_delay_us_;
+  }
+}
+
+void DeadlineMonitor::EndLoop(int64_t now_us, const uint32_t (&stage_us)[kLoopStageCount]) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  last_loop_.loop_us = ClampUs(now_us - loop_start_us_);
+  last_loop_.wake_delay_us = wake_delay_us_;
+  std::memcpy(last_loop_.stage_us, stage_us, sizeof(last_loop_.stage_us));
+  loop_end_us_ = now_us;
+  if (last_loop_.loop_us > worst_loop_.loop_us) {
+    worst_loop_ = last_loop_;
+  }
+}
+
+bool DeadlineMonitor::Record(DeadlineKind kind, uint8_t channel, int64_t planned_us, int64_t actual_us) {
+  const auto index = static_cast<size_t>(kind);
+  if (index >= kDeadlineKindCount) {
+    return false;
+  }
+  const uint32_t late_us = ClampUs(actual_us - planned_us);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  KindAccumulator& acc = kinds_[index];
+  ++acc.stats.edges;
+  ++acc.stats.histogram[BucketFor(late_us)];
+  acc.late_sum_us += late_us;
+  if (late_us > acc.stats.max_late_us) {
+    acc.stats.max_late_us = late_us;
+  }
+  if (late_us <= miss_threshold_us_) {
+    return false;
+  }
+
+  ++acc.stats.misses;
+  DeadlineMiss& miss = misses_[miss_count_ % kDeadlineMissLogSize];
+  miss = DeadlineMiss{};
+  miss.kind = kind;
+  miss.channel = channel;
+  miss.planned_us = planned_us;
+  miss.late_us = late_us;
+  miss.last_loop = last_loop_;
+  miss.wake_delay_us = wake_delay_us_;
+  ++miss_count_;
+  return true;
+}
+
+void DeadlineMonitor::AttributeLastMiss(const char* task_name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (miss_count_ == 0 || task_name == nullptr) {
+    return;
+  }
+  DeadlineMiss& miss = misses_[(miss_count_ - 1) % kDeadlineMissLogSize];
+  std::strncpy(miss.task, task_name, sizeof(miss.task) - 1);
+  miss.task[sizeof(miss.task) - 1] = '\0';
+}
+
+DeadlineKindStats DeadlineMonitor::Get(DeadlineKind kind) const {
+  const auto index = static_cast<size_t>(kind);
+  if (index >= kDeadlineKindCount) {
+    return DeadlineKindStats{};
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  DeadlineKindStats stats = kinds_[index].stats;
+  stats.mean_late_us = stats.edges > 0 ? static_cast<uint32_t>(kinds_[index].late_sum_us / stats.edges) : 0;
+  return stats;
+}
+
+size_t DeadlineMonitor::Misses(DeadlineMiss* out, size_t max_count) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const size_t available = miss_count_ < kDeadlineMissLogSize ? miss_count_ : kDeadlineMissLogSize;
+  const size_t count = available < max_count ? available : max_count;
+  for (size_t i = 0; i < count; ++i) {
+    out[i] = misses_[(miss_count_ - 1 - i) % kDeadlineMissLogSize];
+  }
+  return count;
+}
+
+LoopTiming DeadlineMonitor::worst_loop() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return worst_loop_;
+}
+
+uint32_t DeadlineMonitor::max_wake_delay_us() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return max_wake_delay_us_;
+}
+
+void DeadlineMonitor::Reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (KindAccumulator& acc : kinds_) {
+    acc = KindAccumulator{};
+  }
+  miss_count_ = 0;
+  worst_loop_ = LoopTiming{};
+  max_wake_delay_us_ = 0;
+}
+
+}  // namespace keying
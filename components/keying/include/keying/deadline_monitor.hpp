@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace keying {
+
+/// Keying edges whose planned time is known in advance
+enum class DeadlineKind : uint8_t {
+  kElementEnd = 0,     ///< Dit/dah key-up at the planned element end
+  kElementStart = 1,   ///< Key-down of an element that follows a gap directly
+  kSidetoneStart = 2,  ///< Sidetone generator started for a key-down
+};
+
+constexpr size_t kDeadlineKindCount = 3;
+
+/// Short name ("element_end", "element_start", "sidetone_start")
+const char* DeadlineKindName(DeadlineKind kind);
+
+/// Main loop stages timed for miss attribution
+enum class LoopStage : uint8_t {
+  kPaddles = 0,       ///< DrainPaddleEvents()
+  kKeying = 1,        ///< KeyingSubsystem::Tick() (engines, memories, decoders)
+  kWifi = 2,          ///< WiFi state + captive portal
+  kRemoteServer = 3,  ///< CWNet server
+  kTextKeyer = 4,
+  kWinKeyer = 5,
+  kDiagnostics = 6,   ///< LED animations
+};
+
+constexpr size_t kLoopStageCount = 7;
+
+/// Short name ("paddles", "keying", ...)
+const char* LoopStageName(LoopStage stage);
+
+/// Lateness histogram: bucket i holds lateness below kLatenessBucketUs[i], the last is open
+constexpr size_t kLatenessBucketCount = 8;
+constexpr uint32_t kLatenessBucketUs[kLatenessBucketCount - 1] = {100, 250, 500, 1000, 2000, 5000, 10000};
+
+/// Lateness above which an edge counts as a miss. The keying loop runs on a 1 ms
+/// tick, so up to one tick of lateness is the expected jitter.
+constexpr uint32_t kDefaultMissThresholdUs = 2000;
+
+/// Misses kept with their attribution (newest replaces oldest)
+constexpr size_t kDeadlineMissLogSize = 8;
+
+/// One main loop iteration, as timed by the loop itself
+struct LoopTiming {
+  uint32_t loop_us = 0;        ///< Work time of the iteration (stages plus glue)
+  /// From the end of the previous iteration to this one's start: the 1 ms tick
+  /// sleep, or more when another task held the core
+  uint32_t wake_delay_us = 0;
+  uint32_t stage_us[kLoopStageCount]{};
+};
+
+struct DeadlineMiss {
+  DeadlineKind kind = DeadlineKind::kElementEnd;
+  uint8_t channel = 0;
+  int64_t planned_us = 0;
+  uint32_t late_us = 0;
+  char task[16] = "";     ///< Task that ran most since the element started (empty = unknown)
+  LoopTiming last_loop;   ///< Last completed main loop iteration
+  uint32_t wake_delay_us = 0;  ///< Start delay of the iteration that produced the late edge
+};
+
+struct DeadlineKindStats {
+  uint32_t edges = 0;
+  uint32_t misses = 0;
+  uint32_t max_late_us = 0;
+  uint32_t mean_late_us = 0;
+  uint32_t histogram[kLatenessBucketCount]{};
+};
+
+/**
+ * @brief Planned-vs-actual keying edge times, lateness histograms and miss attribution
+ *
+ * Every timed edge (element end, element start after a gap, sidetone start) is
+ * recorded with the time it was planned for and the time it was produced. Edges
+ * later than the miss threshold are logged together with the timing of the last
+ * main loop iteration, so a miss can be told apart as a slow stage (one stage_us
+ * large), a starved loop (wake_delay_us large: another task held the core) or
+ * both. The task name is filled in by the caller (AttributeLastMiss()).
+ *
+ * Recorded by the keying loop, read by console/HTTP: all methods lock.
+ */
+class DeadlineMonitor {
+ public:
+  explicit DeadlineMonitor(uint32_t miss_threshold_us = kDefaultMissThresholdUs)
+      : miss_threshold_us_(miss_threshold_us) {}
+
+  DeadlineMonitor(const DeadlineMonitor&) = delete;
+  DeadlineMonitor& operator=(const DeadlineMonitor&) = delete;
+
+  /// Main loop iteration starting (records the wake delay since the last EndLoop())
+  void BeginLoop(int64_t now_us);
+
+  /// Main loop iteration done; stage_us[] of the iteration
+  void EndLoop(int64_t now_us, const uint32_t (&stage_us)[kLoopStageCount]);
+
+  /**
+   * @brief Record one edge
+   * @return true if it was a miss (logged; see AttributeLastMiss())
+   */
+  bool Record(DeadlineKind kind, uint8_t channel, int64_t planned_us, int64_t actual_us);
+
+  /// Name the task blamed for the miss just recorded
+  void AttributeLastMiss(const char* task_name);
+
+  DeadlineKindStats Get(DeadlineKind kind) const;
+
+  /// Logged misses, newest first
+  size_t Misses(DeadlineMiss* out, size_t max_count) const;
+
+  /// Longest main loop iteration since the last Reset()
+  LoopTiming worst_loop() const;
+  /// Longest wake delay since the last Reset()
+  uint32_t max_wake_delay_us() const;
+
+  uint32_t miss_threshold_us() const { return miss_threshold_us_; }
+  void Reset();
+
+ private:
+  struct KindAccumulator {
+    DeadlineKindStats stats;
+    uint64_t late_sum_us = 0;
+  };
+
+  mutable std::mutex mutex_;
+  const uint32_t miss_threshold_us_;
+  KindAccumulator kinds_[kDeadlineKindCount];
+  DeadlineMiss misses_[kDeadlineMissLogSize];
+  size_t miss_count_ = 0;  ///< Total logged (ring index = count % size)
+
+  int64_t loop_start_us_ = 0;
+  int64_t loop_end_us_ = 0;   ///< 0 until the first EndLoop()
+  uint32_t wake_delay_us_ = 0;  ///< Of the iteration in progress
+  LoopTiming last_loop_;
+  LoopTiming worst_loop_;
+  uint32_t max_wake_delay_us_ = 0;
+};
+
+}  // namespace keying
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "keying/paddle_engine.hpp"
+
+namespace keying {
+
+/**
+ * @brief Compile-time iambic behavior for PaddleEngine's specialized FSM
+ *
+ * The ten KeyingPresets differ only along three axes: memory mode (both/dot/dah/none),
+ * squeeze latch (state latch = kLive for SuperKeyer/Accukeyer, edge trigger = kSnapshot
+ * for Curtis A) and the memory window percentages. The first two (plus Mode A/B) become
+ * template parameters here; the window stays runtime data but is converted to absolute
+ * microseconds once per element. PaddleEngine::Initialize() picks the instantiation.
+ *
+ *   V0/V3 Both, V1/V4 Dot, V2/V5 Dash  -> IambicPolicy<kB, kDotAndDah|kDotOnly|kDahOnly, kLive>
+ *   V6 Both, V7 Dot, V8 Dash (Curtis A) -> IambicPolicy<kB, ..., kSnapshot>
+ *   V9 No memory                        -> IambicPolicy<kB, kNone, kSnapshot>
+ */
+
+/// Action bits of the memory/squeeze transition table
+namespace arm_action {
+constexpr uint8_t kArmDit = 0x01;        ///< Arm dit memory
+constexpr uint8_t kArmDah = 0x02;        ///< Arm dah memory
+constexpr uint8_t kSqueeze = 0x04;       ///< Mark squeeze seen this element (Mode B bonus)
+constexpr uint8_t kNotifyMemory = 0x08;  ///< Report newly armed memory to the timeline hook
+}  // namespace arm_action
+
+/// Indexed by [combo][current element]: combo = dit_pressed | (dah_pressed << 1),
+/// element = 0 (dit) / 1 (dah). Only the element opposite to the one sending is armed.
+using ArmTable = std::array<std::array<uint8_t, 2>, 4>;
+
+constexpr ArmTable BuildArmTable(bool dit_memory, bool dah_memory) {
+  ArmTable table{};
+  for (size_t element = 0; element < 2; ++element) {
+    const bool sending_dit = element == 0;
+    const uint8_t arm_dit = (dit_memory && !sending_dit) ? arm_action::kArmDit : 0;
+    const uint8_t arm_dah = (dah_memory && sending_dit) ? arm_action::kArmDah : 0;
+    table[1][element] = arm_dit != 0 ? (arm_dit | arm_action::kNotifyMemory) : 0;
+    table[2][element] = arm_dah != 0 ? (arm_dah | arm_action::kNotifyMemory) : 0;
+    table[3][element] = static_cast<uint8_t>(arm_dit | arm_dah | arm_action::kSqueeze);
+  }
+  return table;
+}
+
+template <IambicMode kIambic, MemoryMode kMemory, SqueezeMode kSqueeze>
+struct IambicPolicy {
+  static constexpr bool kModeB = kIambic == IambicMode::kB;
+  static constexpr bool kDitMemory =
+      kMemory == MemoryMode::kDotOnly || kMemory == MemoryMode::kDotAndDah;
+  static constexpr bool kDahMemory =
+      kMemory == MemoryMode::kDahOnly || kMemory == MemoryMode::kDotAndDah;
+  static constexpr bool kLiveSqueeze = kSqueeze == SqueezeMode::kLive;
+  static constexpr ArmTable kArmTable = BuildArmTable(kDitMemory, kDahMemory);
+};
+
+}  // namespace keying
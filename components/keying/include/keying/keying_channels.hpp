@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "hal/paddle_hal.hpp"
+#include "keying/paddle_engine.hpp"
+#include "timeline/timeline_hooks.hpp"
+
+namespace keying {
+
+/**
+ * @brief Channel-tagged callbacks of KeyingChannelRouter
+ *
+ * on_key_state_changed fires for every channel (drives that channel's TX output and
+ * sidetone). on_focus_key_changed is the single, never-overlapping key stream of the
+ * focused radio (decoder, remote keying): a key-down is forwarded only from the
+ * focused channel and only when no forwarded key is still down.
+ */
+struct KeyingChannelCallbacks {
+  void (*on_element_started)(uint8_t channel, PaddleElement element, int64_t start_time_us,
+                             void* context) = nullptr;
+  void (*on_element_finished)(uint8_t channel, PaddleElement element, int64_t end_time_us,
+                              void* context) = nullptr;
+  void (*on_key_state_changed)(uint8_t channel, bool key_active, int64_t timestamp_us,
+                               void* context) = nullptr;
+  void (*on_focus_key_changed)(bool key_active, int64_t timestamp_us, void* context) = nullptr;
+  void (*on_focus_changed)(uint8_t channel, int64_t timestamp_us, void* context) = nullptr;
+  void (*on_deadline)(uint8_t channel, DeadlineKind kind, int64_t planned_us, int64_t actual_us,
+                      void* context) = nullptr;
+  void* context = nullptr;
+
+  // Shared by every channel's engine (single timeline)
+  timeline::TimelineHooks timeline_hooks{};
+};
+
+/**
+ * @brief SO2R keying: one PaddleEngine per radio, one event stream in
+ *
+ * All paddle HALs feed the same ISR queue; PaddleEvent::channel names the input set
+ * that produced the edge. Input set 0 (the main paddle) follows the focus, input set
+ * k > 0 is hard-wired to channel k. PaddleLine::kFocus events select the focused
+ * channel. Engines never share state, so timing on one radio is unaffected by
+ * activity or focus changes on another.
+ *
+ * Focus switch: main-paddle lines still held are released on the old channel and
+ * pressed on the new one at the switch timestamp. The old channel completes the
+ * element in progress (no truncated dit/dah on air); the new channel starts at its
+ * next Tick(), i.e. within one main loop period.
+ */
+class KeyingChannelRouter {
+ public:
+  static constexpr size_t kMaxChannels = 4;
+
+  KeyingChannelRouter() = default;
+
+  KeyingChannelRouter(const KeyingChannelRouter&) = delete;
+  KeyingChannelRouter& operator=(const KeyingChannelRouter&) = delete;
+
+  /**
+   * @brief Set channel count (clamped to 1..kMaxChannels) and callbacks
+   *
+   * Focus returns to channel 0. Each channel must be configured with Configure()
+   * before it keys.
+   */
+  void Initialize(size_t channel_count, const KeyingChannelCallbacks& callbacks);
+
+  /**
+   * @brief (Re)initialize one channel's engine
+   * @return false if channel is out of range or the engine rejected the config
+   */
+  bool Configure(uint8_t channel, const PaddleEngineConfig& config);
+
+  /// Update the timeline hooks handed to engines on their next Configure()
+  void SetTimelineHooks(const timeline::TimelineHooks& hooks) { callbacks_.timeline_hooks = hooks; }
+
+  /// Route one HAL event (paddle edge or focus footswitch)
+  void OnPaddleEvent(const hal::PaddleEvent& event);
+
+  /// Move the main paddle to another channel (ignored if out of range or already focused)
+  void SetFocus(uint8_t channel, int64_t timestamp_us);
+
+  void Tick(int64_t now_us);
+
+  uint8_t focus() const { return focus_; }
+  size_t channel_count() const { return channel_count_; }
+  uint32_t dropped_events() const { return dropped_events_; }
+
+  PaddleEngine& engine(size_t channel) { return engines_[channel]; }
+  const PaddleEngine& engine(size_t channel) const { return engines_[channel]; }
+  bool key_active(size_t channel) const { return key_active_[channel]; }
+
+ private:
+  struct Slot {
+    KeyingChannelRouter* router = nullptr;
+    uint8_t channel = 0;
+  };
+
+  static void HandleElementStarted(PaddleElement element, int64_t start_time_us, void* context);
+  static void HandleElementFinished(PaddleElement element, int64_t end_time_us, void* context);
+  static void HandleKeyStateChanged(bool key_active, int64_t timestamp_us, void* context);
+  static void HandleDeadline(DeadlineKind kind, int64_t planned_us, int64_t actual_us, void* context);
+
+  void OnChannelKey(uint8_t channel, bool key_active, int64_t timestamp_us);
+  void ForwardFocusKey(uint8_t channel, bool key_active, int64_t timestamp_us);
+
+  static constexpr int8_t kNoChannel = -1;
+  static constexpr size_t kMainLines = 3;  // kDit, kDah, kKey
+
+  PaddleEngine engines_[kMaxChannels];
+  Slot slots_[kMaxChannels];
+  bool key_active_[kMaxChannels]{};
+  bool main_held_[kMainLines]{};  // Physical state of input set 0
+  KeyingChannelCallbacks callbacks_{};
+  size_t channel_count_ = 1;
+  uint8_t focus_ = 0;
+  int8_t streamed_channel_ = kNoChannel;  // Channel whose key-down reached the focus stream
+  uint32_t dropped_events_ = 0;           // Events from unconfigured input sets
+};
+
+}  // namespace keying
@@ -4,6 +4,8 @@
 #include <deque>
 
 #include "hal/paddle_hal.hpp"
+#include "keying/deadline_monitor.hpp"
+#include "keying/straight_key.hpp"
 #include "timeline/timeline_hooks.hpp"
 
 namespace keying {
@@ -11,6 +13,7 @@ namespace keying {
 enum class PaddleElement : uint8_t {
   kDit = 0,
   kDah = 1,
+  kManual = 2,  // Straight key / bug dah: key-down timed by the operator
 };
 
 // Iambic keyer mode (Mode A vs Mode B)
@@ -33,6 +36,12 @@ enum class SqueezeMode : uint8_t {
   kLive = 1,      // Continuously update paddle state during element
 };
 
+// Which FSM implementation PaddleEngine runs (both produce identical keying)
+enum class FsmVariant : uint8_t {
+  kSpecialized = 0,  // IambicPolicy instantiation picked at Initialize() (iambic_policy.hpp)
+  kGeneric = 1,      // Runtime branching on the mode fields every tick (reference)
+};
+
 struct PaddleEngineConfig {
   uint32_t speed_wpm = 20;              // Keying speed in words per minute (default: 20 WPM)
   IambicMode iambic_mode = IambicMode::kB;  // Mode A or Mode B operation (default: Mode B)
@@ -54,6 +63,14 @@ struct PaddleEngineConfig {
   uint8_t timing_l = 30;  // L (Dash length): 10-90, default 30 → dash = (L/10.0) * dit_effective (L=30 → 3:1 ratio)
   uint8_t timing_s = 50;  // S (Gap space): 0-99, default 50 → gap = (S/50.0) * dit_effective (S=50 → 1:1 ratio)
   uint8_t timing_p = 50;  // P (Dit duration): 10-99, default 50 → dit_effective = dit_theoretical * (P/50.0) (P=50 → 100%)
+
+  // Manual key lines (straight key input, and the dah paddle in bug mode) bypass the
+  // iambic FSM: OnPaddleEvent() drives the key output directly after debouncing, and
+  // the output is the OR of the iambic and manual key states.
+  bool bug_mode = false;  // Dit paddle sends automatic dits, dah paddle is a manual key
+  int64_t manual_debounce_us = StraightKeyDebouncer::kDefaultLockoutUs;
+
+  FsmVariant fsm_variant = FsmVariant::kSpecialized;
 };
 
 struct PaddleEngineCallbacks {
@@ -63,6 +80,9 @@ struct PaddleEngineCallbacks {
                               void* context) = nullptr;
   void (*on_key_state_changed)(bool key_active, int64_t timestamp_us,
                                void* context) = nullptr;
+  // Timed edge produced by Tick(): when it was planned and when it actually happened
+  void (*on_deadline)(DeadlineKind kind, int64_t planned_us, int64_t actual_us,
+                      void* context) = nullptr;
   void* context = nullptr;
 
   // Timeline hooks for real-time visualization (memory window, late release, latch, squeeze)
@@ -120,6 +140,29 @@ class PaddleEngine {
     int64_t release_time_us = 0;
   };
 
+  // Mode-dependent FSM steps, bound once at Initialize(): either the generic member
+  // functions or an IambicPolicy instantiation of the *Specialized templates
+  struct FsmOps {
+    void (PaddleEngine::*check_memory)(int64_t now_us);
+    void (PaddleEngine::*queue_memory)();  // FinishElement: memory + Mode B bonus
+    void (PaddleEngine::*update_paddles)(bool dit, bool dah);
+  };
+
+  static FsmOps SelectFsmOps(const PaddleEngineConfig& config);
+  template <typename Policy>
+  static constexpr FsmOps SpecializedOps();
+
+  template <typename Policy>
+  void CheckMemoryAndSqueezeSpecialized(int64_t now_us);
+  template <typename Policy>
+  void QueueMemoryAndBonusSpecialized();
+  template <typename Policy>
+  void UpdatePaddlesSpecialized(bool dit, bool dah);
+
+  bool IsManualLine(hal::PaddleLine line) const;
+  void OnManualKeyChanged(bool active, int64_t timestamp_us);
+  void UpdateKeyOutput(int64_t timestamp_us);  // Report OR of iambic + manual key on change
+
   void StartElement(PaddleElement element, int64_t start_time_us);
   void FinishElement(int64_t timestamp_us);
   void EnterGap(int64_t now_us);
@@ -130,6 +173,7 @@ class PaddleEngine {
   PaddleCombo GetComboNow() const;  // Get current paddle combination state
   float GetElementProgressPct(int64_t now_us) const;  // Get % of current element elapsed
   void CheckMemoryAndSqueezeDuringElement(int64_t now_us);  // Check and arm memory flags
+  void QueueMemoryAndBonus();  // Push armed memories and Mode B bonus to the queue
   void UpdatePaddles(bool dit, bool dah);  // Update paddle state based on squeeze_mode
 
   int64_t DitDurationUs() const;
@@ -139,6 +183,7 @@ class PaddleEngine {
   // Configuration and callbacks
   PaddleEngineConfig config_{};
   PaddleEngineCallbacks callbacks_{};
+  FsmOps ops_{};
 
   // FSM state tracking (follows Python prototype structure)
   State state_ = State::kIdle;                    // Current FSM state
@@ -149,6 +194,10 @@ class PaddleEngine {
   int64_t element_start_us_ = 0;  // When current element started
   int64_t element_end_us_ = 0;    // When current element should end
 
+  // Memory window of the current element in absolute time (specialized FSM)
+  int64_t mem_window_open_us_ = 0;
+  int64_t mem_window_close_us_ = 0;
+
   // Gap timing (microseconds)
   int64_t gap_start_us_ = 0;      // When gap started
   int64_t gap_end_us_ = 0;        // When gap should end
@@ -167,6 +216,12 @@ class PaddleEngine {
   // Squeeze tracking for Mode B bonus element
   bool squeeze_seen_this_element_ = false;  // True if squeeze detected during current element
   PaddleCombo last_valid_combo_ = PaddleCombo::kNone;  // Last non-None combo (for snapshot mode)
+
+  // Key output: iambic element on, manual key down, and the combined state last reported
+  bool iambic_key_active_ = false;
+  bool manual_key_active_ = false;
+  bool key_output_ = false;
+  StraightKeyDebouncer manual_key_;
 };
 
 }  // namespace keying
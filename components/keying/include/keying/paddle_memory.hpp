@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "timeline/edge_stream.hpp"
+
+namespace keying {
+
+/// Largest stored paddle memory (edge stream bytes, header included)
+constexpr size_t kPaddleMemoryMaxBytes = 512;
+
+/// Replay speed limits in percent of the recorded speed
+constexpr uint16_t kPaddleMemoryMinSpeedPct = 25;
+constexpr uint16_t kPaddleMemoryMaxSpeedPct = 400;
+
+/**
+ * @brief Records the keyed output as a timeline::EdgeStream (paddle memory)
+ *
+ * Fed with the exact edge timestamps of the key stream. The recording starts at
+ * the first key-down (no lead-in silence). When the buffer fills, the recording
+ * keeps its last complete mark and ignores the rest.
+ */
+class PaddleMemoryRecorder {
+ public:
+  PaddleMemoryRecorder();
+
+  PaddleMemoryRecorder(const PaddleMemoryRecorder&) = delete;
+  PaddleMemoryRecorder& operator=(const PaddleMemoryRecorder&) = delete;
+
+  /// Discard any previous recording and start a new one
+  void Start();
+
+  /// Record one key edge (ignored unless recording)
+  void OnKeyEdge(bool key_active, int64_t timestamp_us);
+
+  /**
+   * @brief Stop recording; a key still down is released at timestamp_us
+   * @return Stream length in bytes (0 if nothing was keyed)
+   */
+  size_t Stop(int64_t timestamp_us);
+
+  bool active() const { return active_; }
+  bool truncated() const { return writer_.full(); }
+  const uint8_t* data() const { return buffer_; }
+  size_t size() const { return size_; }
+
+ private:
+  uint8_t buffer_[kPaddleMemoryMaxBytes]{};
+  timeline::EdgeStreamWriter writer_;
+  size_t size_ = 0;
+  bool active_ = false;
+};
+
+/**
+ * @brief Replays a paddle memory with its recorded timing
+ *
+ * Edge offsets are scaled by 100 / speed_pct and scheduled from Start(): each
+ * edge is reported with its scheduled timestamp, and next_edge_us() tells the
+ * caller when to wake up, so replay timing does not depend on the tick rate.
+ */
+class PaddleMemoryPlayer {
+ public:
+  struct Edge {
+    bool key_active = false;
+    int64_t timestamp_us = 0;  ///< Scheduled time (not the time it was popped)
+  };
+
+  PaddleMemoryPlayer() = default;
+
+  PaddleMemoryPlayer(const PaddleMemoryPlayer&) = delete;
+  PaddleMemoryPlayer& operator=(const PaddleMemoryPlayer&) = delete;
+
+  /**
+   * @brief Copy a stream and start replaying it at start_us
+   * @param speed_pct Replay speed (100 = as recorded), clamped to 25-400 %
+   * @return false if the stream is invalid, empty or larger than kPaddleMemoryMaxBytes
+   */
+  bool Start(const uint8_t* data, size_t size, uint16_t speed_pct, int64_t start_us);
+
+  /**
+   * @brief Abort replay
+   * @return true if the key was down (caller must release its output)
+   */
+  bool Stop();
+
+  /**
+   * @brief Pop the next edge if it is due at now_us
+   * @return false if no edge is due yet (or replay finished)
+   */
+  bool PopDue(int64_t now_us, Edge* edge);
+
+  bool active() const { return active_; }
+  bool key_active() const { return key_active_; }
+  /// Scheduled time of the next edge (only meaningful while active())
+  int64_t next_edge_us() const { return next_.timestamp_us; }
+
+ private:
+  void Advance();
+
+  uint8_t buffer_[kPaddleMemoryMaxBytes]{};
+  timeline::EdgeStreamReader reader_{nullptr, 0};
+  Edge next_{};
+  int64_t start_us_ = 0;
+  uint16_t speed_pct_ = 100;
+  bool key_active_ = false;
+  bool active_ = false;
+};
+
+}  // namespace keying
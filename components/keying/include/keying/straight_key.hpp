@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+
+namespace keying {
+
+/**
+ * @brief Leading-edge debouncer for manually timed key lines (straight key, bug dah)
+ *
+ * The first edge that changes the state is accepted immediately, so the key output
+ * follows the contact with no added delay. Further edges within the lockout window
+ * are contact bounce and are ignored; if the contact settled in the other state
+ * during the lockout (a very short tap), Poll() applies it once the lockout expires.
+ */
+class StraightKeyDebouncer {
+ public:
+  /// Mechanical keys bounce for 1-5 ms; 5 ms still passes 100 WPM dits (12 ms)
+  static constexpr int64_t kDefaultLockoutUs = 5000;
+
+  void Configure(int64_t lockout_us);
+  void Reset();
+
+  /**
+   * @brief Feed a raw contact edge
+   * @return true if the debounced state changed (read it with state())
+   */
+  bool OnEdge(bool active, int64_t timestamp_us);
+
+  /**
+   * @brief Apply a contact state that settled during the lockout
+   * @return true if the debounced state changed at now_us
+   */
+  bool Poll(int64_t now_us);
+
+  bool state() const { return state_; }
+  int64_t last_change_us() const { return last_change_us_; }
+  uint32_t rejected_edges() const { return rejected_edges_; }
+
+ private:
+  bool LockedOut(int64_t timestamp_us) const;
+
+  int64_t lockout_us_ = kDefaultLockoutUs;
+  bool state_ = false;      ///< Debounced (output) state
+  bool raw_ = false;        ///< Last raw contact state
+  bool changed_ = false;    ///< At least one accepted change (lockout reference valid)
+  int64_t last_change_us_ = 0;
+  uint32_t rejected_edges_ = 0;
+};
+
+}  // namespace keying
@@ -0,0 +1,155 @@
+#include "keying/keying_channels.hpp"
+
+#include <algorithm>
+
+namespace keying {
+
+void KeyingChannelRouter::Initialize(size_t channel_count,
+                                     const KeyingChannelCallbacks& callbacks) {
+  channel_count_ = std::clamp<size_t>(channel_count, 1, kMaxChannels);
+  callbacks_ = callbacks;
+  focus_ = 0;
+  streamed_channel_ = kNoChannel;
+  dropped_events_ = 0;
+  for (size_t i = 0; i < kMaxChannels; ++i) {
+    slots_[i] = Slot{.router = this, .channel = static_cast<uint8_t>(i)};
+    key_active_[i] = false;
+  }
+  std::fill(std::begin(main_held_), std::end(main_held_), false);
+}
+
+bool KeyingChannelRouter::Configure(uint8_t channel, const PaddleEngineConfig& config) {
+  if (channel >= channel_count_) {
+    return false;
+  }
+  PaddleEngineCallbacks engine_callbacks{
+      .on_element_started = HandleElementStarted,
+      .on_element_finished = HandleElementFinished,
+      .on_key_state_changed = HandleKeyStateChanged,
+      .on_deadline = HandleDeadline,
+      .context = &slots_[channel],
+      .timeline_hooks = callbacks_.timeline_hooks,
+  };
+  return engines_[channel].Initialize(config, engine_callbacks);
+}
+
+void KeyingChannelRouter::OnPaddleEvent(const hal::PaddleEvent& event) {
+  if (event.line == hal::PaddleLine::kFocus) {
+    SetFocus(event.channel, event.timestamp_us);
+    return;
+  }
+  if (event.channel >= channel_count_) {
+    ++dropped_events_;
+    return;
+  }
+
+  uint8_t target = event.channel;
+  if (event.channel == 0) {
+    const auto line = static_cast<size_t>(event.line);
+    if (line < kMainLines) {
+      main_held_[line] = event.active;
+    }
+    target = focus_;
+  }
+  engines_[target].OnPaddleEvent(event);
+}
+
+void KeyingChannelRouter::SetFocus(uint8_t channel, int64_t timestamp_us) {
+  if (channel >= channel_count_ || channel == focus_) {
+    return;
+  }
+
+  const uint8_t previous = focus_;
+  for (size_t line = 0; line < kMainLines; ++line) {
+    if (main_held_[line]) {
+      engines_[previous].OnPaddleEvent({.line = static_cast<hal::PaddleLine>(line),
+                                        .active = false,
+                                        .timestamp_us = timestamp_us});
+    }
+  }
+  focus_ = channel;
+  for (size_t line = 0; line < kMainLines; ++line) {
+    if (main_held_[line]) {
+      engines_[channel].OnPaddleEvent({.line = static_cast<hal::PaddleLine>(line),
+                                       .active = true,
+                                       .timestamp_us = timestamp_us});
+    }
+  }
+
+  if (callbacks_.on_focus_changed != nullptr) {
+    callbacks_.on_focus_changed(channel, timestamp_us, callbacks_.context);
+  }
+}
+
+void KeyingChannelRouter::Tick(int64_t now_us) {
+  for (size_t i = 0; i < channel_count_; ++i) {
+    engines_[i].Tick(now_us);
+  }
+}
+
+void KeyingChannelRouter::HandleElementStarted(PaddleElement element, int64_t start_time_us,
+                                               void* context) {
+  const auto* slot = static_cast<const Slot*>(context);
+  const KeyingChannelCallbacks& callbacks = slot->router->callbacks_;
+  if (callbacks.on_element_started != nullptr) {
+    callbacks.on_element_started(slot->channel, element, start_time_us, callbacks.context);
+  }
+}
+
+void KeyingChannelRouter::HandleElementFinished(PaddleElement element, int64_t end_time_us,
+                                                void* context) {
+  const auto* slot = static_cast<const Slot*>(context);
+  const KeyingChannelCallbacks& callbacks = slot->router->callbacks_;
+  if (callbacks.on_element_finished != nullptr) {
+    callbacks.on_element_finished(slot->channel, element, end_time_us, callbacks.context);
+  }
+}
+
+void KeyingChannelRouter::HandleDeadline(DeadlineKind kind, int64_t planned_us, int64_t actual_us,
+                                         void* context) {
+  const auto* slot = static_cast<const Slot*>(context);
+  const KeyingChannelCallbacks& callbacks = slot->router->callbacks_;
+  if (callbacks.on_deadline != nullptr) {
+    callbacks.on_deadline(slot->channel, kind, planned_us, actual_us, callbacks.context);
+  }
+}
+
+void KeyingChannelRouter::HandleKeyStateChanged(bool key_active, int64_t timestamp_us,
+                                                void* context) {
+  const auto* slot = static_cast<const Slot*>(context);
+  slot->router->OnChannelKey(slot->channel, key_active, timestamp_us);
+}
+
+void KeyingChannelRouter::OnChannelKey(uint8_t channel, bool key_active, int64_t timestamp_us) {
+  key_active_[channel] = key_active;
+  // TX/sidetone of this radio first, the shared stream after
+  if (callbacks_.on_key_state_changed != nullptr) {
+    callbacks_.on_key_state_changed(channel, key_active, timestamp_us, callbacks_.context);
+  }
+
+  if (key_active) {
+    if (channel == focus_ && streamed_channel_ == kNoChannel) {
+      ForwardFocusKey(channel, true, timestamp_us);
+    }
+    return;
+  }
+  if (channel != streamed_channel_) {
+    return;
+  }
+  ForwardFocusKey(channel, false, timestamp_us);
+  // The focused radio started keying while the previous one finished its element:
+  // hand the stream over so its element is not lost
+  if (focus_ != channel && key_active_[focus_]) {
+    ForwardFocusKey(focus_, true, timestamp_us);
+  }
+}
+
+void KeyingChannelRouter::ForwardFocusKey(uint8_t channel, bool key_active,
+                                          int64_t timestamp_us) {
+  streamed_channel_ = key_active ? static_cast<int8_t>(channel) : kNoChannel;
+  if (callbacks_.on_focus_key_changed != nullptr) {
+    callbacks_.on_focus_key_changed(key_active, timestamp_us, callbacks_.context);
+  }
+}
+
+}  // namespace keying
@@ -1,9 +1,12 @@
 #include "keying/paddle_engine.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cinttypes>
+#include <limits>
 #include "esp_log.h"
 #include "hal/high_precision_clock.hpp"
+#include "keying/iambic_policy.hpp"
 
 namespace keying {
 namespace {
@@ -21,6 +24,48 @@ inline PaddleElement ElementForLine(hal::PaddleLine line) {
                                          : PaddleElement::kDit;
 }
 
+inline PaddleElement OppositeElement(PaddleElement element) {
+  return (element == PaddleElement::kDit) ? PaddleElement::kDah : PaddleElement::kDit;
+}
+
+// Same float arithmetic as PaddleEngine::GetElementProgressPct(), so the specialized
+// FSM's precomputed window edges land on exactly the ticks the generic FSM accepts
+inline float ProgressPct(int64_t elapsed_us, int64_t duration_us) {
+  return (static_cast<float>(elapsed_us) / static_cast<float>(duration_us)) * 100.0f;
+}
+
+constexpr int64_t kNeverUs = std::numeric_limits<int64_t>::max() / 2;
+
+// First elapsed time at which progress >= pct (progress is monotonic in elapsed)
+int64_t FirstElapsedAtOrAbove(float pct, int64_t duration_us) {
+  if (duration_us <= 0) {
+    return (pct <= 0.0f) ? 0 : kNeverUs;
+  }
+  int64_t elapsed = static_cast<int64_t>(static_cast<double>(pct) * duration_us / 100.0);
+  while (elapsed > 0 && ProgressPct(elapsed - 1, duration_us) >= pct) {
+    --elapsed;
+  }
+  while (ProgressPct(elapsed, duration_us) < pct) {
+    ++elapsed;
+  }
+  return elapsed;
+}
+
+// Last elapsed time at which progress <= pct
+int64_t LastElapsedAtOrBelow(float pct, int64_t duration_us) {
+  if (duration_us <= 0) {
+    return (pct >= 0.0f) ? kNeverUs : -1;
+  }
+  int64_t elapsed = static_cast<int64_t>(static_cast<double>(pct) * duration_us / 100.0);
+  while (ProgressPct(elapsed + 1, duration_us) <= pct) {
+    ++elapsed;
+  }
+  while (elapsed >= 0 && ProgressPct(elapsed, duration_us) > pct) {
+    --elapsed;
+  }
+  return elapsed;
+}
+
 }  // namespace
 
 bool PaddleEngine::Initialize(const PaddleEngineConfig& config,
@@ -64,8 +109,15 @@ bool PaddleEngine::Initialize(const PaddleEngineConfig& config,
     return false;
   }
 
+  if (config.manual_debounce_us < 0) {
+    ESP_LOGE(kLogTag, "Initialize failed: manual_debounce_us must be >= 0");
+    return false;
+  }
+
   config_ = config;
   callbacks_ = callbacks;
+  ops_ = SelectFsmOps(config);
+  manual_key_.Configure(config.manual_debounce_us);
 
   Reset();
   return true;
@@ -78,6 +130,8 @@ void PaddleEngine::Reset() {
   last_element_ = PaddleElement::kDah;
   element_start_us_ = 0;
   element_end_us_ = 0;
+  mem_window_open_us_ = 0;
+  mem_window_close_us_ = 0;
   gap_start_us_ = 0;
   gap_end_us_ = 0;
   dit_pressed_ = false;
@@ -91,13 +145,21 @@ void PaddleEngine::Reset() {
   // Clear squeeze flags (Task 4.1)
   squeeze_seen_this_element_ = false;
   last_valid_combo_ = PaddleCombo::kNone;
+
+  iambic_key_active_ = false;
+  manual_key_active_ = false;
+  key_output_ = false;
+  manual_key_.Reset();
 }
 
 void PaddleEngine::OnPaddleEvent(const hal::PaddleEvent& event) {
   // Task 2.10 & 4.4: Update paddle state and squeeze tracking
 
-  // Ignore straight key events (we only handle iambic paddles)
-  if (event.line == hal::PaddleLine::kKey) {
+  // Manual key: straight to the output, no FSM and no logging before the callbacks
+  if (IsManualLine(event.line)) {
+    if (manual_key_.OnEdge(event.active, event.timestamp_us)) {
+      OnManualKeyChanged(event.active, event.timestamp_us);
+    }
     return;
   }
 
@@ -119,10 +181,15 @@ void PaddleEngine::OnPaddleEvent(const hal::PaddleEvent& event) {
   }
 
   // Update paddle state with squeeze mode logic
-  UpdatePaddles(dit_pressed_, dah_pressed_);
+  (this->*ops_.update_paddles)(dit_pressed_, dah_pressed_);
 }
 
 void PaddleEngine::Tick(int64_t now_us) {
+  // Manual key contact that settled during the debounce lockout
+  if (manual_key_.Poll(now_us)) {
+    OnManualKeyChanged(manual_key_.state(), now_us);
+  }
+
   switch (state_) {
     case State::kIdle: {
       // Task 2.7: IDLE state handling
@@ -169,7 +236,7 @@ void PaddleEngine::Tick(int64_t now_us) {
     case State::kSendDah: {
       // Task 2.8 & 3.6: Element state handling
       // Check for memory arming and squeeze detection during element
-      CheckMemoryAndSqueezeDuringElement(now_us);
+      (this->*ops_.check_memory)(now_us);
 
       // Check if element duration has elapsed
       if (now_us >= element_end_us_) {
@@ -178,6 +245,10 @@ void PaddleEngine::Tick(int64_t now_us) {
         // Gap cannot be skipped even when queue has elements, otherwise decoder
         // cannot distinguish individual elements within a character
         EnterGap(element_end_us_);
+        // After the key output: the report must not delay the edge it measures
+        if (callbacks_.on_deadline != nullptr) {
+          callbacks_.on_deadline(DeadlineKind::kElementEnd, element_end_us_, now_us, callbacks_.context);
+        }
       }
       break;
     }
@@ -191,12 +262,46 @@ void PaddleEngine::Tick(int64_t now_us) {
                  (long long)(now_us - gap_start_us_));
         state_ = State::kIdle;
         Tick(now_us);  // Immediately check if we should start next element
+        // An element started straight out of the gap was due at the gap end
+        if (state_ != State::kIdle && callbacks_.on_deadline != nullptr) {
+          callbacks_.on_deadline(DeadlineKind::kElementStart, gap_end_us_, now_us, callbacks_.context);
+        }
       }
       break;
     }
   }
 }
 
+bool PaddleEngine::IsManualLine(hal::PaddleLine line) const {
+  return line == hal::PaddleLine::kKey ||
+         (config_.bug_mode && line == hal::PaddleLine::kDah);
+}
+
+void PaddleEngine::OnManualKeyChanged(bool active, int64_t timestamp_us) {
+  manual_key_active_ = active;
+  // Key output first (TX + sidetone); the element callbacks only feed the timeline
+  UpdateKeyOutput(timestamp_us);
+  if (active) {
+    if (callbacks_.on_element_started != nullptr) {
+      callbacks_.on_element_started(PaddleElement::kManual, timestamp_us, callbacks_.context);
+    }
+  } else if (callbacks_.on_element_finished != nullptr) {
+    callbacks_.on_element_finished(PaddleElement::kManual, timestamp_us, callbacks_.context);
+  }
+  ESP_LOGD(kLogTag, "MANUAL key %s @ %lld us", active ? "DOWN" : "UP", timestamp_us);
+}
+
+void PaddleEngine::UpdateKeyOutput(int64_t timestamp_us) {
+  const bool active = iambic_key_active_ || manual_key_active_;
+  if (active == key_output_) {
+    return;
+  }
+  key_output_ = active;
+  if (callbacks_.on_key_state_changed != nullptr) {
+    callbacks_.on_key_state_changed(active, timestamp_us, callbacks_.context);
+  }
+}
+
 void PaddleEngine::StartElement(PaddleElement element, int64_t start_time_us) {
   // Calculate element duration based on type
   const int64_t duration = (element == PaddleElement::kDit) ? DitDurationUs()
@@ -209,6 +314,10 @@ void PaddleEngine::StartElement(PaddleElement element, int64_t start_time_us) {
   current_element_ = element;
   element_start_us_ = start_time_us;
   element_end_us_ = start_time_us + duration;
+  mem_window_open_us_ =
+      start_time_us + FirstElapsedAtOrAbove(config_.mem_block_start_pct, duration);
+  mem_window_close_us_ =
+      start_time_us + LastElapsedAtOrBelow(config_.mem_block_end_pct, duration);
 
   ESP_LOGI(kLogTag, "→ START %s @ %lld us | planned_dur=%lld us | target_end=%lld us | queue=%zu",
            (element == PaddleElement::kDit) ? "DIT" : "DAH",
@@ -228,9 +337,8 @@ void PaddleEngine::StartElement(PaddleElement element, int64_t start_time_us) {
   if (callbacks_.on_element_started != nullptr) {
     callbacks_.on_element_started(element, start_time_us, callbacks_.context);
   }
-  if (callbacks_.on_key_state_changed != nullptr) {
-    callbacks_.on_key_state_changed(true, start_time_us, callbacks_.context);
-  }
+  iambic_key_active_ = true;
+  UpdateKeyOutput(start_time_us);
 }
 
 void PaddleEngine::FinishElement(int64_t timestamp_us) {
@@ -246,6 +354,18 @@ void PaddleEngine::FinishElement(int64_t timestamp_us) {
            timing_error_us,
            (planned_duration_us > 0 ? (100.0 * timing_error_us / planned_duration_us) : 0.0));
 
+  (this->*ops_.queue_memory)();
+
+  // Task 5.2: Invoke callbacks - CRITICAL: Call IMMEDIATELY without logging first
+  // Reason: ESP_LOGI can take 20-60ms, introducing unacceptable audio timing latency
+  if (callbacks_.on_element_finished != nullptr) {
+    callbacks_.on_element_finished(current_element_, timestamp_us, callbacks_.context);
+  }
+  iambic_key_active_ = false;
+  UpdateKeyOutput(timestamp_us);
+}
+
+void PaddleEngine::QueueMemoryAndBonus() {
   // Save memory flags state BEFORE consuming (needed for Mode B bonus check)
   const bool memory_armed_dit = dot_requested_;
   const bool memory_armed_dah = dah_requested_;
@@ -305,15 +425,6 @@ void PaddleEngine::FinishElement(int64_t timestamp_us) {
       ESP_LOGD(kLogTag, "  Mode B bonus SKIPPED: last_valid_combo is BOTH");
     }
   }
-
-  // Task 5.2: Invoke callbacks - CRITICAL: Call IMMEDIATELY without logging first
-  // Reason: ESP_LOGI can take 20-60ms, introducing unacceptable audio timing latency
-  if (callbacks_.on_element_finished != nullptr) {
-    callbacks_.on_element_finished(current_element_, timestamp_us, callbacks_.context);
-  }
-  if (callbacks_.on_key_state_changed != nullptr) {
-    callbacks_.on_key_state_changed(false, timestamp_us, callbacks_.context);
-  }
 }
 
 void PaddleEngine::EnterGap(int64_t now_us) {
@@ -498,6 +609,126 @@ void PaddleEngine::UpdatePaddles(bool dit, bool dah) {
   }
 }
 
+// Specialized FSM: same decisions as CheckMemoryAndSqueezeDuringElement(), but the
+// memory mode is folded into Policy::kArmTable and the window is an integer compare
+template <typename Policy>
+void PaddleEngine::CheckMemoryAndSqueezeSpecialized(int64_t now_us) {
+  if (now_us < mem_window_open_us_ || now_us > mem_window_close_us_) {
+    return;
+  }
+
+  const size_t combo = (dit_pressed_ ? 1u : 0u) | (dah_pressed_ ? 2u : 0u);
+  const uint8_t action = Policy::kArmTable[combo][IndexForElement(current_element_)];
+  const auto& hooks = callbacks_.timeline_hooks;
+
+  if constexpr (Policy::kDitMemory) {
+    if ((action & arm_action::kArmDit) != 0 && !dot_requested_) {
+      dot_requested_ = true;
+      if ((action & arm_action::kNotifyMemory) != 0 && hooks.OnMemoryWindowChanged != nullptr) {
+        hooks.OnMemoryWindowChanged(false, true, now_us, hooks.context);
+      }
+    }
+  }
+  if constexpr (Policy::kDahMemory) {
+    if ((action & arm_action::kArmDah) != 0 && !dah_requested_) {
+      dah_requested_ = true;
+      if ((action & arm_action::kNotifyMemory) != 0 && hooks.OnMemoryWindowChanged != nullptr) {
+        hooks.OnMemoryWindowChanged(true, true, now_us, hooks.context);
+      }
+    }
+  }
+  if ((action & arm_action::kSqueeze) != 0 && !squeeze_seen_this_element_) {
+    squeeze_seen_this_element_ = true;
+    if (hooks.OnSqueezeDetected != nullptr) {
+      hooks.OnSqueezeDetected(now_us, hooks.context);
+    }
+  }
+}
+
+template <typename Policy>
+void PaddleEngine::QueueMemoryAndBonusSpecialized() {
+  const bool memory_armed_dit = dot_requested_;
+  const bool memory_armed_dah = dah_requested_;
+
+  if constexpr (Policy::kDitMemory) {
+    if (memory_armed_dit) {
+      queue_.push_back(PaddleElement::kDit);
+      dot_requested_ = false;
+    }
+  }
+  if constexpr (Policy::kDahMemory) {
+    if (memory_armed_dah) {
+      queue_.push_back(PaddleElement::kDah);
+      dah_requested_ = false;
+    }
+  }
+
+  if constexpr (Policy::kModeB) {
+    if (squeeze_seen_this_element_ && last_valid_combo_ != PaddleCombo::kBoth) {
+      const PaddleElement bonus = OppositeElement(current_element_);
+      const bool already_queued_by_memory =
+          (bonus == PaddleElement::kDit) ? memory_armed_dit : memory_armed_dah;
+      if (!already_queued_by_memory) {
+        queue_.push_back(bonus);
+      }
+    }
+  }
+}
+
+template <typename Policy>
+void PaddleEngine::UpdatePaddlesSpecialized(bool dit, bool dah) {
+  dit_pressed_ = dit;
+  dah_pressed_ = dah;
+  const PaddleCombo combo = GetComboNow();
+  if constexpr (Policy::kLiveSqueeze) {
+    last_valid_combo_ = combo;
+  } else if (combo != PaddleCombo::kNone) {
+    last_valid_combo_ = combo;
+  }
+}
+
+template <typename Policy>
+constexpr PaddleEngine::FsmOps PaddleEngine::SpecializedOps() {
+  return FsmOps{&PaddleEngine::CheckMemoryAndSqueezeSpecialized<Policy>,
+                &PaddleEngine::QueueMemoryAndBonusSpecialized<Policy>,
+                &PaddleEngine::UpdatePaddlesSpecialized<Policy>};
+}
+
+PaddleEngine::FsmOps PaddleEngine::SelectFsmOps(const PaddleEngineConfig& config) {
+  if (config.fsm_variant == FsmVariant::kGeneric) {
+    return FsmOps{&PaddleEngine::CheckMemoryAndSqueezeDuringElement,
+                  &PaddleEngine::QueueMemoryAndBonus,
+                  &PaddleEngine::UpdatePaddles};
+  }
+
+  using I = IambicMode;
+  using M = MemoryMode;
+  using S = SqueezeMode;
+  // Indexed by [iambic_mode][memory_mode][squeeze_mode]
+  static constexpr FsmOps kOps[2][4][2] = {
+      {{SpecializedOps<IambicPolicy<I::kA, M::kNone, S::kSnapshot>>(),
+        SpecializedOps<IambicPolicy<I::kA, M::kNone, S::kLive>>()},
+       {SpecializedOps<IambicPolicy<I::kA, M::kDotOnly, S::kSnapshot>>(),
+        SpecializedOps<IambicPolicy<I::kA, M::kDotOnly, S::kLive>>()},
+       {SpecializedOps<IambicPolicy<I::kA, M::kDahOnly, S::kSnapshot>>(),
+        SpecializedOps<IambicPolicy<I::kA, M::kDahOnly, S::kLive>>()},
+       {SpecializedOps<IambicPolicy<I::kA, M::kDotAndDah, S::kSnapshot>>(),
+        SpecializedOps<IambicPolicy<I::kA, M::kDotAndDah, S::kLive>>()}},
+      {{SpecializedOps<IambicPolicy<I::kB, M::kNone, S::kSnapshot>>(),
+        SpecializedOps<IambicPolicy<I::kB, M::kNone, S::kLive>>()},
+       {SpecializedOps<IambicPolicy<I::kB, M::kDotOnly, S::kSnapshot>>(),
+        SpecializedOps<IambicPolicy<I::kB, M::kDotOnly, S::kLive>>()},
+       {SpecializedOps<IambicPolicy<I::kB, M::kDahOnly, S::kSnapshot>>(),
+        SpecializedOps<IambicPolicy<I::kB, M::kDahOnly, S::kLive>>()},
+       {SpecializedOps<IambicPolicy<I::kB, M::kDotAndDah, S::kSnapshot>>(),
+        SpecializedOps<IambicPolicy<I::kB, M::kDotAndDah, S::kLive>>()}},
+  };
+  const auto iambic = static_cast<size_t>(config.iambic_mode) & 0x1u;
+  const auto memory = static_cast<size_t>(config.memory_mode) & 0x3u;
+  const auto squeeze = static_cast<size_t>(config.squeeze_mode) & 0x1u;
+  return kOps[iambic][memory][squeeze];
+}
+
 int64_t PaddleEngine::DitDurationUs() const {
   // Timing chain: WPM → dit_theoretical → P → dit_effective
   // 1. Calculate theoretical dit duration from WPM (standard: 1.2s / wpm)
@@ -585,11 +816,12 @@ void PaddleEngine::DumpState(int64_t now_us) const {
   ESP_LOGI(kLogTag, "  Now: %lld us, Gap end: %lld us",
            (long long)now_us, (long long)gap_end_us_);
   ESP_LOGI(kLogTag, "  Paddle state: dit=%d dah=%d", dit_pressed_, dah_pressed_);
-  ESP_LOGI(kLogTag, "  Config: WPM=%lu, mode=%d, mem=%d, squeeze=%d",
+  ESP_LOGI(kLogTag, "  Config: WPM=%lu, mode=%d, mem=%d, squeeze=%d, fsm=%s",
            (unsigned long)config_.speed_wpm,
            (int)config_.iambic_mode,
            (int)config_.memory_mode,
-           (int)config_.squeeze_mode);
+           (int)config_.squeeze_mode,
+           (config_.fsm_variant == FsmVariant::kGeneric) ? "generic" : "specialized");
   ESP_LOGI(kLogTag, "  Config: mem_block_start=%.1f%%, mem_block_end=%.1f%%",
            config_.mem_block_start_pct,
            config_.mem_block_end_pct);
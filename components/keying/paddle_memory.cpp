@@ -0,0 +1,82 @@
+#include "keying/paddle_memory.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace keying {
+
+PaddleMemoryRecorder::PaddleMemoryRecorder() : writer_(buffer_, sizeof(buffer_)) {}
+
+void PaddleMemoryRecorder::Start() {
+  writer_ = timeline::EdgeStreamWriter(buffer_, sizeof(buffer_));
+  size_ = 0;
+  active_ = true;
+}
+
+void PaddleMemoryRecorder::OnKeyEdge(bool key_active, int64_t timestamp_us) {
+  if (active_) {
+    writer_.Add(key_active, timestamp_us);
+  }
+}
+
+size_t PaddleMemoryRecorder::Stop(int64_t timestamp_us) {
+  if (!active_) {
+    return size_;
+  }
+  active_ = false;
+  writer_.Add(false, timestamp_us);
+  size_ = writer_.count() > 0 ? writer_.Finish() : 0;
+  return size_;
+}
+
+bool PaddleMemoryPlayer::Start(const uint8_t* data, size_t size, uint16_t speed_pct,
+                               int64_t start_us) {
+  if (data == nullptr || size > sizeof(buffer_) || !timeline::ValidateEdgeStream(data, size)) {
+    return false;
+  }
+  if (timeline::EdgeStreamReader(data, size).count() == 0) {
+    return false;
+  }
+
+  std::memcpy(buffer_, data, size);
+  reader_ = timeline::EdgeStreamReader(buffer_, size);
+  speed_pct_ = std::clamp(speed_pct, kPaddleMemoryMinSpeedPct, kPaddleMemoryMaxSpeedPct);
+  start_us_ = start_us;
+  key_active_ = false;
+  active_ = true;
+  Advance();
+  return true;
+}
+
+bool PaddleMemoryPlayer::Stop() {
+  const bool was_down = active_ && key_active_;
+  active_ = false;
+  key_active_ = false;
+  return was_down;
+}
+
+bool PaddleMemoryPlayer::PopDue(int64_t now_us, Edge* edge) {
+  if (!active_ || now_us < next_.timestamp_us) {
+    return false;
+  }
+  *edge = next_;
+  key_active_ = next_.key_active;
+  Advance();
+  return true;
+}
+
+void PaddleMemoryPlayer::Advance() {
+  bool key_active = false;
+  int64_t offset_us = 0;
+  if (!reader_.Next(&key_active, &offset_us)) {
+    // Streams end key-up (EdgeStreamWriter::Finish), so nothing is left keyed
+    active_ = false;
+    return;
+  }
+  next_ = Edge{
+      .key_active = key_active,
+      .timestamp_us = start_us_ + offset_us * 100 / speed_pct_,
+  };
+}
+
+}  // namespace keying
@@ -0,0 +1,46 @@
+#include "keying/straight_key.hpp"
+
+namespace keying {
+
+void StraightKeyDebouncer::Configure(int64_t lockout_us) {
+  lockout_us_ = lockout_us < 0 ? 0 : lockout_us;
+}
+
+void StraightKeyDebouncer::Reset() {
+  state_ = false;
+  raw_ = false;
+  changed_ = false;
+  last_change_us_ = 0;
+  rejected_edges_ = 0;
+}
+
+bool StraightKeyDebouncer::LockedOut(int64_t timestamp_us) const {
+  return changed_ && (timestamp_us - last_change_us_) < lockout_us_;
+}
+
+bool StraightKeyDebouncer::OnEdge(bool active, int64_t timestamp_us) {
+  raw_ = active;
+  if (active == state_) {
+    return false;
+  }
+  if (LockedOut(timestamp_us)) {
+    ++rejected_edges_;
+    return false;
+  }
+  state_ = active;
+  changed_ = true;
+  last_change_us_ = timestamp_us;
+  return true;
+}
+
+bool StraightKeyDebouncer::Poll(int64_t now_us) {
+  if (raw_ == state_ || LockedOut(now_us)) {
+    return false;
+  }
+  state_ = raw_;
+  changed_ = true;
+  last_change_us_ = now_us;
+  return true;
+}
+
+}  // namespace keying
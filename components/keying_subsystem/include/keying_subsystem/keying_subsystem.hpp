@@ -24,6 +24,10 @@
  * - Initialize and configure PaddleEngine from DeviceConfig
  * - Log paddle events and keying elements to timeline::EventLogger
  * - Expose engine reference for runtime config updates (console commands)
+ * - SO2R: one engine, TX output and sidetone pitch/pan per keying channel
+ *   (keying::KeyingChannelRouter); all paddle HALs share the one ISR queue
+ * - Paddle memories: record the focused key stream as an edge stream and replay
+ *   it through the same TX/sidetone/remote/decoder path
  *
  * USAGE PATTERN:
  * ```
@@ -39,13 +43,20 @@
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/queue.h"
+#include "freertos/task.h"
 #include "hal/paddle_hal.hpp"
+#include "esp_timer.h"
+#include "keying/deadline_monitor.hpp"
+#include "keying/keying_channels.hpp"
+#include "keying/paddle_memory.hpp"
 #include "keying/paddle_engine.hpp"
 #include "timeline/event_logger.hpp"
+#include "timeline/timeline_capture.hpp"
 #include "config/device_config.hpp"
 
 #include <atomic>
 #include <cstddef>
+#include <mutex>
 
 // Forward declarations to avoid circular dependencies
 namespace hal {
@@ -66,6 +77,7 @@ class DiagnosticsSubsystem;
 
 namespace morse_decoder {
 class AdaptiveTimingClassifier;
+class DecoderService;
 class MorseDecoder;
 }
 
@@ -100,9 +112,10 @@ class KeyingSubsystem {
   // Timeline event capacity - sized for session recording and diagnostics export
   // Rationale: Stores complete event history (paddle edges + keying elements) for analysis.
   // At 80 WPM sustained: ~8.8 paddle events/sec + ~4.4 keying events/sec ≈ 13 events/sec.
-  // 1024 slots = 78 seconds of continuous operation before ring buffer wraps.
+  // 3072 slots = ~4 minutes of continuous operation before ring buffer wraps.
   // Sufficient for capturing error sequences and exporting to analysis tools.
-  static constexpr size_t kTimelineCapacity = 1024;
+  // Memory cost: 8-byte packed slots (timeline::PackedEvent) = ~25 KB RAM.
+  static constexpr size_t kTimelineCapacity = timeline::kTimelineCapacity;
 
   KeyingSubsystem();
   ~KeyingSubsystem();
@@ -126,15 +139,88 @@ class KeyingSubsystem {
   void Tick(int64_t now_us);
 
   /**
-   * @brief Get direct reference to paddle engine for config updates.
+   * @brief Get direct reference to paddle engine for config updates (radio 1).
    */
-  keying::PaddleEngine& GetEngine() { return paddle_engine_; }
+  keying::PaddleEngine& GetEngine() { return channels_.engine(0); }
+
+  /**
+   * @brief Get the SO2R channel router (focus, per-channel engines and key state).
+   */
+  const keying::KeyingChannelRouter& GetChannels() const { return channels_; }
+
+  /**
+   * @brief Move the main paddle to another keying channel (console/web control).
+   * @param channel Keying channel (0 = radio 1)
+   * @return false if the channel is not configured or the queue is full
+   *
+   * Posts a PaddleLine::kFocus event to the paddle queue, so the switch is ordered
+   * with paddle edges already queued, and wakes the keying loop.
+   */
+  bool RequestFocus(uint8_t channel);
+
+  /**
+   * @brief Start recording the focused key stream into the paddle memory buffer.
+   * @return false while a memory is replaying
+   *
+   * Thread-safe (console/web). Edges keep their exact paddle timestamps; the
+   * recording starts at the first key-down.
+   */
+  bool StartMemoryRecording();
+
+  /**
+   * @brief Stop recording and copy the edge stream (timeline::EdgeStreamWriter format).
+   * @param out Destination buffer (keying::kPaddleMemoryMaxBytes is always enough)
+   * @return Stream length, 0 if not recording, nothing keyed or out too small
+   */
+  size_t StopMemoryRecording(uint8_t* out, size_t capacity);
+
+  /**
+   * @brief Replay a recorded edge stream on the focused radio.
+   * @param speed_pct Replay speed in percent of the recorded speed (100 = as keyed)
+   * @return false if recording, already replaying or the stream is invalid
+   *
+   * Thread-safe (console/web). Edges go out at their scheduled microsecond: an
+   * esp_timer wakes the keying loop for each edge instead of waiting for its tick.
+   * Any paddle press aborts the replay.
+   */
+  bool PlayMemory(const uint8_t* data, size_t size, uint16_t speed_pct);
+
+  /**
+   * @brief Abort a replay at the next keying loop pass (thread-safe).
+   */
+  void AbortMemoryPlayback();
+
+  bool IsRecordingMemory() const;
+  bool IsPlayingMemory() const;
+
+  /**
+   * @brief Key the focused radio from a host-driven sender (WinKeyer port)
+   * @param timestamp_us Scheduled edge time (may be slightly in the past)
+   *
+   * Same output path as a paddle memory edge: TX, sidetone, timeline, remote and
+   * decoder. Main loop only.
+   */
+  void OutputHostKeyEdge(bool key_active, int64_t timestamp_us) {
+    OutputMemoryEdge(key_active, timestamp_us);
+  }
 
   /**
    * @brief Get timeline logger for diagnostics/export.
    */
   timeline::EventLogger<kTimelineCapacity>& GetTimeline() { return timeline_logger_; }
 
+  /**
+   * @brief Trigger-based snapshots of the timeline (late element, queue overflows,
+   *        audio underrun); armed from general.capture_* config.
+   */
+  timeline::TimelineCapture& GetTimelineCapture() { return timeline_capture_; }
+
+  /**
+   * @brief Planned-vs-actual keying edge lateness and deadline misses
+   *        (main loop stage timings are fed by ApplicationController::Run()).
+   */
+  keying::DeadlineMonitor& GetDeadlineMonitor() { return deadline_monitor_; }
+
   /**
    * @brief Get number of dropped paddle events (queue overflow).
    */
@@ -146,7 +232,9 @@ class KeyingSubsystem {
    * @brief Debug: Dump complete paddle engine state (for troubleshooting lockups).
    */
   void DumpEngineState(int64_t now_us) const {
-    paddle_engine_.DumpState(now_us);
+    for (size_t i = 0; i < channels_.channel_count(); ++i) {
+      channels_.engine(i).DumpState(now_us);
+    }
   }
 
   /**
@@ -159,6 +247,12 @@ class KeyingSubsystem {
    */
   static keying::PaddleEngineConfig BuildEngineConfig(const config::DeviceConfig& device_config);
 
+  /**
+   * @brief Engine config of one SO2R channel: BuildEngineConfig() plus the radio's speed override.
+   */
+  static keying::PaddleEngineConfig BuildChannelEngineConfig(
+      const config::DeviceConfig& device_config, size_t channel);
+
   /**
    * @brief Apply runtime configuration changes (hot-reload).
    *
@@ -178,7 +272,18 @@ class KeyingSubsystem {
    * @brief Set TX HAL reference (injected from ApplicationController).
    * @param tx_hal Pointer to TxHal instance (non-owning)
    */
-  void SetTxHal(hal::TxHal* tx_hal) { tx_hal_ = tx_hal; }
+  void SetTxHal(hal::TxHal* tx_hal) { channel_tx_[0] = tx_hal; }
+
+  /**
+   * @brief Set the TX output of an SO2R keying channel (channel 0 = SetTxHal()).
+   * @param channel Keying channel (0..kMaxKeyingChannels-1)
+   * @param tx_hal Pointer to TxHal instance (non-owning), nullptr = sidetone only
+   */
+  void SetChannelTxHal(size_t channel, hal::TxHal* tx_hal) {
+    if (channel < config::kMaxKeyingChannels) {
+      channel_tx_[channel] = tx_hal;
+    }
+  }
 
   /**
    * @brief Set Audio Subsystem reference (injected from ApplicationController).
@@ -198,6 +303,54 @@ class KeyingSubsystem {
     ptt_tail_ms_ = ptt_tail_ms;
   }
 
+  /**
+   * @brief Set the task running DrainPaddleEvents()/Tick() (the main loop).
+   * @param task Task handle (non-owning), nullptr to disable wake-ups
+   *
+   * Manual key edges (straight key, dah paddle in bug mode) notify this task from the
+   * ISR so the loop can wait with ulTaskNotifyTake() and process the edge immediately
+   * instead of at its next 1 ms tick. Iambic paddle edges keep the tick cadence.
+   */
+  void SetWakeTask(TaskHandle_t task) { wake_task_ = task; }
+
+  /// Raw paddle edge observer, called from the paddle ISR (must be in IRAM)
+  using PaddleTap = void (*)(const hal::PaddleEvent& event, BaseType_t* higher_priority_task_woken,
+                             void* context);
+  /// Keyed output observer (any radio keyed), called right after TX and sidetone
+  using KeyTap = void (*)(bool key_active, int64_t timestamp_us, void* context);
+  /// Paddle press observer for a host-driven sender (main loop context)
+  using BreakIn = void (*)(int64_t timestamp_us, void* context);
+
+  /**
+   * @brief Mirror raw paddle edges to an external sink (USB HID keyboard output)
+   *
+   * The tap runs inside RecordPaddleEvent(), ahead of the keying loop, so the sink
+   * does not wait for the main loop tick. Set before the paddle ISR is enabled.
+   */
+  void SetPaddleTap(PaddleTap tap, void* context) {
+    paddle_tap_context_ = context;
+    paddle_tap_ = tap;
+  }
+
+  /**
+   * @brief Mirror the keyed output to an external sink (main loop context)
+   */
+  void SetKeyTap(KeyTap tap, void* context) {
+    key_tap_context_ = context;
+    key_tap_ = tap;
+  }
+
+  /**
+   * @brief Let a host-driven sender (WinKeyer port) release the key on a paddle press
+   *
+   * Called from DrainPaddleEvents() before the engine sees the press, like a paddle
+   * memory replay stop, so a key-up from the sender cannot cut the paddle element.
+   */
+  void SetBreakIn(BreakIn break_in, void* context) {
+    break_in_context_ = context;
+    break_in_ = break_in;
+  }
+
   /**
    * @brief Set Diagnostics Subsystem reference (injected from ApplicationController).
    * @param diagnostics_subsystem Pointer to DiagnosticsSubsystem instance (non-owning)
@@ -210,42 +363,28 @@ class KeyingSubsystem {
   }
 
   /**
-   * @brief Set Morse Decoder Timing Classifier reference (injected from ApplicationController).
-   * @param timing_classifier Pointer to AdaptiveTimingClassifier instance (non-owning)
+   * @brief Set the multi-stream decoder service (injected from ApplicationController).
+   * @param decoder_service Pointer to DecoderService instance (non-owning)
    *
-   * The timing classifier receives all keying state changes and adaptively learns
-   * dit/dah timing parameters. Used by full morse decoder in Phase 2.
+   * Every local keying state change is forwarded as a KeySource::kLocal edge; the
+   * service classifies the durations and decodes them to text. Tick() also runs the
+   * inactivity timeouts of all streams (local and remote).
    */
-  void SetTimingClassifier(morse_decoder::AdaptiveTimingClassifier* timing_classifier) {
-    timing_classifier_ = timing_classifier;
+  void SetDecoderService(morse_decoder::DecoderService* decoder_service) {
+    decoder_service_ = decoder_service;
   }
 
   /**
-   * @brief Get Timing Classifier reference.
+   * @brief Get the timing classifier of the local key stream.
    * @return Pointer to timing classifier (may be nullptr)
    */
-  morse_decoder::AdaptiveTimingClassifier* GetTimingClassifier() const {
-    return timing_classifier_;
-  }
-
-  /**
-   * @brief Set morse decoder for real-time keying decoding (Phase 2)
-   * @param morse_decoder Morse decoder instance (non-owning pointer)
-   *
-   * The morse decoder receives classified keying events from the timing
-   * classifier and decodes them to text in real-time.
-   */
-  void SetMorseDecoder(morse_decoder::MorseDecoder* morse_decoder) {
-    morse_decoder_ = morse_decoder;
-  }
+  morse_decoder::AdaptiveTimingClassifier* GetTimingClassifier() const;
 
   /**
-   * @brief Get Morse Decoder reference.
+   * @brief Get the morse decoder of the local key stream.
    * @return Pointer to morse decoder (may be nullptr)
    */
-  morse_decoder::MorseDecoder* GetMorseDecoder() const {
-    return morse_decoder_;
-  }
+  morse_decoder::MorseDecoder* GetMorseDecoder() const;
 
   /**
    * @brief Set Timeline Event Emitter reference (injected from ApplicationController).
@@ -267,22 +406,101 @@ class KeyingSubsystem {
 
  private:
 
+  /// Sidetone of one keying channel, resolved from DeviceConfig by ApplyChannelTones()
+  struct ChannelTone {
+    uint16_t frequency_hz = 0;
+    int8_t pan = 0;
+  };
+
   /**
    * @brief Callback: keying element started (logs to timeline).
    */
-  static void HandleKeyingElementStarted(keying::PaddleElement element, int64_t start_time_us,
-                                         void* context);
+  static void HandleKeyingElementStarted(uint8_t channel, keying::PaddleElement element,
+                                         int64_t start_time_us, void* context);
 
   /**
    * @brief Callback: keying element finished (logs to timeline).
    */
-  static void HandleKeyingElementFinished(keying::PaddleElement element, int64_t end_time_us,
-                                          void* context);
+  static void HandleKeyingElementFinished(uint8_t channel, keying::PaddleElement element,
+                                          int64_t end_time_us, void* context);
+
+  /**
+   * @brief Callback: key state of one channel changed (TX output + sidetone).
+   */
+  static void HandleKeyingStateChanged(uint8_t channel, bool key_active, int64_t timestamp_us,
+                                       void* context);
 
   /**
-   * @brief Callback: key state changed (placeholder for remote protocol).
+   * @brief Callback: key stream of the focused radio changed (remote keying, decoder).
    */
-  static void HandleKeyingStateChanged(bool key_active, int64_t timestamp_us, void* context);
+  static void HandleFocusKeyChanged(bool key_active, int64_t timestamp_us, void* context);
+
+  /**
+   * @brief Remote keying (PTT) and decoder feed of the focused key stream.
+   */
+  void ForwardKeyStream(bool key_active, int64_t timestamp_us);
+
+  /**
+   * @brief Emit due paddle memory edges and arm the wake-up timer for the next one.
+   */
+  void TickMemoryPlayback(int64_t now_us);
+
+  /**
+   * @brief Key the focused radio from a replayed edge (TX, sidetone, timeline, remote, decoder).
+   */
+  void OutputMemoryEdge(bool key_active, int64_t timestamp_us);
+
+  /**
+   * @brief Stop a replay from the keying loop, releasing the key if it was down.
+   */
+  void StopMemoryPlayback(int64_t now_us);
+
+  /**
+   * @brief esp_timer callback: wake the keying loop for the next replay edge.
+   */
+  static void HandleMemoryTimer(void* arg);
+
+  /**
+   * @brief Callback: focus moved to another channel (logs to timeline).
+   */
+  static void HandleFocusChanged(uint8_t channel, int64_t timestamp_us, void* context);
+
+  /**
+   * @brief Callback: an engine produced a timed edge (deadline monitor).
+   */
+  static void HandleDeadline(uint8_t channel, keying::DeadlineKind kind, int64_t planned_us,
+                             int64_t actual_us, void* context);
+
+  /**
+   * @brief Record one edge; on a miss, name the task that ran most since the last snapshot.
+   */
+  void RecordDeadline(uint8_t channel, keying::DeadlineKind kind, int64_t planned_us,
+                      int64_t actual_us);
+
+  /**
+   * @brief Snapshot FreeRTOS run-time counters (baseline for miss attribution).
+   *
+   * Run from Tick() after the engines, in a tick where an element started: it
+   * suspends the scheduler to walk up to 32 tasks, so it must not sit between
+   * the element start and the key output.
+   */
+  void SnapshotTaskRuntime();
+
+  /**
+   * @brief Resolve per-channel sidetone pitch/pan (0 Hz = audio setting).
+   */
+  void ApplyChannelTones(const config::DeviceConfig& device_config);
+
+  /**
+   * @brief Configure every channel's engine from device config.
+   * @return false if any engine rejected its config
+   */
+  bool ConfigureChannels(const config::DeviceConfig& device_config);
+
+  /**
+   * @brief Switch the sidetone generator to a channel's pitch/pan (SO2R only).
+   */
+  void RetuneSidetone(size_t channel);
 
   /**
    * @brief Tick remote PTT management (call from Tick() main loop).
@@ -290,19 +508,59 @@ class KeyingSubsystem {
    */
   void TickRemotePtt(int64_t now_us);
 
-  keying::PaddleEngine paddle_engine_;
-  keying::PaddleEngineCallbacks paddle_callbacks_;
+  /**
+   * @brief Fire capture triggers on fault counter changes and freeze due captures.
+   * @param now_us Current timestamp in microseconds.
+   */
+  void TickCapture(int64_t now_us);
+
+  keying::KeyingChannelRouter channels_;
+  keying::KeyingChannelCallbacks channel_callbacks_;
+  ChannelTone channel_tones_[config::kMaxKeyingChannels]{};
+  uint8_t keyed_channels_ = 0;                   // Bit i set while channel i keys
   timeline::EventLogger<kTimelineCapacity> timeline_logger_;
+  timeline::TimelineCapture timeline_capture_;
+  int64_t element_started_us_[config::kMaxKeyingChannels]{};  // Late element trigger
+  bool runtime_snapshot_due_ = false;            // Element started: SnapshotTaskRuntime() at end of Tick()
+  keying::DeadlineMonitor deadline_monitor_;
+#if defined(CONFIG_FREERTOS_USE_TRACE_FACILITY) && defined(CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS)
+  static constexpr size_t kMaxRuntimeTasks = 32;
+  struct TaskRuntime {
+    TaskHandle_t handle;
+    uint32_t counter;
+  };
+  TaskStatus_t runtime_scratch_[kMaxRuntimeTasks];  // Main loop only (too large for its stack)
+  TaskRuntime runtime_baseline_[kMaxRuntimeTasks]{};  // Counters after the last element start
+  size_t runtime_baseline_count_ = 0;
+#endif
+  int64_t capture_next_check_us_ = 0;
+  uint32_t capture_remote_drops_ = 0;            // Fault counters at the last check
+  uint32_t capture_audio_underruns_ = 0;
   QueueHandle_t paddle_event_queue_;
   std::atomic<uint32_t> paddle_event_dropped_;
+  TaskHandle_t wake_task_ = nullptr;             // Notified on manual key edges and focus changes
+  std::atomic<bool> dah_is_manual_{false};       // Bug mode: dah line is a manual key
+  PaddleTap paddle_tap_ = nullptr;               // USB HID keyboard mirror (ISR context)
+  void* paddle_tap_context_ = nullptr;
+  KeyTap key_tap_ = nullptr;
+  void* key_tap_context_ = nullptr;
+  BreakIn break_in_ = nullptr;                   // WinKeyer paddle break-in
+  void* break_in_context_ = nullptr;
+
+  // Paddle memory record/replay (control calls arrive from console/web tasks)
+  mutable std::mutex memory_mutex_;
+  keying::PaddleMemoryRecorder memory_recorder_;
+  keying::PaddleMemoryPlayer memory_player_;
+  esp_timer_handle_t memory_timer_ = nullptr;
+  int64_t memory_timer_due_us_ = 0;              // Edge the timer is armed for
+  std::atomic<bool> memory_abort_requested_{false};
 
   // Injected dependencies (non-owning pointers)
-  hal::TxHal* tx_hal_ = nullptr;
+  hal::TxHal* channel_tx_[config::kMaxKeyingChannels]{};
   audio_subsystem::AudioSubsystem* audio_subsystem_ = nullptr;
   remote::RemoteCwClient* remote_client_ = nullptr;
   diagnostics_subsystem::DiagnosticsSubsystem* diagnostics_subsystem_ = nullptr;
-  morse_decoder::AdaptiveTimingClassifier* timing_classifier_ = nullptr;
-  morse_decoder::MorseDecoder* morse_decoder_ = nullptr;
+  morse_decoder::DecoderService* decoder_service_ = nullptr;
   timeline::TimelineEventEmitter* timeline_emitter_ = nullptr;
 
   // Remote PTT state
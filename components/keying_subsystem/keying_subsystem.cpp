@@ -1,7 +1,9 @@
 #include "keying_subsystem/keying_subsystem.hpp"
 
 #include <algorithm>
+#include <cstring>
 
+#include "audio/audio_stream_player.hpp"
 #include "audio_subsystem/audio_subsystem.hpp"
 #include "config/keying_presets.hpp"
 #include "diagnostics_subsystem/diagnostics_subsystem.hpp"
@@ -10,8 +12,7 @@
 #include "freertos/task.h"
 #include "hal/high_precision_clock.hpp"
 #include "hal/tx_hal.hpp"
-#include "morse_decoder/adaptive_timing_classifier.hpp"
-#include "morse_decoder/morse_decoder.hpp"
+#include "morse_decoder/decoder_service.hpp"
 #include "remote/remote_cw_client.hpp"
 #include "timeline/timeline_event_emitter.hpp"
 
@@ -19,16 +20,39 @@ namespace keying_subsystem {
 
 namespace {
 constexpr char kLogTag[] = "keying_subsystem";
+
+static_assert(config::kMaxKeyingChannels == keying::KeyingChannelRouter::kMaxChannels,
+              "SO2R config and router must agree on the channel limit");
+
+// Timeline arg0 of channel-tagged events: value in the low byte, channel/input set above
+inline uint32_t TagChannel(uint32_t value, uint8_t channel) {
+  return value | (static_cast<uint32_t>(channel) << 8);
+}
+
+// Fault counters are compared at this period; due captures are frozen at the same pass
+constexpr int64_t kCaptureCheckIntervalUs = 10000;
+
+timeline::CaptureConfig BuildCaptureConfig(const config::DeviceConfig& device_config) {
+  timeline::CaptureConfig capture_config;
+  capture_config.trigger_mask = device_config.general.capture_triggers;
+  capture_config.pre_ms = device_config.general.capture_pre_ms;
+  capture_config.post_ms = device_config.general.capture_post_ms;
+  return capture_config;
 }
+}  // namespace
 
 KeyingSubsystem::KeyingSubsystem()
-    : paddle_engine_(),
-      paddle_callbacks_{},
+    : channels_(),
+      channel_callbacks_{},
       timeline_logger_(),
       paddle_event_queue_(nullptr),
       paddle_event_dropped_(0) {}
 
 KeyingSubsystem::~KeyingSubsystem() {
+  if (memory_timer_ != nullptr) {
+    esp_timer_stop(memory_timer_);
+    esp_timer_delete(memory_timer_);
+  }
   if (paddle_event_queue_ != nullptr) {
     vQueueDelete(paddle_event_queue_);
   }
@@ -62,6 +86,11 @@ keying::PaddleEngineConfig KeyingSubsystem::BuildEngineConfig(
   engine_config.timing_s = keying_cfg.timing_s;
   engine_config.timing_p = keying_cfg.timing_p;
 
+  // Manual key lines (straight key input, dah paddle in bug mode)
+  engine_config.bug_mode = keying_cfg.bug_mode;
+  engine_config.manual_debounce_us =
+      static_cast<int64_t>(keying_cfg.straight_key_debounce_ms) * 1000;
+
   // Memory window percentages: both are positions from element start
   // - memory_open_percent: window opens at this % (0 = opens immediately)
   // - memory_close_percent: window closes at this % (100 = closes at element end)
@@ -99,6 +128,52 @@ keying::PaddleEngineConfig KeyingSubsystem::BuildEngineConfig(
   return engine_config;
 }
 
+keying::PaddleEngineConfig KeyingSubsystem::BuildChannelEngineConfig(
+    const config::DeviceConfig& device_config, size_t channel) {
+  keying::PaddleEngineConfig engine_config = BuildEngineConfig(device_config);
+  const config::So2rRadioConfig* radio = device_config.so2r.Radio(channel);
+  if (radio != nullptr && radio->speed_wpm != 0) {
+    engine_config.speed_wpm = radio->speed_wpm;
+  }
+  return engine_config;
+}
+
+bool KeyingSubsystem::ConfigureChannels(const config::DeviceConfig& device_config) {
+  bool ok = true;
+  for (size_t i = 0; i < channels_.channel_count(); ++i) {
+    const keying::PaddleEngineConfig engine_config = BuildChannelEngineConfig(device_config, i);
+    if (!channels_.Configure(static_cast<uint8_t>(i), engine_config)) {
+      ESP_LOGE(kLogTag, "Paddle engine of channel %u rejected its config",
+               static_cast<unsigned>(i));
+      ok = false;
+    }
+  }
+  return ok;
+}
+
+void KeyingSubsystem::ApplyChannelTones(const config::DeviceConfig& device_config) {
+  const config::So2rConfig& so2r = device_config.so2r;
+  for (size_t i = 0; i < config::kMaxKeyingChannels; ++i) {
+    const config::So2rRadioConfig* radio = so2r.Radio(i);
+    const uint16_t frequency_hz = radio != nullptr ? radio->sidetone_frequency_hz : 0;
+    channel_tones_[i] = ChannelTone{
+        .frequency_hz = frequency_hz != 0 ? frequency_hz
+                                          : device_config.audio.sidetone_frequency_hz,
+        .pan = radio != nullptr ? radio->sidetone_pan : so2r.radio1_pan,
+    };
+  }
+}
+
+void KeyingSubsystem::RetuneSidetone(size_t channel) {
+  // Single radio: leave the generator to AudioSubsystem::ApplyConfig()
+  if (audio_subsystem_ == nullptr || channels_.channel_count() < 2) {
+    return;
+  }
+  audio::SidetoneService& sidetone = audio_subsystem_->GetService();
+  sidetone.SetFrequency(channel_tones_[channel].frequency_hz);
+  sidetone.SetPan(channel_tones_[channel].pan);
+}
+
 void KeyingSubsystem::ApplyConfig(const config::DeviceConfig& device_config) {
   ESP_LOGI(kLogTag, "Applying runtime config changes");
 
@@ -118,8 +193,13 @@ void KeyingSubsystem::ApplyConfig(const config::DeviceConfig& device_config) {
              L, S, P, static_cast<float>(L) / 10.0f);
   }
 
-  // Reinitialize paddle engine with new config (callbacks remain the same)
-  paddle_engine_.Initialize(engine_config, paddle_callbacks_);
+  // Reinitialize every channel's engine with new config (callbacks remain the same).
+  // The channel count itself is reset_required and only read by Initialize().
+  channels_.SetTimelineHooks(channel_callbacks_.timeline_hooks);
+  ConfigureChannels(device_config);
+  ApplyChannelTones(device_config);
+  dah_is_manual_.store(engine_config.bug_mode, std::memory_order_relaxed);
+  timeline_capture_.Configure(BuildCaptureConfig(device_config));
 
   ESP_LOGI(kLogTag, "Keying config applied: speed=%" PRIu32 " WPM, L-S-P=%u-%u-%u, preset=%d",
            engine_config.speed_wpm, L, S, P, static_cast<int>(device_config.keying.preset));
@@ -135,14 +215,25 @@ void IRAM_ATTR KeyingSubsystem::RecordPaddleEvent(const hal::PaddleEvent& event,
   // NOTE: paddle_event_queue_ is guaranteed to exist because KeyingSubsystemPhase
   // (creates queue) runs before PaddleHalPhase (enables ISR) in init sequence.
   BaseType_t higher_priority_task_woken = pdFALSE;
+  // External mirror (USB HID keyboard) sees the edge before the keying loop does
+  if (subsystem->paddle_tap_ != nullptr) {
+    subsystem->paddle_tap_(event, &higher_priority_task_woken, subsystem->paddle_tap_context_);
+  }
   if (xQueueSendFromISR(subsystem->paddle_event_queue_, &event, &higher_priority_task_woken) !=
       pdTRUE) {
     subsystem->paddle_event_dropped_.fetch_add(1, std::memory_order_relaxed);
+  } else if (subsystem->wake_task_ != nullptr &&
+             (event.line == hal::PaddleLine::kKey || event.line == hal::PaddleLine::kFocus ||
+              (event.line == hal::PaddleLine::kDah &&
+               subsystem->dah_is_manual_.load(std::memory_order_relaxed)))) {
+    // Manual key edges go straight to the output and focus switches must not wait:
+    // wake the keying loop now instead of at its next 1 ms tick
+    vTaskNotifyGiveFromISR(subsystem->wake_task_, &higher_priority_task_woken);
   }
   portYIELD_FROM_ISR(higher_priority_task_woken);
 }
 
-void KeyingSubsystem::HandleKeyingElementStarted(keying::PaddleElement element,
+void KeyingSubsystem::HandleKeyingElementStarted(uint8_t channel, keying::PaddleElement element,
                                                  int64_t start_time_us, void* context) {
   auto* subsystem = static_cast<KeyingSubsystem*>(context);
   if (subsystem == nullptr) {
@@ -151,13 +242,17 @@ void KeyingSubsystem::HandleKeyingElementStarted(keying::PaddleElement element,
   timeline::TimelineEvent evt{
       .timestamp_us = (start_time_us != 0) ? start_time_us : hal::HighPrecisionClock::NowMicros(),
       .type = timeline::EventType::kKeying,
-      .arg0 = static_cast<uint32_t>(element),
+      .arg0 = TagChannel(static_cast<uint32_t>(element), channel),
       .arg1 = 1,
   };
   subsystem->timeline_logger_.push(evt);
+  subsystem->element_started_us_[channel] = evt.timestamp_us;
+  // The engine drives the key output after this callback: take the run-time
+  // baseline at the end of Tick() instead of delaying key-down
+  subsystem->runtime_snapshot_due_ = true;
 }
 
-void KeyingSubsystem::HandleKeyingElementFinished(keying::PaddleElement element,
+void KeyingSubsystem::HandleKeyingElementFinished(uint8_t channel, keying::PaddleElement element,
                                                   int64_t end_time_us, void* context) {
   auto* subsystem = static_cast<KeyingSubsystem*>(context);
   if (subsystem == nullptr) {
@@ -166,14 +261,25 @@ void KeyingSubsystem::HandleKeyingElementFinished(keying::PaddleElement element,
   timeline::TimelineEvent evt{
       .timestamp_us = (end_time_us != 0) ? end_time_us : hal::HighPrecisionClock::NowMicros(),
       .type = timeline::EventType::kKeying,
-      .arg0 = static_cast<uint32_t>(element),
+      .arg0 = TagChannel(static_cast<uint32_t>(element), channel),
       .arg1 = 0,
   };
   subsystem->timeline_logger_.push(evt);
+
+  // The engine reports the planned end; an element released more than 10% of its
+  // length after it is late (keying loop starved)
+  if (element != keying::PaddleElement::kManual && end_time_us != 0) {
+    const int64_t length_us = end_time_us - subsystem->element_started_us_[channel];
+    const int64_t late_us = hal::HighPrecisionClock::NowMicros() - end_time_us;
+    if (length_us > 0 && late_us * 10 > length_us) {
+      subsystem->timeline_capture_.Trigger(timeline::CaptureTrigger::kLateElement,
+                                           end_time_us + late_us);
+    }
+  }
 }
 
-void KeyingSubsystem::HandleKeyingStateChanged(bool key_active, int64_t timestamp_us,
-                                               void* context) {
+void KeyingSubsystem::HandleKeyingStateChanged(uint8_t channel, bool key_active,
+                                               int64_t timestamp_us, void* context) {
   auto* subsystem = static_cast<KeyingSubsystem*>(context);
   if (subsystem == nullptr) {
     ESP_LOGE(kLogTag, "HandleKeyingStateChanged called with NULL context!");
@@ -185,67 +291,100 @@ void KeyingSubsystem::HandleKeyingStateChanged(bool key_active, int64_t timestam
   // Audio timing is critical for morse code, so call Start()/Stop() immediately
   // BEFORE any logging or other operations that could delay execution
 
-  // Control sidetone (synchronized with TX) - FIRST, before any logging
+  // Control TX output GPIO of this radio - a single register write, so it goes first
+  if (subsystem->channel_tx_[channel] != nullptr) {
+    subsystem->channel_tx_[channel]->SetActive(key_active);
+  }
+
+  // Control sidetone (synchronized with TX) - before any logging.
+  // SO2R: one generator for all radios; it takes the pitch/pan of the radio that keyed
+  // last (or of one still keyed when that radio releases) and stops when none is keyed.
+  const uint8_t channel_bit = static_cast<uint8_t>(1U << channel);
+  if (key_active) {
+    subsystem->keyed_channels_ |= channel_bit;
+  } else {
+    subsystem->keyed_channels_ &= static_cast<uint8_t>(~channel_bit);
+  }
   if (subsystem->audio_subsystem_ != nullptr) {
     if (key_active) {
+      subsystem->RetuneSidetone(channel);
       subsystem->audio_subsystem_->Start();
-    } else {
+      subsystem->RecordDeadline(channel, keying::DeadlineKind::kSidetoneStart, timestamp_us,
+                                hal::HighPrecisionClock::NowMicros());
+    } else if (subsystem->keyed_channels_ == 0) {
       subsystem->audio_subsystem_->Stop();
+    } else {
+      subsystem->RetuneSidetone(static_cast<size_t>(__builtin_ctz(subsystem->keyed_channels_)));
     }
   }
-
-  // Control TX output GPIO - also time-critical
-  if (subsystem->tx_hal_ != nullptr) {
-    subsystem->tx_hal_->SetActive(key_active);
+  if (subsystem->key_tap_ != nullptr) {
+    subsystem->key_tap_(subsystem->keyed_channels_ != 0, timestamp_us, subsystem->key_tap_context_);
   }
 
   // Now safe to log (after time-critical operations completed)
   const int64_t now_us = hal::HighPrecisionClock::NowMicros();
   const int64_t callback_latency_us = now_us - timestamp_us;
 
-  ESP_LOGI(kLogTag, "═══ AUDIO %s @ %lld us (event_time=%lld, latency=%lld us) ═══",
+  ESP_LOGI(kLogTag, "═══ AUDIO %s @ %lld us (event_time=%lld, latency=%lld us, channel=%u) ═══",
            key_active ? "START" : "STOP",
            now_us,
            timestamp_us,
-           callback_latency_us);
+           callback_latency_us,
+           static_cast<unsigned>(channel));
+}
+
+void KeyingSubsystem::HandleFocusKeyChanged(bool key_active, int64_t timestamp_us,
+                                            void* context) {
+  auto* subsystem = static_cast<KeyingSubsystem*>(context);
+  if (subsystem == nullptr) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(subsystem->memory_mutex_);
+    subsystem->memory_recorder_.OnKeyEdge(key_active, timestamp_us);
+  }
+  subsystem->ForwardKeyStream(key_active, timestamp_us);
+}
 
+void KeyingSubsystem::ForwardKeyStream(bool key_active, int64_t timestamp_us) {
   // Queue local key event to remote client (if connected)
-  if (subsystem->remote_client_ != nullptr) {
-    const auto state = subsystem->remote_client_->GetState();
+  if (remote_client_ != nullptr) {
+    const auto state = remote_client_->GetState();
     ESP_LOGI(kLogTag, "Remote client state check: state=%d (kConnected=%d)",
              static_cast<int>(state), static_cast<int>(remote::RemoteCwClientState::kConnected));
     if (state == remote::RemoteCwClientState::kConnected) {
       ESP_LOGI(kLogTag, "Attempting to queue keying event to remote client...");
-      if (!subsystem->remote_client_->QueueKeyingEvent(key_active, timestamp_us)) {
+      if (!remote_client_->QueueKeyingEvent(key_active, timestamp_us)) {
         ESP_LOGW(kLogTag, "Remote client key queue full, event dropped");
       }
 
       // PTT management: activate PTT on first key-down, extend timeout on any key activity
       if (key_active) {
         // Key down: ensure we're in TX mode
-        if (subsystem->audio_subsystem_ != nullptr &&
-            !subsystem->audio_subsystem_->IsModeTX()) {
-          subsystem->audio_subsystem_->SetModeTX();
+        if (audio_subsystem_ != nullptr &&
+            !audio_subsystem_->IsModeTX()) {
+          audio_subsystem_->SetModeTX();
         }
 
         // Activate PTT if not already active
-        if (!subsystem->ptt_active_) {
-          subsystem->ptt_active_ = true;
+        if (!ptt_active_) {
+          ptt_active_ = true;
           // Note: Actual PTT control would go here (e.g., GPIO pin).
           // For now, PTT is logical state only.
           ESP_LOGD(kLogTag, "Remote PTT activated");
         }
 
         // Update PTT timeout: base tail + current measured latency
-        const uint32_t dynamic_tail_ms = subsystem->ptt_tail_ms_ +
-                                         subsystem->remote_client_->GetLatency();
-        subsystem->ptt_timeout_us_ = timestamp_us + (dynamic_tail_ms * 1000);
+        const uint32_t dynamic_tail_ms = ptt_tail_ms_ +
+                                         remote_client_->GetLatency();
+        ptt_timeout_us_ = timestamp_us + (dynamic_tail_ms * 1000);
       } else {
         // Key up: update PTT timeout
-        if (subsystem->ptt_active_) {
-          const uint32_t dynamic_tail_ms = subsystem->ptt_tail_ms_ +
-                                           subsystem->remote_client_->GetLatency();
-          subsystem->ptt_timeout_us_ = timestamp_us + (dynamic_tail_ms * 1000);
+        if (ptt_active_) {
+          const uint32_t dynamic_tail_ms = ptt_tail_ms_ +
+                                           remote_client_->GetLatency();
+          ptt_timeout_us_ = timestamp_us + (dynamic_tail_ms * 1000);
         }
       }
     } else {
@@ -256,32 +395,106 @@ void KeyingSubsystem::HandleKeyingStateChanged(bool key_active, int64_t timestam
     ESP_LOGI(kLogTag, "Remote client is NULL, keying event NOT queued");
   }
 
-  // Feed timing classifier for morse decoder (if enabled)
-  if (subsystem->timing_classifier_ != nullptr) {
-    // Track previous timestamp for duration calculation
-    static int64_t last_timestamp_us = 0;
-
-    // Calculate duration since last event
-    if (last_timestamp_us > 0) {
-      const int64_t duration_us = timestamp_us - last_timestamp_us;
-      if (duration_us > 0) {
-        // Classify the duration that just ended:
-        // - If current state is key_active=true: previous duration was key-off (gap)
-        // - If current state is key_active=false: previous duration was key-on (dit/dah)
-        const bool was_key_on = !key_active;  // What just ended
-        morse_decoder::KeyEvent event =
-            subsystem->timing_classifier_->ClassifyDuration(duration_us, was_key_on);
-
-        // Feed classified event to morse decoder (Phase 2)
-        if (subsystem->morse_decoder_ != nullptr) {
-          subsystem->morse_decoder_->ProcessEvent(event);
-        }
+  // Feed the local key stream to the morse decoder service (classifier + decoder)
+  if (decoder_service_ != nullptr) {
+    decoder_service_->OnKeyEdge(morse_decoder::KeySource::kLocal, key_active,
+                                           timestamp_us);
+  }
+}
+
+void KeyingSubsystem::HandleDeadline(uint8_t channel, keying::DeadlineKind kind,
+                                     int64_t planned_us, int64_t actual_us, void* context) {
+  auto* subsystem = static_cast<KeyingSubsystem*>(context);
+  if (subsystem == nullptr) {
+    return;
+  }
+  subsystem->RecordDeadline(channel, kind, planned_us, actual_us);
+}
+
+void KeyingSubsystem::RecordDeadline(uint8_t channel, keying::DeadlineKind kind,
+                                     int64_t planned_us, int64_t actual_us) {
+  if (!deadline_monitor_.Record(kind, channel, planned_us, actual_us)) {
+    return;
+  }
+#if defined(CONFIG_FREERTOS_USE_TRACE_FACILITY) && defined(CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS)
+  // Blame the task that ran most since the last element start, other than this
+  // loop and the idle tasks (idle time is the loop's own sleep)
+  uint32_t total_runtime = 0;
+  const UBaseType_t count = uxTaskGetSystemState(runtime_scratch_, kMaxRuntimeTasks, &total_runtime);
+  const TaskHandle_t self = xTaskGetCurrentTaskHandle();
+  const char* busiest = nullptr;
+  uint32_t busiest_delta = 0;
+  for (UBaseType_t i = 0; i < count; ++i) {
+    const TaskStatus_t& task = runtime_scratch_[i];
+    if (task.xHandle == self || std::strncmp(task.pcTaskName, "IDLE", 4) == 0) {
+      continue;
+    }
+    uint32_t baseline = 0;
+    for (size_t j = 0; j < runtime_baseline_count_; ++j) {
+      if (runtime_baseline_[j].handle == task.xHandle) {
+        baseline = runtime_baseline_[j].counter;
+        break;
       }
     }
+    const uint32_t delta = task.ulRunTimeCounter - baseline;
+    if (delta > busiest_delta) {
+      busiest_delta = delta;
+      busiest = task.pcTaskName;
+    }
+  }
+  deadline_monitor_.AttributeLastMiss(busiest);
+#endif
+  // No logging here: a UART write would make the next edge late too. A late
+  // element end may already have fired the capture from HandleKeyingElementFinished().
+  if (!timeline_capture_.pending()) {
+    timeline_capture_.Trigger(timeline::CaptureTrigger::kLateElement, actual_us);
+  }
+}
 
-    // Update timestamp tracker
-    last_timestamp_us = timestamp_us;
+void KeyingSubsystem::SnapshotTaskRuntime() {
+#if defined(CONFIG_FREERTOS_USE_TRACE_FACILITY) && defined(CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS)
+  uint32_t total_runtime = 0;
+  const UBaseType_t count = uxTaskGetSystemState(runtime_scratch_, kMaxRuntimeTasks, &total_runtime);
+  for (UBaseType_t i = 0; i < count; ++i) {
+    runtime_baseline_[i] = {runtime_scratch_[i].xHandle, runtime_scratch_[i].ulRunTimeCounter};
+  }
+  runtime_baseline_count_ = count;
+#endif
+}
+
+void KeyingSubsystem::HandleFocusChanged(uint8_t channel, int64_t timestamp_us, void* context) {
+  auto* subsystem = static_cast<KeyingSubsystem*>(context);
+  if (subsystem == nullptr) {
+    return;
   }
+  timeline::TimelineEvent evt{
+      .timestamp_us = timestamp_us,
+      .type = timeline::EventType::kFocus,
+      .arg0 = channel,
+      .arg1 = 0,
+  };
+  subsystem->timeline_logger_.push(evt);
+  ESP_LOGD(kLogTag, "SO2R focus -> radio %u", static_cast<unsigned>(channel) + 1U);
+}
+
+bool KeyingSubsystem::RequestFocus(uint8_t channel) {
+  if (channel >= channels_.channel_count() || paddle_event_queue_ == nullptr) {
+    return false;
+  }
+  const hal::PaddleEvent event{
+      .line = hal::PaddleLine::kFocus,
+      .active = true,
+      .timestamp_us = hal::HighPrecisionClock::NowMicros(),
+      .channel = channel,
+  };
+  if (xQueueSend(paddle_event_queue_, &event, 0) != pdTRUE) {
+    paddle_event_dropped_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  if (wake_task_ != nullptr) {
+    xTaskNotifyGive(wake_task_);
+  }
+  return true;
 }
 
 esp_err_t KeyingSubsystem::Initialize(const config::DeviceConfig& device_config) {
@@ -295,28 +508,49 @@ esp_err_t KeyingSubsystem::Initialize(const config::DeviceConfig& device_config)
   }
   ESP_LOGI(kLogTag, "Paddle event queue created (capacity=%u)", kPaddleEventQueueCapacity);
 
-  // Configure paddle engine callbacks (context = this KeyingSubsystem instance).
+  // One-shot wake-up at the next paddle memory edge (replay timing independent of the tick)
+  const esp_timer_create_args_t memory_timer_args = {
+      .callback = HandleMemoryTimer,
+      .arg = this,
+      .dispatch_method = ESP_TIMER_TASK,
+      .name = "pmem_replay",
+      .skip_unhandled_events = true,
+  };
+  if (esp_timer_create(&memory_timer_args, &memory_timer_) != ESP_OK) {
+    ESP_LOGW(kLogTag, "Paddle memory timer unavailable, replay runs at tick resolution");
+    memory_timer_ = nullptr;
+  }
+
+  // Configure keying channel callbacks (context = this KeyingSubsystem instance).
   // IMPORTANT: Preserve timeline_hooks if they were set by SetTimelineEmitter() before Initialize().
   // SetTimelineEmitter() is called in SubsystemCreationPhase (Phase 8), before KeyingSubsystemPhase (Phase 11).
-  auto saved_timeline_hooks = paddle_callbacks_.timeline_hooks;
+  auto saved_timeline_hooks = channel_callbacks_.timeline_hooks;
 
-  paddle_callbacks_ = {
+  channel_callbacks_ = {
       .on_element_started = HandleKeyingElementStarted,
       .on_element_finished = HandleKeyingElementFinished,
       .on_key_state_changed = HandleKeyingStateChanged,
+      .on_focus_key_changed = HandleFocusKeyChanged,
+      .on_focus_changed = HandleFocusChanged,
+      .on_deadline = HandleDeadline,
       .context = this,
       .timeline_hooks = saved_timeline_hooks,  // Restore timeline hooks
   };
 
-  // Initialize paddle engine.
-  const keying::PaddleEngineConfig engine_config = BuildEngineConfig(device_config);
-  if (!paddle_engine_.Initialize(engine_config, paddle_callbacks_)) {
+  // Initialize one paddle engine per keying channel (radio).
+  channels_.Initialize(device_config.so2r.channel_count, channel_callbacks_);
+  if (!ConfigureChannels(device_config)) {
     ESP_LOGE(kLogTag, "Paddle engine initialization failed");
     return ESP_FAIL;
   }
+  ApplyChannelTones(device_config);
+  const keying::PaddleEngineConfig engine_config = BuildEngineConfig(device_config);
+  dah_is_manual_.store(engine_config.bug_mode, std::memory_order_relaxed);
+  timeline_capture_.Configure(BuildCaptureConfig(device_config));
 
-  ESP_LOGI(kLogTag, "Keying subsystem initialized (speed=%u WPM)", 
-           static_cast<unsigned int>(engine_config.speed_wpm));
+  ESP_LOGI(kLogTag, "Keying subsystem initialized (speed=%u WPM, channels=%u)",
+           static_cast<unsigned int>(engine_config.speed_wpm),
+           static_cast<unsigned int>(channels_.channel_count()));
   return ESP_OK;
 }
 
@@ -325,18 +559,35 @@ void KeyingSubsystem::DrainPaddleEvents() {
   static uint32_t last_dropped_count = 0;
 
   while (xQueueReceive(paddle_event_queue_, &event, 0) == pdTRUE) {
+    // Touching the paddle takes over from a paddle memory replay or a host sender:
+    // their key is released here, before the engine keys the paddle element
+    if (event.active && event.line != hal::PaddleLine::kFocus) {
+      StopMemoryPlayback(event.timestamp_us);
+      if (break_in_ != nullptr) {
+        break_in_(event.timestamp_us, break_in_context_);
+      }
+      // Sidetone pump may be powered down: bring I2S up before the engine keys the element
+      if (audio_subsystem_ != nullptr) {
+        audio_subsystem_->Wake();
+      }
+    }
+
+    // Engine first: manual key edges switch TX/sidetone inside this call
+    channels_.OnPaddleEvent(event);
+    if (event.line == hal::PaddleLine::kFocus) {
+      continue;  // Logged by HandleFocusChanged() if the focus actually moved
+    }
+
     // Update diagnostics (LED visualization) - moved from ISR to task context
     if (diagnostics_subsystem_ != nullptr) {
       diagnostics_subsystem_->UpdatePaddleActivity(event.line, event.active, event.timestamp_us);
     }
 
-    paddle_engine_.OnPaddleEvent(event);
-
     // Log paddle event to timeline (moved out of ISR context).
     timeline::TimelineEvent timeline_evt{
         .timestamp_us = event.timestamp_us,
         .type = timeline::EventType::kPaddleEdge,
-        .arg0 = static_cast<uint32_t>(event.line),
+        .arg0 = TagChannel(static_cast<uint32_t>(event.line), event.channel),
         .arg1 = event.active ? 1U : 0U,
     };
     timeline_logger_.push(timeline_evt);
@@ -348,6 +599,8 @@ void KeyingSubsystem::DrainPaddleEvents() {
     ESP_LOGW(kLogTag, "ISR queue overflow! Dropped events: %" PRIu32 " (+%" PRIu32 ")",
              current_dropped, current_dropped - last_dropped_count);
     last_dropped_count = current_dropped;
+    timeline_capture_.Trigger(timeline::CaptureTrigger::kIsrQueueOverflow,
+                              hal::HighPrecisionClock::NowMicros());
   }
 }
 
@@ -373,27 +626,199 @@ void KeyingSubsystem::TickRemotePtt(int64_t now_us) {
   }
 }
 
+void KeyingSubsystem::TickCapture(int64_t now_us) {
+  if (now_us < capture_next_check_us_) {
+    return;
+  }
+  capture_next_check_us_ = now_us + kCaptureCheckIntervalUs;
+
+  if (remote_client_ != nullptr) {
+    const uint32_t drops = remote_client_->GetDroppedEventCount();
+    if (drops != capture_remote_drops_) {
+      capture_remote_drops_ = drops;
+      timeline_capture_.Trigger(timeline::CaptureTrigger::kRemoteQueueFull, now_us);
+    }
+  }
+  const audio::AudioStreamPlayer* player =
+      (audio_subsystem_ != nullptr) ? audio_subsystem_->GetStreamPlayer() : nullptr;
+  if (player != nullptr) {
+    const uint32_t underruns = player->GetUnderrunCount();
+    if (underruns != capture_audio_underruns_) {
+      capture_audio_underruns_ = underruns;
+      timeline_capture_.Trigger(timeline::CaptureTrigger::kAudioUnderrun, now_us);
+    }
+  }
+
+  // Freeze between marks only: the ring walk must not stretch an element
+  if (keyed_channels_ == 0) {
+    timeline_capture_.Poll(timeline_logger_, now_us);
+  }
+}
+
+void KeyingSubsystem::TickMemoryPlayback(int64_t now_us) {
+  keying::PaddleMemoryPlayer::Edge edge;
+  while (true) {
+    {
+      std::lock_guard<std::mutex> lock(memory_mutex_);
+      if (!memory_player_.PopDue(now_us, &edge)) {
+        if (memory_player_.active() && memory_timer_ != nullptr) {
+          // Re-arming an esp_timer restarts it, so only do it for a new edge
+          const int64_t next_us = memory_player_.next_edge_us();
+          if (next_us != memory_timer_due_us_) {
+            memory_timer_due_us_ = next_us;
+            esp_timer_stop(memory_timer_);
+            esp_timer_start_once(memory_timer_, static_cast<uint64_t>(next_us - now_us));
+          }
+        }
+        return;
+      }
+    }
+    OutputMemoryEdge(edge.key_active, edge.timestamp_us);
+  }
+}
+
+void KeyingSubsystem::OutputMemoryEdge(bool key_active, int64_t timestamp_us) {
+  const uint8_t channel = channels_.focus();
+  HandleKeyingStateChanged(channel, key_active, timestamp_us, this);
+  timeline::TimelineEvent evt{
+      .timestamp_us = timestamp_us,
+      .type = timeline::EventType::kKeying,
+      .arg0 = TagChannel(static_cast<uint32_t>(keying::PaddleElement::kManual), channel),
+      .arg1 = key_active ? 1U : 0U,
+  };
+  timeline_logger_.push(evt);
+  // Remote and decoder, but not the recorder (record and replay are exclusive)
+  ForwardKeyStream(key_active, timestamp_us);
+}
+
+void KeyingSubsystem::HandleMemoryTimer(void* arg) {
+  auto* subsystem = static_cast<KeyingSubsystem*>(arg);
+  if (subsystem->wake_task_ != nullptr) {
+    xTaskNotifyGive(subsystem->wake_task_);
+  }
+}
+
+bool KeyingSubsystem::StartMemoryRecording() {
+  std::lock_guard<std::mutex> lock(memory_mutex_);
+  if (memory_player_.active()) {
+    return false;
+  }
+  memory_recorder_.Start();
+  ESP_LOGI(kLogTag, "Paddle memory recording started");
+  return true;
+}
+
+size_t KeyingSubsystem::StopMemoryRecording(uint8_t* out, size_t capacity) {
+  std::lock_guard<std::mutex> lock(memory_mutex_);
+  if (!memory_recorder_.active()) {
+    return 0;
+  }
+  const size_t size = memory_recorder_.Stop(hal::HighPrecisionClock::NowMicros());
+  if (size == 0 || out == nullptr || size > capacity) {
+    return 0;
+  }
+  std::copy(memory_recorder_.data(), memory_recorder_.data() + size, out);
+  ESP_LOGI(kLogTag, "Paddle memory recorded: %u bytes%s", static_cast<unsigned>(size),
+           memory_recorder_.truncated() ? " (truncated)" : "");
+  return size;
+}
+
+bool KeyingSubsystem::PlayMemory(const uint8_t* data, size_t size, uint16_t speed_pct) {
+  {
+    std::lock_guard<std::mutex> lock(memory_mutex_);
+    if (memory_recorder_.active() || memory_player_.active()) {
+      return false;
+    }
+    if (!memory_player_.Start(data, size, speed_pct, hal::HighPrecisionClock::NowMicros())) {
+      return false;
+    }
+    memory_timer_due_us_ = 0;
+  }
+  // First edge is due now: run the keying loop instead of waiting for its tick
+  if (wake_task_ != nullptr) {
+    xTaskNotifyGive(wake_task_);
+  }
+  return true;
+}
+
+void KeyingSubsystem::StopMemoryPlayback(int64_t now_us) {
+  bool release = false;
+  {
+    std::lock_guard<std::mutex> lock(memory_mutex_);
+    if (!memory_player_.active()) {
+      return;
+    }
+    release = memory_player_.Stop();
+  }
+  if (memory_timer_ != nullptr) {
+    esp_timer_stop(memory_timer_);
+  }
+  if (release) {
+    OutputMemoryEdge(false, now_us);
+  }
+}
+
+void KeyingSubsystem::AbortMemoryPlayback() {
+  memory_abort_requested_.store(true, std::memory_order_relaxed);
+  if (wake_task_ != nullptr) {
+    xTaskNotifyGive(wake_task_);
+  }
+}
+
+bool KeyingSubsystem::IsRecordingMemory() const {
+  std::lock_guard<std::mutex> lock(memory_mutex_);
+  return memory_recorder_.active();
+}
+
+bool KeyingSubsystem::IsPlayingMemory() const {
+  std::lock_guard<std::mutex> lock(memory_mutex_);
+  return memory_player_.active();
+}
+
 void KeyingSubsystem::Tick(int64_t now_us) {
-  paddle_engine_.Tick(now_us);
+  channels_.Tick(now_us);
+  if (memory_abort_requested_.exchange(false, std::memory_order_relaxed)) {
+    StopMemoryPlayback(now_us);
+  }
+  TickMemoryPlayback(now_us);
   TickRemotePtt(now_us);
+  TickCapture(now_us);
+
+  // Tick morse decoders (all key streams) for inactivity timeout handling
+  if (decoder_service_ != nullptr) {
+    decoder_service_->Tick(now_us);
+  }
 
-  // Tick morse decoder for inactivity timeout handling
-  if (morse_decoder_ != nullptr) {
-    morse_decoder_->Tick(now_us);
+  // Last, once every edge of this tick is out (an element started in this tick)
+  if (runtime_snapshot_due_) {
+    runtime_snapshot_due_ = false;
+    SnapshotTaskRuntime();
   }
 }
 
+morse_decoder::AdaptiveTimingClassifier* KeyingSubsystem::GetTimingClassifier() const {
+  return decoder_service_ != nullptr
+             ? decoder_service_->GetClassifier(morse_decoder::KeySource::kLocal)
+             : nullptr;
+}
+
+morse_decoder::MorseDecoder* KeyingSubsystem::GetMorseDecoder() const {
+  return decoder_service_ != nullptr
+             ? decoder_service_->GetDecoder(morse_decoder::KeySource::kLocal)
+             : nullptr;
+}
+
 void KeyingSubsystem::SetTimelineEmitter(timeline::TimelineEventEmitter* emitter) {
   timeline_emitter_ = emitter;
 
   if (timeline_emitter_ != nullptr) {
     // Get hooks from emitter and forward to paddle engine callbacks
-    paddle_callbacks_.timeline_hooks = timeline_emitter_->GetHooks();
+    channel_callbacks_.timeline_hooks = timeline_emitter_->GetHooks();
 
     ESP_LOGI(kLogTag, "Timeline event emitter wired (hooks ready for next engine initialization)");
   } else {
     // Clear timeline hooks if emitter is removed
-    paddle_callbacks_.timeline_hooks = timeline::TimelineHooks{};
+    channel_callbacks_.timeline_hooks = timeline::TimelineHooks{};
     ESP_LOGI(kLogTag, "Timeline event emitter disconnected");
   }
 
@@ -407,18 +832,18 @@ void KeyingSubsystem::DumpTimelineHooksStatus() const {
   ESP_LOGI(kLogTag, "Timeline Emitter: %s (%p)",
            timeline_emitter_ ? "CONNECTED" : "NULL", timeline_emitter_);
   ESP_LOGI(kLogTag, "");
-  ESP_LOGI(kLogTag, "Paddle Callbacks (in paddle_callbacks_ struct):");
+  ESP_LOGI(kLogTag, "Channel Callbacks (in channel_callbacks_ struct):");
   ESP_LOGI(kLogTag, "  OnMemoryWindowChanged: %s (%p)",
-           paddle_callbacks_.timeline_hooks.OnMemoryWindowChanged ? "SET" : "NULL",
-           paddle_callbacks_.timeline_hooks.OnMemoryWindowChanged);
+           channel_callbacks_.timeline_hooks.OnMemoryWindowChanged ? "SET" : "NULL",
+           channel_callbacks_.timeline_hooks.OnMemoryWindowChanged);
   ESP_LOGI(kLogTag, "  OnLatchStateChanged:   %s (%p)",
-           paddle_callbacks_.timeline_hooks.OnLatchStateChanged ? "SET" : "NULL",
-           paddle_callbacks_.timeline_hooks.OnLatchStateChanged);
+           channel_callbacks_.timeline_hooks.OnLatchStateChanged ? "SET" : "NULL",
+           channel_callbacks_.timeline_hooks.OnLatchStateChanged);
   ESP_LOGI(kLogTag, "  OnSqueezeDetected:     %s (%p)",
-           paddle_callbacks_.timeline_hooks.OnSqueezeDetected ? "SET" : "NULL",
-           paddle_callbacks_.timeline_hooks.OnSqueezeDetected);
+           channel_callbacks_.timeline_hooks.OnSqueezeDetected ? "SET" : "NULL",
+           channel_callbacks_.timeline_hooks.OnSqueezeDetected);
   ESP_LOGI(kLogTag, "  Context pointer:       %p",
-           paddle_callbacks_.timeline_hooks.context);
+           channel_callbacks_.timeline_hooks.context);
   ESP_LOGI(kLogTag, "");
   ESP_LOGI(kLogTag, "Note: Hooks are copied to PaddleEngine during Initialize().");
   ESP_LOGI(kLogTag, "If hooks show NULL, check:");
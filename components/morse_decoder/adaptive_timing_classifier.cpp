@@ -1,151 +1,455 @@
 /**
  * @file adaptive_timing_classifier.cpp
  * @brief Implementation of adaptive morse timing classifier
+ *
+ * Durations are handled in a fixed-point log2 domain ("log position"): the integer
+ * part is the octave above 4.096 ms, the 11-bit fraction is the linear mantissa.
+ * The mapping is monotonic and its inverse is exact, so centroids can be averaged
+ * in the log domain and converted back to microseconds without floating point.
  */
 
 #include "morse_decoder/adaptive_timing_classifier.hpp"
 
-#include <algorithm>
 #include <cinttypes>  // For PRIu32, PRId64
+#include <cstring>
 #include "esp_log.h"
 
 namespace {
 constexpr char kLogTag[] = "morse_decoder";
+
+// Log position layout: 2048 units per octave, 256 units per histogram bin
+constexpr int32_t kFractionBits = 11;
+constexpr int32_t kUnitsPerOctave = 1 << kFractionBits;
+constexpr int32_t kUnitsPerBin = 256;
+constexpr int32_t kBaseExponent = 12;  // Bin 0 starts at 2^12 us = 4.096 ms
+
+// Standard morse ratios expressed as log position offsets (log2(x) × 2048)
+constexpr int32_t kLog2Of3 = 3246;          // dah = 3 × dit, char gap = 3 × intra gap
+constexpr int32_t kLog2Of7Over3 = 2504;     // word gap = 7/3 × char gap
+constexpr int32_t kMinClusterSeparation = 1198;  // Clusters closer than 1.5× are merged
+
+// Samples further than one octave above the longest cluster are learned at that
+// distance (idle pauses, stuck key), so they cannot drag the centroids away
+constexpr int32_t kMaxLearnDistance = kUnitsPerOctave;
+
+static_assert(morse_decoder::AdaptiveTimingClassifier::kBinsPerOctave * kUnitsPerBin ==
+                  kUnitsPerOctave,
+              "Histogram bins must tile an octave exactly");
+
+constexpr int32_t kMaxPosition =
+    static_cast<int32_t>(morse_decoder::AdaptiveTimingClassifier::kHistogramBins) * kUnitsPerBin -
+    1;
+
+/**
+ * @brief Map a duration to its fixed-point log2 position (clamped to histogram range)
+ */
+int32_t LogPosition(int64_t duration_us) {
+  if (duration_us < (int64_t{1} << kBaseExponent)) {
+    return 0;
+  }
+  const uint64_t value = static_cast<uint64_t>(duration_us);
+  const int32_t msb = 63 - __builtin_clzll(value);
+  const int32_t octave = msb - kBaseExponent;
+  if (octave >= static_cast<int32_t>(
+                    morse_decoder::AdaptiveTimingClassifier::kHistogramOctaves)) {
+    return kMaxPosition;
+  }
+  const int32_t mantissa =
+      static_cast<int32_t>((value << kFractionBits) >> msb) - kUnitsPerOctave;
+  return (octave << kFractionBits) + mantissa;
+}
+
+/**
+ * @brief Inverse of LogPosition()
+ */
+int64_t PositionToUs(int32_t position) {
+  if (position < 0) {
+    position = 0;
+  }
+  const int32_t octave = position >> kFractionBits;
+  const int64_t mantissa = kUnitsPerOctave + (position & (kUnitsPerOctave - 1));
+  return (mantissa << (octave + kBaseExponent)) >> kFractionBits;
+}
+
+/**
+ * @brief Negative log-likelihood of a log-domain distance from a cluster centroid
+ *
+ * Gaussian with σ = kCostSigma: cost = d² / (2σ²) nats, scaled to
+ * ElementScores::kCostUnitsPerNat and saturated at kImpossibleCost.
+ */
+constexpr int64_t kCostSigma = kUnitsPerOctave / 4;
+
+uint16_t DistanceCost(int32_t distance) {
+  const int64_t d = distance;
+  const int64_t cost = d * d * morse_decoder::ElementScores::kCostUnitsPerNat /
+                       (2 * kCostSigma * kCostSigma);
+  return cost >= morse_decoder::ElementScores::kImpossibleCost
+             ? morse_decoder::ElementScores::kImpossibleCost
+             : static_cast<uint16_t>(cost);
+}
+
+/**
+ * @brief Merge adjacent clusters that ended up too close and re-seed empty ones
+ * @param centroids Refined centroids (ascending)
+ * @param weights Cluster weights from k-means (modified when clusters merge)
+ * @param seeds Centroids before this refinement (used to name a merged cluster)
+ * @param ratio_offsets Nominal log distance between cluster i and i+1
+ * @param count Number of clusters
+ * @return Index of the first populated cluster, or count if all are empty
+ */
+size_t FinalizeClusters(int32_t* centroids, uint32_t* weights, const int32_t* seeds,
+                        const int32_t* ratio_offsets, size_t count) {
+  // A unimodal population split in two is one cluster: keep it where the
+  // previous model expected it and let the neighbour be re-seeded below.
+  for (size_t i = 0; i + 1 < count; ++i) {
+    if (weights[i] == 0 || weights[i + 1] == 0 ||
+        centroids[i + 1] - centroids[i] >= kMinClusterSeparation) {
+      continue;
+    }
+    const uint32_t total = weights[i] + weights[i + 1];
+    const int32_t merged = static_cast<int32_t>(
+        (static_cast<int64_t>(centroids[i]) * weights[i] +
+         static_cast<int64_t>(centroids[i + 1]) * weights[i + 1]) / total);
+    const int32_t dist_low = merged > seeds[i] ? merged - seeds[i] : seeds[i] - merged;
+    const int32_t dist_high =
+        merged > seeds[i + 1] ? merged - seeds[i + 1] : seeds[i + 1] - merged;
+    const size_t keep = (dist_low <= dist_high) ? i : i + 1;
+    const size_t drop = (keep == i) ? i + 1 : i;
+    centroids[keep] = merged;
+    weights[keep] = total;
+    weights[drop] = 0;
+  }
+
+  size_t first = 0;
+  while (first < count && weights[first] == 0) {
+    ++first;
+  }
+  if (first == count) {
+    return count;
+  }
+
+  for (size_t i = first; i-- > 0;) {
+    centroids[i] = centroids[i + 1] - ratio_offsets[i];
+  }
+  for (size_t i = first + 1; i < count; ++i) {
+    if (weights[i] != 0) {
+      continue;
+    }
+    centroids[i] = centroids[i - 1] + ratio_offsets[i - 1];
+    // Keep ordering if a populated cluster follows the re-seeded one
+    if (i + 1 < count && weights[i + 1] != 0 && centroids[i] >= centroids[i + 1]) {
+      centroids[i] = (centroids[i - 1] + centroids[i + 1]) / 2;
+    }
+  }
+  return first;
+}
+
 }  // namespace
 
 namespace morse_decoder {
 
-AdaptiveTimingClassifier::AdaptiveTimingClassifier(float tolerance_percent)
-    : dit_avg_us_(kDefaultDitUs),
-      dah_avg_us_(kDefaultDahUs),
-      tolerance_percent_(tolerance_percent),
-      dit_sample_count_(0),
-      dah_sample_count_(0) {
+AdaptiveTimingClassifier::AdaptiveTimingClassifier(float tolerance_percent) {
+  int32_t permille = static_cast<int32_t>(tolerance_percent * 10.0f);
+  if (permille < 0) permille = 0;
+  if (permille > 900) permille = 900;
+  tolerance_permille_ = permille;
+
+  Reset();
   ESP_LOGI(kLogTag, "Classifier initialized: tolerance=%.1f%%, default_wpm=20",
-           tolerance_percent_);
+           tolerance_percent);
 }
 
 KeyEvent AdaptiveTimingClassifier::ClassifyDuration(int64_t duration_us, bool was_key_on) {
+  return ClassifyDuration(duration_us, was_key_on, nullptr);
+}
+
+KeyEvent AdaptiveTimingClassifier::ClassifyDuration(int64_t duration_us, bool was_key_on,
+                                                    ElementScores* scores) {
+  if (scores != nullptr) {
+    *scores = ElementScores{};
+    scores->key_on = was_key_on;
+    scores->duration_us = duration_us;
+  }
   if (duration_us <= 0) {
     ESP_LOGW(kLogTag, "Invalid duration: %lld μs", duration_us);
     return KeyEvent::kUnknown;
   }
 
+  const int32_t position = LogPosition(duration_us);
+
   if (was_key_on) {
-    // Key-on duration: classify as dit or dah
-    const int64_t dit_threshold = ComputeDitThreshold();
-
-    if (duration_us < dit_threshold) {
-      // Classify as DIT
-      UpdateDitAverage(duration_us);
-      ESP_LOGD(kLogTag, "Key-on: %lld μs → DIT (threshold: %lld μs)", duration_us, dit_threshold);
-      return KeyEvent::kDit;
-    } else {
-      // Classify as DAH
-      UpdateDahAverage(duration_us);
-      ESP_LOGD(kLogTag, "Key-on: %lld μs → DAH (threshold: %lld μs)", duration_us, dit_threshold);
-      return KeyEvent::kDah;
+    // Key-on duration: classify as dit or dah against the current model, then learn
+    const KeyEvent event = (position < dit_dah_threshold_) ? KeyEvent::kDit : KeyEvent::kDah;
+    if (scores != nullptr) {
+      scores->best = event;
+      scores->cost[0] = DistanceCost(position - mark_centroid_[0]);
+      scores->cost[1] = DistanceCost(position - mark_centroid_[1]);
     }
-  } else {
-    // Key-off duration: classify gap type
-    // Check if we have enough samples for reliable gap classification
-    if (dit_sample_count_ + dah_sample_count_ < kMinSamplesForClassification) {
-      ESP_LOGD(kLogTag, "Key-off: %lld μs → UNKNOWN (warm-up)", duration_us);
-      return KeyEvent::kUnknown;
-    }
-
-    // Calculate gap thresholds based on dit average
-    // Intra-character gap: ~1 dit unit (threshold at 2 dit units)
-    const int64_t char_gap_threshold = dit_avg_us_ * 2;
-
-    // Inter-character gap: ~3 dit units (threshold at 5 dit units for word gap)
-    const int64_t word_gap_threshold = dit_avg_us_ * 5;
-
-    if (duration_us < char_gap_threshold) {
-      ESP_LOGD(kLogTag, "Key-off: %lld μs → INTRA gap", duration_us);
-      return KeyEvent::kIntraGap;
-    } else if (duration_us < word_gap_threshold) {
-      ESP_LOGD(kLogTag, "Key-off: %lld μs → CHAR gap", duration_us);
-      return KeyEvent::kCharGap;
+    if (event == KeyEvent::kDit) {
+      dit_sample_count_++;
     } else {
-      ESP_LOGD(kLogTag, "Key-off: %lld μs → WORD gap", duration_us);
-      return KeyEvent::kWordGap;
+      dah_sample_count_++;
+    }
+
+    const int32_t learn_limit = mark_centroid_[1] + kMaxLearnDistance;
+    AddSample(mark_histogram_, position < learn_limit ? position : learn_limit);
+    UpdateMarkClusters();
+
+    // Gap priors follow the dit until real gaps have been observed
+    if (space_histogram_.total_weight == 0) {
+      SeedSpaceClustersFromMarks();
+    }
+
+    // Log WPM update periodically (every 10 dits to reduce verbosity)
+    if (event == KeyEvent::kDit && dit_sample_count_ % 10 == 0) {
+      ESP_LOGD(kLogTag, "WPM updated: %" PRIu32 " (dit_avg: %" PRId64 " μs, dah_avg: %" PRId64
+               " μs)", GetWPM(), PositionToUs(mark_centroid_[0]),
+               PositionToUs(mark_centroid_[1]));
     }
+    return event;
   }
+
+  // Key-off duration: classify gap type
+  if (scores != nullptr) {
+    for (size_t i = 0; i < 3; ++i) {
+      scores->cost[i] = DistanceCost(position - space_centroid_[i]);
+    }
+  }
+
+  // Check if we have enough samples for reliable gap classification
+  if (dit_sample_count_ + dah_sample_count_ < kMinSamplesForClassification) {
+    return KeyEvent::kUnknown;
+  }
+
+  KeyEvent event = KeyEvent::kWordGap;
+  if (position < char_gap_threshold_) {
+    event = KeyEvent::kIntraGap;
+  } else if (position < word_gap_threshold_) {
+    event = KeyEvent::kCharGap;
+  }
+
+  if (scores != nullptr) {
+    scores->best = event;
+  }
+
+  const int32_t learn_limit = space_centroid_[2] + kMaxLearnDistance;
+  AddSample(space_histogram_, position < learn_limit ? position : learn_limit);
+  UpdateSpaceClusters();
+  return event;
 }
 
 uint32_t AdaptiveTimingClassifier::GetWPM() const {
-  if (dit_avg_us_ <= 0) {
+  const int64_t dit_us = PositionToUs(mark_centroid_[0]);
+  if (dit_us <= 0) {
     return 0;
   }
 
   // WPM = 1,200,000 / dit_avg_us (PARIS standard)
-  int64_t wpm = 1'200'000 / dit_avg_us_;
+  int64_t wpm = 1'200'000 / dit_us;
 
-  // Clamp to reasonable range (10-60 WPM)
-  if (wpm < 10) return 10;
-  if (wpm > 60) return 60;
+  // Clamp to supported range (5-100 WPM)
+  if (wpm < kMinDetectedWpm) return kMinDetectedWpm;
+  if (wpm > kMaxDetectedWpm) return kMaxDetectedWpm;
 
   return static_cast<uint32_t>(wpm);
 }
 
 TimingStats AdaptiveTimingClassifier::GetTimingStats() const {
   TimingStats stats;
-  stats.avg_dit_us = dit_avg_us_;
-  stats.avg_dah_us = dah_avg_us_;
-  stats.ratio = (dit_avg_us_ > 0) ? static_cast<float>(dah_avg_us_) / static_cast<float>(dit_avg_us_) : 0.0f;
+  if (mark_histogram_.total_weight == 0) {
+    // No marks learned yet: report the nominal defaults exactly
+    stats.avg_dit_us = kDefaultDitUs;
+    stats.avg_dah_us = kDefaultDahUs;
+  } else {
+    stats.avg_dit_us = PositionToUs(mark_centroid_[0]);
+    stats.avg_dah_us = PositionToUs(mark_centroid_[1]);
+  }
+  stats.ratio = (stats.avg_dit_us > 0)
+                    ? static_cast<float>(stats.avg_dah_us) / static_cast<float>(stats.avg_dit_us)
+                    : 0.0f;
   stats.dit_sample_count = dit_sample_count_;
   stats.dah_sample_count = dah_sample_count_;
+  stats.avg_intra_gap_us = PositionToUs(space_centroid_[0]);
+  stats.avg_char_gap_us = PositionToUs(space_centroid_[1]);
+  stats.avg_word_gap_us = PositionToUs(space_centroid_[2]);
+  stats.dit_dah_threshold_us = PositionToUs(dit_dah_threshold_);
+  stats.char_gap_threshold_us = PositionToUs(char_gap_threshold_);
+  stats.word_gap_threshold_us = PositionToUs(word_gap_threshold_);
   return stats;
 }
 
 void AdaptiveTimingClassifier::Reset() {
-  dit_avg_us_ = kDefaultDitUs;
-  dah_avg_us_ = kDefaultDahUs;
+  std::memset(&mark_histogram_, 0, sizeof(mark_histogram_));
+  std::memset(&space_histogram_, 0, sizeof(space_histogram_));
+  mark_centroid_[0] = LogPosition(kDefaultDitUs);
+  mark_centroid_[1] = LogPosition(kDefaultDahUs);
   dit_sample_count_ = 0;
   dah_sample_count_ = 0;
+
+  UpdateMarkClusters();
+  SeedSpaceClustersFromMarks();
   ESP_LOGI(kLogTag, "Classifier reset to defaults");
 }
 
 // --- Private Methods ---
 
-int64_t AdaptiveTimingClassifier::ComputeDitThreshold() const {
-  // Threshold is 1.5x the dit average, adjusted by tolerance
-  // This places the threshold between typical dit and dah durations
-  const float tolerance_factor = 1.0f + (tolerance_percent_ / 100.0f);
-  return static_cast<int64_t>(dit_avg_us_ * 1.5f * tolerance_factor);
+void AdaptiveTimingClassifier::AddSample(DurationHistogram& histogram, int32_t position) {
+  if (position < 0) position = 0;
+  if (position > kMaxPosition) position = kMaxPosition;
+
+  const size_t bin = static_cast<size_t>(position / kUnitsPerBin);
+  histogram.weight[bin] += kSampleWeight;
+  histogram.offset_sum[bin] += static_cast<uint32_t>(position % kUnitsPerBin) * kSampleWeight;
+  histogram.total_weight += kSampleWeight;
+
+  // Exponential forgetting: halve everything once the history window is full
+  if (histogram.total_weight > kHistoryWeight * kSampleWeight) {
+    uint32_t total = 0;
+    for (size_t i = 0; i < kHistogramBins; ++i) {
+      histogram.weight[i] >>= 1;
+      histogram.offset_sum[i] = histogram.weight[i] ? histogram.offset_sum[i] >> 1 : 0;
+      total += histogram.weight[i];
+    }
+    histogram.total_weight = total;
+  }
 }
 
-void AdaptiveTimingClassifier::UpdateDitAverage(int64_t measured_us) {
-  if (dit_sample_count_ == 0) {
-    // First sample: initialize directly
-    dit_avg_us_ = measured_us;
-  } else {
-    // Apply Exponential Moving Average (EMA): α=0.3
-    // new_avg = α * measured + (1-α) * old_avg
-    dit_avg_us_ = static_cast<int64_t>(kEmaAlpha * measured_us + (1.0f - kEmaAlpha) * dit_avg_us_);
+void AdaptiveTimingClassifier::RunKMeans(const DurationHistogram& histogram, int32_t* centroids,
+                                         uint32_t* weights, size_t count) {
+  if (LloydIterations(histogram, centroids, weights, count) == 0) {
+    return;
+  }
+
+  // Locate the populated range of the histogram
+  size_t low_bin = kHistogramBins;
+  size_t high_bin = 0;
+  for (size_t bin = 0; bin < kHistogramBins; ++bin) {
+    if (histogram.weight[bin] != 0) {
+      if (low_bin == kHistogramBins) low_bin = bin;
+      high_bin = bin;
+    }
+  }
+  if (low_bin == kHistogramBins ||
+      static_cast<int32_t>(high_bin - low_bin) * kUnitsPerBin < kMinClusterSeparation) {
+    return;  // Unimodal data: an empty cluster is expected
+  }
+
+  // Restart from seeds spread evenly over the populated range
+  int32_t spread[3];
+  uint32_t spread_weights[3];
+  const int32_t low = static_cast<int32_t>(low_bin) * kUnitsPerBin + kUnitsPerBin / 2;
+  const int32_t high = static_cast<int32_t>(high_bin) * kUnitsPerBin + kUnitsPerBin / 2;
+  for (size_t i = 0; i < count; ++i) {
+    spread[i] = low + static_cast<int32_t>((high - low) * static_cast<int32_t>(i) /
+                                           static_cast<int32_t>(count - 1));
+  }
+  size_t empty_before = 0;
+  for (size_t i = 0; i < count; ++i) {
+    empty_before += (weights[i] == 0) ? 1 : 0;
+  }
+  if (LloydIterations(histogram, spread, spread_weights, count) < empty_before) {
+    for (size_t i = 0; i < count; ++i) {
+      centroids[i] = spread[i];
+      weights[i] = spread_weights[i];
+    }
+  }
+}
+
+size_t AdaptiveTimingClassifier::LloydIterations(const DurationHistogram& histogram,
+                                                 int32_t* centroids, uint32_t* weights,
+                                                 size_t count) {
+  uint32_t sums[3];
+  int32_t boundaries[2];
+
+  for (uint32_t iteration = 0; iteration < kMaxKMeansIterations; ++iteration) {
+    for (size_t i = 0; i + 1 < count; ++i) {
+      boundaries[i] = (centroids[i] + centroids[i + 1]) / 2;
+    }
+    for (size_t i = 0; i < count; ++i) {
+      weights[i] = 0;
+      sums[i] = 0;
+    }
+
+    // Bins are sorted, so the assignment step is a single sweep over the boundaries
+    size_t cluster = 0;
+    for (size_t bin = 0; bin < kHistogramBins; ++bin) {
+      const uint32_t weight = histogram.weight[bin];
+      if (weight == 0) {
+        continue;
+      }
+      const int32_t center = static_cast<int32_t>(bin) * kUnitsPerBin + kUnitsPerBin / 2;
+      while (cluster + 1 < count && center >= boundaries[cluster]) {
+        ++cluster;
+      }
+      weights[cluster] += weight;
+      sums[cluster] += static_cast<uint32_t>(bin) * kUnitsPerBin * weight +
+                       histogram.offset_sum[bin];
+    }
+
+    bool changed = false;
+    for (size_t i = 0; i < count; ++i) {
+      if (weights[i] == 0) {
+        continue;
+      }
+      const int32_t updated = static_cast<int32_t>(sums[i] / weights[i]);
+      if (updated != centroids[i]) {
+        centroids[i] = updated;
+        changed = true;
+      }
+    }
+    if (!changed) {
+      break;
+    }
   }
 
-  dit_sample_count_++;
+  size_t empty = 0;
+  for (size_t i = 0; i < count; ++i) {
+    empty += (weights[i] == 0) ? 1 : 0;
+  }
+  return empty;
+}
+
+void AdaptiveTimingClassifier::UpdateMarkClusters() {
+  static constexpr int32_t kMarkRatioOffsets[1] = {kLog2Of3};
 
-  // Log WPM update periodically (every 10 samples to reduce verbosity)
-  if (dit_sample_count_ % 10 == 0) {
-    const float ratio = (dit_avg_us_ > 0) ? static_cast<float>(dah_avg_us_) / static_cast<float>(dit_avg_us_) : 0.0f;
-    ESP_LOGD(kLogTag, "WPM updated: %" PRIu32 " (dit_avg: %" PRId64 " μs, dah_avg: %" PRId64 " μs, ratio: %.2f)",
-             GetWPM(), dit_avg_us_, dah_avg_us_, ratio);
+  int32_t centroids[2] = {mark_centroid_[0], mark_centroid_[1]};
+  uint32_t weights[2] = {0, 0};
+  RunKMeans(mark_histogram_, centroids, weights, 2);
+  if (FinalizeClusters(centroids, weights, mark_centroid_, kMarkRatioOffsets, 2) < 2) {
+    mark_centroid_[0] = centroids[0];
+    mark_centroid_[1] = centroids[1];
   }
+
+  // Decision point: log-midpoint shifted towards the dah by the tolerance
+  const int32_t span = mark_centroid_[1] - mark_centroid_[0];
+  dit_dah_threshold_ = mark_centroid_[0] + (span * (1000 + tolerance_permille_)) / 2000;
 }
 
-void AdaptiveTimingClassifier::UpdateDahAverage(int64_t measured_us) {
-  if (dah_sample_count_ == 0) {
-    // First sample: initialize directly
-    dah_avg_us_ = measured_us;
-  } else {
-    // Apply Exponential Moving Average (EMA): α=0.3
-    dah_avg_us_ = static_cast<int64_t>(kEmaAlpha * measured_us + (1.0f - kEmaAlpha) * dah_avg_us_);
+void AdaptiveTimingClassifier::UpdateSpaceClusters() {
+  static constexpr int32_t kSpaceRatioOffsets[2] = {kLog2Of3, kLog2Of7Over3};
+
+  int32_t centroids[3] = {space_centroid_[0], space_centroid_[1], space_centroid_[2]};
+  uint32_t weights[3] = {0, 0, 0};
+  RunKMeans(space_histogram_, centroids, weights, 3);
+  if (FinalizeClusters(centroids, weights, space_centroid_, kSpaceRatioOffsets, 3) == 3) {
+    SeedSpaceClustersFromMarks();
+    return;
   }
+  for (size_t i = 0; i < 3; ++i) {
+    space_centroid_[i] = centroids[i];
+  }
+
+  char_gap_threshold_ = (space_centroid_[0] + space_centroid_[1]) / 2;
+  word_gap_threshold_ = (space_centroid_[1] + space_centroid_[2]) / 2;
+}
 
-  dah_sample_count_++;
+void AdaptiveTimingClassifier::SeedSpaceClustersFromMarks() {
+  // Standard spacing: intra = 1 dit, char = 3 dits, word = 7 dits
+  space_centroid_[0] = mark_centroid_[0];
+  space_centroid_[1] = space_centroid_[0] + kLog2Of3;
+  space_centroid_[2] = space_centroid_[1] + kLog2Of7Over3;
+  char_gap_threshold_ = (space_centroid_[0] + space_centroid_[1]) / 2;
+  word_gap_threshold_ = (space_centroid_[1] + space_centroid_[2]) / 2;
 }
 
 }  // namespace morse_decoder
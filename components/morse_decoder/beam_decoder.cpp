@@ -0,0 +1,404 @@
+/**
+ * @file beam_decoder.cpp
+ * @brief Probabilistic beam-search (Viterbi) morse decoder implementation
+ */
+
+#include "morse_decoder/beam_decoder.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+namespace morse_decoder {
+
+namespace {
+
+// Language model alphabet: A-Z, 0-9, space, everything else
+constexpr size_t kLetterBase = 0;
+constexpr size_t kDigitBase = 26;
+constexpr size_t kSpaceClass = 36;
+constexpr size_t kOtherClass = 37;
+constexpr size_t kClassCount = 38;
+
+size_t CharClass(char c) {
+  if (c >= 'A' && c <= 'Z') {
+    return kLetterBase + static_cast<size_t>(c - 'A');
+  }
+  if (c >= 'a' && c <= 'z') {
+    return kLetterBase + static_cast<size_t>(c - 'a');
+  }
+  if (c >= '0' && c <= '9') {
+    return kDigitBase + static_cast<size_t>(c - '0');
+  }
+  return (c == ' ') ? kSpaceClass : kOtherClass;
+}
+
+// Unigram costs: round(-ln(p) × 32), i.e. half weight relative to the timing costs
+// (64 units per nat). Letters share p = 0.76 (English frequencies, Q/K boosted for
+// amateur radio traffic), space p = 0.17, each digit p = 0.006, punctuation 0.01 total.
+constexpr uint16_t kUnigramCost[kClassCount] = {
+    89,  144, 124, 110, 75,  131, 134, 99,  94,  217,  // A-J
+    151, 112, 128, 96,  92,  136, 179, 99,  98,  86,   // K-T
+    124, 156, 128, 208, 134, 230,                      // U-Z
+    164, 164, 164, 164, 164, 164, 164, 164, 164, 164,  // 0-9
+    57,                                                // space
+    214,                                               // other
+};
+
+/**
+ * @brief Frequent bigram with its conditional cost round(-ln(P(next | prev)) × 32)
+ */
+struct Bigram {
+  char previous;
+  char next;
+  uint16_t cost;
+};
+
+constexpr uint16_t BigramKey(size_t previous_class, size_t next_class) {
+  return static_cast<uint16_t>(previous_class * kClassCount + next_class);
+}
+
+// Sorted by (CharClass(previous), CharClass(next)) for binary search
+constexpr Bigram kBigrams[] = {
+    {'A', 'N', 55},   // P=0.18
+    {'A', 'T', 68},   // P=0.12
+    {'C', 'Q', 39},   // P=0.30 (CQ)
+    {'D', 'E', 44},   // P=0.25 (DE)
+    {'D', ' ', 34},   // P=0.35
+    {'E', 'D', 74},   // P=0.10
+    {'E', 'N', 74},   // P=0.10
+    {'E', 'R', 61},   // P=0.15
+    {'E', 'S', 74},   // P=0.10
+    {'E', ' ', 34},   // P=0.35
+    {'F', 'B', 61},   // P=0.15 (FB)
+    {'H', 'A', 61},   // P=0.15
+    {'H', 'E', 34},   // P=0.35
+    {'H', 'I', 74},   // P=0.10
+    {'I', 'N', 52},   // P=0.20
+    {'I', 'S', 74},   // P=0.10
+    {'I', 'T', 68},   // P=0.12
+    {'K', ' ', 22},   // P=0.50 (K, TNX K)
+    {'N', 'D', 68},   // P=0.12
+    {'N', 'G', 74},   // P=0.10
+    {'N', 'N', 81},   // P=0.08 (5NN)
+    {'N', ' ', 44},   // P=0.25
+    {'O', 'N', 61},   // P=0.15
+    {'O', 'R', 68},   // P=0.12
+    {'O', 'U', 68},   // P=0.12
+    {'Q', 'R', 61},   // P=0.15 (QRZ, QRL)
+    {'Q', 'S', 61},   // P=0.15 (QSL, QSO)
+    {'Q', 'T', 74},   // P=0.10 (QTH)
+    {'Q', 'U', 39},   // P=0.30
+    {'R', 'E', 52},   // P=0.20
+    {'R', 'S', 81},   // P=0.08 (RST)
+    {'R', ' ', 44},   // P=0.25
+    {'S', 'T', 68},   // P=0.12
+    {'S', ' ', 34},   // P=0.35
+    {'T', 'H', 39},   // P=0.30
+    {'T', 'O', 68},   // P=0.12
+    {'T', 'U', 74},   // P=0.10 (TU)
+    {'T', ' ', 44},   // P=0.25
+    {'U', 'R', 61},   // P=0.15 (UR)
+    {'U', ' ', 44},   // P=0.25
+    {'W', 'X', 74},   // P=0.10 (WX)
+    {'Y', ' ', 29},   // P=0.40
+    {'3', ' ', 22},   // P=0.50 (73)
+    {'5', 'N', 39},   // P=0.30 (5NN)
+    {'5', '9', 39},   // P=0.30 (599)
+    {'7', '3', 16},   // P=0.60 (73)
+    {'9', '9', 39},   // P=0.30 (599)
+    {' ', 'A', 71},   // P=0.11
+    {' ', 'C', 90},   // P=0.06
+    {' ', 'D', 90},   // P=0.06
+    {' ', 'Q', 96},   // P=0.05
+    {' ', 'T', 59},   // P=0.16
+    {' ', '5', 112},  // P=0.03
+};
+
+}  // namespace
+
+// ============================================================================
+// CONSTRUCTION
+// ============================================================================
+
+BeamDecoder::BeamDecoder(const MorseTable& table) {
+  std::memset(tree_, 0, sizeof(tree_));
+
+  // Enumerate every pattern of 1..kMaxPatternLength elements: node n at depth d
+  // spells its pattern in the d bits below its leading one (0 = dit, 1 = dah)
+  std::string pattern;
+  for (size_t node = 2; node < kTreeSize; ++node) {
+    pattern.clear();
+    const int depth = 31 - __builtin_clz(static_cast<unsigned>(node));
+    for (int bit = depth - 1; bit >= 0; --bit) {
+      pattern += ((node >> bit) & 1U) ? '-' : '.';
+    }
+    tree_[node] = table.Lookup(pattern);
+  }
+
+  Reset();
+}
+
+void BeamDecoder::Reset() {
+  beam_size_ = 1;
+  beam_[0] = Hypothesis{};
+  beam_[0].node = kRootNode;
+  beam_[0].last_char = ' ';
+  next_size_ = 0;
+}
+
+// ============================================================================
+// SEARCH
+// ============================================================================
+
+size_t BeamDecoder::ProcessElement(const ElementScores& scores, char* committed,
+                                   size_t capacity) {
+  next_size_ = 0;
+
+  for (size_t i = 0; i < beam_size_; ++i) {
+    const Hypothesis& hypothesis = beam_[i];
+
+    if (scores.key_on) {
+      // Mark: descend to the dit and dah children (invalid once past the tree depth)
+      for (uint8_t element = 0; element < 2; ++element) {
+        Hypothesis candidate = hypothesis;
+        candidate.cost += scores.cost[element];
+        if (hypothesis.node == kInvalidNode) {
+          candidate.node = kInvalidNode;
+        } else if (hypothesis.node >= kTreeSize / 2) {
+          // Longer than any morse character: charge the unknown-character cost now so
+          // the hypothesis cannot defer its decision indefinitely
+          candidate.node = kInvalidNode;
+          candidate.cost += kUnknownCharCost;
+        } else {
+          candidate.node = static_cast<uint8_t>(hypothesis.node * 2 + element);
+        }
+        OfferCandidate(candidate);
+      }
+      continue;
+    }
+
+    // Space at a character boundary: nothing to decide, pay the best explanation
+    if (hypothesis.node == kRootNode) {
+      Hypothesis candidate = hypothesis;
+      candidate.cost +=
+          std::min(scores.cost[0], std::min(scores.cost[1], scores.cost[2]));
+      OfferCandidate(candidate);
+      continue;
+    }
+
+    const char decoded = NodeChar(hypothesis.node);
+
+    Hypothesis intra = hypothesis;
+    intra.cost += scores.cost[0];
+    OfferCandidate(intra);
+
+    Hypothesis char_end = hypothesis;
+    char_end.cost += scores.cost[1];
+    EmitChar(char_end, decoded);
+    OfferCandidate(char_end);
+
+    Hypothesis word_end = hypothesis;
+    word_end.cost += scores.cost[2];
+    EmitChar(word_end, decoded);
+    EmitChar(word_end, ' ');
+    OfferCandidate(word_end);
+  }
+
+  // Swap in the new beam, drop hopeless hypotheses and renormalize so costs stay small
+  uint32_t best_cost = UINT32_MAX;
+  for (size_t i = 0; i < next_size_; ++i) {
+    best_cost = std::min(best_cost, next_beam_[i].cost);
+  }
+  beam_size_ = 0;
+  for (size_t i = 0; i < next_size_; ++i) {
+    if (next_beam_[i].cost - best_cost > kPruneMargin) {
+      continue;
+    }
+    beam_[beam_size_] = next_beam_[i];
+    beam_[beam_size_].cost -= best_cost;
+    beam_size_++;
+  }
+
+  return Commit(committed, capacity);
+}
+
+size_t BeamDecoder::Flush(char* committed, size_t capacity) {
+  Hypothesis best = beam_[BestIndex()];
+  if (best.node != kRootNode) {
+    EmitChar(best, NodeChar(best.node));
+    EmitChar(best, ' ');
+  }
+
+  size_t count = 0;
+  for (size_t i = 0; i < best.pending_length && count < capacity; ++i) {
+    committed[count++] = best.pending[i];
+  }
+
+  beam_size_ = 1;
+  beam_[0] = Hypothesis{};
+  beam_[0].node = kRootNode;
+  beam_[0].last_char = best.last_char;
+  return count;
+}
+
+bool BeamDecoder::HasPending() const {
+  const Hypothesis& best = beam_[BestIndex()];
+  return best.node != kRootNode || best.pending_length > 0;
+}
+
+size_t BeamDecoder::GetBestPattern(char* pattern, size_t capacity) const {
+  if (capacity == 0) {
+    return 0;
+  }
+  const uint8_t node = beam_[BestIndex()].node;
+  size_t length = 0;
+  if (node > kRootNode) {
+    const int depth = 31 - __builtin_clz(static_cast<unsigned>(node));
+    for (int bit = depth - 1; bit >= 0 && length + 1 < capacity; --bit) {
+      pattern[length++] = ((node >> bit) & 1U) ? '-' : '.';
+    }
+  }
+  pattern[length] = '\0';
+  return length;
+}
+
+uint16_t BeamDecoder::LanguageCost(char previous, char next) {
+  const size_t previous_class = CharClass(previous);
+  const size_t next_class = CharClass(next);
+  const uint16_t key = BigramKey(previous_class, next_class);
+
+  const Bigram* begin = std::begin(kBigrams);
+  const Bigram* end = std::end(kBigrams);
+  const Bigram* found = std::lower_bound(begin, end, key, [](const Bigram& entry, uint16_t k) {
+    return BigramKey(CharClass(entry.previous), CharClass(entry.next)) < k;
+  });
+  if (found != end && BigramKey(CharClass(found->previous), CharClass(found->next)) == key) {
+    return found->cost;
+  }
+  return kUnigramCost[next_class];
+}
+
+// ============================================================================
+// HELPERS
+// ============================================================================
+
+char BeamDecoder::NodeChar(uint8_t node) const {
+  if (node == kInvalidNode || tree_[node] == '\0') {
+    return '?';
+  }
+  return tree_[node];
+}
+
+void BeamDecoder::EmitChar(Hypothesis& hypothesis, char c) const {
+  hypothesis.cost += LanguageCost(hypothesis.last_char, c);
+  if (c != ' ' && hypothesis.node != kInvalidNode && tree_[hypothesis.node] == '\0') {
+    hypothesis.cost += kUnknownCharCost;
+  }
+  hypothesis.pending[hypothesis.pending_length++] = c;
+  hypothesis.last_char = c;
+  hypothesis.node = kRootNode;
+}
+
+void BeamDecoder::OfferCandidate(const Hypothesis& candidate) {
+  // Viterbi merge: equal (node, last_char) states have identical futures
+  for (size_t i = 0; i < next_size_; ++i) {
+    Hypothesis& existing = next_beam_[i];
+    if (existing.node == candidate.node && existing.last_char == candidate.last_char) {
+      if (candidate.cost < existing.cost) {
+        existing = candidate;
+      }
+      return;
+    }
+  }
+
+  if (next_size_ < kBeamWidth) {
+    next_beam_[next_size_++] = candidate;
+    return;
+  }
+
+  size_t worst = 0;
+  for (size_t i = 1; i < next_size_; ++i) {
+    if (next_beam_[i].cost > next_beam_[worst].cost) {
+      worst = i;
+    }
+  }
+  if (candidate.cost < next_beam_[worst].cost) {
+    next_beam_[worst] = candidate;
+  }
+}
+
+size_t BeamDecoder::Commit(char* committed, size_t capacity) {
+  size_t count = 0;
+
+  while (count < capacity) {
+    // 1. All hypotheses agree on the oldest pending character
+    bool agree = true;
+    for (size_t i = 0; i < beam_size_; ++i) {
+      if (beam_[i].pending_length == 0 || beam_[i].pending[0] != beam_[0].pending[0]) {
+        agree = false;
+        break;
+      }
+    }
+    if (agree) {
+      committed[count++] = beam_[0].pending[0];
+      for (size_t i = 0; i < beam_size_; ++i) {
+        PopPending(beam_[i]);
+      }
+      continue;
+    }
+
+    // 2. Decision delay bound reached: follow the best hypothesis
+    size_t max_pending = 0;
+    for (size_t i = 0; i < beam_size_; ++i) {
+      max_pending = std::max<size_t>(max_pending, beam_[i].pending_length);
+    }
+    if (max_pending < kMaxDelayChars) {
+      break;
+    }
+
+    const Hypothesis& best = beam_[BestIndex()];
+    const bool best_has_pending = best.pending_length > 0;
+    const char forced = best_has_pending ? best.pending[0] : '\0';
+
+    size_t kept = 0;
+    for (size_t i = 0; i < beam_size_; ++i) {
+      const bool keep = best_has_pending
+                            ? (beam_[i].pending_length > 0 && beam_[i].pending[0] == forced)
+                            : (beam_[i].pending_length < kMaxDelayChars);
+      if (keep) {
+        beam_[kept++] = beam_[i];
+      }
+    }
+    beam_size_ = kept;
+
+    if (best_has_pending) {
+      committed[count++] = forced;
+      for (size_t i = 0; i < beam_size_; ++i) {
+        PopPending(beam_[i]);
+      }
+    }
+  }
+
+  return count;
+}
+
+void BeamDecoder::PopPending(Hypothesis& hypothesis) {
+  if (hypothesis.pending_length == 0) {
+    return;
+  }
+  std::memmove(hypothesis.pending, hypothesis.pending + 1, hypothesis.pending_length - 1);
+  hypothesis.pending_length--;
+}
+
+size_t BeamDecoder::BestIndex() const {
+  size_t best = 0;
+  for (size_t i = 1; i < beam_size_; ++i) {
+    if (beam_[i].cost < beam_[best].cost) {
+      best = i;
+    }
+  }
+  return best;
+}
+
+}  // namespace morse_decoder
@@ -0,0 +1,130 @@
+/**
+ * @file decoder_service.cpp
+ * @brief Parallel morse decoding of the local and remote key streams
+ */
+
+#include "morse_decoder/decoder_service.hpp"
+
+#include "esp_log.h"
+
+namespace morse_decoder {
+
+namespace {
+
+constexpr char kLogTag[] = "decoder_service";
+
+MorseDecoderConfig StreamDecoderConfig(const DecoderServiceConfig& config, KeySource source,
+                                       size_t buffer_size,
+                                       AdaptiveTimingClassifier* classifier) {
+  MorseDecoderConfig decoder_config;
+  decoder_config.buffer_size = buffer_size;
+  decoder_config.enable_logging = config.enable_logging;
+  decoder_config.timing_classifier = classifier;
+  decoder_config.mode = config.mode;
+  decoder_config.source = source;
+  return decoder_config;
+}
+
+size_t SourceIndex(KeySource source) {
+  const size_t index = static_cast<size_t>(source);
+  return index < kKeySourceCount ? index : 0;
+}
+
+}  // namespace
+
+DecoderService::Stream::Stream(const DecoderServiceConfig& config, KeySource source,
+                               size_t buffer_size)
+    : classifier(config.tolerance_percent),
+      decoder(StreamDecoderConfig(config, source, buffer_size, &classifier)) {}
+
+DecoderService::DecoderService(const DecoderServiceConfig& config) {
+  for (size_t i = 0; i < kKeySourceCount; ++i) {
+    const auto source = static_cast<KeySource>(i);
+    const size_t buffer_size =
+        (source == KeySource::kLocal) ? config.local_buffer_size : config.remote_buffer_size;
+    streams_[i] = std::make_unique<Stream>(config, source, buffer_size);
+  }
+  ESP_LOGI(kLogTag, "Decoder service ready (%zu streams, local buffer=%zu, remote buffer=%zu)",
+           kKeySourceCount, config.local_buffer_size, config.remote_buffer_size);
+}
+
+void DecoderService::OnKeyEdge(KeySource source, bool key_down, int64_t timestamp_us) {
+  Stream& stream = *streams_[SourceIndex(source)];
+  if (stream.last_edge_us != 0 && key_down == stream.key_down) {
+    return;  // Repeated state, no duration ended
+  }
+
+  if (timeline_logger_ != nullptr && source != KeySource::kLocal) {
+    timeline_logger_->push(timeline::TimelineEvent{
+        .timestamp_us = timestamp_us,
+        .type = timeline::EventType::kRemoteEvent,
+        .arg0 = static_cast<uint32_t>(source),
+        .arg1 = key_down ? 1U : 0U,
+    });
+  }
+
+  if (stream.last_edge_us != 0) {
+    const int64_t duration_us = timestamp_us - stream.last_edge_us;
+    if (duration_us > 0 && duration_us <= kMaxElementUs) {
+      // The duration that just ended has the previous state (key down = mark)
+      ElementScores scores;
+      stream.classifier.ClassifyDuration(duration_us, stream.key_down, &scores);
+      stream.decoder.ProcessElement(scores);
+    }
+  }
+
+  stream.last_edge_us = timestamp_us;
+  stream.key_down = key_down;
+  stream.active.store(true, std::memory_order_relaxed);
+}
+
+void DecoderService::Tick(int64_t now_us) {
+  for (auto& stream : streams_) {
+    stream->decoder.Tick(now_us);
+  }
+}
+
+MorseDecoder* DecoderService::GetDecoder(KeySource source) const {
+  return &streams_[SourceIndex(source)]->decoder;
+}
+
+AdaptiveTimingClassifier* DecoderService::GetClassifier(KeySource source) const {
+  return &streams_[SourceIndex(source)]->classifier;
+}
+
+bool DecoderService::HasActivity(KeySource source) const {
+  return streams_[SourceIndex(source)]->active.load(std::memory_order_relaxed);
+}
+
+void DecoderService::SetEnabled(bool enabled) {
+  for (auto& stream : streams_) {
+    stream->decoder.SetEnabled(enabled);
+  }
+}
+
+void DecoderService::SetDecodingMode(DecodingMode mode) {
+  for (auto& stream : streams_) {
+    stream->decoder.SetDecodingMode(mode);
+  }
+}
+
+void DecoderService::SetTimelineLogger(timeline::EventLogger<timeline::kTimelineCapacity>* logger) {
+  timeline_logger_ = logger;
+  for (auto& stream : streams_) {
+    stream->decoder.SetTimelineLogger(logger);
+  }
+}
+
+const char* DecoderService::SourceName(KeySource source) {
+  switch (source) {
+    case KeySource::kLocal:
+      return "local";
+    case KeySource::kRemoteClient:
+      return "remote_client";
+    case KeySource::kRemoteServer:
+      return "remote_server";
+  }
+  return "unknown";
+}
+
+}  // namespace morse_decoder
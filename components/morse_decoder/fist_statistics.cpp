@@ -0,0 +1,264 @@
+/**
+ * @file fist_statistics.cpp
+ * @brief Streaming timing statistics of the operator's "fist"
+ */
+
+#include "morse_decoder/fist_statistics.hpp"
+
+#include <cmath>
+
+namespace morse_decoder {
+
+namespace {
+
+constexpr size_t kDit = static_cast<size_t>(KeyEvent::kDit);
+constexpr size_t kDah = static_cast<size_t>(KeyEvent::kDah);
+constexpr size_t kIntraGap = static_cast<size_t>(KeyEvent::kIntraGap);
+constexpr size_t kCharGap = static_cast<size_t>(KeyEvent::kCharGap);
+constexpr size_t kWordGap = static_cast<size_t>(KeyEvent::kWordGap);
+
+/// PARIS: WPM = 1,200,000 / dit_us
+constexpr float kParisUnitUs = 1'200'000.0f;
+
+/// Count-weighted coefficient of variation of two classes, in percent
+float PooledCvPercent(const RunningMoments& a, const RunningMoments& b) {
+  float weighted = 0.0f;
+  uint32_t total = 0;
+  const RunningMoments* const pair[2] = {&a, &b};
+  for (const RunningMoments* moments : pair) {
+    if (moments->Count() >= 2 && moments->Mean() > 0.0f) {
+      weighted += static_cast<float>(moments->Count()) * moments->StdDev() / moments->Mean();
+      total += moments->Count();
+    }
+  }
+  return total > 0 ? 100.0f * weighted / static_cast<float>(total) : 0.0f;
+}
+
+}  // namespace
+
+// ============================================================================
+// RunningMoments
+// ============================================================================
+
+void RunningMoments::Reset() {
+  count_ = 0;
+  mean_ = 0.0f;
+  m2_ = 0.0f;
+}
+
+void RunningMoments::Add(float value) {
+  ++count_;
+  const float delta = value - mean_;
+  mean_ += delta / static_cast<float>(count_);
+  m2_ += delta * (value - mean_);
+}
+
+float RunningMoments::Variance() const {
+  return count_ < 2 ? 0.0f : m2_ / static_cast<float>(count_ - 1);
+}
+
+float RunningMoments::StdDev() const {
+  return std::sqrt(Variance());
+}
+
+// ============================================================================
+// P2Quantile
+// ============================================================================
+
+P2Quantile::P2Quantile(float quantile) : quantile_(quantile) {
+  Reset();
+}
+
+void P2Quantile::Reset() {
+  count_ = 0;
+  const float p = quantile_;
+  const float desired[5] = {0.0f, 2.0f * p, 4.0f * p, 2.0f + 2.0f * p, 4.0f};
+  const float increment[5] = {0.0f, p / 2.0f, p, (1.0f + p) / 2.0f, 1.0f};
+  for (int i = 0; i < 5; ++i) {
+    height_[i] = 0.0f;
+    position_[i] = i;
+    desired_[i] = desired[i];
+    increment_[i] = increment[i];
+  }
+}
+
+void P2Quantile::Add(float value) {
+  // Warm-up: keep the first five samples sorted (insertion)
+  if (count_ < 5) {
+    int i = static_cast<int>(count_);
+    for (; i > 0 && height_[i - 1] > value; --i) {
+      height_[i] = height_[i - 1];
+    }
+    height_[i] = value;
+    ++count_;
+    return;
+  }
+  ++count_;
+
+  // Find the cell containing the sample, extending the extremes if needed
+  int cell;
+  if (value < height_[0]) {
+    height_[0] = value;
+    cell = 0;
+  } else if (value >= height_[4]) {
+    height_[4] = value;
+    cell = 3;
+  } else {
+    cell = 0;
+    while (cell < 3 && value >= height_[cell + 1]) {
+      ++cell;
+    }
+  }
+
+  for (int i = cell + 1; i < 5; ++i) {
+    ++position_[i];
+  }
+  for (int i = 0; i < 5; ++i) {
+    desired_[i] += increment_[i];
+  }
+
+  // Move the three middle markers towards their desired positions
+  for (int i = 1; i <= 3; ++i) {
+    const float offset = desired_[i] - static_cast<float>(position_[i]);
+    if ((offset >= 1.0f && position_[i + 1] - position_[i] > 1) ||
+        (offset <= -1.0f && position_[i - 1] - position_[i] < -1)) {
+      const int d = offset > 0.0f ? 1 : -1;
+      const float candidate = Parabolic(i, d);
+      height_[i] = (height_[i - 1] < candidate && candidate < height_[i + 1]) ? candidate
+                                                                              : Linear(i, d);
+      position_[i] += d;
+    }
+  }
+}
+
+float P2Quantile::Value() const {
+  if (count_ == 0) {
+    return 0.0f;
+  }
+  if (count_ <= 5) {
+    // Exact: nearest-rank on the sorted warm-up samples
+    const size_t index =
+        static_cast<size_t>(std::lround(quantile_ * static_cast<float>(count_ - 1)));
+    return height_[index];
+  }
+  return height_[2];
+}
+
+float P2Quantile::Parabolic(int i, int d) const {
+  const float n_prev = static_cast<float>(position_[i - 1]);
+  const float n = static_cast<float>(position_[i]);
+  const float n_next = static_cast<float>(position_[i + 1]);
+  const float df = static_cast<float>(d);
+  return height_[i] +
+         df / (n_next - n_prev) *
+             ((n - n_prev + df) * (height_[i + 1] - height_[i]) / (n_next - n) +
+              (n_next - n - df) * (height_[i] - height_[i - 1]) / (n - n_prev));
+}
+
+float P2Quantile::Linear(int i, int d) const {
+  return height_[i] + static_cast<float>(d) * (height_[i + d] - height_[i]) /
+                          static_cast<float>(position_[i + d] - position_[i]);
+}
+
+// ============================================================================
+// FistStatistics
+// ============================================================================
+
+FistStatistics::FistStatistics() {
+  Reset();
+}
+
+void FistStatistics::Reset() {
+  for (auto& accumulator : classes_) {
+    accumulator.moments.Reset();
+    accumulator.p10.Reset();
+    accumulator.p50.Reset();
+    accumulator.p90.Reset();
+  }
+  window_head_ = 0;
+  window_count_ = 0;
+  window_sum_ = 0;
+}
+
+void FistStatistics::AddElement(KeyEvent event, int64_t duration_us) {
+  const size_t index = static_cast<size_t>(event);
+  if (index >= FistStats::kClassCount || duration_us <= 0) {
+    return;
+  }
+  const float duration = static_cast<float>(duration_us);
+  const RunningMoments& dits = classes_[kDit].moments;
+
+  // Long pauses (operator stopped sending) would swamp the word spacing figures
+  if (index == kWordGap && dits.Count() > 0 && duration > kMaxWordGapUnits * dits.Mean()) {
+    return;
+  }
+
+  ClassAccumulator& accumulator = classes_[index];
+  accumulator.moments.Add(duration);
+  accumulator.p10.Add(duration);
+  accumulator.p50.Add(duration);
+  accumulator.p90.Add(duration);
+
+  // Rolling speed window: dits directly, dahs scaled by the session ratio
+  float unit = 0.0f;
+  if (index == kDit) {
+    unit = duration;
+  } else if (index == kDah && dits.Count() > 0) {
+    unit = duration * dits.Mean() / accumulator.moments.Mean();
+  }
+  if (unit >= 1.0f) {
+    if (window_count_ == kWindowSize) {
+      window_sum_ -= window_[window_head_];
+    } else {
+      ++window_count_;
+    }
+    window_[window_head_] = static_cast<uint32_t>(unit);
+    window_sum_ += window_[window_head_];
+    window_head_ = (window_head_ + 1) % kWindowSize;
+  }
+}
+
+FistStats FistStatistics::GetSnapshot() const {
+  FistStats stats;
+  for (size_t i = 0; i < FistStats::kClassCount; ++i) {
+    const ClassAccumulator& accumulator = classes_[i];
+    FistStats::ClassStats& out = stats.classes[i];
+    out.count = accumulator.moments.Count();
+    out.mean_us = accumulator.moments.Mean();
+    out.stddev_us = accumulator.moments.StdDev();
+    out.p10_us = accumulator.p10.Value();
+    out.p50_us = accumulator.p50.Value();
+    out.p90_us = accumulator.p90.Value();
+  }
+
+  const float dit = classes_[kDit].moments.Mean();
+  const float dah = classes_[kDah].moments.Mean();
+  const float intra = classes_[kIntraGap].moments.Mean();
+  if (dit <= 0.0f) {
+    return stats;
+  }
+
+  if (dah > 0.0f) {
+    stats.dah_dit_ratio = dah / dit;
+  }
+  if (intra > 0.0f) {
+    stats.weighting_percent = 100.0f * dit / (dit + intra);
+  }
+  stats.jitter_percent = PooledCvPercent(classes_[kDit].moments, classes_[kDah].moments);
+  stats.gap_jitter_percent =
+      PooledCvPercent(classes_[kIntraGap].moments, classes_[kCharGap].moments);
+  stats.char_gap_units = classes_[kCharGap].moments.Mean() / dit;
+  stats.word_gap_units = classes_[kWordGap].moments.Mean() / dit;
+
+  stats.session_wpm = kParisUnitUs / dit;
+  stats.window_count = static_cast<uint32_t>(window_count_);
+  if (window_count_ > 0 && window_sum_ > 0) {
+    stats.window_wpm =
+        kParisUnitUs * static_cast<float>(window_count_) / static_cast<float>(window_sum_);
+    stats.speed_drift_percent = 100.0f * (stats.window_wpm - stats.session_wpm) /
+                                stats.session_wpm;
+  }
+  return stats;
+}
+
+}  // namespace morse_decoder
@@ -4,30 +4,41 @@
  *
  * ARCHITECTURE RATIONALE:
  * =======================
- * This classifier uses Exponential Moving Average (EMA) to continuously adapt to
- * the operator's actual keying timing, supporting non-standard dit/dah ratios
- * (2.5:1 to 4:1 instead of strictly 3:1) and varying speeds (10-60 WPM).
+ * This classifier keeps two small log-spaced duration histograms (key-on marks and
+ * key-off spaces) and places its decision thresholds with incremental 1-D k-means.
+ * Unlike a fixed "1.5 × dit" rule it follows heavy weighting (long dits, short
+ * spaces), Farnsworth spacing (stretched character/word gaps) and non-standard
+ * dit/dah ratios, and supports 5-100 WPM.
  *
  * ALGORITHM DETAILS:
- * - EMA smoothing factor α = 0.3 balances noise reduction vs. adaptation speed
- * - Dynamic thresholds recalculated after each classified dit/dah
- * - Separate averages for dit and dah (no assumption of fixed ratio)
- * - Warm-up period: First 3 samples use default assumptions (20 WPM, 3:1 ratio)
+ * - Durations are mapped to a fixed-point log2 position (piecewise-linear mantissa,
+ *   2048 units per octave) and accumulated in 8-bins-per-octave histograms
+ * - Marks: 2 clusters (dit, dah). Spaces: 3 clusters (intra, char, word), degraded
+ *   to 2 when the long-gap population is not clearly bimodal (e.g. a single word)
+ * - After every sample a few Lloyd iterations run, seeded with the previous
+ *   centroids, so the clustering converges incrementally as the operator keys
+ * - Histograms decay (halve) once they hold ~kHistoryWeight samples, so the
+ *   model follows speed changes
+ * - Empty clusters are re-seeded from their neighbours with the standard 1:3:7 ratios
+ * - Warm-up period: gaps return kUnknown until 3 marks have been classified
  *
  * TIMING PRECISION:
  * - Input: Microsecond timestamps from esp_timer_get_time()
+ * - Integer arithmetic only on the classification path (no FPU use in the ISR-fed loop)
  * - Performance budget: ClassifyDuration() must complete in < 100 μs
+ * - Memory: two histograms of kHistogramBins bins (~1 KB total)
  *
- * RESPONSIB ILITIES:
+ * RESPONSIBILITIES:
  * - Classify key-on durations as dit or dah
  * - Classify key-off durations as intra-character, inter-character, or inter-word gaps
- * - Maintain running averages of dit/dah durations (EMA)
+ * - Maintain cluster centroids of dit/dah and gap durations
  * - Detect operator's sending speed (WPM)
  * - Adapt to timing variations and non-standard ratios
  */
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include "morse_decoder/timing_stats.hpp"
 
@@ -45,6 +56,27 @@ enum class KeyEvent : uint8_t {
   kUnknown = 255 ///< Cannot classify yet (warm-up period, invalid timing)
 };
 
+/**
+ * @brief Soft classification of one keying duration
+ *
+ * Costs are negative log-likelihoods in fixed point (kCostUnitsPerNat per nat) of the
+ * duration under each cluster of the current timing model, computed before the sample
+ * is learned. Lower is more likely. Used by the beam decoder to weigh alternatives.
+ */
+struct ElementScores {
+  /// Fixed-point scale of the costs (64 units ≈ 1 nat)
+  static constexpr uint16_t kCostUnitsPerNat = 64;
+
+  /// Cost of classes that do not apply (e.g. word gap for a key-on duration)
+  static constexpr uint16_t kImpossibleCost = UINT16_MAX;
+
+  KeyEvent best = KeyEvent::kUnknown;  ///< Hard decision (same as ClassifyDuration result)
+  bool key_on = false;                 ///< True for marks (dit/dah), false for spaces
+  int64_t duration_us = 0;             ///< Classified duration
+  /// Marks: [dit, dah, impossible]. Spaces: [intra gap, char gap, word gap]
+  uint16_t cost[3] = {kImpossibleCost, kImpossibleCost, kImpossibleCost};
+};
+
 /**
  * @brief Adaptive timing classifier for morse code
  *
@@ -64,12 +96,22 @@ enum class KeyEvent : uint8_t {
  */
 class AdaptiveTimingClassifier {
  public:
+  /// Histogram resolution: 8 bins per octave (~9% per bin)
+  static constexpr uint32_t kBinsPerOctave = 8;
+
+  /// Histogram span: 10 octaves starting at 4.096 ms (up to ~4.2 s)
+  static constexpr uint32_t kHistogramOctaves = 10;
+
+  /// Total number of bins per histogram
+  static constexpr size_t kHistogramBins = kBinsPerOctave * kHistogramOctaves;
+
   /**
    * @brief Construct classifier with specified tolerance
    * @param tolerance_percent Timing tolerance as percentage (±%, typically 10-50)
    *
-   * Higher tolerance is more forgiving of inconsistent keying but may misclassify
-   * borderline cases. Typical value: 25.0f (±25%).
+   * The tolerance shifts the dit/dah decision point from the log-midpoint of the
+   * two clusters towards the dah centroid. Higher tolerance is more forgiving of
+   * long dits but may misclassify borderline dahs. Typical value: 25.0f (±25%).
    *
    * Initializes with default assumptions: 20 WPM (dit=60ms), 3:1 ratio (dah=180ms).
    */
@@ -81,74 +123,128 @@ class AdaptiveTimingClassifier {
    * @param was_key_on True if this was a key-on duration (dit/dah), false for key-off (gap)
    * @return Classified event type
    *
+   * The duration is classified against the current thresholds, then added to the
+   * mark or space histogram and the clusters are refined.
+   *
    * For key-on durations (was_key_on=true):
-   * - Classifies as kDit or kDah based on threshold
-   * - Updates internal dit/dah averages (EMA)
+   * - Classifies as kDit or kDah
    *
    * For key-off durations (was_key_on=false):
    * - Classifies as kIntraGap, kCharGap, or kWordGap
-   * - Does not update averages (gaps don't affect timing calibration)
-   *
-   * Returns kUnknown during warm-up period (< 3 samples).
+   * - Returns kUnknown during warm-up period (< 3 classified marks)
    *
    * Performance: Guaranteed to complete in < 100 μs on ESP32-S3.
    */
   KeyEvent ClassifyDuration(int64_t duration_us, bool was_key_on);
 
+  /**
+   * @brief Classify a duration and report per-class costs
+   * @param duration_us Duration in microseconds
+   * @param was_key_on True for key-on durations, false for gaps
+   * @param scores Out: hard decision plus per-class costs (may be nullptr)
+   * @return Classified event type (identical to the two-argument overload)
+   *
+   * Costs model each cluster as a Gaussian in the log-duration domain (σ = 1/4 octave)
+   * centred on the cluster centroid. Gap costs are reported during warm-up too, even
+   * though the hard decision is kUnknown.
+   */
+  KeyEvent ClassifyDuration(int64_t duration_us, bool was_key_on, ElementScores* scores);
+
   /**
    * @brief Get detected Words Per Minute (WPM)
-   * @return Current WPM estimate (10-60 range)
+   * @return Current WPM estimate (5-100 range)
    */
   uint32_t GetWPM() const;
 
   /**
    * @brief Get detailed timing statistics
-   * @return Structure with dit/dah averages, ratio, sample counts
+   * @return Structure with centroids, thresholds, ratio and sample counts
    */
   TimingStats GetTimingStats() const;
 
   /**
    * @brief Reset classifier to initial state
    *
-   * Clears learned timing and returns to default assumptions (20 WPM, 3:1 ratio).
+   * Clears both histograms and returns to default assumptions (20 WPM, 3:1 ratio).
    * Use when operator changes or to clear bad calibration.
    */
   void Reset();
 
  private:
   /**
-   * @brief Calculate dit/dah threshold for classification
-   * @return Threshold in microseconds
+   * @brief Decaying log-spaced duration histogram
    *
-   * Threshold is midpoint between dit and dah averages, adjusted by tolerance:
-   * threshold = dit_avg * 1.5 * (1.0 + tolerance%)
+   * Each bin keeps a weight and the weighted sum of in-bin offsets (0-255) so that
+   * cluster centroids are not quantized to bin centres.
+   */
+  struct DurationHistogram {
+    uint16_t weight[kHistogramBins];      ///< Per-bin weight (kSampleWeight per sample)
+    uint32_t offset_sum[kHistogramBins];  ///< Per-bin sum of weight × in-bin offset
+    uint32_t total_weight;                ///< Sum of all bin weights
+  };
+
+  /**
+   * @brief Add a sample at a log position, halving the histogram when it is full
+   */
+  static void AddSample(DurationHistogram& histogram, int32_t position);
+
+  /**
+   * @brief Incremental k-means over a histogram for sorted 1-D centroids
+   * @param histogram Source histogram
+   * @param centroids In: seed centroids (ascending), out: refined centroids
+   * @param weights Out: total weight assigned to each cluster
+   * @param count Number of clusters (2 or 3)
+   *
+   * Starts from the previous centroids. If that leaves a cluster empty although the
+   * data spans more than one cluster width (stale seeds after a large speed change),
+   * the clustering is restarted from seeds spread over the populated range.
+   * Clusters that receive no weight keep their seed value.
+   */
+  static void RunKMeans(const DurationHistogram& histogram, int32_t* centroids,
+                        uint32_t* weights, size_t count);
+
+  /**
+   * @brief Lloyd iterations (assign bins to nearest centroid, recompute means)
+   * @return Number of clusters left without weight
+   */
+  static size_t LloydIterations(const DurationHistogram& histogram, int32_t* centroids,
+                                uint32_t* weights, size_t count);
+
+  /**
+   * @brief Refine dit/dah centroids and recompute the dit/dah threshold
    */
-  int64_t ComputeDitThreshold() const;
+  void UpdateMarkClusters();
 
   /**
-   * @brief Update dit average with new sample (EMA)
-   * @param measured_us New dit duration measurement
+   * @brief Refine intra/char/word gap centroids and recompute the gap thresholds
    */
-  void UpdateDitAverage(int64_t measured_us);
+  void UpdateSpaceClusters();
 
   /**
-   * @brief Update dah average with new sample (EMA)
-   * @param measured_us New dah duration measurement
+   * @brief Derive space centroids from the dit centroid (1:3:7) where the space
+   *        histogram has no data
    */
-  void UpdateDahAverage(int64_t measured_us);
+  void SeedSpaceClustersFromMarks();
 
   // --- State Variables ---
-  int64_t dit_avg_us_;        ///< Current dit average (microseconds)
-  int64_t dah_avg_us_;        ///< Current dah average (microseconds)
-  float tolerance_percent_;   ///< Timing tolerance (±%)
-  uint32_t dit_sample_count_; ///< Number of dits seen
-  uint32_t dah_sample_count_; ///< Number of dahs seen
+  DurationHistogram mark_histogram_;   ///< Key-on durations
+  DurationHistogram space_histogram_;  ///< Key-off durations
+  int32_t mark_centroid_[2];           ///< Dit, dah centroids (log position units)
+  int32_t space_centroid_[3];          ///< Intra, char, word gap centroids (log position units)
+  int32_t dit_dah_threshold_;          ///< Dit/dah decision point (log position units)
+  int32_t char_gap_threshold_;         ///< Intra/char decision point (log position units)
+  int32_t word_gap_threshold_;         ///< Char/word decision point (log position units)
+  int32_t tolerance_permille_;         ///< Timing tolerance (‰ of half dit/dah distance)
+  uint32_t dit_sample_count_;          ///< Number of dits seen
+  uint32_t dah_sample_count_;          ///< Number of dahs seen
 
   // --- Constants ---
-  static constexpr float kEmaAlpha = 0.3f;           ///< EMA smoothing factor (α)
   static constexpr int64_t kDefaultDitUs = 60'000;   ///< Default dit @ 20 WPM
   static constexpr int64_t kDefaultDahUs = 180'000;  ///< Default dah @ 20 WPM (3:1 ratio)
   static constexpr uint32_t kMinSamplesForClassification = 3; ///< Warm-up period
+  static constexpr uint16_t kSampleWeight = 16;      ///< Histogram weight of one sample
+  static constexpr uint32_t kHistoryWeight = 32;     ///< Samples kept before halving
+  static constexpr uint32_t kMaxKMeansIterations = 4;  ///< Lloyd iterations per sample
 };
 
 }  // namespace morse_decoder
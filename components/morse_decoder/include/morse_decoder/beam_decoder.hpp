@@ -0,0 +1,183 @@
+/**
+ * @file beam_decoder.hpp
+ * @brief Probabilistic beam-search (Viterbi) morse decoder
+ *
+ * ARCHITECTURE RATIONALE:
+ * =======================
+ * The greedy decoder commits every dit/dah and gap decision as soon as the timing
+ * classifier makes it, so one borderline gap turns "EE" into "I" irrecoverably. The
+ * beam decoder keeps the few best segmentations alive and scores them with the timing
+ * model (ElementScores costs) plus a compact character bigram language model, then
+ * commits text only when all surviving hypotheses agree or when the decision delay
+ * bound is reached.
+ *
+ * ALGORITHM DETAILS:
+ * - Hypothesis state: position in the morse tree + last emitted character. Two
+ *   hypotheses with the same state are merged (Viterbi), keeping the cheaper one
+ * - Mark: every hypothesis branches into dit and dah children
+ * - Space: every hypothesis branches into intra gap (stay in tree), char gap (emit
+ *   character, add bigram cost) and word gap (emit character + space)
+ * - The kBeamWidth cheapest hypotheses survive each step; hypotheses more than
+ *   kPruneMargin above the best are dropped so confident input commits immediately
+ * - Commit: the common prefix of all pending texts is emitted immediately; when a
+ *   hypothesis holds kMaxDelayChars undecided characters, the best hypothesis'
+ *   oldest character is forced out and hypotheses that disagree are dropped
+ *
+ * MEMORY / CPU BOUNDS:
+ * - Fixed arrays only (~0.5 KB), no heap allocation after construction
+ * - Per element: at most kBeamWidth × 3 candidates, each merged against the beam
+ *
+ * THREAD SAFETY:
+ * Not thread-safe. MorseDecoder serializes access with its own mutex.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "morse_decoder/adaptive_timing_classifier.hpp"
+#include "morse_decoder/morse_table.hpp"
+
+namespace morse_decoder {
+
+/**
+ * @class BeamDecoder
+ * @brief Bounded-delay beam search over morse segmentations with a bigram prior
+ *
+ * Usage:
+ * @code
+ * BeamDecoder beam(table);
+ * char out[BeamDecoder::kMaxOutputChars];
+ * ElementScores scores;
+ * classifier.ClassifyDuration(duration_us, key_on, &scores);
+ * size_t n = beam.ProcessElement(scores, out, sizeof(out));  // 0..n committed chars
+ * n = beam.Flush(out, sizeof(out));  // On inactivity timeout
+ * @endcode
+ */
+class BeamDecoder {
+ public:
+  /// Hypotheses kept after each element
+  static constexpr size_t kBeamWidth = 8;
+
+  /// Maximum number of undecided characters before a decision is forced
+  static constexpr size_t kMaxDelayChars = 3;
+
+  /// Output buffer size that is always large enough for ProcessElement()/Flush()
+  static constexpr size_t kMaxOutputChars = kMaxDelayChars + 2;
+
+  /// Longest pattern tracked in the tree (ITU maximum)
+  static constexpr size_t kMaxPatternLength = 6;
+
+  /**
+   * @brief Build the morse tree from a lookup table
+   * @param table Pattern table (only read during construction)
+   */
+  explicit BeamDecoder(const MorseTable& table);
+
+  /**
+   * @brief Drop all hypotheses and restart at a word boundary
+   */
+  void Reset();
+
+  /**
+   * @brief Advance the search by one classified element
+   * @param scores Per-class costs from AdaptiveTimingClassifier
+   * @param committed Out: characters that became final (may include ' ')
+   * @param capacity Size of committed (use kMaxOutputChars)
+   * @return Number of characters written to committed
+   */
+  size_t ProcessElement(const ElementScores& scores, char* committed, size_t capacity);
+
+  /**
+   * @brief Close the open character as a word end and commit the best hypothesis
+   * @param committed Out: remaining characters of the best hypothesis
+   * @param capacity Size of committed (use kMaxOutputChars)
+   * @return Number of characters written to committed
+   */
+  size_t Flush(char* committed, size_t capacity);
+
+  /**
+   * @brief Check whether the best hypothesis has undecided elements or characters
+   */
+  bool HasPending() const;
+
+  /**
+   * @brief Dit/dah pattern of the open character in the best hypothesis
+   * @param pattern Out: NUL-terminated pattern (e.g. ".-")
+   * @param capacity Size of pattern (kMaxPatternLength + 2 is always enough)
+   * @return Pattern length
+   */
+  size_t GetBestPattern(char* pattern, size_t capacity) const;
+
+  /**
+   * @brief Language model cost of emitting @p next after @p previous
+   * @return Cost in ElementScores::kCostUnitsPerNat units (lower is more likely)
+   *
+   * Back-off bigram: a short list of frequent English and amateur radio bigrams
+   * with conditional costs, otherwise the unigram cost of @p next.
+   */
+  static uint16_t LanguageCost(char previous, char next);
+
+ private:
+  /**
+   * @brief One segmentation hypothesis
+   */
+  struct Hypothesis {
+    uint32_t cost;                      ///< Accumulated cost (normalized to best = 0)
+    uint8_t node;                       ///< Morse tree node (1 = root, 0 = invalid)
+    char last_char;                     ///< Last emitted character (bigram context)
+    uint8_t pending_length;             ///< Number of undecided characters
+    char pending[kMaxOutputChars];      ///< Emitted but not yet committed characters
+  };
+
+  /**
+   * @brief Character decoded by a finished tree node ('?' for invalid patterns)
+   */
+  char NodeChar(uint8_t node) const;
+
+  /**
+   * @brief Insert a candidate into next_beam_, merging equal states and pruning
+   */
+  void OfferCandidate(const Hypothesis& candidate);
+
+  /**
+   * @brief Emit a character on a hypothesis (char or word gap)
+   */
+  void EmitChar(Hypothesis& hypothesis, char c) const;
+
+  /**
+   * @brief Move agreed and delay-forced characters from the beam into committed
+   */
+  size_t Commit(char* committed, size_t capacity);
+
+  /**
+   * @brief Remove the first pending character from a hypothesis
+   */
+  static void PopPending(Hypothesis& hypothesis);
+
+  /**
+   * @brief Index of the cheapest hypothesis in beam_
+   */
+  size_t BestIndex() const;
+
+  // Morse tree: heap layout, children of n are 2n (dit) and 2n+1 (dah), root = 1.
+  // Value is the decoded character or '\0' for prefixes without a character.
+  static constexpr size_t kTreeSize = size_t{1} << (kMaxPatternLength + 1);
+  char tree_[kTreeSize];
+
+  Hypothesis beam_[kBeamWidth];
+  size_t beam_size_ = 0;
+  Hypothesis next_beam_[kBeamWidth];
+  size_t next_size_ = 0;
+
+  // --- Constants ---
+  static constexpr uint8_t kRootNode = 1;
+  static constexpr uint8_t kInvalidNode = 0;
+  /// Extra cost for decoding a pattern that has no character
+  static constexpr uint32_t kUnknownCharCost = 6 * ElementScores::kCostUnitsPerNat;
+  /// Hypotheses costlier than the best by more than this are dropped (~e^-10)
+  static constexpr uint32_t kPruneMargin = 10 * ElementScores::kCostUnitsPerNat;
+};
+
+}  // namespace morse_decoder
@@ -0,0 +1,157 @@
+/**
+ * @file decoder_service.hpp
+ * @brief Parallel morse decoding of the local and remote key streams
+ *
+ * ARCHITECTURE RATIONALE:
+ * =======================
+ * Three key streams pass through the keyer: our own paddles (KeyingSubsystem), the
+ * other station received by RemoteCwClient and a remote operator keying our rig via
+ * RemoteCwServer. Each stream has its own speed and fist, so sharing one timing model
+ * would make every stream decode the others' timing. DecoderService owns one
+ * independent AdaptiveTimingClassifier + MorseDecoder pair per KeySource and turns
+ * raw key edges into classified durations for the matching pair.
+ *
+ * TIMELINE:
+ * All streams share the keying timeline. Decoded characters and gap markers carry the
+ * source in arg1; remote key edges are logged as kRemoteEvent (arg0 = source,
+ * arg1 = key down). Local edges are already logged by the paddle engine hooks.
+ *
+ * MEMORY BOUNDS (per stream, allocated once at construction):
+ * - Classifier histograms + beam search + fist statistics: ~3 KB
+ * - Decoded text: at most buffer_size characters (remote streams use their own limit)
+ *
+ * THREAD SAFETY:
+ * OnKeyEdge() for a given source must always be called from the same task (each
+ * source has a single producer: keying task, client task, server task). Decoders are
+ * internally locked, so getters and Tick() may run from any task.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "morse_decoder/adaptive_timing_classifier.hpp"
+#include "morse_decoder/morse_decoder.hpp"
+#include "timeline/event_logger.hpp"
+
+namespace morse_decoder {
+
+/**
+ * @brief Configuration for DecoderService
+ */
+struct DecoderServiceConfig {
+  /// Classifier tolerance for every stream (see AdaptiveTimingClassifier)
+  float tolerance_percent = 25.0f;
+
+  /// Decoded text kept for the local stream
+  size_t local_buffer_size = 100;
+
+  /// Decoded text kept for each remote stream
+  size_t remote_buffer_size = 100;
+
+  /// Decoding strategy applied to every stream
+  DecodingMode mode = DecodingMode::kGreedy;
+
+  /// Verbose decoder logging
+  bool enable_logging = false;
+};
+
+/**
+ * @class DecoderService
+ * @brief Per-source classifier + decoder pairs fed from raw key edges
+ *
+ * Usage:
+ * @code
+ * DecoderService service(config);
+ * service.OnKeyEdge(KeySource::kRemoteClient, true, timestamp_us);   // Key down
+ * service.OnKeyEdge(KeySource::kRemoteClient, false, timestamp_us);  // Key up
+ * service.Tick(esp_timer_get_time());  // Periodically (inactivity timeouts)
+ * std::string text = service.GetDecoder(KeySource::kRemoteClient)->GetDecodedText();
+ * @endcode
+ */
+class DecoderService {
+ public:
+  /// Durations longer than this (link drop, stuck key, new session) are skipped
+  /// instead of classified: nothing useful can be learned from them
+  static constexpr int64_t kMaxElementUs = 10'000'000;
+
+  explicit DecoderService(const DecoderServiceConfig& config = DecoderServiceConfig{});
+
+  DecoderService(const DecoderService&) = delete;
+  DecoderService& operator=(const DecoderService&) = delete;
+
+  /**
+   * @brief Feed one key edge of a stream
+   * @param source Stream the edge belongs to
+   * @param key_down New key state
+   * @param timestamp_us Edge time (stream clock, must not go backwards within a stream)
+   *
+   * Classifies the duration that just ended (mark on key up, space on key down) and
+   * passes it to the stream's decoder. Repeated edges with the same state are ignored.
+   */
+  void OnKeyEdge(KeySource source, bool key_down, int64_t timestamp_us);
+
+  /**
+   * @brief Run inactivity timeouts of all streams
+   */
+  void Tick(int64_t now_us);
+
+  /**
+   * @brief Decoder of a stream (never nullptr for valid sources)
+   */
+  MorseDecoder* GetDecoder(KeySource source) const;
+
+  /**
+   * @brief Timing classifier of a stream (never nullptr for valid sources)
+   */
+  AdaptiveTimingClassifier* GetClassifier(KeySource source) const;
+
+  /**
+   * @brief Check whether a stream has received any key edge since start
+   */
+  bool HasActivity(KeySource source) const;
+
+  /**
+   * @brief Enable or disable decoding of every stream
+   */
+  void SetEnabled(bool enabled);
+
+  /**
+   * @brief Switch the decoding strategy of every stream
+   */
+  void SetDecodingMode(DecodingMode mode);
+
+  /**
+   * @brief Log decoded characters, gap markers and remote edges to a timeline
+   * @param logger Shared keying timeline (non-owning, may be nullptr)
+   */
+  void SetTimelineLogger(timeline::EventLogger<timeline::kTimelineCapacity>* logger);
+
+  /**
+   * @brief Short lower-case name of a source ("local", "remote_client", "remote_server")
+   */
+  static const char* SourceName(KeySource source);
+
+ private:
+  /**
+   * @brief Independent decoding state of one key stream
+   */
+  struct Stream {
+    Stream(const DecoderServiceConfig& config, KeySource source, size_t buffer_size);
+
+    AdaptiveTimingClassifier classifier;
+    MorseDecoder decoder;
+    int64_t last_edge_us = 0;        ///< 0 until the first edge (producer task only)
+    bool key_down = false;           ///< State since last_edge_us (producer task only)
+    std::atomic<bool> active{false}; ///< Any edge received (read from other tasks)
+  };
+
+  std::array<std::unique_ptr<Stream>, kKeySourceCount> streams_;
+  timeline::EventLogger<timeline::kTimelineCapacity>* timeline_logger_ = nullptr;
+};
+
+}  // namespace morse_decoder
@@ -0,0 +1,196 @@
+/**
+ * @file fist_statistics.hpp
+ * @brief Streaming timing statistics of the operator's "fist"
+ *
+ * ARCHITECTURE RATIONALE:
+ * =======================
+ * TimingStats describes the classifier's model (cluster centroids and thresholds),
+ * which is exactly what the decoder needs but says little about how well the operator
+ * sends. FistStatistics observes every classified duration and keeps, per element
+ * class (dit, dah, intra gap, char gap, word gap):
+ * - Welford running mean/variance (numerically stable, one pass)
+ * - P² quantile estimators for p10/p50/p90 (Jain & Chlamtac, 5 markers each)
+ * plus a rolling window of recent unit lengths for speed drift.
+ *
+ * From these the snapshot derives the figures operators care about: dah/dit ratio,
+ * weighting (mark vs. intra gap), mark jitter, gap jitter, character/word spacing in
+ * units and the recent speed compared to the session average.
+ *
+ * MEMORY / CPU BOUNDS:
+ * - Fixed arrays only (~1.5 KB), no heap allocation
+ * - AddElement(): O(1), a few dozen float operations (no sorting, no division loops)
+ * - GetSnapshot(): O(1)
+ *
+ * THREAD SAFETY:
+ * Not thread-safe. MorseDecoder serializes access with its own mutex.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "morse_decoder/adaptive_timing_classifier.hpp"
+
+namespace morse_decoder {
+
+/**
+ * @brief Welford running mean and variance
+ */
+class RunningMoments {
+ public:
+  void Reset();
+  void Add(float value);
+
+  uint32_t Count() const { return count_; }
+  float Mean() const { return mean_; }
+  /// Sample variance (0 with fewer than two samples)
+  float Variance() const;
+  float StdDev() const;
+
+ private:
+  uint32_t count_ = 0;
+  float mean_ = 0.0f;
+  float m2_ = 0.0f;
+};
+
+/**
+ * @brief P² single-quantile estimator (constant memory, no stored samples)
+ *
+ * Exact for the first five samples, then tracks the quantile with five markers whose
+ * heights are adjusted with piecewise-parabolic interpolation.
+ */
+class P2Quantile {
+ public:
+  /**
+   * @param quantile Target quantile in (0, 1), e.g. 0.5 for the median
+   */
+  explicit P2Quantile(float quantile = 0.5f);
+
+  void Reset();
+  void Add(float value);
+
+  /// Current estimate (0 before the first sample)
+  float Value() const;
+
+ private:
+  float Parabolic(int i, int d) const;
+  float Linear(int i, int d) const;
+
+  float quantile_;
+  uint32_t count_ = 0;
+  float height_[5] = {};     ///< Marker heights
+  int32_t position_[5] = {}; ///< Actual marker positions (0-based)
+  float desired_[5] = {};    ///< Desired marker positions
+  float increment_[5] = {};  ///< Desired position increments per sample
+};
+
+/**
+ * @brief Fist statistics snapshot
+ *
+ * Durations are in microseconds, ratios are plain numbers, percentages are 0-100.
+ * Derived figures are 0 until the classes they depend on have samples.
+ */
+struct FistStats {
+  /// Element classes, indexed like KeyEvent (kDit .. kWordGap)
+  static constexpr size_t kClassCount = 5;
+
+  struct ClassStats {
+    uint32_t count = 0;
+    float mean_us = 0.0f;
+    float stddev_us = 0.0f;
+    float p10_us = 0.0f;
+    float p50_us = 0.0f;
+    float p90_us = 0.0f;
+  };
+
+  ClassStats classes[kClassCount];
+
+  /** Mean dah / mean dit (3.0 nominal, higher = "heavy" dahs) */
+  float dah_dit_ratio = 0.0f;
+
+  /** Mean dit / (mean dit + mean intra gap) × 100 (50 nominal, higher = heavy keying) */
+  float weighting_percent = 0.0f;
+
+  /** Mark jitter: count-weighted coefficient of variation of dits and dahs */
+  float jitter_percent = 0.0f;
+
+  /** Gap jitter: count-weighted coefficient of variation of intra and char gaps */
+  float gap_jitter_percent = 0.0f;
+
+  /** Mean char gap in dit units (3 nominal, higher = Farnsworth spacing) */
+  float char_gap_units = 0.0f;
+
+  /** Mean word gap in dit units (7 nominal) */
+  float word_gap_units = 0.0f;
+
+  /** Speed from the session mean dit (PARIS) */
+  float session_wpm = 0.0f;
+
+  /** Speed from the rolling window of recent marks */
+  float window_wpm = 0.0f;
+
+  /** (window_wpm - session_wpm) / session_wpm × 100 (positive = speeding up) */
+  float speed_drift_percent = 0.0f;
+
+  /** Marks currently in the rolling window */
+  uint32_t window_count = 0;
+};
+
+/**
+ * @class FistStatistics
+ * @brief O(1)-per-element streaming statistics of classified key durations
+ *
+ * Usage:
+ * @code
+ * FistStatistics fist;
+ * fist.AddElement(scores.best, duration_us);  // For every classified duration
+ * FistStats snapshot = fist.GetSnapshot();
+ * @endcode
+ */
+class FistStatistics {
+ public:
+  /// Marks kept in the rolling speed window
+  static constexpr size_t kWindowSize = 32;
+
+  /// Word gaps longer than this many dit units are pauses, not spacing
+  static constexpr float kMaxWordGapUnits = 20.0f;
+
+  FistStatistics();
+
+  /**
+   * @brief Clear all accumulators and the rolling window
+   */
+  void Reset();
+
+  /**
+   * @brief Observe one classified duration
+   * @param event Classification (kUnknown is ignored)
+   * @param duration_us Duration that ended (mark or space)
+   */
+  void AddElement(KeyEvent event, int64_t duration_us);
+
+  /**
+   * @brief Compute derived statistics from the current accumulators
+   */
+  FistStats GetSnapshot() const;
+
+ private:
+  struct ClassAccumulator {
+    RunningMoments moments;
+    P2Quantile p10{0.10f};
+    P2Quantile p50{0.50f};
+    P2Quantile p90{0.90f};
+  };
+
+  ClassAccumulator classes_[FistStats::kClassCount];
+
+  // Rolling window of recent unit lengths in μs (dits, and dahs divided by the session
+  // ratio). Integer sum so adding/evicting never accumulates rounding error.
+  uint32_t window_[kWindowSize] = {};
+  size_t window_head_ = 0;
+  size_t window_count_ = 0;
+  uint64_t window_sum_ = 0;
+};
+
+}  // namespace morse_decoder
@@ -14,6 +14,7 @@
  * - Detect character boundaries (kCharGap) and word boundaries (kWordGap)
  * - Lookup patterns in MorseTable and emit decoded characters
  * - Maintain circular buffer of decoded text (100 characters default)
+ * - Track streaming timing statistics of the operator (FistStatistics)
  *
  * STATE MACHINE:
  * - IDLE: Waiting for first dit/dah
@@ -25,6 +26,11 @@
  * Thread-safe for concurrent access from ISR context (ProcessEvent) and
  * console/Web UI context (GetDecodedText). Protected by std::mutex.
  *
+ * DECODING MODES:
+ * - kGreedy: every classified event is applied immediately (state machine above)
+ * - kBeam: ProcessElement() feeds soft scores to a BeamDecoder, which keeps several
+ *   segmentations alive and commits text with a bounded delay (see beam_decoder.hpp)
+ *
  * PERFORMANCE:
  * - ProcessEvent() target: < 200 μs on ESP32-S3
  * - Pattern buffer: max 6 elements (ITU longest code)
@@ -39,6 +45,8 @@
 #include <string>
 
 #include "morse_decoder/adaptive_timing_classifier.hpp"
+#include "morse_decoder/beam_decoder.hpp"
+#include "morse_decoder/fist_statistics.hpp"
 #include "morse_decoder/morse_table.hpp"
 #include "timeline/event_logger.hpp"
 
@@ -54,6 +62,26 @@ enum class DecoderState : uint8_t {
   kWordGap = 3     ///< Word gap detected, finalize + add space
 };
 
+/**
+ * @brief Decoding strategy
+ */
+enum class DecodingMode : uint8_t {
+  kGreedy = 0,  ///< Hard decisions, characters emitted on each gap
+  kBeam = 1     ///< Beam search with language model, bounded commit delay
+};
+
+/**
+ * @brief Origin of a key stream (tagged on timeline events as arg1)
+ */
+enum class KeySource : uint8_t {
+  kLocal = 0,         ///< Local paddles / straight key (our own sending)
+  kRemoteClient = 1,  ///< Other station, received by RemoteCwClient
+  kRemoteServer = 2   ///< Remote operator keying our rig through RemoteCwServer
+};
+
+/// Number of KeySource values
+constexpr size_t kKeySourceCount = 3;
+
 /**
  * @brief Configuration options for MorseDecoder
  */
@@ -69,6 +97,12 @@ struct MorseDecoderConfig {
   /// Pointer to timing classifier (optional, for stats access)
   /// If provided, GetDetectedWPM() will query classifier directly
   AdaptiveTimingClassifier* timing_classifier = nullptr;
+
+  /// Decoding strategy (greedy state machine or beam search)
+  DecodingMode mode = DecodingMode::kGreedy;
+
+  /// Stream this decoder listens to (tagged on gap marker / decoded char events)
+  KeySource source = KeySource::kLocal;
 };
 
 /**
@@ -134,6 +168,35 @@ class MorseDecoder {
    */
   void ProcessEvent(KeyEvent event);
 
+  /**
+   * @brief Process a soft-classified keying element
+   * @param scores Hard decision and per-class costs from AdaptiveTimingClassifier
+   *
+   * In kGreedy mode this is equivalent to ProcessEvent(scores.best). In kBeam mode
+   * the scores advance the beam search; characters are appended to the decoded
+   * buffer once all hypotheses agree or the decision delay bound is reached.
+   *
+   * Thread-safe: Yes (protected by mutex)
+   */
+  void ProcessElement(const ElementScores& scores);
+
+  /**
+   * @brief Select the decoding strategy
+   * @param mode kGreedy or kBeam
+   *
+   * Switching flushes any open character of the previous strategy.
+   *
+   * Thread-safe: Yes
+   */
+  void SetDecodingMode(DecodingMode mode);
+
+  /**
+   * @brief Get the active decoding strategy
+   *
+   * Thread-safe: Yes
+   */
+  DecodingMode GetDecodingMode() const;
+
   /**
    * @brief Get the entire decoded text buffer
    * @return Decoded text as string (up to buffer_size characters)
@@ -166,7 +229,7 @@ class MorseDecoder {
 
   /**
    * @brief Get detected WPM from timing classifier
-   * @return WPM (10-60), or 0 if no classifier configured
+   * @return WPM (5-100), or 0 if no classifier configured
    *
    * Requires config.timing_classifier to be set during construction.
    *
@@ -174,6 +237,16 @@ class MorseDecoder {
    */
   uint32_t GetDetectedWPM() const;
 
+  /**
+   * @brief Get streaming statistics of the operator's timing ("fist")
+   * @return Snapshot of per-element statistics and derived figures
+   *
+   * Fed by ProcessElement() while the decoder is enabled; cleared by Reset().
+   *
+   * Thread-safe: Yes
+   */
+  FistStats GetFistStats() const;
+
   /**
    * @brief Reset decoder state
    *
@@ -181,6 +254,7 @@ class MorseDecoder {
    * - Current pattern buffer
    * - Decoded text buffer
    * - State machine (back to IDLE)
+   * - Fist statistics
    *
    * Does NOT reset timing classifier (call classifier.Reset() separately if needed).
    *
@@ -224,10 +298,10 @@ class MorseDecoder {
    *
    * If the decoder has been in RECEIVING state for too long without new events,
    * forces finalization of the current pattern + word space. The timeout is
-   * calculated dynamically based on detected WPM (7 dit units = word gap).
+   * calculated dynamically from the classifier's learned word gap threshold.
    *
    * Default timeout: 500ms (word gap @ 20 WPM)
-   * Dynamic timeout: avg_dit_us * 7 (adapts to operator speed)
+   * Dynamic timeout: word_gap_threshold_us (adapts to speed and Farnsworth spacing)
    *
    * This prevents decoded text from remaining "stuck" waiting for the next element.
    *
@@ -247,7 +321,7 @@ class MorseDecoder {
    *
    * Thread-safe: Yes
    */
-  void SetTimelineLogger(timeline::EventLogger<1024>* logger);
+  void SetTimelineLogger(timeline::EventLogger<timeline::kTimelineCapacity>* logger);
 
  private:
   /**
@@ -279,6 +353,20 @@ class MorseDecoder {
    */
   void AppendToBuffer(char c);
 
+  /**
+   * @brief Append characters committed by the beam decoder (buffer + timeline)
+   *
+   * Thread-safe: No (caller must hold mutex_)
+   */
+  void AppendCommitted(const char* text, size_t length);
+
+  /**
+   * @brief Emit a decoded character event to the timeline (if connected)
+   *
+   * Thread-safe: No (caller must hold mutex_)
+   */
+  void EmitDecodedChar(char c);
+
   // Configuration
   MorseDecoderConfig config_;
 
@@ -297,6 +385,12 @@ class MorseDecoder {
   // Last decoded character (for quick access)
   char last_char_ = '\0';
 
+  // Beam search state (used in DecodingMode::kBeam)
+  BeamDecoder beam_decoder_;
+
+  // Streaming timing statistics of the classified elements
+  FistStatistics fist_statistics_;
+
   // Enabled flag
   bool enabled_ = true;
 
@@ -308,7 +402,7 @@ class MorseDecoder {
   static constexpr int64_t kInactivityTimeoutUs = 500'000;  // 500ms default
 
   // Timeline logger for gap marker emission (injected, non-owning)
-  timeline::EventLogger<1024>* timeline_logger_ = nullptr;
+  timeline::EventLogger<timeline::kTimelineCapacity>* timeline_logger_ = nullptr;
 
   // Thread safety
   mutable std::mutex mutex_;
@@ -5,8 +5,8 @@
  * ARCHITECTURE RATIONALE:
  * =======================
  * This structure holds the current state of the adaptive timing classifier's
- * internal averages. It provides visibility into the decoder's learned timing
- * parameters for debugging and display purposes.
+ * learned clusters. It provides visibility into the decoder's timing model
+ * (cluster centroids and decision thresholds) for debugging and display purposes.
  *
  * WPM Calculation:
  * - Standard PARIS timing: 50 dit units per word
@@ -20,17 +20,24 @@
 
 namespace morse_decoder {
 
+/// Lowest speed reported by the decoder (5 WPM → 240 ms dit)
+constexpr uint32_t kMinDetectedWpm = 5;
+
+/// Highest speed reported by the decoder (100 WPM → 12 ms dit)
+constexpr uint32_t kMaxDetectedWpm = 100;
+
 /**
  * @brief Timing statistics for adaptive morse decoder
  *
- * Captures the current learned dit/dah averages and their ratio.
+ * Captures the current learned dit/dah/gap centroids, the thresholds derived
+ * from them and the number of classified marks.
  * Used for debugging, display, and performance monitoring.
  */
 struct TimingStats {
-  /** Average dit duration in microseconds */
+  /** Average dit duration in microseconds (dit cluster centroid) */
   int64_t avg_dit_us = 0;
 
-  /** Average dah duration in microseconds */
+  /** Average dah duration in microseconds (dah cluster centroid) */
   int64_t avg_dah_us = 0;
 
   /** Dah-to-dit ratio (typically 3.0 for standard morse, range 2.5-4.0) */
@@ -42,9 +49,27 @@ struct TimingStats {
   /** Number of dah samples used to calculate average */
   uint32_t dah_sample_count = 0;
 
+  /** Average intra-character gap in microseconds (≈1 dit unit) */
+  int64_t avg_intra_gap_us = 0;
+
+  /** Average inter-character gap in microseconds (≈3 dit units, longer with Farnsworth) */
+  int64_t avg_char_gap_us = 0;
+
+  /** Average inter-word gap in microseconds (≈7 dit units) */
+  int64_t avg_word_gap_us = 0;
+
+  /** Key-on durations below this value are dits, above are dahs */
+  int64_t dit_dah_threshold_us = 0;
+
+  /** Key-off durations below this value are intra-character gaps */
+  int64_t char_gap_threshold_us = 0;
+
+  /** Key-off durations at or above this value are word gaps */
+  int64_t word_gap_threshold_us = 0;
+
   /**
    * @brief Calculate detected Words Per Minute (WPM)
-   * @return WPM based on average dit duration (clamped to 10-60 range)
+   * @return WPM based on average dit duration (clamped to 5-100 range)
    *
    * Uses standard PARIS timing: WPM = 1,200,000 / avg_dit_us
    * For example: 60ms dit → 20 WPM, 48ms dit → 25 WPM
@@ -57,9 +82,9 @@ struct TimingStats {
     // Calculate WPM with bounds checking
     int64_t wpm = 1'200'000 / avg_dit_us;
 
-    // Clamp to reasonable range (10-60 WPM)
-    if (wpm < 10) return 10;
-    if (wpm > 60) return 60;
+    // Clamp to supported range (5-100 WPM)
+    if (wpm < kMinDetectedWpm) return kMinDetectedWpm;
+    if (wpm > kMaxDetectedWpm) return kMaxDetectedWpm;
 
     return static_cast<uint32_t>(wpm);
   }
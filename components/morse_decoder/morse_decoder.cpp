@@ -51,16 +51,19 @@ const char* EventName(KeyEvent event) {
 // CONSTRUCTORS
 // ============================================================================
 
-MorseDecoder::MorseDecoder() : config_() {
+MorseDecoder::MorseDecoder() : config_(), beam_decoder_(morse_table_) {
   ESP_LOGI(kLogTag, "Morse decoder initialized (buffer_size=%zu, logging=%s)",
            config_.buffer_size, config_.enable_logging ? "enabled" : "disabled");
 }
 
-MorseDecoder::MorseDecoder(const MorseDecoderConfig& config) : config_(config) {
-  ESP_LOGI(kLogTag, "Morse decoder initialized (buffer_size=%zu, logging=%s, classifier=%s)",
+MorseDecoder::MorseDecoder(const MorseDecoderConfig& config)
+    : config_(config), beam_decoder_(morse_table_) {
+  ESP_LOGI(kLogTag,
+           "Morse decoder initialized (buffer_size=%zu, logging=%s, classifier=%s, mode=%s)",
            config_.buffer_size,
            config_.enable_logging ? "enabled" : "disabled",
-           config_.timing_classifier ? "linked" : "none");
+           config_.timing_classifier ? "linked" : "none",
+           config_.mode == DecodingMode::kBeam ? "beam" : "greedy");
 }
 
 // ============================================================================
@@ -75,17 +78,15 @@ void MorseDecoder::ProcessEvent(KeyEvent event) {
     return;
   }
 
+  // Update activity timestamp for inactivity timeout on every key edge: gap events
+  // arrive at key-down, so a long dah in progress does not count as silence
+  last_activity_time_us_ = esp_timer_get_time();
+
   // Ignore kUnknown events (warm-up period)
   if (event == KeyEvent::kUnknown) {
     return;
   }
 
-  // Update activity timestamp for inactivity timeout
-  // Only update on dit/dah events (actual morse elements), not on gaps
-  if (event == KeyEvent::kDit || event == KeyEvent::kDah) {
-    last_activity_time_us_ = esp_timer_get_time();
-  }
-
   if (config_.enable_logging) {
     ESP_LOGD(kLogTag, "ProcessEvent: state=%s, event=%s, pattern='%s'",
              StateName(state_), EventName(event), current_pattern_.c_str());
@@ -149,7 +150,7 @@ void MorseDecoder::ProcessEvent(KeyEvent event) {
             .timestamp_us = esp_timer_get_time(),
             .type = timeline::EventType::kGapMarker,
             .arg0 = 0,  // 0 = element gap
-            .arg1 = 0
+            .arg1 = static_cast<uint32_t>(config_.source)
           };
           timeline_logger_->push(gap_evt);
         }
@@ -167,7 +168,7 @@ void MorseDecoder::ProcessEvent(KeyEvent event) {
             .timestamp_us = esp_timer_get_time(),
             .type = timeline::EventType::kGapMarker,
             .arg0 = 1,  // 1 = character gap
-            .arg1 = 0
+            .arg1 = static_cast<uint32_t>(config_.source)
           };
           timeline_logger_->push(gap_evt);
         }
@@ -185,7 +186,7 @@ void MorseDecoder::ProcessEvent(KeyEvent event) {
             .timestamp_us = esp_timer_get_time(),
             .type = timeline::EventType::kGapMarker,
             .arg0 = 2,  // 2 = word gap
-            .arg1 = 0
+            .arg1 = static_cast<uint32_t>(config_.source)
           };
           timeline_logger_->push(gap_evt);
         }
@@ -250,14 +251,7 @@ void MorseDecoder::FinalizePattern(bool add_space) {
   }
 
   // TIMELINE: Emit decoded character event
-  if (timeline_logger_) {
-    timeline::TimelineEvent evt{};
-    evt.timestamp_us = hal::HighPrecisionClock::NowMicros();
-    evt.type = timeline::EventType::kDecodedChar;
-    evt.arg0 = static_cast<int32_t>(decoded_char);  // ASCII character code
-    evt.arg1 = 0;  // Unused
-    timeline_logger_->push(evt);
-  }
+  EmitDecodedChar(decoded_char);
 
   // Append decoded character to buffer
   AppendToBuffer(decoded_char);
@@ -271,14 +265,7 @@ void MorseDecoder::FinalizePattern(bool add_space) {
     }
 
     // TIMELINE: Emit space character event
-    if (timeline_logger_) {
-      timeline::TimelineEvent evt{};
-      evt.timestamp_us = hal::HighPrecisionClock::NowMicros();
-      evt.type = timeline::EventType::kDecodedChar;
-      evt.arg0 = static_cast<int32_t>(' ');  // ASCII space
-      evt.arg1 = 0;  // Unused
-      timeline_logger_->push(evt);
-    }
+    EmitDecodedChar(' ');
   }
 
   // Reset pattern and state
@@ -300,6 +287,84 @@ void MorseDecoder::AppendToBuffer(char c) {
   }
 }
 
+void MorseDecoder::AppendCommitted(const char* text, size_t length) {
+  // Caller must hold mutex_
+
+  for (size_t i = 0; i < length; ++i) {
+    const char c = text[i];
+    AppendToBuffer(c);
+    EmitDecodedChar(c);
+    if (c != ' ') {
+      last_char_ = c;
+      if (config_.enable_logging) {
+        ESP_LOGD(kLogTag, "Beam committed '%c'", c);
+      }
+    }
+  }
+}
+
+void MorseDecoder::EmitDecodedChar(char c) {
+  // Caller must hold mutex_
+
+  if (timeline_logger_) {
+    timeline::TimelineEvent evt{};
+    evt.timestamp_us = hal::HighPrecisionClock::NowMicros();
+    evt.type = timeline::EventType::kDecodedChar;
+    evt.arg0 = static_cast<int32_t>(c);  // ASCII character code
+    evt.arg1 = static_cast<uint32_t>(config_.source);
+    timeline_logger_->push(evt);
+  }
+}
+
+// ============================================================================
+// BEAM SEARCH - ProcessElement
+// ============================================================================
+
+void MorseDecoder::ProcessElement(const ElementScores& scores) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!enabled_) {
+      return;
+    }
+    fist_statistics_.AddElement(scores.best, scores.duration_us);
+    if (config_.mode == DecodingMode::kBeam) {
+      last_activity_time_us_ = esp_timer_get_time();
+      char committed[BeamDecoder::kMaxOutputChars];
+      const size_t count = beam_decoder_.ProcessElement(scores, committed, sizeof(committed));
+      AppendCommitted(committed, count);
+      state_ = beam_decoder_.HasPending() ? DecoderState::kReceiving : DecoderState::kIdle;
+      return;
+    }
+  }
+
+  ProcessEvent(scores.best);
+}
+
+void MorseDecoder::SetDecodingMode(DecodingMode mode) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (mode == config_.mode) {
+    return;
+  }
+
+  // Close whatever the previous strategy had open so no text is lost
+  if (config_.mode == DecodingMode::kBeam) {
+    char committed[BeamDecoder::kMaxOutputChars];
+    AppendCommitted(committed, beam_decoder_.Flush(committed, sizeof(committed)));
+  } else if (!current_pattern_.empty()) {
+    FinalizePattern(true);
+  }
+  current_pattern_.clear();
+  state_ = DecoderState::kIdle;
+  config_.mode = mode;
+
+  ESP_LOGI(kLogTag, "Decoding mode: %s", mode == DecodingMode::kBeam ? "beam" : "greedy");
+}
+
+DecodingMode MorseDecoder::GetDecodingMode() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return config_.mode;
+}
+
 // ============================================================================
 // GETTERS
 // ============================================================================
@@ -318,6 +383,11 @@ char MorseDecoder::GetLastChar() {
 
 std::string MorseDecoder::GetCurrentPattern() {
   std::lock_guard<std::mutex> lock(mutex_);
+  if (config_.mode == DecodingMode::kBeam) {
+    char pattern[BeamDecoder::kMaxPatternLength + 2];
+    beam_decoder_.GetBestPattern(pattern, sizeof(pattern));
+    return std::string(pattern);
+  }
   return current_pattern_;
 }
 
@@ -331,6 +401,11 @@ uint32_t MorseDecoder::GetDetectedWPM() const {
   return 0;  // No classifier configured
 }
 
+FistStats MorseDecoder::GetFistStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return fist_statistics_.GetSnapshot();
+}
+
 DecoderState MorseDecoder::GetState() const {
   std::lock_guard<std::mutex> lock(mutex_);
   return state_;
@@ -345,6 +420,8 @@ void MorseDecoder::Reset() {
 
   current_pattern_.clear();
   decoded_buffer_.clear();
+  beam_decoder_.Reset();
+  fist_statistics_.Reset();
   last_char_ = '\0';
   state_ = DecoderState::kIdle;
 
@@ -371,13 +448,15 @@ void MorseDecoder::Tick(int64_t now_us) {
     return;
   }
 
-  // Calculate dynamic timeout based on detected WPM
-  // Word gap is typically 7 dit units, so we use that as timeout
+  // Calculate dynamic timeout based on the learned word gap threshold
+  // (follows Farnsworth spacing); fall back to 7 dit units
   int64_t timeout_us = kInactivityTimeoutUs;  // Default 500ms (word gap @ 20 WPM)
 
   if (config_.timing_classifier != nullptr) {
     const auto stats = config_.timing_classifier->GetTimingStats();
-    if (stats.avg_dit_us > 0) {
+    if (stats.word_gap_threshold_us > 0) {
+      timeout_us = stats.word_gap_threshold_us;
+    } else if (stats.avg_dit_us > 0) {
       // Word gap threshold: 7 dit units
       timeout_us = stats.avg_dit_us * 7;
     }
@@ -388,13 +467,21 @@ void MorseDecoder::Tick(int64_t now_us) {
 
   if (elapsed_us >= timeout_us) {
     // Force finalization of current pattern + add word space
+    if (config_.mode == DecodingMode::kBeam) {
+      ESP_LOGI(kLogTag, "Inactivity timeout (%lld μs, threshold %lld μs) - flushing beam",
+               elapsed_us, timeout_us);
+      char committed[BeamDecoder::kMaxOutputChars];
+      AppendCommitted(committed, beam_decoder_.Flush(committed, sizeof(committed)));
+      state_ = DecoderState::kIdle;
+      return;
+    }
     ESP_LOGI(kLogTag, "Inactivity timeout (%lld μs, threshold %lld μs) - finalizing pattern '%s' + space",
              elapsed_us, timeout_us, current_pattern_.c_str());
     FinalizePattern(true);  // Finalize with space (word boundary)
   }
 }
 
-void MorseDecoder::SetTimelineLogger(timeline::EventLogger<1024>* logger) {
+void MorseDecoder::SetTimelineLogger(timeline::EventLogger<timeline::kTimelineCapacity>* logger) {
   std::lock_guard<std::mutex> lock(mutex_);
   timeline_logger_ = logger;
 
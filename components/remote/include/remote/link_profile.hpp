@@ -0,0 +1,76 @@
+#pragma once
+
+/**
+ * @file link_profile.hpp
+ * @brief Session-scoped network profile for CWNet sockets and per-profile RTT statistics
+ *
+ * With the default profile a CWNet session uses plain sockets and the radio
+ * keeps modem power-save, which parks MORSE frames behind DTIM wake-ups (tens
+ * of ms of latency and jitter). The low-latency profile tunes each session
+ * socket (TCP_NODELAY, DSCP EF, which WMM maps to the voice access category),
+ * and ApplicationController switches power-save off while such a session is
+ * connected.
+ *
+ * The profile is sampled when a session socket is created and stays fixed
+ * for that session. PING round trips are recorded per profile, so the two can
+ * be compared on the same link (remote.low_latency on/off).
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace remote {
+
+enum class LinkProfile : uint8_t {
+  kDefault = 0,     ///< Stack defaults, radio power-save untouched
+  kLowLatency = 1,  ///< Tuned socket, radio power-save off during the session
+};
+
+constexpr size_t kLinkProfileCount = 2;
+
+/// Short name ("default", "low_latency")
+const char* LinkProfileName(LinkProfile profile);
+
+/**
+ * @brief Apply the profile's socket options to a connected session socket
+ * @return false if an option was rejected (the socket stays usable)
+ */
+bool ApplyLinkProfile(int socket_fd, LinkProfile profile);
+
+struct RttSummary {
+  uint32_t samples = 0;
+  uint32_t last_us = 0;
+  uint32_t min_us = 0;
+  uint32_t max_us = 0;
+  uint32_t mean_us = 0;
+  uint32_t jitter_us = 0;  ///< RFC 3550 style smoothed |RTT(n) - RTT(n-1)|
+};
+
+/**
+ * @class RttStats
+ * @brief Round-trip statistics kept separately for each LinkProfile
+ *
+ * Recorded by the CWNet task, read by console/HTTP: all methods lock.
+ */
+class RttStats {
+ public:
+  void Record(LinkProfile profile, uint32_t rtt_us);
+  RttSummary Get(LinkProfile profile) const;
+  void Reset();
+
+ private:
+  struct Accumulator {
+    uint32_t samples = 0;
+    uint32_t last_us = 0;
+    uint32_t min_us = 0;
+    uint32_t max_us = 0;
+    uint64_t sum_us = 0;
+    uint32_t jitter_x16 = 0;  ///< Jitter × 16 (keeps the 1/16 gain exact)
+  };
+
+  mutable std::mutex mutex_;
+  Accumulator profiles_[kLinkProfileCount];
+};
+
+}  // namespace remote
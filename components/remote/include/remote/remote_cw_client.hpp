@@ -8,6 +8,7 @@
 #include "freertos/queue.h"
 #include "freertos/task.h"
 #include "lwip/sockets.h"
+#include "remote/link_profile.hpp"
 
 namespace audio {
 class AudioStreamPlayer;
@@ -143,6 +144,26 @@ class RemoteCwClient {
     return measured_latency_ms_.load(std::memory_order_relaxed);
   }
 
+  /**
+   * @brief Select the link profile of the next session (thread-safe).
+   * @note The running session keeps the profile it started with.
+   */
+  void SetLinkProfile(LinkProfile profile) {
+    requested_profile_.store(profile, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Link profile of the current (or last) session (thread-safe).
+   */
+  LinkProfile GetSessionProfile() const {
+    return session_profile_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief PING round-trip statistics of one link profile (thread-safe).
+   */
+  RttSummary GetRttSummary(LinkProfile profile) const { return rtt_stats_.Get(profile); }
+
   /**
    * @brief Retrieve count of dropped keying events due to queue overflow (diagnostic).
    */
@@ -312,6 +333,9 @@ class RemoteCwClient {
   std::atomic<RemoteCwClientState> state_{RemoteCwClientState::kIdle};
   std::atomic<uint32_t> measured_latency_ms_{0};
   std::atomic<uint32_t> dropped_keying_events_{0};  // Diagnostic counter
+  std::atomic<LinkProfile> requested_profile_{LinkProfile::kDefault};
+  std::atomic<LinkProfile> session_profile_{LinkProfile::kDefault};
+  RttStats rtt_stats_;  // PING round trips per link profile (locked)
 
   // Socket and connection state (task-only access)
   int socket_fd_ = -1;
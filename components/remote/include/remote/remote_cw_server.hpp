@@ -21,6 +21,7 @@
 #include <cstdint>
 #include "esp_err.h"
 #include "lwip/sockets.h"
+#include "remote/link_profile.hpp"
 
 namespace remote {
 
@@ -99,6 +100,21 @@ class RemoteCwServer {
    */
   const char* client_ip() const { return (client_fd_ >= 0) ? client_ip_ : nullptr; }
 
+  /**
+   * @brief Select the link profile of the next accepted client.
+   */
+  void SetLinkProfile(LinkProfile profile) { requested_profile_ = profile; }
+
+  /**
+   * @brief Link profile of the current (or last) client session.
+   */
+  LinkProfile session_profile() const { return session_profile_; }
+
+  /**
+   * @brief PING round-trip statistics of one link profile (thread-safe).
+   */
+  RttSummary GetRttSummary(LinkProfile profile) const { return rtt_stats_.Get(profile); }
+
  private:
   enum class FrameCategory : uint8_t {
     kNoPayload = 0,
@@ -163,6 +179,13 @@ class RemoteCwServer {
   bool ptt_active_ = false;
   int64_t ptt_timeout_us_ = 0;
   int64_t last_key_timestamp_us_ = 0;
+
+  // Link profile and RTT (PING request answered → final ack received)
+  LinkProfile requested_profile_ = LinkProfile::kDefault;
+  LinkProfile session_profile_ = LinkProfile::kDefault;
+  uint8_t ping_sequence_ = 0;
+  int64_t ping_response_sent_us_ = 0;
+  RttStats rtt_stats_;
 };
 
 }  // namespace remote
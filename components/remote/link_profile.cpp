@@ -0,0 +1,65 @@
+#include "remote/link_profile.hpp"
+
+namespace remote {
+
+const char* LinkProfileName(LinkProfile profile) {
+  switch (profile) {
+    case LinkProfile::kDefault:
+      return "default";
+    case LinkProfile::kLowLatency:
+      return "low_latency";
+  }
+  return "unknown";
+}
+
+void RttStats::Record(LinkProfile profile, uint32_t rtt_us) {
+  const size_t index = static_cast<size_t>(profile);
+  if (index >= kLinkProfileCount) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  Accumulator& acc = profiles_[index];
+  if (acc.samples == 0) {
+    acc.min_us = rtt_us;
+    acc.max_us = rtt_us;
+  } else {
+    const uint32_t delta = (rtt_us > acc.last_us) ? rtt_us - acc.last_us : acc.last_us - rtt_us;
+    // J += (|D| - J) / 16 with J kept scaled by 16
+    acc.jitter_x16 = acc.jitter_x16 + delta - ((acc.jitter_x16 + 8) >> 4);
+    if (rtt_us < acc.min_us) {
+      acc.min_us = rtt_us;
+    }
+    if (rtt_us > acc.max_us) {
+      acc.max_us = rtt_us;
+    }
+  }
+  acc.last_us = rtt_us;
+  acc.sum_us += rtt_us;
+  ++acc.samples;
+}
+
+RttSummary RttStats::Get(LinkProfile profile) const {
+  RttSummary summary;
+  const size_t index = static_cast<size_t>(profile);
+  if (index >= kLinkProfileCount) {
+    return summary;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  const Accumulator& acc = profiles_[index];
+  summary.samples = acc.samples;
+  summary.last_us = acc.last_us;
+  summary.min_us = acc.min_us;
+  summary.max_us = acc.max_us;
+  summary.mean_us = acc.samples > 0 ? static_cast<uint32_t>(acc.sum_us / acc.samples) : 0;
+  summary.jitter_us = acc.jitter_x16 >> 4;
+  return summary;
+}
+
+void RttStats::Reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (Accumulator& acc : profiles_) {
+    acc = Accumulator{};
+  }
+}
+
+}  // namespace remote
@@ -0,0 +1,43 @@
+/**
+ * @file link_socket.cpp
+ * @brief Socket options of the CWNet link profiles (lwIP)
+ */
+
+#include "remote/link_profile.hpp"
+
+#include <cerrno>
+
+#include "esp_log.h"
+#include "lwip/sockets.h"
+
+namespace remote {
+
+namespace {
+constexpr char kLogTag[] = "link_profile";
+
+// DSCP EF (46) in the upper six bits of the TOS byte; 802.11e/WMM maps it to AC_VO
+constexpr int kTosExpeditedForwarding = 46 << 2;
+}  // namespace
+
+bool ApplyLinkProfile(int socket_fd, LinkProfile profile) {
+  if (socket_fd < 0 || profile != LinkProfile::kLowLatency) {
+    return true;
+  }
+
+  bool ok = true;
+  int nodelay = 1;
+  if (lwip_setsockopt(socket_fd, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay)) < 0) {
+    ESP_LOGW(kLogTag, "TCP_NODELAY rejected: errno %d", errno);
+    ok = false;
+  }
+  int tos = kTosExpeditedForwarding;
+  if (lwip_setsockopt(socket_fd, IPPROTO_IP, IP_TOS, &tos, sizeof(tos)) < 0) {
+    ESP_LOGW(kLogTag, "IP_TOS rejected: errno %d", errno);
+    ok = false;
+  }
+  // lwIP has no per-socket TCP send buffer (SO_SNDBUF only applies to UDP);
+  // NODELAY already sends each MORSE frame as soon as it is queued.
+  return ok;
+}
+
+}  // namespace remote
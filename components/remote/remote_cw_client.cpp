@@ -9,6 +9,7 @@
 #include "esp_timer.h"
 #include "lwip/inet.h"
 #include "lwip/netdb.h"
+#include "system_monitor/task_topology.hpp"
 
 #include <fcntl.h>
 
@@ -88,19 +89,20 @@ void RemoteCwClient::Configure(const RemoteCwClientConfig& config,
   ESP_EARLY_LOGW(kLogTag, "Command queue created successfully");
 
   // Create FreeRTOS task
-  ESP_EARLY_LOGW(kLogTag, "Creating FreeRTOS task (stack: 4KB, priority: %d)", tskIDLE_PRIORITY + 2);
+  const system_monitor::TaskSpec& task_spec = system_monitor::TaskSpecFor(system_monitor::TaskId::kRemoteClient);
+  ESP_EARLY_LOGW(kLogTag, "Creating FreeRTOS task (stack: %u, priority: %u, core: %d)",
+                 static_cast<unsigned>(task_spec.stack_bytes), static_cast<unsigned>(task_spec.priority),
+                 task_spec.core);
   ESP_EARLY_LOGW(kLogTag, "sizeof(CommandMessage) = %u bytes", sizeof(CommandMessage));
-  BaseType_t ret = xTaskCreate(
+  BaseType_t ret = system_monitor::CreateTask(
+    system_monitor::TaskId::kRemoteClient,
     TaskFunction,
-    "remote_cw",
-    4096,  // Stack size (4KB)
     this,  // Parameter (this pointer)
-    tskIDLE_PRIORITY + 2,  // Priority
     &task_handle_
   );
 
   if (ret != pdPASS) {
-    ESP_EARLY_LOGE(kLogTag, "Failed to create RemoteCwClient task (xTaskCreate returned %d)", ret);
+    ESP_EARLY_LOGE(kLogTag, "Failed to create RemoteCwClient task (CreateTask returned %d)", ret);
     task_handle_ = nullptr;
     return;
   }
@@ -360,6 +362,11 @@ void RemoteCwClient::AttemptConnect(int64_t now_us) {
     const int flags = lwip_fcntl(socket_fd_, F_GETFL, 0);
     lwip_fcntl(socket_fd_, F_SETFL, flags | O_NONBLOCK);
     connect_in_progress_ = false;
+
+    // The profile is fixed for the whole session (RTT samples are attributed to it)
+    const LinkProfile profile = requested_profile_.load(std::memory_order_relaxed);
+    session_profile_.store(profile, std::memory_order_relaxed);
+    ApplyLinkProfile(socket_fd_, profile);
   }
 
   if (!connect_in_progress_) {
@@ -966,6 +973,8 @@ void RemoteCwClient::HandlePingFrame(const uint8_t* payload, size_t payload_size
         const int64_t rtt_us = now_us - pending_ping_sent_us_;
         uint32_t latency_ms = MicrosecondsToMilliseconds(rtt_us / 2);
         measured_latency_ms_.store(latency_ms, std::memory_order_relaxed);  // Atomic write
+        rtt_stats_.Record(session_profile_.load(std::memory_order_relaxed),
+                          static_cast<uint32_t>(rtt_us));
         if (callbacks_.on_latency_updated != nullptr) {
           callbacks_.on_latency_updated(latency_ms, callbacks_.context);
         }
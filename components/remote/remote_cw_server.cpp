@@ -188,6 +188,9 @@ void RemoteCwServer::HandleNewConnection() {
   if (setsockopt(new_fd, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay)) < 0) {
     ESP_LOGW(kLogTag, "Failed to set TCP_NODELAY: errno %d", errno);
   }
+  session_profile_ = requested_profile_;
+  ApplyLinkProfile(new_fd, session_profile_);
+  ping_response_sent_us_ = 0;
 
   client_fd_ = new_fd;
   std::strncpy(client_ip_, client_ip, sizeof(client_ip_) - 1);
@@ -373,12 +376,19 @@ void RemoteCwServer::HandlePingFrame(const uint8_t* payload, size_t payload_size
   const uint8_t type = payload[0];
   const uint8_t sequence = payload[1];
 
+  const int64_t now_us = hal::HighPrecisionClock::NowMicros();
   if (type == 0) {
     // Client sent REQUEST, respond with type 1
-    const uint32_t now_ms = MicrosecondsToMilliseconds(hal::HighPrecisionClock::NowMicros());
-    SendPingResponse(1, sequence, now_ms);
+    SendPingResponse(1, sequence, MicrosecondsToMilliseconds(now_us));
+    ping_sequence_ = sequence;
+    ping_response_sent_us_ = now_us;
   } else if (type == 2) {
-    // Client sent final ack, respond with type 2 (echo)
+    // Client sent final ack: one round trip since our response
+    if (ping_response_sent_us_ != 0 && sequence == ping_sequence_) {
+      rtt_stats_.Record(session_profile_, static_cast<uint32_t>(now_us - ping_response_sent_us_));
+      ping_response_sent_us_ = 0;
+    }
+    // Respond with type 2 (echo)
     SendPingResponse(2, sequence, 0);
   }
 }
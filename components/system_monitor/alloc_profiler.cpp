@@ -0,0 +1,215 @@
+#include "system_monitor/alloc_profiler.hpp"
+
+#include <cstring>
+
+namespace system_monitor {
+
+namespace {
+
+uint32_t ClampSize(size_t size) {
+  return size > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(size);
+}
+
+struct TaskTag {
+  const char* name;
+  AllocTag tag;
+};
+
+// Tasks with a single owner; the main task is split by the loop's alloc scopes
+constexpr TaskTag kTaskTags[] = {
+    {"main", AllocTag::kMain},
+    {"sidetone_loop", AllocTag::kAudio},
+    {"httpd", AllocTag::kHttp},
+    {"serial_console", AllocTag::kConsole},
+    {"remote_cw", AllocTag::kRemote},
+    {"tl_archive", AllocTag::kTimeline},
+    {"usb_hid", AllocTag::kUsb},
+    {"usb_heartbeat", AllocTag::kUsb},
+    {"TinyUSB", AllocTag::kUsb},
+    {"ota_writer", AllocTag::kOta},
+    {"dns_server", AllocTag::kWifi},
+    {"wifi", AllocTag::kWifi},
+    {"tiT", AllocTag::kWifi},  // lwIP tcpip thread
+    {"sys_evt", AllocTag::kWifi},
+};
+
+// Innermost AllocScope of this thread, -1 = none
+thread_local int8_t t_alloc_scope = -1;
+
+}  // namespace
+
+AllocScope::AllocScope(AllocTag tag) : previous_(t_alloc_scope) {
+  t_alloc_scope = static_cast<int8_t>(tag);
+}
+
+AllocScope::~AllocScope() {
+  t_alloc_scope = previous_;
+}
+
+bool CurrentAllocScope(AllocTag* tag) {
+  if (t_alloc_scope < 0) {
+    return false;
+  }
+  *tag = static_cast<AllocTag>(t_alloc_scope);
+  return true;
+}
+
+const char* AllocTagName(AllocTag tag) {
+  switch (tag) {
+    case AllocTag::kOther:
+      return "other";
+    case AllocTag::kMain:
+      return "main";
+    case AllocTag::kKeying:
+      return "keying";
+    case AllocTag::kAudio:
+      return "audio";
+    case AllocTag::kWifi:
+      return "wifi";
+    case AllocTag::kHttp:
+      return "http";
+    case AllocTag::kConsole:
+      return "console";
+    case AllocTag::kRemote:
+      return "remote";
+    case AllocTag::kTextKeyer:
+      return "text_keyer";
+    case AllocTag::kWinKeyer:
+      return "winkeyer";
+    case AllocTag::kTimeline:
+      return "timeline";
+    case AllocTag::kUsb:
+      return "usb";
+    case AllocTag::kOta:
+      return "ota";
+    case AllocTag::kDiagnostics:
+      return "diagnostics";
+  }
+  return "unknown";
+}
+
+AllocTag AllocTagForTask(const char* task_name) {
+  if (task_name == nullptr) {
+    return AllocTag::kOther;
+  }
+  for (const TaskTag& entry : kTaskTags) {
+    if (std::strcmp(task_name, entry.name) == 0) {
+      return entry.tag;
+    }
+  }
+  return AllocTag::kOther;
+}
+
+size_t AllocProfiler::SlotFor(uintptr_t ptr) {
+  // Heap blocks are 4/8-byte aligned: drop the low bits before mixing
+  return static_cast<size_t>(((ptr >> 3) * 2654435761U) % kLiveCapacity);
+}
+
+size_t AllocProfiler::Find(uintptr_t ptr) const {
+  size_t slot = SlotFor(ptr);
+  for (size_t probes = 0; probes < kLiveCapacity; ++probes) {
+    if (live_[slot].ptr == ptr) {
+      return slot;
+    }
+    if (live_[slot].ptr == 0) {
+      break;
+    }
+    slot = (slot + 1) % kLiveCapacity;
+  }
+  return kLiveCapacity;
+}
+
+void AllocProfiler::Erase(size_t slot) {
+  // Backward-shift deletion keeps linear probing chains intact without tombstones
+  size_t hole = slot;
+  size_t next = (hole + 1) % kLiveCapacity;
+  while (live_[next].ptr != 0) {
+    const size_t home = SlotFor(live_[next].ptr);
+    // Move the entry into the hole unless its home lies cyclically in (hole, next]
+    const bool home_after_hole = hole <= next ? (home > hole && home <= next) : (home > hole || home <= next);
+    if (!home_after_hole) {
+      live_[hole] = live_[next];
+      hole = next;
+    }
+    next = (next + 1) % kLiveCapacity;
+  }
+  live_[hole] = LiveBlock{};
+  --live_count_;
+}
+
+void AllocProfiler::OnAlloc(const void* ptr, size_t size, AllocTag tag, int64_t now_us) {
+  const auto index = static_cast<size_t>(tag);
+  if (ptr == nullptr || index >= kAllocTagCount) {
+    return;
+  }
+  const uint32_t bytes = ClampSize(size);
+  AllocTagStats& stats = tags_[index];
+  ++stats.allocs;
+  stats.alloc_bytes += bytes;
+
+  if (IsFlaggedAllocTag(tag)) {
+    flagged_[flagged_count_ % kFlaggedAllocLogSize] = FlaggedAlloc{tag, bytes, now_us};
+    ++flagged_count_;
+  }
+
+  // Keep one slot free so probing always ends on an empty slot
+  const auto address = reinterpret_cast<uintptr_t>(ptr);
+  if (live_count_ + 1 >= kLiveCapacity || Find(address) != kLiveCapacity) {
+    ++untracked_allocs_;
+    return;
+  }
+  size_t slot = SlotFor(address);
+  while (live_[slot].ptr != 0) {
+    slot = (slot + 1) % kLiveCapacity;
+  }
+  live_[slot] = LiveBlock{address, bytes, tag};
+  ++live_count_;
+  stats.live_bytes += bytes;
+  if (stats.live_bytes > stats.peak_live_bytes) {
+    stats.peak_live_bytes = stats.live_bytes;
+  }
+}
+
+void AllocProfiler::OnFree(const void* ptr) {
+  if (ptr == nullptr) {
+    return;
+  }
+  const size_t slot = Find(reinterpret_cast<uintptr_t>(ptr));
+  if (slot == kLiveCapacity) {
+    ++unknown_frees_;
+    return;
+  }
+  AllocTagStats& stats = tags_[static_cast<size_t>(live_[slot].tag)];
+  ++stats.frees;
+  stats.live_bytes -= live_[slot].size;
+  Erase(slot);
+}
+
+AllocTagStats AllocProfiler::Get(AllocTag tag) const {
+  const auto index = static_cast<size_t>(tag);
+  return index < kAllocTagCount ? tags_[index] : AllocTagStats{};
+}
+
+size_t AllocProfiler::Flagged(FlaggedAlloc* out, size_t max_count) const {
+  const size_t available = flagged_count_ < kFlaggedAllocLogSize ? flagged_count_ : kFlaggedAllocLogSize;
+  const size_t count = available < max_count ? available : max_count;
+  for (size_t i = 0; i < count; ++i) {
+    out[i] = flagged_[(flagged_count_ - 1 - i) % kFlaggedAllocLogSize];
+  }
+  return count;
+}
+
+void AllocProfiler::Reset() {
+  for (LiveBlock& block : live_) {
+    block = LiveBlock{};
+  }
+  live_count_ = 0;
+  for (AllocTagStats& stats : tags_) {
+    stats = AllocTagStats{};
+  }
+  flagged_count_ = 0;
+  untracked_allocs_ = 0;
+  unknown_frees_ = 0;
+}
+
+}  // namespace system_monitor
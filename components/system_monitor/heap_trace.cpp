@@ -0,0 +1,136 @@
+/**
+ * @file heap_trace.cpp
+ * @brief Heap allocation tracer on the ESP-IDF heap hooks (CONFIG_HEAP_USE_HOOKS)
+ */
+
+#include "system_monitor/heap_trace.hpp"
+
+#include <atomic>
+#include <new>
+
+#include "esp_attr.h"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+namespace system_monitor {
+
+namespace {
+
+AllocProfiler* g_profiler = nullptr;  // Created by the first HeapTraceStart()
+std::atomic<bool> g_running{false};
+portMUX_TYPE g_lock = portMUX_INITIALIZER_UNLOCKED;
+
+#ifdef CONFIG_HEAP_USE_HOOKS
+AllocTag CurrentTag() {
+  AllocTag tag;
+  if (CurrentAllocScope(&tag)) {
+    return tag;
+  }
+  return AllocTagForTask(pcTaskGetName(nullptr));
+}
+#endif
+
+}  // namespace
+
+#ifdef CONFIG_HEAP_USE_HOOKS
+
+bool HeapTraceAvailable() {
+  return true;
+}
+
+bool HeapTraceStart() {
+  if (g_profiler == nullptr) {
+    // Internal RAM (the hooks must not touch PSRAM); allocated with the trace
+    // stopped, so the hooks never see their own table being created
+    void* storage = heap_caps_malloc(sizeof(AllocProfiler), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (storage == nullptr) {
+      return false;
+    }
+    g_profiler = new (storage) AllocProfiler();
+  }
+  g_running.store(true, std::memory_order_release);
+  return true;
+}
+
+#else
+
+bool HeapTraceAvailable() {
+  return false;
+}
+
+bool HeapTraceStart() {
+  return false;
+}
+
+#endif  // CONFIG_HEAP_USE_HOOKS
+
+void HeapTraceStop() {
+  g_running.store(false, std::memory_order_release);
+}
+
+bool HeapTraceRunning() {
+  return g_running.load(std::memory_order_acquire);
+}
+
+void HeapTraceReset() {
+  if (g_profiler == nullptr) {
+    return;
+  }
+  portENTER_CRITICAL(&g_lock);
+  g_profiler->Reset();
+  portEXIT_CRITICAL(&g_lock);
+}
+
+void HeapTraceGetReport(HeapTraceReport* report) {
+  *report = HeapTraceReport{};
+  report->running = HeapTraceRunning();
+  if (g_profiler == nullptr) {
+    return;
+  }
+  portENTER_CRITICAL(&g_lock);
+  for (size_t i = 0; i < kAllocTagCount; ++i) {
+    report->tags[i] = g_profiler->Get(static_cast<AllocTag>(i));
+  }
+  report->flagged_logged = g_profiler->Flagged(report->flagged, kFlaggedAllocLogSize);
+  report->flagged_count = g_profiler->flagged_count();
+  report->untracked_allocs = g_profiler->untracked_allocs();
+  report->unknown_frees = g_profiler->unknown_frees();
+  report->live_blocks = g_profiler->live_blocks();
+  portEXIT_CRITICAL(&g_lock);
+}
+
+}  // namespace system_monitor
+
+#ifdef CONFIG_HEAP_USE_HOOKS
+
+//==============================================================================
+// ESP-IDF heap hooks (weak in esp_heap_caps.h). Called by every heap_caps
+// allocation after the heap lock is released; idle cost is the flag check.
+// The profiler code runs from flash: allocations made with the flash cache
+// disabled must not happen anyway, and ISR context is skipped.
+//==============================================================================
+
+extern "C" void IRAM_ATTR esp_heap_trace_alloc_hook(void* ptr, size_t size, uint32_t caps) {
+  (void)caps;
+  if (!system_monitor::g_running.load(std::memory_order_acquire) || xPortInIsrContext()) {
+    return;
+  }
+  const system_monitor::AllocTag tag = system_monitor::CurrentTag();
+  const int64_t now_us = esp_timer_get_time();
+  portENTER_CRITICAL(&system_monitor::g_lock);
+  system_monitor::g_profiler->OnAlloc(ptr, size, tag, now_us);
+  portEXIT_CRITICAL(&system_monitor::g_lock);
+}
+
+extern "C" void IRAM_ATTR esp_heap_trace_free_hook(void* ptr) {
+  if (!system_monitor::g_running.load(std::memory_order_acquire) || xPortInIsrContext()) {
+    return;
+  }
+  portENTER_CRITICAL(&system_monitor::g_lock);
+  system_monitor::g_profiler->OnFree(ptr);
+  portEXIT_CRITICAL(&system_monitor::g_lock);
+}
+
+#endif  // CONFIG_HEAP_USE_HOOKS
@@ -0,0 +1,142 @@
+#pragma once
+
+/**
+ * @file alloc_profiler.hpp
+ * @brief Heap allocation accounting per subsystem
+ *
+ * ARCHITECTURE RATIONALE:
+ * =======================
+ * HeapInfo only shows totals; fragmentation comes from who allocates, how
+ * often and how long the blocks live. AllocProfiler is the bookkeeping behind
+ * the opt-in heap tracer (heap_trace.hpp): every allocation is charged to a
+ * subsystem tag, remembered in a fixed open-addressing table of live blocks,
+ * and its free is charged back to the same tag. Allocations made on the
+ * time-critical keying and audio paths are flagged and logged.
+ *
+ * THREAD SAFETY:
+ * - NOT synchronized: the caller serializes (the tracer calls it from the
+ *   heap hooks under a spinlock; a std::mutex could itself allocate)
+ * - Never allocates: all storage is inside the object
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace system_monitor {
+
+/// Subsystem an allocation is charged to
+enum class AllocTag : uint8_t {
+  kOther = 0,     ///< Unmapped task (ESP-IDF internals, timers)
+  kMain,          ///< Main task outside the loop stages (boot, config apply)
+  kKeying,        ///< Paddles, keying engines, decoder (main loop) - flagged
+  kAudio,         ///< Sidetone / remote audio task - flagged
+  kWifi,          ///< WiFi subsystem, captive portal, lwIP and driver tasks
+  kHttp,          ///< Web server handlers
+  kConsole,       ///< Serial console commands
+  kRemote,        ///< CWNet client and server
+  kTextKeyer,
+  kWinKeyer,
+  kTimeline,      ///< Timeline archive
+  kUsb,           ///< TinyUSB, HID keyboard, heartbeat
+  kOta,
+  kDiagnostics,   ///< LED animations
+};
+
+constexpr size_t kAllocTagCount = 14;
+
+/// Short name ("keying", "http", ...)
+const char* AllocTagName(AllocTag tag);
+
+/// Subsystem owning a FreeRTOS task, by task name (kOther when unknown)
+AllocTag AllocTagForTask(const char* task_name);
+
+/**
+ * @brief Charge the current task's allocations to a tag until destroyed
+ *
+ * Scopes nest; the innermost wins. Costs a thread-local store.
+ */
+class AllocScope {
+ public:
+  explicit AllocScope(AllocTag tag);
+  ~AllocScope();
+
+  AllocScope(const AllocScope&) = delete;
+  AllocScope& operator=(const AllocScope&) = delete;
+
+ private:
+  int8_t previous_;
+};
+
+/// Innermost AllocScope of the calling task; false when none is open
+bool CurrentAllocScope(AllocTag* tag);
+
+/// Allocations with this tag happen on a time-critical path
+constexpr bool IsFlaggedAllocTag(AllocTag tag) {
+  return tag == AllocTag::kKeying || tag == AllocTag::kAudio;
+}
+
+struct AllocTagStats {
+  uint32_t allocs = 0;
+  uint32_t frees = 0;            ///< Frees of blocks this tag allocated
+  uint64_t alloc_bytes = 0;      ///< Cumulative
+  uint32_t live_bytes = 0;       ///< Allocated since Reset() and not yet freed
+  uint32_t peak_live_bytes = 0;
+};
+
+/// One allocation on the keying or audio path
+struct FlaggedAlloc {
+  AllocTag tag = AllocTag::kOther;
+  uint32_t size = 0;
+  int64_t timestamp_us = 0;
+};
+
+/// Flagged allocations kept (newest replaces oldest)
+constexpr size_t kFlaggedAllocLogSize = 8;
+
+class AllocProfiler {
+ public:
+  /// Live blocks tracked at once; more are counted as untracked
+  static constexpr size_t kLiveCapacity = 512;
+
+  AllocProfiler() = default;
+  AllocProfiler(const AllocProfiler&) = delete;
+  AllocProfiler& operator=(const AllocProfiler&) = delete;
+
+  void OnAlloc(const void* ptr, size_t size, AllocTag tag, int64_t now_us);
+
+  /// Frees of blocks allocated before Reset() (or untracked) only count as unknown
+  void OnFree(const void* ptr);
+
+  AllocTagStats Get(AllocTag tag) const;
+
+  /// Flagged allocations, newest first
+  size_t Flagged(FlaggedAlloc* out, size_t max_count) const;
+  uint32_t flagged_count() const { return flagged_count_; }
+
+  uint32_t untracked_allocs() const { return untracked_allocs_; }
+  uint32_t unknown_frees() const { return unknown_frees_; }
+  size_t live_blocks() const { return live_count_; }
+
+  void Reset();
+
+ private:
+  struct LiveBlock {
+    uintptr_t ptr;  ///< 0 = empty slot
+    uint32_t size;
+    AllocTag tag;
+  };
+
+  static size_t SlotFor(uintptr_t ptr);
+  size_t Find(uintptr_t ptr) const;  ///< kLiveCapacity if absent
+  void Erase(size_t slot);
+
+  LiveBlock live_[kLiveCapacity]{};
+  size_t live_count_ = 0;
+  AllocTagStats tags_[kAllocTagCount];
+  FlaggedAlloc flagged_[kFlaggedAllocLogSize];
+  uint32_t flagged_count_ = 0;
+  uint32_t untracked_allocs_ = 0;
+  uint32_t unknown_frees_ = 0;
+};
+
+}  // namespace system_monitor
@@ -0,0 +1,58 @@
+#pragma once
+
+/**
+ * @file heap_trace.hpp
+ * @brief Opt-in heap allocation tracer charging allocations to subsystems
+ *
+ * ARCHITECTURE RATIONALE:
+ * =======================
+ * On target the tracer sits on the ESP-IDF heap hooks (CONFIG_HEAP_USE_HOOKS:
+ * esp_heap_trace_alloc_hook / esp_heap_trace_free_hook); on host a malloc
+ * interposer (tests_host/support/alloc_interposer.cpp) implements the same
+ * API. Both feed an AllocProfiler while the trace runs and cost one flag
+ * check per allocation otherwise.
+ *
+ * ATTRIBUTION:
+ * - An AllocScope on the current task wins (the main loop opens one per
+ *   stage: keying, WiFi, remote server, text keyer, WinKeyer, diagnostics)
+ * - Otherwise the task name decides (AllocTagForTask())
+ *
+ * USAGE PATTERN:
+ * ```
+ * HeapTraceStart();                     // console: heap start
+ * ...
+ * HeapTraceReport report;
+ * HeapTraceGetReport(&report);          // console: heap
+ * ```
+ */
+
+#include "system_monitor/alloc_profiler.hpp"
+
+namespace system_monitor {
+
+/// Copy of the tracer state for printing
+struct HeapTraceReport {
+  bool running = false;
+  AllocTagStats tags[kAllocTagCount];
+  FlaggedAlloc flagged[kFlaggedAllocLogSize];
+  size_t flagged_logged = 0;     ///< Valid entries in flagged[], newest first
+  uint32_t flagged_count = 0;
+  uint32_t untracked_allocs = 0;
+  uint32_t unknown_frees = 0;
+  size_t live_blocks = 0;
+};
+
+/// false when the build has no heap hooks (CONFIG_HEAP_USE_HOOKS not enabled)
+bool HeapTraceAvailable();
+
+/// Start (or resume) charging allocations; blocks allocated before are not tracked
+bool HeapTraceStart();
+void HeapTraceStop();
+bool HeapTraceRunning();
+
+/// Drop all counters and the live block table
+void HeapTraceReset();
+
+void HeapTraceGetReport(HeapTraceReport* report);
+
+}  // namespace system_monitor
@@ -0,0 +1,167 @@
+#pragma once
+
+/**
+ * @file task_topology.hpp
+ * @brief Central table of task placement: core affinity, priority, stack size
+ *
+ * ARCHITECTURE RATIONALE:
+ * =======================
+ * Every task of the firmware is listed once in kTaskTopology (task_topology.cpp)
+ * and created from it (CreateTask(), or the driver config for httpd/TinyUSB).
+ * The ESP32-S3 has two cores; the table splits them:
+ *
+ *   core 0  keying loop (main), sidetone, USB HID report, TinyUSB stack
+ *           + the paddle and USB interrupts (installed from the main task)
+ *   core 1  WiFi driver, lwIP, httpd, console, CWNet client, DNS, OTA, archive
+ *
+ * Rules checked by ValidateTaskTopology(): a real-time task must have a higher
+ * priority than any best-effort task that can run on the same core, so keying
+ * and audio always win over HTTP and WiFi; and among real-time tasks sharing a
+ * core, a higher realtime_rank needs a higher priority, so the short
+ * event-driven tasks (sidetone refill, HID report) preempt the keying loop,
+ * which also runs its non-keying stages. At boot AuditTaskPlacement()
+ * compares the running tasks (including the ones placed by sdkconfig: WiFi,
+ * lwIP, main task core) against the table.
+ *
+ * The table and the rule check are pure (host-testable).
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+namespace system_monitor {
+
+enum class TaskId : uint8_t {
+  kMainLoop = 0,
+  kSidetone,
+  kUsbHid,
+  kTinyUsb,
+  kUsbHeartbeat,
+  kSerialConsole,
+  kHttpd,
+  kDnsServer,
+  kRemoteClient,
+  kTimelineArchive,
+  kOtaWriter,
+  kWifi,
+  kLwip,
+};
+
+constexpr size_t kTaskIdCount = 13;
+
+/// ESP32-S3
+constexpr int8_t kTaskCoreCount = 2;
+/// Not pinned (tskNO_AFFINITY)
+constexpr int8_t kAnyCore = -1;
+
+enum class TaskClass : uint8_t {
+  kRealtime,    ///< Keying and audio paths: must preempt best-effort work on their core
+  kSystem,      ///< Driver/stack tasks (USB, WiFi, lwIP): placed, not ranked
+  kBestEffort,  ///< Everything else
+};
+
+/// Who applies the table entry
+enum class TaskOrigin : uint8_t {
+  kCreated,    ///< CreateTask()
+  kDriver,     ///< Passed to a driver config (httpd_config_t, tinyusb_config_t)
+  kMainTask,   ///< Priority set by the main loop; core and stack from sdkconfig
+  kSdkconfig,  ///< Fixed by sdkconfig.defaults: audited only
+};
+
+struct TaskSpec {
+  TaskId id;
+  const char* name;       ///< FreeRTOS task name
+  TaskClass task_class;
+  TaskOrigin origin;
+  int8_t core;            ///< 0, 1 or kAnyCore
+  UBaseType_t priority;
+  uint32_t stack_bytes;   ///< 0 = not set by the firmware
+  uint8_t realtime_rank = 0;  ///< Real-time only: must preempt lower ranks on a shared core
+};
+
+const char* TaskClassName(TaskClass task_class);
+
+/// Table entry of a task
+const TaskSpec& TaskSpecFor(TaskId id);
+
+/// Whole table (kTaskIdCount entries, in TaskId order)
+const TaskSpec* TaskTopology();
+
+/// Table entry by FreeRTOS task name, nullptr if the task is not in the table
+const TaskSpec* FindTaskSpec(const char* name);
+
+enum class TopologyIssueKind : uint8_t {
+  kBadCore,            ///< Core out of range
+  kBadPriority,        ///< At or above max_priority
+  kSmallStack,         ///< Created task below kMinTaskStackBytes
+  kPriorityInversion,  ///< Real-time task not above a best-effort task sharing its core
+  kRealtimeOrder,      ///< Real-time task not above a lower-ranked real-time task sharing its core
+};
+
+struct TopologyIssue {
+  TopologyIssueKind kind;
+  TaskId task;
+  TaskId other;  ///< Task it fails to preempt (kPriorityInversion, kRealtimeOrder)
+};
+
+constexpr uint32_t kMinTaskStackBytes = 2048;
+
+/// Two placements can share a core
+constexpr bool CanShareCore(int8_t a, int8_t b) {
+  return a == kAnyCore || b == kAnyCore || a == b;
+}
+
+/**
+ * @brief Check a table against the placement rules
+ * @param max_priority configMAX_PRIORITIES of the build
+ * @return Issues found (up to max_issues stored)
+ */
+size_t ValidateTaskTopology(const TaskSpec* specs, size_t count, UBaseType_t max_priority,
+                            TopologyIssue* issues, size_t max_issues);
+
+/// One-line description of an issue found in the firmware table
+void FormatTopologyIssue(const TopologyIssue& issue, char* buffer, size_t size);
+
+/**
+ * @brief Create a task with the placement of its table entry
+ * @return pdPASS on success (xTaskCreatePinnedToCore result)
+ */
+BaseType_t CreateTask(TaskId id, TaskFunction_t function, void* arg, TaskHandle_t* handle);
+
+//==============================================================================
+// Running tasks (target only: FreeRTOS trace facility)
+//==============================================================================
+
+/// Actual placement of one table task
+struct TaskPlacement {
+  TaskId id;
+  bool running = false;
+  int8_t core = kAnyCore;
+  UBaseType_t priority = 0;    ///< Base priority (without inheritance)
+  uint32_t stack_hwm_bytes = 0;
+  uint32_t cpu_permille = 0;   ///< Of one core since boot (run-time stats)
+};
+
+struct CoreLoad {
+  uint32_t busy_permille[kTaskCoreCount]{};  ///< 1000 - idle task share, since boot
+  uint32_t other_tasks = 0;                  ///< Running tasks not in the table
+  bool cpu_available = false;                ///< Run-time stats compiled in
+};
+
+/**
+ * @brief Read the placement of every table task
+ * @param out kTaskIdCount entries, in TaskId order
+ * @return false without CONFIG_FREERTOS_USE_TRACE_FACILITY
+ */
+bool ReadTaskPlacement(TaskPlacement* out, CoreLoad* load);
+
+/**
+ * @brief Log table rule violations and running tasks placed differently from the table
+ * @return Number of problems logged
+ */
+size_t AuditTaskPlacement();
+
+}  // namespace system_monitor
@@ -0,0 +1,154 @@
+#include "system_monitor/task_topology.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+namespace system_monitor {
+
+namespace {
+
+// Core 0: keying and audio (with the paddle/USB interrupts of the main task).
+// Core 1: network and everything that can wait. Priorities on core 0 rank the
+// real-time tasks above TinyUSB, and the short event-driven ones above the
+// keying loop (realtime_rank); on core 1 WiFi and lwIP keep their driver
+// priorities and the application tasks sit below them.
+constexpr TaskSpec kTaskTopology[kTaskIdCount] = {
+    // Keying loop; core 0 and 8 KB from sdkconfig (CONFIG_ESP_MAIN_TASK_*).
+    // Also runs the non-keying stages (console output, decoder, ...): lowest real-time rank
+    {TaskId::kMainLoop, "main", TaskClass::kRealtime, TaskOrigin::kMainTask, 0, 6, 0},
+    // Refills the I2S DMA every chunk: a late refill is an audible underrun
+    {TaskId::kSidetone, "sidetone_loop", TaskClass::kRealtime, TaskOrigin::kCreated, 0, 8, 4096, 2},
+    // Above TinyUSB: a report is queued before the stack services the bus
+    {TaskId::kUsbHid, "usb_hid", TaskClass::kRealtime, TaskOrigin::kCreated, 0, 7, 3072, 1},
+    // Same core as the USB interrupt
+    {TaskId::kTinyUsb, "TinyUSB", TaskClass::kSystem, TaskOrigin::kDriver, 0, 5, 4096},
+    // 4 KB: the task uses ~2.2 KB
+    {TaskId::kUsbHeartbeat, "usb_heartbeat", TaskClass::kBestEffort, TaskOrigin::kCreated, 1, 2, 4096},
+    // C++ objects, vectors and strings of the command handlers
+    {TaskId::kSerialConsole, "serial_console", TaskClass::kBestEffort, TaskOrigin::kCreated, 1, 5, 8192},
+    // JSON parsing
+    {TaskId::kHttpd, "httpd", TaskClass::kBestEffort, TaskOrigin::kDriver, 1, 5, 4096},
+    {TaskId::kDnsServer, "dns_server", TaskClass::kBestEffort, TaskOrigin::kCreated, 1, 4, 4096},
+    // Remote keying events must not queue behind a page load
+    {TaskId::kRemoteClient, "remote_cw", TaskClass::kBestEffort, TaskOrigin::kCreated, 1, 6, 4096},
+    // Archiving only runs in idle time
+    {TaskId::kTimelineArchive, "tl_archive", TaskClass::kBestEffort, TaskOrigin::kCreated, 1, 1, 4096},
+    // Above httpd so a filled buffer is flushed as soon as it is handed over
+    {TaskId::kOtaWriter, "ota_writer", TaskClass::kBestEffort, TaskOrigin::kCreated, 1, 6, 4096},
+    // CONFIG_ESP_WIFI_TASK_PINNED_TO_CORE_1 (ESP_TASK_WIFI_PRIO)
+    {TaskId::kWifi, "wifi", TaskClass::kSystem, TaskOrigin::kSdkconfig, 1, 23, 0},
+    // CONFIG_LWIP_TCPIP_TASK_AFFINITY_CPU1, CONFIG_LWIP_TCPIP_TASK_PRIO
+    {TaskId::kLwip, "tiT", TaskClass::kSystem, TaskOrigin::kSdkconfig, 1, 18, 0},
+};
+
+const char* TaskName(TaskId id) {
+  return TaskSpecFor(id).name;
+}
+
+}  // namespace
+
+const char* TaskClassName(TaskClass task_class) {
+  switch (task_class) {
+    case TaskClass::kRealtime:
+      return "realtime";
+    case TaskClass::kSystem:
+      return "system";
+    case TaskClass::kBestEffort:
+      return "best-effort";
+  }
+  return "unknown";
+}
+
+const TaskSpec& TaskSpecFor(TaskId id) {
+  const auto index = static_cast<size_t>(id);
+  return kTaskTopology[index < kTaskIdCount ? index : 0];
+}
+
+const TaskSpec* TaskTopology() {
+  return kTaskTopology;
+}
+
+const TaskSpec* FindTaskSpec(const char* name) {
+  if (name == nullptr) {
+    return nullptr;
+  }
+  for (const TaskSpec& spec : kTaskTopology) {
+    if (std::strcmp(spec.name, name) == 0) {
+      return &spec;
+    }
+  }
+  return nullptr;
+}
+
+size_t ValidateTaskTopology(const TaskSpec* specs, size_t count, UBaseType_t max_priority,
+                            TopologyIssue* issues, size_t max_issues) {
+  size_t found = 0;
+  const auto report = [&](TopologyIssueKind kind, TaskId task, TaskId other) {
+    if (found < max_issues) {
+      issues[found] = TopologyIssue{kind, task, other};
+    }
+    ++found;
+  };
+
+  for (size_t i = 0; i < count; ++i) {
+    const TaskSpec& spec = specs[i];
+    if (spec.core != kAnyCore && (spec.core < 0 || spec.core >= kTaskCoreCount)) {
+      report(TopologyIssueKind::kBadCore, spec.id, spec.id);
+    }
+    if (spec.priority >= max_priority) {
+      report(TopologyIssueKind::kBadPriority, spec.id, spec.id);
+    }
+    if (spec.origin == TaskOrigin::kCreated && spec.stack_bytes < kMinTaskStackBytes) {
+      report(TopologyIssueKind::kSmallStack, spec.id, spec.id);
+    }
+    if (spec.task_class != TaskClass::kRealtime) {
+      continue;
+    }
+    for (size_t j = 0; j < count; ++j) {
+      const TaskSpec& other = specs[j];
+      if (!CanShareCore(spec.core, other.core) || spec.priority > other.priority) {
+        continue;
+      }
+      if (other.task_class == TaskClass::kBestEffort) {
+        report(TopologyIssueKind::kPriorityInversion, spec.id, other.id);
+      } else if (other.task_class == TaskClass::kRealtime && spec.realtime_rank > other.realtime_rank) {
+        report(TopologyIssueKind::kRealtimeOrder, spec.id, other.id);
+      }
+    }
+  }
+  return found;
+}
+
+void FormatTopologyIssue(const TopologyIssue& issue, char* buffer, size_t size) {
+  const TaskSpec& spec = TaskSpecFor(issue.task);
+  switch (issue.kind) {
+    case TopologyIssueKind::kBadCore:
+      std::snprintf(buffer, size, "%s: core %d does not exist", spec.name, spec.core);
+      return;
+    case TopologyIssueKind::kBadPriority:
+      std::snprintf(buffer, size, "%s: priority %u out of range", spec.name,
+                    static_cast<unsigned>(spec.priority));
+      return;
+    case TopologyIssueKind::kSmallStack:
+      std::snprintf(buffer, size, "%s: stack %u bytes below %u", spec.name,
+                    static_cast<unsigned>(spec.stack_bytes), static_cast<unsigned>(kMinTaskStackBytes));
+      return;
+    case TopologyIssueKind::kPriorityInversion:
+      std::snprintf(buffer, size, "%s (real-time) does not preempt %s on a shared core", spec.name,
+                    TaskName(issue.other));
+      return;
+    case TopologyIssueKind::kRealtimeOrder:
+      std::snprintf(buffer, size, "%s (real-time rank %u) does not preempt %s on a shared core", spec.name,
+                    static_cast<unsigned>(spec.realtime_rank), TaskName(issue.other));
+      return;
+  }
+  std::snprintf(buffer, size, "%s: unknown issue", spec.name);
+}
+
+BaseType_t CreateTask(TaskId id, TaskFunction_t function, void* arg, TaskHandle_t* handle) {
+  const TaskSpec& spec = TaskSpecFor(id);
+  return xTaskCreatePinnedToCore(function, spec.name, spec.stack_bytes, arg, spec.priority, handle,
+                                 spec.core == kAnyCore ? tskNO_AFFINITY : spec.core);
+}
+
+}  // namespace system_monitor
@@ -0,0 +1,134 @@
+/**
+ * @file task_topology_audit.cpp
+ * @brief Running-task side of task_topology.hpp (FreeRTOS trace facility)
+ */
+
+#include "system_monitor/task_topology.hpp"
+
+#include <cstdlib>
+#include <cstring>
+
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+namespace system_monitor {
+
+namespace {
+
+constexpr char kLogTag[] = "task_topology";
+
+// Same bound as the /api/system/stats task list
+constexpr UBaseType_t kMaxTasks = 32;
+
+constexpr size_t kMaxIssues = 8;
+
+}  // namespace
+
+#ifdef CONFIG_FREERTOS_USE_TRACE_FACILITY
+
+bool ReadTaskPlacement(TaskPlacement* out, CoreLoad* load) {
+  for (size_t i = 0; i < kTaskIdCount; ++i) {
+    out[i] = TaskPlacement{};
+    out[i].id = static_cast<TaskId>(i);
+  }
+  *load = CoreLoad{};
+
+  // Heap, not stack: called from the console task as well as the main task
+  auto* status = static_cast<TaskStatus_t*>(malloc(kMaxTasks * sizeof(TaskStatus_t)));
+  if (status == nullptr) {
+    return false;
+  }
+  uint32_t total_runtime = 0;
+  UBaseType_t count = uxTaskGetSystemState(status, kMaxTasks, &total_runtime);
+  if (count > kMaxTasks) {
+    count = kMaxTasks;
+  }
+
+#ifdef CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+  // total_runtime is elapsed time: an idle task's share of it is the idle time of its core
+  load->cpu_available = total_runtime > 0;
+#endif
+
+  for (UBaseType_t i = 0; i < count; ++i) {
+    const TaskStatus_t& task = status[i];
+    const TaskSpec* spec = FindTaskSpec(task.pcTaskName);
+#ifdef CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+    const uint32_t permille =
+        load->cpu_available ? static_cast<uint32_t>(static_cast<uint64_t>(task.ulRunTimeCounter) * 1000U / total_runtime)
+                            : 0;
+    if (task.pcTaskName != nullptr && std::strncmp(task.pcTaskName, "IDLE", 4) == 0) {
+      const int core = task.pcTaskName[4] - '0';
+      if (core >= 0 && core < kTaskCoreCount) {
+        load->busy_permille[core] = permille < 1000 ? 1000 - permille : 0;
+      }
+    }
+#else
+    const uint32_t permille = 0;
+#endif
+    if (spec == nullptr) {
+      ++load->other_tasks;
+      continue;
+    }
+    TaskPlacement& placement = out[static_cast<size_t>(spec->id)];
+    placement.running = true;
+    const BaseType_t core = xTaskGetCoreID(task.xHandle);
+    placement.core = core == tskNO_AFFINITY ? kAnyCore : static_cast<int8_t>(core);
+    placement.priority = task.uxBasePriority;
+    placement.stack_hwm_bytes = task.usStackHighWaterMark;  // Bytes on ESP-IDF
+    placement.cpu_permille = permille;
+  }
+  free(status);
+  return true;
+}
+
+#else
+
+bool ReadTaskPlacement(TaskPlacement* out, CoreLoad* load) {
+  for (size_t i = 0; i < kTaskIdCount; ++i) {
+    out[i] = TaskPlacement{};
+    out[i].id = static_cast<TaskId>(i);
+  }
+  *load = CoreLoad{};
+  return false;
+}
+
+#endif  // CONFIG_FREERTOS_USE_TRACE_FACILITY
+
+size_t AuditTaskPlacement() {
+  size_t problems = 0;
+  char line[96];
+
+  TopologyIssue issues[kMaxIssues];
+  const size_t found = ValidateTaskTopology(TaskTopology(), kTaskIdCount, configMAX_PRIORITIES, issues, kMaxIssues);
+  for (size_t i = 0; i < found && i < kMaxIssues; ++i) {
+    FormatTopologyIssue(issues[i], line, sizeof(line));
+    ESP_LOGE(kLogTag, "%s", line);
+  }
+  problems += found;
+
+  TaskPlacement placement[kTaskIdCount];
+  CoreLoad load;
+  if (!ReadTaskPlacement(placement, &load)) {
+    ESP_LOGW(kLogTag, "Running tasks not audited (CONFIG_FREERTOS_USE_TRACE_FACILITY off)");
+    return problems;
+  }
+  for (const TaskPlacement& actual : placement) {
+    const TaskSpec& spec = TaskSpecFor(actual.id);
+    // Tasks started later (httpd, OTA, CWNet, ...) are checked by 'topology'
+    if (!actual.running) {
+      continue;
+    }
+    if (actual.core != spec.core || actual.priority != spec.priority) {
+      ESP_LOGW(kLogTag, "%s runs on core %d prio %u, table says core %d prio %u", spec.name, actual.core,
+               static_cast<unsigned>(actual.priority), spec.core, static_cast<unsigned>(spec.priority));
+      ++problems;
+    }
+  }
+  if (problems == 0) {
+    ESP_LOGI(kLogTag, "Task placement matches the topology table");
+  }
+  return problems;
+}
+
+}  // namespace system_monitor
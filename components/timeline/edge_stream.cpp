@@ -0,0 +1,133 @@
+#include "timeline/edge_stream.hpp"
+
+namespace timeline {
+
+namespace {
+
+constexpr size_t kMaxEdges = UINT16_MAX - 1;  // Even, fits the u16 header count
+
+size_t PutVarint(uint8_t* out, uint32_t value) {
+  size_t length = 0;
+  while (value >= 0x80) {
+    out[length++] = static_cast<uint8_t>(value | 0x80);
+    value >>= 7;
+  }
+  out[length++] = static_cast<uint8_t>(value);
+  return length;
+}
+
+}  // namespace
+
+EdgeStreamWriter::EdgeStreamWriter(uint8_t* buffer, size_t buffer_size)
+    : buffer_(buffer),
+      capacity_(buffer != nullptr ? buffer_size : 0),
+      length_(kEdgeStreamHeaderSize) {
+  full_ = capacity_ < kEdgeStreamHeaderSize;
+}
+
+bool EdgeStreamWriter::Add(bool key_active, int64_t timestamp_us) {
+  if (full_) {
+    return false;
+  }
+  if (key_active == this->key_active()) {
+    return true;  // Leading key-up or repeated state
+  }
+  if (count_ == 0 && !origin_set_) {
+    origin_us_ = timestamp_us;
+  }
+
+  const int64_t previous_us = count_ == 0 ? origin_us_ : last_us_;
+  const int64_t delta_us = timestamp_us > previous_us ? timestamp_us - previous_us : 0;
+  if (delta_us > static_cast<int64_t>(UINT32_MAX) || count_ >= kMaxEdges) {
+    full_ = true;
+    return false;
+  }
+
+  uint8_t encoded[kEdgeStreamMaxVarintSize];
+  const size_t encoded_length = PutVarint(encoded, static_cast<uint32_t>(delta_us));
+  if (length_ + encoded_length > capacity_) {
+    full_ = true;
+    return false;
+  }
+  for (size_t i = 0; i < encoded_length; ++i) {
+    buffer_[length_ + i] = encoded[i];
+  }
+  last_edge_offset_ = length_;
+  length_ += encoded_length;
+  last_us_ = timestamp_us > previous_us ? timestamp_us : previous_us;
+  ++count_;
+  return true;
+}
+
+size_t EdgeStreamWriter::Finish() {
+  if (capacity_ < kEdgeStreamHeaderSize) {
+    return 0;
+  }
+  if (key_active()) {
+    // Never store a key-down without its key-up (replay would hold the key)
+    length_ = last_edge_offset_;
+    --count_;
+  }
+  buffer_[0] = kEdgeStreamMagic;
+  buffer_[1] = kEdgeStreamVersion;
+  buffer_[2] = static_cast<uint8_t>(count_);
+  buffer_[3] = static_cast<uint8_t>(count_ >> 8);
+  return length_;
+}
+
+EdgeStreamReader::EdgeStreamReader(const uint8_t* data, size_t size)
+    : data_(data), size_(data != nullptr ? size : 0) {
+  if (size_ < kEdgeStreamHeaderSize || data_[0] != kEdgeStreamMagic ||
+      data_[1] != kEdgeStreamVersion) {
+    return;
+  }
+  count_ = static_cast<size_t>(data_[2]) | static_cast<size_t>(data_[3]) << 8;
+  valid_ = (count_ & 1U) == 0;
+}
+
+bool EdgeStreamReader::Next(bool* key_active, int64_t* offset_us) {
+  if (!valid_ || index_ >= count_) {
+    return false;
+  }
+
+  uint32_t delta_us = 0;
+  for (size_t shift = 0;; shift += 7) {
+    if (position_ >= size_ || shift >= 7 * kEdgeStreamMaxVarintSize) {
+      valid_ = false;  // Truncated or oversized varint
+      return false;
+    }
+    const uint8_t byte = data_[position_++];
+    delta_us |= static_cast<uint32_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      break;
+    }
+  }
+
+  offset_us_ += delta_us;
+  *key_active = (index_ & 1U) == 0;
+  *offset_us = offset_us_;
+  ++index_;
+  return true;
+}
+
+bool ValidateEdgeStream(const uint8_t* data, size_t size, int64_t* duration_us) {
+  EdgeStreamReader reader(data, size);
+  if (!reader.valid()) {
+    return false;
+  }
+  bool key_active = false;
+  int64_t offset_us = 0;
+  size_t decoded = 0;
+  while (reader.Next(&key_active, &offset_us)) {
+    ++decoded;
+  }
+  if (decoded != reader.count()) {
+    return false;
+  }
+  if (duration_us != nullptr) {
+    *duration_us = offset_us;
+  }
+  return true;
+}
+
+}  // namespace timeline
@@ -0,0 +1,126 @@
+#pragma once
+
+/**
+ * @file edge_stream.hpp
+ * @brief Delta/varint coded key edge stream (paddle memories, timeline export)
+ *
+ * A recorded fist is nothing but alternating key-down/key-up edges. Storing the
+ * gap to the previous edge as an unsigned LEB128 varint keeps microsecond
+ * resolution at 2-3 bytes per edge (a 60 ms dit is 3 bytes), so a typical
+ * 20-character message fits in a few hundred bytes of flash.
+ *
+ * Layout (little-endian):
+ *   u8 magic (0xED)   u8 version   u16 edge_count
+ *   edge_count × varint delta_us   (edge 0: offset from stream start)
+ *
+ * Edge i is a key-down for even i and a key-up for odd i; writers only emit
+ * whole marks, so edge_count is always even and a stream always ends key-up.
+ * The same encoding backs GET /api/timeline/export, so a section of the
+ * timeline can be stored as a paddle memory and a memory can be inspected
+ * with the timeline tools.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace timeline {
+
+constexpr uint8_t kEdgeStreamMagic = 0xED;
+constexpr uint8_t kEdgeStreamVersion = 1;
+constexpr size_t kEdgeStreamHeaderSize = 4;
+constexpr size_t kEdgeStreamMaxVarintSize = 5;  ///< Deltas are capped at 32 bits
+
+/**
+ * @class EdgeStreamWriter
+ * @brief Encodes key edges into a caller-provided buffer
+ *
+ * Usage:
+ * @code
+ * EdgeStreamWriter writer(buffer, sizeof(buffer));
+ * writer.Add(true, t_down);
+ * writer.Add(false, t_up);
+ * size_t length = writer.Finish();
+ * @endcode
+ */
+class EdgeStreamWriter {
+ public:
+  /**
+   * @param buffer Output buffer (at least kEdgeStreamHeaderSize bytes)
+   * @param buffer_size Buffer size in bytes
+   */
+  EdgeStreamWriter(uint8_t* buffer, size_t buffer_size);
+
+  /**
+   * @brief Append one key edge
+   *
+   * A leading key-up and repeats of the current state are ignored. Timestamps
+   * running backwards encode as a zero gap.
+   *
+   * @return false once the stream is full (buffer, edge count or a gap above
+   *         2^32 µs); later edges are ignored so the stream stays a prefix
+   */
+  bool Add(bool key_active, int64_t timestamp_us);
+
+  /**
+   * @brief Drop an unterminated key-down and write the header
+   * @return Total stream length in bytes (0 if the buffer cannot hold a header)
+   */
+  size_t Finish();
+
+  /// Timestamp that edge 0's offset is measured from (the first edge by default)
+  void SetOrigin(int64_t origin_us) { origin_us_ = origin_us; origin_set_ = true; }
+
+  size_t count() const { return count_; }
+  bool full() const { return full_; }
+  bool key_active() const { return (count_ & 1U) != 0; }
+
+ private:
+  uint8_t* buffer_;
+  size_t capacity_;
+  size_t length_;
+  size_t last_edge_offset_ = 0;  ///< Start of the newest edge (rolled back by Finish())
+  size_t count_ = 0;
+  int64_t origin_us_ = 0;
+  int64_t last_us_ = 0;
+  bool origin_set_ = false;
+  bool full_ = false;
+};
+
+/**
+ * @class EdgeStreamReader
+ * @brief Walks an encoded stream edge by edge
+ */
+class EdgeStreamReader {
+ public:
+  EdgeStreamReader(const uint8_t* data, size_t size);
+
+  /// Header is well-formed (magic, version, even edge count)
+  bool valid() const { return valid_; }
+  size_t count() const { return count_; }
+
+  /**
+   * @brief Decode the next edge
+   * @param key_active Edge direction (output)
+   * @param offset_us Microseconds since stream start (output)
+   * @return false at the end of the stream or on a truncated varint
+   */
+  bool Next(bool* key_active, int64_t* offset_us);
+
+ private:
+  const uint8_t* data_;
+  size_t size_;
+  size_t position_ = kEdgeStreamHeaderSize;
+  size_t count_ = 0;
+  size_t index_ = 0;
+  int64_t offset_us_ = 0;
+  bool valid_ = false;
+};
+
+/**
+ * @brief Decode a whole stream once to check it
+ * @param duration_us Offset of the last edge (output, optional)
+ * @return true if the header is valid and every edge decodes within size
+ */
+bool ValidateEdgeStream(const uint8_t* data, size_t size, int64_t* duration_us = nullptr);
+
+}  // namespace timeline
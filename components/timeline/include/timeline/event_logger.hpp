@@ -30,17 +30,19 @@ extern "C" {
 
 namespace timeline {
 
+// Values 0-14 are stored in the 4-bit type of PackedEvent; larger ones take an extension record
 enum class EventType : uint8_t {
-  kPaddleEdge = 0,
-  kRemoteEvent = 1,
+  kPaddleEdge = 0,     // arg0: line | input_set << 8, arg1: 1=pressed
+  kRemoteEvent = 1,    // arg0: source (1=remote client/2=remote server), arg1: 1=key down
   kDiagnostics = 2,
   kAudio = 3,
-  kKeying = 4,
+  kKeying = 4,         // arg0: element | channel << 8, arg1: 1=start/0=end
   kMemoryWindow = 5,   // arg0: 0=dit/1=dah, arg1: 0=closed/1=open
   kLatch = 6,          // arg0: unused, arg1: 0=released/1=active
   kSqueeze = 7,        // arg0: unused, arg1: 1=detected
-  kGapMarker = 8,      // arg0: 0=element/1=char/2=word, arg1: unused
-  kDecodedChar = 9,    // arg0: char_code (ASCII), arg1: unused
+  kGapMarker = 8,      // arg0: 0=element/1=char/2=word, arg1: source (0=local)
+  kDecodedChar = 9,    // arg0: char_code (ASCII), arg1: source (0=local)
+  kFocus = 10,         // arg0: focused keying channel (SO2R), arg1: unused
 };
 
 struct TimelineEvent {
@@ -50,11 +52,64 @@ struct TimelineEvent {
   uint32_t arg1 = 0;
 };
 
+/// Capacity of the keying timeline and of every component sharing it (~24 KB)
+constexpr size_t kTimelineCapacity = 3072;
+
+/**
+ * @brief 8-byte ring slot of EventLogger (TimelineEvent pads to 24 bytes)
+ *
+ * offset_us is relative to the base timestamp of the slot's block. packed holds
+ * type (bits 0-3), arg0 (bits 4-23) and arg1 (bits 24-31). Events that do not fit
+ * (wide args, offset beyond ±35 min, type >= 15) store kPackedEscape as type and
+ * point to an extension record instead: bits 4-7 type, 8-15 extension index,
+ * 16-31 low half of arg0.
+ */
+struct PackedEvent {
+  int32_t offset_us = 0;
+  uint32_t packed = 0;
+};
+static_assert(sizeof(PackedEvent) == 8, "PackedEvent must stay 8 bytes");
+
+constexpr uint32_t kPackedEscape = 0xF;
+constexpr uint32_t kPackedArg0Bits = 20;
+constexpr uint32_t kPackedArg1Bits = 8;
+
+/// Full-width event referenced by an escaped PackedEvent
+struct ExtensionRecord {
+  int64_t timestamp_us = 0;
+  uint32_t arg0 = 0;
+  uint32_t arg1 = 0;
+  uint32_t sequence = 0;  ///< Low bits of the owning event's push count (staleness check)
+  EventType type = EventType::kDiagnostics;
+};
+
+/**
+ * @brief Fixed-size ring of timeline events, ISR-safe push
+ *
+ * Events are stored as 8-byte PackedEvent slots: three times the history of
+ * 24-byte TimelineEvent slots in the same RAM. Slots are grouped in blocks of
+ * kBlockSize sharing one 64-bit base timestamp (the first event of the block),
+ * so each slot only needs a 32-bit offset. While the head block is being
+ * rewritten, its slots from the previous lap decode against previous_base_.
+ *
+ * Wide events go to a small ring of ExtensionRecords. Once more than
+ * kExtensionCapacity wide events were logged after one of them, that event
+ * decodes from its slot alone (arg0 truncated to 16 bits, arg1 = 0).
+ *
+ * for_each(), copy_since() and latest() hand out decoded TimelineEvents, decoded
+ * under the spinlock.
+ */
 template <size_t Capacity>
 class EventLogger {
   static_assert(Capacity > 0, "EventLogger capacity must be greater than zero");
 
  public:
+  static constexpr size_t kBlockSize = (Capacity < 32) ? Capacity : 32;
+  static constexpr size_t kBlockCount = Capacity / kBlockSize;
+  static constexpr size_t kExtensionCapacity =
+      (Capacity / 128 < 4) ? 4 : ((Capacity / 128 > 256) ? 256 : Capacity / 128);
+  static_assert(Capacity % kBlockSize == 0, "EventLogger capacity must be a multiple of 32");
+
   constexpr EventLogger() : spinlock_(portMUX_INITIALIZER_UNLOCKED) {}
 
   // Thread-safe push for task context. Uses critical section but may allocate literals.
@@ -76,44 +131,127 @@ class EventLogger {
   [[nodiscard]] size_t size() const noexcept { return count_; }
   [[nodiscard]] constexpr size_t capacity() const noexcept { return Capacity; }
   [[nodiscard]] size_t dropped_count() const noexcept { return dropped_count_; }
+  /// Events pushed since construction (never reset; wraps around)
+  [[nodiscard]] size_t pushed_count() const noexcept { return pushed_; }
   [[nodiscard]] bool empty() const noexcept { return count_ == 0; }
 
   void clear() noexcept {
     head_ = 0;
+    head_block_ = 0;
+    head_in_block_ = 0;
     count_ = 0;
     dropped_count_ = 0;
   }
 
+  /**
+   * @brief Visit the events held when the call starts, oldest first (thread-safe)
+   *
+   * Slots decode against block bases that a push may move, so events are decoded
+   * under the spinlock in small batches; the visitor runs outside it. Events
+   * overwritten before their batch is decoded are skipped; events pushed during
+   * the walk are not visited.
+   */
   template <typename Visitor>
   void for_each(Visitor&& visitor) const {
-    const size_t valid = count_;
-    if (valid == 0) {
-      return;
-    }
-    const size_t start = (valid == Capacity) ? head_ : 0;
-    for (size_t i = 0; i < valid; ++i) {
-      size_t index = start + i;
-      if (index >= Capacity) {  // Avoid modulo to prevent literal relocation.
-        index -= Capacity;
+    TimelineEvent batch[kVisitBatch];
+    portENTER_CRITICAL(&spinlock_);
+    size_t cursor = pushed_ - count_;
+    const size_t end = pushed_;
+    portEXIT_CRITICAL(&spinlock_);
+    for (;;) {
+      portENTER_CRITICAL(&spinlock_);
+      size_t copied = 0;
+      copy_range_locked(&cursor, end, batch, kVisitBatch, &copied);
+      portEXIT_CRITICAL(&spinlock_);
+      if (copied == 0) {
+        return;
+      }
+      for (size_t i = 0; i < copied; ++i) {
+        visitor(batch[i]);
       }
-      visitor(buffer_[index]);
     }
   }
 
+  /**
+   * @brief Copy events pushed after *cursor, oldest first (thread-safe)
+   *
+   * For readers that follow the logger incrementally (TimelineArchive): start
+   * with *cursor = pushed_count(), each call advances it past the copied events.
+   * Events overwritten before they could be copied are skipped and reported in
+   * *lost. Keep max small: the copy runs inside the critical section.
+   *
+   * @return Number of events written to out
+   */
+  size_t copy_since(size_t* cursor, TimelineEvent* out, size_t max, size_t* lost) noexcept {
+    size_t copied = 0;
+    portENTER_CRITICAL(&spinlock_);
+    const size_t skipped = copy_range_locked(cursor, pushed_, out, max, &copied);
+    portEXIT_CRITICAL(&spinlock_);
+    if (lost != nullptr) {
+      *lost = skipped;
+    }
+    return copied;
+  }
+
   [[nodiscard]] TimelineEvent latest() const noexcept {
-    if (count_ == 0) {
-      return TimelineEvent{};
+    TimelineEvent event;
+    portENTER_CRITICAL(&spinlock_);
+    if (count_ != 0) {
+      const size_t index = (head_ > 0) ? (head_ - 1) : (Capacity - 1);  // Avoid modulo to prevent literal relocation.
+      event = unpack(index, pushed_ - 1);
     }
-    const size_t index = (head_ > 0) ? (head_ - 1) : (Capacity - 1);  // Avoid modulo to prevent literal relocation.
-    return buffer_[index];
+    portEXIT_CRITICAL(&spinlock_);
+    return event;
   }
 
  private:
+  /// Events decoded per critical section by for_each() (on the caller's stack)
+  static constexpr size_t kVisitBatch = 16;
+
+  /**
+   * Copy up to max events with push counts in [*cursor, end), oldest first, and
+   * advance *cursor past them. Must be called within a critical section.
+   * @return Events skipped because they were overwritten before *cursor reached them
+   */
+  size_t copy_range_locked(size_t* cursor, size_t end, TimelineEvent* out, size_t max,
+                           size_t* copied) const noexcept {
+    size_t behind = pushed_ - *cursor;  // Push counts wrap: compare ages, not counts
+    size_t skipped = 0;
+    if (behind > count_) {
+      skipped = behind - count_;
+      behind = count_;
+    }
+    const size_t end_age = pushed_ - end;
+    const size_t pending = (behind > end_age) ? (behind - end_age) : 0;
+    *copied = (pending < max) ? pending : max;
+    size_t index = (head_ >= behind) ? (head_ - behind) : (head_ + Capacity - behind);
+    size_t sequence = *cursor + skipped;
+    for (size_t i = 0; i < *copied; ++i) {
+      out[i] = unpack(index, sequence++);
+      if (++index >= Capacity) {  // Avoid modulo to prevent literal relocation.
+        index = 0;
+      }
+    }
+    *cursor += skipped + *copied;
+    return skipped;
+  }
+
   // Unsafe push without locking. Must be called within a critical section.
   void push_unsafe(const TimelineEvent& event) noexcept {
-    buffer_[head_] = event;
+    if (head_in_block_ == 0) {
+      previous_base_ = block_base_[head_block_];
+      block_base_[head_block_] = event.timestamp_us;
+    }
+    buffer_[head_] = pack(event, block_base_[head_block_]);
+
     const size_t next_head = head_ + 1;
     head_ = (next_head < Capacity) ? next_head : 0;  // Avoid modulo to prevent literal relocation.
+    if (++head_in_block_ == kBlockSize) {
+      head_in_block_ = 0;
+      const size_t next_block = head_block_ + 1;
+      head_block_ = (next_block < kBlockCount) ? next_block : 0;
+    }
+    ++pushed_;
     if (count_ < Capacity) {
       ++count_;
     } else {
@@ -121,10 +259,66 @@ class EventLogger {
     }
   }
 
-  TimelineEvent buffer_[Capacity] = {};
+  PackedEvent pack(const TimelineEvent& event, int64_t base) noexcept {
+    const int64_t offset = event.timestamp_us - base;
+    const uint32_t type = static_cast<uint32_t>(event.type);
+    // Shift checks only: no wide constants in IRAM code
+    if (static_cast<int64_t>(static_cast<int32_t>(offset)) == offset && type < kPackedEscape &&
+        (event.arg0 >> kPackedArg0Bits) == 0 && (event.arg1 >> kPackedArg1Bits) == 0) {
+      return PackedEvent{static_cast<int32_t>(offset),
+                         type | (event.arg0 << 4) | (event.arg1 << (4 + kPackedArg0Bits))};
+    }
+
+    const size_t slot = extension_head_;
+    const size_t next_slot = slot + 1;
+    extension_head_ = (next_slot < kExtensionCapacity) ? next_slot : 0;
+    extension_[slot] = ExtensionRecord{event.timestamp_us, event.arg0, event.arg1,
+                                       static_cast<uint32_t>(pushed_), event.type};
+    int32_t clamped = static_cast<int32_t>(offset);
+    if (static_cast<int64_t>(clamped) != offset) {
+      clamped = (offset < 0) ? INT32_MIN : INT32_MAX;
+    }
+    return PackedEvent{clamped, kPackedEscape | ((type & 0xFU) << 4) |
+                                    (static_cast<uint32_t>(slot) << 8) | (event.arg0 << 16)};
+  }
+
+  /// Decode slot index, which holds the event with push count sequence
+  TimelineEvent unpack(size_t index, size_t sequence) const noexcept {
+    const PackedEvent& slot = buffer_[index];
+    const uint32_t type = slot.packed & 0xFU;
+    if (type != kPackedEscape) {
+      return TimelineEvent{base_of(index) + slot.offset_us, static_cast<EventType>(type),
+                           (slot.packed >> 4) & ((1U << kPackedArg0Bits) - 1U),
+                           slot.packed >> (4 + kPackedArg0Bits)};
+    }
+    const ExtensionRecord& extension = extension_[(slot.packed >> 8) & 0xFFU];
+    if (extension.sequence == static_cast<uint32_t>(sequence)) {
+      return TimelineEvent{extension.timestamp_us, extension.type, extension.arg0, extension.arg1};
+    }
+    // Extension reused by newer wide events: what the slot still holds
+    return TimelineEvent{base_of(index) + slot.offset_us,
+                         static_cast<EventType>((slot.packed >> 4) & 0xFU), slot.packed >> 16, 0};
+  }
+
+  int64_t base_of(size_t index) const noexcept {
+    const size_t block = index / kBlockSize;
+    if (head_in_block_ != 0 && block == head_block_ && index >= head_) {
+      return previous_base_;  // Previous lap, not yet overwritten
+    }
+    return block_base_[block];
+  }
+
+  PackedEvent buffer_[Capacity] = {};
+  int64_t block_base_[kBlockCount] = {};
+  int64_t previous_base_ = 0;
+  ExtensionRecord extension_[kExtensionCapacity] = {};
+  size_t extension_head_ = 0;
   size_t head_ = 0;
+  size_t head_block_ = 0;
+  size_t head_in_block_ = 0;
   size_t count_ = 0;
   size_t dropped_count_ = 0;
+  size_t pushed_ = 0;
   mutable portMUX_TYPE spinlock_;  // Spinlock for ISR-safe access. Mutable to allow locking in const methods if needed.
 };
 
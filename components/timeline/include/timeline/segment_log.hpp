@@ -0,0 +1,226 @@
+#pragma once
+
+/**
+ * @file segment_log.hpp
+ * @brief Compressed timeline segments in a ring of flash sectors (long-term history)
+ *
+ * The RAM logger keeps ~4 min of events; the archive (timeline_archive.hpp) moves
+ * them into flash as self-describing segments, one per 4 KB sector. Each event is
+ * delta coded (zigzag varint timestamp gap, u8 type, varint arg0/arg1), typically
+ * 5-7 bytes instead of the 8-byte packed RAM slot, so a sector holds ~600 events.
+ *
+ * Segment layout (little-endian):
+ *   u32 magic ("TLS1")  u32 sequence  u16 boot  u16 count  u16 payload_size
+ *   u16 reserved        u32 lost      u32 crc32 (payload)
+ *   i64 min_us          i64 max_us    (timestamp range, for time queries)
+ *   payload: count × { varint zigzag(timestamp - previous), u8 type, varint arg0, varint arg1 }
+ *
+ * The first record's "previous" timestamp is 0. Timestamps are esp_timer time of
+ * the boot that wrote the segment; boot tells boots apart.
+ *
+ * SegmentLog writes sectors in ring order (oldest overwritten first), so every
+ * sector is erased once per lap: wear is spread evenly without a wear-levelling
+ * layer. At mount it rebuilds its index from the 40-byte sector headers only.
+ *
+ * Pure logic over the SegmentFlash interface (host-testable with a RAM fake).
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "timeline/event_logger.hpp"
+
+namespace timeline {
+
+constexpr uint32_t kSegmentMagic = 0x31534C54;  // "TLS1" little-endian
+constexpr size_t kSegmentSize = 4096;           ///< One flash sector
+constexpr size_t kSegmentHeaderSize = 40;
+constexpr size_t kSegmentMaxRecordSize = 21;    ///< 10-byte timestamp + type + 2 × 5-byte args
+
+struct SegmentHeader {
+  uint32_t sequence = 0;
+  uint16_t boot = 0;
+  uint16_t count = 0;
+  uint16_t payload_size = 0;
+  uint32_t lost = 0;       ///< Events skipped (logger overrun) before this segment
+  uint32_t crc = 0;
+  int64_t min_us = 0;
+  int64_t max_us = 0;
+};
+
+/**
+ * @brief Parse and sanity-check a segment header (no payload CRC check)
+ * @return false for erased/foreign sectors or inconsistent sizes
+ */
+bool ParseSegmentHeader(const uint8_t* data, size_t size, SegmentHeader* header);
+
+/**
+ * @class SegmentEncoder
+ * @brief Packs events into one segment buffer
+ */
+class SegmentEncoder {
+ public:
+  /// @param buffer Output buffer, at most kSegmentSize bytes are used
+  SegmentEncoder(uint8_t* buffer, size_t buffer_size);
+
+  /// Start an empty segment in the same buffer
+  void Reset();
+
+  /**
+   * @brief Append one event
+   * @return false when the segment is full (the event is not added)
+   */
+  bool Add(const TimelineEvent& event);
+
+  /**
+   * @brief Write the header
+   * @return Segment length in bytes
+   */
+  size_t Finish(uint32_t sequence, uint16_t boot, uint32_t lost);
+
+  size_t count() const { return count_; }
+  bool empty() const { return count_ == 0; }
+  const uint8_t* data() const { return buffer_; }
+
+ private:
+  uint8_t* buffer_;
+  size_t capacity_;
+  size_t length_ = kSegmentHeaderSize;
+  size_t count_ = 0;
+  int64_t previous_us_ = 0;
+  int64_t min_us_ = 0;
+  int64_t max_us_ = 0;
+};
+
+/**
+ * @class SegmentDecoder
+ * @brief Walks the events of one segment
+ */
+class SegmentDecoder {
+ public:
+  /// Checks header and payload CRC; an invalid segment decodes no events
+  SegmentDecoder(const uint8_t* data, size_t size);
+
+  bool valid() const { return valid_; }
+  const SegmentHeader& header() const { return header_; }
+
+  /// @return false at the end of the segment or on a malformed record
+  bool Next(TimelineEvent* event);
+
+ private:
+  const uint8_t* data_;
+  size_t end_ = 0;
+  size_t position_ = kSegmentHeaderSize;
+  size_t index_ = 0;
+  int64_t previous_us_ = 0;
+  SegmentHeader header_{};
+  bool valid_ = false;
+};
+
+/**
+ * @brief Sector storage behind a SegmentLog (raw flash partition on target)
+ */
+class SegmentFlash {
+ public:
+  virtual ~SegmentFlash() = default;
+
+  /// Number of kSegmentSize slots
+  virtual size_t slot_count() const = 0;
+  virtual bool Read(size_t slot, size_t offset, uint8_t* out, size_t size) = 0;
+  /// Erase the slot and program size bytes from its start
+  virtual bool Write(size_t slot, const uint8_t* data, size_t size) = 0;
+};
+
+/**
+ * @class SegmentLog
+ * @brief Ring of segments with an in-RAM index for time-range queries
+ *
+ * The index costs 32 bytes per slot (8 KB for a 1 MB partition). Not
+ * thread-safe: TimelineArchive serializes access.
+ */
+class SegmentLog {
+ public:
+  struct Entry {
+    uint32_t sequence = 0;
+    uint16_t boot = 0;
+    uint16_t count = 0;
+    int64_t min_us = 0;
+    int64_t max_us = 0;
+    bool valid = false;
+  };
+
+  SegmentLog() = default;
+
+  SegmentLog(const SegmentLog&) = delete;
+  SegmentLog& operator=(const SegmentLog&) = delete;
+
+  /**
+   * @brief Read every slot header and rebuild the index
+   * @return false if the flash has no slots or the index cannot be allocated
+   */
+  bool Mount(SegmentFlash* flash);
+
+  /**
+   * @brief Write a finished segment over the oldest slot
+   * @return false on an invalid segment or a flash error (the slot is then empty)
+   */
+  bool Append(const uint8_t* segment, size_t length);
+
+  /**
+   * @brief Copy a stored segment
+   * @param out Buffer of at least kSegmentSize bytes
+   * @return Segment length, 0 if the slot holds no valid segment
+   */
+  size_t ReadSegment(size_t slot, uint8_t* out);
+
+  /**
+   * @brief Visit stored segments oldest first
+   *
+   * Only segments of the given boot whose [min_us, max_us] overlaps
+   * [since_us, until_us] are visited; all_boots ignores boot and range.
+   * visitor(size_t slot, const Entry&) returns false to stop.
+   */
+  template <typename Visitor>
+  void ForEachSegment(bool all_boots, uint16_t boot, int64_t since_us, int64_t until_us,
+                      Visitor&& visitor) const {
+    for (size_t i = 0; i < slot_count_; ++i) {
+      size_t slot = next_slot_ + i;
+      if (slot >= slot_count_) {
+        slot -= slot_count_;
+      }
+      const Entry& entry = index_[slot];
+      if (!entry.valid) {
+        continue;
+      }
+      if (!all_boots &&
+          (entry.boot != boot || entry.max_us < since_us || entry.min_us > until_us)) {
+        continue;
+      }
+      if (!visitor(slot, entry)) {
+        return;
+      }
+    }
+  }
+
+  bool mounted() const { return flash_ != nullptr; }
+  size_t slot_count() const { return slot_count_; }
+  size_t used_slots() const { return used_slots_; }
+  const Entry& entry(size_t slot) const { return index_[slot]; }
+
+  /// Sequence for the next segment (one past the newest stored)
+  uint32_t next_sequence() const { return next_sequence_; }
+  /// Boot number to stamp on segments of this boot (one past the newest stored)
+  uint16_t current_boot() const { return current_boot_; }
+
+ private:
+  SegmentFlash* flash_ = nullptr;
+  std::unique_ptr<Entry[]> index_;
+  size_t slot_count_ = 0;
+  size_t used_slots_ = 0;
+  size_t next_slot_ = 0;
+  uint32_t next_sequence_ = 0;
+  uint16_t current_boot_ = 0;
+};
+
+}  // namespace timeline
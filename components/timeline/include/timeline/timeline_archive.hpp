@@ -0,0 +1,161 @@
+#pragma once
+
+/**
+ * @file timeline_archive.hpp
+ * @brief Optional long-term timeline recorder on a dedicated flash partition
+ *
+ * A low-priority task follows the RAM EventLogger (EventLogger::copy_since),
+ * packs events into compressed segments (segment_log.hpp) and writes them to the
+ * "timeline" data partition. Keying never waits for it: producers still only push
+ * into the RAM ring.
+ *
+ * DOUBLE BUFFERING:
+ * - Events are encoded into the active 4 KB segment; a full segment is swapped
+ *   into the pending buffer and encoding carries on in the other one
+ * - The pending segment is written once nothing was logged for
+ *   kArchiveIdleFlushUs: a sector erase stalls the flash cache of both cores for
+ *   tens of ms, which must not land in the middle of a character. If the active
+ *   segment fills up before that, the pending one is written anyway
+ *
+ * PARTITION TABLE:
+ * - Needs a data partition labelled "timeline" (any data subtype), e.g.
+ *     timeline, data, 0x40, , 1M
+ *   1 MB (256 segments) holds roughly 150k events, several hours of operating.
+ *   Without it Start() fails with ESP_ERR_NOT_FOUND and nothing else changes
+ *
+ * Events of the current boot are queried by esp_timer time; segments remember
+ * the boot that wrote them, so older boots stay exportable as a whole.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+#include "timeline/event_logger.hpp"
+#include "timeline/segment_log.hpp"
+
+extern "C" {
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+}
+
+namespace timeline {
+
+constexpr char kArchivePartitionLabel[] = "timeline";
+
+/// Quiet time before a pending segment is written to flash
+constexpr int64_t kArchiveIdleFlushUs = 500'000;
+
+/// Logger poll period of the archive task
+constexpr uint32_t kArchivePollMs = 250;
+
+struct TimelineArchiveStats {
+  bool running = false;
+  size_t slot_count = 0;
+  size_t used_slots = 0;
+  uint16_t boot = 0;
+  uint32_t segments_written = 0;
+  uint32_t write_errors = 0;
+  uint32_t events_archived = 0;
+  uint32_t events_lost = 0;       ///< Overwritten in the RAM ring before archiving
+  size_t buffered_events = 0;     ///< Encoded but not yet in flash
+  int64_t oldest_us = 0;          ///< Archived range of the current boot (0 if none)
+  int64_t newest_us = 0;
+};
+
+/**
+ * @class TimelineArchive
+ * @brief Flash-backed timeline history
+ *
+ * Thread safety: Start() once at init; the other methods are safe from any task.
+ */
+class TimelineArchive {
+ public:
+  /// Incremental event source (EventLogger::copy_since signature)
+  using ReadEventsFn = size_t (*)(size_t* cursor, TimelineEvent* out, size_t max, size_t* lost,
+                                  void* context);
+
+  /// Receives one raw segment; return false to stop the export
+  using SegmentSinkFn = bool (*)(const uint8_t* segment, size_t length, void* context);
+
+  TimelineArchive() = default;
+  ~TimelineArchive();
+
+  TimelineArchive(const TimelineArchive&) = delete;
+  TimelineArchive& operator=(const TimelineArchive&) = delete;
+
+  /**
+   * @brief Mount the partition and start archiving a logger
+   *
+   * Events already in the logger are archived too (boot history).
+   */
+  template <size_t Capacity>
+  esp_err_t Start(EventLogger<Capacity>* logger,
+                  const char* partition_label = kArchivePartitionLabel) {
+    return Start(partition_label, &ReadLogger<Capacity>, logger,
+                 logger->pushed_count() - logger->size());
+  }
+
+  esp_err_t Start(const char* partition_label, ReadEventsFn read, void* context, size_t cursor);
+
+  /// Seal the partial segment and write it at the next task pass
+  void RequestFlush();
+
+  bool IsRunning() const { return task_ != nullptr; }
+  TimelineArchiveStats GetStats() const;
+
+  /**
+   * @brief Stream stored segments oldest first, one at a time (no decoding)
+   *
+   * @param all_boots Every stored segment; otherwise segments of the current boot
+   *                  overlapping [since_us, until_us]
+   * @return Number of segments passed to sink
+   */
+  size_t Export(bool all_boots, int64_t since_us, int64_t until_us, SegmentSinkFn sink,
+                void* context);
+
+ private:
+  template <size_t Capacity>
+  static size_t ReadLogger(size_t* cursor, TimelineEvent* out, size_t max, size_t* lost,
+                           void* context) {
+    return static_cast<EventLogger<Capacity>*>(context)->copy_since(cursor, out, max, lost);
+  }
+
+  static void TaskThunk(void* arg);
+  void Run();
+  void Collect();
+  void SealActive();
+  void WritePending();
+
+  std::unique_ptr<SegmentFlash> flash_;
+  SegmentLog log_;
+  mutable std::mutex mutex_;  ///< Guards log_, flash access and the statistics
+
+  ReadEventsFn read_ = nullptr;
+  void* read_context_ = nullptr;
+  size_t cursor_ = 0;
+  TaskHandle_t task_ = nullptr;
+  std::atomic<bool> flush_requested_{false};
+
+  // Double buffer: active_ encodes into buffers_[active_index_], the other one
+  // holds the sealed segment waiting for a quiet moment (pending_length_ > 0)
+  std::unique_ptr<uint8_t[]> buffers_[2];
+  size_t active_index_ = 0;
+  SegmentEncoder active_{nullptr, 0};
+  size_t pending_length_ = 0;
+  size_t pending_count_ = 0;
+  uint32_t next_sequence_ = 0;
+  uint32_t lost_since_seal_ = 0;
+  int64_t last_event_us_ = 0;
+  std::atomic<size_t> buffered_events_{0};
+
+  uint32_t segments_written_ = 0;
+  uint32_t write_errors_ = 0;
+  uint32_t events_archived_ = 0;
+  uint32_t events_lost_ = 0;
+};
+
+}  // namespace timeline
@@ -0,0 +1,167 @@
+#pragma once
+
+/**
+ * @file timeline_capture.hpp
+ * @brief Trigger-based pre/post snapshots of the timeline (logic-analyzer style)
+ *
+ * When a fault is detected (late keying element, ISR queue overflow, remote
+ * queue full, audio underrun) the interesting history has usually wrapped out
+ * of the RAM ring by the time someone looks. A trigger only records its time;
+ * once the post window has elapsed, Poll() copies [trigger - pre, trigger + post]
+ * out of the EventLogger into a capture of its own. Producers keep doing a
+ * single ring push: nothing here runs on the event path.
+ *
+ * Captures use the segment format of the flash archive (segment_log.hpp), so the
+ * same decoder reads both. The last kMaxCaptures are kept, sized to their
+ * content (a few hundred bytes for a typical 2.5 s window).
+ *
+ * Thread safety: all methods are safe from any task (not from ISRs).
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+
+#include "timeline/event_logger.hpp"
+#include "timeline/segment_log.hpp"
+
+namespace timeline {
+
+enum class CaptureTrigger : uint8_t {
+  kManual = 0,            ///< Console / HTTP request (always enabled)
+  kLateElement = 1,       ///< Keying element ended >10% of its length after its planned end
+  kIsrQueueOverflow = 2,  ///< Paddle ISR queue full, edge dropped
+  kRemoteQueueFull = 3,   ///< RemoteCwClient keying queue full, event dropped
+  kAudioUnderrun = 4,     ///< Remote audio stream ran dry
+};
+
+constexpr size_t kCaptureTriggerCount = 5;
+constexpr size_t kMaxCaptures = 4;
+/// Upper bound of pre + post (a 4 KB segment holds ~600 keying events)
+constexpr uint32_t kCaptureMaxWindowMs = 20000;
+
+/// Enable bit of a trigger in CaptureConfig::trigger_mask (general.capture_triggers)
+constexpr uint8_t CaptureTriggerBit(CaptureTrigger trigger) {
+  return static_cast<uint8_t>(1U << (static_cast<uint8_t>(trigger) - 1U));
+}
+
+/// Short name ("late", "isr_overflow", ...)
+const char* CaptureTriggerName(CaptureTrigger trigger);
+
+struct CaptureConfig {
+  uint8_t trigger_mask = 0;  ///< CaptureTriggerBit() of the automatic triggers
+  uint32_t pre_ms = 2000;
+  uint32_t post_ms = 500;
+};
+
+struct CaptureInfo {
+  uint32_t id = 0;
+  CaptureTrigger trigger = CaptureTrigger::kManual;
+  int64_t trigger_us = 0;
+  uint32_t pre_ms = 0;
+  uint32_t post_ms = 0;
+  size_t events = 0;
+  size_t length = 0;       ///< Segment bytes (0 when the window held no events)
+  bool truncated = false;  ///< Window did not fit one segment; the end is missing
+};
+
+/**
+ * @class TimelineCapture
+ * @brief Armed triggers plus the last few frozen snapshots
+ */
+class TimelineCapture {
+ public:
+  TimelineCapture() = default;
+
+  TimelineCapture(const TimelineCapture&) = delete;
+  TimelineCapture& operator=(const TimelineCapture&) = delete;
+
+  /// Window lengths are clamped so that pre + post <= kCaptureMaxWindowMs
+  void Configure(const CaptureConfig& config);
+  CaptureConfig config() const;
+
+  /**
+   * @brief Arm a capture around timestamp_us
+   * @return false if the trigger is disabled or a capture is already pending
+   */
+  bool Trigger(CaptureTrigger trigger, int64_t timestamp_us);
+
+  /// A trigger fired and its capture is not frozen yet
+  bool pending() const;
+
+  /**
+   * @brief Freeze the pending capture once its post window has elapsed
+   *
+   * Walks the whole ring once, so call it where a few hundred µs do not matter
+   * (KeyingSubsystem does it while no key is down).
+   * @return true if a capture was frozen
+   */
+  template <size_t Capacity>
+  bool Poll(const EventLogger<Capacity>& logger, int64_t now_us) {
+    CaptureInfo info;
+    if (!TakeDue(now_us, &info)) {
+      return false;
+    }
+    std::unique_ptr<uint8_t[]> scratch(new (std::nothrow) uint8_t[kSegmentSize]);
+    if (!scratch) {
+      return false;
+    }
+    const int64_t since_us = info.trigger_us - static_cast<int64_t>(info.pre_ms) * 1000;
+    const int64_t until_us = info.trigger_us + static_cast<int64_t>(info.post_ms) * 1000;
+    SegmentEncoder encoder(scratch.get(), kSegmentSize);
+    logger.for_each([&](const TimelineEvent& event) {
+      if (info.truncated || event.timestamp_us < since_us || event.timestamp_us > until_us) {
+        return;
+      }
+      info.truncated = !encoder.Add(event);
+    });
+    info.events = encoder.count();
+    if (!encoder.empty()) {
+      info.length = encoder.Finish(info.id, 0, 0);
+    }
+    Store(info, scratch.get());
+    return true;
+  }
+
+  /**
+   * @brief Frozen captures, oldest first
+   * @return Number written to out
+   */
+  size_t List(CaptureInfo* out, size_t max) const;
+
+  /**
+   * @brief Copy one capture (segment format)
+   * @param out Buffer of at least kSegmentSize bytes
+   * @param info Filled with the capture's info (id 0 if the id is unknown)
+   * @return Segment length, 0 if the id is unknown or the capture is empty
+   */
+  size_t Read(uint32_t id, uint8_t* out, CaptureInfo* info) const;
+
+  /// Drop every frozen capture (a pending one stays armed)
+  void Clear();
+
+  /// Triggers ignored because a capture was pending (counts all enabled ones)
+  uint32_t missed_triggers() const;
+
+ private:
+  struct Slot {
+    CaptureInfo info;
+    std::unique_ptr<uint8_t[]> data;
+  };
+
+  bool TakeDue(int64_t now_us, CaptureInfo* info);
+  void Store(const CaptureInfo& info, const uint8_t* segment);
+
+  mutable std::mutex mutex_;
+  CaptureConfig config_{};
+  bool pending_ = false;
+  CaptureInfo pending_info_{};
+  uint32_t next_id_ = 1;
+  uint32_t missed_triggers_ = 0;
+  Slot slots_[kMaxCaptures];
+  size_t next_slot_ = 0;
+};
+
+}  // namespace timeline
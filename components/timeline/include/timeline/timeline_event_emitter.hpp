@@ -97,7 +97,7 @@ class TimelineEventEmitter {
    * @note No validation is performed on event_logger pointer. Caller must
    *       ensure it points to a valid EventLogger instance.
    */
-  explicit TimelineEventEmitter(EventLogger<1024>* event_logger);
+  explicit TimelineEventEmitter(EventLogger<kTimelineCapacity>* event_logger);
 
   /**
    * @brief Hook callback for memory window state changes
@@ -194,7 +194,7 @@ class TimelineEventEmitter {
    * event_logger_->push(TimelineEvent{...});
    * @endcode
    */
-  EventLogger<1024>* event_logger_;
+  EventLogger<kTimelineCapacity>* event_logger_;
 };
 
 }  // namespace timeline
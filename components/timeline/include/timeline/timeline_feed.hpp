@@ -0,0 +1,91 @@
+#pragma once
+
+/**
+ * @file timeline_feed.hpp
+ * @brief Compact binary encoding of timeline events for the web UI
+ *
+ * JSON costs ~80 bytes and a cJSON allocation per event; the timeline page fetches
+ * up to 1024 events per request ten times per second. The binary feed packs each event
+ * into 8 bytes behind one 32-byte header (all fields little-endian):
+ *
+ * Header:
+ *   u32 magic ("TLB1")   u16 version   u16 count
+ *   i64 base_us          (timestamp of the first record)
+ *   i64 server_time_us   (esp_timer_get_time() when the page was built)
+ *   u32 dropped_count    u32 reserved
+ *
+ * Record:
+ *   u32 delta_us (timestamp - base_us)   u8 type   u8 arg1   u16 arg0
+ *
+ * arg0 is clamped to 0xFFFF and arg1 to 0xFF (every producer fits: characters,
+ * paddle/source indices, booleans). A page ends early when the next event is more
+ * than 2^32 µs (71 min) after base_us; the client simply asks again with
+ * since = last timestamp.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include "timeline/event_logger.hpp"
+
+namespace timeline {
+
+constexpr uint32_t kFeedMagic = 0x31424C54;  // "TLB1" little-endian
+constexpr uint16_t kFeedVersion = 1;
+constexpr size_t kFeedHeaderSize = 32;
+constexpr size_t kFeedRecordSize = 8;
+
+/**
+ * @brief Bytes needed for a page of up to max_events records
+ */
+constexpr size_t FeedPageSize(size_t max_events) {
+  return kFeedHeaderSize + max_events * kFeedRecordSize;
+}
+
+/**
+ * @class FeedWriter
+ * @brief Builds one binary feed page into a caller-provided buffer
+ *
+ * Usage:
+ * @code
+ * FeedWriter writer(buffer, sizeof(buffer));
+ * logger.for_each([&](const TimelineEvent& evt) {
+ *   if (evt.timestamp_us > since_us) writer.Add(evt);
+ * });
+ * size_t length = writer.Finish(esp_timer_get_time(), logger.dropped_count());
+ * @endcode
+ */
+class FeedWriter {
+ public:
+  /**
+   * @param buffer Output buffer (at least kFeedHeaderSize bytes)
+   * @param buffer_size Buffer size in bytes; bounds the record count
+   */
+  FeedWriter(uint8_t* buffer, size_t buffer_size);
+
+  /**
+   * @brief Append one event
+   * @return false when the page is full (buffer or delta range); later events are
+   *         ignored so the page stays a contiguous, ordered prefix
+   */
+  bool Add(const TimelineEvent& event);
+
+  /**
+   * @brief Write the header
+   * @return Total page length in bytes
+   */
+  size_t Finish(int64_t server_time_us, uint32_t dropped_count);
+
+  size_t count() const { return count_; }
+  bool full() const { return full_; }
+
+ private:
+  uint8_t* buffer_;
+  bool header_fits_;
+  size_t capacity_;  ///< Records that fit in the buffer
+  size_t count_ = 0;
+  int64_t base_us_ = 0;
+  bool full_ = false;
+};
+
+}  // namespace timeline
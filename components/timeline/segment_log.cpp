@@ -0,0 +1,267 @@
+#include "timeline/segment_log.hpp"
+
+#include <new>
+
+namespace timeline {
+
+namespace {
+
+constexpr size_t kMaxVarint64Size = 10;
+
+void PutU16(uint8_t* out, uint16_t value) {
+  out[0] = static_cast<uint8_t>(value);
+  out[1] = static_cast<uint8_t>(value >> 8);
+}
+
+void PutU32(uint8_t* out, uint32_t value) {
+  PutU16(out, static_cast<uint16_t>(value));
+  PutU16(out + 2, static_cast<uint16_t>(value >> 16));
+}
+
+void PutI64(uint8_t* out, int64_t value) {
+  const uint64_t bits = static_cast<uint64_t>(value);
+  PutU32(out, static_cast<uint32_t>(bits));
+  PutU32(out + 4, static_cast<uint32_t>(bits >> 32));
+}
+
+uint16_t GetU16(const uint8_t* in) {
+  return static_cast<uint16_t>(in[0] | in[1] << 8);
+}
+
+uint32_t GetU32(const uint8_t* in) {
+  return static_cast<uint32_t>(GetU16(in)) | static_cast<uint32_t>(GetU16(in + 2)) << 16;
+}
+
+int64_t GetI64(const uint8_t* in) {
+  return static_cast<int64_t>(static_cast<uint64_t>(GetU32(in)) |
+                              static_cast<uint64_t>(GetU32(in + 4)) << 32);
+}
+
+size_t PutVarint(uint8_t* out, uint64_t value) {
+  size_t length = 0;
+  while (value >= 0x80) {
+    out[length++] = static_cast<uint8_t>(value | 0x80);
+    value >>= 7;
+  }
+  out[length++] = static_cast<uint8_t>(value);
+  return length;
+}
+
+bool GetVarint(const uint8_t* data, size_t end, size_t* position, uint64_t* value) {
+  uint64_t result = 0;
+  for (size_t shift = 0; shift < 7 * kMaxVarint64Size; shift += 7) {
+    if (*position >= end) {
+      return false;
+    }
+    const uint8_t byte = data[(*position)++];
+    result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      *value = result;
+      return true;
+    }
+  }
+  return false;
+}
+
+uint64_t ZigZag(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t UnZigZag(uint64_t value) {
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+// CRC-32 (IEEE, reflected), bitwise: one 4 KB segment per flush, no table needed
+uint32_t Crc32(const uint8_t* data, size_t size) {
+  uint32_t crc = 0xFFFFFFFFU;
+  for (size_t i = 0; i < size; ++i) {
+    crc ^= data[i];
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc >> 1) ^ (0xEDB88320U & (0U - (crc & 1U)));
+    }
+  }
+  return ~crc;
+}
+
+}  // namespace
+
+bool ParseSegmentHeader(const uint8_t* data, size_t size, SegmentHeader* header) {
+  if (data == nullptr || size < kSegmentHeaderSize || GetU32(data) != kSegmentMagic) {
+    return false;
+  }
+  header->sequence = GetU32(data + 4);
+  header->boot = GetU16(data + 8);
+  header->count = GetU16(data + 10);
+  header->payload_size = GetU16(data + 12);
+  header->lost = GetU32(data + 16);
+  header->crc = GetU32(data + 20);
+  header->min_us = GetI64(data + 24);
+  header->max_us = GetI64(data + 32);
+  return header->payload_size <= kSegmentSize - kSegmentHeaderSize && header->count > 0 &&
+         header->min_us <= header->max_us;
+}
+
+SegmentEncoder::SegmentEncoder(uint8_t* buffer, size_t buffer_size)
+    : buffer_(buffer),
+      capacity_(buffer == nullptr ? 0 : (buffer_size < kSegmentSize ? buffer_size : kSegmentSize)) {}
+
+void SegmentEncoder::Reset() {
+  length_ = kSegmentHeaderSize;
+  count_ = 0;
+  previous_us_ = 0;
+}
+
+bool SegmentEncoder::Add(const TimelineEvent& event) {
+  if (count_ >= UINT16_MAX || length_ + kSegmentMaxRecordSize > capacity_) {
+    return false;
+  }
+  uint8_t* out = buffer_ + length_;
+  size_t length = PutVarint(out, ZigZag(event.timestamp_us - previous_us_));
+  out[length++] = static_cast<uint8_t>(event.type);
+  length += PutVarint(out + length, event.arg0);
+  length += PutVarint(out + length, event.arg1);
+  length_ += length;
+
+  if (count_ == 0 || event.timestamp_us < min_us_) {
+    min_us_ = event.timestamp_us;
+  }
+  if (count_ == 0 || event.timestamp_us > max_us_) {
+    max_us_ = event.timestamp_us;
+  }
+  previous_us_ = event.timestamp_us;
+  ++count_;
+  return true;
+}
+
+size_t SegmentEncoder::Finish(uint32_t sequence, uint16_t boot, uint32_t lost) {
+  if (capacity_ < kSegmentHeaderSize) {
+    return 0;
+  }
+  const size_t payload_size = length_ - kSegmentHeaderSize;
+  PutU32(buffer_, kSegmentMagic);
+  PutU32(buffer_ + 4, sequence);
+  PutU16(buffer_ + 8, boot);
+  PutU16(buffer_ + 10, static_cast<uint16_t>(count_));
+  PutU16(buffer_ + 12, static_cast<uint16_t>(payload_size));
+  PutU16(buffer_ + 14, 0);
+  PutU32(buffer_ + 16, lost);
+  PutU32(buffer_ + 20, Crc32(buffer_ + kSegmentHeaderSize, payload_size));
+  PutI64(buffer_ + 24, min_us_);
+  PutI64(buffer_ + 32, max_us_);
+  return length_;
+}
+
+SegmentDecoder::SegmentDecoder(const uint8_t* data, size_t size) : data_(data) {
+  if (!ParseSegmentHeader(data, size, &header_)) {
+    return;
+  }
+  end_ = kSegmentHeaderSize + header_.payload_size;
+  valid_ = end_ <= size && Crc32(data + kSegmentHeaderSize, header_.payload_size) == header_.crc;
+}
+
+bool SegmentDecoder::Next(TimelineEvent* event) {
+  if (!valid_ || index_ >= header_.count) {
+    return false;
+  }
+  uint64_t delta = 0;
+  uint64_t arg0 = 0;
+  uint64_t arg1 = 0;
+  if (!GetVarint(data_, end_, &position_, &delta) || position_ >= end_) {
+    valid_ = false;
+    return false;
+  }
+  const uint8_t type = data_[position_++];
+  if (!GetVarint(data_, end_, &position_, &arg0) || !GetVarint(data_, end_, &position_, &arg1)) {
+    valid_ = false;
+    return false;
+  }
+
+  previous_us_ += UnZigZag(delta);
+  event->timestamp_us = previous_us_;
+  event->type = static_cast<EventType>(type);
+  event->arg0 = static_cast<uint32_t>(arg0);
+  event->arg1 = static_cast<uint32_t>(arg1);
+  ++index_;
+  return true;
+}
+
+bool SegmentLog::Mount(SegmentFlash* flash) {
+  flash_ = nullptr;
+  slot_count_ = flash != nullptr ? flash->slot_count() : 0;
+  if (slot_count_ == 0) {
+    return false;
+  }
+  index_.reset(new (std::nothrow) Entry[slot_count_]);
+  if (!index_) {
+    slot_count_ = 0;
+    return false;
+  }
+
+  used_slots_ = 0;
+  next_slot_ = 0;
+  next_sequence_ = 0;
+  uint16_t newest_boot = 0;
+  bool any = false;
+  uint8_t raw[kSegmentHeaderSize];
+  for (size_t slot = 0; slot < slot_count_; ++slot) {
+    SegmentHeader header{};
+    if (!flash->Read(slot, 0, raw, sizeof(raw)) || !ParseSegmentHeader(raw, sizeof(raw), &header)) {
+      continue;
+    }
+    index_[slot] = Entry{header.sequence, header.boot, header.count, header.min_us, header.max_us,
+                         true};
+    ++used_slots_;
+    // Sequences increase by one per segment; compare wrap-safe
+    if (!any || static_cast<int32_t>(header.sequence - (next_sequence_ - 1)) > 0) {
+      next_sequence_ = header.sequence + 1;
+      next_slot_ = slot + 1 < slot_count_ ? slot + 1 : 0;
+      newest_boot = header.boot;
+      any = true;
+    }
+  }
+  current_boot_ = any ? static_cast<uint16_t>(newest_boot + 1) : 0;
+  flash_ = flash;
+  return true;
+}
+
+bool SegmentLog::Append(const uint8_t* segment, size_t length) {
+  SegmentHeader header{};
+  if (flash_ == nullptr || length > kSegmentSize ||
+      !ParseSegmentHeader(segment, length, &header)) {
+    return false;
+  }
+
+  const size_t slot = next_slot_;
+  next_slot_ = slot + 1 < slot_count_ ? slot + 1 : 0;
+  next_sequence_ = header.sequence + 1;
+  if (index_[slot].valid) {
+    index_[slot].valid = false;
+    --used_slots_;
+  }
+  if (!flash_->Write(slot, segment, length)) {
+    return false;
+  }
+  index_[slot] = Entry{header.sequence, header.boot, header.count, header.min_us, header.max_us,
+                       true};
+  ++used_slots_;
+  return true;
+}
+
+size_t SegmentLog::ReadSegment(size_t slot, uint8_t* out) {
+  if (flash_ == nullptr || slot >= slot_count_ || !index_[slot].valid) {
+    return 0;
+  }
+  SegmentHeader header{};
+  if (!flash_->Read(slot, 0, out, kSegmentHeaderSize) ||
+      !ParseSegmentHeader(out, kSegmentHeaderSize, &header) ||
+      header.sequence != index_[slot].sequence) {
+    return 0;
+  }
+  const size_t length = kSegmentHeaderSize + header.payload_size;
+  if (!flash_->Read(slot, kSegmentHeaderSize, out + kSegmentHeaderSize, header.payload_size)) {
+    return 0;
+  }
+  return length;
+}
+
+}  // namespace timeline
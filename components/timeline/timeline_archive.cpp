@@ -0,0 +1,250 @@
+#include "timeline/timeline_archive.hpp"
+
+#include <new>
+
+extern "C" {
+#include "esp_log.h"
+#include "esp_partition.h"
+#include "esp_timer.h"
+}
+
+#include "system_monitor/task_topology.hpp"
+
+namespace timeline {
+
+namespace {
+constexpr char kLogTag[] = "timeline_archive";
+
+/// Events copied per logger critical section
+constexpr size_t kBatchSize = 16;
+
+/// SegmentFlash on a raw data partition, one segment per 4 KB sector
+class PartitionFlash : public SegmentFlash {
+ public:
+  explicit PartitionFlash(const esp_partition_t* partition) : partition_(partition) {}
+
+  size_t slot_count() const override { return partition_->size / kSegmentSize; }
+
+  bool Read(size_t slot, size_t offset, uint8_t* out, size_t size) override {
+    return esp_partition_read(partition_, slot * kSegmentSize + offset, out, size) == ESP_OK;
+  }
+
+  bool Write(size_t slot, const uint8_t* data, size_t size) override {
+    const size_t address = slot * kSegmentSize;
+    esp_err_t err = esp_partition_erase_range(partition_, address, kSegmentSize);
+    if (err == ESP_OK) {
+      err = esp_partition_write(partition_, address, data, size);
+    }
+    if (err != ESP_OK) {
+      ESP_LOGW(kLogTag, "Segment write at slot %u failed: %s", static_cast<unsigned>(slot),
+               esp_err_to_name(err));
+    }
+    return err == ESP_OK;
+  }
+
+ private:
+  const esp_partition_t* partition_;
+};
+}  // namespace
+
+TimelineArchive::~TimelineArchive() {
+  if (task_ != nullptr) {
+    // Not in the middle of a flash write or export once we hold the mutex
+    std::lock_guard<std::mutex> lock(mutex_);
+    vTaskDelete(task_);
+    task_ = nullptr;
+  }
+}
+
+esp_err_t TimelineArchive::Start(const char* partition_label, ReadEventsFn read, void* context,
+                                 size_t cursor) {
+  if (task_ != nullptr) {
+    return ESP_ERR_INVALID_STATE;
+  }
+  if (read == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+
+  const esp_partition_t* partition = esp_partition_find_first(
+      ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, partition_label);
+  if (partition == nullptr) {
+    ESP_LOGW(kLogTag, "No '%s' partition - timeline archive disabled", partition_label);
+    return ESP_ERR_NOT_FOUND;
+  }
+
+  flash_.reset(new (std::nothrow) PartitionFlash(partition));
+  buffers_[0].reset(new (std::nothrow) uint8_t[kSegmentSize]);
+  buffers_[1].reset(new (std::nothrow) uint8_t[kSegmentSize]);
+  if (!flash_ || !buffers_[0] || !buffers_[1] || !log_.Mount(flash_.get())) {
+    ESP_LOGE(kLogTag, "Failed to mount timeline archive (%u bytes)",
+             static_cast<unsigned>(partition->size));
+    buffers_[0].reset();
+    buffers_[1].reset();
+    flash_.reset();
+    return ESP_ERR_NO_MEM;
+  }
+
+  read_ = read;
+  read_context_ = context;
+  cursor_ = cursor;
+  active_index_ = 0;
+  active_ = SegmentEncoder(buffers_[0].get(), kSegmentSize);
+  next_sequence_ = log_.next_sequence();
+
+  if (system_monitor::CreateTask(system_monitor::TaskId::kTimelineArchive, &TaskThunk, this, &task_) != pdPASS) {
+    task_ = nullptr;
+    return ESP_ERR_NO_MEM;
+  }
+
+  ESP_LOGI(kLogTag, "Timeline archive on '%s': %u/%u segments used, boot %u",
+           partition_label, static_cast<unsigned>(log_.used_slots()),
+           static_cast<unsigned>(log_.slot_count()), static_cast<unsigned>(log_.current_boot()));
+  return ESP_OK;
+}
+
+void TimelineArchive::RequestFlush() {
+  flush_requested_.store(true);
+  if (task_ != nullptr) {
+    xTaskNotifyGive(task_);
+  }
+}
+
+TimelineArchiveStats TimelineArchive::GetStats() const {
+  TimelineArchiveStats stats{};
+  stats.running = task_ != nullptr;
+  stats.buffered_events = buffered_events_.load();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats.slot_count = log_.slot_count();
+  stats.used_slots = log_.used_slots();
+  stats.boot = log_.current_boot();
+  stats.segments_written = segments_written_;
+  stats.write_errors = write_errors_;
+  stats.events_archived = events_archived_;
+  stats.events_lost = events_lost_;
+  bool any = false;
+  log_.ForEachSegment(false, log_.current_boot(), INT64_MIN, INT64_MAX,
+                      [&](size_t, const SegmentLog::Entry& entry) {
+                        if (!any || entry.min_us < stats.oldest_us) {
+                          stats.oldest_us = entry.min_us;
+                        }
+                        if (!any || entry.max_us > stats.newest_us) {
+                          stats.newest_us = entry.max_us;
+                        }
+                        any = true;
+                        return true;
+                      });
+  return stats;
+}
+
+size_t TimelineArchive::Export(bool all_boots, int64_t since_us, int64_t until_us,
+                               SegmentSinkFn sink, void* context) {
+  if (!log_.mounted() || sink == nullptr) {
+    return 0;
+  }
+  std::unique_ptr<uint8_t[]> segment(new (std::nothrow) uint8_t[kSegmentSize]);
+  if (!segment) {
+    return 0;
+  }
+
+  // Walk by sequence, not by slot: the task may overwrite the oldest slot while the
+  // sink is sending, and the mutex is only held for one flash read at a time
+  uint32_t next = 0;
+  bool started = false;
+  size_t exported = 0;
+  for (;;) {
+    size_t length = 0;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      log_.ForEachSegment(all_boots, log_.current_boot(), since_us, until_us,
+                          [&](size_t slot, const SegmentLog::Entry& entry) {
+                            if (started && static_cast<int32_t>(entry.sequence - next) < 0) {
+                              return true;  // Already sent
+                            }
+                            length = log_.ReadSegment(slot, segment.get());
+                            next = entry.sequence + 1;
+                            return length == 0;  // Skip unreadable slots
+                          });
+    }
+    if (length == 0) {
+      return exported;
+    }
+    started = true;
+    ++exported;
+    if (!sink(segment.get(), length, context)) {
+      return exported;
+    }
+  }
+}
+
+void TimelineArchive::TaskThunk(void* arg) {
+  static_cast<TimelineArchive*>(arg)->Run();
+}
+
+void TimelineArchive::Run() {
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(kArchivePollMs));
+    Collect();
+
+    const bool flush = flush_requested_.exchange(false);
+    if (flush && !active_.empty()) {
+      SealActive();
+    }
+    if (pending_length_ > 0 &&
+        (flush || esp_timer_get_time() - last_event_us_ >= kArchiveIdleFlushUs)) {
+      WritePending();
+    }
+    buffered_events_.store(active_.count() + pending_count_);
+  }
+}
+
+void TimelineArchive::Collect() {
+  TimelineEvent batch[kBatchSize];
+  for (;;) {
+    size_t lost = 0;
+    const size_t copied = read_(&cursor_, batch, kBatchSize, &lost, read_context_);
+    if (lost > 0) {
+      lost_since_seal_ += static_cast<uint32_t>(lost);
+      std::lock_guard<std::mutex> lock(mutex_);
+      events_lost_ += static_cast<uint32_t>(lost);
+    }
+    for (size_t i = 0; i < copied; ++i) {
+      if (batch[i].timestamp_us > last_event_us_) {
+        last_event_us_ = batch[i].timestamp_us;
+      }
+      if (!active_.Add(batch[i])) {
+        SealActive();
+        active_.Add(batch[i]);
+      }
+    }
+    if (copied < kBatchSize) {
+      return;
+    }
+  }
+}
+
+void TimelineArchive::SealActive() {
+  if (pending_length_ > 0) {
+    WritePending();  // Both buffers full: no quiet moment came, write now
+  }
+  pending_count_ = active_.count();
+  pending_length_ = active_.Finish(next_sequence_++, log_.current_boot(), lost_since_seal_);
+  lost_since_seal_ = 0;
+  active_index_ ^= 1U;
+  active_ = SegmentEncoder(buffers_[active_index_].get(), kSegmentSize);
+}
+
+void TimelineArchive::WritePending() {
+  const uint8_t* pending = buffers_[active_index_ ^ 1U].get();
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (log_.Append(pending, pending_length_)) {
+    ++segments_written_;
+    events_archived_ += static_cast<uint32_t>(pending_count_);
+  } else {
+    ++write_errors_;
+  }
+  pending_length_ = 0;
+  pending_count_ = 0;
+}
+
+}  // namespace timeline
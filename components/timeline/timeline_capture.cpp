@@ -0,0 +1,144 @@
+#include "timeline/timeline_capture.hpp"
+
+#include <cstring>
+
+namespace timeline {
+
+const char* CaptureTriggerName(CaptureTrigger trigger) {
+  switch (trigger) {
+    case CaptureTrigger::kManual:
+      return "manual";
+    case CaptureTrigger::kLateElement:
+      return "late";
+    case CaptureTrigger::kIsrQueueOverflow:
+      return "isr_overflow";
+    case CaptureTrigger::kRemoteQueueFull:
+      return "remote_queue";
+    case CaptureTrigger::kAudioUnderrun:
+      return "audio_underrun";
+  }
+  return "unknown";
+}
+
+void TimelineCapture::Configure(const CaptureConfig& config) {
+  CaptureConfig clamped = config;
+  if (clamped.pre_ms > kCaptureMaxWindowMs) {
+    clamped.pre_ms = kCaptureMaxWindowMs;
+  }
+  if (clamped.post_ms > kCaptureMaxWindowMs - clamped.pre_ms) {
+    clamped.post_ms = kCaptureMaxWindowMs - clamped.pre_ms;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  config_ = clamped;
+}
+
+CaptureConfig TimelineCapture::config() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return config_;
+}
+
+bool TimelineCapture::Trigger(CaptureTrigger trigger, int64_t timestamp_us) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (trigger != CaptureTrigger::kManual && (config_.trigger_mask & CaptureTriggerBit(trigger)) == 0) {
+    return false;
+  }
+  if (pending_) {
+    ++missed_triggers_;
+    return false;
+  }
+  pending_ = true;
+  pending_info_ = CaptureInfo{};
+  pending_info_.id = next_id_++;
+  pending_info_.trigger = trigger;
+  pending_info_.trigger_us = timestamp_us;
+  pending_info_.pre_ms = config_.pre_ms;
+  pending_info_.post_ms = config_.post_ms;
+  return true;
+}
+
+bool TimelineCapture::pending() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return pending_;
+}
+
+bool TimelineCapture::TakeDue(int64_t now_us, CaptureInfo* info) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!pending_ ||
+      now_us < pending_info_.trigger_us + static_cast<int64_t>(pending_info_.post_ms) * 1000) {
+    return false;
+  }
+  // Cleared here: triggers during the (slow) copy start the next capture
+  pending_ = false;
+  *info = pending_info_;
+  return true;
+}
+
+void TimelineCapture::Store(const CaptureInfo& info, const uint8_t* segment) {
+  std::unique_ptr<uint8_t[]> data;
+  CaptureInfo stored = info;
+  if (stored.length > 0) {
+    data.reset(new (std::nothrow) uint8_t[stored.length]);
+    if (data) {
+      std::memcpy(data.get(), segment, stored.length);
+    } else {
+      stored.length = 0;
+    }
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  Slot& slot = slots_[next_slot_];
+  slot.info = stored;
+  slot.data = std::move(data);
+  next_slot_ = (next_slot_ + 1 < kMaxCaptures) ? next_slot_ + 1 : 0;
+}
+
+size_t TimelineCapture::List(CaptureInfo* out, size_t max) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t count = 0;
+  for (size_t i = 0; i < kMaxCaptures && count < max; ++i) {
+    size_t index = next_slot_ + i;
+    if (index >= kMaxCaptures) {
+      index -= kMaxCaptures;
+    }
+    if (slots_[index].info.id != 0) {
+      out[count++] = slots_[index].info;
+    }
+  }
+  return count;
+}
+
+size_t TimelineCapture::Read(uint32_t id, uint8_t* out, CaptureInfo* info) const {
+  if (info != nullptr) {
+    *info = CaptureInfo{};
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const Slot& slot : slots_) {
+    if (id == 0 || slot.info.id != id) {
+      continue;
+    }
+    if (info != nullptr) {
+      *info = slot.info;
+    }
+    if (!slot.data) {
+      return 0;
+    }
+    std::memcpy(out, slot.data.get(), slot.info.length);
+    return slot.info.length;
+  }
+  return 0;
+}
+
+void TimelineCapture::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (Slot& slot : slots_) {
+    slot.info = CaptureInfo{};
+    slot.data.reset();
+  }
+  next_slot_ = 0;
+}
+
+uint32_t TimelineCapture::missed_triggers() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return missed_triggers_;
+}
+
+}  // namespace timeline
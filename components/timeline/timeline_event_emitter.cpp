@@ -17,7 +17,7 @@ constexpr const char* TAG = "TimelineEmitter";
 }  // namespace
 
 // Constructor: Store injected EventLogger pointer
-TimelineEventEmitter::TimelineEventEmitter(EventLogger<1024>* event_logger)
+TimelineEventEmitter::TimelineEventEmitter(EventLogger<kTimelineCapacity>* event_logger)
     : event_logger_(event_logger) {
   // No validation - caller must ensure event_logger is valid
 }
@@ -0,0 +1,71 @@
+#include "timeline/timeline_feed.hpp"
+
+namespace timeline {
+
+namespace {
+
+void PutU16(uint8_t* out, uint16_t value) {
+  out[0] = static_cast<uint8_t>(value);
+  out[1] = static_cast<uint8_t>(value >> 8);
+}
+
+void PutU32(uint8_t* out, uint32_t value) {
+  PutU16(out, static_cast<uint16_t>(value));
+  PutU16(out + 2, static_cast<uint16_t>(value >> 16));
+}
+
+void PutI64(uint8_t* out, int64_t value) {
+  const uint64_t bits = static_cast<uint64_t>(value);
+  PutU32(out, static_cast<uint32_t>(bits));
+  PutU32(out + 4, static_cast<uint32_t>(bits >> 32));
+}
+
+}  // namespace
+
+FeedWriter::FeedWriter(uint8_t* buffer, size_t buffer_size)
+    : buffer_(buffer),
+      header_fits_(buffer != nullptr && buffer_size >= kFeedHeaderSize),
+      capacity_(header_fits_ ? (buffer_size - kFeedHeaderSize) / kFeedRecordSize : 0) {
+  // Header count is 16 bits
+  if (capacity_ > UINT16_MAX) {
+    capacity_ = UINT16_MAX;
+  }
+}
+
+bool FeedWriter::Add(const TimelineEvent& event) {
+  if (full_) {
+    return false;
+  }
+  if (count_ == 0) {
+    base_us_ = event.timestamp_us;
+  }
+  const int64_t delta_us = event.timestamp_us - base_us_;
+  if (count_ >= capacity_ || delta_us < 0 || delta_us > static_cast<int64_t>(UINT32_MAX)) {
+    full_ = true;
+    return false;
+  }
+
+  uint8_t* record = buffer_ + kFeedHeaderSize + count_ * kFeedRecordSize;
+  PutU32(record, static_cast<uint32_t>(delta_us));
+  record[4] = static_cast<uint8_t>(event.type);
+  record[5] = static_cast<uint8_t>(event.arg1 > UINT8_MAX ? UINT8_MAX : event.arg1);
+  PutU16(record + 6, static_cast<uint16_t>(event.arg0 > UINT16_MAX ? UINT16_MAX : event.arg0));
+  ++count_;
+  return true;
+}
+
+size_t FeedWriter::Finish(int64_t server_time_us, uint32_t dropped_count) {
+  if (!header_fits_) {
+    return 0;
+  }
+  PutU32(buffer_, kFeedMagic);
+  PutU16(buffer_ + 4, kFeedVersion);
+  PutU16(buffer_ + 6, static_cast<uint16_t>(count_));
+  PutI64(buffer_ + 8, base_us_);
+  PutI64(buffer_ + 16, server_time_us);
+  PutU32(buffer_ + 24, dropped_count);
+  PutU32(buffer_ + 28, 0);
+  return FeedPageSize(count_);
+}
+
+}  // namespace timeline
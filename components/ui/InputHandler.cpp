@@ -4,13 +4,17 @@
  */
 
 #include "InputHandler.hpp"
+#include "app/usb_early_init.hpp"
 #include "tinyusb_cdc_acm.h"
 #include <cstring>
 
 namespace ui {
 
-// USB-CDC port for console (COM7) - already initialized in usb_early_init.cpp
-static constexpr tinyusb_cdcacm_itf_t CONSOLE_CDC_PORT = TINYUSB_CDC_ACM_1;
+// USB-CDC port for console (COM7, or the single CDC port with the HID keyboard) -
+// chosen and initialized in usb_early_init.cpp
+static tinyusb_cdcacm_itf_t ConsoleCdcPort() {
+    return static_cast<tinyusb_cdcacm_itf_t>(usb_service_cdc_port());
+}
 
 SerialConsole::InputHandler::InputHandler(SerialConsole& console)
     : console_(console) {
@@ -25,21 +29,21 @@ void SerialConsole::InputHandler::init() {
 
 void SerialConsole::InputHandler::echo(char c) {
     if (echoEnabled_) {
-        tinyusb_cdcacm_write_queue(CONSOLE_CDC_PORT, reinterpret_cast<const uint8_t*>(&c), 1);
-        tinyusb_cdcacm_write_flush(CONSOLE_CDC_PORT, 0);  // Non-blocking flush
+        tinyusb_cdcacm_write_queue(ConsoleCdcPort(), reinterpret_cast<const uint8_t*>(&c), 1);
+        tinyusb_cdcacm_write_flush(ConsoleCdcPort(), 0);  // Non-blocking flush
     }
 }
 
 void SerialConsole::InputHandler::write(const std::string& str) {
-    tinyusb_cdcacm_write_queue(CONSOLE_CDC_PORT,
+    tinyusb_cdcacm_write_queue(ConsoleCdcPort(),
                                reinterpret_cast<const uint8_t*>(str.c_str()),
                                str.length());
-    tinyusb_cdcacm_write_flush(CONSOLE_CDC_PORT, 0);  // Non-blocking flush
+    tinyusb_cdcacm_write_flush(ConsoleCdcPort(), 0);  // Non-blocking flush
 }
 
 int SerialConsole::InputHandler::readChar(char& c) {
     size_t rx_size = 0;
-    esp_err_t err = tinyusb_cdcacm_read(CONSOLE_CDC_PORT,
+    esp_err_t err = tinyusb_cdcacm_read(ConsoleCdcPort(),
                                         reinterpret_cast<uint8_t*>(&c),
                                         1,
                                         &rx_size);
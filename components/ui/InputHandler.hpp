@@ -3,7 +3,7 @@
  * @brief Input handler for serial console - processes keyboard input and line editing
  *
  * Nested class of SerialConsole. Handles:
- * - Character input from USB-CDC (TINYUSB_CDC_ACM_1 / COM7)
+ * - Character input from the USB-CDC console port (COM7, see usb_service_cdc_port())
  * - Line editing (backspace, Ctrl+C)
  * - Command history navigation (arrow keys)
  * - Echo and prompt display
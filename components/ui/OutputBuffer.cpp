@@ -4,12 +4,16 @@
  */
 
 #include "OutputBuffer.hpp"
+#include "app/usb_early_init.hpp"
 #include "tinyusb_cdc_acm.h"
 
 namespace ui {
 
-// USB-CDC port for console (COM7) - already initialized in usb_early_init.cpp
-static constexpr tinyusb_cdcacm_itf_t CONSOLE_CDC_PORT = TINYUSB_CDC_ACM_1;
+// USB-CDC port for console (COM7, or the single CDC port with the HID keyboard) -
+// chosen and initialized in usb_early_init.cpp
+static tinyusb_cdcacm_itf_t ConsoleCdcPort() {
+    return static_cast<tinyusb_cdcacm_itf_t>(usb_service_cdc_port());
+}
 
 SerialConsole::OutputBuffer::OutputBuffer() = default;
 
@@ -26,7 +30,7 @@ void SerialConsole::OutputBuffer::addLine(const std::string& line) {
 
 void SerialConsole::OutputBuffer::dump() const {
     const char* header = "\r\n--- Output Buffer ---\r\n";
-    tinyusb_cdcacm_write_queue(CONSOLE_CDC_PORT,
+    tinyusb_cdcacm_write_queue(ConsoleCdcPort(),
                                reinterpret_cast<const uint8_t*>(header),
                                strlen(header));
 
@@ -35,17 +39,17 @@ void SerialConsole::OutputBuffer::dump() const {
     for (size_t i = 0; i < count_; i++) {
         size_t idx = (start + i) % BUF_LINES;
         const auto& line = buffer_[idx];
-        tinyusb_cdcacm_write_queue(CONSOLE_CDC_PORT,
+        tinyusb_cdcacm_write_queue(ConsoleCdcPort(),
                                    reinterpret_cast<const uint8_t*>(line.c_str()),
                                    line.length());
     }
 
     const char* footer = "--- End Buffer ---\r\n";
-    tinyusb_cdcacm_write_queue(CONSOLE_CDC_PORT,
+    tinyusb_cdcacm_write_queue(ConsoleCdcPort(),
                                reinterpret_cast<const uint8_t*>(footer),
                                strlen(footer));
 
-    tinyusb_cdcacm_write_flush(CONSOLE_CDC_PORT, 0);  // Non-blocking flush
+    tinyusb_cdcacm_write_flush(ConsoleCdcPort(), 0);  // Non-blocking flush
 }
 
 } // namespace ui
@@ -44,7 +44,8 @@ std::vector<config::Parameter*> GetParameterList(config::ParameterRegistry* regi
     // If prefix is empty, get all visible parameters by trying common prefixes
     if (prefix.empty()) {
         std::vector<config::Parameter*> all_params;
-        const char* subsystems[] = {"general", "keying", "audio", "wifi", "paddle", "tx", "remote", "server"};
+        const char* subsystems[] = {"general", "keying", "audio", "wifi", "paddle", "tx",
+                                    "remote", "server", "so2r"};
 
         for (const char* subsystem : subsystems) {
             auto params = registry->GetVisibleParameters(subsystem, config);
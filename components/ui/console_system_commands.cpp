@@ -9,9 +9,18 @@
 #include "remote/remote_cw_client.hpp"
 #include "remote/remote_cw_server.hpp"
 #include "keying_subsystem/keying_subsystem.hpp"
+#include "audio_subsystem/audio_subsystem.hpp"
+#include "keying/deadline_monitor.hpp"
+#include "keying/paddle_memory.hpp"
+#include "timeline/edge_stream.hpp"
+#include "timeline/timeline_archive.hpp"
+#include "timeline/timeline_capture.hpp"
 #include "morse_decoder/morse_decoder.hpp"
 #include "morse_decoder/adaptive_timing_classifier.hpp"
+#include "system_monitor/heap_trace.hpp"
+#include "system_monitor/task_topology.hpp"
 #include "system_monitor/system_monitor.hpp"
+#include "usb_hid/hid_keyer_port.hpp"
 #include "esp_log.h"
 #include "esp_system.h"
 #include "esp_timer.h"
@@ -19,6 +28,7 @@
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
 #include <inttypes.h>
+#include <cstdlib>
 
 // Include auto-generated logging tags list
 // This file is generated by tools/generate_log_tags.py during build
@@ -40,9 +50,21 @@ static remote::RemoteCwServer* g_remote_server = nullptr;
 // Global keying subsystem instance (set via SetKeyingSubsystem())
 static keying_subsystem::KeyingSubsystem* g_keying_subsystem = nullptr;
 
+// Config storage (for paddle memory persistence)
+static config::Storage* g_config_storage = nullptr;
+
 // Global morse decoder instance (set via SetMorseDecoder())
 static morse_decoder::MorseDecoder* g_morse_decoder = nullptr;
 
+// Flash timeline archive (set by TimelineArchivePhase; nullptr when disabled)
+static timeline::TimelineArchive* g_timeline_archive = nullptr;
+
+// Audio subsystem (set by AudioSubsystemPhase; nullptr when audio init failed)
+static audio_subsystem::AudioSubsystem* g_audio_subsystem = nullptr;
+
+// USB HID keyboard output (set by SubsystemCreationPhase; nullptr when general.usb_hid is off)
+static usb_hid::HidKeyerPort* g_usb_hid_keyer = nullptr;
+
 //=============================================================================
 // Reboot Command
 //=============================================================================
@@ -386,6 +408,32 @@ int HandleFactoryResetCommand(const std::vector<std::string>& args) {
 // Remote Command
 //=============================================================================
 
+// Session link profile plus PING RTT/jitter recorded under each profile
+template <typename Endpoint>
+static void PrintLinkProfileStats(const Endpoint& endpoint, remote::LinkProfile session) {
+    g_console_instance->Printf("Profile: %s\r\n", remote::LinkProfileName(session));
+    for (size_t i = 0; i < remote::kLinkProfileCount; ++i) {
+        const auto profile = static_cast<remote::LinkProfile>(i);
+        const remote::RttSummary rtt = endpoint.GetRttSummary(profile);
+        if (rtt.samples == 0) {
+            g_console_instance->Printf("  RTT %-11s: no samples\r\n", remote::LinkProfileName(profile));
+            continue;
+        }
+        g_console_instance->Printf("  RTT %-11s: %lu samples, mean %lu.%lu ms, min %lu.%lu ms, "
+                                   "max %lu.%lu ms, jitter %lu.%lu ms\r\n",
+                                   remote::LinkProfileName(profile),
+                                   static_cast<unsigned long>(rtt.samples),
+                                   static_cast<unsigned long>(rtt.mean_us / 1000),
+                                   static_cast<unsigned long>((rtt.mean_us % 1000) / 100),
+                                   static_cast<unsigned long>(rtt.min_us / 1000),
+                                   static_cast<unsigned long>((rtt.min_us % 1000) / 100),
+                                   static_cast<unsigned long>(rtt.max_us / 1000),
+                                   static_cast<unsigned long>((rtt.max_us % 1000) / 100),
+                                   static_cast<unsigned long>(rtt.jitter_us / 1000),
+                                   static_cast<unsigned long>((rtt.jitter_us % 1000) / 100));
+    }
+}
+
 int HandleRemoteCommand(const std::vector<std::string>& args) {
     if (!g_console_instance) {
         ESP_LOGE(TAG, "remote: console instance is null");
@@ -478,6 +526,7 @@ int HandleRemoteCommand(const std::vector<std::string>& args) {
                 g_console_instance->Print("Latency: Measuring...\r\n");
             }
         }
+        PrintLinkProfileStats(*g_remote_client, g_remote_client->GetSessionProfile());
 
         g_console_instance->Print("\r\n");
         return 0;
@@ -569,6 +618,7 @@ int HandleServerCommand(const std::vector<std::string>& args) {
                 g_console_instance->Print("Unknown\r\n");
                 break;
         }
+        PrintLinkProfileStats(*g_remote_server, g_remote_server->session_profile());
 
         g_console_instance->Print("\r\n");
         return 0;
@@ -605,6 +655,22 @@ void SetKeyingSubsystem(keying_subsystem::KeyingSubsystem* keying) {
     }
 }
 
+void SetConfigStorage(config::Storage* storage) {
+    g_config_storage = storage;
+}
+
+void SetTimelineArchive(timeline::TimelineArchive* archive) {
+    g_timeline_archive = archive;
+}
+
+void SetAudioSubsystem(audio_subsystem::AudioSubsystem* audio) {
+    g_audio_subsystem = audio;
+}
+
+void SetUsbHidKeyer(usb_hid::HidKeyerPort* port) {
+    g_usb_hid_keyer = port;
+}
+
 void SetMorseDecoder(morse_decoder::MorseDecoder* decoder) {
     g_morse_decoder = decoder;
     if (decoder) {
@@ -643,6 +709,501 @@ int HandleKeyingDebugCommand(const std::vector<std::string>& args) {
     return 0;
 }
 
+//=============================================================================
+// SO2R Command
+//=============================================================================
+
+int HandleSo2rCommand(const std::vector<std::string>& args) {
+    if (!g_console_instance) {
+        ESP_LOGE(TAG, "so2r: console instance is null");
+        return -1;
+    }
+
+    if (!g_keying_subsystem) {
+        g_console_instance->Print("Error: Keying subsystem not initialized\r\n");
+        return -1;
+    }
+
+    const keying::KeyingChannelRouter& channels = g_keying_subsystem->GetChannels();
+
+    if (args.size() == 3 && args[1] == "focus") {
+        const int radio = atoi(args[2].c_str());
+        if (radio < 1 || static_cast<size_t>(radio) > channels.channel_count()) {
+            g_console_instance->Printf("Error: radio must be 1-%u\r\n",
+                                       static_cast<unsigned>(channels.channel_count()));
+            return -1;
+        }
+        if (!g_keying_subsystem->RequestFocus(static_cast<uint8_t>(radio - 1))) {
+            g_console_instance->Print("Error: focus request dropped (queue full)\r\n");
+            return -1;
+        }
+        g_console_instance->Printf("Focus -> radio %d\r\n", radio);
+        return 0;
+    }
+
+    if (args.size() != 1) {
+        g_console_instance->Print("Usage: so2r [focus <radio>]\r\n");
+        return -1;
+    }
+
+    g_console_instance->Printf("SO2R: %u channel(s), focus on radio %u\r\n",
+                               static_cast<unsigned>(channels.channel_count()),
+                               static_cast<unsigned>(channels.focus()) + 1U);
+    for (size_t i = 0; i < channels.channel_count(); ++i) {
+        g_console_instance->Printf("  radio %u: %s, %u WPM%s\r\n",
+                                   static_cast<unsigned>(i) + 1U,
+                                   channels.key_active(i) ? "KEYED" : "idle",
+                                   static_cast<unsigned>(channels.engine(i).speed_wpm()),
+                                   i == channels.focus() ? " [focus]" : "");
+    }
+    return 0;
+}
+
+//=============================================================================
+// Paddle Memory Command
+//=============================================================================
+
+namespace {
+
+// Parse a 1-based message slot; prints the error itself
+bool ParseMemorySlot(const std::string& text, size_t* slot) {
+    const int value = atoi(text.c_str());
+    if (value < 1 || static_cast<size_t>(value) > config::Storage::kPaddleMemorySlots) {
+        g_console_instance->Printf("Error: slot must be 1-%u\r\n",
+                                   static_cast<unsigned>(config::Storage::kPaddleMemorySlots));
+        return false;
+    }
+    *slot = static_cast<size_t>(value);
+    return true;
+}
+
+}  // namespace
+
+int HandleMemoryCommand(const std::vector<std::string>& args) {
+    if (!g_console_instance) {
+        ESP_LOGE(TAG, "memory: console instance is null");
+        return -1;
+    }
+    if (!g_keying_subsystem || !g_config_storage) {
+        g_console_instance->Print("Error: Keying subsystem not initialized\r\n");
+        return -1;
+    }
+
+    const std::string action = args.size() > 1 ? args[1] : "";
+    size_t slot = 0;
+    uint8_t stream[keying::kPaddleMemoryMaxBytes];
+
+    if (args.size() == 1) {
+        g_console_instance->Printf("Paddle memory: %s\r\n",
+                                   g_keying_subsystem->IsRecordingMemory() ? "RECORDING" :
+                                   g_keying_subsystem->IsPlayingMemory() ? "PLAYING" : "idle");
+        for (size_t i = 1; i <= config::Storage::kPaddleMemorySlots; ++i) {
+            size_t size = 0;
+            if (g_config_storage->LoadPaddleMemory(i, stream, sizeof(stream), &size) == ESP_OK) {
+                int64_t duration_us = 0;
+                timeline::ValidateEdgeStream(stream, size, &duration_us);
+                g_console_instance->Printf("  F%u: %u bytes, %u edges, %.1f s\r\n",
+                                           static_cast<unsigned>(i), static_cast<unsigned>(size),
+                                           static_cast<unsigned>(timeline::EdgeStreamReader(stream, size).count()),
+                                           static_cast<double>(duration_us) / 1e6);
+            }
+        }
+        return 0;
+    }
+
+    if (action == "record" && args.size() == 2) {
+        if (!g_keying_subsystem->StartMemoryRecording()) {
+            g_console_instance->Print("Error: a memory is playing\r\n");
+            return -1;
+        }
+        g_console_instance->Print("Recording... key the message, then 'memory save <slot>'\r\n");
+        return 0;
+    }
+
+    if (action == "save" && args.size() == 3) {
+        if (!ParseMemorySlot(args[2], &slot)) {
+            return -1;
+        }
+        const size_t size = g_keying_subsystem->StopMemoryRecording(stream, sizeof(stream));
+        if (size == 0) {
+            g_console_instance->Print("Error: nothing recorded (use 'memory record' first)\r\n");
+            return -1;
+        }
+        if (g_config_storage->SavePaddleMemory(slot, stream, size) != ESP_OK) {
+            g_console_instance->Print("Error: failed to save to flash\r\n");
+            return -1;
+        }
+        g_console_instance->Printf("Saved F%u (%u bytes)\r\n", static_cast<unsigned>(slot),
+                                   static_cast<unsigned>(size));
+        return 0;
+    }
+
+    if (action == "play" && (args.size() == 3 || args.size() == 4)) {
+        if (!ParseMemorySlot(args[2], &slot)) {
+            return -1;
+        }
+        const int speed_pct = args.size() == 4 ? atoi(args[3].c_str()) : 100;
+        if (speed_pct < keying::kPaddleMemoryMinSpeedPct ||
+            speed_pct > keying::kPaddleMemoryMaxSpeedPct) {
+            g_console_instance->Printf("Error: speed must be %u-%u%%\r\n",
+                                       static_cast<unsigned>(keying::kPaddleMemoryMinSpeedPct),
+                                       static_cast<unsigned>(keying::kPaddleMemoryMaxSpeedPct));
+            return -1;
+        }
+        size_t size = 0;
+        if (g_config_storage->LoadPaddleMemory(slot, stream, sizeof(stream), &size) != ESP_OK) {
+            g_console_instance->Printf("Error: F%u has no recording\r\n", static_cast<unsigned>(slot));
+            return -1;
+        }
+        if (!g_keying_subsystem->PlayMemory(stream, size, static_cast<uint16_t>(speed_pct))) {
+            g_console_instance->Print("Error: busy or invalid recording\r\n");
+            return -1;
+        }
+        g_console_instance->Printf("Playing F%u at %d%%\r\n", static_cast<unsigned>(slot), speed_pct);
+        return 0;
+    }
+
+    if (action == "stop" && args.size() == 2) {
+        if (g_keying_subsystem->IsRecordingMemory()) {
+            g_keying_subsystem->StopMemoryRecording(nullptr, 0);
+            g_console_instance->Print("Recording discarded\r\n");
+        } else {
+            g_keying_subsystem->AbortMemoryPlayback();
+            g_console_instance->Print("Playback stopped\r\n");
+        }
+        return 0;
+    }
+
+    if (action == "erase" && args.size() == 3) {
+        if (!ParseMemorySlot(args[2], &slot)) {
+            return -1;
+        }
+        if (g_config_storage->ErasePaddleMemory(slot) != ESP_OK) {
+            g_console_instance->Print("Error: failed to erase\r\n");
+            return -1;
+        }
+        g_console_instance->Printf("Erased F%u recording\r\n", static_cast<unsigned>(slot));
+        return 0;
+    }
+
+    g_console_instance->Print("Usage: memory [record | save <1-10> | play <1-10> [speed%] | stop | erase <1-10>]\r\n");
+    return -1;
+}
+
+//=============================================================================
+// Timeline Archive Command
+//=============================================================================
+
+namespace {
+
+struct ArchiveDumpContext {
+    int64_t since_us;
+    size_t printed;
+};
+
+bool PrintArchiveSegment(const uint8_t* segment, size_t length, void* context) {
+    auto* dump = static_cast<ArchiveDumpContext*>(context);
+    timeline::SegmentDecoder decoder(segment, length);
+    if (decoder.header().lost > 0) {
+        g_console_instance->Printf("  (%" PRIu32 " events lost)\r\n", decoder.header().lost);
+    }
+    timeline::TimelineEvent event{};
+    while (decoder.Next(&event)) {
+        if (event.timestamp_us < dump->since_us) {
+            continue;
+        }
+        g_console_instance->Printf("  %10.6f s  type=%u arg0=0x%04" PRIx32 " arg1=%" PRIu32 "\r\n",
+                                   static_cast<double>(event.timestamp_us) / 1e6,
+                                   static_cast<unsigned>(event.type), event.arg0, event.arg1);
+        ++dump->printed;
+    }
+    return true;
+}
+
+}  // namespace
+
+int HandleArchiveCommand(const std::vector<std::string>& args) {
+    if (!g_console_instance) {
+        ESP_LOGE(TAG, "archive: console instance is null");
+        return -1;
+    }
+    if (!g_timeline_archive) {
+        g_console_instance->Print("Timeline archive disabled (set general timeline_archive true and\r\n"
+                                  "add a 'timeline' data partition)\r\n");
+        return -1;
+    }
+
+    const std::string action = args.size() > 1 ? args[1] : "";
+    if (action.empty()) {
+        const timeline::TimelineArchiveStats stats = g_timeline_archive->GetStats();
+        g_console_instance->Printf("Timeline archive: %u/%u segments (4 KB), boot %u\r\n",
+                                   static_cast<unsigned>(stats.used_slots),
+                                   static_cast<unsigned>(stats.slot_count),
+                                   static_cast<unsigned>(stats.boot));
+        g_console_instance->Printf("  this boot: %.1f - %.1f s archived\r\n",
+                                   static_cast<double>(stats.oldest_us) / 1e6,
+                                   static_cast<double>(stats.newest_us) / 1e6);
+        g_console_instance->Printf("  events: %" PRIu32 " archived, %u buffered, %" PRIu32 " lost\r\n",
+                                   stats.events_archived, static_cast<unsigned>(stats.buffered_events),
+                                   stats.events_lost);
+        g_console_instance->Printf("  segments written: %" PRIu32 ", write errors: %" PRIu32 "\r\n",
+                                   stats.segments_written, stats.write_errors);
+        return 0;
+    }
+
+    if (action == "flush" && args.size() == 2) {
+        g_timeline_archive->RequestFlush();
+        g_console_instance->Print("Buffered events will be written now\r\n");
+        return 0;
+    }
+
+    if (action == "dump" && args.size() <= 3) {
+        const int seconds = args.size() == 3 ? atoi(args[2].c_str()) : 10;
+        if (seconds <= 0) {
+            g_console_instance->Print("Error: seconds must be > 0\r\n");
+            return -1;
+        }
+        const int64_t now_us = esp_timer_get_time();
+        ArchiveDumpContext context{now_us - static_cast<int64_t>(seconds) * 1000000, 0};
+        g_timeline_archive->Export(false, context.since_us, now_us, &PrintArchiveSegment, &context);
+        g_console_instance->Printf("%u archived events (buffered events: 'archive flush' first)\r\n",
+                                   static_cast<unsigned>(context.printed));
+        return 0;
+    }
+
+    g_console_instance->Print("Usage: archive [flush | dump [seconds]]\r\n");
+    return -1;
+}
+
+//=============================================================================
+// Timeline Capture Command
+//=============================================================================
+
+int HandleCaptureCommand(const std::vector<std::string>& args) {
+    if (!g_console_instance) {
+        ESP_LOGE(TAG, "capture: console instance is null");
+        return -1;
+    }
+    if (!g_keying_subsystem) {
+        g_console_instance->Print("Error: Keying subsystem not initialized\r\n");
+        return -1;
+    }
+    timeline::TimelineCapture& capture = g_keying_subsystem->GetTimelineCapture();
+
+    const std::string action = args.size() > 1 ? args[1] : "";
+    if (action.empty()) {
+        const timeline::CaptureConfig config = capture.config();
+        g_console_instance->Printf("Timeline captures: triggers 0x%X, %" PRIu32 " ms before / %" PRIu32
+                                   " ms after, %" PRIu32 " missed%s\r\n",
+                                   static_cast<unsigned>(config.trigger_mask), config.pre_ms,
+                                   config.post_ms, capture.missed_triggers(),
+                                   capture.pending() ? ", one pending" : "");
+        timeline::CaptureInfo captures[timeline::kMaxCaptures];
+        const size_t count = capture.List(captures, timeline::kMaxCaptures);
+        for (size_t i = 0; i < count; ++i) {
+            g_console_instance->Printf("  #%" PRIu32 "  %-14s at %10.6f s  %u events%s\r\n",
+                                       captures[i].id, timeline::CaptureTriggerName(captures[i].trigger),
+                                       static_cast<double>(captures[i].trigger_us) / 1e6,
+                                       static_cast<unsigned>(captures[i].events),
+                                       captures[i].truncated ? " (truncated)" : "");
+        }
+        if (count == 0) {
+            g_console_instance->Print("  (none)\r\n");
+        }
+        return 0;
+    }
+
+    if (action == "now" && args.size() == 2) {
+        if (!capture.Trigger(timeline::CaptureTrigger::kManual, esp_timer_get_time())) {
+            g_console_instance->Print("Error: a capture is already pending\r\n");
+            return -1;
+        }
+        g_console_instance->Print("Capture armed (frozen after the post window)\r\n");
+        return 0;
+    }
+
+    if (action == "dump" && args.size() == 3) {
+        std::unique_ptr<uint8_t[]> segment(new (std::nothrow) uint8_t[timeline::kSegmentSize]);
+        if (!segment) {
+            g_console_instance->Print("Error: out of memory\r\n");
+            return -1;
+        }
+        timeline::CaptureInfo info;
+        const size_t length = capture.Read(static_cast<uint32_t>(strtoul(args[2].c_str(), nullptr, 10)),
+                                           segment.get(), &info);
+        if (info.id == 0) {
+            g_console_instance->Printf("Error: no capture #%s\r\n", args[2].c_str());
+            return -1;
+        }
+        ArchiveDumpContext context{INT64_MIN, 0};
+        PrintArchiveSegment(segment.get(), length, &context);
+        g_console_instance->Printf("%u events, trigger '%s' at %.6f s\r\n",
+                                   static_cast<unsigned>(context.printed),
+                                   timeline::CaptureTriggerName(info.trigger),
+                                   static_cast<double>(info.trigger_us) / 1e6);
+        return 0;
+    }
+
+    if (action == "clear" && args.size() == 2) {
+        capture.Clear();
+        g_console_instance->Print("Captures cleared\r\n");
+        return 0;
+    }
+
+    g_console_instance->Print("Usage: capture [now | dump <id> | clear]\r\n");
+    return -1;
+}
+
+//=============================================================================
+// Sidetone Command
+//=============================================================================
+
+int HandleSidetoneCommand(const std::vector<std::string>& args) {
+    if (!g_console_instance) {
+        ESP_LOGE(TAG, "sidetone: console instance is null");
+        return -1;
+    }
+    if (args.size() > 1) {
+        g_console_instance->Print("Usage: sidetone\r\n");
+        return -1;
+    }
+    if (!g_audio_subsystem || !g_audio_subsystem->IsReady()) {
+        g_console_instance->Print("Error: Audio subsystem not initialized\r\n");
+        return -1;
+    }
+
+    const audio::SidetonePowerStats stats = g_audio_subsystem->GetService().GetPowerStats();
+    const uint64_t fill_avg_us = stats.chunks_pumped > 0 ? stats.fill_us / stats.chunks_pumped : 0;
+    const uint64_t chunks_saved =
+        stats.chunk_period_us > 0 ? static_cast<uint64_t>(stats.powered_down_us) / stats.chunk_period_us : 0;
+
+    g_console_instance->Printf("Sidetone pump: %s\r\n", stats.powered_down ? "powered down" : "running");
+    g_console_instance->Printf("  power-downs: %" PRIu32 ", wakes: %" PRIu32 " (%" PRIu32 " from DMA preload)\r\n",
+                               stats.power_downs, stats.wakes, stats.preloaded_wakes);
+    g_console_instance->Printf("  wake latency: last %" PRIu32 " us, max %" PRIu32 " us\r\n",
+                               stats.last_wake_latency_us, stats.max_wake_latency_us);
+    g_console_instance->Printf("  pumped: %" PRIu64 " chunks, %" PRIu64 " us fill per chunk\r\n",
+                               stats.chunks_pumped, fill_avg_us);
+    g_console_instance->Printf("  powered down: %.1f s, ~%" PRIu64 " chunks (~%" PRIu64 " ms fill) saved\r\n",
+                               static_cast<double>(stats.powered_down_us) / 1e6, chunks_saved,
+                               chunks_saved * fill_avg_us / 1000);
+    return 0;
+}
+
+//=============================================================================
+// USB HID Command
+//=============================================================================
+
+int HandleUsbHidCommand(const std::vector<std::string>& args) {
+    if (!g_console_instance) {
+        ESP_LOGE(TAG, "usbhid: console instance is null");
+        return -1;
+    }
+    const bool reset = args.size() == 2 && args[1] == "reset";
+    if (args.size() > 1 && !reset) {
+        g_console_instance->Print("Usage: usbhid [reset]\r\n");
+        return -1;
+    }
+    if (!g_usb_hid_keyer) {
+        g_console_instance->Print("USB HID keyboard: off (general usb_hid 1|2, then reboot)\r\n");
+        return 0;
+    }
+    if (reset) {
+        g_usb_hid_keyer->ResetStats();
+        g_console_instance->Print("USB HID statistics cleared\r\n");
+        return 0;
+    }
+
+    const usb_hid::HidLatencySummary latency = g_usb_hid_keyer->latency();
+    g_console_instance->Printf("USB HID keyboard: %s, %" PRIu32 " reports, %" PRIu32 " edges dropped\r\n",
+                               usb_hid::HidKeyerModeName(g_usb_hid_keyer->mode()),
+                               g_usb_hid_keyer->reports_sent(), g_usb_hid_keyer->dropped_edges());
+    if (latency.samples == 0) {
+        g_console_instance->Print("  edge-to-host latency: no samples\r\n");
+        return 0;
+    }
+    g_console_instance->Printf("  edge-to-host latency: %" PRIu32 " samples, last %" PRIu32 " us, mean %" PRIu32
+                               " us, min %" PRIu32 " us, max %" PRIu32 " us, %" PRIu32 " over 2 ms\r\n",
+                               latency.samples, latency.last_us, latency.mean_us, latency.min_us,
+                               latency.max_us, latency.over_2ms);
+    return 0;
+}
+
+//=============================================================================
+// Deadline Monitor Command
+//=============================================================================
+
+int HandleDeadlinesCommand(const std::vector<std::string>& args) {
+    if (!g_console_instance) {
+        ESP_LOGE(TAG, "deadlines: console instance is null");
+        return -1;
+    }
+    const bool reset = args.size() == 2 && args[1] == "reset";
+    if (args.size() > 1 && !reset) {
+        g_console_instance->Print("Usage: deadlines [reset]\r\n");
+        return -1;
+    }
+    if (!g_keying_subsystem) {
+        g_console_instance->Print("Error: Keying subsystem not initialized\r\n");
+        return -1;
+    }
+    keying::DeadlineMonitor& monitor = g_keying_subsystem->GetDeadlineMonitor();
+    if (reset) {
+        monitor.Reset();
+        g_console_instance->Print("Deadline statistics cleared\r\n");
+        return 0;
+    }
+
+    g_console_instance->Printf("Keying deadlines (miss > %" PRIu32 " us late):\r\n", monitor.miss_threshold_us());
+    g_console_instance->Print("  edge             edges  misses  mean us   max us   <100 <250 <500  <1m  <2m  <5m <10m >10m\r\n");
+    for (size_t k = 0; k < keying::kDeadlineKindCount; ++k) {
+        const auto kind = static_cast<keying::DeadlineKind>(k);
+        const keying::DeadlineKindStats stats = monitor.Get(kind);
+        g_console_instance->Printf("  %-14s %7" PRIu32 " %7" PRIu32 " %8" PRIu32 " %8" PRIu32 "  ",
+                                   keying::DeadlineKindName(kind), stats.edges, stats.misses,
+                                   stats.mean_late_us, stats.max_late_us);
+        for (size_t b = 0; b < keying::kLatenessBucketCount; ++b) {
+            g_console_instance->Printf(" %4" PRIu32, stats.histogram[b]);
+        }
+        g_console_instance->Print("\r\n");
+    }
+
+    const keying::LoopTiming worst = monitor.worst_loop();
+    g_console_instance->Printf("Main loop: worst %" PRIu32 " us, max wake delay %" PRIu32 " us\r\n",
+                               worst.loop_us, monitor.max_wake_delay_us());
+    g_console_instance->Print("  worst iteration:");
+    for (size_t i = 0; i < keying::kLoopStageCount; ++i) {
+        g_console_instance->Printf(" %s %" PRIu32, keying::LoopStageName(static_cast<keying::LoopStage>(i)),
+                                   worst.stage_us[i]);
+    }
+    g_console_instance->Print("\r\n");
+
+    keying::DeadlineMiss misses[keying::kDeadlineMissLogSize];
+    const size_t count = monitor.Misses(misses, keying::kDeadlineMissLogSize);
+    g_console_instance->Print("Recent misses (newest first):\r\n");
+    if (count == 0) {
+        g_console_instance->Print("  (none)\r\n");
+    }
+    for (size_t i = 0; i < count; ++i) {
+        const keying::DeadlineMiss& miss = misses[i];
+        // Slowest stage of the last loop iteration before the late edge
+        size_t slowest = 0;
+        for (size_t s = 1; s < keying::kLoopStageCount; ++s) {
+            if (miss.last_loop.stage_us[s] > miss.last_loop.stage_us[slowest]) {
+                slowest = s;
+            }
+        }
+        g_console_instance->Printf("  %10.6f s  %-14s R%u  +%" PRIu32 " us  wake %" PRIu32 " us  loop %" PRIu32
+                                   " us (%s %" PRIu32 " us)  task %s\r\n",
+                                   static_cast<double>(miss.planned_us) / 1e6,
+                                   keying::DeadlineKindName(miss.kind), static_cast<unsigned>(miss.channel) + 1,
+                                   miss.late_us, miss.wake_delay_us, miss.last_loop.loop_us,
+                                   keying::LoopStageName(static_cast<keying::LoopStage>(slowest)),
+                                   miss.last_loop.stage_us[slowest], miss.task[0] != '\0' ? miss.task : "?");
+    }
+    return 0;
+}
+
 //=============================================================================
 // Timeline Debug Command
 //=============================================================================
@@ -740,8 +1301,21 @@ int HandleDecoderCommand(const std::vector<std::string>& args) {
         g_console_instance->Printf("Dah/Dit ratio:  %.2f:1\r\n", stats.ratio);
         g_console_instance->Printf("Dit samples:    %u\r\n", stats.dit_sample_count);
         g_console_instance->Printf("Dah samples:    %u\r\n", stats.dah_sample_count);
+        g_console_instance->Printf("Gap averages:   intra=%" PRId64 " char=%" PRId64
+                                   " word=%" PRId64 " μs\r\n",
+                                   stats.avg_intra_gap_us, stats.avg_char_gap_us,
+                                   stats.avg_word_gap_us);
+        g_console_instance->Printf("Thresholds:     dit/dah=%" PRId64 " char=%" PRId64
+                                   " word=%" PRId64 " μs\r\n",
+                                   stats.dit_dah_threshold_us, stats.char_gap_threshold_us,
+                                   stats.word_gap_threshold_us);
         g_console_instance->Printf("Decoder state:  %s\r\n",
                                   g_morse_decoder->IsEnabled() ? "Enabled" : "Disabled");
+        g_console_instance->Printf("Decoding mode:  %s\r\n",
+                                   g_morse_decoder->GetDecodingMode() ==
+                                           morse_decoder::DecodingMode::kBeam
+                                       ? "Beam search"
+                                       : "Greedy");
 
         std::string pattern = g_morse_decoder->GetCurrentPattern();
         if (!pattern.empty()) {
@@ -750,6 +1324,16 @@ int HandleDecoderCommand(const std::vector<std::string>& args) {
             g_console_instance->Print("Current pattern: (none)\r\n");
         }
 
+        const auto fist = g_morse_decoder->GetFistStats();
+        g_console_instance->Printf("Fist:           ratio=%.2f weight=%.1f%% jitter=%.1f%%"
+                                   " gap jitter=%.1f%%\r\n",
+                                   fist.dah_dit_ratio, fist.weighting_percent,
+                                   fist.jitter_percent, fist.gap_jitter_percent);
+        g_console_instance->Printf("Spacing:        char=%.1f word=%.1f units\r\n",
+                                   fist.char_gap_units, fist.word_gap_units);
+        g_console_instance->Printf("Speed:          session=%.1f recent=%.1f WPM (drift %+.1f%%)\r\n",
+                                   fist.session_wpm, fist.window_wpm, fist.speed_drift_percent);
+
         g_console_instance->Print("================================\r\n\r\n");
         return 0;
     }
@@ -874,6 +1458,140 @@ int HandleSystemCommand(const std::vector<std::string>& args) {
     return 0;
 }
 
+//=============================================================================
+// Heap Trace Command
+//=============================================================================
+
+int HandleHeapCommand(const std::vector<std::string>& args) {
+    if (!g_console_instance) {
+        ESP_LOGE(TAG, "heap: console instance is null");
+        return -1;
+    }
+    const std::string action = args.size() == 2 ? args[1] : "";
+    if (args.size() > 2 || (args.size() == 2 && action != "start" && action != "stop" && action != "reset")) {
+        g_console_instance->Print("Usage: heap [start|stop|reset]\r\n");
+        return -1;
+    }
+    if (!system_monitor::HeapTraceAvailable()) {
+        g_console_instance->Print("Heap trace not available (CONFIG_HEAP_USE_HOOKS not enabled)\r\n");
+        return action.empty() ? 0 : -1;
+    }
+    if (action == "start") {
+        if (!system_monitor::HeapTraceStart()) {
+            g_console_instance->Print("Error: out of memory for the trace table\r\n");
+            return -1;
+        }
+        g_console_instance->Print("Heap trace running (blocks allocated before now are not tracked)\r\n");
+        return 0;
+    }
+    if (action == "stop") {
+        system_monitor::HeapTraceStop();
+        g_console_instance->Print("Heap trace stopped\r\n");
+        return 0;
+    }
+    if (action == "reset") {
+        system_monitor::HeapTraceReset();
+        g_console_instance->Print("Heap trace counters cleared\r\n");
+        return 0;
+    }
+
+    // The report is printed after the copy: printing allocates (console is traced too)
+    system_monitor::HeapTraceReport report;
+    system_monitor::HeapTraceGetReport(&report);
+    const system_monitor::HeapInfo heap = system_monitor::SystemMonitor().GetHeapInfo();
+    g_console_instance->Printf("Heap: %" PRIu32 " free, %" PRIu32 " minimum, largest block %" PRIu32 "\r\n",
+                               heap.free_bytes, heap.minimum_free_bytes, heap.largest_free_block);
+    g_console_instance->Printf("Trace: %s, %u live blocks tracked, %" PRIu32 " untracked allocs, %" PRIu32
+                               " frees of older blocks\r\n",
+                               report.running ? "running" : "stopped", static_cast<unsigned>(report.live_blocks),
+                               report.untracked_allocs, report.unknown_frees);
+    g_console_instance->Print("  subsystem      allocs    frees      bytes  live bytes  peak live\r\n");
+    for (size_t i = 0; i < system_monitor::kAllocTagCount; ++i) {
+        const system_monitor::AllocTagStats& stats = report.tags[i];
+        if (stats.allocs == 0) {
+            continue;
+        }
+        const auto tag = static_cast<system_monitor::AllocTag>(i);
+        g_console_instance->Printf("  %-12s %8" PRIu32 " %8" PRIu32 " %10" PRIu64 " %11" PRIu32 " %10" PRIu32 "%s\r\n",
+                                   system_monitor::AllocTagName(tag), stats.allocs, stats.frees,
+                                   stats.alloc_bytes, stats.live_bytes, stats.peak_live_bytes,
+                                   system_monitor::IsFlaggedAllocTag(tag) ? "  !" : "");
+    }
+    g_console_instance->Printf("Allocations on the keying/audio path: %" PRIu32 "\r\n", report.flagged_count);
+    for (size_t i = 0; i < report.flagged_logged; ++i) {
+        g_console_instance->Printf("  %10.6f s  %-6s %" PRIu32 " bytes\r\n",
+                                   static_cast<double>(report.flagged[i].timestamp_us) / 1e6,
+                                   system_monitor::AllocTagName(report.flagged[i].tag), report.flagged[i].size);
+    }
+    return 0;
+}
+
+//=============================================================================
+// Task Topology Command
+//=============================================================================
+
+int HandleTopologyCommand(const std::vector<std::string>& args) {
+    if (!g_console_instance) {
+        ESP_LOGE(TAG, "topology: console instance is null");
+        return -1;
+    }
+    if (args.size() > 1) {
+        g_console_instance->Print("Usage: topology\r\n");
+        return -1;
+    }
+
+    system_monitor::TaskPlacement placement[system_monitor::kTaskIdCount];
+    system_monitor::CoreLoad load;
+    const bool audited = system_monitor::ReadTaskPlacement(placement, &load);
+    const system_monitor::TaskSpec* table = system_monitor::TaskTopology();
+
+    g_console_instance->Print("  task            class         core prio  stack   run core prio   stack free     cpu\r\n");
+    for (size_t i = 0; i < system_monitor::kTaskIdCount; ++i) {
+        const system_monitor::TaskSpec& spec = table[i];
+        const system_monitor::TaskPlacement& actual = placement[i];
+        g_console_instance->Printf("  %-15s %-12s %5d %4u %6" PRIu32, spec.name,
+                                   system_monitor::TaskClassName(spec.task_class), spec.core,
+                                   static_cast<unsigned>(spec.priority), spec.stack_bytes);
+        if (!audited) {
+            g_console_instance->Print("\r\n");
+            continue;
+        }
+        if (!actual.running) {
+            g_console_instance->Print("   not running\r\n");
+            continue;
+        }
+        const bool moved = actual.core != spec.core || actual.priority != spec.priority;
+        g_console_instance->Printf("   %8d %4u%s %10" PRIu32 " %4" PRIu32 ".%" PRIu32 "%%\r\n", actual.core,
+                                   static_cast<unsigned>(actual.priority), moved ? " !" : "  ",
+                                   actual.stack_hwm_bytes, actual.cpu_permille / 10, actual.cpu_permille % 10);
+    }
+    if (!audited) {
+        g_console_instance->Print("Running tasks not available (CONFIG_FREERTOS_USE_TRACE_FACILITY not enabled)\r\n");
+    } else {
+        if (load.cpu_available) {
+            for (int8_t core = 0; core < system_monitor::kTaskCoreCount; ++core) {
+                g_console_instance->Printf("Core %d busy %" PRIu32 ".%" PRIu32 "%% since boot\r\n", core,
+                                           load.busy_permille[core] / 10, load.busy_permille[core] % 10);
+            }
+        }
+        g_console_instance->Printf("Other tasks (system, not in the table): %" PRIu32 "\r\n", load.other_tasks);
+    }
+
+    constexpr size_t kMaxIssues = 8;
+    system_monitor::TopologyIssue issues[kMaxIssues];
+    const size_t found = system_monitor::ValidateTaskTopology(table, system_monitor::kTaskIdCount,
+                                                              configMAX_PRIORITIES, issues, kMaxIssues);
+    if (found == 0) {
+        g_console_instance->Print("Table rules: OK (real-time tasks preempt best-effort and lower-ranked tasks on their core)\r\n");
+    }
+    for (size_t i = 0; i < found && i < kMaxIssues; ++i) {
+        char line[96];
+        system_monitor::FormatTopologyIssue(issues[i], line, sizeof(line));
+        g_console_instance->Printf("Table rule violated: %s\r\n", line);
+    }
+    return 0;
+}
+
 //=============================================================================
 // Upgrade Command (Enter UF2 Bootloader Mode)
 //=============================================================================
@@ -981,6 +1699,55 @@ void RegisterSystemCommands(SerialConsole* console) {
         },
         "keying-debug - Dump paddle engine state for debugging");
 
+    // Register 'so2r' command
+    console->RegisterCommand("so2r",
+        [](const std::vector<std::string>& args) -> int {
+            return HandleSo2rCommand(args);
+        },
+        "so2r [focus <radio>] - Show SO2R keying channels or switch focus");
+
+    // Register 'memory' command
+    console->RegisterCommand("memory",
+        [](const std::vector<std::string>& args) -> int {
+            return HandleMemoryCommand(args);
+        },
+        "memory [record|save|play|stop|erase] - Record and replay paddle memories");
+
+    // Register 'archive' command
+    console->RegisterCommand("archive",
+        [](const std::vector<std::string>& args) -> int {
+            return HandleArchiveCommand(args);
+        },
+        "archive [flush|dump [seconds]] - Flash timeline archive status and export");
+
+    // Register 'capture' command
+    console->RegisterCommand("capture",
+        [](const std::vector<std::string>& args) -> int {
+            return HandleCaptureCommand(args);
+        },
+        "capture [now|dump <id>|clear] - Trigger-based timeline snapshots");
+
+    // Register 'sidetone' command
+    console->RegisterCommand("sidetone",
+        [](const std::vector<std::string>& args) -> int {
+            return HandleSidetoneCommand(args);
+        },
+        "sidetone - Sidetone pump idle power-down and wake latency");
+
+    // Register 'usbhid' command
+    console->RegisterCommand("usbhid",
+        [](const std::vector<std::string>& args) -> int {
+            return HandleUsbHidCommand(args);
+        },
+        "usbhid [reset] - USB HID keyboard output and edge-to-host latency");
+
+    // Register 'deadlines' command
+    console->RegisterCommand("deadlines",
+        [](const std::vector<std::string>& args) -> int {
+            return HandleDeadlinesCommand(args);
+        },
+        "deadlines [reset] - Keying edge lateness, misses and their cause");
+
     // Register 'decoder' command
     console->RegisterCommand("decoder",
         [](const std::vector<std::string>& args) -> int {
@@ -1009,7 +1776,21 @@ void RegisterSystemCommands(SerialConsole* console) {
         },
         "system - Display complete system statistics in JSON format");
 
-    ESP_LOGI(TAG, "Registered system commands: reboot, debug, factory-reset, remote, server, keying-debug, decoder, cpu, tasks, system");
+    // Register 'heap' command
+    console->RegisterCommand("heap",
+        [](const std::vector<std::string>& args) -> int {
+            return HandleHeapCommand(args);
+        },
+        "heap [start|stop|reset] - Heap allocation trace per subsystem");
+
+    // Register 'topology' command
+    console->RegisterCommand("topology",
+        [](const std::vector<std::string>& args) -> int {
+            return HandleTopologyCommand(args);
+        },
+        "topology - Task core pinning, priorities and placement audit");
+
+    ESP_LOGI(TAG, "Registered system commands: reboot, debug, factory-reset, remote, server, keying-debug, so2r, memory, decoder, cpu, tasks, system, heap, topology");
 }
 
 }  // namespace ui
@@ -6,6 +6,8 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <memory>
+#include <new>
 #include <string>
 #include <strings.h>
 
@@ -15,16 +17,28 @@ extern "C" {
 
 #include "app/application_controller.hpp"
 #include "app/bootloader_entry.hpp"
+#include "app/ota_update.hpp"
+#include "keying/deadline_monitor.hpp"
+#include "keying/paddle_memory.hpp"
+#include "keying_subsystem/keying_subsystem.hpp"
 #include "remote/remote_cw_client.hpp"
 #include "remote/remote_cw_server.hpp"
 #include "system_monitor/system_monitor.hpp"
+#include "system_monitor/task_topology.hpp"
 #include "ui/web_assets.hpp"
-#include "morse_decoder/morse_decoder.hpp"
+#include "morse_decoder/decoder_service.hpp"
 #include "text_keyer/text_keyer.hpp"
 #include "system_monitor/system_monitor.hpp"
+#include "timeline/edge_stream.hpp"
+#include "timeline/timeline_feed.hpp"
+#include "timeline/timeline_archive.hpp"
+#include "timeline/timeline_capture.hpp"
 
 extern "C" {
+#include "esp_app_desc.h"
 #include "esp_log.h"
+#include "esp_ota_ops.h"
+#include "esp_system.h"
 }
 
 namespace ui {
@@ -64,6 +78,113 @@ static esp_err_t SendJsonDocument(httpd_req_t* req, cJSON* document) {
   return result;
 }
 
+// Cache policy: content-hashed bundles never change under the same URL, everything
+// else (index.html, unhashed files) is revalidated with its ETag on every use.
+constexpr char kCacheImmutable[] = "public, max-age=31536000, immutable";
+constexpr char kCacheRevalidate[] = "no-cache";
+
+// Vite output directory for JS/CSS chunks (build.assetsDir), served through one route
+constexpr char kBundleRoute[] = "/assets/*";
+
+// Copy a request header into buffer; false when absent or longer than the buffer
+bool GetRequestHeader(httpd_req_t* req, const char* name, char* buffer, size_t buffer_size) {
+  const size_t length = httpd_req_get_hdr_value_len(req, name);
+  if (length == 0 || length >= buffer_size) {
+    return false;
+  }
+  return httpd_req_get_hdr_value_str(req, name, buffer, buffer_size) == ESP_OK;
+}
+
+// Body reader for app::StreamFirmwareUpdate; a slow client gets a few socket timeouts
+// of grace before the transfer is abandoned
+int ReadRequestBody(void* context, char* buffer, size_t length) {
+  auto* req = static_cast<httpd_req_t*>(context);
+  for (int attempt = 0; attempt < 3; ++attempt) {
+    const int received = httpd_req_recv(req, buffer, length);
+    if (received != HTTPD_SOCK_ERR_TIMEOUT) {
+      return received;
+    }
+  }
+  return HTTPD_SOCK_ERR_TIMEOUT;
+}
+
+const char* OtaStatusLine(esp_err_t error) {
+  switch (error) {
+    case ESP_OK: return "200 OK";
+    case ESP_ERR_INVALID_STATE: return "409 Conflict";
+    case ESP_ERR_INVALID_SIZE: return "413 Payload Too Large";
+    case ESP_ERR_INVALID_CRC: return "422 Unprocessable Entity";
+    case ESP_ERR_NOT_FOUND: return "503 Service Unavailable";
+    default: return "500 Internal Server Error";
+  }
+}
+
+// Check a comma-separated header list ("gzip, br;q=1" or "W/\"a\", \"b\"") for a token.
+// Items refused with "q=0" never match; other parameters after ';' and the
+// weak-validator prefix "W/" are ignored.
+bool HeaderListContains(const char* list, std::string_view token) {
+  std::string_view rest(list);
+  while (!rest.empty()) {
+    const size_t comma = rest.find(',');
+    std::string_view item = rest.substr(0, comma);
+    rest = (comma == std::string_view::npos) ? std::string_view() : rest.substr(comma + 1);
+
+    const size_t params = item.find(';');
+    if (params != std::string_view::npos) {
+      const std::string_view quality = item.substr(params + 1);
+      const size_t q = quality.find("q=");
+      if (q != std::string_view::npos && std::strtof(std::string(quality.substr(q + 2)).c_str(),
+                                                      nullptr) <= 0.0f) {
+        continue;
+      }
+      item = item.substr(0, params);
+    }
+    while (!item.empty() && item.front() == ' ') {
+      item.remove_prefix(1);
+    }
+    while (!item.empty() && item.back() == ' ') {
+      item.remove_suffix(1);
+    }
+    if (item.size() > 2 && item[0] == 'W' && item[1] == '/') {
+      item.remove_prefix(2);
+    }
+    if (item == token || item == "*") {
+      return true;
+    }
+  }
+  return false;
+}
+
+// "link": {"profile": "...", "rtt": {"default": {...}, "low_latency": {...}}} of a CWNet endpoint
+template <typename Endpoint>
+void AddLinkProfileJson(cJSON* parent, const Endpoint& endpoint, remote::LinkProfile session) {
+  cJSON* link = cJSON_CreateObject();
+  cJSON* rtt = cJSON_CreateObject();
+  if (link == nullptr || rtt == nullptr) {
+    cJSON_Delete(link);
+    cJSON_Delete(rtt);
+    return;
+  }
+  cJSON_AddStringToObject(link, "profile", remote::LinkProfileName(session));
+  for (size_t i = 0; i < remote::kLinkProfileCount; ++i) {
+    const auto profile = static_cast<remote::LinkProfile>(i);
+    const remote::RttSummary summary = endpoint.GetRttSummary(profile);
+    cJSON* entry = cJSON_CreateObject();
+    if (entry == nullptr) {
+      continue;
+    }
+    cJSON_AddNumberToObject(entry, "samples", static_cast<double>(summary.samples));
+    cJSON_AddNumberToObject(entry, "last_us", static_cast<double>(summary.last_us));
+    cJSON_AddNumberToObject(entry, "min_us", static_cast<double>(summary.min_us));
+    cJSON_AddNumberToObject(entry, "max_us", static_cast<double>(summary.max_us));
+    cJSON_AddNumberToObject(entry, "mean_us", static_cast<double>(summary.mean_us));
+    cJSON_AddNumberToObject(entry, "jitter_us", static_cast<double>(summary.jitter_us));
+    cJSON_AddItemToObject(rtt, remote::LinkProfileName(profile), entry);
+  }
+  cJSON_AddItemToObject(link, "rtt", rtt);
+  cJSON_AddItemToObject(parent, "link", link);
+}
+
 }  // namespace
 
 esp_err_t HttpServer::HandleRoot(httpd_req_t* req) {
@@ -141,8 +262,18 @@ esp_err_t HttpServer::Start() {
   // Configure HTTP server
   httpd_config_t httpd_config = HTTPD_DEFAULT_CONFIG();
   httpd_config.server_port = 80;
-  httpd_config.max_uri_handlers = 50;  // 19 API endpoints + asset routes + margin for future growth
-  httpd_config.stack_size = 4096;      // Sufficient for JSON parsing
+  httpd_config.max_uri_handlers = 61;  // API endpoints + asset routes + margin for future growth
+  // Task placement from the topology table: core 1, below the keying and audio tasks
+  const system_monitor::TaskSpec& httpd_task = system_monitor::TaskSpecFor(system_monitor::TaskId::kHttpd);
+  httpd_config.stack_size = httpd_task.stack_bytes;
+  httpd_config.task_priority = httpd_task.priority;
+  httpd_config.core_id = httpd_task.core;
+  // Browsers keep HTTP/1.1 connections alive between page loads; when all sockets are
+  // taken, close the least recently used idle one instead of refusing new clients
+  httpd_config.lru_purge_enable = true;
+  // Wildcard matching lets one "/assets/*" route serve every code-split bundle chunk
+  // (exact URIs still match exactly)
+  httpd_config.uri_match_fn = httpd_uri_match_wildcard;
   // Note: max header length configured via CONFIG_HTTPD_MAX_REQ_HDR_LEN in sdkconfig.defaults
 
   // Start server
@@ -152,14 +283,26 @@ esp_err_t HttpServer::Start() {
     return err;
   }
 
-  // Register URI handlers
+  // Register URI handlers (counted for the startup log; a failure, e.g. max_uri_handlers
+  // reached, is logged and the server keeps the routes registered so far)
+  int registered = 0;
+  const auto register_route = [this, &registered](const httpd_uri_t* uri) {
+    const esp_err_t reg_err = httpd_register_uri_handler(server_, uri);
+    if (reg_err != ESP_OK) {
+      ESP_LOGE(HttpServer::kLogTag, "  Failed to register %s: %s", uri->uri, esp_err_to_name(reg_err));
+      return false;
+    }
+    ++registered;
+    return true;
+  };
+
   httpd_uri_t uri_root = {
       .uri = "/",
       .method = HTTP_GET,
       .handler = HandleRoot,
       .user_ctx = &context_,
   };
-  httpd_register_uri_handler(server_, &uri_root);
+  register_route(&uri_root);
 
   httpd_uri_t uri_config_page = {
       .uri = "/config",
@@ -167,7 +310,7 @@ esp_err_t HttpServer::Start() {
       .handler = HandleGetConfigPage,
       .user_ctx = &context_,
   };
-  httpd_register_uri_handler(server_, &uri_config_page);
+  register_route(&uri_config_page);
 
   httpd_uri_t uri_timeline = {
       .uri = "/timeline",
@@ -175,7 +318,7 @@ esp_err_t HttpServer::Start() {
       .handler = HandleGetTimeline,
       .user_ctx = &context_,
   };
-  httpd_register_uri_handler(server_, &uri_timeline);
+  register_route(&uri_timeline);
 
   httpd_uri_t uri_remote = {
       .uri = "/remote",
@@ -183,7 +326,7 @@ esp_err_t HttpServer::Start() {
       .handler = HandleGetRemote,
       .user_ctx = &context_,
   };
-  httpd_register_uri_handler(server_, &uri_remote);
+  register_route(&uri_remote);
 
   httpd_uri_t uri_decoder = {
       .uri = "/decoder",
@@ -191,7 +334,7 @@ esp_err_t HttpServer::Start() {
       .handler = HandleGetDecoder,
       .user_ctx = &context_,
   };
-  httpd_register_uri_handler(server_, &uri_decoder);
+  register_route(&uri_decoder);
 
   httpd_uri_t uri_system = {
       .uri = "/system",
@@ -199,7 +342,7 @@ esp_err_t HttpServer::Start() {
       .handler = HandleGetSystem,
       .user_ctx = &context_,
   };
-  httpd_register_uri_handler(server_, &uri_system);
+  register_route(&uri_system);
 
   httpd_uri_t uri_firmware = {
       .uri = "/firmware",
@@ -207,7 +350,7 @@ esp_err_t HttpServer::Start() {
       .handler = HandleGetFirmwarePage,
       .user_ctx = &context_,
   };
-  httpd_register_uri_handler(server_, &uri_firmware);
+  register_route(&uri_firmware);
 
   httpd_uri_t uri_status = {
       .uri = "/api/status",
@@ -215,7 +358,7 @@ esp_err_t HttpServer::Start() {
       .handler = HandleGetStatus,
       .user_ctx = &context_,
   };
-  httpd_register_uri_handler(server_, &uri_status);
+  register_route(&uri_status);
 
   // New endpoints (Task 5.4.2)
   httpd_uri_t uri_schema = {
@@ -224,7 +367,7 @@ esp_err_t HttpServer::Start() {
       .handler = HandleGetSchema,
       .user_ctx = &context_,
   };
-  httpd_register_uri_handler(server_, &uri_schema);
+  register_route(&uri_schema);
 
   httpd_uri_t uri_get_config = {
       .uri = "/api/config",
@@ -232,7 +375,7 @@ esp_err_t HttpServer::Start() {
       .handler = HandleGetConfig,
       .user_ctx = &context_,
   };
-  httpd_register_uri_handler(server_, &uri_get_config);
+  register_route(&uri_get_config);
 
   // Parameter update endpoint (no wildcard needed)
   httpd_uri_t uri_post_param = {
@@ -241,7 +384,7 @@ esp_err_t HttpServer::Start() {
       .handler = HandlePostParameter,
       .user_ctx = &context_,
   };
-  httpd_register_uri_handler(server_, &uri_post_param);
+  register_route(&uri_post_param);
 
   httpd_uri_t uri_save = {
       .uri = "/api/config/save",
@@ -249,7 +392,7 @@ esp_err_t HttpServer::Start() {
       .handler = HandlePostSave,
       .user_ctx = &context_,
   };
-  httpd_register_uri_handler(server_, &uri_save);
+  register_route(&uri_save);
 
   // Remote keying endpoints (Task 6)
   httpd_uri_t uri_remote_status = {
@@ -258,7 +401,7 @@ esp_err_t HttpServer::Start() {
       .handler = HandleGetRemoteStatus,
       .user_ctx = &context_,
   };
-  httpd_register_uri_handler(server_, &uri_remote_status);
+  register_route(&uri_remote_status);
 
   httpd_uri_t uri_client_start = {
       .uri = "/api/remote/client/start",
@@ -266,7 +409,7 @@ esp_err_t HttpServer::Start() {
       .handler = HandlePostClientStart,
       .user_ctx = &context_,
   };
-  httpd_register_uri_handler(server_, &uri_client_start);
+  register_route(&uri_client_start);
 
   httpd_uri_t uri_client_stop = {
       .uri = "/api/remote/client/stop",
@@ -274,7 +417,7 @@ esp_err_t HttpServer::Start() {
       .handler = HandlePostClientStop,
       .user_ctx = &context_,
   };
-  httpd_register_uri_handler(server_, &uri_client_stop);
+  register_route(&uri_client_stop);
 
   httpd_uri_t uri_server_start = {
       .uri = "/api/remote/server/start",
@@ -282,7 +425,7 @@ esp_err_t HttpServer::Start() {
       .handler = HandlePostServerStart,
       .user_ctx = &context_,
   };
-  httpd_register_uri_handler(server_, &uri_server_start);
+  register_route(&uri_server_start);
 
   httpd_uri_t uri_server_stop = {
       .uri = "/api/remote/server/stop",
@@ -290,7 +433,7 @@ esp_err_t HttpServer::Start() {
       .handler = HandlePostServerStop,
       .user_ctx = &context_,
   };
-  httpd_register_uri_handler(server_, &uri_server_stop);
+  register_route(&uri_server_stop);
 
   httpd_uri_t uri_decoder_status = {
       .uri = "/api/decoder/status",
@@ -298,7 +441,7 @@ esp_err_t HttpServer::Start() {
       .handler = HandleGetDecoderStatus,
       .user_ctx = &context_,
   };
-  httpd_register_uri_handler(server_, &uri_decoder_status);
+  register_route(&uri_decoder_status);
 
   httpd_uri_t uri_decoder_enable = {
       .uri = "/api/decoder/enable",
@@ -306,7 +449,31 @@ esp_err_t HttpServer::Start() {
       .handler = HandlePostDecoderEnable,
       .user_ctx = &context_,
   };
-  httpd_register_uri_handler(server_, &uri_decoder_enable);
+  register_route(&uri_decoder_enable);
+
+  httpd_uri_t uri_decoder_stats = {
+      .uri = "/api/decoder/stats",
+      .method = HTTP_GET,
+      .handler = HandleGetDecoderStats,
+      .user_ctx = &context_,
+  };
+  register_route(&uri_decoder_stats);
+
+  httpd_uri_t uri_so2r = {
+      .uri = "/api/so2r",
+      .method = HTTP_GET,
+      .handler = HandleGetSo2r,
+      .user_ctx = &context_,
+  };
+  register_route(&uri_so2r);
+
+  httpd_uri_t uri_so2r_focus = {
+      .uri = "/api/so2r/focus",
+      .method = HTTP_POST,
+      .handler = HandlePostSo2rFocus,
+      .user_ctx = &context_,
+  };
+  register_route(&uri_so2r_focus);
 
   httpd_uri_t uri_timeline_events = {
       .uri = "/api/timeline/events",
@@ -314,7 +481,63 @@ esp_err_t HttpServer::Start() {
       .handler = HandleGetTimelineEvents,
       .user_ctx = &context_,
   };
-  httpd_register_uri_handler(server_, &uri_timeline_events);
+  register_route(&uri_timeline_events);
+
+  httpd_uri_t uri_timeline_feed = {
+      .uri = "/api/timeline/feed",
+      .method = HTTP_GET,
+      .handler = HandleGetTimelineFeed,
+      .user_ctx = &context_,
+  };
+  register_route(&uri_timeline_feed);
+
+  httpd_uri_t uri_timeline_export = {
+      .uri = "/api/timeline/export",
+      .method = HTTP_GET,
+      .handler = HandleGetTimelineExport,
+      .user_ctx = &context_,
+  };
+  register_route(&uri_timeline_export);
+
+  httpd_uri_t uri_timeline_archive = {
+      .uri = "/api/timeline/archive",
+      .method = HTTP_GET,
+      .handler = HandleGetTimelineArchive,
+      .user_ctx = &context_,
+  };
+  register_route(&uri_timeline_archive);
+
+  httpd_uri_t uri_timeline_archive_segments = {
+      .uri = "/api/timeline/archive/segments",
+      .method = HTTP_GET,
+      .handler = HandleGetTimelineArchiveSegments,
+      .user_ctx = &context_,
+  };
+  register_route(&uri_timeline_archive_segments);
+
+  httpd_uri_t uri_timeline_captures = {
+      .uri = "/api/timeline/captures",
+      .method = HTTP_GET,
+      .handler = HandleGetTimelineCaptures,
+      .user_ctx = &context_,
+  };
+  register_route(&uri_timeline_captures);
+
+  httpd_uri_t uri_timeline_captures_post = {
+      .uri = "/api/timeline/captures",
+      .method = HTTP_POST,
+      .handler = HandlePostTimelineCaptures,
+      .user_ctx = &context_,
+  };
+  register_route(&uri_timeline_captures_post);
+
+  httpd_uri_t uri_timeline_capture_data = {
+      .uri = "/api/timeline/captures/data",
+      .method = HTTP_GET,
+      .handler = HandleGetTimelineCaptureData,
+      .user_ctx = &context_,
+  };
+  register_route(&uri_timeline_capture_data);
 
   httpd_uri_t uri_timeline_config = {
       .uri = "/api/timeline/config",
@@ -322,7 +545,7 @@ esp_err_t HttpServer::Start() {
       .handler = HandleGetTimelineConfig,
       .user_ctx = &context_,
   };
-  httpd_register_uri_handler(server_, &uri_timeline_config);
+  register_route(&uri_timeline_config);
 
   // Text keyer endpoints
   httpd_uri_t uri_keyer_page = {
@@ -331,7 +554,7 @@ esp_err_t HttpServer::Start() {
       .handler = HandleGetKeyerPage,
       .user_ctx = &context_,
   };
-  httpd_register_uri_handler(server_, &uri_keyer_page);
+  register_route(&uri_keyer_page);
 
   httpd_uri_t uri_keyer_status = {
       .uri = "/api/keyer/status",
@@ -339,7 +562,7 @@ esp_err_t HttpServer::Start() {
       .handler = HandleGetKeyerStatus,
       .user_ctx = &context_,
   };
-  httpd_register_uri_handler(server_, &uri_keyer_status);
+  register_route(&uri_keyer_status);
 
   httpd_uri_t uri_keyer_send = {
       .uri = "/api/keyer/send",
@@ -347,7 +570,7 @@ esp_err_t HttpServer::Start() {
       .handler = HandlePostKeyerSend,
       .user_ctx = &context_,
   };
-  httpd_register_uri_handler(server_, &uri_keyer_send);
+  register_route(&uri_keyer_send);
 
   httpd_uri_t uri_keyer_message = {
       .uri = "/api/keyer/message",
@@ -355,7 +578,23 @@ esp_err_t HttpServer::Start() {
       .handler = HandlePostKeyerMessage,
       .user_ctx = &context_,
   };
-  httpd_register_uri_handler(server_, &uri_keyer_message);
+  register_route(&uri_keyer_message);
+
+  httpd_uri_t uri_keyer_memory_get = {
+      .uri = "/api/keyer/memory",
+      .method = HTTP_GET,
+      .handler = HandleGetKeyerMemory,
+      .user_ctx = &context_,
+  };
+  register_route(&uri_keyer_memory_get);
+
+  httpd_uri_t uri_keyer_memory_post = {
+      .uri = "/api/keyer/memory",
+      .method = HTTP_POST,
+      .handler = HandlePostKeyerMemory,
+      .user_ctx = &context_,
+  };
+  register_route(&uri_keyer_memory_post);
 
   httpd_uri_t uri_keyer_abort = {
       .uri = "/api/keyer/abort",
@@ -363,7 +602,7 @@ esp_err_t HttpServer::Start() {
       .handler = HandlePostKeyerAbort,
       .user_ctx = &context_,
   };
-  httpd_register_uri_handler(server_, &uri_keyer_abort);
+  register_route(&uri_keyer_abort);
 
   // System monitoring endpoints
   httpd_uri_t uri_system_stats = {
@@ -372,7 +611,7 @@ esp_err_t HttpServer::Start() {
       .handler = HandleGetSystemStats,
       .user_ctx = &context_,
   };
-  httpd_register_uri_handler(server_, &uri_system_stats);
+  register_route(&uri_system_stats);
 
   // Bootloader management endpoints
   httpd_uri_t uri_enter_bootloader = {
@@ -381,17 +620,40 @@ esp_err_t HttpServer::Start() {
       .handler = HandlePostEnterBootloader,
       .user_ctx = &context_,
   };
-  httpd_register_uri_handler(server_, &uri_enter_bootloader);
+  register_route(&uri_enter_bootloader);
+
+  httpd_uri_t uri_firmware_info = {
+      .uri = "/api/firmware/info",
+      .method = HTTP_GET,
+      .handler = HandleGetFirmwareInfo,
+      .user_ctx = &context_,
+  };
+  register_route(&uri_firmware_info);
+
+  httpd_uri_t uri_firmware_upload = {
+      .uri = "/api/firmware/upload",
+      .method = HTTP_POST,
+      .handler = HandlePostFirmwareUpload,
+      .user_ctx = &context_,
+  };
+  register_route(&uri_firmware_upload);
 
   asset_routes_.clear();
   const std::size_t asset_count = assets::Count();
   ESP_LOGI(HttpServer::kLogTag, "Registering %d web assets", static_cast<int>(asset_count));
-  asset_routes_.reserve(asset_count);
+  asset_routes_.reserve(asset_count + 1);
   const assets::Asset* embedded_assets = assets::List();
+  std::size_t bundle_chunks = 0;
   for (std::size_t i = 0; i < asset_count; ++i) {
     const assets::Asset& asset = embedded_assets[i];
     ESP_LOGI(HttpServer::kLogTag, "  Asset %d: %s (%d bytes, %s)",
              static_cast<int>(i), asset.path, static_cast<int>(asset.size), asset.content_type);
+    // Bundle chunks (one per lazily loaded page) share the wildcard route below so
+    // code splitting does not eat into max_uri_handlers
+    if (std::strncmp(asset.path, kBundleRoute, sizeof(kBundleRoute) - 2) == 0) {
+      ++bundle_chunks;
+      continue;
+    }
     httpd_uri_t uri = {
         .uri = asset.path,
         .method = HTTP_GET,
@@ -399,13 +661,24 @@ esp_err_t HttpServer::Start() {
         .user_ctx = &context_,
     };
     asset_routes_.push_back(uri);
-    esp_err_t reg_err = httpd_register_uri_handler(server_, &asset_routes_.back());
-    if (reg_err != ESP_OK) {
-      ESP_LOGE(HttpServer::kLogTag, "  Failed to register %s: %s", asset.path, esp_err_to_name(reg_err));
+    register_route(&asset_routes_.back());
+  }
+  if (bundle_chunks > 0) {
+    httpd_uri_t uri = {
+        .uri = kBundleRoute,
+        .method = HTTP_GET,
+        .handler = HandleGetAsset,
+        .user_ctx = &context_,
+    };
+    asset_routes_.push_back(uri);
+    if (register_route(&asset_routes_.back())) {
+      ESP_LOGI(HttpServer::kLogTag, "  %d bundle chunks served by %s", static_cast<int>(bundle_chunks),
+               kBundleRoute);
     }
   }
 
-  ESP_LOGI(HttpServer::kLogTag, "HTTP server started on port 80 with %d endpoints", 21 + static_cast<int>(asset_routes_.size()));
+  ESP_LOGI(HttpServer::kLogTag, "HTTP server started on port 80 with %d URI handlers (max %d)", registered,
+           static_cast<int>(httpd_config.max_uri_handlers));
   return ESP_OK;
 }
 
@@ -534,12 +807,47 @@ esp_err_t HttpServer::SendAsset(httpd_req_t* req, std::string_view asset_path) {
   }
 
   httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
+  httpd_resp_set_hdr(req, "Cache-Control", asset->immutable ? kCacheImmutable : kCacheRevalidate);
+
+  // Pick the encoding first: each encoded body gets its own ETag, so a cache
+  // revalidating one variant is never handed the other one's body after a 304
+  char header[128];
+  const std::uint8_t* body = asset->data;
+  std::size_t body_size = asset->size;
+  const char* encoding = nullptr;
+  const char* etag_suffix = "";
+  if (asset->br_data != nullptr && GetRequestHeader(req, "Accept-Encoding", header, sizeof(header)) &&
+      HeaderListContains(header, "br")) {
+    encoding = "br";
+    etag_suffix = "-br";
+    body = asset->br_data;
+    body_size = asset->br_size;
+  } else if (asset->compressed) {
+    encoding = "gzip";
+    etag_suffix = "-gz";
+  }
+
+  // Generated ETags are quoted: insert the suffix before the closing quote
+  char etag[80];
+  const std::string_view base(asset->etag);
+  snprintf(etag, sizeof(etag), "%.*s%s\"", static_cast<int>(base.size() - 1), base.data(), etag_suffix);
+  httpd_resp_set_hdr(req, "ETag", etag);
+  if (asset->br_data != nullptr || asset->compressed) {
+    httpd_resp_set_hdr(req, "Vary", "Accept-Encoding");
+  }
+
+  // Revalidation: the browser already holds this exact content
+  if (GetRequestHeader(req, "If-None-Match", header, sizeof(header)) && HeaderListContains(header, etag)) {
+    httpd_resp_set_status(req, "304 Not Modified");
+    return httpd_resp_send(req, nullptr, 0);
+  }
+
   httpd_resp_set_type(req, asset->content_type);
-  if (asset->compressed) {
-    httpd_resp_set_hdr(req, "Content-Encoding", "gzip");
+  if (encoding != nullptr) {
+    httpd_resp_set_hdr(req, "Content-Encoding", encoding);
   }
 
-  return httpd_resp_send(req, reinterpret_cast<const char*>(asset->data), asset->size);
+  return httpd_resp_send(req, reinterpret_cast<const char*>(body), body_size);
 }
 
 esp_err_t HttpServer::SendError(httpd_req_t* req, int status_code, const char* message) {
@@ -615,7 +923,8 @@ esp_err_t HttpServer::HandleGetConfig(httpd_req_t* req) {
   char subsystem_filter[32] = "";
   GetQueryParam(req, "subsystem", subsystem_filter, sizeof(subsystem_filter));
 
-  const char* subsystems[] = {"general", "audio", "keying", "wifi", "hardware", "remote", "server"};
+  const char* subsystems[] = {"general", "audio", "keying", "wifi", "hardware", "remote", "server",
+                              "so2r"};
 
   cJSON* root = cJSON_CreateObject();
   if (root == nullptr) {
@@ -900,6 +1209,7 @@ esp_err_t HttpServer::HandleGetRemoteStatus(httpd_req_t* req) {
     cJSON_AddNumberToObject(client_obj, "server_port", static_cast<double>(server_port));
     cJSON_AddNumberToObject(client_obj, "latency_ms", static_cast<double>(latency_ms));
     cJSON_AddNumberToObject(client_obj, "ptt_tail_base_ms", static_cast<double>(ptt_tail_base_ms));
+    AddLinkProfileJson(client_obj, *client, client->GetSessionProfile());
   } else {
     cJSON_AddNumberToObject(client_obj, "state", 0.0);  // Idle
     cJSON_AddStringToObject(client_obj, "server_host", "");
@@ -926,6 +1236,7 @@ esp_err_t HttpServer::HandleGetRemoteStatus(httpd_req_t* req) {
     cJSON_AddNumberToObject(server_obj, "listen_port", static_cast<double>(listen_port));
     cJSON_AddStringToObject(server_obj, "client_ip", client_ip ? client_ip : "");
     cJSON_AddNumberToObject(server_obj, "ptt_tail_ms", static_cast<double>(ptt_tail_ms));
+    AddLinkProfileJson(server_obj, *server, server->session_profile());
   } else {
     cJSON_AddNumberToObject(server_obj, "state", 0.0);  // Idle
     cJSON_AddNumberToObject(server_obj, "listen_port", 0.0);
@@ -1098,6 +1409,28 @@ esp_err_t HttpServer::HandleGetDecoderStatus(httpd_req_t* req) {
       cJSON_Delete(root);
       return SendError(req, 500, "Failed to build decoder status JSON");
     }
+
+    // Every key stream (local, remote client, remote server) for the split view
+    morse_decoder::DecoderService* service = ctx->app_controller->GetDecoderService();
+    cJSON* streams = cJSON_AddArrayToObject(root, "streams");
+    if (service != nullptr && streams != nullptr) {
+      for (size_t i = 0; i < morse_decoder::kKeySourceCount; ++i) {
+        const auto source = static_cast<morse_decoder::KeySource>(i);
+        morse_decoder::MorseDecoder* stream_decoder = service->GetDecoder(source);
+        cJSON* stream = cJSON_CreateObject();
+        if (stream == nullptr) {
+          cJSON_Delete(root);
+          return SendError(req, 500, "Failed to build decoder status JSON");
+        }
+        cJSON_AddItemToArray(streams, stream);
+        cJSON_AddStringToObject(stream, "source", morse_decoder::DecoderService::SourceName(source));
+        cJSON_AddBoolToObject(stream, "active", service->HasActivity(source));
+        cJSON_AddNumberToObject(stream, "wpm",
+                                static_cast<double>(stream_decoder->GetDetectedWPM()));
+        cJSON_AddStringToObject(stream, "pattern", stream_decoder->GetCurrentPattern().c_str());
+        cJSON_AddStringToObject(stream, "text", stream_decoder->GetDecodedText().c_str());
+      }
+    }
   } else {
     // Decoder not initialized - return safe defaults
     if (cJSON_AddBoolToObject(root, "enabled", cJSON_False) == nullptr ||
@@ -1141,18 +1474,18 @@ esp_err_t HttpServer::HandlePostDecoderEnable(httpd_req_t* req) {
   bool enabled = cJSON_IsTrue(enabled_item);
   cJSON_Delete(body);
 
-  // Get MorseDecoder from ApplicationController
-  morse_decoder::MorseDecoder* decoder = nullptr;
+  // Get DecoderService from ApplicationController
+  morse_decoder::DecoderService* service = nullptr;
   if (ctx->app_controller != nullptr) {
-    decoder = ctx->app_controller->GetMorseDecoder();
+    service = ctx->app_controller->GetDecoderService();
   }
 
-  if (decoder == nullptr) {
+  if (service == nullptr) {
     return SendError(req, 400, "Morse decoder not initialized");
   }
 
-  // Set decoder enabled state
-  decoder->SetEnabled(enabled);
+  // Set enabled state of every stream (local and remote)
+  service->SetEnabled(enabled);
 
   // Build success response
   cJSON* response = cJSON_CreateObject();
@@ -1167,15 +1500,242 @@ esp_err_t HttpServer::HandlePostDecoderEnable(httpd_req_t* req) {
   return SendJsonDocument(req, response);
 }
 
+// SO2R API handlers
+
+esp_err_t HttpServer::HandleGetSo2r(httpd_req_t* req) {
+  auto* ctx = static_cast<HandlerContext*>(req->user_ctx);
+
+  keying_subsystem::KeyingSubsystem* keying = nullptr;
+  if (ctx->app_controller != nullptr) {
+    keying = ctx->app_controller->GetKeyingSubsystem();
+  }
+  if (keying == nullptr) {
+    return SendError(req, 500, "Keying subsystem not initialized");
+  }
+
+  cJSON* root = cJSON_CreateObject();
+  if (root == nullptr) {
+    return SendError(req, 500, "Failed to allocate SO2R JSON");
+  }
+
+  const keying::KeyingChannelRouter& channels = keying->GetChannels();
+  cJSON_AddNumberToObject(root, "channel_count", static_cast<double>(channels.channel_count()));
+  cJSON_AddNumberToObject(root, "focus", static_cast<double>(channels.focus()));
+  cJSON* radios = cJSON_AddArrayToObject(root, "channels");
+  if (radios == nullptr) {
+    cJSON_Delete(root);
+    return SendError(req, 500, "Failed to build SO2R JSON");
+  }
+  for (size_t i = 0; i < channels.channel_count(); ++i) {
+    cJSON* radio = cJSON_CreateObject();
+    if (radio == nullptr) {
+      cJSON_Delete(root);
+      return SendError(req, 500, "Failed to build SO2R JSON");
+    }
+    cJSON_AddItemToArray(radios, radio);
+    cJSON_AddNumberToObject(radio, "channel", static_cast<double>(i));
+    cJSON_AddBoolToObject(radio, "key_active", channels.key_active(i));
+    cJSON_AddNumberToObject(radio, "speed_wpm",
+                            static_cast<double>(channels.engine(i).speed_wpm()));
+  }
+
+  return SendJsonDocument(req, root);
+}
+
+esp_err_t HttpServer::HandlePostSo2rFocus(httpd_req_t* req) {
+  auto* ctx = static_cast<HandlerContext*>(req->user_ctx);
+
+  // Read POST body (JSON: {"channel": 0-based index})
+  char content[64];
+  size_t recv_size = std::min(req->content_len, sizeof(content) - 1);
+  int ret = httpd_req_recv(req, content, recv_size);
+  if (ret <= 0) {
+    if (ret == HTTPD_SOCK_ERR_TIMEOUT) {
+      httpd_resp_send_408(req);
+    }
+    return ESP_FAIL;
+  }
+  content[ret] = '\0';
+
+  cJSON* body = cJSON_ParseWithLength(content, ret);
+  if (body == nullptr) {
+    return SendError(req, 400, "Invalid JSON payload");
+  }
+  const cJSON* channel_item = cJSON_GetObjectItemCaseSensitive(body, "channel");
+  if (!cJSON_IsNumber(channel_item)) {
+    cJSON_Delete(body);
+    return SendError(req, 400, "Missing or invalid 'channel' field in JSON");
+  }
+  const int channel = channel_item->valueint;
+  cJSON_Delete(body);
+
+  keying_subsystem::KeyingSubsystem* keying = nullptr;
+  if (ctx->app_controller != nullptr) {
+    keying = ctx->app_controller->GetKeyingSubsystem();
+  }
+  if (keying == nullptr) {
+    return SendError(req, 500, "Keying subsystem not initialized");
+  }
+  if (channel < 0 || static_cast<size_t>(channel) >= keying->GetChannels().channel_count()) {
+    return SendError(req, 400, "Channel out of range");
+  }
+  if (!keying->RequestFocus(static_cast<uint8_t>(channel))) {
+    return SendError(req, 500, "Focus request dropped");
+  }
+
+  cJSON* response = cJSON_CreateObject();
+  if (response == nullptr) {
+    return SendError(req, 500, "Failed to allocate response JSON");
+  }
+  cJSON_AddBoolToObject(response, "success", cJSON_True);
+  cJSON_AddNumberToObject(response, "focus", static_cast<double>(channel));
+  return SendJsonDocument(req, response);
+}
+
+esp_err_t HttpServer::HandleGetDecoderStats(httpd_req_t* req) {
+  auto* ctx = static_cast<HandlerContext*>(req->user_ctx);
+
+  morse_decoder::DecoderService* service = nullptr;
+  if (ctx->app_controller != nullptr) {
+    service = ctx->app_controller->GetDecoderService();
+  }
+  if (service == nullptr) {
+    return SendError(req, 400, "Morse decoder not initialized");
+  }
+
+  // Optional ?source=local|remote_client|remote_server (default: local)
+  morse_decoder::KeySource source = morse_decoder::KeySource::kLocal;
+  char source_param[24];
+  if (GetQueryParam(req, "source", source_param, sizeof(source_param))) {
+    bool found = false;
+    for (size_t i = 0; i < morse_decoder::kKeySourceCount; ++i) {
+      const auto candidate = static_cast<morse_decoder::KeySource>(i);
+      if (strcmp(source_param, morse_decoder::DecoderService::SourceName(candidate)) == 0) {
+        source = candidate;
+        found = true;
+      }
+    }
+    if (!found) {
+      return SendError(req, 400, "Unknown decoder source");
+    }
+  }
+  morse_decoder::MorseDecoder* decoder = service->GetDecoder(source);
+
+  const morse_decoder::FistStats stats = decoder->GetFistStats();
+
+  cJSON* root = cJSON_CreateObject();
+  if (root == nullptr) {
+    return SendError(req, 500, "Failed to allocate decoder stats JSON");
+  }
+
+  // Derived figures (ratio to two decimals, the rest to one)
+  auto round1 = [](float value) { return std::round(static_cast<double>(value) * 10.0) / 10.0; };
+  cJSON_AddNumberToObject(root, "ratio", std::round(stats.dah_dit_ratio * 100.0) / 100.0);
+  cJSON_AddNumberToObject(root, "weight", round1(stats.weighting_percent));
+  cJSON_AddNumberToObject(root, "jitter", round1(stats.jitter_percent));
+  cJSON_AddNumberToObject(root, "gap_jitter", round1(stats.gap_jitter_percent));
+  cJSON_AddNumberToObject(root, "char_gap", round1(stats.char_gap_units));
+  cJSON_AddNumberToObject(root, "word_gap", round1(stats.word_gap_units));
+  cJSON_AddNumberToObject(root, "wpm", round1(stats.session_wpm));
+  cJSON_AddNumberToObject(root, "window_wpm", round1(stats.window_wpm));
+  cJSON_AddNumberToObject(root, "drift", round1(stats.speed_drift_percent));
+  cJSON_AddNumberToObject(root, "window", static_cast<double>(stats.window_count));
+
+  // Per class: [count, mean, stddev, p10, p50, p90] in whole microseconds
+  static constexpr const char* kClassNames[morse_decoder::FistStats::kClassCount] = {
+      "dit", "dah", "intra", "char", "word"};
+  for (size_t i = 0; i < morse_decoder::FistStats::kClassCount; ++i) {
+    const auto& cls = stats.classes[i];
+    const int values[6] = {
+        static_cast<int>(cls.count),
+        static_cast<int>(std::lround(cls.mean_us)),
+        static_cast<int>(std::lround(cls.stddev_us)),
+        static_cast<int>(std::lround(cls.p10_us)),
+        static_cast<int>(std::lround(cls.p50_us)),
+        static_cast<int>(std::lround(cls.p90_us)),
+    };
+    cJSON* array = cJSON_CreateIntArray(values, 6);
+    if (array == nullptr) {
+      cJSON_Delete(root);
+      return SendError(req, 500, "Failed to build decoder stats JSON");
+    }
+    cJSON_AddItemToObject(root, kClassNames[i], array);
+  }
+
+  return SendJsonDocument(req, root);
+}
+
 esp_err_t HttpServer::HandleGetSystemStats(httpd_req_t* req) {
+  auto* ctx = static_cast<HandlerContext*>(req->user_ctx);
+
   // Create system monitor instance
   system_monitor::SystemMonitor monitor;
 
   // Get complete system stats as JSON
   std::string json = monitor.GetSystemStatsJson();
 
-  // Send JSON response
-  return SendJson(req, json.c_str());
+  keying_subsystem::KeyingSubsystem* keying = nullptr;
+  if (ctx->app_controller != nullptr) {
+    keying = ctx->app_controller->GetKeyingSubsystem();
+  }
+  cJSON* root = keying != nullptr ? cJSON_ParseWithLength(json.c_str(), json.size()) : nullptr;
+  if (root == nullptr) {
+    // Send JSON response
+    return SendJson(req, json.c_str());
+  }
+
+  // Keying edge lateness: per edge kind, the main loop worst case and the last misses
+  const keying::DeadlineMonitor& deadlines = keying->GetDeadlineMonitor();
+  cJSON* deadlines_json = cJSON_AddObjectToObject(root, "deadlines");
+  cJSON_AddNumberToObject(deadlines_json, "miss_threshold_us", deadlines.miss_threshold_us());
+  for (size_t k = 0; k < keying::kDeadlineKindCount; ++k) {
+    const auto kind = static_cast<keying::DeadlineKind>(k);
+    const keying::DeadlineKindStats stats = deadlines.Get(kind);
+    cJSON* kind_json = cJSON_AddObjectToObject(deadlines_json, keying::DeadlineKindName(kind));
+    cJSON_AddNumberToObject(kind_json, "edges", stats.edges);
+    cJSON_AddNumberToObject(kind_json, "misses", stats.misses);
+    cJSON_AddNumberToObject(kind_json, "mean_late_us", stats.mean_late_us);
+    cJSON_AddNumberToObject(kind_json, "max_late_us", stats.max_late_us);
+    cJSON* histogram = cJSON_AddArrayToObject(kind_json, "histogram");
+    for (size_t b = 0; b < keying::kLatenessBucketCount; ++b) {
+      cJSON_AddItemToArray(histogram, cJSON_CreateNumber(stats.histogram[b]));
+    }
+  }
+  cJSON* bounds = cJSON_AddArrayToObject(deadlines_json, "histogram_bounds_us");
+  for (size_t b = 0; b + 1 < keying::kLatenessBucketCount; ++b) {
+    cJSON_AddItemToArray(bounds, cJSON_CreateNumber(keying::kLatenessBucketUs[b]));
+  }
+
+  const auto add_stages = [](cJSON* parent, const keying::LoopTiming& timing) {
+    cJSON* stages = cJSON_AddObjectToObject(parent, "stages_us");
+    for (size_t i = 0; i < keying::kLoopStageCount; ++i) {
+      cJSON_AddNumberToObject(stages, keying::LoopStageName(static_cast<keying::LoopStage>(i)),
+                              timing.stage_us[i]);
+    }
+  };
+  const keying::LoopTiming worst = deadlines.worst_loop();
+  cJSON* loop_json = cJSON_AddObjectToObject(deadlines_json, "worst_loop");
+  cJSON_AddNumberToObject(loop_json, "loop_us", worst.loop_us);
+  cJSON_AddNumberToObject(loop_json, "max_wake_delay_us", deadlines.max_wake_delay_us());
+  add_stages(loop_json, worst);
+
+  keying::DeadlineMiss misses[keying::kDeadlineMissLogSize];
+  const size_t miss_count = deadlines.Misses(misses, keying::kDeadlineMissLogSize);
+  cJSON* misses_json = cJSON_AddArrayToObject(deadlines_json, "recent_misses");
+  for (size_t i = 0; i < miss_count; ++i) {
+    cJSON* miss_json = cJSON_CreateObject();
+    cJSON_AddStringToObject(miss_json, "kind", keying::DeadlineKindName(misses[i].kind));
+    cJSON_AddNumberToObject(miss_json, "channel", misses[i].channel);
+    cJSON_AddNumberToObject(miss_json, "planned_us", static_cast<double>(misses[i].planned_us));
+    cJSON_AddNumberToObject(miss_json, "late_us", misses[i].late_us);
+    cJSON_AddNumberToObject(miss_json, "wake_delay_us", misses[i].wake_delay_us);
+    cJSON_AddNumberToObject(miss_json, "loop_us", misses[i].last_loop.loop_us);
+    add_stages(miss_json, misses[i].last_loop);
+    cJSON_AddStringToObject(miss_json, "task", misses[i].task);
+    cJSON_AddItemToArray(misses_json, miss_json);
+  }
+
+  return SendJsonDocument(req, root);
 }
 
 esp_err_t HttpServer::HandlePostEnterBootloader(httpd_req_t* req) {
@@ -1206,6 +1766,70 @@ esp_err_t HttpServer::HandlePostEnterBootloader(httpd_req_t* req) {
   return result;
 }
 
+esp_err_t HttpServer::HandleGetFirmwareInfo(httpd_req_t* req) {
+  const esp_partition_t* running = esp_ota_get_running_partition();
+  const esp_partition_t* next = esp_ota_get_next_update_partition(nullptr);
+  const esp_app_desc_t* app_desc = esp_app_get_description();
+
+  cJSON* response = cJSON_CreateObject();
+  if (response == nullptr) {
+    return SendError(req, 500, "Failed to allocate response JSON");
+  }
+  cJSON_AddStringToObject(response, "version", app_desc->version);
+  cJSON_AddStringToObject(response, "running_partition", running != nullptr ? running->label : "");
+  const bool ota_available = next != nullptr && next != running;
+  cJSON_AddBoolToObject(response, "ota_available", ota_available);
+  if (ota_available) {
+    cJSON_AddStringToObject(response, "update_partition", next->label);
+    cJSON_AddNumberToObject(response, "max_image_size", next->size);
+  }
+  cJSON_AddBoolToObject(response, "pending_verify", app::IsRunningFirmwarePendingVerify());
+  cJSON_AddBoolToObject(response, "update_in_progress", app::IsFirmwareUpdateInProgress());
+  return SendJsonDocument(req, response);
+}
+
+esp_err_t HttpServer::HandlePostFirmwareUpload(httpd_req_t* req) {
+  // Raw image in the body; expected digest in ?sha256= or X-Firmware-SHA256 (optional)
+  char sha256[72] = {};
+  const bool has_digest = GetQueryParam(req, "sha256", sha256, sizeof(sha256)) ||
+                          GetRequestHeader(req, "X-Firmware-SHA256", sha256, sizeof(sha256));
+  if (has_digest && strlen(sha256) != 64) {
+    return SendError(req, 400, "sha256 must be 64 hex characters");
+  }
+
+  ESP_LOGI(HttpServer::kLogTag, "Firmware upload: %u bytes%s",
+           static_cast<unsigned>(req->content_len), has_digest ? " (sha256 given)" : "");
+  const app::OtaResult result = app::StreamFirmwareUpdate(
+      req->content_len, has_digest ? sha256 : nullptr, ReadRequestBody, req);
+
+  cJSON* response = cJSON_CreateObject();
+  if (response == nullptr) {
+    return SendError(req, 500, "Failed to allocate response JSON");
+  }
+  const bool success = result.error == ESP_OK;
+  cJSON_AddBoolToObject(response, "success", success);
+  cJSON_AddStringToObject(response, "message", result.message);
+  cJSON_AddStringToObject(response, "partition", result.partition);
+  cJSON_AddNumberToObject(response, "bytes", result.bytes_written);
+  cJSON_AddNumberToObject(response, "duration_ms", result.duration_ms);
+  cJSON_AddNumberToObject(response, "throughput_kbps", result.throughput_kbps);
+  cJSON_AddNumberToObject(response, "heap_peak_bytes", result.heap_peak_bytes);
+  cJSON_AddStringToObject(response, "sha256", result.sha256_hex);
+  cJSON_AddBoolToObject(response, "restarting", success);
+
+  httpd_resp_set_status(req, OtaStatusLine(result.error));
+  const esp_err_t sent = SendJsonDocument(req, response);
+  if (!success) {
+    return sent;
+  }
+
+  // Same pattern as bootloader entry: let the response leave before restarting.
+  // The new image boots pending verification (see app/ota_update.hpp).
+  vTaskDelay(pdMS_TO_TICKS(500));
+  esp_restart();
+  return sent;
+}
+
 // ============================================================================
 // TEXT KEYER API HANDLERS
 // ============================================================================
@@ -1359,6 +1983,30 @@ esp_err_t HttpServer::HandlePostKeyerMessage(httpd_req_t* req) {
     return SendError(req, 400, "Message number must be 1-10");
   }
 
+  // A paddle memory recorded for this slot replays the operator's own fist instead
+  keying_subsystem::KeyingSubsystem* keying = nullptr;
+  if (ctx->app_controller != nullptr) {
+    keying = ctx->app_controller->GetKeyingSubsystem();
+  }
+  if (keying != nullptr) {
+    size_t stream_size = 0;
+    std::unique_ptr<uint8_t[]> stream(new (std::nothrow) uint8_t[keying::kPaddleMemoryMaxBytes]);
+    if (stream && ctx->storage->LoadPaddleMemory(static_cast<size_t>(message_num), stream.get(),
+                                                 keying::kPaddleMemoryMaxBytes,
+                                                 &stream_size) == ESP_OK) {
+      if (!keying->PlayMemory(stream.get(), stream_size, 100)) {
+        return SendError(req, 400, "Failed to play paddle memory (busy?)");
+      }
+      cJSON* response = cJSON_CreateObject();
+      if (response == nullptr) {
+        return SendError(req, 500, "Failed to allocate response JSON");
+      }
+      cJSON_AddBoolToObject(response, "success", cJSON_True);
+      cJSON_AddStringToObject(response, "message", "Paddle memory replaying");
+      return SendJsonDocument(req, response);
+    }
+  }
+
   // Get message text from config
   const char* message_text = nullptr;
   switch (message_num) {
@@ -1423,8 +2071,12 @@ esp_err_t HttpServer::HandlePostKeyerAbort(httpd_req_t* req) {
     return SendError(req, 500, "Text keyer not initialized");
   }
 
-  // Abort transmission
+  // Abort transmission (text and paddle memory replay)
   keyer->Abort();
+  keying_subsystem::KeyingSubsystem* keying = ctx->app_controller->GetKeyingSubsystem();
+  if (keying != nullptr) {
+    keying->AbortMemoryPlayback();
+  }
 
   // Build success response
   cJSON* response = cJSON_CreateObject();
@@ -1438,6 +2090,175 @@ esp_err_t HttpServer::HandlePostKeyerAbort(httpd_req_t* req) {
   return SendJsonDocument(req, response);
 }
 
+/**
+ * @brief Handle GET /api/keyer/memory
+ *
+ * Response JSON:
+ * {
+ *   "state": "idle",   // "recording" | "playing"
+ *   "slots": [ { "slot": 1, "bytes": 212, "edges": 84, "duration_ms": 6120 }, ... ]
+ * }
+ * Only slots holding a recording are listed.
+ */
+esp_err_t HttpServer::HandleGetKeyerMemory(httpd_req_t* req) {
+  auto* ctx = static_cast<HandlerContext*>(req->user_ctx);
+
+  keying_subsystem::KeyingSubsystem* keying = nullptr;
+  if (ctx->app_controller != nullptr) {
+    keying = ctx->app_controller->GetKeyingSubsystem();
+  }
+  if (keying == nullptr) {
+    return SendError(req, 500, "Keying subsystem not initialized");
+  }
+
+  std::unique_ptr<uint8_t[]> stream(new (std::nothrow) uint8_t[keying::kPaddleMemoryMaxBytes]);
+  cJSON* response = cJSON_CreateObject();
+  cJSON* slots = cJSON_CreateArray();
+  if (!stream || response == nullptr || slots == nullptr) {
+    cJSON_Delete(response);
+    cJSON_Delete(slots);
+    return SendError(req, 500, "Failed to allocate response JSON");
+  }
+
+  const char* state = "idle";
+  if (keying->IsRecordingMemory()) {
+    state = "recording";
+  } else if (keying->IsPlayingMemory()) {
+    state = "playing";
+  }
+  cJSON_AddStringToObject(response, "state", state);
+
+  for (size_t slot = 1; slot <= config::Storage::kPaddleMemorySlots; ++slot) {
+    size_t size = 0;
+    int64_t duration_us = 0;
+    if (ctx->storage->LoadPaddleMemory(slot, stream.get(), keying::kPaddleMemoryMaxBytes,
+                                       &size) != ESP_OK ||
+        !timeline::ValidateEdgeStream(stream.get(), size, &duration_us)) {
+      continue;
+    }
+    cJSON* entry = cJSON_CreateObject();
+    if (entry == nullptr) {
+      break;
+    }
+    cJSON_AddNumberToObject(entry, "slot", static_cast<double>(slot));
+    cJSON_AddNumberToObject(entry, "bytes", static_cast<double>(size));
+    cJSON_AddNumberToObject(entry, "edges",
+                            static_cast<double>(timeline::EdgeStreamReader(stream.get(), size).count()));
+    cJSON_AddNumberToObject(entry, "duration_ms", static_cast<double>(duration_us / 1000));
+    cJSON_AddItemToArray(slots, entry);
+  }
+  cJSON_AddItemToObject(response, "slots", slots);
+
+  return SendJsonDocument(req, response);
+}
+
+/**
+ * @brief Handle POST /api/keyer/memory
+ *
+ * Request JSON: { "action": "record" | "save" | "play" | "stop" | "erase",
+ *                 "slot": 1-10 (save/play/erase), "speed_pct": 25-400 (play, default 100) }
+ *
+ * Same semantics as the 'memory' console command: "save" stops the running
+ * recording and stores it, "stop" discards a recording or aborts a replay.
+ */
+esp_err_t HttpServer::HandlePostKeyerMemory(httpd_req_t* req) {
+  auto* ctx = static_cast<HandlerContext*>(req->user_ctx);
+
+  char buffer[128];
+  int received = httpd_req_recv(req, buffer, sizeof(buffer) - 1);
+  if (received <= 0) {
+    return SendError(req, 400, "Missing request body");
+  }
+  buffer[received] = '\0';
+
+  cJSON* body = cJSON_Parse(buffer);
+  if (body == nullptr) {
+    return SendError(req, 400, "Invalid JSON in request body");
+  }
+  const cJSON* action_item = cJSON_GetObjectItem(body, "action");
+  const cJSON* slot_item = cJSON_GetObjectItem(body, "slot");
+  const cJSON* speed_item = cJSON_GetObjectItem(body, "speed_pct");
+  const std::string action = cJSON_IsString(action_item) ? action_item->valuestring : "";
+  const int slot = cJSON_IsNumber(slot_item) ? static_cast<int>(cJSON_GetNumberValue(slot_item)) : 0;
+  const int speed_pct =
+      cJSON_IsNumber(speed_item) ? static_cast<int>(cJSON_GetNumberValue(speed_item)) : 100;
+  cJSON_Delete(body);
+
+  keying_subsystem::KeyingSubsystem* keying = nullptr;
+  if (ctx->app_controller != nullptr) {
+    keying = ctx->app_controller->GetKeyingSubsystem();
+  }
+  if (keying == nullptr) {
+    return SendError(req, 500, "Keying subsystem not initialized");
+  }
+
+  const bool needs_slot = action == "save" || action == "play" || action == "erase";
+  if (needs_slot && (slot < 1 || static_cast<size_t>(slot) > config::Storage::kPaddleMemorySlots)) {
+    return SendError(req, 400, "Slot must be 1-10");
+  }
+
+  const char* message = nullptr;
+  if (action == "record") {
+    if (!keying->StartMemoryRecording()) {
+      return SendError(req, 400, "A memory is playing");
+    }
+    message = "Recording started";
+  } else if (action == "stop") {
+    if (keying->IsRecordingMemory()) {
+      keying->StopMemoryRecording(nullptr, 0);
+      message = "Recording discarded";
+    } else {
+      keying->AbortMemoryPlayback();
+      message = "Playback stopped";
+    }
+  } else if (action == "erase") {
+    if (ctx->storage->ErasePaddleMemory(static_cast<size_t>(slot)) != ESP_OK) {
+      return SendError(req, 500, "Failed to erase paddle memory");
+    }
+    message = "Paddle memory erased";
+  } else if (action == "save" || action == "play") {
+    std::unique_ptr<uint8_t[]> stream(new (std::nothrow) uint8_t[keying::kPaddleMemoryMaxBytes]);
+    if (!stream) {
+      return SendError(req, 500, "Failed to allocate stream buffer");
+    }
+    size_t size = 0;
+    if (action == "save") {
+      size = keying->StopMemoryRecording(stream.get(), keying::kPaddleMemoryMaxBytes);
+      if (size == 0) {
+        return SendError(req, 400, "Nothing recorded");
+      }
+      if (ctx->storage->SavePaddleMemory(static_cast<size_t>(slot), stream.get(), size) != ESP_OK) {
+        return SendError(req, 500, "Failed to save paddle memory");
+      }
+      message = "Paddle memory saved";
+    } else {
+      if (speed_pct < keying::kPaddleMemoryMinSpeedPct ||
+          speed_pct > keying::kPaddleMemoryMaxSpeedPct) {
+        return SendError(req, 400, "speed_pct must be 25-400");
+      }
+      if (ctx->storage->LoadPaddleMemory(static_cast<size_t>(slot), stream.get(),
+                                         keying::kPaddleMemoryMaxBytes, &size) != ESP_OK) {
+        return SendError(req, 404, "No paddle memory in this slot");
+      }
+      if (!keying->PlayMemory(stream.get(), size, static_cast<uint16_t>(speed_pct))) {
+        return SendError(req, 400, "Failed to play paddle memory (busy?)");
+      }
+      message = "Paddle memory replaying";
+    }
+  } else {
+    return SendError(req, 400, "Unknown action");
+  }
+
+  cJSON* response = cJSON_CreateObject();
+  if (response == nullptr) {
+    return SendError(req, 500, "Failed to allocate response JSON");
+  }
+  cJSON_AddBoolToObject(response, "success", cJSON_True);
+  cJSON_AddStringToObject(response, "message", message);
+
+  return SendJsonDocument(req, response);
+}
+
 // Include timeline API handlers (separate file to avoid bloating http_server.cpp)
 #include "timeline_api_handlers.cpp"
 
@@ -27,6 +27,18 @@ namespace morse_decoder {
 class MorseDecoder;
 }
 
+namespace timeline {
+class TimelineArchive;
+}
+
+namespace audio_subsystem {
+class AudioSubsystem;
+}
+
+namespace usb_hid {
+class HidKeyerPort;
+}
+
 namespace ui {
 
 // Forward declaration for SerialConsole
@@ -174,6 +186,159 @@ void SetKeyingSubsystem(keying_subsystem::KeyingSubsystem* keying);
  */
 int HandleKeyingDebugCommand(const std::vector<std::string>& args);
 
+/**
+ * @brief Handle "so2r" command
+ *
+ * Syntax: `so2r` | `so2r focus <radio>`
+ *
+ * Shows SO2R keying channels (focus, key state, speed) or moves the main
+ * paddle to another radio (1-based, as printed by `so2r`).
+ *
+ * @param args Command arguments (args[0] is "so2r")
+ * @return 0 on success, -1 on error
+ */
+int HandleSo2rCommand(const std::vector<std::string>& args);
+
+/**
+ * @brief Set configuration storage for commands that persist data (paddle memories)
+ *
+ * @param storage Pointer to Storage instance (non-owning)
+ */
+void SetConfigStorage(config::Storage* storage);
+
+/**
+ * @brief Handle "memory" command
+ *
+ * Syntax: `memory` | `memory record` | `memory save <1-10>` |
+ *         `memory play <1-10> [speed%]` | `memory stop` | `memory erase <1-10>`
+ *
+ * Records the paddle as keyed (exact edge timing) and stores it in a message
+ * slot; F-key/web message playback then replays the recording instead of the text.
+ *
+ * @param args Command arguments (args[0] is "memory")
+ * @return 0 on success, -1 on error
+ */
+int HandleMemoryCommand(const std::vector<std::string>& args);
+
+/**
+ * @brief Set flash timeline archive for the "archive" command
+ *
+ * @param archive Pointer to TimelineArchive instance (non-owning, nullptr = disabled)
+ */
+void SetTimelineArchive(timeline::TimelineArchive* archive);
+
+/**
+ * @brief Handle "archive" command
+ *
+ * Syntax: `archive` | `archive flush` | `archive dump [seconds]`
+ *
+ * Shows the flash timeline archive (segments used, archived time range),
+ * writes the partially filled segment now, or prints the archived events of
+ * the last N seconds (default 10) decoded one segment at a time.
+ *
+ * @param args Command arguments (args[0] is "archive")
+ * @return 0 on success, -1 on error
+ */
+int HandleArchiveCommand(const std::vector<std::string>& args);
+
+/**
+ * @brief Handle "capture" command
+ *
+ * Syntax: `capture` | `capture now` | `capture dump <id>` | `capture clear`
+ *
+ * Lists the trigger-based timeline snapshots (general.capture_* config),
+ * fires a manual trigger, prints the events of one capture or drops them all.
+ *
+ * @param args Command arguments (args[0] is "capture")
+ * @return 0 on success, -1 on error
+ */
+int HandleCaptureCommand(const std::vector<std::string>& args);
+
+/**
+ * @brief Set audio subsystem for the "sidetone" command
+ *
+ * @param audio Pointer to AudioSubsystem instance (non-owning)
+ */
+void SetAudioSubsystem(audio_subsystem::AudioSubsystem* audio);
+
+/**
+ * @brief Handle "sidetone" command
+ *
+ * Syntax: `sidetone`
+ *
+ * Shows the idle power-down state of the sidetone pump (audio.idle_timeout):
+ * power-downs, wake latency and the pump work saved while powered down.
+ *
+ * @param args Command arguments (args[0] is "sidetone")
+ * @return 0 on success, -1 on error
+ */
+int HandleSidetoneCommand(const std::vector<std::string>& args);
+
+/**
+ * @brief Set USB HID keyboard output for the "usbhid" command
+ *
+ * @param port Pointer to HidKeyerPort instance (non-owning, nullptr = disabled)
+ */
+void SetUsbHidKeyer(usb_hid::HidKeyerPort* port);
+
+/**
+ * @brief Handle "usbhid" command
+ *
+ * Syntax: `usbhid` | `usbhid reset`
+ *
+ * Shows the HID keyboard output mode (general.usb_hid), reports sent, dropped
+ * edges and the latency from the paddle GPIO edge to the report read by the
+ * host; "reset" clears the counters.
+ *
+ * @param args Command arguments (args[0] is "usbhid")
+ * @return 0 on success, -1 on error
+ */
+int HandleUsbHidCommand(const std::vector<std::string>& args);
+
+/**
+ * @brief Handle "deadlines" command
+ *
+ * Syntax: `deadlines` | `deadlines reset`
+ *
+ * Shows planned-vs-actual lateness of keying edges (element end/start,
+ * sidetone start) as counters and histograms, the worst main loop iteration
+ * by stage, and the last misses with the loop timing and busiest task that
+ * preceded them; "reset" clears the counters.
+ *
+ * @param args Command arguments (args[0] is "deadlines")
+ * @return 0 on success, -1 on error
+ */
+int HandleDeadlinesCommand(const std::vector<std::string>& args);
+
+/**
+ * @brief Handle "heap" command
+ *
+ * Syntax: `heap` | `heap start` | `heap stop` | `heap reset`
+ *
+ * Shows heap totals and, once the trace was started, allocations, frees and
+ * live bytes per subsystem plus the allocations made on the keying or audio
+ * path. Requires CONFIG_HEAP_USE_HOOKS=y.
+ *
+ * @param args Command arguments (args[0] is "heap")
+ * @return 0 on success, -1 on error
+ */
+int HandleHeapCommand(const std::vector<std::string>& args);
+
+/**
+ * @brief Handle "topology" command
+ *
+ * Syntax: `topology`
+ *
+ * Lists the task topology table (class, core, priority, stack) next to the
+ * running placement of each task with its stack high-water mark and CPU
+ * share, marks tasks placed differently from the table, and prints the
+ * per-core load and any violation of the real-time priority rule.
+ *
+ * @param args Command arguments (args[0] is "topology")
+ * @return 0 on success, -1 on error
+ */
+int HandleTopologyCommand(const std::vector<std::string>& args);
+
 /**
  * @brief Handle "debug timeline" command
  *
@@ -182,10 +182,22 @@ class HttpServer {
   // Decoder API endpoints
   static esp_err_t HandleGetDecoderStatus(httpd_req_t* req);
   static esp_err_t HandlePostDecoderEnable(httpd_req_t* req);
+  static esp_err_t HandleGetDecoderStats(httpd_req_t* req);
+
+  // SO2R API endpoints
+  static esp_err_t HandleGetSo2r(httpd_req_t* req);
+  static esp_err_t HandlePostSo2rFocus(httpd_req_t* req);
 
   // Timeline API endpoints
   static esp_err_t HandleGetTimelineEvents(httpd_req_t* req);
+  static esp_err_t HandleGetTimelineFeed(httpd_req_t* req);
   static esp_err_t HandleGetTimelineConfig(httpd_req_t* req);
+  static esp_err_t HandleGetTimelineExport(httpd_req_t* req);
+  static esp_err_t HandleGetTimelineArchive(httpd_req_t* req);
+  static esp_err_t HandleGetTimelineArchiveSegments(httpd_req_t* req);
+  static esp_err_t HandleGetTimelineCaptures(httpd_req_t* req);
+  static esp_err_t HandleGetTimelineCaptureData(httpd_req_t* req);
+  static esp_err_t HandlePostTimelineCaptures(httpd_req_t* req);
 
   // System Monitor API endpoints
   static esp_err_t HandleGetSystemStats(httpd_req_t* req);
@@ -193,6 +205,8 @@ class HttpServer {
   // Firmware update API endpoints
   static esp_err_t HandleGetFirmwarePage(httpd_req_t* req);
   static esp_err_t HandlePostEnterBootloader(httpd_req_t* req);
+  static esp_err_t HandleGetFirmwareInfo(httpd_req_t* req);
+  static esp_err_t HandlePostFirmwareUpload(httpd_req_t* req);
 
   // Text Keyer API endpoints
   static esp_err_t HandleGetKeyerPage(httpd_req_t* req);
@@ -200,6 +214,8 @@ class HttpServer {
   static esp_err_t HandlePostKeyerSend(httpd_req_t* req);
   static esp_err_t HandlePostKeyerMessage(httpd_req_t* req);
   static esp_err_t HandlePostKeyerAbort(httpd_req_t* req);
+  static esp_err_t HandleGetKeyerMemory(httpd_req_t* req);
+  static esp_err_t HandlePostKeyerMemory(httpd_req_t* req);
 
   // Helper: Extract query parameter from URI
   static bool GetQueryParam(httpd_req_t* req, const char* param_name,
@@ -20,6 +20,7 @@
 #include <functional>
 #include <cstdint>
 #include <memory>
+#include <atomic>
 
 // Forward declaration for DeviceConfig (MUST be outside ui namespace)
 namespace config {
@@ -101,7 +102,7 @@ public:
 
     /**
      * Initialize console and create FreeRTOS task.
-     * Sets up USB-CDC interface (TINYUSB_CDC_ACM_1) and displays initial prompt.
+     * Sets up USB-CDC interface (usb_service_cdc_port(): CDC1, or CDC0 with the HID keyboard) and displays initial prompt.
      */
     void Init();
 
@@ -120,6 +121,14 @@ public:
      */
     void Task();
 
+    /**
+     * Hand USB-CDC1 to another protocol (true) or take it back (false).
+     * While released the console neither reads the port nor writes to it
+     * (Print() output only goes to the output buffer); the prompt is shown
+     * again when the port comes back. Thread-safe.
+     */
+    void SetPortReleased(bool released);
+
     /**
      * Print string to console output.
      * @param str String to output (automatically buffered)
@@ -149,6 +158,8 @@ private:
     std::unique_ptr<CommandDispatcher> dispatcher_;
     std::unique_ptr<OutputBuffer> output_;
     config::DeviceConfig* config_;  ///< Device configuration for dynamic prompt
+    std::atomic<bool> port_released_{false};  ///< CDC1 handed to another protocol
+    bool reprompt_ = false;                   ///< Console task: redraw the prompt on reclaim
 
     /**
      * Process a completed command line.
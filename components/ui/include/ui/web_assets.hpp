@@ -12,9 +12,14 @@ struct Asset {
   std::size_t size;               // Size of the embedded asset
   const char* content_type;       // MIME type for HTTP response
   bool compressed;                // True if gzip-compressed at build time
+  const std::uint8_t* br_data;    // Brotli variant, nullptr when not embedded
+  std::size_t br_size;            // Size of the Brotli variant (0 when absent)
+  const char* etag;               // Quoted strong ETag (hash of the uncompressed content; SendAsset adds -gz/-br)
+  bool immutable;                 // Content-hashed file name: cacheable forever
 };
 
 // Returns pointer to asset metadata or nullptr when not found.
+// The generated manifest is sorted by path, lookup is a binary search.
 const Asset* Find(std::string_view path);
 const Asset* List();
 std::size_t Count();
@@ -4,7 +4,7 @@
  *
  * Main implementation of the SerialConsole class.
  * Adapted from prototype in components/ui/tmp/Console.cpp
- * Modified to use USB-CDC (TINYUSB_CDC_ACM_1) instead of UART.
+ * Modified to use USB-CDC (usb_service_cdc_port()) instead of UART.
  */
 
 #include "ui/serial_console.hpp"
@@ -12,11 +12,13 @@
 #include "CommandDispatcher.hpp"
 #include "OutputBuffer.hpp"
 #include "config/device_config.hpp"
+#include "app/usb_early_init.hpp"
 #include "tinyusb_cdc_acm.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "esp_log.h"
 #include "esp_app_desc.h"  // For esp_app_get_description()
+#include "system_monitor/task_topology.hpp"
 #include <sstream>
 #include <cstring>
 #include <cstdarg>
@@ -28,8 +30,11 @@ static const char* TAG = "SerialConsole";
 // Global console instance pointer (used by command handlers in console_parameter_bridge.cpp)
 SerialConsole* g_console_instance = nullptr;
 
-// USB-CDC port for console (COM7) - already initialized in usb_early_init.cpp
-static constexpr tinyusb_cdcacm_itf_t CONSOLE_CDC_PORT = TINYUSB_CDC_ACM_1;
+// USB-CDC port for console (COM7, or the single CDC port with the HID keyboard) -
+// chosen and initialized in usb_early_init.cpp
+static tinyusb_cdcacm_itf_t ConsoleCdcPort() {
+    return static_cast<tinyusb_cdcacm_itf_t>(usb_service_cdc_port());
+}
 
 // FreeRTOS task entry point
 static void console_task_entry(void* pvParameters) {
@@ -70,13 +75,11 @@ std::string SerialConsole::GetPrompt() const {
 void SerialConsole::Init() {
     input_->init();
 
-    // Create FreeRTOS task for console processing
-    BaseType_t result = xTaskCreate(
+    // Create FreeRTOS task for console processing (placement: system_monitor/task_topology)
+    BaseType_t result = system_monitor::CreateTask(
+        system_monitor::TaskId::kSerialConsole,
         console_task_entry,
-        "serial_console",       // Task name
-        8192,                   // Stack size: 8KB (safe for C++ objects, vectors, strings + USB-CDC)
         this,                   // Task parameter (this pointer)
-        5,                      // Priority: same as USB heartbeat task
         nullptr                 // Task handle (not needed)
     );
 
@@ -95,14 +98,29 @@ void SerialConsole::RegisterCommand(const std::string& verb,
 }
 
 void SerialConsole::Task() {
+    if (port_released_.load(std::memory_order_relaxed)) {
+        reprompt_ = true;  // Another protocol owns COM7: leave its bytes alone
+        return;
+    }
+    if (reprompt_) {
+        reprompt_ = false;
+        input_->init();
+    }
     input_->process();
 }
 
+void SerialConsole::SetPortReleased(bool released) {
+    port_released_.store(released, std::memory_order_relaxed);
+    ESP_LOGI(TAG, "Console %s USB-CDC1", released ? "released" : "reclaimed");
+}
+
 void SerialConsole::Print(const std::string& str) {
-    tinyusb_cdcacm_write_queue(CONSOLE_CDC_PORT,
-                               reinterpret_cast<const uint8_t*>(str.c_str()),
-                               str.length());
-    tinyusb_cdcacm_write_flush(CONSOLE_CDC_PORT, 0);  // Non-blocking flush
+    if (!port_released_.load(std::memory_order_relaxed)) {
+        tinyusb_cdcacm_write_queue(ConsoleCdcPort(),
+                                   reinterpret_cast<const uint8_t*>(str.c_str()),
+                                   str.length());
+        tinyusb_cdcacm_write_flush(ConsoleCdcPort(), 0);  // Non-blocking flush
+    }
     output_->addLine(str);
 }
 
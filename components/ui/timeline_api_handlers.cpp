@@ -4,14 +4,25 @@
  *
  * Provides HTTP endpoints for timeline event streaming and configuration:
  * - GET /api/timeline/events?since=<timestamp>&limit=<max_events>
+ * - GET /api/timeline/feed?since=<timestamp>&limit=<max_events> (binary, see timeline_feed.hpp)
  * - GET /api/timeline/config
+ * - GET /api/timeline/export?since=<timestamp>&channel=<n> (edge stream, see timeline/edge_stream.hpp)
+ * - GET /api/timeline/archive (flash archive status)
+ * - GET /api/timeline/archive/segments?since=&until=&all=1 (raw segments, see timeline/segment_log.hpp)
+ * - GET /api/timeline/captures (trigger-based snapshots)
+ * - GET /api/timeline/captures/data?id=<n> (one snapshot, segment format)
+ * - POST /api/timeline/captures {"action": "trigger"|"clear"}
  *
  * Separated from http_server.cpp to avoid bloating the main file.
  * Included directly in http_server.cpp (not compiled separately).
  */
 
 #include "ui/http_server.hpp"
+#include "timeline/edge_stream.hpp"
 #include "timeline/event_logger.hpp"
+#include "timeline/timeline_archive.hpp"
+#include "timeline/timeline_capture.hpp"
+#include "timeline/timeline_feed.hpp"
 #include "app/application_controller.hpp"
 #include "keying_subsystem/keying_subsystem.hpp"
 
@@ -24,6 +35,8 @@ extern "C" {
 #include <cinttypes>
 #include <cstdlib>
 #include <cstring>
+#include <memory>
+#include <new>
 
 // Timeline API log tag (macro to avoid namespace scope issues when included)
 #define TIMELINE_TAG "TimelineAPI"
@@ -33,6 +46,11 @@ extern "C" {
 
 namespace {
 
+// Feed pages are allocated per request from the httpd task: 1024 events is 8 KB + header
+// (the whole logger would be ~24 KB); clients page with since = last timestamp
+constexpr size_t kFeedDefaultEvents = 512;
+constexpr size_t kFeedMaxEvents = 1024;
+
 /**
  * @brief Map EventType enum to JSON string representation
  *
@@ -63,6 +81,8 @@ const char* EventTypeToString(timeline::EventType type) {
       return "gap_marker";
     case EventType::kDecodedChar:
       return "decoded_char";
+    case EventType::kFocus:
+      return "focus";
     default:
       return "unknown";
   }
@@ -200,6 +220,359 @@ esp_err_t HttpServer::HandleGetTimelineEvents(httpd_req_t* req) {
   return SendJsonDocument(req, root);
 }
 
+/**
+ * @brief Handle GET /api/timeline/feed
+ *
+ * Same selection as /api/timeline/events, encoded as one binary page
+ * (application/octet-stream, 8 bytes per event; format in timeline/timeline_feed.hpp).
+ *
+ * Query parameters:
+ * - since: (optional) Microsecond timestamp - only return events after this time
+ * - limit: (optional) Maximum events to return (default: 512, max: 1024); a full page
+ *   means more events may follow: ask again with since = last timestamp
+ */
+esp_err_t HttpServer::HandleGetTimelineFeed(httpd_req_t* req) {
+  auto* ctx = static_cast<HandlerContext*>(req->user_ctx);
+
+  keying_subsystem::KeyingSubsystem* keying = nullptr;
+  if (ctx->app_controller != nullptr) {
+    keying = ctx->app_controller->GetKeyingSubsystem();
+  }
+  if (keying == nullptr) {
+    ESP_LOGW(TIMELINE_TAG, "KeyingSubsystem not initialized");
+    return SendError(req, 500, "Keying subsystem not initialized");
+  }
+  auto& timeline = keying->GetTimeline();
+
+  int64_t since_timestamp = 0;
+  size_t limit = kFeedDefaultEvents;
+  char param_buf[32];
+  if (GetQueryParam(req, "since", param_buf, sizeof(param_buf))) {
+    since_timestamp = strtoll(param_buf, nullptr, 10);
+  }
+  if (GetQueryParam(req, "limit", param_buf, sizeof(param_buf))) {
+    const long requested = atol(param_buf);
+    if (requested > 0) {
+      limit = static_cast<size_t>(requested) < kFeedMaxEvents ? static_cast<size_t>(requested)
+                                                              : kFeedMaxEvents;
+    }
+  }
+
+  // At most 8 KB + header; allocated per request instead of on the 4 KB httpd stack
+  const size_t page_size = timeline::FeedPageSize(limit);
+  std::unique_ptr<uint8_t[]> page(new (std::nothrow) uint8_t[page_size]);
+  if (!page) {
+    ESP_LOGE(TIMELINE_TAG, "Failed to allocate %zu byte feed page", page_size);
+    return SendError(req, 500, "Failed to allocate feed page");
+  }
+
+  timeline::FeedWriter writer(page.get(), page_size);
+  timeline.for_each([&](const timeline::TimelineEvent& evt) {
+    if (evt.timestamp_us > since_timestamp) {
+      writer.Add(evt);
+    }
+  });
+  const size_t length =
+      writer.Finish(esp_timer_get_time(), static_cast<uint32_t>(timeline.dropped_count()));
+
+  httpd_resp_set_type(req, "application/octet-stream");
+  httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
+  httpd_resp_set_hdr(req, "Cache-Control", "no-store");
+  return httpd_resp_send(req, reinterpret_cast<const char*>(page.get()), length);
+}
+
+/**
+ * @brief Handle GET /api/timeline/export
+ *
+ * Exports the keyed output of one channel as a paddle memory edge stream
+ * (application/octet-stream, format in timeline/edge_stream.hpp). The absolute
+ * time of stream offset 0 is returned in the X-Edge-Stream-Origin-Us header.
+ *
+ * Query parameters:
+ * - since: (optional) Microsecond timestamp - only export key edges after this time
+ * - channel: (optional) Keying channel (default 0)
+ */
+esp_err_t HttpServer::HandleGetTimelineExport(httpd_req_t* req) {
+  auto* ctx = static_cast<HandlerContext*>(req->user_ctx);
+
+  keying_subsystem::KeyingSubsystem* keying = nullptr;
+  if (ctx->app_controller != nullptr) {
+    keying = ctx->app_controller->GetKeyingSubsystem();
+  }
+  if (keying == nullptr) {
+    ESP_LOGW(TIMELINE_TAG, "KeyingSubsystem not initialized");
+    return SendError(req, 500, "Keying subsystem not initialized");
+  }
+  auto& timeline = keying->GetTimeline();
+
+  int64_t since_timestamp = 0;
+  uint32_t channel = 0;
+  char param_buf[32];
+  if (GetQueryParam(req, "since", param_buf, sizeof(param_buf))) {
+    since_timestamp = strtoll(param_buf, nullptr, 10);
+  }
+  if (GetQueryParam(req, "channel", param_buf, sizeof(param_buf))) {
+    channel = static_cast<uint32_t>(strtoul(param_buf, nullptr, 10));
+  }
+
+  // Worst case: every logged event is a key edge with a 5-byte gap
+  const size_t stream_capacity =
+      timeline::kEdgeStreamHeaderSize + timeline.capacity() * timeline::kEdgeStreamMaxVarintSize;
+  std::unique_ptr<uint8_t[]> stream(new (std::nothrow) uint8_t[stream_capacity]);
+  if (!stream) {
+    ESP_LOGE(TIMELINE_TAG, "Failed to allocate %zu byte edge stream", stream_capacity);
+    return SendError(req, 500, "Failed to allocate edge stream");
+  }
+
+  timeline::EdgeStreamWriter writer(stream.get(), stream_capacity);
+  int64_t origin_us = 0;
+  timeline.for_each([&](const timeline::TimelineEvent& evt) {
+    if (evt.type != timeline::EventType::kKeying || evt.timestamp_us <= since_timestamp ||
+        (evt.arg0 >> 8) != channel) {
+      return;
+    }
+    if (writer.count() == 0 && evt.arg1 != 0) {
+      origin_us = evt.timestamp_us;  // Stream offsets start at the first key-down
+    }
+    writer.Add(evt.arg1 != 0, evt.timestamp_us);
+  });
+  const size_t length = writer.Finish();
+
+  char origin_buf[24];
+  snprintf(origin_buf, sizeof(origin_buf), "%" PRId64, origin_us);
+  httpd_resp_set_type(req, "application/octet-stream");
+  httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
+  httpd_resp_set_hdr(req, "Access-Control-Expose-Headers", "X-Edge-Stream-Origin-Us");
+  httpd_resp_set_hdr(req, "X-Edge-Stream-Origin-Us", origin_buf);
+  httpd_resp_set_hdr(req, "Cache-Control", "no-store");
+  return httpd_resp_send(req, reinterpret_cast<const char*>(stream.get()), length);
+}
+
+/**
+ * @brief Handle GET /api/timeline/archive
+ *
+ * Response JSON (enabled false when general.timeline_archive is off or the
+ * "timeline" partition is missing):
+ * {
+ *   "enabled": true, "boot": 3, "slots": 256, "used_slots": 41,
+ *   "oldest_us": 1200000, "newest_us": 5400000000,
+ *   "events_archived": 24890, "events_buffered": 112, "events_lost": 0,
+ *   "segments_written": 41, "write_errors": 0
+ * }
+ */
+esp_err_t HttpServer::HandleGetTimelineArchive(httpd_req_t* req) {
+  auto* ctx = static_cast<HandlerContext*>(req->user_ctx);
+  timeline::TimelineArchive* archive =
+      ctx->app_controller != nullptr ? ctx->app_controller->GetTimelineArchive() : nullptr;
+
+  cJSON* root = cJSON_CreateObject();
+  if (root == nullptr) {
+    return SendError(req, 500, "Failed to allocate JSON");
+  }
+  cJSON_AddBoolToObject(root, "enabled", archive != nullptr);
+  if (archive != nullptr) {
+    const timeline::TimelineArchiveStats stats = archive->GetStats();
+    cJSON_AddNumberToObject(root, "boot", stats.boot);
+    cJSON_AddNumberToObject(root, "slots", static_cast<double>(stats.slot_count));
+    cJSON_AddNumberToObject(root, "used_slots", static_cast<double>(stats.used_slots));
+    cJSON_AddNumberToObject(root, "oldest_us", static_cast<double>(stats.oldest_us));
+    cJSON_AddNumberToObject(root, "newest_us", static_cast<double>(stats.newest_us));
+    cJSON_AddNumberToObject(root, "events_archived", stats.events_archived);
+    cJSON_AddNumberToObject(root, "events_buffered", static_cast<double>(stats.buffered_events));
+    cJSON_AddNumberToObject(root, "events_lost", stats.events_lost);
+    cJSON_AddNumberToObject(root, "segments_written", stats.segments_written);
+    cJSON_AddNumberToObject(root, "write_errors", stats.write_errors);
+  }
+  return SendJsonDocument(req, root);
+}
+
+namespace {
+bool SendArchiveSegment(const uint8_t* segment, size_t length, void* context) {
+  return httpd_resp_send_chunk(static_cast<httpd_req_t*>(context),
+                               reinterpret_cast<const char*>(segment), length) == ESP_OK;
+}
+}  // namespace
+
+/**
+ * @brief Handle GET /api/timeline/archive/segments
+ *
+ * Streams stored segments as they are in flash (application/octet-stream, chunked,
+ * format in timeline/segment_log.hpp), oldest first. Segments are read one at a
+ * time, so memory use does not depend on the range; the client decodes them.
+ *
+ * Query parameters:
+ * - since / until: (optional) Microsecond range of the current boot
+ * - all: (optional) 1 = every stored segment, all boots
+ */
+esp_err_t HttpServer::HandleGetTimelineArchiveSegments(httpd_req_t* req) {
+  auto* ctx = static_cast<HandlerContext*>(req->user_ctx);
+  timeline::TimelineArchive* archive =
+      ctx->app_controller != nullptr ? ctx->app_controller->GetTimelineArchive() : nullptr;
+  if (archive == nullptr) {
+    return SendError(req, 404, "Timeline archive disabled");
+  }
+
+  int64_t since_us = INT64_MIN;
+  int64_t until_us = INT64_MAX;
+  bool all_boots = false;
+  char param_buf[32];
+  if (GetQueryParam(req, "since", param_buf, sizeof(param_buf))) {
+    since_us = strtoll(param_buf, nullptr, 10);
+  }
+  if (GetQueryParam(req, "until", param_buf, sizeof(param_buf))) {
+    until_us = strtoll(param_buf, nullptr, 10);
+  }
+  if (GetQueryParam(req, "all", param_buf, sizeof(param_buf))) {
+    all_boots = atoi(param_buf) != 0;
+  }
+
+  httpd_resp_set_type(req, "application/octet-stream");
+  httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
+  httpd_resp_set_hdr(req, "Cache-Control", "no-store");
+  const size_t segments = archive->Export(all_boots, since_us, until_us, &SendArchiveSegment, req);
+  ESP_LOGD(TIMELINE_TAG, "Archive export: %zu segments", segments);
+  return httpd_resp_send_chunk(req, nullptr, 0);
+}
+
+/**
+ * @brief Handle GET /api/timeline/captures
+ *
+ * Response JSON:
+ * {
+ *   "triggers": 3, "pre_ms": 2000, "post_ms": 500, "pending": false, "missed": 0,
+ *   "captures": [
+ *     {"id": 2, "trigger": "late", "trigger_us": 81234567, "pre_ms": 2000, "post_ms": 500,
+ *      "events": 38, "bytes": 301, "truncated": false}
+ *   ]
+ * }
+ */
+esp_err_t HttpServer::HandleGetTimelineCaptures(httpd_req_t* req) {
+  auto* ctx = static_cast<HandlerContext*>(req->user_ctx);
+  keying_subsystem::KeyingSubsystem* keying =
+      ctx->app_controller != nullptr ? ctx->app_controller->GetKeyingSubsystem() : nullptr;
+  if (keying == nullptr) {
+    return SendError(req, 500, "Keying subsystem not initialized");
+  }
+  timeline::TimelineCapture& capture = keying->GetTimelineCapture();
+  const timeline::CaptureConfig config = capture.config();
+  timeline::CaptureInfo captures[timeline::kMaxCaptures];
+  const size_t count = capture.List(captures, timeline::kMaxCaptures);
+
+  cJSON* root = cJSON_CreateObject();
+  if (root == nullptr) {
+    return SendError(req, 500, "Failed to allocate JSON");
+  }
+  cJSON_AddNumberToObject(root, "triggers", config.trigger_mask);
+  cJSON_AddNumberToObject(root, "pre_ms", config.pre_ms);
+  cJSON_AddNumberToObject(root, "post_ms", config.post_ms);
+  cJSON_AddBoolToObject(root, "pending", capture.pending());
+  cJSON_AddNumberToObject(root, "missed", capture.missed_triggers());
+  cJSON* list = cJSON_AddArrayToObject(root, "captures");
+  for (size_t i = 0; list != nullptr && i < count; ++i) {
+    cJSON* item = cJSON_CreateObject();
+    if (item == nullptr) {
+      break;
+    }
+    cJSON_AddNumberToObject(item, "id", captures[i].id);
+    cJSON_AddStringToObject(item, "trigger", timeline::CaptureTriggerName(captures[i].trigger));
+    cJSON_AddNumberToObject(item, "trigger_us", static_cast<double>(captures[i].trigger_us));
+    cJSON_AddNumberToObject(item, "pre_ms", captures[i].pre_ms);
+    cJSON_AddNumberToObject(item, "post_ms", captures[i].post_ms);
+    cJSON_AddNumberToObject(item, "events", static_cast<double>(captures[i].events));
+    cJSON_AddNumberToObject(item, "bytes", static_cast<double>(captures[i].length));
+    cJSON_AddBoolToObject(item, "truncated", captures[i].truncated);
+    cJSON_AddItemToArray(list, item);
+  }
+  return SendJsonDocument(req, root);
+}
+
+/**
+ * @brief Handle GET /api/timeline/captures/data?id=<n>
+ *
+ * One capture as a single segment (application/octet-stream, format in
+ * timeline/segment_log.hpp; the segment sequence is the capture id).
+ */
+esp_err_t HttpServer::HandleGetTimelineCaptureData(httpd_req_t* req) {
+  auto* ctx = static_cast<HandlerContext*>(req->user_ctx);
+  keying_subsystem::KeyingSubsystem* keying =
+      ctx->app_controller != nullptr ? ctx->app_controller->GetKeyingSubsystem() : nullptr;
+  if (keying == nullptr) {
+    return SendError(req, 500, "Keying subsystem not initialized");
+  }
+  char param_buf[16];
+  if (!GetQueryParam(req, "id", param_buf, sizeof(param_buf))) {
+    return SendError(req, 400, "Missing id parameter");
+  }
+  std::unique_ptr<uint8_t[]> segment(new (std::nothrow) uint8_t[timeline::kSegmentSize]);
+  if (!segment) {
+    return SendError(req, 500, "Failed to allocate capture buffer");
+  }
+  timeline::CaptureInfo info;
+  const size_t length = keying->GetTimelineCapture().Read(
+      static_cast<uint32_t>(strtoul(param_buf, nullptr, 10)), segment.get(), &info);
+  if (length == 0) {
+    return SendError(req, 404, info.id == 0 ? "Unknown capture" : "Capture holds no events");
+  }
+
+  httpd_resp_set_type(req, "application/octet-stream");
+  httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
+  httpd_resp_set_hdr(req, "Cache-Control", "no-store");
+  return httpd_resp_send(req, reinterpret_cast<const char*>(segment.get()),
+                         static_cast<ssize_t>(length));
+}
+
+/**
+ * @brief Handle POST /api/timeline/captures
+ *
+ * Body: {"action": "trigger"} arms a manual capture around now,
+ *       {"action": "clear"} drops the frozen captures.
+ */
+esp_err_t HttpServer::HandlePostTimelineCaptures(httpd_req_t* req) {
+  auto* ctx = static_cast<HandlerContext*>(req->user_ctx);
+
+  char buffer[64];
+  int received = httpd_req_recv(req, buffer, sizeof(buffer) - 1);
+  if (received <= 0) {
+    return SendError(req, 400, "Missing request body");
+  }
+  buffer[received] = '\0';
+  cJSON* body = cJSON_Parse(buffer);
+  if (body == nullptr) {
+    return SendError(req, 400, "Invalid JSON in request body");
+  }
+  const cJSON* action_item = cJSON_GetObjectItem(body, "action");
+  const std::string action = cJSON_IsString(action_item) ? action_item->valuestring : "";
+  cJSON_Delete(body);
+
+  keying_subsystem::KeyingSubsystem* keying =
+      ctx->app_controller != nullptr ? ctx->app_controller->GetKeyingSubsystem() : nullptr;
+  if (keying == nullptr) {
+    return SendError(req, 500, "Keying subsystem not initialized");
+  }
+  timeline::TimelineCapture& capture = keying->GetTimelineCapture();
+
+  const char* message = nullptr;
+  if (action == "trigger") {
+    if (!capture.Trigger(timeline::CaptureTrigger::kManual, esp_timer_get_time())) {
+      return SendError(req, 400, "A capture is already pending");
+    }
+    message = "Capture armed";
+  } else if (action == "clear") {
+    capture.Clear();
+    message = "Captures cleared";
+  } else {
+    return SendError(req, 400, "Unknown action");
+  }
+
+  cJSON* response = cJSON_CreateObject();
+  if (response == nullptr) {
+    return SendError(req, 500, "Failed to allocate response JSON");
+  }
+  cJSON_AddBoolToObject(response, "success", cJSON_True);
+  cJSON_AddStringToObject(response, "message", message);
+  return SendJsonDocument(req, response);
+}
+
 /**
  * @brief Handle GET /api/timeline/config
  *
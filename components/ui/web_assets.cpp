@@ -10,8 +10,10 @@ namespace ui::assets {
 const Asset* Find(std::string_view path) {
   const auto begin = generated::kAssets;
   const auto end = generated::kAssets + generated::kAssetCount;
-  const auto it = std::find_if(begin, end, [&](const Asset& asset) { return path == asset.path; });
-  return it == end ? nullptr : it;
+  const auto it = std::lower_bound(begin, end, path, [](const Asset& asset, std::string_view key) {
+    return std::string_view(asset.path) < key;
+  });
+  return (it != end && path == it->path) ? it : nullptr;
 }
 
 const Asset* List() {
@@ -0,0 +1,125 @@
+/**
+ * @file hid_keyer.cpp
+ * @brief Keyboard-report state and latency statistics for the USB HID keyer output
+ */
+
+#include "usb_hid/hid_keyer.hpp"
+
+namespace usb_hid {
+
+namespace {
+constexpr uint8_t kInputDit = 0x01;
+constexpr uint8_t kInputDah = 0x02;
+constexpr uint8_t kInputKey = 0x04;
+constexpr uint8_t kInputKeyed = 0x08;
+
+constexpr uint32_t kSlowReportUs = 2000;
+}  // namespace
+
+const char* HidKeyerModeName(HidKeyerMode mode) {
+  switch (mode) {
+    case HidKeyerMode::kOff:
+      return "off";
+    case HidKeyerMode::kPaddles:
+      return "paddles";
+    case HidKeyerMode::kKeyed:
+      return "keyed";
+  }
+  return "unknown";
+}
+
+void HidKeyer::OnPaddleEdge(hal::PaddleLine line, bool active, int64_t timestamp_us) {
+  if (mode_ != HidKeyerMode::kPaddles) {
+    return;
+  }
+  switch (line) {
+    case hal::PaddleLine::kDit:
+      Apply(kInputDit, active, timestamp_us);
+      break;
+    case hal::PaddleLine::kDah:
+      Apply(kInputDah, active, timestamp_us);
+      break;
+    case hal::PaddleLine::kKey:
+      Apply(kInputKey, active, timestamp_us);
+      break;
+    case hal::PaddleLine::kFocus:
+      break;
+  }
+}
+
+void HidKeyer::OnKeyEdge(bool key_active, int64_t timestamp_us) {
+  if (mode_ == HidKeyerMode::kKeyed) {
+    Apply(kInputKeyed, key_active, timestamp_us);
+  }
+}
+
+void HidKeyer::Apply(uint8_t input_bit, bool active, int64_t timestamp_us) {
+  const uint8_t before = inputs_;
+  inputs_ = active ? static_cast<uint8_t>(inputs_ | input_bit)
+                   : static_cast<uint8_t>(inputs_ & ~input_bit);
+  if (inputs_ == before) {
+    return;
+  }
+  // Latency is charged to the oldest edge still waiting for a report
+  if (!dirty_) {
+    oldest_edge_us_ = timestamp_us;
+    dirty_ = true;
+  }
+}
+
+uint8_t HidKeyer::modifiers() const {
+  uint8_t modifiers = 0;
+  if ((inputs_ & (kInputDit | kInputKey | kInputKeyed)) != 0) {
+    modifiers |= kModifierLeftCtrl;
+  }
+  if ((inputs_ & kInputDah) != 0) {
+    modifiers |= kModifierRightCtrl;
+  }
+  return modifiers;
+}
+
+bool HidKeyer::TakeReport(uint8_t* modifiers, int64_t* edge_us) {
+  if (!dirty_) {
+    return false;
+  }
+  dirty_ = false;
+  const uint8_t current = this->modifiers();
+  if (current == reported_) {
+    return false;  // Press and release both landed before the report went out
+  }
+  reported_ = current;
+  *modifiers = current;
+  *edge_us = oldest_edge_us_;
+  return true;
+}
+
+void HidLatencyStats::Record(uint32_t latency_us) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (summary_.samples == 0 || latency_us < summary_.min_us) {
+    summary_.min_us = latency_us;
+  }
+  if (latency_us > summary_.max_us) {
+    summary_.max_us = latency_us;
+  }
+  if (latency_us > kSlowReportUs) {
+    ++summary_.over_2ms;
+  }
+  ++summary_.samples;
+  summary_.last_us = latency_us;
+  sum_us_ += latency_us;
+}
+
+HidLatencySummary HidLatencyStats::Get() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  HidLatencySummary summary = summary_;
+  summary.mean_us = summary.samples > 0 ? static_cast<uint32_t>(sum_us_ / summary.samples) : 0;
+  return summary;
+}
+
+void HidLatencyStats::Reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  summary_ = HidLatencySummary{};
+  sum_us_ = 0;
+}
+
+}  // namespace usb_hid
@@ -0,0 +1,214 @@
+/**
+ * @file hid_keyer_port.cpp
+ * @brief USB HID keyboard interface mirroring the paddles or the keyed output (TinyUSB)
+ */
+
+#include "usb_hid/hid_keyer_port.hpp"
+
+#include "esp_attr.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "system_monitor/task_topology.hpp"
+#include "tusb.h"
+
+namespace usb_hid {
+
+namespace {
+constexpr char kLogTag[] = "usb_hid";
+
+constexpr UBaseType_t kQueueLength = 32;
+
+// The S3 OTG controller has four IN endpoints besides EP0 and dual CDC takes
+// all of them (notification + data IN per port). The keyboard configuration
+// therefore has one CDC port, TinyUSB instance 0, which carries the console;
+// the debug log stays on UART1 (usb_service_cdc_port() in usb_early_init.hpp)
+enum : uint8_t {
+  kItfCdc = 0,
+  kItfCdcData,
+  kItfHid,
+  kItfCount,
+};
+
+constexpr uint8_t kEpCdcNotif = 0x81;
+constexpr uint8_t kEpCdcOut = 0x02;
+constexpr uint8_t kEpCdcIn = 0x82;
+constexpr uint8_t kEpHidIn = 0x83;  // Third IN endpoint; the fourth stays free
+
+constexpr uint8_t kStrIdxCdc = 4;  // "CDC" interface string of the default string table
+constexpr uint8_t kHidPollIntervalMs = 1;
+constexpr uint8_t kHidEpSize = 8;  // One boot keyboard report
+
+constexpr uint16_t kConfigTotalLength = TUD_CONFIG_DESC_LEN + TUD_CDC_DESC_LEN + TUD_HID_DESC_LEN;
+
+const uint8_t kHidReportDescriptor[] = {
+    TUD_HID_REPORT_DESC_KEYBOARD(),
+};
+
+const uint8_t kFullSpeedConfig[] = {
+    TUD_CONFIG_DESCRIPTOR(1, kItfCount, 0, kConfigTotalLength, TUSB_DESC_CONFIG_ATT_REMOTE_WAKEUP, 100),
+    TUD_CDC_DESCRIPTOR(kItfCdc, kStrIdxCdc, kEpCdcNotif, 8, kEpCdcOut, kEpCdcIn, 64),
+    TUD_HID_DESCRIPTOR(kItfHid, 0, HID_ITF_PROTOCOL_KEYBOARD, sizeof(kHidReportDescriptor), kEpHidIn,
+                       kHidEpSize, kHidPollIntervalMs),
+};
+
+// Port the TinyUSB callbacks report to (one per boot)
+HidKeyerPort* g_port = nullptr;
+}  // namespace
+
+const uint8_t* HidKeyerPort::FullSpeedConfigDescriptor() {
+  return kFullSpeedConfig;
+}
+
+HidKeyerPort::~HidKeyerPort() {
+  if (g_port == this) {
+    g_port = nullptr;
+  }
+  if (task_ != nullptr) {
+    vTaskDelete(task_);
+  }
+  if (queue_ != nullptr) {
+    vQueueDelete(queue_);
+  }
+}
+
+esp_err_t HidKeyerPort::Start() {
+  if (task_ != nullptr) {
+    return ESP_ERR_INVALID_STATE;
+  }
+  queue_ = xQueueCreate(kQueueLength, sizeof(Edge));
+  if (queue_ == nullptr) {
+    return ESP_ERR_NO_MEM;
+  }
+  g_port = this;
+  if (system_monitor::CreateTask(system_monitor::TaskId::kUsbHid, &TaskThunk, this, &task_) != pdPASS) {
+    task_ = nullptr;
+    g_port = nullptr;
+    return ESP_ERR_NO_MEM;
+  }
+  ESP_LOGI(kLogTag, "HID keyboard output: %s (Left Ctrl = dit, Right Ctrl = dah)",
+           HidKeyerModeName(keyer_.mode()));
+  return ESP_OK;
+}
+
+void IRAM_ATTR HidKeyerPort::PaddleTapFromIsr(const hal::PaddleEvent& event,
+                                              BaseType_t* higher_priority_task_woken, void* context) {
+  auto* port = static_cast<HidKeyerPort*>(context);
+  if (port == nullptr || port->task_ == nullptr || event.line == hal::PaddleLine::kFocus) {
+    return;
+  }
+  const Edge edge{event.line, false, event.active, event.timestamp_us};
+  if (xQueueSendFromISR(port->queue_, &edge, higher_priority_task_woken) != pdTRUE) {
+    port->dropped_edges_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  vTaskNotifyGiveFromISR(port->task_, higher_priority_task_woken);
+}
+
+void HidKeyerPort::KeyTap(bool key_active, int64_t timestamp_us, void* context) {
+  auto* port = static_cast<HidKeyerPort*>(context);
+  if (port == nullptr || port->task_ == nullptr) {
+    return;
+  }
+  const Edge edge{hal::PaddleLine::kKey, true, key_active, timestamp_us};
+  if (xQueueSend(port->queue_, &edge, 0) != pdTRUE) {
+    port->dropped_edges_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  xTaskNotifyGive(port->task_);
+}
+
+void HidKeyerPort::ResetStats() {
+  latency_.Reset();
+  reports_sent_.store(0, std::memory_order_relaxed);
+  dropped_edges_.store(0, std::memory_order_relaxed);
+}
+
+void HidKeyerPort::OnReportDelivered() {
+  const int64_t edge_us = in_flight_edge_us_.exchange(-1);
+  if (edge_us >= 0) {
+    latency_.Record(static_cast<uint32_t>(esp_timer_get_time() - edge_us));
+  }
+  // The endpoint is free again: send what changed while this report was on the bus
+  if (task_ != nullptr) {
+    xTaskNotifyGive(task_);
+  }
+}
+
+void HidKeyerPort::TaskThunk(void* arg) {
+  static_cast<HidKeyerPort*>(arg)->TaskLoop();
+}
+
+void HidKeyerPort::TaskLoop() {
+  while (true) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    Edge edge;
+    while (xQueueReceive(queue_, &edge, 0) == pdTRUE) {
+      if (edge.keyed) {
+        keyer_.OnKeyEdge(edge.active, edge.timestamp_us);
+      } else {
+        keyer_.OnPaddleEdge(edge.line, edge.active, edge.timestamp_us);
+      }
+    }
+    SendPending();
+  }
+}
+
+void HidKeyerPort::SendPending() {
+  // Previous report still waiting for the host poll: OnReportDelivered() wakes us again.
+  // Not mounted: the state is sent with the next edge after enumeration.
+  if (!tud_hid_ready()) {
+    return;
+  }
+  uint8_t modifiers = 0;
+  int64_t edge_us = 0;
+  if (!keyer_.TakeReport(&modifiers, &edge_us)) {
+    return;
+  }
+  in_flight_edge_us_.store(edge_us);
+  if (tud_hid_keyboard_report(0, modifiers, nullptr)) {
+    reports_sent_.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    in_flight_edge_us_.store(-1);
+    ESP_LOGW(kLogTag, "Keyboard report rejected (modifiers 0x%02X)", modifiers);
+  }
+}
+
+}  // namespace usb_hid
+
+//==============================================================================
+// TinyUSB HID callbacks (C linkage, required with CONFIG_TINYUSB_HID_COUNT)
+//==============================================================================
+
+extern "C" uint8_t const* tud_hid_descriptor_report_cb(uint8_t instance) {
+  (void)instance;
+  return usb_hid::kHidReportDescriptor;
+}
+
+extern "C" uint16_t tud_hid_get_report_cb(uint8_t instance, uint8_t report_id, hid_report_type_t report_type,
+                                          uint8_t* buffer, uint16_t reqlen) {
+  (void)instance;
+  (void)report_id;
+  (void)report_type;
+  (void)buffer;
+  (void)reqlen;
+  return 0;
+}
+
+extern "C" void tud_hid_set_report_cb(uint8_t instance, uint8_t report_id, hid_report_type_t report_type,
+                                      uint8_t const* buffer, uint16_t bufsize) {
+  // Keyboard LED output reports are ignored
+  (void)instance;
+  (void)report_id;
+  (void)report_type;
+  (void)buffer;
+  (void)bufsize;
+}
+
+extern "C" void tud_hid_report_complete_cb(uint8_t instance, uint8_t const* report, uint16_t len) {
+  (void)instance;
+  (void)report;
+  (void)len;
+  if (usb_hid::g_port != nullptr) {
+    usb_hid::g_port->OnReportDelivered();
+  }
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+/**
+ * @file hid_keyer.hpp
+ * @brief Keyboard-report state and latency statistics for the USB HID keyer output
+ *
+ * Online practice sites (VBand and similar) read a paddle as keyboard
+ * modifiers: Left Ctrl = dit, Right Ctrl = dah. HidKeyer turns key edges into
+ * that modifier byte, either from the raw paddle lines or from the keyed
+ * output, and remembers the timestamp of the oldest edge each report carries
+ * so the delivery latency can be measured against the GPIO edge.
+ *
+ * Pure logic: no TinyUSB or FreeRTOS calls (see HidKeyerPort for the USB side).
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#include "hal/paddle_hal.hpp"
+
+namespace usb_hid {
+
+enum class HidKeyerMode : uint8_t {
+  kOff = 0,      ///< No HID interface
+  kPaddles = 1,  ///< Raw paddle and straight key lines
+  kKeyed = 2,    ///< Keyed output (what goes to TX)
+};
+
+/// Short name ("off", "paddles", "keyed")
+const char* HidKeyerModeName(HidKeyerMode mode);
+
+/// Boot keyboard modifier bits
+constexpr uint8_t kModifierLeftCtrl = 0x01;
+constexpr uint8_t kModifierRightCtrl = 0x10;
+
+/**
+ * @class HidKeyer
+ * @brief Modifier state mirrored from key edges, with per-report edge timestamps
+ *
+ * Owned by a single task; not thread-safe.
+ */
+class HidKeyer {
+ public:
+  explicit HidKeyer(HidKeyerMode mode = HidKeyerMode::kPaddles) : mode_(mode) {}
+
+  HidKeyerMode mode() const { return mode_; }
+
+  /**
+   * @brief Raw paddle edge (kPaddles mode; ignored otherwise)
+   *
+   * Dit and straight key press Left Ctrl, dah presses Right Ctrl. Focus
+   * switches are ignored.
+   */
+  void OnPaddleEdge(hal::PaddleLine line, bool active, int64_t timestamp_us);
+
+  /// Keyed output edge (kKeyed mode, Left Ctrl; ignored otherwise)
+  void OnKeyEdge(bool key_active, int64_t timestamp_us);
+
+  /**
+   * @brief Take the next report if the modifiers changed since the last one
+   * @param modifiers Output: modifier byte to send
+   * @param edge_us Output: timestamp of the oldest edge folded into it
+   * @return false if there is nothing new to send
+   */
+  bool TakeReport(uint8_t* modifiers, int64_t* edge_us);
+
+  /// Current modifier byte (including changes not yet taken)
+  uint8_t modifiers() const;
+
+ private:
+  void Apply(uint8_t input_bit, bool active, int64_t timestamp_us);
+
+  HidKeyerMode mode_;
+  uint8_t inputs_ = 0;  ///< One bit per mirrored input (dit, dah, key, keyed)
+  uint8_t reported_ = 0;
+  bool dirty_ = false;
+  int64_t oldest_edge_us_ = 0;
+};
+
+struct HidLatencySummary {
+  uint32_t samples = 0;
+  uint32_t last_us = 0;
+  uint32_t min_us = 0;
+  uint32_t max_us = 0;
+  uint32_t mean_us = 0;
+  uint32_t over_2ms = 0;  ///< Reports that took longer than two 1 ms polls
+};
+
+/**
+ * @class HidLatencyStats
+ * @brief GPIO-edge-to-report-delivered latency
+ *
+ * Recorded from the TinyUSB task, read by console/HTTP: all methods lock.
+ */
+class HidLatencyStats {
+ public:
+  void Record(uint32_t latency_us);
+  HidLatencySummary Get() const;
+  void Reset();
+
+ private:
+  mutable std::mutex mutex_;
+  HidLatencySummary summary_;
+  uint64_t sum_us_ = 0;
+};
+
+}  // namespace usb_hid
@@ -0,0 +1,96 @@
+#pragma once
+
+/**
+ * @file hid_keyer_port.hpp
+ * @brief USB HID keyboard interface mirroring the paddles or the keyed output
+ *
+ * With general.usb_hid set, usb_early_init() installs a configuration
+ * descriptor with a boot keyboard on an interrupt IN endpoint polled every
+ * 1 ms. The ESP32-S3 has no IN endpoint left for it next to two CDC ports,
+ * so the keyboard takes the place of the debug log port: one CDC port (the
+ * console) plus the keyboard. HidKeyerPort feeds it:
+ *
+ *   paddle ISR ─▶ PaddleTapFromIsr() ─▶ queue + notify ─▶ "usb_hid" task ─▶ tud_hid_keyboard_report()
+ *   keyed output (main loop) ─▶ KeyTap() ────────────────┘
+ *
+ * Raw paddle edges never wait for the main loop tick. Latency is measured
+ * from the GPIO edge timestamp to the moment the host has collected the
+ * report (tud_hid_report_complete_cb).
+ */
+
+#include <atomic>
+#include <cstdint>
+
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+#include "hal/paddle_hal.hpp"
+#include "usb_hid/hid_keyer.hpp"
+
+namespace usb_hid {
+
+class HidKeyerPort {
+ public:
+  explicit HidKeyerPort(HidKeyerMode mode) : keyer_(mode) {}
+  ~HidKeyerPort();
+
+  HidKeyerPort(const HidKeyerPort&) = delete;
+  HidKeyerPort& operator=(const HidKeyerPort&) = delete;
+
+  /**
+   * @brief Full-speed configuration descriptor: one CDC port (console) + HID keyboard
+   *
+   * Passed to tinyusb_driver_install() in place of the Kconfig default
+   * (dual CDC) when the HID output is enabled. Selected at boot only.
+   */
+  static const uint8_t* FullSpeedConfigDescriptor();
+
+  /// Create the report task (one port per boot)
+  esp_err_t Start();
+
+  HidKeyerMode mode() const { return keyer_.mode(); }
+
+  /**
+   * @brief KeyingSubsystem paddle tap (ISR context, IRAM)
+   * @param context HidKeyerPort instance
+   */
+  static void PaddleTapFromIsr(const hal::PaddleEvent& event, BaseType_t* higher_priority_task_woken,
+                               void* context);
+
+  /**
+   * @brief KeyingSubsystem keyed output tap (main loop)
+   * @param context HidKeyerPort instance
+   */
+  static void KeyTap(bool key_active, int64_t timestamp_us, void* context);
+
+  HidLatencySummary latency() const { return latency_.Get(); }
+  void ResetStats();
+  uint32_t reports_sent() const { return reports_sent_.load(std::memory_order_relaxed); }
+  uint32_t dropped_edges() const { return dropped_edges_.load(std::memory_order_relaxed); }
+
+  /// Called from tud_hid_report_complete_cb (TinyUSB task)
+  void OnReportDelivered();
+
+ private:
+  struct Edge {
+    hal::PaddleLine line;
+    bool keyed;  ///< Keyed output edge (line unused)
+    bool active;
+    int64_t timestamp_us;
+  };
+
+  static void TaskThunk(void* arg);
+  void TaskLoop();
+  void SendPending();
+
+  HidKeyer keyer_;  ///< Report task only
+  QueueHandle_t queue_ = nullptr;
+  TaskHandle_t task_ = nullptr;
+  HidLatencyStats latency_;
+  std::atomic<int64_t> in_flight_edge_us_{-1};  ///< Edge timestamp of the report on the bus
+  std::atomic<uint32_t> reports_sent_{0};
+  std::atomic<uint32_t> dropped_edges_{0};
+};
+
+}  // namespace usb_hid
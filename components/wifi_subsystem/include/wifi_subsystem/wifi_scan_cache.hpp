@@ -0,0 +1,113 @@
+#pragma once
+
+/**
+ * @file wifi_scan_cache.hpp
+ * @brief Bounded WiFi scan results plus the policy deciding when to rescan
+ *
+ * A scan takes the radio off the home channel for a few seconds, which stalls
+ * AP clients and any CWNet session. HTTP handlers therefore never scan: they
+ * Request() and read a Snapshot() immediately, with its age. WiFiSubsystem::Tick()
+ * asks ShouldStart() and runs the scan in the background.
+ *
+ * Policy:
+ * - A Request() marks interest for interest_window_ms. While someone is
+ *   interested the cache is refreshed every refresh_interval_ms.
+ * - A Request() on results older than min_interval_ms asks for a scan right
+ *   away; scans never start closer than min_interval_ms apart.
+ * - Nothing starts while suppressed (remote keying session active); the
+ *   request stays pending until the suppression ends.
+ *
+ * Complete() keeps one entry per SSID (strongest), drops hidden networks and
+ * channels outside 2.4 GHz, and sorts by RSSI (strongest first).
+ *
+ * Thread safety: all methods are safe from any task (not from ISRs).
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace wifi_subsystem {
+
+constexpr size_t kMaxScanResults = 20;
+/// Snapshot age when no scan has completed yet
+constexpr uint32_t kScanAgeNever = UINT32_MAX;
+
+/// One network (authmode holds the wifi_auth_mode_t value)
+struct WifiScanEntry {
+  char ssid[33] = "";
+  int8_t rssi = 0;
+  uint8_t authmode = 0;
+  uint8_t channel = 0;
+};
+
+struct WifiScanPolicy {
+  uint32_t refresh_interval_ms = 60000;   ///< Periodic refresh while interested
+  uint32_t min_interval_ms = 15000;       ///< Rate limit of on-demand scans
+  uint32_t interest_window_ms = 120000;   ///< Interest lifetime after a Request()
+};
+
+struct WifiScanSnapshot {
+  size_t count = 0;
+  uint32_t age_ms = kScanAgeNever;  ///< Since the last completed scan
+  bool scanning = false;
+  bool suppressed = false;
+  uint32_t scans = 0;               ///< Completed scans since boot
+};
+
+/**
+ * @class WifiScanCache
+ * @brief Scan results and refresh schedule shared by the WiFi task and HTTP handlers
+ */
+class WifiScanCache {
+ public:
+  explicit WifiScanCache(const WifiScanPolicy& policy = WifiScanPolicy{}) : policy_(policy) {}
+
+  WifiScanCache(const WifiScanCache&) = delete;
+  WifiScanCache& operator=(const WifiScanCache&) = delete;
+
+  /// Mark interest; ask for a scan if the results are older than min_interval_ms
+  void Request(uint32_t now_ms);
+
+  /// Someone asked for results within interest_window_ms
+  bool Interested(uint32_t now_ms) const;
+
+  /**
+   * @brief Decide whether a scan starts now (marks it running when it does)
+   * @param suppressed A remote keying session is active
+   */
+  bool ShouldStart(uint32_t now_ms, bool suppressed);
+
+  /// Replace the results with a finished scan (raw driver records, any order)
+  void Complete(const WifiScanEntry* raw, size_t count, uint32_t now_ms);
+
+  /// The running scan failed, timed out or was cancelled; results are kept
+  void Abort();
+
+  bool scanning() const;
+
+  /**
+   * @brief Copy the cached results, strongest first
+   * @return Number written to out
+   */
+  size_t Snapshot(WifiScanEntry* out, size_t max, uint32_t now_ms, WifiScanSnapshot* info) const;
+
+ private:
+  const WifiScanPolicy policy_;
+
+  mutable std::mutex mutex_;
+  WifiScanEntry results_[kMaxScanResults];
+  size_t count_ = 0;
+  bool has_results_ = false;
+  uint32_t completed_ms_ = 0;
+  bool has_interest_ = false;
+  uint32_t interest_ms_ = 0;
+  bool pending_ = false;
+  bool scanning_ = false;
+  bool suppressed_ = false;
+  bool started_once_ = false;
+  uint32_t started_ms_ = 0;
+  uint32_t scans_ = 0;
+};
+
+}  // namespace wifi_subsystem
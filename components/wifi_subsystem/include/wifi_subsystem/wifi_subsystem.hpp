@@ -21,6 +21,15 @@
  * 3. Query status via GetStatus()
  * 4. Reconfigure via SetConfig() + Reconnect()
  *
+ * BACKGROUND SCAN:
+ * A scan takes the radio off the home channel, which stalls AP clients and any
+ * CWNet session. ScanNetworks() never scans: it returns the cached list (see
+ * wifi_scan_cache.hpp) and registers interest. Tick() starts a non-blocking
+ * scan when the cache policy asks for one and collects the records on
+ * WIFI_EVENT_SCAN_DONE. In AP mode the STA interface is added (APSTA) while
+ * someone is interested. SetScanSuppressed(true) holds back new scans and
+ * cancels a running one while a remote keying session is active.
+ *
  * THREAD SAFETY:
  * - Initialize/Deinitialize: Must be called from main task
  * - Tick: Must be called from main loop (not ISR-safe)
@@ -40,6 +49,7 @@ extern "C" {
 }
 
 #include "config/device_config.hpp"
+#include "wifi_subsystem/wifi_scan_cache.hpp"
 
 // Forward declaration to avoid circular dependency
 namespace diagnostics_subsystem {
@@ -167,21 +177,42 @@ class WiFiSubsystem {
   bool IsInitialized() const { return initialized_; }
 
   /**
-   * @brief Scan for available WiFi networks
+   * @brief Cached WiFi networks (non-blocking)
    *
-   * Performs a blocking WiFi scan (blocks for 3-5 seconds).
-   * Returns networks sorted by RSSI (strongest first).
-   * Filters out duplicate SSIDs (keeps strongest signal) and 5GHz networks.
+   * Returns the result of the last background scan immediately, strongest
+   * first, one entry per SSID, 2.4 GHz only. Also requests a refresh: a scan
+   * starts from Tick() if the results are older than the rate limit and no
+   * remote keying session suppresses scanning.
    *
    * @param results Output vector of scan results (cleared before filling)
-   * @param max_results Maximum number of results to return (default: 20)
-   * @return ESP_OK on success, ESP_ERR_INVALID_STATE if scan already in progress,
-   *         ESP_ERR_TIMEOUT if scan times out (>5 seconds)
+   * @param max_results Maximum number of results to return (at most kMaxScanResults)
+   * @param info Optional age/scanning/suppressed state of the cache
+   * @return ESP_OK on success, ESP_ERR_INVALID_STATE if WiFi is not initialized
+   *
+   * @note Thread-safe (called from HTTP handlers).
+   */
+  esp_err_t ScanNetworks(std::vector<WifiScanResult>& results, uint16_t max_results = 20,
+                         WifiScanSnapshot* info = nullptr);
+
+  /**
+   * @brief Hold back background scans (remote keying session active)
+   *
+   * A scan already running is cancelled on the next Tick(). Thread-safe.
+   */
+  void SetScanSuppressed(bool suppressed) {
+    scan_suppressed_.store(suppressed, std::memory_order_release);
+  }
+
+  /**
+   * @brief Radio low-latency mode for active remote sessions
    *
-   * @note This method is NOT thread-safe. Do not call concurrently.
-   * @note Scan timeout is 5 seconds. If no results after 5s, returns empty vector.
+   * true disables modem power-save (WIFI_PS_NONE) so frames are not held
+   * until the next DTIM wake-up; false restores the previous power-save mode.
+   * Call from the main loop; repeated calls with the same value do nothing.
    */
-  esp_err_t ScanNetworks(std::vector<WifiScanResult>& results, uint16_t max_results = 20);
+  void SetLowLatency(bool enable);
+
+  bool IsLowLatency() const { return low_latency_; }
 
   /**
    * @brief Get number of clients connected to AP
@@ -230,6 +261,26 @@ class WiFiSubsystem {
    */
   void FallbackToAp();
 
+  /**
+   * @brief Background scan state machine (start, collect, timeout, APSTA revert)
+   */
+  void TickScan(uint32_t now_ms);
+
+  /**
+   * @brief Start a non-blocking scan (adds the STA interface in AP mode)
+   */
+  esp_err_t StartScan();
+
+  /**
+   * @brief Fetch the driver's records after WIFI_EVENT_SCAN_DONE into the cache
+   */
+  void CollectScanResults(uint32_t now_ms);
+
+  /**
+   * @brief Drop a running scan (timeout, suppression, WiFi stop)
+   */
+  void CancelScan();
+
   config::WiFiConfig config_{};
   std::atomic<WiFiMode> mode_{WiFiMode::kIdle};
   std::atomic<bool> ready_{false};
@@ -247,6 +298,15 @@ class WiFiSubsystem {
 
   // WiFi scan state tracking
   std::atomic<bool> scan_in_progress_{false};  ///< True if scan is currently running
+  std::atomic<bool> scan_done_{false};         ///< WIFI_EVENT_SCAN_DONE seen, records not fetched yet
+  std::atomic<bool> scan_suppressed_{false};   ///< Remote keying session active
+  std::atomic<bool> scan_apsta_{false};        ///< STA interface added to AP mode for scanning
+  uint32_t scan_start_ms_ = 0;
+  WifiScanCache scan_cache_;
+
+  // Low-latency radio profile (main loop only)
+  bool low_latency_ = false;
+  wifi_ps_type_t saved_ps_ = WIFI_PS_MIN_MODEM;
   uint32_t last_client_check_ms_ = 0;          ///< Last time client count was checked
   std::atomic<uint8_t> connected_clients_{0};  ///< Cached client count (updated every 5s)
 };
@@ -0,0 +1,121 @@
+#include "wifi_subsystem/wifi_scan_cache.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace wifi_subsystem {
+
+namespace {
+
+/// Milliseconds from since_ms to now_ms; 0 if a caller's clock read predates since_ms
+uint32_t Elapsed(uint32_t now_ms, uint32_t since_ms) {
+  const int32_t delta = static_cast<int32_t>(now_ms - since_ms);
+  return delta > 0 ? static_cast<uint32_t>(delta) : 0;
+}
+
+}  // namespace
+
+void WifiScanCache::Request(uint32_t now_ms) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  has_interest_ = true;
+  interest_ms_ = now_ms;
+  if (!has_results_ || Elapsed(now_ms, completed_ms_) >= policy_.min_interval_ms) {
+    pending_ = true;
+  }
+}
+
+bool WifiScanCache::Interested(uint32_t now_ms) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return has_interest_ && Elapsed(now_ms, interest_ms_) < policy_.interest_window_ms;
+}
+
+bool WifiScanCache::ShouldStart(uint32_t now_ms, bool suppressed) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  suppressed_ = suppressed;
+  if (scanning_ || suppressed) {
+    return false;
+  }
+  if (started_once_ && Elapsed(now_ms, started_ms_) < policy_.min_interval_ms) {
+    return false;
+  }
+  const bool interested = has_interest_ && Elapsed(now_ms, interest_ms_) < policy_.interest_window_ms;
+  const bool stale = !has_results_ || Elapsed(now_ms, completed_ms_) >= policy_.refresh_interval_ms;
+  if (!pending_ && !(interested && stale)) {
+    return false;
+  }
+  pending_ = false;
+  scanning_ = true;
+  started_once_ = true;
+  started_ms_ = now_ms;
+  return true;
+}
+
+void WifiScanCache::Complete(const WifiScanEntry* raw, size_t count, uint32_t now_ms) {
+  WifiScanEntry merged[kMaxScanResults];
+  size_t merged_count = 0;
+  for (size_t i = 0; i < count; ++i) {
+    const WifiScanEntry& entry = raw[i];
+    if (entry.ssid[0] == '\0' || entry.channel == 0 || entry.channel > 14) {
+      continue;  // Hidden network or not 2.4 GHz
+    }
+    WifiScanEntry* slot = nullptr;
+    for (size_t j = 0; j < merged_count; ++j) {
+      if (std::strncmp(merged[j].ssid, entry.ssid, sizeof(entry.ssid)) == 0) {
+        slot = &merged[j];
+        break;
+      }
+    }
+    if (slot == nullptr && merged_count < kMaxScanResults) {
+      merged[merged_count++] = entry;
+      continue;
+    }
+    if (slot == nullptr) {
+      // Full: the new network displaces the weakest one if it is stronger
+      slot = std::min_element(merged, merged + merged_count,
+                              [](const WifiScanEntry& a, const WifiScanEntry& b) { return a.rssi < b.rssi; });
+    }
+    if (entry.rssi > slot->rssi) {
+      *slot = entry;
+    }
+  }
+  for (size_t i = 0; i < merged_count; ++i) {
+    merged[i].ssid[sizeof(merged[i].ssid) - 1] = '\0';
+  }
+  std::stable_sort(merged, merged + merged_count,
+                   [](const WifiScanEntry& a, const WifiScanEntry& b) { return a.rssi > b.rssi; });
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::copy(merged, merged + merged_count, results_);
+  count_ = merged_count;
+  has_results_ = true;
+  completed_ms_ = now_ms;
+  scanning_ = false;
+  ++scans_;
+}
+
+void WifiScanCache::Abort() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  scanning_ = false;
+}
+
+bool WifiScanCache::scanning() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return scanning_;
+}
+
+size_t WifiScanCache::Snapshot(WifiScanEntry* out, size_t max, uint32_t now_ms,
+                               WifiScanSnapshot* info) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const size_t count = std::min(max, count_);
+  std::copy(results_, results_ + count, out);
+  if (info != nullptr) {
+    info->count = count;
+    info->age_ms = has_results_ ? Elapsed(now_ms, completed_ms_) : kScanAgeNever;
+    info->scanning = scanning_;
+    info->suppressed = suppressed_;
+    info->scans = scans_;
+  }
+  return count;
+}
+
+}  // namespace wifi_subsystem
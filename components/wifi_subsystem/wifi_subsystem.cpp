@@ -2,12 +2,15 @@
 
 #include <algorithm>
 #include <cstring>
+#include <memory>
+#include <new>
 #include <string>
 #include <unordered_map>
 
 extern "C" {
 #include "esp_log.h"
 #include "esp_mac.h"
+#include "esp_timer.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/event_groups.h"
 }
@@ -23,6 +26,13 @@ constexpr char kLogTag[] = "WiFiSubsystem";
 constexpr uint8_t kMaxStaRetries = 3;  // Retry 3 times before AP fallback
 constexpr uint32_t kStaRetryDelayMs = 5000;  // Wait 5s between retries
 
+// Background scan: short active dwell per channel keeps each off-channel
+// excursion brief (the driver returns to the home channel between channels)
+constexpr uint32_t kScanDwellMinMs = 30;
+constexpr uint32_t kScanDwellMaxMs = 80;
+constexpr uint32_t kScanTimeoutMs = 8000;
+constexpr uint16_t kMaxScanRecords = 32;  // Driver records fetched per scan (heap, transient)
+
 }  // namespace
 
 WiFiSubsystem::~WiFiSubsystem() {
@@ -144,6 +154,7 @@ void WiFiSubsystem::Deinitialize() {
   }
 
   initialized_ = false;
+  low_latency_ = false;
   mode_.store(WiFiMode::kIdle, std::memory_order_release);
   ready_.store(false, std::memory_order_release);
   ESP_LOGI(kLogTag, "WiFi subsystem deinitialized");
@@ -193,7 +204,7 @@ esp_err_t WiFiSubsystem::StartStaMode() {
 esp_err_t WiFiSubsystem::StartApMode() {
   ESP_LOGI(kLogTag, "Starting AP mode (SSID: %s)", config_.ap_ssid);
 
-  // Configure WiFi mode to AP only (ScanNetworks will temporarily switch to APSTA when needed)
+  // Configure WiFi mode to AP only (TickScan adds the STA interface while a scan is wanted)
   esp_err_t err = esp_wifi_set_mode(WIFI_MODE_AP);
   if (err != ESP_OK) {
     ESP_LOGE(kLogTag, "Failed to set AP mode: %s", esp_err_to_name(err));
@@ -243,6 +254,8 @@ void WiFiSubsystem::StopWiFi() {
     return;
   }
 
+  CancelScan();
+  scan_apsta_.store(false, std::memory_order_release);
   esp_wifi_disconnect();
   esp_wifi_stop();
   mode_.store(WiFiMode::kIdle, std::memory_order_release);
@@ -304,6 +317,8 @@ void WiFiSubsystem::Tick(uint32_t now_ms) {
       last_client_check_ms_ = now_ms;
     }
   }
+
+  TickScan(now_ms);
 }
 
 WiFiStatus WiFiSubsystem::GetStatus() const {
@@ -370,6 +385,9 @@ void WiFiSubsystem::EventHandler(void* arg, esp_event_base_t event_base,
   if (event_base == WIFI_EVENT) {
     switch (event_id) {
       case WIFI_EVENT_STA_START:
+        if (self->scan_apsta_.load(std::memory_order_acquire)) {
+          break;  // STA interface added to AP mode for scanning only
+        }
         ESP_LOGI(kLogTag, "STA started, attempting connection...");
         esp_wifi_connect();
         break;
@@ -397,6 +415,11 @@ void WiFiSubsystem::EventHandler(void* arg, esp_event_base_t event_base,
         ESP_LOGI(kLogTag, "AP started");
         break;
 
+      case WIFI_EVENT_SCAN_DONE:
+        // Records are fetched from Tick(), not on the event task
+        self->scan_done_.store(true, std::memory_order_release);
+        break;
+
       case WIFI_EVENT_AP_STACONNECTED: {
         auto* event = static_cast<wifi_event_ap_staconnected_t*>(event_data);
         ESP_LOGI(kLogTag, "Client connected to AP (MAC: " MACSTR ")",
@@ -441,13 +464,164 @@ void WiFiSubsystem::FallbackToAp() {
   StartApMode();
 }
 
-esp_err_t WiFiSubsystem::ScanNetworks(std::vector<WifiScanResult>& results, uint16_t max_results) {
-  // WiFi scan disabled - captive portal uses manual SSID entry only
+esp_err_t WiFiSubsystem::ScanNetworks(std::vector<WifiScanResult>& results, uint16_t max_results,
+                                      WifiScanSnapshot* info) {
   results.clear();
-  ESP_LOGI(kLogTag, "WiFi scan disabled (manual entry only)");
+  if (!initialized_) {
+    return ESP_ERR_INVALID_STATE;
+  }
+
+  const uint32_t now_ms = static_cast<uint32_t>(esp_timer_get_time() / 1000);
+  scan_cache_.Request(now_ms);
+
+  WifiScanEntry entries[kMaxScanResults];
+  const size_t count = scan_cache_.Snapshot(
+      entries, std::min<size_t>(max_results, kMaxScanResults), now_ms, info);
+  results.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    WifiScanResult result = {};
+    std::memcpy(result.ssid, entries[i].ssid, sizeof(result.ssid));
+    result.rssi = entries[i].rssi;
+    result.authmode = static_cast<wifi_auth_mode_t>(entries[i].authmode);
+    result.channel = entries[i].channel;
+    results.push_back(result);
+  }
   return ESP_OK;
 }
 
+void WiFiSubsystem::TickScan(uint32_t now_ms) {
+  const bool suppressed = scan_suppressed_.load(std::memory_order_acquire);
+
+  if (scan_in_progress_.load(std::memory_order_acquire)) {
+    if (scan_done_.exchange(false, std::memory_order_acq_rel)) {
+      CollectScanResults(now_ms);
+    } else if (suppressed) {
+      ESP_LOGI(kLogTag, "Remote session active, cancelling WiFi scan");
+      CancelScan();
+    } else if (now_ms - scan_start_ms_ >= kScanTimeoutMs) {
+      ESP_LOGW(kLogTag, "WiFi scan timed out after %u ms", static_cast<unsigned>(kScanTimeoutMs));
+      CancelScan();
+    }
+    return;
+  }
+
+  // Drop the scan-only STA interface once nobody is looking at the results
+  if (scan_apsta_.load(std::memory_order_acquire) && !scan_cache_.Interested(now_ms)) {
+    if (esp_wifi_set_mode(WIFI_MODE_AP) == ESP_OK) {
+      scan_apsta_.store(false, std::memory_order_release);
+    }
+  }
+
+  const WiFiMode mode = mode_.load(std::memory_order_acquire);
+  if (mode != WiFiMode::kApActive && mode != WiFiMode::kStaConnected) {
+    return;  // No scanning while the STA connection is being set up
+  }
+  if (!scan_cache_.ShouldStart(now_ms, suppressed)) {
+    return;
+  }
+
+  const esp_err_t err = StartScan();
+  if (err != ESP_OK) {
+    ESP_LOGW(kLogTag, "Failed to start WiFi scan: %s", esp_err_to_name(err));
+    scan_cache_.Abort();
+    return;
+  }
+  scan_start_ms_ = now_ms;
+}
+
+esp_err_t WiFiSubsystem::StartScan() {
+  wifi_mode_t wifi_mode = WIFI_MODE_NULL;
+  esp_err_t err = esp_wifi_get_mode(&wifi_mode);
+  if (err != ESP_OK) {
+    return err;
+  }
+  if (wifi_mode == WIFI_MODE_AP) {
+    // Scanning needs the STA interface; STA_START must not trigger a connect
+    scan_apsta_.store(true, std::memory_order_release);
+    err = esp_wifi_set_mode(WIFI_MODE_APSTA);
+    if (err != ESP_OK) {
+      scan_apsta_.store(false, std::memory_order_release);
+      return err;
+    }
+  }
+
+  wifi_scan_config_t scan_cfg = {};
+  scan_cfg.show_hidden = false;
+  scan_cfg.scan_type = WIFI_SCAN_TYPE_ACTIVE;
+  scan_cfg.scan_time.active.min = kScanDwellMinMs;
+  scan_cfg.scan_time.active.max = kScanDwellMaxMs;
+
+  scan_done_.store(false, std::memory_order_release);
+  err = esp_wifi_scan_start(&scan_cfg, false);  // Non-blocking: WIFI_EVENT_SCAN_DONE follows
+  if (err == ESP_OK) {
+    scan_in_progress_.store(true, std::memory_order_release);
+  }
+  return err;
+}
+
+void WiFiSubsystem::CollectScanResults(uint32_t now_ms) {
+  scan_in_progress_.store(false, std::memory_order_release);
+
+  uint16_t count = kMaxScanRecords;
+  std::unique_ptr<wifi_ap_record_t[]> records(new (std::nothrow) wifi_ap_record_t[count]);
+  std::unique_ptr<WifiScanEntry[]> entries(new (std::nothrow) WifiScanEntry[count]);
+  if (!records || !entries) {
+    ESP_LOGW(kLogTag, "No memory for WiFi scan records");
+    esp_wifi_clear_ap_list();
+    scan_cache_.Abort();
+    return;
+  }
+
+  // Also releases the driver's list beyond the first kMaxScanRecords
+  const esp_err_t err = esp_wifi_scan_get_ap_records(&count, records.get());
+  if (err != ESP_OK) {
+    ESP_LOGW(kLogTag, "Failed to read WiFi scan records: %s", esp_err_to_name(err));
+    scan_cache_.Abort();
+    return;
+  }
+
+  for (uint16_t i = 0; i < count; ++i) {
+    std::memcpy(entries[i].ssid, records[i].ssid, sizeof(entries[i].ssid) - 1);
+    entries[i].ssid[sizeof(entries[i].ssid) - 1] = '\0';
+    entries[i].rssi = records[i].rssi;
+    entries[i].authmode = static_cast<uint8_t>(records[i].authmode);
+    entries[i].channel = records[i].primary;
+  }
+  scan_cache_.Complete(entries.get(), count, now_ms);
+  ESP_LOGI(kLogTag, "WiFi scan complete: %u records in %u ms", static_cast<unsigned>(count),
+           static_cast<unsigned>(now_ms - scan_start_ms_));
+}
+
+void WiFiSubsystem::CancelScan() {
+  if (!scan_in_progress_.exchange(false, std::memory_order_acq_rel)) {
+    return;
+  }
+  esp_wifi_scan_stop();
+  esp_wifi_clear_ap_list();
+  scan_done_.store(false, std::memory_order_release);
+  scan_cache_.Abort();
+}
+
+void WiFiSubsystem::SetLowLatency(bool enable) {
+  if (!initialized_ || enable == low_latency_) {
+    return;
+  }
+
+  if (enable) {
+    if (esp_wifi_get_ps(&saved_ps_) != ESP_OK) {
+      saved_ps_ = WIFI_PS_MIN_MODEM;
+    }
+  }
+  const esp_err_t err = esp_wifi_set_ps(enable ? WIFI_PS_NONE : saved_ps_);
+  if (err != ESP_OK) {
+    ESP_LOGW(kLogTag, "Failed to %s modem power-save: %s", enable ? "disable" : "restore",
+             esp_err_to_name(err));
+    return;
+  }
+  low_latency_ = enable;
+  ESP_LOGI(kLogTag, "Low-latency radio profile %s", enable ? "on (power-save off)" : "off");
+}
+
 uint8_t WiFiSubsystem::GetConnectedClientCount() const {
   // Only valid in AP mode
   if (mode_.load(std::memory_order_acquire) != WiFiMode::kApActive) {
@@ -0,0 +1,225 @@
+#pragma once
+
+/**
+ * @file winkeyer.hpp
+ * @brief K1EL WinKeyer 3 host protocol emulation (parser, send buffer, element scheduler)
+ *
+ * Contest loggers (N1MM+, Win-Test, DXLog...) drive a WinKeyer over a serial
+ * port with a binary protocol: admin commands (0x00 nn), immediate host
+ * commands (0x01-0x17), buffered commands (0x18-0x1F) and ASCII text. This
+ * class implements that protocol on top of the keyer:
+ *
+ * - Feed() parses host bytes without blocking (partial commands are kept)
+ * - Text and buffered commands go into a 128-byte input buffer with the WK3
+ *   pointer commands (overwrite, insert, null placeholders, backspace)
+ * - PopDue() turns the buffer into key edges with their scheduled timestamps
+ *   (weighting, dit/dah ratio, key compensation, Farnsworth, contest spacing)
+ * - ReadOutput() returns the bytes for the host: status (0xC0 | flags) on
+ *   every change, speed pot reports (0x80 | value) and, with serial echo on,
+ *   each character right after its last element is released
+ * - XOFF is raised above 2/3 of the buffer and dropped below 1/3, so the
+ *   host can stream long messages without overrunning it
+ * - OnPaddlePress() is paddle break-in: the buffer is flushed, a character in
+ *   progress is cut and BREAKIN stays set until the paddle has been idle for
+ *   a word space
+ *
+ * Keyer behaviour that WK exposes through pins (PTT lead/tail, sidetone
+ * frequency, paddle mode) stays with the keyer's own configuration: those
+ * commands are accepted and stored so that "get values" echoes them back.
+ *
+ * Not thread-safe: WinKeyerPort drives it from the main loop only.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include "morse_decoder/morse_encoder.hpp"
+
+namespace winkeyer {
+
+/// Firmware revision reported by "host open" (WK3.1)
+constexpr uint8_t kWinKeyerVersion = 31;
+
+/// Input buffer size (bytes of text and buffered commands, as on WK3)
+constexpr size_t kInputBufferSize = 128;
+
+/// Bytes waiting for the host before new responses are dropped
+constexpr size_t kOutputQueueSize = 64;
+
+/// WK speed limits (speed command, buffered speed, Farnsworth)
+constexpr uint8_t kMinSpeedWpm = 5;
+constexpr uint8_t kMaxSpeedWpm = 99;
+
+/// Status byte flags (low bits of 0xC0 | flags)
+constexpr uint8_t kStatusXoff = 0x01;     ///< Input buffer more than 2/3 full
+constexpr uint8_t kStatusBreakin = 0x02;  ///< Paddle break-in active
+constexpr uint8_t kStatusBusy = 0x04;     ///< Sending (buffer not empty or element in progress)
+constexpr uint8_t kStatusKeydown = 0x08;  ///< Tune (key immediate) active
+constexpr uint8_t kStatusWait = 0x10;     ///< Executing a buffered wait
+
+/// Mode register bits (host command 0x0E)
+constexpr uint8_t kModeContestSpacing = 0x01;
+constexpr uint8_t kModeSerialEcho = 0x04;
+
+/**
+ * @brief Values set by the host that the keyer reports back ("get values")
+ *
+ * Layout follows the WK "load defaults" command (0x0F + 15 bytes).
+ */
+struct WinKeyerSettings {
+  uint8_t mode = kModeSerialEcho;  ///< Mode register
+  uint8_t speed_wpm = 0;           ///< Host speed, 0 = follow the speed pot
+  uint8_t sidetone = 0x05;
+  uint8_t weight = 50;             ///< Mark/space weighting in %, 50 = normal
+  uint8_t lead_in = 0;             ///< PTT lead-in (10 ms units)
+  uint8_t tail = 0;                ///< PTT tail (10 ms units)
+  uint8_t pot_min_wpm = 10;        ///< Speed pot range start
+  uint8_t pot_range_wpm = 25;      ///< Speed pot range width
+  uint8_t first_extension = 0;
+  uint8_t key_compensation = 0;    ///< ms added to every mark (taken from the space)
+  uint8_t farnsworth_wpm = 0;      ///< Character speed when above speed_wpm, 0 = off
+  uint8_t paddle_setpoint = 50;
+  uint8_t ratio = 50;              ///< Dit/dah ratio, 50 = 1:3
+  uint8_t pin_config = 0x05;
+  uint8_t unused = 0xFF;
+};
+
+/**
+ * @class WinKeyer
+ * @brief WK3 command set and send buffer, producing timed key edges
+ */
+class WinKeyer {
+ public:
+  struct Edge {
+    bool key_active = false;
+    int64_t timestamp_us = 0;  ///< Scheduled time (not the time it was popped)
+  };
+
+  WinKeyer();
+
+  WinKeyer(const WinKeyer&) = delete;
+  WinKeyer& operator=(const WinKeyer&) = delete;
+
+  /// Parse host bytes (never blocks; a command split across calls is resumed)
+  void Feed(const uint8_t* data, size_t size, int64_t now_us);
+
+  /**
+   * @brief Next key edge due at now_us
+   * @return false once nothing else is due; call again until it returns false
+   *
+   * Characters are chained on their scheduled timestamps, so tick jitter does
+   * not accumulate into the spacing.
+   */
+  bool PopDue(int64_t now_us, Edge* edge);
+
+  /// Paddle touched: flush the buffer, cut the current character, raise BREAKIN
+  void OnPaddlePress(int64_t now_us);
+
+  /**
+   * @brief Position of the keyer's speed control (the "speed pot")
+   *
+   * While the host is open, a change is reported as 0x80 | (wpm - pot_min),
+   * clamped to the pot range set by the host.
+   */
+  void SetPotSpeed(uint8_t wpm);
+
+  /// Copy pending host-bound bytes into out; returns the number copied
+  size_t ReadOutput(uint8_t* out, size_t max);
+
+  /// Copy pending host-bound bytes without removing them; returns the number copied
+  size_t PeekOutput(uint8_t* out, size_t max) const;
+
+  /// Remove the first count host-bound bytes (the ones accepted by the transport)
+  void ConsumeOutput(size_t count);
+
+  /// Close the host session and restore the defaults; the key-up edge follows from PopDue()
+  void Reset(int64_t now_us);
+
+  bool host_open() const { return host_open_; }
+  bool key_down() const { return key_down_; }
+  uint8_t status() const;
+  size_t buffered() const;
+  uint8_t effective_speed() const;
+  const WinKeyerSettings& settings() const { return settings_; }
+  uint32_t dropped_output() const { return dropped_output_; }
+
+ private:
+  struct Segment {
+    bool key = false;
+    uint32_t duration_us = 0;
+  };
+
+  static constexpr size_t kMaxArgs = 15;
+  static constexpr size_t kMaxSegments = 40;
+  static constexpr int64_t kTuneLimitUs = 100 * 1000000LL;
+
+  void HandleByte(uint8_t byte, int64_t now_us);
+  void ExecuteAdmin(int64_t now_us);
+  void ExecuteHost(int64_t now_us);
+  void ExecutePointer();
+  bool Enqueue(const uint8_t* bytes, size_t count);
+  void ClearBuffer(int64_t now_us);
+  void AbortCharacter(int64_t now_us);
+  bool LoadNext(int64_t now_us);
+  void AppendCharacter(char ch, uint8_t wpm, bool merged);
+  void AppendSegment(bool key, int64_t duration_us);
+  void ApplyDefaults(const uint8_t* values);
+  void UpdateXoff();
+  void Emit(uint8_t byte);
+  void ReportStatus();
+  uint8_t PotByte() const;
+
+  uint8_t Peek(size_t offset) const;
+  bool InWindow(size_t position) const;
+
+  morse_decoder::MorseEncoder encoder_;
+  WinKeyerSettings settings_;
+
+  // Parser
+  uint8_t command_ = 0;
+  uint8_t args_[kMaxArgs]{};
+  size_t arg_count_ = 0;
+  size_t args_needed_ = 0;
+  size_t skip_ = 0;  ///< Payload bytes of unsupported admin commands still to discard
+  bool in_command_ = false;
+
+  // Input buffer (positions are absolute ring indices, as the pointer commands see them)
+  uint8_t ring_[kInputBufferSize]{};
+  size_t send_ = 0;   ///< Next byte to send
+  size_t end_ = 0;    ///< One past the last queued byte
+  size_t input_ = 0;  ///< Where the next host byte goes
+  bool overwrite_ = false;
+  bool xoff_ = false;
+
+  // Element scheduler
+  Segment segments_[kMaxSegments]{};
+  size_t segment_count_ = 0;
+  size_t segment_index_ = 0;
+  size_t echo_index_ = 0;  ///< Segment at whose start the echo is sent
+  char echo_[2]{};
+  size_t echo_count_ = 0;
+  int64_t cursor_us_ = 0;  ///< Scheduled start of segments_[segment_index_]
+  bool idle_ = true;
+  bool key_down_ = false;
+  bool waiting_ = false;
+  uint8_t buffered_speed_ = 0;
+
+  // Host state
+  bool host_open_ = false;
+  bool paused_ = false;
+  bool tune_ = false;
+  int64_t tune_start_us_ = 0;
+  bool breakin_ = false;
+  int64_t breakin_until_us_ = 0;
+  uint8_t pot_wpm_ = 20;
+  uint8_t reported_pot_ = 0xFF;
+  uint8_t reported_status_ = 0;
+
+  // Host-bound bytes
+  uint8_t output_[kOutputQueueSize]{};
+  size_t output_head_ = 0;
+  size_t output_count_ = 0;
+  uint32_t dropped_output_ = 0;
+};
+
+}  // namespace winkeyer
@@ -0,0 +1,72 @@
+#pragma once
+
+/**
+ * @file winkeyer_port.hpp
+ * @brief WinKeyer emulation bound to the USB-CDC service port (console port)
+ *
+ * The service port carries the text console by default. With
+ * winkeyer.enabled the port is handed over to the WinKeyer protocol: the
+ * console stops reading and writing it (SerialConsole::SetPortReleased())
+ * and a logger opens the same COM port as a WK3 at any baud rate.
+ *
+ * Tick() runs in the main loop next to the keying subsystem: it drains the
+ * CDC receive FIFO, forwards the key edges that are due to the keying output
+ * and queues status/echo bytes for the host. Nothing in it blocks.
+ */
+
+#include <cstdint>
+#include <functional>
+
+#include "winkeyer/winkeyer.hpp"
+
+namespace winkeyer {
+
+class WinKeyerPort {
+ public:
+  /// Key output: edge state and its scheduled timestamp
+  using KeyOutput = std::function<void(bool key_active, int64_t timestamp_us)>;
+
+  /// @param cdc_port tinyusb_cdcacm_itf_t of the service port (usb_service_cdc_port())
+  WinKeyerPort(int cdc_port, KeyOutput key_output);
+
+  /**
+   * @brief Take over (true) or release (false) the service port
+   *
+   * Releasing closes the host session and lets go of the key.
+   */
+  void SetEnabled(bool enabled, int64_t now_us);
+  bool enabled() const { return enabled_; }
+
+  /**
+   * @brief Service the port (main loop)
+   * @param pot_wpm Keyer speed, reported to the host as the speed pot
+   */
+  void Tick(int64_t now_us, uint8_t pot_wpm);
+
+  /**
+   * @brief Paddle break-in: flush the buffer and release the key now
+   *
+   * Must run before the paddle engine keys the element (KeyingSubsystem::SetBreakIn()),
+   * otherwise the key-up would cut the operator's element.
+   */
+  void OnPaddlePress(int64_t timestamp_us);
+
+  /// KeyingSubsystem::BreakIn adapter (context = WinKeyerPort*)
+  static void BreakIn(int64_t timestamp_us, void* context);
+
+  const WinKeyer& protocol() const { return protocol_; }
+  uint32_t rx_bytes() const { return rx_bytes_; }
+  uint32_t tx_bytes() const { return tx_bytes_; }
+
+ private:
+  void FlushEdges(int64_t now_us);
+
+  WinKeyer protocol_;
+  int cdc_port_;
+  KeyOutput key_output_;
+  bool enabled_ = false;
+  uint32_t rx_bytes_ = 0;
+  uint32_t tx_bytes_ = 0;
+};
+
+}  // namespace winkeyer
@@ -0,0 +1,683 @@
+#include "winkeyer/winkeyer.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <string>
+
+namespace winkeyer {
+
+namespace {
+
+constexpr size_t kRingMask = kInputBufferSize - 1;
+static_assert((kInputBufferSize & kRingMask) == 0, "Input buffer size must be a power of two");
+
+// Largest queued byte count (one slot stays free to tell full from empty)
+constexpr size_t kRingCapacity = kInputBufferSize - 1;
+
+// Admin sub-commands (0x00 nn)
+constexpr uint8_t kAdminCalibrate = 0x00;
+constexpr uint8_t kAdminReset = 0x01;
+constexpr uint8_t kAdminHostOpen = 0x02;
+constexpr uint8_t kAdminHostClose = 0x03;
+constexpr uint8_t kAdminEcho = 0x04;
+constexpr uint8_t kAdminPaddleA2d = 0x05;
+constexpr uint8_t kAdminSpeedA2d = 0x06;
+constexpr uint8_t kAdminGetValues = 0x07;
+constexpr uint8_t kAdminGetMajorRev = 0x09;
+constexpr uint8_t kAdminLoadEeprom = 0x0D;
+constexpr uint8_t kAdminReadVcc = 0x15;
+constexpr uint8_t kAdminGetMinorRev = 0x17;
+constexpr uint8_t kAdminGetIcType = 0x18;
+constexpr size_t kEepromSize = 256;
+
+// Reply to "read Vcc": the host computes 26214 / value volts, 52 = 5.0 V
+constexpr uint8_t kVccReading = 52;
+
+// Buffered commands (stored in the input buffer with their arguments)
+constexpr uint8_t kBufferedPtt = 0x18;
+constexpr uint8_t kBufferedKey = 0x19;
+constexpr uint8_t kBufferedWait = 0x1A;
+constexpr uint8_t kBufferedMerge = 0x1B;
+constexpr uint8_t kBufferedSpeed = 0x1C;
+constexpr uint8_t kBufferedHscwSpeed = 0x1D;
+constexpr uint8_t kBufferedCancelSpeed = 0x1E;
+constexpr uint8_t kBufferedNop = 0x1F;
+
+constexpr uint8_t kPointerCommand = 0x16;
+constexpr uint8_t kHalfSpace = '|';
+constexpr uint8_t kPlaceholder = 0x00;  ///< Null inserted by the pointer command
+
+constexpr uint8_t kMaxTimedSeconds = 99;  ///< Buffered key-down / wait limit
+constexpr int64_t kUsPerSecond = 1000000;
+constexpr int64_t kDitUsPerWpm = 1200000;  ///< PARIS: dit = 1.2 s / WPM
+
+// Argument bytes after the command byte (0x00-0x1F); pointer and admin
+// commands grow once their sub-command byte is known
+constexpr uint8_t kCommandArgs[0x20] = {
+    1, 1, 1, 1, 2, 3, 1, 0, 0, 1, 0, 1, 1, 1, 1, 15,  // 0x00-0x0F
+    1, 1, 1, 0, 1, 0, 1, 1, 1, 1, 1, 2, 1, 1, 0, 0,   // 0x10-0x1F
+};
+
+size_t AdminPayload(uint8_t sub) {
+  switch (sub) {
+    case kAdminCalibrate:
+    case kAdminEcho:
+    case 0x0E:  // Standalone message
+    case 0x0F:  // Load X1MODE
+    case 0x16:  // Load X2MODE
+    case 0x19:  // Sidetone volume
+      return 1;
+    case 0x13:  // RTTY registers
+      return 2;
+    default:
+      return 0;
+  }
+}
+
+uint8_t Clamp(uint8_t value, uint8_t low, uint8_t high) {
+  return std::min(std::max(value, low), high);
+}
+
+}  // namespace
+
+WinKeyer::WinKeyer() = default;
+
+void WinKeyer::Feed(const uint8_t* data, size_t size, int64_t now_us) {
+  if (data == nullptr) {
+    return;
+  }
+  for (size_t i = 0; i < size; ++i) {
+    HandleByte(data[i], now_us);
+  }
+  ReportStatus();
+}
+
+void WinKeyer::HandleByte(uint8_t byte, int64_t now_us) {
+  if (skip_ > 0) {
+    --skip_;
+    return;
+  }
+
+  if (!in_command_) {
+    if (byte >= 0x80) {
+      return;  // Not a command or text
+    }
+    if (byte >= 0x20) {
+      if (host_open_) {
+        Enqueue(&byte, 1);
+      }
+      return;
+    }
+    command_ = byte;
+    arg_count_ = 0;
+    args_needed_ = kCommandArgs[byte];
+    in_command_ = args_needed_ > 0;
+    if (in_command_) {
+      return;
+    }
+  } else {
+    if (arg_count_ < kMaxArgs) {
+      args_[arg_count_] = byte;
+    }
+    ++arg_count_;
+    if (arg_count_ == 1) {
+      if (command_ == 0x00) {
+        if (byte == kAdminLoadEeprom) {
+          in_command_ = false;
+          skip_ = kEepromSize;  // Settings stay with the keyer's own config
+          return;
+        }
+        args_needed_ = 1 + AdminPayload(byte);
+      } else if (command_ == kPointerCommand && byte >= 0x01 && byte <= 0x03) {
+        args_needed_ = 2;
+      }
+    }
+    if (arg_count_ < args_needed_) {
+      return;
+    }
+    in_command_ = false;
+  }
+
+  if (command_ == 0x00) {
+    ExecuteAdmin(now_us);
+  } else if (!host_open_) {
+    return;  // Everything but admin needs an open host session
+  } else if (command_ < kBufferedPtt) {
+    ExecuteHost(now_us);
+  } else {
+    uint8_t bytes[3] = {command_, args_[0], args_[1]};
+    Enqueue(bytes, 1 + arg_count_);
+  }
+}
+
+void WinKeyer::ExecuteAdmin(int64_t now_us) {
+  switch (args_[0]) {
+    case kAdminReset:
+      Reset(now_us);
+      break;
+    case kAdminHostOpen:
+      host_open_ = true;
+      Emit(kWinKeyerVersion);
+      reported_status_ = status();  // Only changes are reported from here on
+      reported_pot_ = 0xFF;
+      break;
+    case kAdminHostClose:
+      ClearBuffer(now_us);
+      tune_ = false;
+      paused_ = false;
+      host_open_ = false;
+      break;
+    case kAdminEcho:
+      Emit(args_[1]);
+      break;
+    case kAdminPaddleA2d:
+    case kAdminGetMinorRev:
+    case kAdminGetIcType:
+      Emit(0);
+      break;
+    case kAdminSpeedA2d:
+      Emit(PotByte() & 0x3F);
+      break;
+    case kAdminGetValues: {
+      const WinKeyerSettings& s = settings_;
+      const uint8_t values[] = {s.mode,         s.speed_wpm,        s.sidetone,       s.weight,
+                                s.lead_in,      s.tail,             s.pot_min_wpm,    s.pot_range_wpm,
+                                s.first_extension, s.key_compensation, s.farnsworth_wpm, s.paddle_setpoint,
+                                s.ratio,        s.pin_config,       s.unused};
+      for (uint8_t value : values) {
+        Emit(value);
+      }
+      break;
+    }
+    case kAdminGetMajorRev:
+      Emit(kWinKeyerVersion);
+      break;
+    case kAdminReadVcc:
+      Emit(kVccReading);
+      break;
+    default:
+      break;  // Mode switches, baud rate, calibration: nothing to do over USB
+  }
+}
+
+void WinKeyer::ExecuteHost(int64_t now_us) {
+  const uint8_t a0 = args_[0];
+  switch (command_) {
+    case 0x01:
+      settings_.sidetone = a0;
+      break;
+    case 0x02:
+      settings_.speed_wpm = (a0 == 0) ? 0 : Clamp(a0, kMinSpeedWpm, kMaxSpeedWpm);
+      break;
+    case 0x03:
+      settings_.weight = Clamp(a0, 10, 90);
+      break;
+    case 0x04:
+      settings_.lead_in = a0;
+      settings_.tail = args_[1];
+      break;
+    case 0x05:
+      settings_.pot_min_wpm = a0;
+      settings_.pot_range_wpm = args_[1];
+      reported_pot_ = 0xFF;  // Report the pot against the new range
+      break;
+    case 0x06:
+      paused_ = a0 != 0;
+      break;
+    case 0x07:
+      Emit(PotByte());
+      break;
+    case 0x08:
+      if (send_ != end_) {
+        end_ = (end_ - 1) & kRingMask;
+        if (!InWindow(input_)) {
+          input_ = end_;
+        }
+        UpdateXoff();
+      }
+      break;
+    case 0x09:
+      settings_.pin_config = a0;
+      break;
+    case 0x0A:
+      ClearBuffer(now_us);
+      paused_ = false;
+      break;
+    case 0x0B:
+      if (a0 != 0 && !tune_) {
+        AbortCharacter(now_us);
+        tune_start_us_ = now_us;
+      }
+      tune_ = a0 != 0;
+      break;
+    case 0x0D:
+      settings_.farnsworth_wpm = (a0 == 0) ? 0 : Clamp(a0, 10, kMaxSpeedWpm);
+      break;
+    case 0x0E:
+      settings_.mode = a0;
+      break;
+    case 0x0F:
+      ApplyDefaults(args_);
+      break;
+    case 0x10:
+      settings_.first_extension = a0;
+      break;
+    case 0x11:
+      settings_.key_compensation = a0;
+      break;
+    case 0x12:
+      settings_.paddle_setpoint = a0;
+      break;
+    case 0x15:
+      reported_status_ = status();
+      Emit(reported_status_);
+      break;
+    case kPointerCommand:
+      ExecutePointer();
+      break;
+    case 0x17:
+      settings_.ratio = Clamp(a0, 33, 66);
+      break;
+    default:
+      break;  // HSCW, null, software paddle
+  }
+}
+
+void WinKeyer::ExecutePointer() {
+  const size_t position = args_[1] & kRingMask;
+  switch (args_[0]) {
+    case 0x00:
+      send_ = end_ = input_ = 0;
+      overwrite_ = false;
+      UpdateXoff();
+      break;
+    case 0x01:
+    case 0x02:
+      overwrite_ = args_[0] == 0x01;
+      input_ = InWindow(position) ? position : end_;
+      break;
+    case 0x03: {
+      const bool overwrite = overwrite_;
+      overwrite_ = false;  // Placeholders are inserted, never written over text
+      const uint8_t null = kPlaceholder;
+      for (uint8_t i = 0; i < args_[1]; ++i) {
+        if (!Enqueue(&null, 1)) {
+          break;
+        }
+      }
+      overwrite_ = overwrite;
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+bool WinKeyer::Enqueue(const uint8_t* bytes, size_t count) {
+  if (buffered() + count > kRingCapacity) {
+    return false;  // Host ignored XOFF: drop rather than corrupt a command
+  }
+  for (size_t i = 0; i < count; ++i) {
+    if (overwrite_ && input_ != end_) {
+      ring_[input_] = bytes[i];
+    } else {
+      // Insert at input_: shift the tail one slot towards end_
+      for (size_t p = end_; p != input_; p = (p - 1) & kRingMask) {
+        ring_[p] = ring_[(p - 1) & kRingMask];
+      }
+      ring_[input_] = bytes[i];
+      end_ = (end_ + 1) & kRingMask;
+    }
+    input_ = (input_ + 1) & kRingMask;
+  }
+  UpdateXoff();
+  return true;
+}
+
+void WinKeyer::ClearBuffer(int64_t now_us) {
+  send_ = end_ = input_ = 0;
+  overwrite_ = false;
+  buffered_speed_ = 0;
+  UpdateXoff();
+  AbortCharacter(now_us);
+}
+
+void WinKeyer::AbortCharacter(int64_t now_us) {
+  segment_count_ = 0;
+  segment_index_ = 0;
+  echo_count_ = 0;
+  waiting_ = false;
+  cursor_us_ = now_us;
+  idle_ = true;
+}
+
+bool WinKeyer::PopDue(int64_t now_us, Edge* edge) {
+  if (tune_ && now_us - tune_start_us_ >= kTuneLimitUs) {
+    tune_ = false;  // Tune watchdog: a lost "key up" must not hold the transmitter
+  }
+  if (breakin_ && now_us >= breakin_until_us_) {
+    breakin_ = false;
+  }
+
+  while (true) {
+    if (segment_index_ >= segment_count_) {
+      if (cursor_us_ > now_us) {
+        return false;  // Character space of the last character still running
+      }
+      // Nothing scheduled: the key follows tune
+      if (key_down_ != tune_) {
+        key_down_ = tune_;
+        edge->key_active = tune_;
+        edge->timestamp_us = now_us;
+        ReportStatus();
+        return true;
+      }
+      if (!LoadNext(now_us)) {
+        ReportStatus();
+        return false;
+      }
+      ReportStatus();
+      continue;
+    }
+    if (cursor_us_ > now_us) {
+      return false;
+    }
+
+    const size_t index = segment_index_++;
+    if (index == echo_index_ && echo_count_ > 0) {
+      if ((settings_.mode & kModeSerialEcho) != 0) {
+        for (size_t i = 0; i < echo_count_; ++i) {
+          Emit(static_cast<uint8_t>(echo_[i]));
+        }
+      }
+      echo_count_ = 0;
+    }
+    const Segment& segment = segments_[index];
+    const int64_t start_us = cursor_us_;
+    cursor_us_ += segment.duration_us;
+    if (segment.key != key_down_) {
+      key_down_ = segment.key;
+      edge->key_active = segment.key;
+      edge->timestamp_us = start_us;
+      return true;
+    }
+  }
+}
+
+bool WinKeyer::LoadNext(int64_t now_us) {
+  waiting_ = false;
+  if (paused_ || breakin_ || tune_) {
+    idle_ = true;
+    return false;
+  }
+
+  while (send_ != end_) {
+    const uint8_t byte = Peek(0);
+    const size_t length = (byte >= kBufferedPtt && byte <= kBufferedNop) ? 1 + kCommandArgs[byte] : 1;
+    if (buffered() < length) {
+      break;  // Truncated by backspace: nothing sensible to send
+    }
+    const uint8_t a0 = (length > 1) ? Peek(1) : 0;
+    const uint8_t a1 = (length > 2) ? Peek(2) : 0;
+    send_ = (send_ + length) & kRingMask;
+    if (!InWindow(input_)) {
+      input_ = end_;  // The host pointer was on bytes that just went out
+    }
+    UpdateXoff();
+
+    const uint8_t wpm = effective_speed();
+    const int64_t space_dit_us = kDitUsPerWpm / wpm;
+    segment_count_ = 0;
+    segment_index_ = 0;
+    echo_count_ = 0;
+    echo_index_ = 0;
+
+    switch (byte) {
+      case kBufferedKey:
+        AppendSegment(true, std::min(a0, kMaxTimedSeconds) * kUsPerSecond);
+        AppendSegment(false, 0);
+        break;
+      case kBufferedWait:
+        AppendSegment(false, std::min(a0, kMaxTimedSeconds) * kUsPerSecond);
+        waiting_ = true;
+        break;
+      case kBufferedMerge:
+        AppendCharacter(static_cast<char>(a0), wpm, true);
+        AppendCharacter(static_cast<char>(a1), wpm, false);
+        break;
+      case kBufferedSpeed:
+        buffered_speed_ = (a0 == 0) ? 0 : Clamp(a0, kMinSpeedWpm, kMaxSpeedWpm);
+        break;
+      case kBufferedCancelSpeed:
+        buffered_speed_ = 0;
+        break;
+      case kBufferedPtt:
+      case kBufferedHscwSpeed:
+      case kBufferedNop:
+      case kPlaceholder:
+        break;
+      case ' ': {
+        // The previous character already ended with 3 dits of space
+        const int64_t extra_dits = ((settings_.mode & kModeContestSpacing) != 0) ? 3 : 4;
+        AppendSegment(false, extra_dits * space_dit_us);
+        echo_[echo_count_++] = ' ';
+        break;
+      }
+      case kHalfSpace:
+        AppendSegment(false, space_dit_us / 2);
+        break;
+      default:
+        AppendCharacter(static_cast<char>(byte), wpm, false);
+        break;
+    }
+
+    if (segment_count_ == 0) {
+      continue;  // Command or unsupported character: nothing to key
+    }
+    if (idle_) {
+      cursor_us_ = now_us;
+      idle_ = false;
+    }
+    return true;
+  }
+
+  buffered_speed_ = 0;  // A buffered speed change lasts until the buffer empties
+  idle_ = true;
+  return false;
+}
+
+void WinKeyer::AppendCharacter(char ch, uint8_t wpm, bool merged) {
+  const char upper = static_cast<char>(std::toupper(static_cast<unsigned char>(ch)));
+  const std::string pattern = encoder_.Encode(upper);
+  if (pattern.empty()) {
+    return;
+  }
+
+  // Farnsworth: elements at the faster character speed, spacing at wpm
+  const uint8_t char_wpm = (settings_.farnsworth_wpm > wpm) ? settings_.farnsworth_wpm : wpm;
+  const int64_t dit_us = kDitUsPerWpm / char_wpm;
+  const int64_t space_dit_us = kDitUsPerWpm / wpm;
+  const int64_t dah_us = dit_us * 3 * settings_.ratio / 50;
+  const int64_t weight_us = dit_us * (static_cast<int>(settings_.weight) - 50) / 50;
+  const int64_t compensation_us = static_cast<int64_t>(settings_.key_compensation) * 1000;
+  const int64_t mark_extra_us = weight_us + compensation_us;
+  const int64_t gap_us = std::max<int64_t>(dit_us - mark_extra_us, 0);
+
+  for (char element : pattern) {
+    const int64_t mark_us = (element == '-') ? dah_us : dit_us;
+    if (segment_count_ + 2 > kMaxSegments) {
+      break;
+    }
+    AppendSegment(true, std::max<int64_t>(mark_us + mark_extra_us, 0));
+    AppendSegment(false, gap_us);
+  }
+  // Echo on the release of the last mark; a merged first letter keeps the element gap
+  echo_index_ = segment_count_ - 1;
+  if (!merged) {
+    segments_[segment_count_ - 1].duration_us = static_cast<uint32_t>(gap_us + 2 * space_dit_us);
+  }
+  echo_[echo_count_++] = upper;
+}
+
+void WinKeyer::AppendSegment(bool key, int64_t duration_us) {
+  if (segment_count_ >= kMaxSegments) {
+    return;
+  }
+  segments_[segment_count_].key = key;
+  segments_[segment_count_].duration_us = static_cast<uint32_t>(duration_us);
+  ++segment_count_;
+}
+
+void WinKeyer::OnPaddlePress(int64_t now_us) {
+  if (!host_open_) {
+    return;
+  }
+  ClearBuffer(now_us);
+  tune_ = false;
+  breakin_ = true;
+  breakin_until_us_ = now_us + 7 * (kDitUsPerWpm / effective_speed());
+  ReportStatus();
+}
+
+void WinKeyer::SetPotSpeed(uint8_t wpm) {
+  pot_wpm_ = wpm;
+  if (!host_open_) {
+    return;
+  }
+  const uint8_t report = PotByte();
+  if (report != reported_pot_) {
+    reported_pot_ = report;
+    Emit(report);
+  }
+}
+
+void WinKeyer::Reset(int64_t now_us) {
+  ClearBuffer(now_us);
+  settings_ = WinKeyerSettings{};
+  in_command_ = false;
+  skip_ = 0;
+  host_open_ = false;
+  paused_ = false;
+  tune_ = false;
+  breakin_ = false;
+  reported_pot_ = 0xFF;
+}
+
+size_t WinKeyer::ReadOutput(uint8_t* out, size_t max) {
+  const size_t count = PeekOutput(out, max);
+  ConsumeOutput(count);
+  return count;
+}
+
+size_t WinKeyer::PeekOutput(uint8_t* out, size_t max) const {
+  const size_t count = std::min(max, output_count_);
+  for (size_t i = 0; i < count; ++i) {
+    out[i] = output_[(output_head_ + i) % kOutputQueueSize];
+  }
+  return count;
+}
+
+void WinKeyer::ConsumeOutput(size_t count) {
+  count = std::min(count, output_count_);
+  output_head_ = (output_head_ + count) % kOutputQueueSize;
+  output_count_ -= count;
+}
+
+uint8_t WinKeyer::status() const {
+  uint8_t flags = 0xC0;
+  if (xoff_) {
+    flags |= kStatusXoff;
+  }
+  if (breakin_) {
+    flags |= kStatusBreakin;
+  }
+  if (send_ != end_ || !idle_) {
+    flags |= kStatusBusy;
+  }
+  if (tune_) {
+    flags |= kStatusKeydown;
+  }
+  if (waiting_) {
+    flags |= kStatusWait;
+  }
+  return flags;
+}
+
+size_t WinKeyer::buffered() const {
+  return (end_ - send_) & kRingMask;
+}
+
+uint8_t WinKeyer::effective_speed() const {
+  if (buffered_speed_ != 0) {
+    return buffered_speed_;
+  }
+  if (settings_.speed_wpm != 0) {
+    return settings_.speed_wpm;
+  }
+  return Clamp(pot_wpm_, kMinSpeedWpm, kMaxSpeedWpm);
+}
+
+void WinKeyer::ApplyDefaults(const uint8_t* values) {
+  WinKeyerSettings& s = settings_;
+  s.mode = values[0];
+  s.speed_wpm = (values[1] == 0) ? 0 : Clamp(values[1], kMinSpeedWpm, kMaxSpeedWpm);
+  s.sidetone = values[2];
+  s.weight = Clamp(values[3], 10, 90);
+  s.lead_in = values[4];
+  s.tail = values[5];
+  s.pot_min_wpm = values[6];
+  s.pot_range_wpm = values[7];
+  s.first_extension = values[8];
+  s.key_compensation = values[9];
+  s.farnsworth_wpm = (values[10] == 0) ? 0 : Clamp(values[10], 10, kMaxSpeedWpm);
+  s.paddle_setpoint = values[11];
+  s.ratio = Clamp(values[12], 33, 66);
+  s.pin_config = values[13];
+  s.unused = values[14];
+  reported_pot_ = 0xFF;
+}
+
+void WinKeyer::UpdateXoff() {
+  const size_t count = buffered();
+  if (count > kInputBufferSize * 2 / 3) {
+    xoff_ = true;
+  } else if (count < kInputBufferSize / 3) {
+    xoff_ = false;
+  }
+}
+
+void WinKeyer::Emit(uint8_t byte) {
+  if (output_count_ >= kOutputQueueSize) {
+    ++dropped_output_;
+    return;
+  }
+  output_[(output_head_ + output_count_) % kOutputQueueSize] = byte;
+  ++output_count_;
+}
+
+void WinKeyer::ReportStatus() {
+  if (!host_open_) {
+    return;
+  }
+  const uint8_t current = status();
+  if (current != reported_status_) {
+    reported_status_ = current;
+    Emit(current);
+  }
+}
+
+uint8_t WinKeyer::PotByte() const {
+  const uint8_t low = settings_.pot_min_wpm;
+  const uint8_t high = static_cast<uint8_t>(std::min(low + settings_.pot_range_wpm, 0xFF));
+  return static_cast<uint8_t>(0x80 | ((Clamp(pot_wpm_, low, high) - low) & 0x3F));
+}
+
+uint8_t WinKeyer::Peek(size_t offset) const {
+  return ring_[(send_ + offset) & kRingMask];
+}
+
+bool WinKeyer::InWindow(size_t position) const {
+  return ((position - send_) & kRingMask) <= buffered();
+}
+
+}  // namespace winkeyer
@@ -0,0 +1,90 @@
+/**
+ * @file winkeyer_port.cpp
+ * @brief WinKeyer protocol on the USB-CDC service port (TinyUSB)
+ */
+
+#include "winkeyer/winkeyer_port.hpp"
+
+#include <utility>
+
+#include "esp_log.h"
+#include "tinyusb_cdc_acm.h"
+
+namespace winkeyer {
+
+namespace {
+constexpr char kLogTag[] = "winkeyer";
+
+// Bytes moved per CDC call; one full-speed bulk packet
+constexpr size_t kChunkSize = 64;
+
+// Receive chunks per tick: a logger never sends more than the 128-byte buffer
+constexpr int kMaxRxChunksPerTick = 4;
+}  // namespace
+
+WinKeyerPort::WinKeyerPort(int cdc_port, KeyOutput key_output)
+    : cdc_port_(cdc_port), key_output_(std::move(key_output)) {}
+
+void WinKeyerPort::SetEnabled(bool enabled, int64_t now_us) {
+  if (enabled == enabled_) {
+    return;
+  }
+  enabled_ = enabled;
+  if (!enabled) {
+    protocol_.Reset(now_us);
+    FlushEdges(now_us);  // Let go of the key
+  }
+  ESP_LOGI(kLogTag, "Service port %s", enabled ? "in WinKeyer mode" : "back to the console");
+}
+
+void WinKeyerPort::Tick(int64_t now_us, uint8_t pot_wpm) {
+  if (!enabled_) {
+    return;
+  }
+
+  uint8_t chunk[kChunkSize];
+  for (int i = 0; i < kMaxRxChunksPerTick; ++i) {
+    size_t rx_size = 0;
+    if (tinyusb_cdcacm_read(static_cast<tinyusb_cdcacm_itf_t>(cdc_port_), chunk, sizeof(chunk), &rx_size) != ESP_OK || rx_size == 0) {
+      break;
+    }
+    rx_bytes_ += rx_size;
+    protocol_.Feed(chunk, rx_size, now_us);
+  }
+
+  protocol_.SetPotSpeed(pot_wpm);
+  FlushEdges(now_us);
+
+  // Only the bytes the CDC FIFO accepted leave the protocol queue; the rest is
+  // retried next tick, so echo and status never go missing when the host is slow
+  const size_t count = protocol_.PeekOutput(chunk, sizeof(chunk));
+  if (count > 0) {
+    const size_t queued = tinyusb_cdcacm_write_queue(static_cast<tinyusb_cdcacm_itf_t>(cdc_port_), chunk, count);
+    protocol_.ConsumeOutput(queued);
+    tx_bytes_ += queued;
+    tinyusb_cdcacm_write_flush(static_cast<tinyusb_cdcacm_itf_t>(cdc_port_), 0);  // Non-blocking flush
+  }
+}
+
+void WinKeyerPort::OnPaddlePress(int64_t timestamp_us) {
+  if (!enabled_) {
+    return;
+  }
+  protocol_.OnPaddlePress(timestamp_us);
+  FlushEdges(timestamp_us);  // Key-up goes out now, ahead of the paddle element
+}
+
+void WinKeyerPort::BreakIn(int64_t timestamp_us, void* context) {
+  static_cast<WinKeyerPort*>(context)->OnPaddlePress(timestamp_us);
+}
+
+void WinKeyerPort::FlushEdges(int64_t now_us) {
+  WinKeyer::Edge edge;
+  while (protocol_.PopDue(now_us, &edge)) {
+    if (key_output_) {
+      key_output_(edge.key_active, edge.timestamp_us);
+    }
+  }
+}
+
+}  // namespace winkeyer
@@ -0,0 +1,195 @@
+#!/usr/bin/env python3
+"""Build decoder replay fixtures for the host replay harness.
+
+Fixtures are plain-text key edge recordings with the reference text and a
+character error rate budget. They are replayed by `decoder_replay` and by the
+`DecoderReplayCorpus` host tests (tests_host/test_decoder_replay.cpp), which act
+as the regression gate for AdaptiveTimingClassifier and MorseDecoder changes.
+
+Two sources are supported:
+
+  generate       Synthesize the checked-in corpus (10-80 WPM, jitter, weighting,
+                 Farnsworth spacing, speed drift). Deterministic per seed.
+  from-timeline  Convert a /api/timeline/events JSON export (EventLogger "keying"
+                 events) recorded on a real keyer into a fixture.
+
+Examples:
+  python scripts/decoder/generate_corpus.py generate \
+      --output tests_host/fixtures/decoder_corpus
+  python scripts/decoder/generate_corpus.py from-timeline timeline.json \
+      --text "CQ DE IU3QEZ K" --wpm 22 --output my_fist.txt
+"""
+
+from __future__ import annotations
+
+import argparse
+import json
+import random
+import sys
+from dataclasses import dataclass
+from pathlib import Path
+from typing import List, Tuple
+
+MORSE = {
+    "A": ".-", "B": "-...", "C": "-.-.", "D": "-..", "E": ".", "F": "..-.",
+    "G": "--.", "H": "....", "I": "..", "J": ".---", "K": "-.-", "L": ".-..",
+    "M": "--", "N": "-.", "O": "---", "P": ".--.", "Q": "--.-", "R": ".-.",
+    "S": "...", "T": "-", "U": "..-", "V": "...-", "W": ".--", "X": "-..-",
+    "Y": "-.--", "Z": "--..",
+    "0": "-----", "1": ".----", "2": "..---", "3": "...--", "4": "....-",
+    "5": ".....", "6": "-....", "7": "--...", "8": "---..", "9": "----.",
+    "/": "-..-.", "?": "..--..", "=": "-...-",
+}
+
+START_TIMESTAMP_US = 1_000_000  # Non-zero: the firmware ignores the first edge at t=0
+
+
+@dataclass
+class FistSpec:
+    """Synthetic operator profile for one fixture."""
+
+    name: str
+    text: str
+    start_wpm: float
+    end_wpm: float
+    jitter: float = 0.0        # Uniform relative jitter (+/-) per duration
+    weighting: float = 0.0     # Fraction of a dit unit moved from spaces to marks
+    farnsworth: float = 1.0    # Stretch factor for character and word gaps
+    max_cer: float = 0.05      # Regression budget (character error rate)
+    seed: int = 1
+
+
+QSO_1 = "CQ CQ DE IU3QEZ IU3QEZ K"
+QSO_2 = "IU3QEZ DE DL1ABC GM TNX FER CALL UR RST 599 599 NAME HANS QTH BERLIN HW CPY BK"
+QSO_3 = "R R FB HANS UR RST 579 NAME SIMONE QTH PADOVA WX SUNNY TEMP 22C 73 ES GL SK"
+PANGRAM = "THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG 1234567890"
+CONTEST = "TEST IU3QEZ 5NN 15 TU DL1ABC 5NN 14 TU EE 5NN 15 TU"
+PARIS = "PARIS PARIS PARIS PARIS PARIS PARIS"
+
+CORPUS: List[FistSpec] = [
+    FistSpec("wpm10_clean", f"{QSO_1} {PANGRAM}", 10, 10, jitter=0.05, max_cer=0.02, seed=10),
+    FistSpec("wpm15_farnsworth", f"{QSO_2}", 15, 15, jitter=0.08, farnsworth=1.8,
+             max_cer=0.08, seed=15),
+    FistSpec("wpm18_straight_key", f"{QSO_3}", 18, 18, jitter=0.20, max_cer=0.03, seed=18),
+    FistSpec("wpm20_paris", PARIS, 20, 20, jitter=0.02, max_cer=0.02, seed=20),
+    FistSpec("wpm25_weighted", f"{QSO_2}", 25, 25, jitter=0.10, weighting=0.3,
+             max_cer=0.05, seed=25),
+    FistSpec("wpm30_drift", f"{QSO_3} {PANGRAM}", 30, 22, jitter=0.08, max_cer=0.02, seed=30),
+    FistSpec("wpm35_contest", CONTEST, 35, 35, jitter=0.08, max_cer=0.08, seed=35),
+    FistSpec("wpm40_jitter", f"{QSO_1} {QSO_3}", 40, 40, jitter=0.15, max_cer=0.03, seed=40),
+    FistSpec("wpm50_clean", f"{PANGRAM} {CONTEST}", 50, 50, jitter=0.05, max_cer=0.03, seed=50),
+    FistSpec("wpm60_drift", f"{QSO_2}", 60, 68, jitter=0.08, max_cer=0.05, seed=60),
+    FistSpec("wpm80_clean", f"{PARIS} {QSO_1}", 80, 80, jitter=0.05, max_cer=0.02, seed=80),
+]
+
+
+def render_edges(spec: FistSpec) -> List[Tuple[int, bool]]:
+    """Render a fist spec into (timestamp_us, key_down) edges."""
+    rng = random.Random(spec.seed)
+    text = spec.text.upper()
+    durations: List[Tuple[float, bool]] = []  # (duration_us, key_on)
+
+    def unit_at(index: int) -> float:
+        progress = index / (len(text) - 1) if len(text) > 1 else 0.0
+        wpm = spec.start_wpm + (spec.end_wpm - spec.start_wpm) * progress
+        return 1_200_000.0 / wpm
+
+    def emit(units_us: float, key_on: bool) -> None:
+        durations.append((units_us * (1.0 + rng.uniform(-spec.jitter, spec.jitter)), key_on))
+
+    for index, char in enumerate(text):
+        unit = unit_at(index)
+        shift = unit * spec.weighting
+        if char == " ":
+            if durations and not durations[-1][1]:
+                durations.pop()
+            emit((7.0 * unit - shift) * spec.farnsworth, False)
+            continue
+        pattern = MORSE.get(char)
+        if pattern is None:
+            raise ValueError(f"{spec.name}: unsupported character {char!r}")
+        for position, element in enumerate(pattern):
+            emit((3.0 if element == "-" else 1.0) * unit + shift, True)
+            if position + 1 < len(pattern):
+                emit(unit - shift, False)
+        emit((3.0 * unit - shift) * spec.farnsworth, False)
+
+    edges: List[Tuple[int, bool]] = []
+    timestamp = START_TIMESTAMP_US
+    for duration, key_on in durations:
+        edges.append((timestamp, key_on))
+        timestamp += max(1, int(round(duration)))
+    edges.append((timestamp, True))  # Closing key-down ends the final gap
+    return edges
+
+
+def write_fixture(path: Path, name: str, text: str, wpm: float, max_cer: float,
+                  edges: List[Tuple[int, bool]], source: str) -> None:
+    lines = [
+        f"# Decoder replay fixture ({source})",
+        f"name: {name}",
+        f"text: {text.upper()}",
+        f"wpm: {int(round(wpm))}",
+        f"max_cer: {max_cer:.3f}",
+        "# timestamp_us key_down",
+    ]
+    lines.extend(f"{timestamp} {1 if down else 0}" for timestamp, down in edges)
+    path.write_text("\n".join(lines) + "\n", encoding="ascii")
+
+
+def command_generate(args: argparse.Namespace) -> int:
+    output = Path(args.output)
+    output.mkdir(parents=True, exist_ok=True)
+    for spec in CORPUS:
+        edges = render_edges(spec)
+        write_fixture(output / f"{spec.name}.txt", spec.name, spec.text, spec.start_wpm,
+                      spec.max_cer, edges, "generated by scripts/decoder/generate_corpus.py")
+        print(f"{spec.name}: {len(edges)} edges")
+    return 0
+
+
+def command_from_timeline(args: argparse.Namespace) -> int:
+    data = json.loads(Path(args.timeline).read_text())
+    events = data.get("events", data) if isinstance(data, dict) else data
+    edges: List[Tuple[int, bool]] = []
+    for event in sorted(events, key=lambda e: e["timestamp_us"]):
+        if event.get("type") != "keying":
+            continue
+        down = int(event.get("arg1", 0)) != 0
+        if edges and edges[-1][1] == down:
+            continue  # Repeated state (e.g. overlapping element callbacks)
+        edges.append((int(event["timestamp_us"]), down))
+    if len(edges) < 2:
+        print("error: timeline contains fewer than two keying edges", file=sys.stderr)
+        return 1
+    name = args.name or Path(args.output).stem
+    write_fixture(Path(args.output), name, args.text, args.wpm, args.max_cer, edges,
+                  f"recorded, converted from {Path(args.timeline).name}")
+    print(f"{name}: {len(edges)} edges")
+    return 0
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    gen = sub.add_parser("generate", help="write the synthetic corpus")
+    gen.add_argument("--output", default="tests_host/fixtures/decoder_corpus")
+    gen.set_defaults(func=command_generate)
+
+    conv = sub.add_parser("from-timeline", help="convert a timeline JSON export")
+    conv.add_argument("timeline", help="JSON from GET /api/timeline/events")
+    conv.add_argument("--text", required=True, help="reference text that was sent")
+    conv.add_argument("--wpm", type=float, required=True, help="nominal sending speed")
+    conv.add_argument("--max-cer", type=float, default=0.05, help="regression budget")
+    conv.add_argument("--name", help="fixture name (default: output file stem)")
+    conv.add_argument("--output", required=True, help="fixture file to write")
+    conv.set_defaults(func=command_from_timeline)
+
+    args = parser.parse_args()
+    return args.func(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,80 @@
+#!/usr/bin/env python3
+"""Report and enforce the compressed size budget of the Web UI bundle.
+
+Every JS/CSS chunk in webui/dist is embedded in firmware flash gzip-compressed by
+embed_assets.py, so the gzip size is what the budget is measured in. The entry
+chunk (the one index.html loads) is paid on every page load; lazily loaded page
+chunks only when their route is opened. The script prints one line per chunk and
+exits non-zero when a budget is exceeded, so build.sh catches regressions before
+they reach flash.
+"""
+
+from __future__ import annotations
+
+import argparse
+import gzip
+import re
+import sys
+from pathlib import Path
+from typing import List, Tuple
+
+# Budgets in gzip bytes. Raise deliberately (and note why in the changelog) when a
+# feature genuinely needs the space.
+_DEFAULT_ENTRY_BUDGET = 40 * 1024
+_DEFAULT_CHUNK_BUDGET = 24 * 1024
+_DEFAULT_TOTAL_BUDGET = 128 * 1024
+
+_ENTRY_SCRIPT = re.compile(r'<script[^>]*type="module"[^>]*src="/?([^"]+)"')
+
+
+def gzip_size(path: Path) -> int:
+    # Same settings as embed_assets.py so the report matches the flash cost
+    return len(gzip.compress(path.read_bytes(), mtime=0))
+
+
+def collect_chunks(dist: Path) -> List[Tuple[str, int, int]]:
+    chunks = []
+    for path in sorted(dist.rglob("*")):
+        if path.is_file() and path.suffix in {".js", ".css", ".html"}:
+            chunks.append((path.relative_to(dist).as_posix(), path.stat().st_size, gzip_size(path)))
+    return chunks
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Check Web UI chunk sizes against budget")
+    parser.add_argument("--dist", type=Path, default=Path("dist"), help="Vite output directory")
+    parser.add_argument("--entry-budget", type=int, default=_DEFAULT_ENTRY_BUDGET)
+    parser.add_argument("--chunk-budget", type=int, default=_DEFAULT_CHUNK_BUDGET)
+    parser.add_argument("--total-budget", type=int, default=_DEFAULT_TOTAL_BUDGET)
+    args = parser.parse_args()
+
+    index = args.dist / "index.html"
+    if not index.is_file():
+        print(f"check_bundle_budget: {index} not found", file=sys.stderr)
+        return 1
+    match = _ENTRY_SCRIPT.search(index.read_text())
+    entry = match.group(1) if match else ""
+
+    failures: List[str] = []
+    total = 0
+    print(f"{'chunk':<48} {'raw':>9} {'gzip':>9}  budget")
+    for name, raw, compressed in collect_chunks(args.dist):
+        total += compressed
+        budget = args.entry_budget if name == entry else args.chunk_budget
+        marker = "entry" if name == entry else ""
+        status = "OK" if compressed <= budget else "OVER"
+        print(f"{name:<48} {raw:>9} {compressed:>9}  {status} ({budget}) {marker}")
+        if compressed > budget:
+            failures.append(f"{name}: {compressed} > {budget} gzip bytes")
+
+    print(f"{'total':<48} {'':>9} {total:>9}  ({args.total_budget})")
+    if total > args.total_budget:
+        failures.append(f"total: {total} > {args.total_budget} gzip bytes")
+
+    for failure in failures:
+        print(f"check_bundle_budget: over budget: {failure}", file=sys.stderr)
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
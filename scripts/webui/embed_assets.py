@@ -5,14 +5,26 @@ The script scans the webui/ directory for static assets and emits a C++ include
 file that defines byte arrays and metadata for runtime lookup. Assets can be
 optionally gzip-compressed to reduce flash usage; the metadata notes whether
 compression was applied so the HTTP layer can set the proper header.
+
+Caching metadata:
+- Every asset gets a strong ETag (truncated SHA-256 of the uncompressed content)
+  so the server can answer If-None-Match with 304 Not Modified.
+- Files whose name carries a bundler content hash (Vite: assets/index-3f9a1c2b.js)
+  are flagged immutable and served with a one-year Cache-Control.
+- The manifest is sorted by request path so the runtime lookup can binary search.
+- With --brotli (requires the Python "brotli" module) a Brotli variant is embedded
+  next to the gzip one when it is smaller; browsers only advertise "br" over HTTPS,
+  so on plain HTTP the gzip variant is what gets served.
 """
 
 from __future__ import annotations
 
 import argparse
 import gzip
+import hashlib
+import re
 from pathlib import Path
-from typing import Iterable, List, Tuple
+from typing import Iterable, List, Optional, Tuple
 
 _TEXT_EXTENSIONS = {
     ".html": "text/html",
@@ -61,6 +73,31 @@ def iter_assets(root: Path) -> Iterable[Tuple[Path, Path, str]]:
         yield path, rel, content_type
 
 
+# Bundler content hash in the file name: "name-<hash>.ext" with at least 8 base64url
+# characters, only trusted inside the bundler's assets/ directory
+_HASHED_NAME = re.compile(r"-[A-Za-z0-9_-]{8,}\.[a-z0-9]+$")
+_HASHED_DIR = "assets"
+
+# Hex digits of SHA-256 kept for the ETag (64 bits, collisions irrelevant at this scale)
+_ETAG_HEX_DIGITS = 16
+
+
+def is_hashed_name(rel_path: Path) -> bool:
+    return rel_path.parts[0] == _HASHED_DIR and _HASHED_NAME.search(rel_path.name) is not None
+
+
+def content_etag(data: bytes) -> str:
+    return hashlib.sha256(data).hexdigest()[:_ETAG_HEX_DIGITS]
+
+
+def brotli_compress(data: bytes) -> Optional[bytes]:
+    try:
+        import brotli  # type: ignore[import-not-found]
+    except ImportError:
+        return None
+    return brotli.compress(data, quality=11)
+
+
 def format_byte_array(data: bytes) -> str:
     columns = 12
     lines: List[str] = []
@@ -80,6 +117,7 @@ def generate_include(
     assets: Iterable[Tuple[Path, Path, str]],
     output: Path,
     gzip_assets: bool,
+    brotli_assets: bool = False,
 ) -> None:
     lines: List[str] = []
     lines.append("// AUTO-GENERATED FILE. DO NOT EDIT.")
@@ -93,19 +131,34 @@ def generate_include(
 
     manifest_entries: List[str] = []
 
-    for src_path, rel_path, content_type in assets:
-        data = src_path.read_bytes()
-        if gzip_assets:
-            data = gzip.compress(data)
+    # Sorted by request path: ui::assets::Find() binary searches the manifest
+    for src_path, rel_path, content_type in sorted(assets, key=lambda a: a[1].as_posix()):
+        raw = src_path.read_bytes()
+        etag = content_etag(raw)
+        data = gzip.compress(raw, mtime=0) if gzip_assets else raw
         symbol = sanitize_symbol(rel_path)
         lines.append(f"alignas(4) const std::uint8_t {symbol}[] = {{")
         lines.append(f"    {format_byte_array(data)}")
         lines.append("};")
         lines.append("")
+
+        br_symbol = "nullptr"
+        br_size = "0"
+        br_data = brotli_compress(raw) if brotli_assets else None
+        if br_data is not None and len(br_data) < len(data):
+            br_symbol = symbol + "_br"
+            br_size = f"sizeof({br_symbol})"
+            lines.append(f"alignas(4) const std::uint8_t {br_symbol}[] = {{")
+            lines.append(f"    {format_byte_array(br_data)}")
+            lines.append("};")
+            lines.append("")
+
         compressed_flag = "true" if gzip_assets else "false"
+        immutable_flag = "true" if is_hashed_name(rel_path) else "false"
         manifest_entries.append(
-            '    {"/%s", %s, sizeof(%s), "%s", %s},'
-            % (rel_path.as_posix(), symbol, symbol, content_type, compressed_flag)
+            '    {"/%s", %s, sizeof(%s), "%s", %s, %s, %s, "\\"%s\\"", %s},'
+            % (rel_path.as_posix(), symbol, symbol, content_type, compressed_flag,
+               br_symbol, br_size, etag, immutable_flag)
         )
 
     lines.append("const Asset kAssets[] = {")
@@ -122,6 +175,9 @@ def main() -> None:
     parser.add_argument("--source", type=Path, default=Path("webui"), help="Directory containing assets")
     parser.add_argument("--output", type=Path, required=True, help="Output include file path")
     parser.add_argument("--gzip", action="store_true", help="Compress assets before embedding")
+    parser.add_argument(
+        "--brotli", action="store_true", help="Also embed Brotli variants (needs the brotli module)"
+    )
     args = parser.parse_args()
 
     if not args.source.is_dir():
@@ -132,7 +188,9 @@ def main() -> None:
         raise SystemExit("No embeddable assets found in source directory")
 
     args.output.parent.mkdir(parents=True, exist_ok=True)
-    generate_include(assets, args.output, args.gzip)
+    if args.brotli and brotli_compress(b"") is None:
+        print("embed_assets: brotli module not available, embedding gzip only")
+    generate_include(assets, args.output, args.gzip, args.brotli)
 
 
 if __name__ == "__main__":
@@ -0,0 +1,61 @@
+/**
+ * @file bench_audio.cpp
+ * @brief Benchmarks for sidetone synthesis and the remote audio jitter buffer
+ */
+
+#include "audio/audio_stream_player.hpp"
+#include "audio/tone_generator.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+// One I2S DMA block of stereo frames while the tone is on (fades included)
+void BM_ToneGeneratorFill(benchmark::State& state) {
+  audio::ToneGenerator generator;
+  audio::ToneGeneratorSettings settings{};
+  settings.sample_rate_hz = 16000;
+  settings.tone_frequency_hz = 600;
+  settings.volume_percent = 70;
+  settings.fade_in_ms = 5;
+  settings.fade_out_ms = 5;
+  generator.Configure(settings);
+  generator.Start();
+
+  const size_t frames = static_cast<size_t>(state.range(0));
+  std::vector<int16_t> buffer(frames * 2);
+  for (auto _ : state) {
+    generator.Fill(buffer.data(), frames);
+    benchmark::DoNotOptimize(buffer.data());
+  }
+  state.SetItemsProcessed(state.iterations() * frames);
+}
+BENCHMARK(BM_ToneGeneratorFill)->Arg(64)->Arg(256);
+
+// One 20 ms network packet in (A-Law @ 8 kHz), the same amount out as stereo frames
+void BM_AudioStreamPlayerWriteRead(benchmark::State& state) {
+  constexpr size_t kPacketSamples = 160;
+  audio::AudioStreamPlayer player;
+  std::vector<uint8_t> alaw(kPacketSamples);
+  for (size_t i = 0; i < alaw.size(); ++i) {
+    alaw[i] = static_cast<uint8_t>(0xD5 ^ (i & 0x3F));
+  }
+  std::vector<int16_t> stereo(kPacketSamples * 2);
+
+  // Prime past the start threshold so reads produce audio instead of silence
+  for (size_t i = 0; i < audio::AudioStreamPlayer::kTargetBufferSamples / kPacketSamples; ++i) {
+    player.WriteALawSamples(alaw.data(), alaw.size());
+  }
+  for (auto _ : state) {
+    player.WriteALawSamples(alaw.data(), alaw.size());
+    player.ReadStereoFrames(stereo.data(), kPacketSamples);
+    benchmark::DoNotOptimize(stereo.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kPacketSamples);
+}
+BENCHMARK(BM_AudioStreamPlayerWriteRead);
+
+}  // namespace
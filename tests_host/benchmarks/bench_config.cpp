@@ -0,0 +1,41 @@
+/**
+ * @file bench_config.cpp
+ * @brief Benchmarks for configuration persistence against the in-memory NVS stub
+ *
+ * The stub has no flash latency, so these numbers track the CPU cost of the
+ * table-driven serialization (parameter walk, key formatting, backup copy).
+ */
+
+#include "config/device_config.hpp"
+
+#include "benchmark/benchmark.h"
+#include "support/fake_esp_idf.hpp"
+
+namespace {
+
+void BM_StorageSave(benchmark::State& state) {
+  fake_esp_idf_reset();
+  config::Storage storage;
+  storage.Initialize("keyer");
+  config::DeviceConfig cfg = storage.LoadOrDefault();
+  const bool with_backup = state.range(0) != 0;
+  for (auto _ : state) {
+    cfg.keying.speed_wpm = cfg.keying.speed_wpm == 25 ? 26 : 25;
+    benchmark::DoNotOptimize(storage.Save(cfg, with_backup));
+  }
+}
+BENCHMARK(BM_StorageSave)->Arg(0)->Arg(1);
+
+void BM_StorageLoad(benchmark::State& state) {
+  fake_esp_idf_reset();
+  config::Storage storage;
+  storage.Initialize("keyer");
+  storage.Save(storage.LoadOrDefault(), false);
+  for (auto _ : state) {
+    config::DeviceConfig cfg = storage.LoadOrDefault();
+    benchmark::DoNotOptimize(cfg);
+  }
+}
+BENCHMARK(BM_StorageLoad);
+
+}  // namespace
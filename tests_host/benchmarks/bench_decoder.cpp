@@ -0,0 +1,46 @@
+/**
+ * @file bench_decoder.cpp
+ * @brief Benchmarks for the decoder building blocks (pattern lookup, timing classifier)
+ */
+
+#include "morse_decoder/adaptive_timing_classifier.hpp"
+#include "morse_decoder/morse_table.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <array>
+#include <string>
+
+namespace {
+
+void BM_MorseTableLookup(benchmark::State& state) {
+  morse_decoder::MorseTable table;
+  const std::array<std::string, 8> patterns = {".-", "-...", "-.-.", "...", "-----",
+                                               ".-.-.-", "--..--", "..--.."};
+  size_t index = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(table.Lookup(patterns[index]));
+    index = (index + 1) % patterns.size();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MorseTableLookup);
+
+// Alternating marks and spaces of a 20 WPM fist with +-10% jitter
+void BM_ClassifyDuration(benchmark::State& state) {
+  morse_decoder::AdaptiveTimingClassifier classifier;
+  constexpr int64_t kUnitUs = 60'000;
+  const std::array<int64_t, 8> durations = {kUnitUs, kUnitUs, 3 * kUnitUs, kUnitUs,
+                                            kUnitUs * 11 / 10, 3 * kUnitUs, kUnitUs * 9 / 10,
+                                            7 * kUnitUs};
+  const std::array<bool, 8> key_on = {true, false, true, false, true, false, true, false};
+  size_t index = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(classifier.ClassifyDuration(durations[index], key_on[index]));
+    index = (index + 1) % durations.size();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ClassifyDuration);
+
+}  // namespace
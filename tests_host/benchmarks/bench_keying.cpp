@@ -0,0 +1,132 @@
+/**
+ * @file bench_keying.cpp
+ * @brief Benchmarks for the keying hot path (PaddleEngine) and the timeline logger
+ */
+
+#include "keying/paddle_engine.hpp"
+#include "timeline/event_logger.hpp"
+
+#include "benchmark/benchmark.h"
+
+namespace {
+
+void NoopElement(keying::PaddleElement, int64_t, void*) {}
+void NoopKey(bool, int64_t, void*) {}
+
+bool InitEngine(keying::PaddleEngine& engine, uint32_t wpm,
+                keying::FsmVariant variant = keying::FsmVariant::kSpecialized) {
+  keying::PaddleEngineConfig config{};
+  config.speed_wpm = wpm;
+  config.fsm_variant = variant;
+  config.mem_block_start_pct = 60.0f;  // Accukeyer window
+  config.mem_block_end_pct = 99.0f;
+  keying::PaddleEngineCallbacks callbacks{
+      .on_element_started = NoopElement,
+      .on_element_finished = NoopElement,
+      .on_key_state_changed = NoopKey,
+      .context = nullptr,
+  };
+  return engine.Initialize(config, callbacks);
+}
+
+// Idle engine: the cost paid by the keying task on every tick with no paddle pressed
+void BM_PaddleEngineTickIdle(benchmark::State& state) {
+  keying::PaddleEngine engine;
+  InitEngine(engine, 25);
+  int64_t now_us = 1'000'000;
+  for (auto _ : state) {
+    engine.Tick(now_us);
+    now_us += 1000;
+  }
+}
+BENCHMARK(BM_PaddleEngineTickIdle);
+
+// Both paddles held: iambic alternation with element start/finish on the 1 ms tick
+void BM_PaddleEngineTickSqueeze(benchmark::State& state) {
+  keying::PaddleEngine engine;
+  InitEngine(engine, static_cast<uint32_t>(state.range(0)));
+  int64_t now_us = 1'000'000;
+  engine.OnPaddleEvent({.line = hal::PaddleLine::kDit, .active = true, .timestamp_us = now_us});
+  engine.OnPaddleEvent({.line = hal::PaddleLine::kDah, .active = true, .timestamp_us = now_us});
+  for (auto _ : state) {
+    engine.Tick(now_us);
+    now_us += 1000;
+  }
+}
+BENCHMARK(BM_PaddleEngineTickSqueeze)->Arg(20)->Arg(60);
+
+// Same squeeze on the generic (runtime-branching) FSM, the baseline for the one above
+void BM_PaddleEngineTickSqueezeGeneric(benchmark::State& state) {
+  keying::PaddleEngine engine;
+  InitEngine(engine, static_cast<uint32_t>(state.range(0)), keying::FsmVariant::kGeneric);
+  int64_t now_us = 1'000'000;
+  engine.OnPaddleEvent({.line = hal::PaddleLine::kDit, .active = true, .timestamp_us = now_us});
+  engine.OnPaddleEvent({.line = hal::PaddleLine::kDah, .active = true, .timestamp_us = now_us});
+  for (auto _ : state) {
+    engine.Tick(now_us);
+    now_us += 1000;
+  }
+}
+BENCHMARK(BM_PaddleEngineTickSqueezeGeneric)->Arg(20)->Arg(60);
+
+// Press/release pairs as delivered by the paddle ISR queue
+void BM_PaddleEngineOnPaddleEvent(benchmark::State& state) {
+  keying::PaddleEngine engine;
+  InitEngine(engine, 25);
+  int64_t now_us = 1'000'000;
+  bool active = false;
+  for (auto _ : state) {
+    active = !active;
+    engine.OnPaddleEvent({.line = hal::PaddleLine::kDit, .active = active, .timestamp_us = now_us});
+    now_us += 24'000;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PaddleEngineOnPaddleEvent);
+
+// Straight key edges: debounce + key output callback, the whole manual passthrough path
+void BM_StraightKeyPassthrough(benchmark::State& state) {
+  keying::PaddleEngine engine;
+  InitEngine(engine, 25);
+  int64_t now_us = 1'000'000;
+  bool active = false;
+  for (auto _ : state) {
+    active = !active;
+    engine.OnPaddleEvent({.line = hal::PaddleLine::kKey, .active = active, .timestamp_us = now_us});
+    now_us += 24'000;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StraightKeyPassthrough);
+
+void BM_EventLoggerPush(benchmark::State& state) {
+  static timeline::EventLogger<timeline::kTimelineCapacity> logger;
+  timeline::TimelineEvent event{};
+  event.type = timeline::EventType::kKeying;
+  for (auto _ : state) {
+    event.timestamp_us += 1000;
+    logger.push(event);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EventLoggerPush);
+
+// Full ring walk, as done by the timeline API handlers
+void BM_EventLoggerForEach(benchmark::State& state) {
+  static timeline::EventLogger<timeline::kTimelineCapacity> logger;
+  timeline::TimelineEvent event{};
+  for (size_t i = 0; i < timeline::kTimelineCapacity; ++i) {
+    event.timestamp_us = static_cast<int64_t>(i) * 1000;
+    event.arg0 = static_cast<uint32_t>(i);
+    logger.push(event);
+  }
+  for (auto _ : state) {
+    uint64_t sum = 0;
+    logger.for_each([&](const timeline::TimelineEvent& e) { sum += e.arg0; });
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * timeline::kTimelineCapacity);
+}
+BENCHMARK(BM_EventLoggerForEach);
+
+}  // namespace
@@ -0,0 +1,61 @@
+/**
+ * @file benchmark_main.cpp
+ * @brief Entry point of host_benchmarks
+ *
+ * Usage:
+ *   host_benchmarks [--log] [google-benchmark flags]
+ *   host_benchmarks --benchmark_out=bench.json --benchmark_out_format=json
+ *
+ * Same convention as decoder_replay: firmware ESP_LOGx output (stdout on host) is
+ * discarded unless --log is given, so the console table stays readable. JSON output
+ * (--benchmark_out) is unaffected; compare two runs with tools/compare_benchmarks.py.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "benchmark/benchmark.h"
+
+int main(int argc, char** argv) {
+  bool keep_log = false;
+  std::vector<char*> args;
+  for (int i = 0; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--log") == 0) {
+      keep_log = true;
+    } else {
+      args.push_back(argv[i]);
+    }
+  }
+  int bench_argc = static_cast<int>(args.size());
+  benchmark::Initialize(&bench_argc, args.data());
+  if (benchmark::ReportUnrecognizedArguments(bench_argc, args.data())) {
+    return 2;
+  }
+
+  // The console report keeps the original stdout; firmware logs go to /dev/null
+  std::ofstream report;
+  const bool color = isatty(fileno(stdout)) != 0;
+  if (!keep_log) {
+    const int report_fd = dup(fileno(stdout));
+    if (report_fd >= 0 && std::freopen("/dev/null", "w", stdout) != nullptr) {
+      report.open("/dev/fd/" + std::to_string(report_fd));
+    }
+  }
+
+  if (report.is_open()) {
+    benchmark::ConsoleReporter console(color ? benchmark::ConsoleReporter::OO_Defaults
+                                             : benchmark::ConsoleReporter::OO_Tabular);
+    console.SetOutputStream(&report);
+    console.SetErrorStream(&report);
+    benchmark::RunSpecifiedBenchmarks(&console);
+  } else {
+    benchmark::RunSpecifiedBenchmarks();
+  }
+  benchmark::Shutdown();
+  return 0;
+}
@@ -0,0 +1,150 @@
+#include "keying/iambic_policy.hpp"
+#include "keying/paddle_engine.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+#include "hal/paddle_hal.hpp"
+
+namespace {
+
+using keying::IambicMode;
+using keying::MemoryMode;
+using keying::SqueezeMode;
+
+// Everything the engine reports, in call order: (kind, a, b, timestamp)
+struct Trace {
+  enum Kind : int { kStarted, kFinished, kKey, kMemory, kSqueeze };
+  std::vector<std::tuple<int, int, int, int64_t>> entries;
+
+  keying::PaddleEngineCallbacks Callbacks() {
+    keying::PaddleEngineCallbacks callbacks{
+        .on_element_started =
+            [](keying::PaddleElement element, int64_t ts, void* ctx) {
+              static_cast<Trace*>(ctx)->entries.emplace_back(kStarted, static_cast<int>(element), 0, ts);
+            },
+        .on_element_finished =
+            [](keying::PaddleElement element, int64_t ts, void* ctx) {
+              static_cast<Trace*>(ctx)->entries.emplace_back(kFinished, static_cast<int>(element), 0, ts);
+            },
+        .on_key_state_changed =
+            [](bool active, int64_t ts, void* ctx) {
+              static_cast<Trace*>(ctx)->entries.emplace_back(kKey, active ? 1 : 0, 0, ts);
+            },
+        .context = this,
+    };
+    callbacks.timeline_hooks.OnMemoryWindowChanged = [](bool is_dah, bool opened, int64_t ts,
+                                                        void* ctx) {
+      static_cast<Trace*>(ctx)->entries.emplace_back(kMemory, is_dah ? 1 : 0, opened ? 1 : 0, ts);
+    };
+    callbacks.timeline_hooks.OnSqueezeDetected = [](int64_t ts, void* ctx) {
+      static_cast<Trace*>(ctx)->entries.emplace_back(kSqueeze, 0, 0, ts);
+    };
+    callbacks.timeline_hooks.context = this;
+    return callbacks;
+  }
+};
+
+// Deterministic paddle script: random press/release times on both paddles, ticked at a
+// step that does not divide the element length so window edges land between ticks
+Trace RunScript(keying::PaddleEngineConfig config, keying::FsmVariant variant, uint32_t seed) {
+  config.fsm_variant = variant;
+  Trace trace;
+  keying::PaddleEngine engine;
+  EXPECT_TRUE(engine.Initialize(config, trace.Callbacks()));
+
+  uint32_t rng = seed;
+  auto next = [&rng]() {
+    rng = rng * 1664525u + 1013904223u;
+    return rng >> 8;
+  };
+
+  bool dit = false;
+  bool dah = false;
+  int64_t next_edge_us = 0;
+  for (int64_t now_us = 0; now_us < 3'000'000; now_us += 700) {
+    if (now_us >= next_edge_us) {
+      const bool toggle_dah = (next() & 1u) != 0;
+      bool& line_state = toggle_dah ? dah : dit;
+      line_state = !line_state;
+      engine.OnPaddleEvent({.line = toggle_dah ? hal::PaddleLine::kDah : hal::PaddleLine::kDit,
+                            .active = line_state,
+                            .timestamp_us = now_us});
+      next_edge_us = now_us + 5'000 + static_cast<int64_t>(next() % 150'000);
+    }
+    engine.Tick(now_us);
+  }
+  return trace;
+}
+
+struct WindowCase {
+  float open_pct;
+  float close_pct;
+};
+
+TEST(IambicPolicyTest, SpecializedMatchesGenericForAllPolicies) {
+  const IambicMode iambic_modes[] = {IambicMode::kA, IambicMode::kB};
+  const MemoryMode memory_modes[] = {MemoryMode::kNone, MemoryMode::kDotOnly,
+                                     MemoryMode::kDahOnly, MemoryMode::kDotAndDah};
+  const SqueezeMode squeeze_modes[] = {SqueezeMode::kSnapshot, SqueezeMode::kLive};
+  // Default, SuperKeyer, Accukeyer/Curtis A, dead zones at both ends
+  const WindowCase windows[] = {{0.0f, 100.0f}, {55.0f, 99.0f}, {60.0f, 99.0f}, {15.0f, 85.0f}};
+
+  for (IambicMode iambic : iambic_modes) {
+    for (MemoryMode memory : memory_modes) {
+      for (SqueezeMode squeeze : squeeze_modes) {
+        for (const WindowCase& window : windows) {
+          keying::PaddleEngineConfig config{};
+          config.speed_wpm = 28;
+          config.iambic_mode = iambic;
+          config.memory_mode = memory;
+          config.squeeze_mode = squeeze;
+          config.mem_block_start_pct = window.open_pct;
+          config.mem_block_end_pct = window.close_pct;
+
+          for (uint32_t seed = 1; seed <= 3; ++seed) {
+            const Trace generic = RunScript(config, keying::FsmVariant::kGeneric, seed);
+            const Trace specialized = RunScript(config, keying::FsmVariant::kSpecialized, seed);
+            ASSERT_FALSE(generic.entries.empty());
+            ASSERT_EQ(generic.entries, specialized.entries)
+                << "iambic=" << static_cast<int>(iambic) << " memory=" << static_cast<int>(memory)
+                << " squeeze=" << static_cast<int>(squeeze) << " window=" << window.open_pct
+                << "-" << window.close_pct << " seed=" << seed;
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(IambicPolicyTest, ArmTableArmsOnlyOppositeElement) {
+  using Both = keying::IambicPolicy<IambicMode::kB, MemoryMode::kDotAndDah, SqueezeMode::kLive>;
+  constexpr size_t kDitOnly = 1;
+  constexpr size_t kDahOnly = 2;
+  constexpr size_t kSqueeze = 3;
+  constexpr size_t kSendingDit = 0;
+  constexpr size_t kSendingDah = 1;
+
+  EXPECT_EQ(0, Both::kArmTable[0][kSendingDit]);
+  EXPECT_EQ(0, Both::kArmTable[kDitOnly][kSendingDit]);
+  EXPECT_EQ(keying::arm_action::kArmDit | keying::arm_action::kNotifyMemory,
+            Both::kArmTable[kDitOnly][kSendingDah]);
+  EXPECT_EQ(keying::arm_action::kArmDah | keying::arm_action::kNotifyMemory,
+            Both::kArmTable[kDahOnly][kSendingDit]);
+  EXPECT_EQ(keying::arm_action::kArmDah | keying::arm_action::kSqueeze,
+            Both::kArmTable[kSqueeze][kSendingDit]);
+
+  using DotOnly = keying::IambicPolicy<IambicMode::kB, MemoryMode::kDotOnly, SqueezeMode::kSnapshot>;
+  EXPECT_EQ(0, DotOnly::kArmTable[kDahOnly][kSendingDit]);
+  EXPECT_EQ(keying::arm_action::kSqueeze, DotOnly::kArmTable[kSqueeze][kSendingDit]);
+
+  using NoMemory = keying::IambicPolicy<IambicMode::kB, MemoryMode::kNone, SqueezeMode::kSnapshot>;
+  EXPECT_FALSE(NoMemory::kDitMemory);
+  EXPECT_FALSE(NoMemory::kDahMemory);
+  EXPECT_EQ(keying::arm_action::kSqueeze, NoMemory::kArmTable[kSqueeze][kSendingDah]);
+}
+
+}  // namespace
@@ -0,0 +1,203 @@
+#include "keying/keying_channels.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+#include "hal/paddle_hal.hpp"
+
+namespace {
+
+constexpr int64_t kTickUs = 1'000;
+constexpr int64_t kDitUs20Wpm = 60'000;
+
+struct ChannelRecorder {
+  struct KeyEdge {
+    uint8_t channel;
+    bool active;
+    int64_t timestamp_us;
+  };
+
+  std::vector<KeyEdge> keys;
+  std::vector<std::tuple<bool, int64_t>> focus_stream;
+  std::vector<uint8_t> focus_changes;
+
+  keying::KeyingChannelCallbacks Callbacks() {
+    return keying::KeyingChannelCallbacks{
+        .on_key_state_changed =
+            [](uint8_t channel, bool active, int64_t ts, void* ctx) {
+              static_cast<ChannelRecorder*>(ctx)->keys.push_back({channel, active, ts});
+            },
+        .on_focus_key_changed =
+            [](bool active, int64_t ts, void* ctx) {
+              static_cast<ChannelRecorder*>(ctx)->focus_stream.emplace_back(active, ts);
+            },
+        .on_focus_changed =
+            [](uint8_t channel, int64_t, void* ctx) {
+              static_cast<ChannelRecorder*>(ctx)->focus_changes.push_back(channel);
+            },
+        .context = this,
+    };
+  }
+
+  std::vector<KeyEdge> KeysOf(uint8_t channel) const {
+    std::vector<KeyEdge> result;
+    for (const auto& edge : keys) {
+      if (edge.channel == channel) {
+        result.push_back(edge);
+      }
+    }
+    return result;
+  }
+};
+
+hal::PaddleEvent Edge(hal::PaddleLine line, bool active, int64_t ts, uint8_t input_set = 0) {
+  return {.line = line, .active = active, .timestamp_us = ts, .channel = input_set};
+}
+
+void InitRouter(keying::KeyingChannelRouter& router, ChannelRecorder& recorder, size_t count) {
+  router.Initialize(count, recorder.Callbacks());
+  keying::PaddleEngineConfig config{};
+  config.speed_wpm = 20;
+  for (size_t i = 0; i < count; ++i) {
+    ASSERT_TRUE(router.Configure(static_cast<uint8_t>(i), config));
+  }
+}
+
+void RunUntil(keying::KeyingChannelRouter& router, int64_t& now_us, int64_t end_us) {
+  for (; now_us < end_us; now_us += kTickUs) {
+    router.Tick(now_us);
+  }
+}
+
+TEST(KeyingChannelRouterTest, MainPaddleFollowsFocus) {
+  keying::KeyingChannelRouter router;
+  ChannelRecorder recorder;
+  InitRouter(router, recorder, 2);
+
+  int64_t now = 0;
+  router.OnPaddleEvent(Edge(hal::PaddleLine::kKey, true, now));
+  router.OnPaddleEvent(Edge(hal::PaddleLine::kKey, false, 50'000));
+  ASSERT_EQ(2u, recorder.KeysOf(0).size());
+  EXPECT_TRUE(recorder.KeysOf(1).empty());
+
+  router.OnPaddleEvent(Edge(hal::PaddleLine::kFocus, true, 100'000, 1));
+  EXPECT_EQ(1, router.focus());
+  ASSERT_EQ(1u, recorder.focus_changes.size());
+  router.OnPaddleEvent(Edge(hal::PaddleLine::kKey, true, 150'000));
+  router.OnPaddleEvent(Edge(hal::PaddleLine::kKey, false, 200'000));
+  EXPECT_EQ(2u, recorder.KeysOf(0).size());
+  EXPECT_EQ(2u, recorder.KeysOf(1).size());
+  EXPECT_EQ(4u, recorder.focus_stream.size());
+}
+
+TEST(KeyingChannelRouterTest, FocusSwitchCompletesOldElementAndStartsNewWithinOneTick) {
+  keying::KeyingChannelRouter router;
+  ChannelRecorder recorder;
+  InitRouter(router, recorder, 2);
+
+  int64_t now = 0;
+  router.OnPaddleEvent(Edge(hal::PaddleLine::kDit, true, now));
+  RunUntil(router, now, 130'000);  // Second dit in progress on channel 0
+
+  const int64_t switch_us = now;
+  router.SetFocus(1, switch_us);
+  RunUntil(router, now, 400'000);
+
+  // Channel 0: whole dits only, nothing after the element in progress
+  const auto old_keys = recorder.KeysOf(0);
+  ASSERT_EQ(4u, old_keys.size());
+  for (size_t i = 0; i < old_keys.size(); i += 2) {
+    EXPECT_EQ(kDitUs20Wpm, old_keys[i + 1].timestamp_us - old_keys[i].timestamp_us);
+  }
+  EXPECT_GT(old_keys.back().timestamp_us, switch_us);
+
+  // Channel 1 picked up the held paddle at its first tick after the switch
+  const auto new_keys = recorder.KeysOf(1);
+  ASSERT_FALSE(new_keys.empty());
+  EXPECT_TRUE(new_keys[0].active);
+  EXPECT_LE(new_keys[0].timestamp_us - switch_us, kTickUs);
+}
+
+TEST(KeyingChannelRouterTest, DedicatedInputTimingUnaffectedByOtherChannel) {
+  auto run = [](bool busy_main_paddle) {
+    keying::KeyingChannelRouter router;
+    ChannelRecorder recorder;
+    InitRouter(router, recorder, 2);
+    for (int64_t t = 0; t < 1'000'000; t += kTickUs) {
+      if (t % 170'000 == 0) {
+        router.OnPaddleEvent(Edge(hal::PaddleLine::kDah, (t / 170'000) % 2 == 0, t, 1));
+      }
+      if (busy_main_paddle && t % 23'000 == 0) {
+        router.OnPaddleEvent(Edge(hal::PaddleLine::kDit, (t / 23'000) % 2 == 0, t));
+        router.OnPaddleEvent(Edge(hal::PaddleLine::kDah, (t / 23'000) % 3 == 0, t));
+        router.SetFocus((t / 23'000) % 2 == 0 ? 0 : 1, t);
+        router.SetFocus(0, t);
+      }
+      router.Tick(t);
+    }
+    return recorder.KeysOf(1);
+  };
+
+  const auto quiet = run(false);
+  const auto busy = run(true);
+  ASSERT_FALSE(quiet.empty());
+  ASSERT_EQ(quiet.size(), busy.size());
+  for (size_t i = 0; i < quiet.size(); ++i) {
+    EXPECT_EQ(quiet[i].active, busy[i].active);
+    EXPECT_EQ(quiet[i].timestamp_us, busy[i].timestamp_us) << "edge " << i;
+  }
+}
+
+TEST(KeyingChannelRouterTest, FocusStreamNeverOverlaps) {
+  keying::KeyingChannelRouter router;
+  ChannelRecorder recorder;
+  InitRouter(router, recorder, 3);
+
+  uint32_t rng = 7;
+  auto next = [&rng]() {
+    rng = rng * 1664525u + 1013904223u;
+    return rng >> 8;
+  };
+  bool held[3][2]{};
+  for (int64_t t = 0; t < 3'000'000; t += kTickUs) {
+    if (next() % 20 == 0) {
+      const uint8_t input_set = static_cast<uint8_t>(next() % 3);
+      const size_t line = next() % 2;
+      held[input_set][line] = !held[input_set][line];
+      router.OnPaddleEvent(
+          Edge(static_cast<hal::PaddleLine>(line), held[input_set][line], t, input_set));
+    }
+    if (next() % 200 == 0) {
+      router.SetFocus(static_cast<uint8_t>(next() % 3), t);
+    }
+    router.Tick(t);
+  }
+
+  ASSERT_GT(recorder.focus_stream.size(), 10u);
+  int64_t last_ts = -1;
+  for (size_t i = 0; i < recorder.focus_stream.size(); ++i) {
+    EXPECT_EQ(i % 2 == 0, std::get<0>(recorder.focus_stream[i])) << "edge " << i;
+    EXPECT_GE(std::get<1>(recorder.focus_stream[i]), last_ts);
+    last_ts = std::get<1>(recorder.focus_stream[i]);
+  }
+}
+
+TEST(KeyingChannelRouterTest, OutOfRangeInputsAndFocusAreIgnored) {
+  keying::KeyingChannelRouter router;
+  ChannelRecorder recorder;
+  InitRouter(router, recorder, 2);
+
+  router.OnPaddleEvent(Edge(hal::PaddleLine::kKey, true, 1'000, 3));
+  EXPECT_EQ(1u, router.dropped_events());
+  EXPECT_TRUE(recorder.keys.empty());
+
+  router.SetFocus(2, 2'000);
+  EXPECT_EQ(0, router.focus());
+  EXPECT_TRUE(recorder.focus_changes.empty());
+  EXPECT_FALSE(router.Configure(2, keying::PaddleEngineConfig{}));
+}
+
+}  // namespace
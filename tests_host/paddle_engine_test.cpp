@@ -45,9 +45,14 @@ int64_t DitDurationUs(uint32_t wpm) {
   return static_cast<int64_t>(seconds * 1'000'000.0);
 }
 
-TEST(PaddleEngineTest, ImmediateDitSchedulesElement) {
+// Every scenario runs on both FSM variants: the specialized (IambicPolicy) engine
+// must key exactly like the generic reference engine
+class PaddleEngineTest : public ::testing::TestWithParam<keying::FsmVariant> {};
+
+TEST_P(PaddleEngineTest, ImmediateDitSchedulesElement) {
   keying::PaddleEngine engine;
   keying::PaddleEngineConfig config{};
+  config.fsm_variant = GetParam();
   CallbackRecorder recorder;
   keying::PaddleEngineCallbacks callbacks{
       .on_element_started = CallbackRecorder::OnStarted,
@@ -67,9 +72,10 @@ TEST(PaddleEngineTest, ImmediateDitSchedulesElement) {
   EXPECT_EQ(press_time, recorder.elements[0].timestamp_us);
 }
 
-TEST(PaddleEngineTest, MemoryWindowCapturesSqueezeWithinRange) {
+TEST_P(PaddleEngineTest, MemoryWindowCapturesSqueezeWithinRange) {
   keying::PaddleEngine engine;
   keying::PaddleEngineConfig config{};
+  config.fsm_variant = GetParam();
   config.speed_wpm = 20;
   config.mem_block_start_pct = 60.0f;
   config.mem_block_end_pct = 99.0f;
@@ -98,4 +104,46 @@ TEST(PaddleEngineTest, MemoryWindowCapturesSqueezeWithinRange) {
   EXPECT_TRUE(recorder.elements.back().started);
 }
 
+TEST_P(PaddleEngineTest, ReportsPlannedAndActualEdgeTimes) {
+  keying::PaddleEngine engine;
+  keying::PaddleEngineConfig config{};
+  config.fsm_variant = GetParam();
+  config.speed_wpm = 20;
+  struct Deadline {
+    keying::DeadlineKind kind;
+    int64_t planned_us;
+    int64_t actual_us;
+  };
+  std::vector<Deadline> deadlines;
+  keying::PaddleEngineCallbacks callbacks{
+      .on_deadline =
+          [](keying::DeadlineKind kind, int64_t planned_us, int64_t actual_us, void* context) {
+            static_cast<std::vector<Deadline>*>(context)->push_back(Deadline{kind, planned_us, actual_us});
+          },
+      .context = &deadlines,
+  };
+  ASSERT_TRUE(engine.Initialize(config, callbacks));
+
+  // Held dit: the first element ends 300 us late, the next starts late out of its gap
+  const int64_t dit = DitDurationUs(config.speed_wpm);
+  engine.OnPaddleEvent({.line = hal::PaddleLine::kDit, .active = true, .timestamp_us = 0});
+  engine.Tick(0);
+  engine.Tick(dit + 300);
+  ASSERT_EQ(1u, deadlines.size());
+  EXPECT_EQ(keying::DeadlineKind::kElementEnd, deadlines[0].kind);
+  EXPECT_EQ(dit, deadlines[0].planned_us);
+  EXPECT_EQ(dit + 300, deadlines[0].actual_us);
+
+  // The gap runs from the planned element end: lateness does not carry over
+  engine.Tick(2 * dit + 1500);
+  ASSERT_EQ(2u, deadlines.size());
+  EXPECT_EQ(keying::DeadlineKind::kElementStart, deadlines[1].kind);
+  EXPECT_EQ(2 * dit, deadlines[1].planned_us);
+  EXPECT_EQ(1500, deadlines[1].actual_us - deadlines[1].planned_us);
+}
+
+INSTANTIATE_TEST_SUITE_P(FsmVariants, PaddleEngineTest,
+                         ::testing::Values(keying::FsmVariant::kSpecialized,
+                                           keying::FsmVariant::kGeneric));
+
 }  // namespace
@@ -129,3 +129,36 @@ TEST_F(PaddleHalTest, HasConfiguredPinsReflectsConfiguredState) {
   hal.Shutdown();
   EXPECT_FALSE(hal.IsInitialized());
 }
+
+TEST_F(PaddleHalTest, FocusFootswitchAndInputSetAreStampedOnEvents) {
+  hal::PaddleHal hal;
+  hal::PaddleHalConfig config{};
+  config.dit.gpio = 1;
+  config.focus.gpio = 4;
+  config.channel = 2;
+
+  fake_gpio_set_level(1, 1);
+  fake_gpio_set_level(4, 1);
+  PaddleCallbackContext ctx{};
+  ASSERT_EQ(ESP_OK, hal.Initialize(config, &TestPaddleCallback, &ctx));
+  EXPECT_TRUE(fake_gpio_snapshot(4).configured);
+  hal.Poll();
+  ASSERT_TRUE(ctx.events.empty());
+
+  fake_esp_timer_set_time(100);
+  fake_gpio_set_level(1, 0);
+  fake_gpio_set_level(4, 0);
+  hal.Poll();
+  ASSERT_EQ(2U, ctx.events.size());
+  EXPECT_EQ(hal::PaddleLine::kDit, ctx.events[0].line);
+  EXPECT_EQ(2U, ctx.events[0].channel);
+  EXPECT_EQ(hal::PaddleLine::kFocus, ctx.events[1].line);
+  EXPECT_TRUE(ctx.events[1].active);
+  EXPECT_EQ(1U, ctx.events[1].channel);
+
+  fake_gpio_set_level(4, 1);
+  hal.Poll();
+  ASSERT_EQ(3U, ctx.events.size());
+  EXPECT_FALSE(ctx.events[2].active);
+  EXPECT_EQ(0U, ctx.events[2].channel);
+}
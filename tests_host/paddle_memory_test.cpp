@@ -0,0 +1,118 @@
+#include "keying/paddle_memory.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using Edge = keying::PaddleMemoryPlayer::Edge;
+
+// "K" as sent by a human: uneven dah/dit weight, 21 WPM-ish
+const std::vector<Edge> kFist = {
+    {true, 1'000'000}, {false, 1'172'431}, {true, 1'231'907}, {false, 1'287'002},
+    {true, 1'349'118}, {false, 1'530'660},
+};
+
+void Record(keying::PaddleMemoryRecorder& recorder, const std::vector<Edge>& edges) {
+  recorder.Start();
+  for (const Edge& edge : edges) {
+    recorder.OnKeyEdge(edge.key_active, edge.timestamp_us);
+  }
+}
+
+std::vector<Edge> Replay(keying::PaddleMemoryPlayer& player, int64_t from_us, int64_t step_us) {
+  std::vector<Edge> edges;
+  for (int64_t now = from_us; player.active(); now += step_us) {
+    Edge edge;
+    while (player.PopDue(now, &edge)) {
+      edges.push_back(edge);
+    }
+  }
+  return edges;
+}
+
+TEST(PaddleMemoryTest, ReplaysRecordedEdgesAtScheduledMicroseconds) {
+  keying::PaddleMemoryRecorder recorder;
+  Record(recorder, kFist);
+  const size_t size = recorder.Stop(2'000'000);
+  ASSERT_GT(size, 0U);
+  EXPECT_LE(size, timeline::kEdgeStreamHeaderSize + kFist.size() * 3);
+
+  keying::PaddleMemoryPlayer player;
+  ASSERT_TRUE(player.Start(recorder.data(), size, 100, 5'000'000));
+  // A coarse 1 ms poll still reports the exact schedule
+  const auto edges = Replay(player, 5'000'000, 1'000);
+  ASSERT_EQ(kFist.size(), edges.size());
+  for (size_t i = 0; i < edges.size(); ++i) {
+    EXPECT_EQ(kFist[i].key_active, edges[i].key_active);
+    EXPECT_EQ(kFist[i].timestamp_us - kFist[0].timestamp_us + 5'000'000, edges[i].timestamp_us)
+        << "edge " << i;
+  }
+  EXPECT_FALSE(player.key_active());
+}
+
+TEST(PaddleMemoryTest, SpeedScalingShortensEveryGap) {
+  keying::PaddleMemoryRecorder recorder;
+  Record(recorder, kFist);
+  const size_t size = recorder.Stop(2'000'000);
+
+  keying::PaddleMemoryPlayer player;
+  ASSERT_TRUE(player.Start(recorder.data(), size, 200, 0));
+  const auto edges = Replay(player, 0, 1'000);
+  ASSERT_EQ(kFist.size(), edges.size());
+  for (size_t i = 0; i < edges.size(); ++i) {
+    EXPECT_EQ((kFist[i].timestamp_us - kFist[0].timestamp_us) / 2, edges[i].timestamp_us);
+  }
+}
+
+TEST(PaddleMemoryTest, StopReleasesKeyHeldAtEndOfRecording) {
+  keying::PaddleMemoryRecorder recorder;
+  recorder.Start();
+  recorder.OnKeyEdge(false, 10);  // Leading key-up is not recorded
+  recorder.OnKeyEdge(true, 100);
+  ASSERT_EQ(timeline::kEdgeStreamHeaderSize + 2, recorder.Stop(150));
+  EXPECT_FALSE(recorder.active());
+
+  keying::PaddleMemoryPlayer player;
+  ASSERT_TRUE(player.Start(recorder.data(), recorder.size(), 100, 0));
+  Edge edge;
+  ASSERT_TRUE(player.PopDue(0, &edge));
+  EXPECT_TRUE(player.key_active());
+  EXPECT_TRUE(player.Stop());  // Aborted with the key down
+  EXPECT_FALSE(player.active());
+}
+
+TEST(PaddleMemoryTest, EmptyOrInvalidRecordingsDoNotPlay) {
+  keying::PaddleMemoryRecorder recorder;
+  recorder.Start();
+  EXPECT_EQ(0U, recorder.Stop(1'000));
+
+  keying::PaddleMemoryPlayer player;
+  EXPECT_FALSE(player.Start(recorder.data(), recorder.size(), 100, 0));
+  const uint8_t garbage[] = {0xED, 1, 2, 0, 0x80};
+  EXPECT_FALSE(player.Start(garbage, sizeof(garbage), 100, 0));
+  EXPECT_FALSE(player.active());
+}
+
+TEST(PaddleMemoryTest, LongRecordingKeepsCompleteMarks) {
+  keying::PaddleMemoryRecorder recorder;
+  recorder.Start();
+  int64_t t = 0;
+  for (int i = 0; i < 1000; ++i) {
+    recorder.OnKeyEdge(i % 2 == 0, t);
+    t += 60'000;
+  }
+  const size_t size = recorder.Stop(t);
+  EXPECT_TRUE(recorder.truncated());
+  EXPECT_LE(size, keying::kPaddleMemoryMaxBytes);
+
+  keying::PaddleMemoryPlayer player;
+  ASSERT_TRUE(player.Start(recorder.data(), size, 100, 0));
+  const auto edges = Replay(player, 0, 10'000);
+  ASSERT_FALSE(edges.empty());
+  EXPECT_FALSE(edges.back().key_active);
+}
+
+}  // namespace
@@ -155,6 +155,102 @@ TEST_F(SidetoneServiceTest, PumpAudioOncePropagatesDriverFailure) {
   ASSERT_EQ(1u, driver_ptr->write_records.size());
 }
 
+class SidetoneIdlePowerTest : public SidetoneServiceTest {
+ protected:
+  void SetUp() override {
+    SidetoneServiceTest::SetUp();
+    auto driver = std::make_unique<FakeCodecDriver>();
+    driver_ = driver.get();
+    service_.SetCodecDriverForTesting(std::move(driver));
+    SidetoneConfig config = DefaultConfig();
+    config.idle_timeout_ms = 100;
+    ASSERT_EQ(ESP_OK, service_.Initialize(config));
+  }
+
+  /// Key one tone, then pump silence until the idle timeout powers the pump down
+  void PowerDownAfterTone() {
+    ASSERT_EQ(ESP_OK, service_.Start());
+    ASSERT_EQ(ESP_OK, service_.PumpAudioOnceForTest());
+    service_.Stop();
+    for (int i = 0; i < 40 && !service_.IsPoweredDown(); ++i) {
+      fake_esp_timer_advance(16'000);  // One 256-frame chunk at 16 kHz
+      service_.PumpAudioOnceForTest();
+    }
+    ASSERT_TRUE(service_.IsPoweredDown());
+  }
+
+  i2s_chan_handle_t channel() const { return driver_->last_config.i2s_tx_handle; }
+
+  SidetoneService service_;
+  FakeCodecDriver* driver_ = nullptr;
+};
+
+TEST_F(SidetoneIdlePowerTest, SilencePowersDownAndWakeResumesThePump) {
+  PowerDownAfterTone();
+  EXPECT_FALSE(fake_i2s_snapshot(channel()).enabled);
+  const size_t writes = driver_->write_records.size();
+  EXPECT_EQ(ESP_ERR_INVALID_STATE, service_.PumpAudioOnceForTest());
+  EXPECT_EQ(writes, driver_->write_records.size());
+
+  fake_esp_timer_advance(2'000'000);
+  service_.Wake();  // First paddle edge
+  EXPECT_FALSE(service_.IsPoweredDown());
+  EXPECT_TRUE(fake_i2s_snapshot(channel()).enabled);
+  EXPECT_TRUE(fake_i2s_snapshot(channel()).preloaded.empty());  // No tone requested yet
+
+  fake_esp_timer_advance(150);
+  ASSERT_EQ(ESP_OK, service_.PumpAudioOnceForTest());
+  const audio::SidetonePowerStats stats = service_.GetPowerStats();
+  EXPECT_EQ(1U, stats.power_downs);
+  EXPECT_EQ(1U, stats.wakes);
+  EXPECT_EQ(0U, stats.preloaded_wakes);
+  EXPECT_EQ(150U, stats.last_wake_latency_us);
+  EXPECT_GE(stats.powered_down_us, 2'000'000);
+  EXPECT_EQ(16'000U, stats.chunk_period_us);
+}
+
+TEST_F(SidetoneIdlePowerTest, StartWhilePoweredDownPreloadsTheFadeIn) {
+  PowerDownAfterTone();
+  ASSERT_EQ(ESP_OK, service_.Start());
+  EXPECT_FALSE(service_.IsPoweredDown());
+
+  const auto snapshot = fake_i2s_snapshot(channel());
+  EXPECT_TRUE(snapshot.enabled);
+  ASSERT_EQ(SidetoneService::kWakePrerollFrames * SidetoneService::kCodecChannelCount,
+            snapshot.preloaded.size());
+
+  // The pump continues exactly where the preloaded frames end
+  audio::ToneGenerator reference;
+  audio::ToneGeneratorSettings settings = DefaultConfig().tone_settings;
+  reference.Configure(settings);
+  reference.Start();
+  std::vector<int16_t> expected(SidetoneService::kFramesPerChunk * SidetoneService::kCodecChannelCount);
+  reference.Fill(expected.data(), SidetoneService::kWakePrerollFrames);
+  EXPECT_TRUE(std::equal(snapshot.preloaded.begin(), snapshot.preloaded.end(), expected.begin()));
+  EXPECT_LT(std::abs(snapshot.preloaded[2]), 200);  // Fade-in starts near zero
+
+  ASSERT_EQ(ESP_OK, service_.PumpAudioOnceForTest());
+  reference.Fill(expected.data(), SidetoneService::kFramesPerChunk);
+  EXPECT_EQ(expected, driver_->write_records.back().samples);
+  EXPECT_EQ(1U, service_.GetPowerStats().preloaded_wakes);
+}
+
+TEST_F(SidetoneServiceTest, ZeroIdleTimeoutKeepsPumpingSilence) {
+  SidetoneService service;
+  auto driver = std::make_unique<FakeCodecDriver>();
+  FakeCodecDriver* driver_ptr = driver.get();
+  service.SetCodecDriverForTesting(std::move(driver));
+  ASSERT_EQ(ESP_OK, service.Initialize(DefaultConfig()));
+  ASSERT_EQ(ESP_OK, service.Start());
+  service.Stop();
+  for (int i = 0; i < 100; ++i) {
+    fake_esp_timer_advance(16'000);
+    ASSERT_EQ(ESP_OK, service.PumpAudioOnceForTest());
+  }
+  EXPECT_FALSE(service.IsPoweredDown());
+  EXPECT_EQ(100U, driver_ptr->write_records.size());
+}
+
 TEST(ToneGeneratorTest, GeneratesThreeBurstsWithPreciseTiming) {
   audio::ToneGenerator generator;
   audio::ToneGeneratorSettings settings{};
@@ -244,4 +340,40 @@ TEST(ToneGeneratorTest, GeneratesThreeBurstsWithPreciseTiming) {
   }
 }
 
+TEST(ToneGeneratorTest, PanAttenuatesFarChannelOnly) {
+  audio::ToneGenerator generator;
+  audio::ToneGeneratorSettings settings{};
+  settings.sample_rate_hz = 16000;
+  settings.tone_frequency_hz = 500;
+  settings.fade_in_ms = 1;
+  generator.Configure(settings);
+  generator.Start();
+
+  auto peaks = [&generator]() {
+    std::vector<int16_t> raw(512 * 2);
+    generator.Fill(raw.data(), 512);
+    int32_t left = 0;
+    int32_t right = 0;
+    for (size_t i = 64; i < 512; ++i) {  // Skip the fade-in
+      left = std::max(left, std::abs(static_cast<int32_t>(raw[i * 2])));
+      right = std::max(right, std::abs(static_cast<int32_t>(raw[i * 2 + 1])));
+    }
+    return std::make_pair(left, right);
+  };
+
+  const auto centre = peaks();
+  EXPECT_EQ(centre.first, centre.second);
+
+  generator.SetPan(-100);
+  EXPECT_EQ(-100, generator.Pan());
+  const auto hard_left = peaks();
+  EXPECT_EQ(centre.first, hard_left.first);
+  EXPECT_EQ(0, hard_left.second);
+
+  generator.SetPan(50);
+  const auto half_right = peaks();
+  EXPECT_EQ(centre.second, half_right.second);
+  EXPECT_NEAR(centre.first / 2, half_right.first, 2);
+}
+
 }  // namespace
@@ -0,0 +1,232 @@
+#include "keying/paddle_engine.hpp"
+#include "keying/straight_key.hpp"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include "hal/paddle_hal.hpp"
+
+namespace {
+
+struct KeyRecorder {
+  struct ElementEvent {
+    keying::PaddleElement element;
+    bool started;
+    int64_t timestamp_us;
+  };
+  struct KeyEvent {
+    bool active;
+    int64_t timestamp_us;
+  };
+
+  static void OnStarted(keying::PaddleElement element, int64_t timestamp_us, void* context) {
+    static_cast<KeyRecorder*>(context)->elements.push_back({element, true, timestamp_us});
+  }
+
+  static void OnFinished(keying::PaddleElement element, int64_t timestamp_us, void* context) {
+    static_cast<KeyRecorder*>(context)->elements.push_back({element, false, timestamp_us});
+  }
+
+  static void OnKeyChanged(bool active, int64_t timestamp_us, void* context) {
+    static_cast<KeyRecorder*>(context)->key_states.push_back({active, timestamp_us});
+  }
+
+  keying::PaddleEngineCallbacks Callbacks() {
+    return keying::PaddleEngineCallbacks{
+        .on_element_started = OnStarted,
+        .on_element_finished = OnFinished,
+        .on_key_state_changed = OnKeyChanged,
+        .context = this,
+    };
+  }
+
+  std::vector<ElementEvent> elements;
+  std::vector<KeyEvent> key_states;
+};
+
+hal::PaddleEvent KeyEdge(bool active, int64_t timestamp_us) {
+  return {.line = hal::PaddleLine::kKey, .active = active, .timestamp_us = timestamp_us};
+}
+
+TEST(StraightKeyDebouncerTest, AcceptsLeadingEdgeAndRejectsBounce) {
+  keying::StraightKeyDebouncer debouncer;
+  debouncer.Configure(5'000);
+
+  EXPECT_TRUE(debouncer.OnEdge(true, 1'000));
+  EXPECT_TRUE(debouncer.state());
+  EXPECT_FALSE(debouncer.OnEdge(false, 1'200));
+  EXPECT_FALSE(debouncer.OnEdge(true, 1'400));
+  EXPECT_TRUE(debouncer.state());
+  EXPECT_EQ(1u, debouncer.rejected_edges());
+
+  // Contact settled closed: nothing to apply after the lockout
+  EXPECT_FALSE(debouncer.Poll(7'000));
+  EXPECT_TRUE(debouncer.OnEdge(false, 60'000));
+  EXPECT_FALSE(debouncer.state());
+}
+
+TEST(StraightKeyDebouncerTest, PollAppliesTapShorterThanLockout) {
+  keying::StraightKeyDebouncer debouncer;
+  debouncer.Configure(5'000);
+
+  ASSERT_TRUE(debouncer.OnEdge(true, 1'000));
+  EXPECT_FALSE(debouncer.OnEdge(false, 3'000));  // Released inside the lockout
+  EXPECT_FALSE(debouncer.Poll(5'999));
+  EXPECT_TRUE(debouncer.Poll(6'000));
+  EXPECT_FALSE(debouncer.state());
+  EXPECT_EQ(6'000, debouncer.last_change_us());
+}
+
+TEST(StraightKeyDebouncerTest, ZeroLockoutFollowsEveryEdge) {
+  keying::StraightKeyDebouncer debouncer;
+  debouncer.Configure(0);
+
+  EXPECT_TRUE(debouncer.OnEdge(true, 100));
+  EXPECT_TRUE(debouncer.OnEdge(false, 101));
+  EXPECT_TRUE(debouncer.OnEdge(true, 102));
+  EXPECT_EQ(0u, debouncer.rejected_edges());
+}
+
+TEST(StraightKeyPassthroughTest, KeyEdgeDrivesOutputInsideEventHandler) {
+  keying::PaddleEngine engine;
+  keying::PaddleEngineConfig config{};
+  KeyRecorder recorder;
+  ASSERT_TRUE(engine.Initialize(config, recorder.Callbacks()));
+
+  // No Tick() in between: the output must change within OnPaddleEvent itself,
+  // stamped with the edge time (zero simulated latency)
+  engine.OnPaddleEvent(KeyEdge(true, 10'000));
+  ASSERT_EQ(1u, recorder.key_states.size());
+  EXPECT_TRUE(recorder.key_states[0].active);
+  EXPECT_EQ(10'000, recorder.key_states[0].timestamp_us);
+
+  engine.OnPaddleEvent(KeyEdge(false, 70'000));
+  ASSERT_EQ(2u, recorder.key_states.size());
+  EXPECT_FALSE(recorder.key_states[1].active);
+  EXPECT_EQ(70'000, recorder.key_states[1].timestamp_us);
+
+  // Timeline/decoder fan-out through the element callbacks
+  ASSERT_EQ(2u, recorder.elements.size());
+  EXPECT_EQ(keying::PaddleElement::kManual, recorder.elements[0].element);
+  EXPECT_TRUE(recorder.elements[0].started);
+  EXPECT_EQ(10'000, recorder.elements[0].timestamp_us);
+  EXPECT_FALSE(recorder.elements[1].started);
+  EXPECT_EQ(70'000, recorder.elements[1].timestamp_us);
+}
+
+TEST(StraightKeyPassthroughTest, BounceDoesNotReachOutput) {
+  keying::PaddleEngine engine;
+  keying::PaddleEngineConfig config{};
+  config.manual_debounce_us = 5'000;
+  KeyRecorder recorder;
+  ASSERT_TRUE(engine.Initialize(config, recorder.Callbacks()));
+
+  engine.OnPaddleEvent(KeyEdge(true, 1'000));
+  engine.OnPaddleEvent(KeyEdge(false, 1'300));
+  engine.OnPaddleEvent(KeyEdge(true, 1'600));
+  engine.Tick(10'000);
+  ASSERT_EQ(1u, recorder.key_states.size());
+
+  // Short tap: release during the lockout is keyed by Tick() once it expires
+  engine.OnPaddleEvent(KeyEdge(false, 50'000));
+  engine.OnPaddleEvent(KeyEdge(true, 100'000));
+  engine.OnPaddleEvent(KeyEdge(false, 102'000));
+  ASSERT_EQ(3u, recorder.key_states.size());
+  engine.Tick(104'000);
+  EXPECT_EQ(3u, recorder.key_states.size());
+  engine.Tick(105'000);
+  ASSERT_EQ(4u, recorder.key_states.size());
+  EXPECT_FALSE(recorder.key_states[3].active);
+  EXPECT_EQ(105'000, recorder.key_states[3].timestamp_us);
+}
+
+TEST(StraightKeyPassthroughTest, BugModeKeysDahManuallyAndDitsAutomatically) {
+  keying::PaddleEngine engine;
+  keying::PaddleEngineConfig config{};
+  config.speed_wpm = 20;
+  config.bug_mode = true;
+  KeyRecorder recorder;
+  ASSERT_TRUE(engine.Initialize(config, recorder.Callbacks()));
+
+  // Dah paddle: manual, held for an arbitrary (operator-timed) 500 ms
+  engine.OnPaddleEvent({.line = hal::PaddleLine::kDah, .active = true, .timestamp_us = 1'000});
+  for (int64_t t = 1'000; t < 501'000; t += 1'000) {
+    engine.Tick(t);
+  }
+  engine.OnPaddleEvent({.line = hal::PaddleLine::kDah, .active = false, .timestamp_us = 501'000});
+  ASSERT_EQ(2u, recorder.key_states.size());
+  EXPECT_EQ(500'000, recorder.key_states[1].timestamp_us - recorder.key_states[0].timestamp_us);
+  for (const auto& element : recorder.elements) {
+    EXPECT_EQ(keying::PaddleElement::kManual, element.element);
+  }
+
+  // Dit paddle: still automatic
+  recorder.elements.clear();
+  engine.OnPaddleEvent({.line = hal::PaddleLine::kDit, .active = true, .timestamp_us = 600'000});
+  engine.Tick(600'000);
+  ASSERT_FALSE(recorder.elements.empty());
+  EXPECT_EQ(keying::PaddleElement::kDit, recorder.elements[0].element);
+}
+
+TEST(StraightKeyPassthroughTest, OverlapWithIambicElementKeysOutputOnce) {
+  keying::PaddleEngine engine;
+  keying::PaddleEngineConfig config{};
+  config.speed_wpm = 20;
+  config.manual_debounce_us = 0;
+  KeyRecorder recorder;
+  ASSERT_TRUE(engine.Initialize(config, recorder.Callbacks()));
+
+  engine.OnPaddleEvent({.line = hal::PaddleLine::kDit, .active = true, .timestamp_us = 0});
+  engine.Tick(0);
+  ASSERT_EQ(1u, recorder.key_states.size());
+
+  // Straight key pressed during the dit: output already on, no duplicate edge
+  engine.OnPaddleEvent(KeyEdge(true, 10'000));
+  engine.OnPaddleEvent({.line = hal::PaddleLine::kDit, .active = false, .timestamp_us = 20'000});
+  for (int64_t t = 0; t <= 200'000; t += 1'000) {
+    engine.Tick(t);
+  }
+  EXPECT_EQ(1u, recorder.key_states.size());  // Key still held, output stays on
+
+  engine.OnPaddleEvent(KeyEdge(false, 300'000));
+  ASSERT_EQ(2u, recorder.key_states.size());
+  EXPECT_FALSE(recorder.key_states[1].active);
+}
+
+// Host simulator latency budget: edge handler to key callback, wall clock.
+// On-target the edge reaches the handler through the ISR task notification.
+TEST(StraightKeyPassthroughTest, PassthroughLatencyUnder100Us) {
+  keying::PaddleEngine engine;
+  keying::PaddleEngineConfig config{};
+  config.manual_debounce_us = 0;
+
+  struct Probe {
+    std::chrono::steady_clock::time_point fired;
+  } probe;
+  keying::PaddleEngineCallbacks callbacks{
+      .on_key_state_changed =
+          [](bool, int64_t, void* context) {
+            static_cast<Probe*>(context)->fired = std::chrono::steady_clock::now();
+          },
+      .context = &probe,
+  };
+  ASSERT_TRUE(engine.Initialize(config, callbacks));
+
+  std::vector<int64_t> latencies_ns;
+  constexpr int kEdges = 1000;
+  for (int i = 0; i < kEdges; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    engine.OnPaddleEvent(KeyEdge((i % 2) == 0, static_cast<int64_t>(i) * 10'000));
+    latencies_ns.push_back(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(probe.fired - start).count());
+  }
+  std::sort(latencies_ns.begin(), latencies_ns.end());
+  const int64_t median_ns = latencies_ns[latencies_ns.size() / 2];
+  EXPECT_GE(median_ns, 0);
+  EXPECT_LT(median_ns, 100'000);
+}
+
+}  // namespace
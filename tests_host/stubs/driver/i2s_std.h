@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 #include "esp_err.h"
@@ -80,6 +81,8 @@ esp_err_t i2s_new_channel(const i2s_chan_config_t* config,
 esp_err_t i2s_channel_init_std_mode(i2s_chan_handle_t handle, const i2s_std_config_t* std_cfg);
 esp_err_t i2s_channel_enable(i2s_chan_handle_t handle);
 esp_err_t i2s_channel_disable(i2s_chan_handle_t handle);
+esp_err_t i2s_channel_preload_data(i2s_chan_handle_t handle, const void* src, size_t size,
+                                   size_t* bytes_loaded);
 esp_err_t i2s_del_channel(i2s_chan_handle_t handle);
 
 #ifdef __cplusplus
@@ -9,8 +9,10 @@
 #include "freertos/task.h"
 #include "led_strip.h"
 #include "nvs.h"
+#include "tinyusb_cdc_acm.h"
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
@@ -31,6 +33,7 @@ struct i2s_channel {
   i2s_std_config_t std_cfg{};
   bool std_initialized = false;
   bool enabled = false;
+  std::vector<int16_t> preloaded;
 };
 
 struct esp_io_expander {
@@ -93,6 +96,13 @@ std::unordered_map<TaskHandle_t, std::unique_ptr<FakeTask>> g_fake_tasks;
 
 std::unordered_map<esp_io_expander_handle_t, std::unique_ptr<esp_io_expander>> g_io_expanders;
 
+struct FakeCdcPort {
+  std::vector<uint8_t> rx;  ///< Host to device, not read yet
+  std::vector<uint8_t> tx;  ///< Device to host, queued
+};
+
+std::array<FakeCdcPort, TINYUSB_CDC_ACM_MAX> g_cdc_ports;
+
 FakeLedStrip* GetStrip(led_strip_handle_t handle) {
   auto it = g_led_strips.find(handle);
   if (it == g_led_strips.end()) {
@@ -229,6 +239,14 @@ void vTaskDelete(TaskHandle_t task) {
 
 void vTaskDelay(uint32_t) {}
 
+BaseType_t xTaskNotifyGive(TaskHandle_t) {
+  return pdPASS;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t, uint32_t) {
+  return 0;
+}
+
 esp_err_t i2c_new_master_bus(const i2c_master_bus_config_t* config, i2c_master_bus_handle_t* handle) {
   if (config == nullptr || handle == nullptr) {
     return ESP_ERR_INVALID_ARG;
@@ -292,6 +310,9 @@ esp_err_t i2s_channel_enable(i2s_chan_handle_t handle) {
   if (it == g_i2s_channels.end()) {
     return ESP_ERR_INVALID_STATE;
   }
+  if (it->second->enabled) {
+    return ESP_ERR_INVALID_STATE;
+  }
   it->second->enabled = true;
   return ESP_OK;
 }
@@ -305,6 +326,22 @@ esp_err_t i2s_channel_disable(i2s_chan_handle_t handle) {
     return ESP_ERR_INVALID_STATE;
   }
   it->second->enabled = false;
+  it->second->preloaded.clear();
+  return ESP_OK;
+}
+
+esp_err_t i2s_channel_preload_data(i2s_chan_handle_t handle, const void* src, size_t size,
+                                   size_t* bytes_loaded) {
+  auto it = g_i2s_channels.find(handle);
+  if (it == g_i2s_channels.end() || src == nullptr || bytes_loaded == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  if (it->second->enabled) {
+    return ESP_ERR_INVALID_STATE;  // Only allowed before i2s_channel_enable()
+  }
+  const auto* samples = static_cast<const int16_t*>(src);
+  it->second->preloaded.assign(samples, samples + size / sizeof(int16_t));
+  *bytes_loaded = size;
   return ESP_OK;
 }
 
@@ -603,6 +640,31 @@ esp_err_t led_strip_refresh(led_strip_handle_t handle) {
   return ESP_OK;
 }
 
+esp_err_t tinyusb_cdcacm_read(tinyusb_cdcacm_itf_t itf, uint8_t* out_buf, size_t out_buf_sz,
+                              size_t* rx_data_size) {
+  if (itf >= TINYUSB_CDC_ACM_MAX || out_buf == nullptr || rx_data_size == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  std::vector<uint8_t>& rx = g_cdc_ports[itf].rx;
+  const size_t count = rx.size() < out_buf_sz ? rx.size() : out_buf_sz;
+  std::memcpy(out_buf, rx.data(), count);
+  rx.erase(rx.begin(), rx.begin() + static_cast<std::ptrdiff_t>(count));
+  *rx_data_size = count;
+  return ESP_OK;
+}
+
+size_t tinyusb_cdcacm_write_queue(tinyusb_cdcacm_itf_t itf, const uint8_t* in_buf, size_t in_size) {
+  if (itf >= TINYUSB_CDC_ACM_MAX || in_buf == nullptr) {
+    return 0;
+  }
+  g_cdc_ports[itf].tx.insert(g_cdc_ports[itf].tx.end(), in_buf, in_buf + in_size);
+  return in_size;
+}
+
+esp_err_t tinyusb_cdcacm_write_flush(tinyusb_cdcacm_itf_t itf, uint32_t) {
+  return itf < TINYUSB_CDC_ACM_MAX ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
 }  // extern "C"
 
 // Test control helpers -------------------------------------------------------
@@ -629,6 +691,17 @@ void fake_gpio_set_level(gpio_num_t gpio, int level) {
   g_gpio_states[gpio].level = level;
 }
 
+FakeI2sChannelSnapshot fake_i2s_snapshot(i2s_chan_handle_t handle) {
+  FakeI2sChannelSnapshot snapshot;
+  auto it = g_i2s_channels.find(handle);
+  if (it != g_i2s_channels.end()) {
+    snapshot.exists = true;
+    snapshot.enabled = it->second->enabled;
+    snapshot.preloaded = it->second->preloaded;
+  }
+  return snapshot;
+}
+
 FakeGpioStateSnapshot fake_gpio_snapshot(gpio_num_t gpio) {
   FakeGpioStateSnapshot snapshot{};
   auto it = g_gpio_states.find(gpio);
@@ -700,11 +773,29 @@ FakeLedStripSnapshot fake_led_strip_snapshot(led_strip_handle_t handle) {
   return snapshot;
 }
 
+void fake_cdc_reset() {
+  for (FakeCdcPort& port : g_cdc_ports) {
+    port.rx.clear();
+    port.tx.clear();
+  }
+}
+
+void fake_cdc_host_write(int port, const std::vector<uint8_t>& bytes) {
+  g_cdc_ports[port].rx.insert(g_cdc_ports[port].rx.end(), bytes.begin(), bytes.end());
+}
+
+std::vector<uint8_t> fake_cdc_host_read(int port) {
+  std::vector<uint8_t> bytes;
+  bytes.swap(g_cdc_ports[port].tx);
+  return bytes;
+}
+
 void fake_esp_idf_reset() {
   fake_esp_reset_time();
   fake_gpio_reset();
   fake_nvs_reset();
   fake_led_strip_reset();
+  fake_cdc_reset();
   g_i2c_buses.clear();
   g_i2s_channels.clear();
   g_fake_tasks.clear();
@@ -15,6 +15,8 @@ typedef void (*TaskFunction_t)(void*);
 #define pdFAIL 0
 
 #define pdMS_TO_TICKS(ms) (ms)
+#define pdTRUE 1
+#define portMAX_DELAY 0xFFFFFFFFU
 
 static const BaseType_t tskNO_AFFINITY = -1;
 
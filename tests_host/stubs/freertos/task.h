@@ -16,6 +16,8 @@ BaseType_t xTaskCreatePinnedToCore(TaskFunction_t task_func,
 
 void vTaskDelete(TaskHandle_t task);
 void vTaskDelay(uint32_t ticks);
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, uint32_t ticks_to_wait);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,160 @@
+/**
+ * @file alloc_interposer.cpp
+ * @brief Host implementation of system_monitor/heap_trace.hpp: malloc interposer
+ *
+ * Replaces malloc/calloc/realloc/free of the test binary and forwards to the
+ * glibc implementation; while the trace runs, each call is charged to the
+ * AllocScope of the calling thread (kOther outside a scope). operator new
+ * and std::string/std::vector allocate through malloc, so firmware code run
+ * on host is covered as on target.
+ */
+
+#include "system_monitor/heap_trace.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <mutex>
+
+#if defined(__GLIBC__)
+
+extern "C" void* __libc_malloc(size_t size);
+extern "C" void* __libc_calloc(size_t count, size_t size);
+extern "C" void* __libc_realloc(void* ptr, size_t size);
+extern "C" void __libc_free(void* ptr);
+
+namespace system_monitor {
+
+namespace {
+
+AllocProfiler g_profiler;
+std::atomic<bool> g_running{false};
+std::mutex g_mutex;                 // Never allocates on Linux
+thread_local bool t_in_hook = false;  // The hook's own calls must not recurse
+
+int64_t NowMicros() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void RecordAlloc(void* ptr, size_t size) {
+  if (!g_running.load(std::memory_order_acquire) || t_in_hook || ptr == nullptr) {
+    return;
+  }
+  t_in_hook = true;
+  AllocTag tag = AllocTag::kOther;
+  CurrentAllocScope(&tag);
+  const int64_t now_us = NowMicros();
+  {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    g_profiler.OnAlloc(ptr, size, tag, now_us);
+  }
+  t_in_hook = false;
+}
+
+void RecordFree(void* ptr) {
+  if (!g_running.load(std::memory_order_acquire) || t_in_hook || ptr == nullptr) {
+    return;
+  }
+  t_in_hook = true;
+  {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    g_profiler.OnFree(ptr);
+  }
+  t_in_hook = false;
+}
+
+}  // namespace
+
+bool HeapTraceAvailable() {
+  return true;
+}
+
+bool HeapTraceStart() {
+  g_running.store(true, std::memory_order_release);
+  return true;
+}
+
+void HeapTraceStop() {
+  g_running.store(false, std::memory_order_release);
+}
+
+bool HeapTraceRunning() {
+  return g_running.load(std::memory_order_acquire);
+}
+
+void HeapTraceReset() {
+  std::lock_guard<std::mutex> lock(g_mutex);
+  g_profiler.Reset();
+}
+
+void HeapTraceGetReport(HeapTraceReport* report) {
+  *report = HeapTraceReport{};
+  report->running = HeapTraceRunning();
+  std::lock_guard<std::mutex> lock(g_mutex);
+  for (size_t i = 0; i < kAllocTagCount; ++i) {
+    report->tags[i] = g_profiler.Get(static_cast<AllocTag>(i));
+  }
+  report->flagged_logged = g_profiler.Flagged(report->flagged, kFlaggedAllocLogSize);
+  report->flagged_count = g_profiler.flagged_count();
+  report->untracked_allocs = g_profiler.untracked_allocs();
+  report->unknown_frees = g_profiler.unknown_frees();
+  report->live_blocks = g_profiler.live_blocks();
+}
+
+}  // namespace system_monitor
+
+extern "C" void* malloc(size_t size) noexcept {
+  void* ptr = __libc_malloc(size);
+  system_monitor::RecordAlloc(ptr, size);
+  return ptr;
+}
+
+extern "C" void* calloc(size_t count, size_t size) noexcept {
+  void* ptr = __libc_calloc(count, size);
+  system_monitor::RecordAlloc(ptr, count * size);
+  return ptr;
+}
+
+extern "C" void* realloc(void* ptr, size_t size) noexcept {
+  void* moved = __libc_realloc(ptr, size);
+  if (moved != nullptr || size == 0) {
+    system_monitor::RecordFree(ptr);
+    system_monitor::RecordAlloc(moved, size);
+  }
+  return moved;
+}
+
+extern "C" void free(void* ptr) noexcept {
+  system_monitor::RecordFree(ptr);
+  __libc_free(ptr);
+}
+
+#else  // !__GLIBC__
+
+namespace system_monitor {
+
+bool HeapTraceAvailable() {
+  return false;
+}
+
+bool HeapTraceStart() {
+  return false;
+}
+
+void HeapTraceStop() {}
+
+bool HeapTraceRunning() {
+  return false;
+}
+
+void HeapTraceReset() {}
+
+void HeapTraceGetReport(HeapTraceReport* report) {
+  *report = HeapTraceReport{};
+}
+
+}  // namespace system_monitor
+
+#endif  // __GLIBC__
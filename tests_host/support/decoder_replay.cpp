@@ -0,0 +1,266 @@
+/**
+ * @file decoder_replay.cpp
+ * @brief Host replay harness for the morse decoder pipeline
+ */
+
+#include "decoder_replay.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "fake_esp_idf.hpp"
+#include "morse_decoder/adaptive_timing_classifier.hpp"
+#include "morse_decoder/morse_encoder.hpp"
+
+namespace decoder_replay {
+
+namespace {
+
+std::string TrimRight(const std::string& text) {
+  const size_t end = text.find_last_not_of(" \r\n\t");
+  return end == std::string::npos ? std::string() : text.substr(0, end + 1);
+}
+
+bool Fail(std::string* error, const std::string& message) {
+  if (error != nullptr) {
+    *error = message;
+  }
+  return false;
+}
+
+// Key-up timestamp that ends the last mark of every reference character (-1 for spaces)
+std::vector<int64_t> CharacterEndTimes(const Fixture& fixture) {
+  morse_decoder::MorseEncoder encoder;
+  std::vector<int64_t> end_times(fixture.text.size(), -1);
+  size_t edge = 0;
+  for (size_t c = 0; c < fixture.text.size(); ++c) {
+    if (fixture.text[c] == ' ') {
+      continue;
+    }
+    size_t marks = encoder.Encode(fixture.text[c]).size();
+    for (; edge + 1 < fixture.edges.size() && marks > 0; ++edge) {
+      if (fixture.edges[edge].key_down && --marks == 0) {
+        end_times[c] = fixture.edges[edge + 1].timestamp_us;
+      }
+    }
+  }
+  return end_times;
+}
+
+// Pairs (reference index, decoded index) of equal characters on an optimal alignment
+std::vector<std::pair<size_t, size_t>> AlignMatches(const std::string& reference,
+                                                    const std::string& decoded) {
+  const size_t rows = reference.size() + 1;
+  const size_t cols = decoded.size() + 1;
+  std::vector<size_t> cost(rows * cols);
+  for (size_t i = 0; i < rows; ++i) {
+    for (size_t j = 0; j < cols; ++j) {
+      if (i == 0 || j == 0) {
+        cost[i * cols + j] = i + j;
+        continue;
+      }
+      const size_t substitute = reference[i - 1] == decoded[j - 1] ? 0 : 1;
+      cost[i * cols + j] = std::min({cost[(i - 1) * cols + j] + 1, cost[i * cols + j - 1] + 1,
+                                     cost[(i - 1) * cols + j - 1] + substitute});
+    }
+  }
+
+  std::vector<std::pair<size_t, size_t>> matches;
+  size_t i = reference.size();
+  size_t j = decoded.size();
+  while (i > 0 && j > 0) {
+    const size_t here = cost[i * cols + j];
+    if (reference[i - 1] == decoded[j - 1] && here == cost[(i - 1) * cols + j - 1]) {
+      matches.emplace_back(i - 1, j - 1);
+      --i;
+      --j;
+    } else if (here == cost[(i - 1) * cols + j - 1] + 1) {
+      --i;
+      --j;
+    } else if (here == cost[(i - 1) * cols + j] + 1) {
+      --i;
+    } else {
+      --j;
+    }
+  }
+  return matches;
+}
+
+}  // namespace
+
+bool LoadFixture(const std::string& path, Fixture* fixture, std::string* error) {
+  std::ifstream file(path);
+  if (!file) {
+    return Fail(error, "cannot open " + path);
+  }
+
+  Fixture parsed;
+  std::string line;
+  size_t line_number = 0;
+  while (std::getline(file, line)) {
+    ++line_number;
+    line = TrimRight(line);
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+
+    const size_t colon = line.find(':');
+    if (colon != std::string::npos) {
+      const std::string key = line.substr(0, colon);
+      std::string value = line.substr(colon + 1);
+      value.erase(0, value.find_first_not_of(' '));
+      if (key == "name") {
+        parsed.name = value;
+      } else if (key == "text") {
+        parsed.text = value;
+      } else if (key == "wpm") {
+        parsed.wpm = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+      } else if (key == "max_cer") {
+        parsed.max_cer = std::strtod(value.c_str(), nullptr);
+      } else {
+        return Fail(error, path + ":" + std::to_string(line_number) + ": unknown key '" +
+                               key + "'");
+      }
+      continue;
+    }
+
+    std::istringstream fields(line);
+    KeyEdge edge;
+    int key_down = 0;
+    if (!(fields >> edge.timestamp_us >> key_down) || (key_down != 0 && key_down != 1)) {
+      return Fail(error, path + ":" + std::to_string(line_number) + ": malformed edge");
+    }
+    edge.key_down = key_down != 0;
+    if (!parsed.edges.empty() && edge.timestamp_us <= parsed.edges.back().timestamp_us) {
+      return Fail(error, path + ":" + std::to_string(line_number) +
+                             ": timestamps must increase");
+    }
+    parsed.edges.push_back(edge);
+  }
+
+  if (parsed.text.empty() || parsed.edges.size() < 2) {
+    return Fail(error, path + ": missing text or edges");
+  }
+  if (parsed.name.empty()) {
+    parsed.name = std::filesystem::path(path).stem().string();
+  }
+  *fixture = std::move(parsed);
+  return true;
+}
+
+std::vector<std::string> ListFixtures(const std::string& directory) {
+  std::vector<std::string> paths;
+  std::error_code ec;
+  for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+    if (entry.is_regular_file() && entry.path().extension() == ".txt") {
+      paths.push_back(entry.path().string());
+    }
+  }
+  std::sort(paths.begin(), paths.end());
+  return paths;
+}
+
+ReplayResult Replay(const Fixture& fixture, const ReplayOptions& options) {
+  morse_decoder::AdaptiveTimingClassifier classifier;
+  morse_decoder::MorseDecoderConfig config;
+  config.buffer_size = fixture.text.size() * 2 + 16;
+  config.timing_classifier = &classifier;
+  config.mode = options.mode;
+  morse_decoder::MorseDecoder decoder(config);
+
+  // Simulated time at which each decoded buffer position appeared
+  std::vector<int64_t> emit_times;
+  auto collect = [&](int64_t now_us) {
+    const size_t length = decoder.GetDecodedText().size();
+    while (emit_times.size() < length) {
+      emit_times.push_back(now_us);
+    }
+  };
+
+  ReplayResult result;
+  std::chrono::steady_clock::duration busy{};
+  int64_t next_tick_us = fixture.edges.front().timestamp_us + options.tick_interval_us;
+
+  // Same duration bookkeeping as KeyingSubsystem::HandleKeyingStateChanged()
+  for (size_t i = 1; i < fixture.edges.size(); ++i) {
+    const KeyEdge& previous = fixture.edges[i - 1];
+    const KeyEdge& edge = fixture.edges[i];
+
+    // Periodic ticks while the previous state lasts (inactivity timeout)
+    for (; next_tick_us < edge.timestamp_us; next_tick_us += options.tick_interval_us) {
+      fake_esp_timer_set_time(next_tick_us);
+      decoder.Tick(next_tick_us);
+      collect(next_tick_us);
+    }
+
+    fake_esp_timer_set_time(edge.timestamp_us);
+    const auto start = std::chrono::steady_clock::now();
+    morse_decoder::ElementScores scores;
+    classifier.ClassifyDuration(edge.timestamp_us - previous.timestamp_us, previous.key_down,
+                                &scores);
+    decoder.ProcessElement(scores);
+    busy += std::chrono::steady_clock::now() - start;
+    ++result.events;
+    collect(edge.timestamp_us);
+  }
+
+  // Let the inactivity timeout flush the tail (bounded to a few seconds)
+  const int64_t end_us = fixture.edges.back().timestamp_us + 5'000'000;
+  for (; next_tick_us <= end_us; next_tick_us += options.tick_interval_us) {
+    fake_esp_timer_set_time(next_tick_us);
+    decoder.Tick(next_tick_us);
+    collect(next_tick_us);
+  }
+
+  result.decoded = TrimRight(decoder.GetDecodedText());
+  result.errors = EditDistance(fixture.text, result.decoded);
+  result.cer = static_cast<double>(result.errors) / static_cast<double>(fixture.text.size());
+
+  // Latency over characters that were decoded correctly (aligned to the reference)
+  const std::vector<int64_t> char_end_times = CharacterEndTimes(fixture);
+  int64_t latency_sum = 0;
+  size_t matched = 0;
+  for (const auto& [ref_index, decoded_index] : AlignMatches(fixture.text, result.decoded)) {
+    if (char_end_times[ref_index] < 0) {
+      continue;
+    }
+    const int64_t latency =
+        std::max<int64_t>(0, emit_times[decoded_index] - char_end_times[ref_index]);
+    latency_sum += latency;
+    result.max_latency_us = std::max(result.max_latency_us, latency);
+    ++matched;
+  }
+  if (matched > 0) {
+    result.mean_latency_us = static_cast<double>(latency_sum) / static_cast<double>(matched);
+  }
+
+  const double busy_s = std::chrono::duration<double>(busy).count();
+  if (busy_s > 0.0) {
+    result.events_per_second = static_cast<double>(result.events) / busy_s;
+  }
+  return result;
+}
+
+size_t EditDistance(const std::string& a, const std::string& b) {
+  std::vector<size_t> row(b.size() + 1);
+  for (size_t j = 0; j <= b.size(); ++j) {
+    row[j] = j;
+  }
+  for (size_t i = 1; i <= a.size(); ++i) {
+    size_t diagonal = row[0];
+    row[0] = i;
+    for (size_t j = 1; j <= b.size(); ++j) {
+      const size_t above = row[j];
+      row[j] = std::min({row[j] + 1, row[j - 1] + 1,
+                         diagonal + (a[i - 1] != b[j - 1] ? size_t{1} : size_t{0})});
+      diagonal = above;
+    }
+  }
+  return row[b.size()];
+}
+
+}  // namespace decoder_replay
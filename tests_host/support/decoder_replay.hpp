@@ -0,0 +1,100 @@
+/**
+ * @file decoder_replay.hpp
+ * @brief Host replay harness for the morse decoder pipeline
+ *
+ * Replays recorded or synthetic key edge streams (fixtures) through
+ * AdaptiveTimingClassifier + MorseDecoder exactly like KeyingSubsystem does on the
+ * device, on a simulated clock, and measures:
+ * - Character error rate against the fixture's reference text (Levenshtein)
+ * - Decode latency: simulated time from the key-up ending a character's last mark
+ *   to the moment the character appears in the decoded buffer
+ * - Throughput: classified key events per second of host wall-clock time
+ *
+ * Fixture format (see scripts/decoder/generate_corpus.py):
+ * @code
+ * # comment
+ * name: wpm20_paris
+ * text: PARIS PARIS
+ * wpm: 20
+ * max_cer: 0.030
+ * 1000000 1        <- timestamp_us key_down
+ * 1060000 0
+ * @endcode
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "morse_decoder/morse_decoder.hpp"
+
+namespace decoder_replay {
+
+/**
+ * @brief Key state change at a point in time
+ */
+struct KeyEdge {
+  int64_t timestamp_us = 0;
+  bool key_down = false;
+};
+
+/**
+ * @brief Replay fixture: reference text, regression budget and key edges
+ */
+struct Fixture {
+  std::string name;
+  std::string text;       ///< Reference text that was sent (upper case)
+  uint32_t wpm = 0;       ///< Nominal sending speed (informational)
+  double max_cer = 0.0;   ///< Highest acceptable character error rate
+  std::vector<KeyEdge> edges;
+};
+
+/**
+ * @brief Replay parameters
+ */
+struct ReplayOptions {
+  morse_decoder::DecodingMode mode = morse_decoder::DecodingMode::kGreedy;
+  int64_t tick_interval_us = 10'000;  ///< MorseDecoder::Tick() period on the simulated clock
+};
+
+/**
+ * @brief Metrics of one replay
+ */
+struct ReplayResult {
+  std::string decoded;              ///< Decoded text (trailing spaces removed)
+  size_t errors = 0;                ///< Edit distance to the reference text
+  double cer = 0.0;                 ///< errors / reference length
+  double mean_latency_us = 0.0;     ///< Mean decode latency over matched characters
+  int64_t max_latency_us = 0;       ///< Worst decode latency
+  size_t events = 0;                ///< Classified key events
+  double events_per_second = 0.0;   ///< Host throughput (classifier + decoder)
+};
+
+/**
+ * @brief Parse a fixture file
+ * @param path File path
+ * @param fixture Out: parsed fixture
+ * @param error Out: reason on failure (may be nullptr)
+ * @return True on success
+ */
+bool LoadFixture(const std::string& path, Fixture* fixture, std::string* error);
+
+/**
+ * @brief List fixture files (*.txt) in a directory, sorted by name
+ */
+std::vector<std::string> ListFixtures(const std::string& directory);
+
+/**
+ * @brief Replay a fixture through a fresh classifier and decoder
+ */
+ReplayResult Replay(const Fixture& fixture, const ReplayOptions& options);
+
+/**
+ * @brief Levenshtein distance between two strings
+ */
+size_t EditDistance(const std::string& a, const std::string& b);
+
+}  // namespace decoder_replay
@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "driver/gpio.h"
+#include "driver/i2s_std.h"
 #include "esp_err.h"
 #include "led_strip.h"
 
@@ -25,6 +26,12 @@ struct FakeNvsSnapshotEntry {
   std::string string_value;
 };
 
+struct FakeI2sChannelSnapshot {
+  bool exists = false;
+  bool enabled = false;
+  std::vector<int16_t> preloaded;  ///< Last i2s_channel_preload_data() (cleared on disable)
+};
+
 struct FakeLedStripSnapshot {
   size_t led_count = 0;
   std::vector<std::array<uint8_t, 3>> pixels;
@@ -46,6 +53,14 @@ void fake_gpio_set_install_result(esp_err_t result);
 void fake_nvs_reset();
 std::vector<FakeNvsSnapshotEntry> fake_nvs_snapshot(const std::string& ns_name);
 
+FakeI2sChannelSnapshot fake_i2s_snapshot(i2s_chan_handle_t handle);
+
+void fake_cdc_reset();
+/// Bytes sent by the host on a CDC port (tinyusb_cdcacm_read() returns them)
+void fake_cdc_host_write(int port, const std::vector<uint8_t>& bytes);
+/// Bytes queued to the host on a CDC port since the last call
+std::vector<uint8_t> fake_cdc_host_read(int port);
+
 void fake_led_strip_reset();
 FakeLedStripSnapshot fake_led_strip_snapshot(led_strip_handle_t handle);
 std::vector<led_strip_handle_t> fake_led_strip_handles();
@@ -4,8 +4,14 @@
  */
 
 #include "morse_decoder/adaptive_timing_classifier.hpp"
+#include "morse_decoder/morse_encoder.hpp"
 #include "gtest/gtest.h"
 
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
 using namespace morse_decoder;
 
 namespace {
@@ -16,6 +22,88 @@ constexpr int64_t DitDurationUs(uint32_t wpm) {
   return 1'200'000 / wpm;
 }
 
+// One key-on or key-off duration of a synthetic stream with its ground-truth label
+struct TimedElement {
+  int64_t duration_us;
+  bool key_on;
+  KeyEvent expected;
+};
+
+// Shape of a synthetic operator ("fist")
+struct FistProfile {
+  uint32_t start_wpm = 20;        // Character speed at stream start
+  uint32_t end_wpm = 20;          // Character speed at stream end (linear drift)
+  float weighting = 0.0f;         // Fraction of a dit unit moved from spaces to marks
+  float farnsworth = 1.0f;        // Stretch factor for char/word gaps
+  float jitter = 0.0f;            // Uniform relative jitter (±) per duration
+  uint32_t seed = 1;
+};
+
+constexpr char kCorpusText[] =
+    "CQ CQ DE IU3QEZ IU3QEZ K THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG 5NN TU 73 "
+    "PARIS PARIS RST 599 QTH PADOVA NAME SIMONE HW CPY";
+
+// Render text into labelled mark/space durations following a fist profile
+std::vector<TimedElement> BuildStream(const std::string& text, const FistProfile& fist) {
+  MorseEncoder encoder;
+  std::vector<TimedElement> stream;
+  std::mt19937 rng(fist.seed);
+  std::uniform_real_distribution<float> jitter(-fist.jitter, fist.jitter);
+
+  const size_t length = text.size();
+  auto unit_at = [&](size_t index) {
+    const float progress = length > 1 ? static_cast<float>(index) / (length - 1) : 0.0f;
+    const float wpm = fist.start_wpm + (static_cast<float>(fist.end_wpm) - fist.start_wpm) *
+                                           progress;
+    return 1'200'000.0f / wpm;
+  };
+  auto emit = [&](float units_us, bool key_on, KeyEvent expected) {
+    const float value = units_us * (1.0f + jitter(rng));
+    stream.push_back({static_cast<int64_t>(value), key_on, expected});
+  };
+
+  for (size_t i = 0; i < length; ++i) {
+    const float unit = unit_at(i);
+    const float shift = unit * fist.weighting;
+    if (text[i] == ' ') {
+      // Turn the previous char gap into a word gap
+      if (!stream.empty() && !stream.back().key_on) {
+        stream.pop_back();
+      }
+      emit((7.0f * unit - shift) * fist.farnsworth, false, KeyEvent::kWordGap);
+      continue;
+    }
+    const std::string pattern = encoder.Encode(text[i]);
+    for (size_t e = 0; e < pattern.size(); ++e) {
+      const bool dah = pattern[e] == '-';
+      emit((dah ? 3.0f : 1.0f) * unit + shift, true, dah ? KeyEvent::kDah : KeyEvent::kDit);
+      if (e + 1 < pattern.size()) {
+        emit(unit - shift, false, KeyEvent::kIntraGap);
+      }
+    }
+    emit((3.0f * unit - shift) * fist.farnsworth, false, KeyEvent::kCharGap);
+  }
+  return stream;
+}
+
+// Feed a stream and return the fraction of correctly classified elements after warm-up
+float ClassificationAccuracy(AdaptiveTimingClassifier& classifier,
+                             const std::vector<TimedElement>& stream, size_t warm_up = 12) {
+  size_t scored = 0;
+  size_t correct = 0;
+  for (size_t i = 0; i < stream.size(); ++i) {
+    const KeyEvent event = classifier.ClassifyDuration(stream[i].duration_us, stream[i].key_on);
+    if (i < warm_up) {
+      continue;
+    }
+    ++scored;
+    if (event == stream[i].expected) {
+      ++correct;
+    }
+  }
+  return scored > 0 ? static_cast<float>(correct) / scored : 0.0f;
+}
+
 // Test fixture for classifier tests
 class AdaptiveTimingClassifierTest : public ::testing::Test {
  protected:
@@ -180,4 +268,101 @@ TEST_F(AdaptiveTimingClassifierTest, GapWarmUpPeriod) {
   EXPECT_NE(KeyEvent::kUnknown, gap2);  // Should classify as some gap type
 }
 
+// Test 9: Speed range covers 5-100 WPM
+TEST_F(AdaptiveTimingClassifierTest, WpmRange5To100) {
+  for (int i = 0; i < 20; i++) {
+    classifier_.ClassifyDuration(DitDurationUs(100), true);
+  }
+  EXPECT_GE(classifier_.GetWPM(), 95u);
+  EXPECT_LE(classifier_.GetWPM(), 100u);
+
+  classifier_.Reset();
+  for (int i = 0; i < 20; i++) {
+    classifier_.ClassifyDuration(DitDurationUs(5), true);
+    classifier_.ClassifyDuration(DitDurationUs(5) * 3, true);
+  }
+  EXPECT_GE(classifier_.GetWPM(), 5u);
+  EXPECT_LE(classifier_.GetWPM(), 6u);
+}
+
+// Test 10: Thresholds reported in stats are ordered and bracket the centroids
+TEST_F(AdaptiveTimingClassifierTest, StatsThresholdsOrdered) {
+  FistProfile fist;
+  fist.jitter = 0.1f;
+  ClassificationAccuracy(classifier_, BuildStream(kCorpusText, fist));
+
+  const auto stats = classifier_.GetTimingStats();
+  EXPECT_LT(stats.avg_dit_us, stats.dit_dah_threshold_us);
+  EXPECT_LT(stats.dit_dah_threshold_us, stats.avg_dah_us);
+  EXPECT_LT(stats.avg_intra_gap_us, stats.char_gap_threshold_us);
+  EXPECT_LT(stats.char_gap_threshold_us, stats.avg_char_gap_us);
+  EXPECT_LT(stats.avg_char_gap_us, stats.word_gap_threshold_us);
+  EXPECT_LT(stats.word_gap_threshold_us, stats.avg_word_gap_us);
+}
+
+// Test 11: Jittered streams at the speed extremes
+TEST_F(AdaptiveTimingClassifierTest, JitteredStreamsAcrossSpeeds) {
+  for (uint32_t wpm : {5u, 12u, 25u, 40u, 60u, 100u}) {
+    AdaptiveTimingClassifier classifier(25.0f);
+    FistProfile fist;
+    fist.start_wpm = wpm;
+    fist.end_wpm = wpm;
+    fist.jitter = 0.15f;
+    fist.seed = wpm;
+    EXPECT_GE(ClassificationAccuracy(classifier, BuildStream(kCorpusText, fist)), 0.97f)
+        << "wpm=" << wpm;
+  }
+}
+
+// Test 12: Heavy weighting (long marks, short spaces)
+TEST_F(AdaptiveTimingClassifierTest, HeavyWeighting) {
+  FistProfile fist;
+  fist.start_wpm = 22;
+  fist.end_wpm = 22;
+  fist.weighting = 0.4f;  // Dit mark 1.4 units, intra gap 0.6 units
+  fist.jitter = 0.1f;
+  EXPECT_GE(ClassificationAccuracy(classifier_, BuildStream(kCorpusText, fist)), 0.97f);
+}
+
+// Test 13: Farnsworth spacing (18 WPM characters, stretched gaps)
+TEST_F(AdaptiveTimingClassifierTest, FarnsworthSpacing) {
+  FistProfile fist;
+  fist.start_wpm = 18;
+  fist.end_wpm = 18;
+  fist.farnsworth = 2.5f;
+  fist.jitter = 0.1f;
+  EXPECT_GE(ClassificationAccuracy(classifier_, BuildStream(kCorpusText, fist)), 0.97f);
+}
+
+// Test 14: Speed drift within one stream
+TEST_F(AdaptiveTimingClassifierTest, SpeedDrift) {
+  FistProfile fist;
+  fist.start_wpm = 15;
+  fist.end_wpm = 35;
+  fist.jitter = 0.1f;
+  EXPECT_GE(ClassificationAccuracy(classifier_, BuildStream(kCorpusText, fist)), 0.97f);
+}
+
+// Test 15: Per-event cost on the jittered corpus (test properties, loosely bounded)
+TEST_F(AdaptiveTimingClassifierTest, PerEventCost) {
+  FistProfile fist;
+  fist.jitter = 0.15f;
+  const auto stream = BuildStream(kCorpusText, fist);
+
+  constexpr int kRounds = 50;
+  const auto start = std::chrono::steady_clock::now();
+  for (int round = 0; round < kRounds; ++round) {
+    for (const auto& element : stream) {
+      classifier_.ClassifyDuration(element.duration_us, element.key_on);
+    }
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  const double ns_per_event =
+      static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) /
+      (static_cast<double>(stream.size()) * kRounds);
+  RecordProperty("ns_per_event", static_cast<int>(ns_per_event));
+  RecordProperty("events", static_cast<int>(stream.size() * kRounds));
+  EXPECT_LT(ns_per_event, 100'000.0);  // Firmware budget is 100 us per event
+}
+
 }  // namespace
@@ -0,0 +1,142 @@
+/**
+ * @file test_alloc_profiler.cpp
+ * @brief Unit tests for heap allocation accounting and the host malloc interposer
+ */
+
+#include "system_monitor/alloc_profiler.hpp"
+#include "system_monitor/heap_trace.hpp"
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace system_monitor;
+
+namespace {
+
+const void* Address(uintptr_t value) {
+  return reinterpret_cast<const void*>(value);
+}
+
+TEST(AllocProfilerTest, ChargesFreesToTheAllocatingTag) {
+  auto profiler = std::make_unique<AllocProfiler>();
+
+  profiler->OnAlloc(Address(0x1000), 64, AllocTag::kHttp, 10);
+  profiler->OnAlloc(Address(0x2000), 200, AllocTag::kHttp, 20);
+  profiler->OnAlloc(Address(0x3000), 32, AllocTag::kConsole, 30);
+  profiler->OnFree(Address(0x1000));
+  profiler->OnFree(Address(0x9000));  // Allocated before the trace
+  profiler->OnFree(nullptr);
+
+  const AllocTagStats http = profiler->Get(AllocTag::kHttp);
+  EXPECT_EQ(2U, http.allocs);
+  EXPECT_EQ(1U, http.frees);
+  EXPECT_EQ(264U, http.alloc_bytes);
+  EXPECT_EQ(200U, http.live_bytes);
+  EXPECT_EQ(264U, http.peak_live_bytes);
+  EXPECT_EQ(32U, profiler->Get(AllocTag::kConsole).live_bytes);
+  EXPECT_EQ(1U, profiler->unknown_frees());
+  EXPECT_EQ(2U, profiler->live_blocks());
+  EXPECT_EQ(0U, profiler->flagged_count());
+
+  profiler->Reset();
+  EXPECT_EQ(0U, profiler->live_blocks());
+  EXPECT_EQ(0U, profiler->Get(AllocTag::kHttp).allocs);
+}
+
+TEST(AllocProfilerTest, LiveTableSurvivesCollisionsAndOverflow) {
+  auto profiler = std::make_unique<AllocProfiler>();
+  const size_t capacity = AllocProfiler::kLiveCapacity;
+
+  // Fill the table, then free every other block: the rest must still be found
+  for (uintptr_t i = 1; i < capacity; ++i) {
+    profiler->OnAlloc(Address(i * 16), 8, AllocTag::kWifi, 0);
+  }
+  EXPECT_EQ(capacity - 1, profiler->live_blocks());
+  profiler->OnAlloc(Address(0x100000), 8, AllocTag::kWifi, 0);  // Table full
+  EXPECT_EQ(1U, profiler->untracked_allocs());
+
+  for (uintptr_t i = 1; i < capacity; i += 2) {
+    profiler->OnFree(Address(i * 16));
+  }
+  for (uintptr_t i = 2; i < capacity; i += 2) {
+    profiler->OnFree(Address(i * 16));
+  }
+  EXPECT_EQ(0U, profiler->live_blocks());
+  EXPECT_EQ(0U, profiler->unknown_frees());
+  EXPECT_EQ(0U, profiler->Get(AllocTag::kWifi).live_bytes);
+  EXPECT_EQ(capacity - 1, profiler->Get(AllocTag::kWifi).frees);
+}
+
+TEST(AllocProfilerTest, FlagsKeyingAndAudioAllocations) {
+  auto profiler = std::make_unique<AllocProfiler>();
+  for (uintptr_t i = 1; i <= kFlaggedAllocLogSize + 1; ++i) {
+    profiler->OnAlloc(Address(i * 32), i, i % 2 ? AllocTag::kKeying : AllocTag::kAudio,
+                      static_cast<int64_t>(i) * 1000);
+  }
+  profiler->OnAlloc(Address(0x8000), 100, AllocTag::kHttp, 99'000);
+
+  EXPECT_EQ(kFlaggedAllocLogSize + 1, profiler->flagged_count());
+  FlaggedAlloc flagged[kFlaggedAllocLogSize];
+  ASSERT_EQ(kFlaggedAllocLogSize, profiler->Flagged(flagged, kFlaggedAllocLogSize));
+  EXPECT_EQ(kFlaggedAllocLogSize + 1, flagged[0].size);  // Newest first
+  EXPECT_EQ(AllocTag::kKeying, flagged[0].tag);
+  EXPECT_EQ(2U, flagged[kFlaggedAllocLogSize - 1].size);
+}
+
+TEST(AllocProfilerTest, TagsFromTaskNameAndScope) {
+  EXPECT_EQ(AllocTag::kAudio, AllocTagForTask("sidetone_loop"));
+  EXPECT_EQ(AllocTag::kHttp, AllocTagForTask("httpd"));
+  EXPECT_EQ(AllocTag::kOther, AllocTagForTask("ipc0"));
+  EXPECT_EQ(AllocTag::kOther, AllocTagForTask(nullptr));
+
+  AllocTag tag = AllocTag::kOther;
+  EXPECT_FALSE(CurrentAllocScope(&tag));
+  {
+    const AllocScope outer(AllocTag::kWifi);
+    {
+      const AllocScope inner(AllocTag::kKeying);
+      ASSERT_TRUE(CurrentAllocScope(&tag));
+      EXPECT_EQ(AllocTag::kKeying, tag);
+    }
+    ASSERT_TRUE(CurrentAllocScope(&tag));
+    EXPECT_EQ(AllocTag::kWifi, tag);
+  }
+  EXPECT_FALSE(CurrentAllocScope(&tag));
+}
+
+TEST(HeapTraceTest, InterposerChargesScopedAllocations) {
+  if (!HeapTraceAvailable()) {
+    GTEST_SKIP() << "malloc interposer needs glibc";
+  }
+  HeapTraceReset();
+  ASSERT_TRUE(HeapTraceStart());
+  {
+    const AllocScope scope(AllocTag::kTextKeyer);
+    std::string text(200, 'x');
+    std::vector<int> values(50);
+    values.push_back(1);  // Grows: new block, old one freed
+  }
+  {
+    const AllocScope scope(AllocTag::kKeying);
+    auto leaked = std::make_unique<std::string>(100, 'y');
+    HeapTraceStop();
+    HeapTraceReport report;
+    HeapTraceGetReport(&report);
+    EXPECT_FALSE(report.running);
+
+    const AllocTagStats& text_keyer = report.tags[static_cast<size_t>(AllocTag::kTextKeyer)];
+    EXPECT_GE(text_keyer.allocs, 3U);
+    EXPECT_EQ(text_keyer.allocs, text_keyer.frees);
+    EXPECT_EQ(0U, text_keyer.live_bytes);
+    EXPECT_GE(text_keyer.alloc_bytes, 200U + 50U * sizeof(int));
+
+    const AllocTagStats& keying = report.tags[static_cast<size_t>(AllocTag::kKeying)];
+    EXPECT_GE(keying.live_bytes, 100U);
+    EXPECT_GE(report.flagged_count, 2U);  // The unique_ptr and the string buffer
+  }
+  HeapTraceReset();
+}
+
+}  // namespace
@@ -0,0 +1,294 @@
+/**
+ * @file test_beam_decoder.cpp
+ * @brief Unit tests for BeamDecoder and MorseDecoder beam mode
+ *
+ * Tests language model costs, bounded-delay commits, ambiguity resolution and
+ * end-to-end decoding of jittered keying against the greedy decoder.
+ */
+
+#include "morse_decoder/beam_decoder.hpp"
+#include "morse_decoder/morse_decoder.hpp"
+#include "morse_decoder/morse_encoder.hpp"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace morse_decoder;
+
+namespace {
+
+// Confident costs: the right class is free, the others are far away
+constexpr uint16_t kFar = 1300;
+
+ElementScores Mark(bool dah) {
+  ElementScores scores;
+  scores.key_on = true;
+  scores.best = dah ? KeyEvent::kDah : KeyEvent::kDit;
+  scores.cost[0] = dah ? kFar : 0;
+  scores.cost[1] = dah ? 0 : kFar;
+  return scores;
+}
+
+ElementScores Gap(KeyEvent type) {
+  ElementScores scores;
+  scores.key_on = false;
+  scores.best = type;
+  scores.cost[0] = (type == KeyEvent::kIntraGap) ? 0 : kFar;
+  scores.cost[1] = (type == KeyEvent::kCharGap) ? 0 : kFar;
+  scores.cost[2] = (type == KeyEvent::kWordGap) ? 0 : kFar;
+  return scores;
+}
+
+// Render text as confident element scores
+std::vector<ElementScores> CleanScores(const std::string& text) {
+  MorseEncoder encoder;
+  std::vector<ElementScores> out;
+  for (char c : text) {
+    if (c == ' ') {
+      out.back() = Gap(KeyEvent::kWordGap);
+      continue;
+    }
+    const std::string pattern = encoder.Encode(c);
+    for (size_t e = 0; e < pattern.size(); ++e) {
+      out.push_back(Mark(pattern[e] == '-'));
+      out.push_back(Gap(e + 1 < pattern.size() ? KeyEvent::kIntraGap : KeyEvent::kCharGap));
+    }
+  }
+  return out;
+}
+
+// Feed scores into a beam decoder and collect committed text (plus final flush)
+std::string RunBeam(BeamDecoder& beam, const std::vector<ElementScores>& scores,
+                    bool flush = true) {
+  std::string text;
+  char out[BeamDecoder::kMaxOutputChars];
+  for (const auto& element : scores) {
+    text.append(out, beam.ProcessElement(element, out, sizeof(out)));
+  }
+  if (flush) {
+    text.append(out, beam.Flush(out, sizeof(out)));
+  }
+  return text;
+}
+
+// Levenshtein distance for character error counts
+size_t EditDistance(const std::string& a, const std::string& b) {
+  std::vector<size_t> row(b.size() + 1);
+  for (size_t j = 0; j <= b.size(); ++j) {
+    row[j] = j;
+  }
+  for (size_t i = 1; i <= a.size(); ++i) {
+    size_t diagonal = row[0];
+    row[0] = i;
+    for (size_t j = 1; j <= b.size(); ++j) {
+      const size_t above = row[j];
+      row[j] = std::min({row[j] + 1, row[j - 1] + 1, diagonal + (a[i - 1] != b[j - 1] ? 1 : 0)});
+      diagonal = above;
+    }
+  }
+  return row[b.size()];
+}
+
+std::string Trim(const std::string& text) {
+  const size_t end = text.find_last_not_of(' ');
+  return end == std::string::npos ? std::string() : text.substr(0, end + 1);
+}
+
+class BeamDecoderTest : public ::testing::Test {
+ protected:
+  MorseTable table_;
+  BeamDecoder beam_{table_};
+};
+
+// ============================================================================
+// LANGUAGE MODEL
+// ============================================================================
+
+TEST_F(BeamDecoderTest, LanguageCostPrefersFrequentBigrams) {
+  EXPECT_LT(BeamDecoder::LanguageCost('T', 'H'), BeamDecoder::LanguageCost('T', 'Q'));
+  EXPECT_LT(BeamDecoder::LanguageCost('C', 'Q'), BeamDecoder::LanguageCost('C', 'X'));
+  EXPECT_LT(BeamDecoder::LanguageCost('7', '3'), BeamDecoder::LanguageCost('7', '4'));
+  // First and last table entries are found by the binary search
+  EXPECT_EQ(55, BeamDecoder::LanguageCost('A', 'N'));
+  EXPECT_EQ(112, BeamDecoder::LanguageCost(' ', '5'));
+  // Back-off: unlisted pairs cost the unigram of the next character
+  EXPECT_EQ(BeamDecoder::LanguageCost('X', 'E'), BeamDecoder::LanguageCost('Z', 'E'));
+}
+
+// ============================================================================
+// DECODING
+// ============================================================================
+
+TEST_F(BeamDecoderTest, CleanElementsDecode) {
+  EXPECT_EQ("CQ DE IU3QEZ K ", RunBeam(beam_, CleanScores("CQ DE IU3QEZ K ")));
+}
+
+TEST_F(BeamDecoderTest, AmbiguousGapResolvedByLanguageModel) {
+  // "T" then ". ? . . ." where the first gap slightly favours a character gap:
+  // greedy reads "TES", the bigram model prefers "TH"
+  std::vector<ElementScores> scores = CleanScores("T");
+  scores.push_back(Mark(false));
+  ElementScores ambiguous = Gap(KeyEvent::kCharGap);
+  ambiguous.cost[0] = 330;
+  ambiguous.cost[1] = 300;
+  scores.push_back(ambiguous);
+  scores.push_back(Mark(false));
+  scores.push_back(Gap(KeyEvent::kIntraGap));
+  scores.push_back(Mark(false));
+  scores.push_back(Gap(KeyEvent::kIntraGap));
+  scores.push_back(Mark(false));
+  scores.push_back(Gap(KeyEvent::kWordGap));
+
+  EXPECT_EQ("TH ", RunBeam(beam_, scores));
+
+  MorseDecoder greedy;
+  for (const auto& element : scores) {
+    greedy.ProcessElement(element);
+  }
+  EXPECT_EQ("TES ", greedy.GetDecodedText());
+}
+
+TEST_F(BeamDecoderTest, CommitDelayIsBounded) {
+  // Every gap equally likely to be intra or char: hypotheses never agree, so only
+  // the delay bound forces text out
+  ElementScores ambiguous = Gap(KeyEvent::kCharGap);
+  ambiguous.cost[0] = 300;
+  ambiguous.cost[1] = 300;
+
+  std::string committed;
+  char out[BeamDecoder::kMaxOutputChars];
+  for (int i = 0; i < 40; ++i) {
+    committed.append(out, beam_.ProcessElement(Mark(false), out, sizeof(out)));
+    committed.append(out, beam_.ProcessElement(ambiguous, out, sizeof(out)));
+  }
+  // Each character spans at most kMaxPatternLength dits and at most kMaxDelayChars
+  // characters may remain undecided
+  EXPECT_GE(committed.size(), 40 / BeamDecoder::kMaxPatternLength - BeamDecoder::kMaxDelayChars);
+  EXPECT_TRUE(beam_.HasPending());
+}
+
+TEST_F(BeamDecoderTest, FlushClosesOpenCharacter) {
+  std::vector<ElementScores> scores = {Mark(true), Gap(KeyEvent::kIntraGap), Mark(false)};
+  RunBeam(beam_, scores, false);
+
+  char pattern[BeamDecoder::kMaxPatternLength + 2];
+  EXPECT_EQ(2U, beam_.GetBestPattern(pattern, sizeof(pattern)));
+  EXPECT_STREQ("-.", pattern);
+  EXPECT_TRUE(beam_.HasPending());
+
+  char out[BeamDecoder::kMaxOutputChars];
+  const size_t count = beam_.Flush(out, sizeof(out));
+  EXPECT_EQ("N ", std::string(out, count));
+  EXPECT_FALSE(beam_.HasPending());
+}
+
+TEST_F(BeamDecoderTest, OverlongPatternDecodesAsUnknown) {
+  std::vector<ElementScores> scores;
+  for (int i = 0; i < 8; ++i) {
+    scores.push_back(Mark(false));
+    scores.push_back(Gap(KeyEvent::kIntraGap));
+  }
+  scores.back() = Gap(KeyEvent::kWordGap);
+  EXPECT_EQ("? ", RunBeam(beam_, scores));
+}
+
+// ============================================================================
+// MORSE DECODER INTEGRATION
+// ============================================================================
+
+TEST(MorseDecoderBeamModeTest, ProcessElementUsesBeamSearch) {
+  MorseDecoderConfig config;
+  config.mode = DecodingMode::kBeam;
+  MorseDecoder decoder(config);
+  EXPECT_EQ(DecodingMode::kBeam, decoder.GetDecodingMode());
+
+  for (const auto& element : CleanScores("TU 73 ")) {
+    decoder.ProcessElement(element);
+  }
+  EXPECT_EQ("TU 73 ", decoder.GetDecodedText());
+  EXPECT_EQ('3', decoder.GetLastChar());
+}
+
+TEST(MorseDecoderBeamModeTest, SwitchingModeFlushesOpenCharacter) {
+  MorseDecoderConfig config;
+  config.mode = DecodingMode::kBeam;
+  MorseDecoder decoder(config);
+
+  decoder.ProcessElement(Mark(true));
+  decoder.ProcessElement(Gap(KeyEvent::kIntraGap));
+  decoder.ProcessElement(Mark(true));
+  EXPECT_EQ("--", decoder.GetCurrentPattern());
+  EXPECT_EQ(DecoderState::kReceiving, decoder.GetState());
+
+  decoder.SetDecodingMode(DecodingMode::kGreedy);
+  EXPECT_EQ("M ", decoder.GetDecodedText());
+  EXPECT_EQ(DecoderState::kIdle, decoder.GetState());
+}
+
+TEST(MorseDecoderBeamModeTest, GreedyModeMatchesProcessEvent) {
+  MorseDecoder decoder;
+  for (const auto& element : CleanScores("SOS ")) {
+    decoder.ProcessElement(element);
+  }
+  EXPECT_EQ("SOS ", decoder.GetDecodedText());
+}
+
+TEST(MorseDecoderBeamModeTest, BeamNoWorseThanGreedyOnJitteredKeying) {
+  const std::string text =
+      "CQ CQ DE IU3QEZ IU3QEZ K THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG 5NN TU 73 "
+      "PARIS PARIS RST 599 QTH PADOVA NAME SIMONE HW CPY";
+
+  size_t greedy_errors = 0;
+  size_t beam_errors = 0;
+  for (uint32_t seed = 1; seed <= 5; ++seed) {
+    // Render with ±40% uniform jitter on every duration at 25 WPM
+    MorseEncoder encoder;
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> jitter(-0.4f, 0.4f);
+    const float unit = 1'200'000.0f / 25.0f;
+    std::vector<std::pair<int64_t, bool>> stream;
+    auto emit = [&](float units, bool key_on) {
+      stream.emplace_back(static_cast<int64_t>(units * unit * (1.0f + jitter(rng))), key_on);
+    };
+    for (char c : text) {
+      if (c == ' ') {
+        stream.pop_back();
+        emit(7.0f, false);
+        continue;
+      }
+      const std::string pattern = encoder.Encode(c);
+      for (size_t e = 0; e < pattern.size(); ++e) {
+        emit(pattern[e] == '-' ? 3.0f : 1.0f, true);
+        emit(e + 1 < pattern.size() ? 1.0f : 3.0f, false);
+      }
+    }
+
+    AdaptiveTimingClassifier greedy_classifier;
+    AdaptiveTimingClassifier beam_classifier;
+    MorseDecoderConfig config;
+    config.buffer_size = 256;
+    MorseDecoder greedy(config);
+    config.mode = DecodingMode::kBeam;
+    MorseDecoder beam(config);
+    for (const auto& [duration_us, key_on] : stream) {
+      ElementScores scores;
+      greedy_classifier.ClassifyDuration(duration_us, key_on, &scores);
+      greedy.ProcessElement(scores);
+      beam_classifier.ClassifyDuration(duration_us, key_on, &scores);
+      beam.ProcessElement(scores);
+    }
+    beam.SetDecodingMode(DecodingMode::kGreedy);  // Flush pending text
+
+    greedy_errors += EditDistance(text, Trim(greedy.GetDecodedText()));
+    beam_errors += EditDistance(text, Trim(beam.GetDecodedText()));
+  }
+
+  RecordProperty("greedy_errors", static_cast<int>(greedy_errors));
+  RecordProperty("beam_errors", static_cast<int>(beam_errors));
+  EXPECT_LE(beam_errors, greedy_errors);
+}
+
+}  // namespace
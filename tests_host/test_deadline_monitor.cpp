@@ -0,0 +1,77 @@
+/**
+ * @file test_deadline_monitor.cpp
+ * @brief Unit tests for keying edge lateness histograms and deadline miss attribution
+ */
+
+#include "keying/deadline_monitor.hpp"
+#include "gtest/gtest.h"
+
+using namespace keying;
+
+namespace {
+
+TEST(DeadlineMonitorTest, HistogramAndMisses) {
+  DeadlineMonitor monitor(1000);
+
+  EXPECT_FALSE(monitor.Record(DeadlineKind::kElementEnd, 0, 10'000, 10'050));   // 50 us
+  EXPECT_FALSE(monitor.Record(DeadlineKind::kElementEnd, 0, 20'000, 19'900));   // Early = on time
+  EXPECT_FALSE(monitor.Record(DeadlineKind::kElementEnd, 0, 30'000, 31'000));   // At the threshold
+  EXPECT_TRUE(monitor.Record(DeadlineKind::kElementEnd, 1, 40'000, 52'000));    // 12 ms
+
+  const DeadlineKindStats stats = monitor.Get(DeadlineKind::kElementEnd);
+  EXPECT_EQ(4U, stats.edges);
+  EXPECT_EQ(1U, stats.misses);
+  EXPECT_EQ(12'000U, stats.max_late_us);
+  EXPECT_EQ((50U + 0U + 1000U + 12'000U) / 4U, stats.mean_late_us);
+  EXPECT_EQ(2U, stats.histogram[0]);                        // < 100 us
+  EXPECT_EQ(1U, stats.histogram[4]);                        // < 2 ms
+  EXPECT_EQ(1U, stats.histogram[kLatenessBucketCount - 1]);  // >= 10 ms
+
+  EXPECT_EQ(0U, monitor.Get(DeadlineKind::kSidetoneStart).edges);
+}
+
+TEST(DeadlineMonitorTest, MissCarriesLastLoopAndTask) {
+  DeadlineMonitor monitor(1000);
+  uint32_t stages[kLoopStageCount] = {};
+
+  monitor.BeginLoop(0);
+  stages[static_cast<size_t>(LoopStage::kWifi)] = 4000;
+  monitor.EndLoop(4500, stages);
+
+  // Next iteration woke 3 ms after the previous one ended
+  monitor.BeginLoop(7500);
+  ASSERT_TRUE(monitor.Record(DeadlineKind::kElementStart, 0, 5000, 7600));
+  monitor.AttributeLastMiss("wifi_task_with_a_long_name");
+
+  DeadlineMiss misses[kDeadlineMissLogSize];
+  ASSERT_EQ(1U, monitor.Misses(misses, kDeadlineMissLogSize));
+  EXPECT_EQ(DeadlineKind::kElementStart, misses[0].kind);
+  EXPECT_EQ(2600U, misses[0].late_us);
+  EXPECT_EQ(3000U, misses[0].wake_delay_us);
+  EXPECT_EQ(4500U, misses[0].last_loop.loop_us);
+  EXPECT_EQ(4000U, misses[0].last_loop.stage_us[static_cast<size_t>(LoopStage::kWifi)]);
+  EXPECT_STREQ("wifi_task_with_", misses[0].task);  // Truncated to the FreeRTOS name length
+
+  EXPECT_EQ(4500U, monitor.worst_loop().loop_us);
+  EXPECT_EQ(3000U, monitor.max_wake_delay_us());
+}
+
+TEST(DeadlineMonitorTest, MissLogKeepsNewestAndResets) {
+  DeadlineMonitor monitor(100);
+  for (int i = 0; i < static_cast<int>(kDeadlineMissLogSize) + 3; ++i) {
+    ASSERT_TRUE(monitor.Record(DeadlineKind::kSidetoneStart, 0, i * 10'000, i * 10'000 + 200 + i));
+  }
+
+  DeadlineMiss misses[kDeadlineMissLogSize];
+  ASSERT_EQ(kDeadlineMissLogSize, monitor.Misses(misses, kDeadlineMissLogSize));
+  EXPECT_EQ(200U + kDeadlineMissLogSize + 2, misses[0].late_us);  // Newest first
+  EXPECT_EQ(203U, misses[kDeadlineMissLogSize - 1].late_us);       // Three oldest dropped
+  EXPECT_STREQ("", misses[0].task);
+
+  monitor.Reset();
+  EXPECT_EQ(0U, monitor.Misses(misses, kDeadlineMissLogSize));
+  EXPECT_EQ(0U, monitor.Get(DeadlineKind::kSidetoneStart).edges);
+  EXPECT_EQ(0U, monitor.worst_loop().loop_us);
+}
+
+}  // namespace
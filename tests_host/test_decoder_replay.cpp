@@ -0,0 +1,103 @@
+/**
+ * @file test_decoder_replay.cpp
+ * @brief Regression gate: replay the decoder corpus and enforce per-fixture CER budgets
+ *
+ * Fixtures live in tests_host/fixtures/decoder_corpus and are produced by
+ * scripts/decoder/generate_corpus.py (synthetic) or converted from timeline exports.
+ */
+
+#include "decoder_replay.hpp"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <fstream>
+
+using namespace decoder_replay;
+
+namespace {
+
+std::vector<Fixture> LoadCorpus() {
+  std::vector<Fixture> corpus;
+  for (const auto& path : ListFixtures(DECODER_CORPUS_DIR)) {
+    Fixture fixture;
+    std::string error;
+    EXPECT_TRUE(LoadFixture(path, &fixture, &error)) << error;
+    corpus.push_back(std::move(fixture));
+  }
+  return corpus;
+}
+
+TEST(DecoderReplayCorpus, CoversTenToEightyWpm) {
+  const auto corpus = LoadCorpus();
+  ASSERT_FALSE(corpus.empty()) << "No fixtures in " << DECODER_CORPUS_DIR;
+  const auto [slowest, fastest] = std::minmax_element(
+      corpus.begin(), corpus.end(),
+      [](const Fixture& a, const Fixture& b) { return a.wpm < b.wpm; });
+  EXPECT_LE(slowest->wpm, 10U);
+  EXPECT_GE(fastest->wpm, 80U);
+}
+
+TEST(DecoderReplayCorpus, GreedyWithinBudget) {
+  for (const auto& fixture : LoadCorpus()) {
+    const ReplayResult result = Replay(fixture, ReplayOptions{});
+    RecordProperty(fixture.name + "_greedy_cer_permille", static_cast<int>(result.cer * 1000.0));
+    RecordProperty(fixture.name + "_greedy_latency_us", static_cast<int>(result.mean_latency_us));
+    EXPECT_LE(result.cer, fixture.max_cer)
+        << fixture.name << "\n  ref: " << fixture.text << "\n  got: " << result.decoded;
+  }
+}
+
+TEST(DecoderReplayCorpus, BeamWithinBudget) {
+  ReplayOptions options;
+  options.mode = morse_decoder::DecodingMode::kBeam;
+  for (const auto& fixture : LoadCorpus()) {
+    const ReplayResult result = Replay(fixture, options);
+    RecordProperty(fixture.name + "_beam_cer_permille", static_cast<int>(result.cer * 1000.0));
+    RecordProperty(fixture.name + "_beam_latency_us", static_cast<int>(result.mean_latency_us));
+    EXPECT_LE(result.cer, fixture.max_cer)
+        << fixture.name << "\n  ref: " << fixture.text << "\n  got: " << result.decoded;
+  }
+}
+
+TEST(DecoderReplayCorpus, GreedyLatencyIsOneCharacterGap) {
+  // Greedy decoding emits a character when its gap ends: latency ≈ 3 dit units
+  Fixture fixture;
+  std::string error;
+  ASSERT_TRUE(LoadFixture(std::string(DECODER_CORPUS_DIR) + "/wpm20_paris.txt", &fixture,
+                          &error))
+      << error;
+  const ReplayResult result = Replay(fixture, ReplayOptions{});
+  EXPECT_GT(result.mean_latency_us, 2 * 60'000);
+  EXPECT_LT(result.mean_latency_us, 8 * 60'000);
+  EXPECT_GT(result.events, 100U);
+}
+
+TEST(DecoderReplayFixture, RejectsMalformedInput) {
+  const std::string path = ::testing::TempDir() + "decoder_replay_bad.txt";
+  {
+    std::ofstream out(path);
+    out << "text: E\n1000 1\n900 0\n";
+  }
+  Fixture fixture;
+  std::string error;
+  EXPECT_FALSE(LoadFixture(path, &fixture, &error));
+  EXPECT_NE(std::string::npos, error.find("increase"));
+
+  {
+    std::ofstream out(path);
+    out << "text: E\nwpm: 20\n1000 1\n61000 0\n241000 1\n";
+  }
+  ASSERT_TRUE(LoadFixture(path, &fixture, &error)) << error;
+  EXPECT_EQ("decoder_replay_bad", fixture.name);
+  EXPECT_EQ(3U, fixture.edges.size());
+  EXPECT_EQ(20U, fixture.wpm);
+}
+
+TEST(DecoderReplayFixture, EditDistance) {
+  EXPECT_EQ(0U, EditDistance("PARIS", "PARIS"));
+  EXPECT_EQ(1U, EditDistance("PARIS", "PARS"));
+  EXPECT_EQ(2U, EditDistance("EE", "I"));
+  EXPECT_EQ(5U, EditDistance("PARIS", ""));
+}
+
+}  // namespace
@@ -0,0 +1,129 @@
+/**
+ * @file test_decoder_service.cpp
+ * @brief Unit tests for DecoderService (parallel local/remote decoding)
+ *
+ * Tests that each key stream decodes independently at its own speed, edge bookkeeping
+ * (repeated states, long pauses) and the source tags written to the timeline.
+ */
+
+#include "morse_decoder/decoder_service.hpp"
+#include "morse_decoder/morse_encoder.hpp"
+#include "fake_esp_idf.hpp"
+#include "gtest/gtest.h"
+
+#include <string>
+
+using namespace morse_decoder;
+
+namespace {
+
+// Key edges for text at the given unit; t_us is advanced past the last space
+void SendText(DecoderService& service, KeySource source, const std::string& text,
+              int64_t unit_us, int64_t& t_us) {
+  MorseEncoder encoder;
+  for (char c : text) {
+    if (c == ' ') {
+      t_us += 4 * unit_us;  // Char gap already sent, 7 units total
+      continue;
+    }
+    for (char element : encoder.Encode(c)) {
+      fake_esp_timer_set_time(t_us);
+      service.OnKeyEdge(source, true, t_us);
+      t_us += (element == '-' ? 3 : 1) * unit_us;
+      fake_esp_timer_set_time(t_us);
+      service.OnKeyEdge(source, false, t_us);
+      t_us += unit_us;
+    }
+    t_us += 2 * unit_us;
+  }
+}
+
+// Key down that closes the trailing gap so it gets classified
+void CloseGap(DecoderService& service, KeySource source, int64_t t_us) {
+  fake_esp_timer_set_time(t_us);
+  service.OnKeyEdge(source, true, t_us);
+}
+
+TEST(DecoderServiceTest, StreamsDecodeIndependently) {
+  DecoderService service;
+  int64_t t_local = 1'000'000;
+  int64_t t_client = 1'000'000;
+
+  // Local at 20 WPM, remote client at 30 WPM: each learns its own speed
+  SendText(service, KeySource::kLocal, "PARIS PARIS ", 60000, t_local);
+  CloseGap(service, KeySource::kLocal, t_local);
+  SendText(service, KeySource::kRemoteClient, "CQ CQ ", 40000, t_client);
+  CloseGap(service, KeySource::kRemoteClient, t_client);
+
+  const std::string local = service.GetDecoder(KeySource::kLocal)->GetDecodedText();
+  const std::string client = service.GetDecoder(KeySource::kRemoteClient)->GetDecodedText();
+  EXPECT_NE(std::string::npos, local.find("PARIS PARIS")) << local;
+  EXPECT_NE(std::string::npos, client.find("CQ CQ")) << client;
+  EXPECT_EQ(std::string::npos, local.find("CQ"));
+  EXPECT_TRUE(service.GetDecoder(KeySource::kRemoteServer)->GetDecodedText().empty());
+
+  EXPECT_NEAR(20.0f, service.GetDecoder(KeySource::kLocal)->GetDetectedWPM(), 1.0f);
+  EXPECT_NEAR(30.0f, service.GetDecoder(KeySource::kRemoteClient)->GetDetectedWPM(), 1.5f);
+
+  EXPECT_TRUE(service.HasActivity(KeySource::kLocal));
+  EXPECT_TRUE(service.HasActivity(KeySource::kRemoteClient));
+  EXPECT_FALSE(service.HasActivity(KeySource::kRemoteServer));
+}
+
+TEST(DecoderServiceTest, RepeatedEdgesAndLongPausesAreIgnored) {
+  DecoderService service;
+  MorseDecoder* decoder = service.GetDecoder(KeySource::kRemoteServer);
+
+  // Duplicate key-down notifications (network retransmit) must not create elements
+  service.OnKeyEdge(KeySource::kRemoteServer, true, 1'000'000);
+  service.OnKeyEdge(KeySource::kRemoteServer, true, 1'030'000);
+  service.OnKeyEdge(KeySource::kRemoteServer, false, 1'060'000);
+  EXPECT_EQ(1U, decoder->GetFistStats().classes[static_cast<size_t>(KeyEvent::kDit)].count);
+
+  // A 20 s silence is longer than any element and is skipped entirely
+  service.OnKeyEdge(KeySource::kRemoteServer, true, 21'060'000);
+  size_t gaps = 0;
+  const FistStats stats = decoder->GetFistStats();
+  for (size_t i = static_cast<size_t>(KeyEvent::kIntraGap); i < FistStats::kClassCount; ++i) {
+    gaps += stats.classes[i].count;
+  }
+  EXPECT_EQ(0U, gaps);
+}
+
+TEST(DecoderServiceTest, TimelineEventsCarryTheSource) {
+  timeline::EventLogger<timeline::kTimelineCapacity> logger;
+  DecoderService service;
+  service.SetTimelineLogger(&logger);
+
+  int64_t t_us = 1'000'000;
+  SendText(service, KeySource::kRemoteClient, "PARIS PARIS ", 60000, t_us);
+  CloseGap(service, KeySource::kRemoteClient, t_us);
+
+  size_t remote_edges = 0;
+  size_t decoded = 0;
+  logger.for_each([&](const timeline::TimelineEvent& event) {
+    if (event.type == timeline::EventType::kRemoteEvent) {
+      EXPECT_EQ(static_cast<uint32_t>(KeySource::kRemoteClient), event.arg0);
+      ++remote_edges;
+    } else if (event.type == timeline::EventType::kDecodedChar ||
+               event.type == timeline::EventType::kGapMarker) {
+      EXPECT_EQ(static_cast<uint32_t>(KeySource::kRemoteClient), event.arg1);
+      if (event.type == timeline::EventType::kDecodedChar) {
+        ++decoded;
+      }
+    }
+  });
+  EXPECT_EQ(57U, remote_edges);  // 28 marks and the closing key down
+  EXPECT_GE(decoded, 10U);
+}
+
+TEST(DecoderServiceTest, ControlsApplyToEveryStream) {
+  DecoderService service;
+  service.SetEnabled(false);
+  for (size_t i = 0; i < kKeySourceCount; ++i) {
+    EXPECT_FALSE(service.GetDecoder(static_cast<KeySource>(i))->IsEnabled());
+  }
+  EXPECT_STREQ("remote_client", DecoderService::SourceName(KeySource::kRemoteClient));
+}
+
+}  // namespace
@@ -0,0 +1,97 @@
+/**
+ * @file test_edge_stream.cpp
+ * @brief Unit tests for the delta/varint key edge stream
+ */
+
+#include "timeline/edge_stream.hpp"
+#include "gtest/gtest.h"
+
+#include <utility>
+#include <vector>
+
+using namespace timeline;
+
+namespace {
+
+std::vector<std::pair<bool, int64_t>> Decode(const uint8_t* data, size_t size) {
+  std::vector<std::pair<bool, int64_t>> edges;
+  EdgeStreamReader reader(data, size);
+  bool key_active = false;
+  int64_t offset_us = 0;
+  while (reader.Next(&key_active, &offset_us)) {
+    edges.emplace_back(key_active, offset_us);
+  }
+  return edges;
+}
+
+TEST(EdgeStreamTest, RoundTripsMicrosecondOffsets) {
+  uint8_t buffer[64];
+  EdgeStreamWriter writer(buffer, sizeof(buffer));
+  const int64_t base = 7'000'000'000LL;
+  ASSERT_TRUE(writer.Add(true, base));
+  ASSERT_TRUE(writer.Add(false, base + 60'013));
+  ASSERT_TRUE(writer.Add(true, base + 120'000));
+  ASSERT_TRUE(writer.Add(false, base + 300'127));
+  const size_t length = writer.Finish();
+
+  // 4-byte header, first edge 1 byte, 60 ms gaps 3 bytes each
+  EXPECT_EQ(kEdgeStreamHeaderSize + 1 + 3 * 3, length);
+  const auto edges = Decode(buffer, length);
+  ASSERT_EQ(4U, edges.size());
+  EXPECT_EQ(std::make_pair(true, int64_t{0}), edges[0]);
+  EXPECT_EQ(std::make_pair(false, int64_t{60'013}), edges[1]);
+  EXPECT_EQ(std::make_pair(true, int64_t{120'000}), edges[2]);
+  EXPECT_EQ(std::make_pair(false, int64_t{300'127}), edges[3]);
+
+  int64_t duration_us = 0;
+  EXPECT_TRUE(ValidateEdgeStream(buffer, length, &duration_us));
+  EXPECT_EQ(300'127, duration_us);
+}
+
+TEST(EdgeStreamTest, IgnoresLeadingKeyUpAndRepeatedStates) {
+  uint8_t buffer[32];
+  EdgeStreamWriter writer(buffer, sizeof(buffer));
+  writer.SetOrigin(1'000);
+  EXPECT_TRUE(writer.Add(false, 1'500));
+  EXPECT_TRUE(writer.Add(true, 2'000));
+  EXPECT_TRUE(writer.Add(true, 2'500));
+  EXPECT_TRUE(writer.Add(false, 3'000));
+  const auto edges = Decode(buffer, writer.Finish());
+  ASSERT_EQ(2U, edges.size());
+  EXPECT_EQ(1'000, edges[0].second);  // Offset from the explicit origin
+  EXPECT_EQ(2'000, edges[1].second);
+}
+
+TEST(EdgeStreamTest, FullBufferKeepsWholeMarksOnly) {
+  uint8_t buffer[kEdgeStreamHeaderSize + 7];
+  EdgeStreamWriter writer(buffer, sizeof(buffer));
+  int64_t t = 0;
+  bool accepted = true;
+  for (int i = 0; accepted && i < 10; ++i) {
+    accepted = writer.Add(i % 2 == 0, t);
+    t += 60'000;
+  }
+  EXPECT_TRUE(writer.full());
+  const size_t length = writer.Finish();
+  EXPECT_EQ(0U, writer.count() % 2);
+  EXPECT_TRUE(ValidateEdgeStream(buffer, length));
+  EXPECT_EQ(writer.count(), Decode(buffer, length).size());
+}
+
+TEST(EdgeStreamTest, RejectsMalformedStreams) {
+  uint8_t buffer[32];
+  EdgeStreamWriter writer(buffer, sizeof(buffer));
+  writer.Add(true, 0);
+  writer.Add(false, 200'000);
+  const size_t length = writer.Finish();
+
+  EXPECT_FALSE(ValidateEdgeStream(buffer, length - 1));  // Truncated varint
+  buffer[0] = 0;
+  EXPECT_FALSE(ValidateEdgeStream(buffer, length));  // Bad magic
+  buffer[0] = kEdgeStreamMagic;
+  buffer[2] = 3;
+  EXPECT_FALSE(ValidateEdgeStream(buffer, length));  // Odd edge count
+  EXPECT_FALSE(ValidateEdgeStream(nullptr, 0));
+}
+
+}  // namespace
@@ -0,0 +1,141 @@
+/**
+ * @file test_event_logger.cpp
+ * @brief Unit tests for the packed timeline ring
+ */
+
+#include "timeline/event_logger.hpp"
+#include "gtest/gtest.h"
+
+#include <vector>
+
+using namespace timeline;
+
+namespace {
+
+template <size_t Capacity>
+std::vector<TimelineEvent> Collect(const EventLogger<Capacity>& logger) {
+  std::vector<TimelineEvent> events;
+  logger.for_each([&](const TimelineEvent& event) { events.push_back(event); });
+  return events;
+}
+
+void ExpectEvent(const TimelineEvent& expected, const TimelineEvent& actual) {
+  EXPECT_EQ(expected.timestamp_us, actual.timestamp_us);
+  EXPECT_EQ(expected.type, actual.type);
+  EXPECT_EQ(expected.arg0, actual.arg0);
+  EXPECT_EQ(expected.arg1, actual.arg1);
+}
+
+TEST(EventLoggerTest, SlotsAreEightBytes) {
+  EXPECT_EQ(8U, sizeof(PackedEvent));
+  // Three times the old 1024 × 24-byte ring, plus block bases and extensions
+  EXPECT_LE(sizeof(EventLogger<kTimelineCapacity>), 1024U * sizeof(TimelineEvent) + 2048U);
+}
+
+TEST(EventLoggerTest, RoundTripsKeyingEventsAcrossWraps) {
+  EventLogger<64> logger;
+  std::vector<TimelineEvent> pushed;
+  for (uint32_t i = 0; i < 200; ++i) {
+    const TimelineEvent event{5'000'000'000LL + static_cast<int64_t>(i) * 60'000,
+                              (i % 3 == 0) ? EventType::kPaddleEdge : EventType::kKeying,
+                              (i & 1U) | ((i % 4) << 8), i & 1U};
+    logger.push(event);
+    pushed.push_back(event);
+  }
+  EXPECT_EQ(64U, logger.size());
+  EXPECT_EQ(136U, logger.dropped_count());
+
+  const auto events = Collect(logger);
+  ASSERT_EQ(64U, events.size());
+  for (size_t i = 0; i < events.size(); ++i) {
+    ExpectEvent(pushed[136 + i], events[i]);
+  }
+  ExpectEvent(pushed.back(), logger.latest());
+}
+
+TEST(EventLoggerTest, PreviousLapOfTheHeadBlockKeepsItsBase) {
+  EventLogger<64> logger;  // Two 32-slot blocks
+  for (int64_t i = 0; i < 64; ++i) {
+    logger.push({i * 1'000, EventType::kKeying, 1, 0});
+  }
+  // An hour later: block 0 gets a new base while slots 5-31 still hold the first lap
+  for (int64_t i = 0; i < 5; ++i) {
+    logger.push({3'600'000'000LL + i, EventType::kKeying, 2, 0});
+  }
+  const auto events = Collect(logger);
+  ASSERT_EQ(64U, events.size());
+  EXPECT_EQ(5'000, events[0].timestamp_us);
+  EXPECT_EQ(31'000, events[26].timestamp_us);
+  EXPECT_EQ(32'000, events[27].timestamp_us);
+  EXPECT_EQ(3'600'000'000LL, events[59].timestamp_us);
+  EXPECT_EQ(3'600'000'004LL, events[63].timestamp_us);
+}
+
+TEST(EventLoggerTest, ForEachSkipsSlotsOverwrittenDuringTheWalk) {
+  EventLogger<64> logger;  // Two 32-slot blocks
+  for (int64_t i = 0; i < 64; ++i) {
+    logger.push({i * 1'000, EventType::kKeying, 1, 0});
+  }
+  // A writer starts a new block an hour later while the reader is in the oldest one
+  std::vector<TimelineEvent> events;
+  logger.for_each([&](const TimelineEvent& event) {
+    if (events.empty()) {
+      for (int64_t i = 0; i < 32; ++i) {
+        logger.push({3'600'000'000LL + i, EventType::kKeying, 2, 0});
+      }
+    }
+    events.push_back(event);
+  });
+  // The first batch was decoded before the push; the rest of block 0 is gone and
+  // nothing from the new lap shows up as an old event
+  ASSERT_EQ(16U + 32U, events.size());
+  for (size_t i = 0; i < 16; ++i) {
+    EXPECT_EQ(static_cast<int64_t>(i) * 1'000, events[i].timestamp_us);
+  }
+  for (size_t i = 16; i < events.size(); ++i) {
+    EXPECT_EQ(static_cast<int64_t>(i + 16) * 1'000, events[i].timestamp_us);
+    EXPECT_EQ(1U, events[i].arg0);
+  }
+}
+
+TEST(EventLoggerTest, WideEventsUseExtensionRecords) {
+  EventLogger<64> logger;
+  const std::vector<TimelineEvent> pushed = {
+      {1'000, EventType::kKeying, 1, 1},
+      {2'000, EventType::kDiagnostics, 0xDEADBEEFU, 0x12345678U},        // Wide args
+      {1'000, EventType::kDecodedChar, 'K', 0},                           // Out of order
+      {9'000'000'000LL, EventType::kFocus, 3, 0},                         // Gap beyond ±35 min
+      {9'000'000'100LL, static_cast<EventType>(20), 0, 0},                // Type beyond the nibble
+      {-5, EventType::kRemoteEvent, 2, 1},
+  };
+  for (const auto& event : pushed) {
+    logger.push(event);
+  }
+  const auto events = Collect(logger);
+  ASSERT_EQ(pushed.size(), events.size());
+  for (size_t i = 0; i < pushed.size(); ++i) {
+    ExpectEvent(pushed[i], events[i]);
+  }
+}
+
+TEST(EventLoggerTest, ReusedExtensionDegradesToTheSlot) {
+  EventLogger<64> logger;
+  ASSERT_EQ(4U, EventLogger<64>::kExtensionCapacity);
+  for (uint32_t i = 0; i < 6; ++i) {
+    logger.push({static_cast<int64_t>(i) * 1'000, EventType::kAudio, 0x10000000U + i, 7 + 0x1000U});
+  }
+  const auto events = Collect(logger);
+  ASSERT_EQ(6U, events.size());
+  // The two oldest lost their extension: timestamp and arg0 low half survive
+  EXPECT_EQ(0, events[0].timestamp_us);
+  EXPECT_EQ(EventType::kAudio, events[0].type);
+  EXPECT_EQ(0U, events[0].arg0);
+  EXPECT_EQ(0U, events[0].arg1);
+  EXPECT_EQ(1U, events[1].arg0);
+  for (size_t i = 2; i < events.size(); ++i) {
+    EXPECT_EQ(0x10000000U + i, events[i].arg0);
+    EXPECT_EQ(7 + 0x1000U, events[i].arg1);
+  }
+}
+
+}  // namespace
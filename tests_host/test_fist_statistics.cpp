@@ -0,0 +1,246 @@
+/**
+ * @file test_fist_statistics.cpp
+ * @brief Unit tests for FistStatistics (streaming fist analysis)
+ *
+ * Tests Welford moments and P² quantiles against exact values, the derived fist
+ * figures on synthetic keying and the MorseDecoder integration.
+ */
+
+#include "morse_decoder/fist_statistics.hpp"
+#include "morse_decoder/morse_decoder.hpp"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace morse_decoder;
+
+namespace {
+
+// Exact sample quantile (nearest rank) for comparison
+float ExactQuantile(std::vector<float> samples, float quantile) {
+  std::sort(samples.begin(), samples.end());
+  const size_t index = static_cast<size_t>(std::lround(quantile * (samples.size() - 1)));
+  return samples[index];
+}
+
+// Send one "PARIS " worth of elements with the given unit and weighting
+void SendParis(FistStatistics& fist, float unit_us, float dah_units = 3.0f) {
+  static const char* const kPattern[] = {".--.", ".-", ".-.", "..", "..."};
+  for (size_t c = 0; c < 5; ++c) {
+    const char* pattern = kPattern[c];
+    for (size_t e = 0; pattern[e] != '\0'; ++e) {
+      const bool dah = pattern[e] == '-';
+      fist.AddElement(dah ? KeyEvent::kDah : KeyEvent::kDit,
+                      static_cast<int64_t>(unit_us * (dah ? dah_units : 1.0f)));
+      KeyEvent gap = KeyEvent::kIntraGap;
+      float units = 1.0f;
+      if (pattern[e + 1] == '\0') {
+        gap = (c == 4) ? KeyEvent::kWordGap : KeyEvent::kCharGap;
+        units = (c == 4) ? 7.0f : 3.0f;
+      }
+      fist.AddElement(gap, static_cast<int64_t>(unit_us * units));
+    }
+  }
+}
+
+// ============================================================================
+// ESTIMATORS
+// ============================================================================
+
+TEST(RunningMomentsTest, MatchesTwoPassMeanAndVariance) {
+  std::mt19937 rng(7);
+  std::normal_distribution<float> dist(60000.0f, 5000.0f);
+  RunningMoments moments;
+  std::vector<float> samples;
+  for (int i = 0; i < 2000; ++i) {
+    samples.push_back(dist(rng));
+    moments.Add(samples.back());
+  }
+
+  double mean = 0.0;
+  for (float x : samples) mean += x;
+  mean /= samples.size();
+  double variance = 0.0;
+  for (float x : samples) variance += (x - mean) * (x - mean);
+  variance /= samples.size() - 1;
+
+  EXPECT_EQ(2000U, moments.Count());
+  EXPECT_NEAR(mean, moments.Mean(), 1.0);
+  EXPECT_NEAR(std::sqrt(variance), moments.StdDev(), 5.0);
+}
+
+TEST(P2QuantileTest, ExactDuringWarmUp) {
+  P2Quantile median(0.5f);
+  EXPECT_EQ(0.0f, median.Value());
+  for (float x : {50.0f, 10.0f, 30.0f}) {
+    median.Add(x);
+  }
+  EXPECT_EQ(30.0f, median.Value());
+}
+
+TEST(P2QuantileTest, TracksQuantilesOfSkewedStream) {
+  std::mt19937 rng(11);
+  std::lognormal_distribution<float> dist(std::log(60000.0f), 0.15f);
+  P2Quantile p10(0.1f);
+  P2Quantile p50(0.5f);
+  P2Quantile p90(0.9f);
+  std::vector<float> samples;
+  for (int i = 0; i < 5000; ++i) {
+    const float x = dist(rng);
+    samples.push_back(x);
+    p10.Add(x);
+    p50.Add(x);
+    p90.Add(x);
+  }
+  // Within 2% of the exact sample quantiles
+  EXPECT_NEAR(ExactQuantile(samples, 0.1f), p10.Value(), 0.02f * p10.Value());
+  EXPECT_NEAR(ExactQuantile(samples, 0.5f), p50.Value(), 0.02f * p50.Value());
+  EXPECT_NEAR(ExactQuantile(samples, 0.9f), p90.Value(), 0.02f * p90.Value());
+}
+
+// ============================================================================
+// FIST FIGURES
+// ============================================================================
+
+TEST(FistStatisticsTest, EmptySnapshotIsZero) {
+  FistStatistics fist;
+  const FistStats stats = fist.GetSnapshot();
+  EXPECT_EQ(0U, stats.classes[0].count);
+  EXPECT_EQ(0.0f, stats.dah_dit_ratio);
+  EXPECT_EQ(0.0f, stats.session_wpm);
+  EXPECT_EQ(0U, stats.window_count);
+}
+
+TEST(FistStatisticsTest, PerfectKeyingHasNominalFigures) {
+  FistStatistics fist;
+  for (int i = 0; i < 5; ++i) {
+    SendParis(fist, 60000.0f);  // 20 WPM
+  }
+  const FistStats stats = fist.GetSnapshot();
+
+  EXPECT_NEAR(3.0f, stats.dah_dit_ratio, 0.01f);
+  EXPECT_NEAR(50.0f, stats.weighting_percent, 0.1f);
+  EXPECT_NEAR(0.0f, stats.jitter_percent, 0.1f);
+  EXPECT_NEAR(0.0f, stats.gap_jitter_percent, 0.1f);
+  EXPECT_NEAR(3.0f, stats.char_gap_units, 0.01f);
+  EXPECT_NEAR(7.0f, stats.word_gap_units, 0.01f);
+  EXPECT_NEAR(20.0f, stats.session_wpm, 0.1f);
+  EXPECT_NEAR(20.0f, stats.window_wpm, 0.1f);
+  EXPECT_NEAR(0.0f, stats.speed_drift_percent, 0.5f);
+  EXPECT_EQ(FistStatistics::kWindowSize, stats.window_count);
+
+  const auto& dah = stats.classes[static_cast<size_t>(KeyEvent::kDah)];
+  EXPECT_EQ(20U, dah.count);  // PARIS has 4 dahs
+  EXPECT_NEAR(180000.0f, dah.p50_us, 1.0f);
+}
+
+TEST(FistStatisticsTest, HeavyDahsRaiseRatio) {
+  FistStatistics fist;
+  for (int i = 0; i < 5; ++i) {
+    SendParis(fist, 60000.0f, 3.6f);
+  }
+  EXPECT_NEAR(3.6f, fist.GetSnapshot().dah_dit_ratio, 0.01f);
+}
+
+TEST(FistStatisticsTest, JitterReflectsTimingSpread) {
+  std::mt19937 rng(3);
+  std::normal_distribution<float> jitter(1.0f, 0.1f);  // 10% standard deviation
+  FistStatistics fist;
+  for (int i = 0; i < 500; ++i) {
+    fist.AddElement(KeyEvent::kDit, static_cast<int64_t>(60000.0f * jitter(rng)));
+    fist.AddElement(KeyEvent::kIntraGap, 60000);
+  }
+  const FistStats stats = fist.GetSnapshot();
+  EXPECT_NEAR(10.0f, stats.jitter_percent, 1.0f);
+  EXPECT_NEAR(0.0f, stats.gap_jitter_percent, 0.1f);
+}
+
+TEST(FistStatisticsTest, SpeedDriftFollowsRecentMarks) {
+  FistStatistics fist;
+  for (int i = 0; i < 10; ++i) {
+    SendParis(fist, 60000.0f);  // 20 WPM
+  }
+  for (int i = 0; i < 4; ++i) {
+    SendParis(fist, 50000.0f);  // 24 WPM, fills the window
+  }
+  const FistStats stats = fist.GetSnapshot();
+  EXPECT_GT(stats.window_wpm, stats.session_wpm);
+  EXPECT_GT(stats.speed_drift_percent, 5.0f);
+  EXPECT_NEAR(24.0f, stats.window_wpm, 0.5f);
+}
+
+TEST(FistStatisticsTest, LongPausesAreNotWordGaps) {
+  FistStatistics fist;
+  SendParis(fist, 60000.0f);
+  fist.AddElement(KeyEvent::kWordGap, 10'000'000);  // Operator stopped for 10 s
+  const FistStats stats = fist.GetSnapshot();
+  EXPECT_EQ(1U, stats.classes[static_cast<size_t>(KeyEvent::kWordGap)].count);
+  EXPECT_NEAR(7.0f, stats.word_gap_units, 0.01f);
+}
+
+TEST(FistStatisticsTest, UnknownEventsAndResetAreHandled) {
+  FistStatistics fist;
+  fist.AddElement(KeyEvent::kUnknown, 60000);
+  fist.AddElement(KeyEvent::kDit, 0);
+  EXPECT_EQ(0U, fist.GetSnapshot().classes[0].count);
+
+  SendParis(fist, 60000.0f);
+  EXPECT_GT(fist.GetSnapshot().classes[0].count, 0U);
+  fist.Reset();
+  EXPECT_EQ(0U, fist.GetSnapshot().classes[0].count);
+  EXPECT_EQ(0U, fist.GetSnapshot().window_count);
+}
+
+// ============================================================================
+// MORSE DECODER INTEGRATION
+// ============================================================================
+
+TEST(MorseDecoderFistTest, ClassifiedElementsFeedStatistics) {
+  AdaptiveTimingClassifier classifier;
+  MorseDecoderConfig config;
+  config.timing_classifier = &classifier;
+  MorseDecoder decoder(config);
+
+  // "TEST " four times at 20 WPM through the real classifier
+  const std::pair<int64_t, bool> element[] = {
+      {180000, true}, {180000, false},                                   // T
+      {60000, true},  {180000, false},                                   // E
+      {60000, true},  {60000, false}, {60000, true}, {60000, false},
+      {60000, true},  {180000, false},                                   // S
+      {180000, true}, {420000, false},                                   // T
+  };
+  for (int repeat = 0; repeat < 4; ++repeat) {
+    for (const auto& [duration_us, key_on] : element) {
+      ElementScores scores;
+      classifier.ClassifyDuration(duration_us, key_on, &scores);
+      EXPECT_EQ(duration_us, scores.duration_us);
+      decoder.ProcessElement(scores);
+    }
+  }
+
+  FistStats stats = decoder.GetFistStats();
+  EXPECT_EQ(16U, stats.classes[static_cast<size_t>(KeyEvent::kDit)].count);
+  EXPECT_EQ(8U, stats.classes[static_cast<size_t>(KeyEvent::kDah)].count);
+  EXPECT_NEAR(3.0f, stats.dah_dit_ratio, 0.01f);
+  EXPECT_NEAR(20.0f, stats.session_wpm, 0.1f);
+
+  decoder.Reset();
+  stats = decoder.GetFistStats();
+  EXPECT_EQ(0U, stats.classes[static_cast<size_t>(KeyEvent::kDit)].count);
+}
+
+TEST(MorseDecoderFistTest, DisabledDecoderDoesNotCollect) {
+  MorseDecoder decoder;
+  decoder.SetEnabled(false);
+  ElementScores scores;
+  scores.best = KeyEvent::kDit;
+  scores.key_on = true;
+  scores.duration_us = 60000;
+  decoder.ProcessElement(scores);
+  EXPECT_EQ(0U, decoder.GetFistStats().classes[0].count);
+}
+
+}  // namespace
@@ -0,0 +1,98 @@
+/**
+ * @file test_hid_keyer.cpp
+ * @brief Unit tests for the USB HID keyboard report state and latency statistics
+ */
+
+#include "usb_hid/hid_keyer.hpp"
+#include "gtest/gtest.h"
+
+using namespace usb_hid;
+
+namespace {
+
+TEST(HidKeyerTest, PaddlesMapToLeftAndRightCtrl) {
+  HidKeyer keyer(HidKeyerMode::kPaddles);
+  uint8_t modifiers = 0xFF;
+  int64_t edge_us = 0;
+  EXPECT_FALSE(keyer.TakeReport(&modifiers, &edge_us));
+
+  keyer.OnPaddleEdge(hal::PaddleLine::kDit, true, 1000);
+  ASSERT_TRUE(keyer.TakeReport(&modifiers, &edge_us));
+  EXPECT_EQ(kModifierLeftCtrl, modifiers);
+  EXPECT_EQ(1000, edge_us);
+
+  keyer.OnPaddleEdge(hal::PaddleLine::kDah, true, 2000);
+  ASSERT_TRUE(keyer.TakeReport(&modifiers, &edge_us));
+  EXPECT_EQ(kModifierLeftCtrl | kModifierRightCtrl, modifiers);
+
+  keyer.OnPaddleEdge(hal::PaddleLine::kFocus, true, 2500);  // Not a key
+  keyer.OnKeyEdge(true, 2600);                               // Keyed output not mirrored
+  EXPECT_FALSE(keyer.TakeReport(&modifiers, &edge_us));
+
+  // Straight key shares Left Ctrl with dit: released only when both are
+  keyer.OnPaddleEdge(hal::PaddleLine::kKey, true, 3000);
+  EXPECT_FALSE(keyer.TakeReport(&modifiers, &edge_us));
+  keyer.OnPaddleEdge(hal::PaddleLine::kDit, false, 4000);
+  EXPECT_FALSE(keyer.TakeReport(&modifiers, &edge_us));
+  keyer.OnPaddleEdge(hal::PaddleLine::kKey, false, 5000);
+  keyer.OnPaddleEdge(hal::PaddleLine::kDah, false, 5100);
+  ASSERT_TRUE(keyer.TakeReport(&modifiers, &edge_us));
+  EXPECT_EQ(0, modifiers);
+  EXPECT_EQ(5000, edge_us);  // Charged to the oldest edge in the report
+}
+
+TEST(HidKeyerTest, KeyedModeIgnoresRawPaddles) {
+  HidKeyer keyer(HidKeyerMode::kKeyed);
+  uint8_t modifiers = 0;
+  int64_t edge_us = 0;
+
+  keyer.OnPaddleEdge(hal::PaddleLine::kDah, true, 100);
+  EXPECT_FALSE(keyer.TakeReport(&modifiers, &edge_us));
+
+  keyer.OnKeyEdge(true, 200);
+  ASSERT_TRUE(keyer.TakeReport(&modifiers, &edge_us));
+  EXPECT_EQ(kModifierLeftCtrl, modifiers);
+  EXPECT_EQ(200, edge_us);
+
+  keyer.OnKeyEdge(true, 300);  // Repeated state: nothing new
+  EXPECT_FALSE(keyer.TakeReport(&modifiers, &edge_us));
+}
+
+TEST(HidKeyerTest, PressAndReleaseBetweenReportsCollapse) {
+  HidKeyer keyer(HidKeyerMode::kPaddles);
+  uint8_t modifiers = 0;
+  int64_t edge_us = 0;
+
+  keyer.OnPaddleEdge(hal::PaddleLine::kDit, true, 100);
+  keyer.OnPaddleEdge(hal::PaddleLine::kDit, false, 400);
+  EXPECT_EQ(0, keyer.modifiers());
+  EXPECT_FALSE(keyer.TakeReport(&modifiers, &edge_us));
+
+  // The next change starts a new latency window
+  keyer.OnPaddleEdge(hal::PaddleLine::kDah, true, 900);
+  ASSERT_TRUE(keyer.TakeReport(&modifiers, &edge_us));
+  EXPECT_EQ(900, edge_us);
+}
+
+TEST(HidLatencyStatsTest, SummaryAndReset) {
+  HidLatencyStats stats;
+  EXPECT_EQ(0U, stats.Get().samples);
+
+  stats.Record(900);
+  stats.Record(1500);
+  stats.Record(3000);
+
+  const HidLatencySummary summary = stats.Get();
+  EXPECT_EQ(3U, summary.samples);
+  EXPECT_EQ(3000U, summary.last_us);
+  EXPECT_EQ(900U, summary.min_us);
+  EXPECT_EQ(3000U, summary.max_us);
+  EXPECT_EQ(1800U, summary.mean_us);
+  EXPECT_EQ(1U, summary.over_2ms);
+
+  stats.Reset();
+  EXPECT_EQ(0U, stats.Get().samples);
+  EXPECT_EQ(0U, stats.Get().max_us);
+}
+
+}  // namespace
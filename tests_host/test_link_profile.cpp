@@ -0,0 +1,57 @@
+/**
+ * @file test_link_profile.cpp
+ * @brief Unit tests for per-profile CWNet round-trip statistics
+ */
+
+#include "remote/link_profile.hpp"
+#include "gtest/gtest.h"
+
+using namespace remote;
+
+namespace {
+
+TEST(RttStatsTest, ProfilesAreKeptApart) {
+  RttStats stats;
+  stats.Record(LinkProfile::kDefault, 40'000);
+  stats.Record(LinkProfile::kDefault, 80'000);
+  stats.Record(LinkProfile::kDefault, 60'000);
+  stats.Record(LinkProfile::kLowLatency, 12'000);
+
+  const RttSummary slow = stats.Get(LinkProfile::kDefault);
+  EXPECT_EQ(3U, slow.samples);
+  EXPECT_EQ(60'000U, slow.last_us);
+  EXPECT_EQ(40'000U, slow.min_us);
+  EXPECT_EQ(80'000U, slow.max_us);
+  EXPECT_EQ(60'000U, slow.mean_us);
+
+  const RttSummary fast = stats.Get(LinkProfile::kLowLatency);
+  EXPECT_EQ(1U, fast.samples);
+  EXPECT_EQ(12'000U, fast.mean_us);
+  EXPECT_EQ(0U, fast.jitter_us);
+
+  stats.Reset();
+  EXPECT_EQ(0U, stats.Get(LinkProfile::kDefault).samples);
+}
+
+TEST(RttStatsTest, JitterFollowsRttVariation) {
+  RttStats stats;
+  for (int i = 0; i < 100; ++i) {
+    stats.Record(LinkProfile::kLowLatency, 10'000);
+  }
+  EXPECT_EQ(0U, stats.Get(LinkProfile::kLowLatency).jitter_us);
+
+  // Power-save style: alternate 10 ms / 30 ms, |D| = 20 ms every sample
+  for (int i = 0; i < 200; ++i) {
+    stats.Record(LinkProfile::kDefault, (i & 1) ? 30'000 : 10'000);
+  }
+  const RttSummary summary = stats.Get(LinkProfile::kDefault);
+  EXPECT_NEAR(20'000.0, static_cast<double>(summary.jitter_us), 500.0);
+  EXPECT_EQ(20'000U, summary.mean_us);
+}
+
+TEST(RttStatsTest, ProfileNames) {
+  EXPECT_STREQ("default", LinkProfileName(LinkProfile::kDefault));
+  EXPECT_STREQ("low_latency", LinkProfileName(LinkProfile::kLowLatency));
+}
+
+}  // namespace
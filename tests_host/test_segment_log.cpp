@@ -0,0 +1,228 @@
+/**
+ * @file test_segment_log.cpp
+ * @brief Unit tests for the flash timeline archive codec and segment ring
+ */
+
+#include "timeline/segment_log.hpp"
+#include "gtest/gtest.h"
+
+#include <cstring>
+#include <vector>
+
+using namespace timeline;
+
+namespace {
+
+/// RAM-backed flash: erased bytes read 0xFF like NOR flash
+class FakeFlash : public SegmentFlash {
+ public:
+  explicit FakeFlash(size_t slots) : data_(slots * kSegmentSize, 0xFF), slots_(slots) {}
+
+  size_t slot_count() const override { return slots_; }
+
+  bool Read(size_t slot, size_t offset, uint8_t* out, size_t size) override {
+    std::memcpy(out, &data_[slot * kSegmentSize + offset], size);
+    return true;
+  }
+
+  bool Write(size_t slot, const uint8_t* data, size_t size) override {
+    ++erase_counts[slot];
+    std::memset(&data_[slot * kSegmentSize], 0xFF, kSegmentSize);
+    std::memcpy(&data_[slot * kSegmentSize], data, size);
+    return true;
+  }
+
+  uint8_t* raw(size_t slot) { return &data_[slot * kSegmentSize]; }
+
+  std::vector<int> erase_counts = std::vector<int>(64, 0);
+
+ private:
+  std::vector<uint8_t> data_;
+  size_t slots_;
+};
+
+/// Fill one segment with events every step_us starting at start_us
+std::vector<uint8_t> MakeSegment(uint32_t sequence, uint16_t boot, int64_t start_us,
+                                 int64_t step_us, size_t events) {
+  std::vector<uint8_t> buffer(kSegmentSize);
+  SegmentEncoder encoder(buffer.data(), buffer.size());
+  for (size_t i = 0; i < events; ++i) {
+    EXPECT_TRUE(encoder.Add({start_us + static_cast<int64_t>(i) * step_us, EventType::kKeying,
+                             static_cast<uint32_t>(i % 2), static_cast<uint32_t>(i % 2)}));
+  }
+  buffer.resize(encoder.Finish(sequence, boot, 0));
+  return buffer;
+}
+
+TEST(SegmentLogTest, RoundTripsEventsIncludingBackwardsTimestamps) {
+  const std::vector<TimelineEvent> events = {
+      {5'000'000'000LL, EventType::kPaddleEdge, 1 | (2U << 8), 1},
+      {5'000'060'000LL, EventType::kDecodedChar, 'K', 0},
+      {5'000'059'000LL, EventType::kKeying, 0xFFFFFFFFU, 0},  // Logged out of order
+      {5'071'000'000LL, EventType::kFocus, 3, 0},
+  };
+  std::vector<uint8_t> buffer(kSegmentSize);
+  SegmentEncoder encoder(buffer.data(), buffer.size());
+  for (const auto& event : events) {
+    ASSERT_TRUE(encoder.Add(event));
+  }
+  const size_t length = encoder.Finish(42, 7, 3);
+
+  SegmentDecoder decoder(buffer.data(), length);
+  ASSERT_TRUE(decoder.valid());
+  EXPECT_EQ(42U, decoder.header().sequence);
+  EXPECT_EQ(7U, decoder.header().boot);
+  EXPECT_EQ(3U, decoder.header().lost);
+  EXPECT_EQ(5'000'000'000LL, decoder.header().min_us);
+  EXPECT_EQ(5'071'000'000LL, decoder.header().max_us);
+
+  TimelineEvent decoded{};
+  for (const auto& expected : events) {
+    ASSERT_TRUE(decoder.Next(&decoded));
+    EXPECT_EQ(expected.timestamp_us, decoded.timestamp_us);
+    EXPECT_EQ(expected.type, decoded.type);
+    EXPECT_EQ(expected.arg0, decoded.arg0);
+    EXPECT_EQ(expected.arg1, decoded.arg1);
+  }
+  EXPECT_FALSE(decoder.Next(&decoded));
+}
+
+TEST(SegmentLogTest, KeyingEventsCompressToAFewBytes) {
+  // 20 WPM dits: 60 ms gaps, small args
+  std::vector<uint8_t> buffer(kSegmentSize);
+  SegmentEncoder encoder(buffer.data(), buffer.size());
+  size_t count = 0;
+  while (encoder.Add({1'000'000LL + static_cast<int64_t>(count) * 60'000, EventType::kKeying,
+                      static_cast<uint32_t>(count % 2), static_cast<uint32_t>(count % 2)})) {
+    ++count;
+  }
+  EXPECT_GT(count, 600U);  // ~6 bytes per event vs 8 in RAM
+
+  SegmentDecoder decoder(buffer.data(), encoder.Finish(0, 0, 0));
+  size_t decoded = 0;
+  TimelineEvent event{};
+  while (decoder.Next(&event)) {
+    ++decoded;
+  }
+  EXPECT_EQ(count, decoded);
+}
+
+TEST(SegmentLogTest, RejectsErasedAndCorruptedSegments) {
+  std::vector<uint8_t> erased(kSegmentSize, 0xFF);
+  SegmentHeader header{};
+  EXPECT_FALSE(ParseSegmentHeader(erased.data(), erased.size(), &header));
+
+  auto segment = MakeSegment(1, 0, 0, 1'000, 10);
+  segment[kSegmentHeaderSize + 3] ^= 0x01;
+  EXPECT_FALSE(SegmentDecoder(segment.data(), segment.size()).valid());
+}
+
+TEST(SegmentLogTest, RingOverwritesOldestAndSpreadsWear) {
+  FakeFlash flash(4);
+  SegmentLog log;
+  ASSERT_TRUE(log.Mount(&flash));
+  EXPECT_EQ(0U, log.used_slots());
+  EXPECT_EQ(0U, log.current_boot());
+
+  for (uint32_t i = 0; i < 10; ++i) {
+    const auto segment = MakeSegment(log.next_sequence(), log.current_boot(),
+                                     static_cast<int64_t>(i) * 1'000'000, 1'000, 10);
+    ASSERT_TRUE(log.Append(segment.data(), segment.size()));
+  }
+  EXPECT_EQ(4U, log.used_slots());
+  EXPECT_EQ(10U, log.next_sequence());
+
+  std::vector<uint32_t> sequences;
+  log.ForEachSegment(true, 0, 0, 0, [&](size_t, const SegmentLog::Entry& entry) {
+    sequences.push_back(entry.sequence);
+    return true;
+  });
+  EXPECT_EQ((std::vector<uint32_t>{6, 7, 8, 9}), sequences);
+
+  for (size_t slot = 0; slot < 4; ++slot) {
+    EXPECT_GE(flash.erase_counts[slot], 2);
+    EXPECT_LE(flash.erase_counts[slot], 3);
+  }
+}
+
+TEST(SegmentLogTest, RemountRebuildsIndexAndStartsANewBoot) {
+  FakeFlash flash(8);
+  {
+    SegmentLog log;
+    ASSERT_TRUE(log.Mount(&flash));
+    for (uint32_t i = 0; i < 3; ++i) {
+      const auto segment = MakeSegment(log.next_sequence(), log.current_boot(),
+                                       static_cast<int64_t>(i) * 1'000'000, 1'000, 10);
+      ASSERT_TRUE(log.Append(segment.data(), segment.size()));
+    }
+  }
+
+  SegmentLog log;
+  ASSERT_TRUE(log.Mount(&flash));
+  EXPECT_EQ(3U, log.used_slots());
+  EXPECT_EQ(3U, log.next_sequence());
+  EXPECT_EQ(1U, log.current_boot());
+
+  // Same timestamps again in the new boot: time queries only see this boot
+  const auto segment = MakeSegment(log.next_sequence(), log.current_boot(), 0, 1'000, 10);
+  ASSERT_TRUE(log.Append(segment.data(), segment.size()));
+  size_t visited = 0;
+  log.ForEachSegment(false, log.current_boot(), 0, 5'000'000,
+                     [&](size_t slot, const SegmentLog::Entry& entry) {
+                       EXPECT_EQ(1U, entry.boot);
+                       std::vector<uint8_t> out(kSegmentSize);
+                       const size_t length = log.ReadSegment(slot, out.data());
+                       EXPECT_TRUE(SegmentDecoder(out.data(), length).valid());
+                       ++visited;
+                       return true;
+                     });
+  EXPECT_EQ(1U, visited);
+}
+
+TEST(SegmentLogTest, TimeRangeQuerySelectsOverlappingSegments) {
+  FakeFlash flash(8);
+  SegmentLog log;
+  ASSERT_TRUE(log.Mount(&flash));
+  for (uint32_t i = 0; i < 5; ++i) {
+    // Segment i covers [i s, i s + 9 ms]
+    const auto segment = MakeSegment(log.next_sequence(), log.current_boot(),
+                                     static_cast<int64_t>(i) * 1'000'000, 1'000, 10);
+    ASSERT_TRUE(log.Append(segment.data(), segment.size()));
+  }
+
+  std::vector<uint32_t> sequences;
+  log.ForEachSegment(false, 0, 1'005'000, 3'000'000, [&](size_t, const SegmentLog::Entry& entry) {
+    sequences.push_back(entry.sequence);
+    return true;
+  });
+  EXPECT_EQ((std::vector<uint32_t>{1, 2, 3}), sequences);
+}
+
+TEST(EventLoggerCopySinceTest, FollowsLoggerAndReportsOverwrittenEvents) {
+  EventLogger<8> logger;
+  size_t cursor = logger.pushed_count();
+  TimelineEvent out[4];
+  size_t lost = 0;
+
+  for (int64_t i = 0; i < 3; ++i) {
+    logger.push({i, EventType::kKeying, 0, 0});
+  }
+  ASSERT_EQ(3U, logger.copy_since(&cursor, out, 4, &lost));
+  EXPECT_EQ(0U, lost);
+  EXPECT_EQ(2, out[2].timestamp_us);
+  EXPECT_EQ(0U, logger.copy_since(&cursor, out, 4, &lost));
+
+  // 12 more pushes into an 8-event ring: the 4 oldest are gone before we read
+  for (int64_t i = 3; i < 15; ++i) {
+    logger.push({i, EventType::kKeying, 0, 0});
+  }
+  ASSERT_EQ(4U, logger.copy_since(&cursor, out, 4, &lost));
+  EXPECT_EQ(4U, lost);
+  EXPECT_EQ(7, out[0].timestamp_us);
+  ASSERT_EQ(4U, logger.copy_since(&cursor, out, 4, &lost));
+  EXPECT_EQ(0U, lost);
+  EXPECT_EQ(14, out[3].timestamp_us);
+  EXPECT_EQ(logger.pushed_count(), cursor);
+}
+
+}  // namespace
@@ -0,0 +1,144 @@
+/**
+ * @file test_task_topology.cpp
+ * @brief Unit tests for the task topology table and its placement rules
+ */
+
+#include "system_monitor/task_topology.hpp"
+
+#include <array>
+#include <cstring>
+#include <string>
+
+#include "gtest/gtest.h"
+
+using namespace system_monitor;
+
+namespace {
+
+// ESP-IDF default configMAX_PRIORITIES
+constexpr UBaseType_t kMaxPriorities = 25;
+
+std::array<TaskSpec, kTaskIdCount> CopyTable() {
+  std::array<TaskSpec, kTaskIdCount> specs{};
+  for (size_t i = 0; i < kTaskIdCount; ++i) {
+    specs[i] = TaskTopology()[i];
+  }
+  return specs;
+}
+
+TEST(TaskTopologyTest, FirmwareTableIsValid) {
+  TopologyIssue issues[4];
+  const size_t found = ValidateTaskTopology(TaskTopology(), kTaskIdCount, kMaxPriorities, issues, 4);
+  for (size_t i = 0; i < found && i < 4; ++i) {
+    char line[96];
+    FormatTopologyIssue(issues[i], line, sizeof(line));
+    ADD_FAILURE() << line;
+  }
+  EXPECT_EQ(found, 0u);
+
+  // Entries are in TaskId order and real-time tasks stay off the network core
+  for (size_t i = 0; i < kTaskIdCount; ++i) {
+    const TaskSpec& spec = TaskTopology()[i];
+    EXPECT_EQ(static_cast<size_t>(spec.id), i);
+    if (spec.task_class == TaskClass::kRealtime) {
+      EXPECT_EQ(spec.core, TaskSpecFor(TaskId::kMainLoop).core) << spec.name;
+      EXPECT_NE(spec.core, TaskSpecFor(TaskId::kWifi).core) << spec.name;
+    }
+  }
+}
+
+TEST(TaskTopologyTest, FlagsInversionCoreAndStack) {
+  auto specs = CopyTable();
+  // httpd moved next to the keying loop at the loop's priority
+  specs[static_cast<size_t>(TaskId::kHttpd)].core = 0;
+  specs[static_cast<size_t>(TaskId::kHttpd)].priority = 6;
+  specs[static_cast<size_t>(TaskId::kDnsServer)].core = 2;
+  specs[static_cast<size_t>(TaskId::kTimelineArchive)].stack_bytes = 1024;
+  specs[static_cast<size_t>(TaskId::kOtaWriter)].priority = kMaxPriorities;
+
+  TopologyIssue issues[16];
+  const size_t found = ValidateTaskTopology(specs.data(), specs.size(), kMaxPriorities, issues, 16);
+  ASSERT_LE(found, 16u);
+
+  size_t inversions = 0;
+  bool bad_core = false;
+  bool small_stack = false;
+  bool bad_priority = false;
+  for (size_t i = 0; i < found; ++i) {
+    switch (issues[i].kind) {
+      case TopologyIssueKind::kPriorityInversion:
+        EXPECT_EQ(issues[i].other, TaskId::kHttpd);
+        ++inversions;
+        break;
+      case TopologyIssueKind::kBadCore:
+        bad_core = issues[i].task == TaskId::kDnsServer;
+        break;
+      case TopologyIssueKind::kSmallStack:
+        small_stack = issues[i].task == TaskId::kTimelineArchive;
+        break;
+      case TopologyIssueKind::kBadPriority:
+        bad_priority = issues[i].task == TaskId::kOtaWriter;
+        break;
+      case TopologyIssueKind::kRealtimeOrder:
+        ADD_FAILURE() << "real-time ranks were not changed";
+        break;
+    }
+  }
+  // Only main is not above priority 6 on core 0
+  EXPECT_EQ(inversions, 1u);
+  EXPECT_TRUE(bad_core);
+  EXPECT_TRUE(small_stack);
+  EXPECT_TRUE(bad_priority);
+}
+
+TEST(TaskTopologyTest, UnpinnedTaskSharesEveryCore) {
+  auto specs = CopyTable();
+  specs[static_cast<size_t>(TaskId::kSerialConsole)].core = kAnyCore;
+  specs[static_cast<size_t>(TaskId::kSerialConsole)].priority = 7;
+
+  TopologyIssue issues[8];
+  const size_t found = ValidateTaskTopology(specs.data(), specs.size(), kMaxPriorities, issues, 8);
+  // Priority 7 console may run on core 0: main (6) and usb_hid (7) are not above it
+  ASSERT_EQ(found, 2u);
+  EXPECT_EQ(issues[0].kind, TopologyIssueKind::kPriorityInversion);
+  EXPECT_EQ(issues[0].task, TaskId::kMainLoop);
+  EXPECT_EQ(issues[0].other, TaskId::kSerialConsole);
+  EXPECT_EQ(issues[1].task, TaskId::kUsbHid);
+
+  char line[96];
+  FormatTopologyIssue(issues[0], line, sizeof(line));
+  EXPECT_NE(std::string(line).find("main"), std::string::npos);
+  EXPECT_NE(std::string(line).find("serial_console"), std::string::npos);
+}
+
+TEST(TaskTopologyTest, RealtimeTasksRankedOnSharedCore) {
+  auto specs = CopyTable();
+  // Sidetone at the keying loop's priority: the loop's non-keying stages delay the refill
+  specs[static_cast<size_t>(TaskId::kSidetone)].priority = 6;
+  // Ranks only apply on a shared core
+  specs[static_cast<size_t>(TaskId::kUsbHid)].core = 1;
+
+  TopologyIssue issues[8];
+  const size_t found = ValidateTaskTopology(specs.data(), specs.size(), kMaxPriorities, issues, 8);
+  ASSERT_EQ(found, 1u);
+  EXPECT_EQ(issues[0].kind, TopologyIssueKind::kRealtimeOrder);
+  EXPECT_EQ(issues[0].task, TaskId::kSidetone);
+  EXPECT_EQ(issues[0].other, TaskId::kMainLoop);
+
+  char line[96];
+  FormatTopologyIssue(issues[0], line, sizeof(line));
+  EXPECT_NE(std::string(line).find("sidetone_loop"), std::string::npos);
+  EXPECT_NE(std::string(line).find("main"), std::string::npos);
+}
+
+TEST(TaskTopologyTest, LookupByName) {
+  const TaskSpec* spec = FindTaskSpec("tl_archive");
+  ASSERT_NE(spec, nullptr);
+  EXPECT_EQ(spec->id, TaskId::kTimelineArchive);
+  EXPECT_EQ(spec, &TaskSpecFor(TaskId::kTimelineArchive));
+  EXPECT_EQ(FindTaskSpec("IDLE0"), nullptr);
+  EXPECT_EQ(FindTaskSpec(nullptr), nullptr);
+  EXPECT_STREQ(TaskClassName(TaskSpecFor(TaskId::kSidetone).task_class), "realtime");
+}
+
+}  // namespace
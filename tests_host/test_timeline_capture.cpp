@@ -0,0 +1,114 @@
+/**
+ * @file test_timeline_capture.cpp
+ * @brief Unit tests for trigger-based timeline snapshots
+ */
+
+#include "timeline/timeline_capture.hpp"
+#include "gtest/gtest.h"
+
+#include <vector>
+
+using namespace timeline;
+
+namespace {
+
+/// One keying event every 10 ms from 0 to 9.99 s
+void FillLogger(EventLogger<kTimelineCapacity>* logger) {
+  for (int64_t i = 0; i < 1000; ++i) {
+    logger->push({i * 10'000, EventType::kKeying, 0, static_cast<uint32_t>(i & 1)});
+  }
+}
+
+std::vector<TimelineEvent> Decode(const TimelineCapture& capture, uint32_t id) {
+  std::vector<uint8_t> buffer(kSegmentSize);
+  CaptureInfo info;
+  const size_t length = capture.Read(id, buffer.data(), &info);
+  std::vector<TimelineEvent> events;
+  SegmentDecoder decoder(buffer.data(), length);
+  TimelineEvent event{};
+  while (decoder.Next(&event)) {
+    events.push_back(event);
+  }
+  return events;
+}
+
+TEST(TimelineCaptureTest, FreezesPreAndPostWindowAfterPostElapsed) {
+  EventLogger<kTimelineCapacity> logger;
+  FillLogger(&logger);
+  TimelineCapture capture;
+  capture.Configure({CaptureTriggerBit(CaptureTrigger::kLateElement), 1000, 500});
+
+  ASSERT_TRUE(capture.Trigger(CaptureTrigger::kLateElement, 5'000'000));
+  EXPECT_FALSE(capture.Poll(logger, 5'400'000));  // Post window still open
+  EXPECT_TRUE(capture.pending());
+  ASSERT_TRUE(capture.Poll(logger, 5'500'000));
+  EXPECT_FALSE(capture.pending());
+
+  CaptureInfo list[kMaxCaptures];
+  ASSERT_EQ(1U, capture.List(list, kMaxCaptures));
+  EXPECT_EQ(CaptureTrigger::kLateElement, list[0].trigger);
+  EXPECT_EQ(5'000'000, list[0].trigger_us);
+  EXPECT_EQ(151U, list[0].events);  // 4.0 s .. 5.5 s inclusive
+  EXPECT_FALSE(list[0].truncated);
+
+  const auto events = Decode(capture, list[0].id);
+  ASSERT_EQ(151U, events.size());
+  EXPECT_EQ(4'000'000, events.front().timestamp_us);
+  EXPECT_EQ(5'500'000, events.back().timestamp_us);
+}
+
+TEST(TimelineCaptureTest, DisabledTriggersAreIgnoredButManualAlwaysWorks) {
+  TimelineCapture capture;
+  capture.Configure({CaptureTriggerBit(CaptureTrigger::kAudioUnderrun), 100, 100});
+  EXPECT_FALSE(capture.Trigger(CaptureTrigger::kLateElement, 1'000));
+  EXPECT_FALSE(capture.Trigger(CaptureTrigger::kIsrQueueOverflow, 1'000));
+  EXPECT_TRUE(capture.Trigger(CaptureTrigger::kManual, 1'000));
+  // One capture at a time: the next enabled trigger is counted as missed
+  EXPECT_FALSE(capture.Trigger(CaptureTrigger::kAudioUnderrun, 2'000));
+  EXPECT_EQ(1U, capture.missed_triggers());
+}
+
+TEST(TimelineCaptureTest, KeepsTheLastCapturesAndClampsTheWindow) {
+  EventLogger<kTimelineCapacity> logger;
+  FillLogger(&logger);
+  TimelineCapture capture;
+  capture.Configure({0, 50'000, 50'000});
+  EXPECT_EQ(kCaptureMaxWindowMs, capture.config().pre_ms);
+  EXPECT_EQ(0U, capture.config().post_ms);
+
+  capture.Configure({0, 20, 20});
+  for (int64_t i = 1; i <= 6; ++i) {
+    ASSERT_TRUE(capture.Trigger(CaptureTrigger::kManual, i * 1'000'000));
+    ASSERT_TRUE(capture.Poll(logger, i * 1'000'000 + 20'000));
+  }
+  CaptureInfo list[kMaxCaptures];
+  ASSERT_EQ(kMaxCaptures, capture.List(list, kMaxCaptures));
+  EXPECT_EQ(3U, list[0].id);
+  EXPECT_EQ(6U, list[kMaxCaptures - 1].id);
+  EXPECT_EQ(5U, list[0].events);  // 2.98 .. 3.02 s
+
+  std::vector<uint8_t> buffer(kSegmentSize);
+  CaptureInfo info;
+  EXPECT_EQ(0U, capture.Read(1, buffer.data(), &info));
+  EXPECT_EQ(0U, info.id);
+
+  capture.Clear();
+  EXPECT_EQ(0U, capture.List(list, kMaxCaptures));
+}
+
+TEST(TimelineCaptureTest, WindowBeyondOneSegmentIsTruncated) {
+  EventLogger<kTimelineCapacity> logger;
+  for (int64_t i = 0; i < 3000; ++i) {
+    logger.push({i * 1'000, EventType::kDiagnostics, 0xFFFFFFFFU, 0xFFFFFFFFU});
+  }
+  TimelineCapture capture;
+  capture.Configure({0, 2000, 0});
+  ASSERT_TRUE(capture.Trigger(CaptureTrigger::kManual, 2'999'000));
+  ASSERT_TRUE(capture.Poll(logger, 2'999'000));
+  CaptureInfo list[1];
+  ASSERT_EQ(1U, capture.List(list, 1));
+  EXPECT_TRUE(list[0].truncated);
+  EXPECT_EQ(list[0].events, Decode(capture, list[0].id).size());
+}
+
+}  // namespace
@@ -0,0 +1,87 @@
+/**
+ * @file test_timeline_feed.cpp
+ * @brief Unit tests for the binary timeline feed encoder
+ */
+
+#include "timeline/timeline_feed.hpp"
+#include "gtest/gtest.h"
+
+#include <vector>
+
+using namespace timeline;
+
+namespace {
+
+uint32_t GetU32(const uint8_t* in) {
+  return static_cast<uint32_t>(in[0]) | static_cast<uint32_t>(in[1]) << 8 |
+         static_cast<uint32_t>(in[2]) << 16 | static_cast<uint32_t>(in[3]) << 24;
+}
+
+uint16_t GetU16(const uint8_t* in) {
+  return static_cast<uint16_t>(in[0] | in[1] << 8);
+}
+
+int64_t GetI64(const uint8_t* in) {
+  return static_cast<int64_t>(static_cast<uint64_t>(GetU32(in)) |
+                              static_cast<uint64_t>(GetU32(in + 4)) << 32);
+}
+
+TEST(TimelineFeedTest, EncodesHeaderAndRecords) {
+  std::vector<uint8_t> page(FeedPageSize(4));
+  FeedWriter writer(page.data(), page.size());
+  ASSERT_TRUE(writer.Add({5'000'000'000LL, EventType::kPaddleEdge, 1, 1}));
+  ASSERT_TRUE(writer.Add({5'000'060'000LL, EventType::kDecodedChar, 'K', 2}));
+  const size_t length = writer.Finish(5'000'100'000LL, 7);
+
+  ASSERT_EQ(FeedPageSize(2), length);
+  EXPECT_EQ(kFeedMagic, GetU32(&page[0]));
+  EXPECT_EQ(kFeedVersion, GetU16(&page[4]));
+  EXPECT_EQ(2U, GetU16(&page[6]));
+  EXPECT_EQ(5'000'000'000LL, GetI64(&page[8]));
+  EXPECT_EQ(5'000'100'000LL, GetI64(&page[16]));
+  EXPECT_EQ(7U, GetU32(&page[24]));
+
+  const uint8_t* second = &page[kFeedHeaderSize + kFeedRecordSize];
+  EXPECT_EQ(60'000U, GetU32(second));
+  EXPECT_EQ(static_cast<uint8_t>(EventType::kDecodedChar), second[4]);
+  EXPECT_EQ(2U, second[5]);
+  EXPECT_EQ(static_cast<uint16_t>('K'), GetU16(second + 6));
+}
+
+TEST(TimelineFeedTest, StopsWhenBufferIsFull) {
+  std::vector<uint8_t> page(FeedPageSize(2));
+  FeedWriter writer(page.data(), page.size());
+  EXPECT_TRUE(writer.Add({1, EventType::kKeying, 0, 1}));
+  EXPECT_TRUE(writer.Add({2, EventType::kKeying, 0, 0}));
+  EXPECT_FALSE(writer.Add({3, EventType::kKeying, 0, 1}));
+  EXPECT_TRUE(writer.full());
+  EXPECT_EQ(FeedPageSize(2), writer.Finish(10, 0));
+}
+
+TEST(TimelineFeedTest, EndsPageBeyondDeltaRange) {
+  std::vector<uint8_t> page(FeedPageSize(4));
+  FeedWriter writer(page.data(), page.size());
+  EXPECT_TRUE(writer.Add({1'000, EventType::kKeying, 0, 1}));
+  EXPECT_FALSE(writer.Add({1'000 + (int64_t{1} << 32), EventType::kKeying, 0, 0}));
+  // Later events are refused too, so the page stays an ordered prefix
+  EXPECT_FALSE(writer.Add({2'000, EventType::kKeying, 0, 0}));
+  EXPECT_EQ(1U, writer.count());
+}
+
+TEST(TimelineFeedTest, ClampsWideArguments) {
+  std::vector<uint8_t> page(FeedPageSize(1));
+  FeedWriter writer(page.data(), page.size());
+  writer.Add({0, EventType::kDiagnostics, 100'000, 300});
+  writer.Finish(0, 0);
+  EXPECT_EQ(0xFFFF, GetU16(&page[kFeedHeaderSize + 6]));
+  EXPECT_EQ(0xFF, page[kFeedHeaderSize + 5]);
+}
+
+TEST(TimelineFeedTest, TooSmallBufferProducesNothing) {
+  uint8_t page[kFeedHeaderSize - 1];
+  FeedWriter writer(page, sizeof(page));
+  EXPECT_FALSE(writer.Add({0, EventType::kKeying, 0, 1}));
+  EXPECT_EQ(0U, writer.Finish(0, 0));
+}
+
+}  // namespace
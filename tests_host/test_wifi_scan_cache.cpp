@@ -0,0 +1,109 @@
+/**
+ * @file test_wifi_scan_cache.cpp
+ * @brief Unit tests for the background WiFi scan cache and its refresh policy
+ */
+
+#include "wifi_subsystem/wifi_scan_cache.hpp"
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using namespace wifi_subsystem;
+
+namespace {
+
+WifiScanEntry Entry(const char* ssid, int8_t rssi, uint8_t channel = 6) {
+  WifiScanEntry entry;
+  std::snprintf(entry.ssid, sizeof(entry.ssid), "%s", ssid);
+  entry.rssi = rssi;
+  entry.channel = channel;
+  return entry;
+}
+
+TEST(WifiScanCacheTest, CompleteDedupesFiltersAndSortsByRssi) {
+  WifiScanCache cache;
+  const std::vector<WifiScanEntry> raw = {
+      Entry("home", -70), Entry("", -30), Entry("shack", -50), Entry("home", -45),
+      Entry("five_ghz", -40, 36), Entry("club", -80),
+  };
+  cache.Complete(raw.data(), raw.size(), 1000);
+
+  WifiScanEntry out[kMaxScanResults];
+  WifiScanSnapshot info;
+  ASSERT_EQ(3U, cache.Snapshot(out, kMaxScanResults, 3500, &info));
+  EXPECT_STREQ("home", out[0].ssid);
+  EXPECT_EQ(-45, out[0].rssi);
+  EXPECT_STREQ("shack", out[1].ssid);
+  EXPECT_STREQ("club", out[2].ssid);
+  EXPECT_EQ(2500U, info.age_ms);
+  EXPECT_EQ(1U, info.scans);
+}
+
+TEST(WifiScanCacheTest, KeepsTheStrongestNetworksWhenFull) {
+  WifiScanCache cache;
+  std::vector<WifiScanEntry> raw;
+  char ssid[16];
+  for (int i = 0; i < 30; ++i) {
+    std::snprintf(ssid, sizeof(ssid), "net%02d", i);
+    raw.push_back(Entry(ssid, static_cast<int8_t>(-90 + i)));
+  }
+  cache.Complete(raw.data(), raw.size(), 0);
+
+  WifiScanEntry out[kMaxScanResults];
+  ASSERT_EQ(kMaxScanResults, cache.Snapshot(out, kMaxScanResults, 0, nullptr));
+  EXPECT_STREQ("net29", out[0].ssid);
+  EXPECT_EQ(-80, out[kMaxScanResults - 1].rssi);
+}
+
+TEST(WifiScanCacheTest, OnDemandScansAreRateLimited) {
+  WifiScanCache cache({60000, 15000, 120000});
+  EXPECT_FALSE(cache.ShouldStart(0, false));  // Nobody asked
+
+  WifiScanSnapshot info;
+  WifiScanEntry out[kMaxScanResults];
+  cache.Snapshot(out, kMaxScanResults, 0, &info);
+  EXPECT_EQ(kScanAgeNever, info.age_ms);
+
+  cache.Request(100);
+  ASSERT_TRUE(cache.ShouldStart(100, false));
+  EXPECT_FALSE(cache.ShouldStart(200, false));  // Already running
+  cache.Complete(nullptr, 0, 3100);
+
+  cache.Request(5000);  // Fresh results: served from the cache
+  EXPECT_FALSE(cache.ShouldStart(5000, false));
+  cache.Request(19000);  // Older than min_interval_ms: scan again
+  EXPECT_TRUE(cache.ShouldStart(19000, false));
+}
+
+TEST(WifiScanCacheTest, RefreshesPeriodicallyOnlyWhileInterested) {
+  WifiScanCache cache({60000, 15000, 120000});
+  cache.Request(0);
+  ASSERT_TRUE(cache.ShouldStart(0, false));
+  cache.Complete(nullptr, 0, 3000);
+
+  EXPECT_FALSE(cache.ShouldStart(62000, false));
+  ASSERT_TRUE(cache.ShouldStart(63000, false));
+  cache.Complete(nullptr, 0, 66000);
+  // Interest expired at 120 s: results age without further scans
+  EXPECT_FALSE(cache.Interested(120000));
+  EXPECT_FALSE(cache.ShouldStart(200000, false));
+}
+
+TEST(WifiScanCacheTest, SuppressionDefersThePendingRequest) {
+  WifiScanCache cache;
+  cache.Request(0);
+  EXPECT_FALSE(cache.ShouldStart(0, true));
+  WifiScanSnapshot info;
+  WifiScanEntry out[1];
+  cache.Snapshot(out, 1, 0, &info);
+  EXPECT_TRUE(info.suppressed);
+  EXPECT_FALSE(info.scanning);
+
+  EXPECT_TRUE(cache.ShouldStart(500000, false));  // Session over, interest long gone
+  cache.Abort();
+  EXPECT_FALSE(cache.scanning());
+}
+
+}  // namespace
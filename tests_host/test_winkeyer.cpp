@@ -0,0 +1,282 @@
+/**
+ * @file test_winkeyer.cpp
+ * @brief Unit tests for the WinKeyer 3 protocol emulation (parser, buffer, timing, status)
+ */
+
+#include "winkeyer/winkeyer.hpp"
+#include "winkeyer/winkeyer_port.hpp"
+#include "gtest/gtest.h"
+
+#include "../support/fake_esp_idf.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace winkeyer;
+
+namespace {
+
+constexpr int64_t kDit20WpmUs = 60000;
+
+void Send(WinKeyer& wk, std::vector<uint8_t> bytes, int64_t now_us = 0) {
+  wk.Feed(bytes.data(), bytes.size(), now_us);
+}
+
+void SendText(WinKeyer& wk, const std::string& text, int64_t now_us = 0) {
+  wk.Feed(reinterpret_cast<const uint8_t*>(text.data()), text.size(), now_us);
+}
+
+std::vector<uint8_t> Drain(WinKeyer& wk) {
+  uint8_t out[kOutputQueueSize];
+  const size_t count = wk.ReadOutput(out, sizeof(out));
+  return std::vector<uint8_t>(out, out + count);
+}
+
+/// Echoed characters among the host-bound bytes (status and pot reports dropped)
+std::string Echo(const std::vector<uint8_t>& bytes) {
+  std::string text;
+  for (uint8_t byte : bytes) {
+    if (byte < 0x80) {
+      text.push_back(static_cast<char>(byte));
+    }
+  }
+  return text;
+}
+
+/// Run the scheduler in 1 ms ticks until it goes idle
+std::vector<WinKeyer::Edge> RunUntilIdle(WinKeyer& wk, int64_t start_us, std::string* echo = nullptr) {
+  std::vector<WinKeyer::Edge> edges;
+  WinKeyer::Edge edge;
+  for (int64_t now = start_us; now < start_us + 20 * 1000000LL; now += 1000) {
+    while (wk.PopDue(now, &edge)) {
+      edges.push_back(edge);
+    }
+    if (echo != nullptr) {
+      *echo += Echo(Drain(wk));
+    }
+    if ((wk.status() & kStatusBusy) == 0) {
+      break;
+    }
+  }
+  return edges;
+}
+
+WinKeyer& OpenAt20Wpm(WinKeyer& wk) {
+  Send(wk, {0x00, 0x02});  // Host open
+  Send(wk, {0x02, 20});    // 20 WPM
+  Drain(wk);
+  return wk;
+}
+
+TEST(WinKeyerTest, HostOpenReportsVersionAndGatesText) {
+  WinKeyer wk;
+  SendText(wk, "CQ");
+  EXPECT_EQ(0U, wk.buffered());  // Host closed: text ignored
+
+  Send(wk, {0x00, 0x04, 0x5A});  // Admin echo works without a session
+  Send(wk, {0x00, 0x02});
+  EXPECT_EQ((std::vector<uint8_t>{0x5A, kWinKeyerVersion}), Drain(wk));
+  EXPECT_TRUE(wk.host_open());
+
+  // A command split across reads is resumed
+  Send(wk, {0x02});
+  Send(wk, {25});
+  EXPECT_EQ(25, wk.effective_speed());
+
+  SendText(wk, "CQ");
+  EXPECT_EQ(2U, wk.buffered());
+  EXPECT_EQ((std::vector<uint8_t>{0xC0 | kStatusBusy}), Drain(wk));
+
+  Send(wk, {0x00, 0x03});  // Host close flushes
+  EXPECT_FALSE(wk.host_open());
+  EXPECT_EQ(0U, wk.buffered());
+}
+
+TEST(WinKeyerTest, OutputIsKeptUntilConsumed) {
+  WinKeyer wk;
+  Send(wk, {0x00, 0x04, 0x11});
+  Send(wk, {0x00, 0x04, 0x22});
+  Send(wk, {0x00, 0x04, 0x33});
+
+  // A transport that accepts one byte: the rest stays queued in order
+  uint8_t out[4];
+  ASSERT_EQ(3U, wk.PeekOutput(out, sizeof(out)));
+  wk.ConsumeOutput(1);
+  ASSERT_EQ(2U, wk.PeekOutput(out, sizeof(out)));
+  EXPECT_EQ(0x22, out[0]);
+  wk.ConsumeOutput(0);
+  EXPECT_EQ((std::vector<uint8_t>{0x22, 0x33}), Drain(wk));
+  wk.ConsumeOutput(5);  // More than pending: ignored past the end
+  EXPECT_TRUE(Drain(wk).empty());
+}
+
+TEST(WinKeyerTest, KeysWithPerElementTimingAndEchoesOnRelease) {
+  WinKeyer wk;
+  OpenAt20Wpm(wk);
+  SendText(wk, "A E", 1000);
+  Drain(wk);
+
+  std::string echo;
+  const std::vector<WinKeyer::Edge> edges = RunUntilIdle(wk, 1000, &echo);
+  ASSERT_EQ(6U, edges.size());
+  // A: dit, element space, dah
+  EXPECT_TRUE(edges[0].key_active);
+  EXPECT_EQ(1000, edges[0].timestamp_us);
+  EXPECT_EQ(1000 + kDit20WpmUs, edges[1].timestamp_us);
+  EXPECT_EQ(1000 + 2 * kDit20WpmUs, edges[2].timestamp_us);
+  EXPECT_EQ(1000 + 5 * kDit20WpmUs, edges[3].timestamp_us);
+  // Word space: 7 dits from the end of A to E
+  EXPECT_EQ(1000 + 12 * kDit20WpmUs, edges[4].timestamp_us);
+  EXPECT_EQ(1000 + 13 * kDit20WpmUs, edges[5].timestamp_us);
+  EXPECT_EQ("A E", echo);
+  EXPECT_FALSE(wk.key_down());
+}
+
+TEST(WinKeyerTest, EchoWaitsForTheLastElement) {
+  WinKeyer wk;
+  OpenAt20Wpm(wk);
+  SendText(wk, "T");
+  Drain(wk);
+
+  WinKeyer::Edge edge;
+  ASSERT_TRUE(wk.PopDue(0, &edge));
+  EXPECT_FALSE(wk.PopDue(3 * kDit20WpmUs - 1, &edge));
+  EXPECT_EQ("", Echo(Drain(wk)));
+  ASSERT_TRUE(wk.PopDue(3 * kDit20WpmUs, &edge));
+  EXPECT_FALSE(edge.key_active);
+  EXPECT_EQ("T", Echo(Drain(wk)));
+  // Busy until the character space has run out
+  EXPECT_NE(0, wk.status() & kStatusBusy);
+  EXPECT_FALSE(wk.PopDue(6 * kDit20WpmUs, &edge));
+  EXPECT_EQ(0, wk.status() & kStatusBusy);
+}
+
+TEST(WinKeyerTest, PointerCommandsEditTheUnsentBuffer) {
+  WinKeyer wk;
+  OpenAt20Wpm(wk);
+  Send(wk, {0x06, 0x01});  // Pause while the host edits
+  Send(wk, {0x16, 0x00});
+  SendText(wk, "ABC");
+  Send(wk, {0x16, 0x01, 0x01});  // Overwrite at position 1
+  SendText(wk, "X");
+  Send(wk, {0x16, 0x02, 0x03});  // Insert at the end
+  Send(wk, {0x16, 0x03, 0x02});  // Two placeholders
+  SendText(wk, "D");
+  Send(wk, {0x08});              // Backspace removes D again
+  Send(wk, {0x1B, 'S', 'K'});    // Merged prosign
+  Send(wk, {0x06, 0x00});
+  Drain(wk);
+
+  std::string echo;
+  RunUntilIdle(wk, 0, &echo);
+  EXPECT_EQ("AXCSK", echo);
+}
+
+TEST(WinKeyerTest, XoffHasHysteresis) {
+  WinKeyer wk;
+  OpenAt20Wpm(wk);
+  Send(wk, {0x06, 0x01});
+  SendText(wk, std::string(90, 'E'));
+  EXPECT_NE(0, wk.status() & kStatusXoff);
+  Send(wk, {0x06, 0x00});
+
+  WinKeyer::Edge edge;
+  int64_t now = 0;
+  while (wk.buffered() >= kInputBufferSize / 3) {
+    EXPECT_NE(0, wk.status() & kStatusXoff);  // Still above the low mark
+    while (wk.PopDue(now, &edge)) {
+    }
+    now += 1000;
+  }
+  while (wk.PopDue(now, &edge)) {
+  }
+  EXPECT_EQ(0, wk.status() & kStatusXoff);
+}
+
+TEST(WinKeyerTest, PaddleBreakinFlushesAndCutsTheCharacter) {
+  WinKeyer wk;
+  OpenAt20Wpm(wk);
+  SendText(wk, "TEST");
+  Drain(wk);
+
+  WinKeyer::Edge edge;
+  ASSERT_TRUE(wk.PopDue(0, &edge));
+  ASSERT_TRUE(edge.key_active);
+  wk.OnPaddlePress(50000);
+  EXPECT_EQ(0U, wk.buffered());
+  EXPECT_EQ(0xC0 | kStatusBreakin, Drain(wk).back());
+
+  ASSERT_TRUE(wk.PopDue(50000, &edge));
+  EXPECT_FALSE(edge.key_active);
+  EXPECT_EQ(50000, edge.timestamp_us);
+
+  // Host text waits until the paddle has been idle for a word space
+  SendText(wk, "E", 60000);
+  EXPECT_FALSE(wk.PopDue(60000, &edge));
+  ASSERT_TRUE(wk.PopDue(50000 + 7 * kDit20WpmUs, &edge));
+  EXPECT_TRUE(edge.key_active);
+  EXPECT_EQ(0, wk.status() & kStatusBreakin);
+}
+
+TEST(WinKeyerPortTest, PaddlePressDuringAMarkLeavesThePaddleElementKeyed) {
+  fake_cdc_reset();
+  constexpr int kCdcPort = 1;
+  // Keyed output as KeyingSubsystem drives it: the latest edge from any source wins
+  bool keyed = false;
+  std::vector<WinKeyer::Edge> host_edges;
+  WinKeyerPort port(kCdcPort, [&](bool key_active, int64_t timestamp_us) {
+    host_edges.push_back({key_active, timestamp_us});
+    keyed = key_active;
+  });
+  port.SetEnabled(true, 0);
+  fake_cdc_host_write(kCdcPort, {0x00, 0x02, 0x02, 20, 'T'});  // Open, 20 WPM, one dah
+  port.Tick(0, 20);
+  ASSERT_TRUE(keyed);
+
+  // Main loop order on a paddle press mid-dah: DrainPaddleEvents() runs the
+  // break-in, then the engine keys the paddle element
+  const int64_t press_us = kDit20WpmUs;
+  port.OnPaddlePress(press_us);
+  EXPECT_FALSE(keyed);
+  keyed = true;
+
+  // The rest of this loop pass and the following ones leave the element alone
+  for (int64_t now = press_us; now <= press_us + kDit20WpmUs; now += 1000) {
+    port.Tick(now, 20);
+    ASSERT_TRUE(keyed) << "host key-up at " << now;
+  }
+  ASSERT_EQ(2U, host_edges.size());
+  EXPECT_FALSE(host_edges[1].key_active);
+  EXPECT_EQ(press_us, host_edges[1].timestamp_us);
+  EXPECT_NE(0U, port.protocol().status() & kStatusBreakin);
+  fake_cdc_reset();
+}
+
+TEST(WinKeyerTest, SpeedPotAndBufferedSpeed) {
+  WinKeyer wk;
+  Send(wk, {0x00, 0x02});
+  Send(wk, {0x05, 10, 25, 0});  // Pot 10-35 WPM
+  Send(wk, {0x02, 0});          // Follow the pot
+  Drain(wk);
+
+  wk.SetPotSpeed(22);
+  EXPECT_EQ((std::vector<uint8_t>{0x80 | 12}), Drain(wk));
+  wk.SetPotSpeed(22);
+  EXPECT_TRUE(Drain(wk).empty());  // Reported on change only
+  wk.SetPotSpeed(50);
+  EXPECT_EQ((std::vector<uint8_t>{0x80 | 25}), Drain(wk));
+  EXPECT_EQ(50, wk.effective_speed());
+
+  // Buffered speed applies to the characters after it, then lapses
+  Send(wk, {0x02, 20});
+  Send(wk, {0x1C, 40});
+  SendText(wk, "E");
+  WinKeyer::Edge edge;
+  ASSERT_TRUE(wk.PopDue(0, &edge));
+  ASSERT_TRUE(wk.PopDue(30000, &edge));  // 40 WPM dit
+  EXPECT_EQ(30000, edge.timestamp_us);
+  RunUntilIdle(wk, 30000);
+  EXPECT_EQ(20, wk.effective_speed());
+}
+
+}  // namespace
@@ -0,0 +1,62 @@
+#!/usr/bin/env python3
+"""Compare two host_benchmarks JSON reports (e.g. previous and current firmware release).
+
+    host_benchmarks --benchmark_out=new.json --benchmark_out_format=json
+    tools/compare_benchmarks.py old.json new.json [--threshold 10]
+
+Prints the CPU time of every benchmark present in both runs and the relative change.
+Exits non-zero when any benchmark got slower than --threshold percent. Host timings
+track relative cost only; they are not a substitute for on-target measurements.
+"""
+
+from __future__ import annotations
+
+import argparse
+import json
+import sys
+from pathlib import Path
+from typing import Dict
+
+
+def load_cpu_times(path: Path) -> Dict[str, float]:
+    report = json.loads(path.read_text())
+    times = {}
+    for bench in report.get("benchmarks", []):
+        # Skip aggregate rows (mean/median/stddev) of --benchmark_repetitions runs
+        if bench.get("run_type", "iteration") != "iteration":
+            continue
+        times[bench["name"]] = float(bench["cpu_time"])
+    return times
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Diff two google-benchmark JSON reports")
+    parser.add_argument("baseline", type=Path)
+    parser.add_argument("current", type=Path)
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="regression threshold in percent (default 10)")
+    args = parser.parse_args()
+
+    baseline = load_cpu_times(args.baseline)
+    current = load_cpu_times(args.current)
+
+    regressions = 0
+    print(f"{'benchmark':<44} {'base ns':>11} {'curr ns':>11} {'change':>8}")
+    for name in sorted(baseline.keys() | current.keys()):
+        if name not in baseline or name not in current:
+            side = "new" if name in current else "removed"
+            print(f"{name:<44} {'':>11} {'':>11} {side:>8}")
+            continue
+        base, curr = baseline[name], current[name]
+        change = (curr - base) / base * 100.0 if base > 0 else 0.0
+        flag = ""
+        if change > args.threshold:
+            flag = "  SLOWER"
+            regressions += 1
+        print(f"{name:<44} {base:>11.1f} {curr:>11.1f} {change:>+7.1f}%{flag}")
+
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,116 @@
+/**
+ * @file decoder_replay_main.cpp
+ * @brief Command-line front end of the decoder replay harness
+ *
+ * Usage:
+ *   decoder_replay [--beam|--both] [--tick-us N] [-v] [--log] <fixture.txt|directory>...
+ *
+ * Prints one line per fixture and mode (CER, latency, throughput) and exits with
+ * status 1 if any fixture exceeds its max_cer budget, so it can gate CI runs.
+ * Firmware ESP_LOGx output (stdout on host) is discarded unless --log is given.
+ */
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "decoder_replay.hpp"
+
+namespace {
+
+void PrintUsage() {
+  std::printf(
+      "Usage: decoder_replay [--beam|--both] [--tick-us N] [-v] [--log] <fixture|directory>...\n"
+      "  --beam      replay with beam-search decoding (default: greedy)\n"
+      "  --both      replay every fixture in both modes\n"
+      "  --tick-us   MorseDecoder::Tick() period on the simulated clock (default 10000)\n"
+      "  -v          print decoded text next to the reference\n"
+      "  --log       keep firmware log output\n");
+}
+
+const char* ModeName(morse_decoder::DecodingMode mode) {
+  return mode == morse_decoder::DecodingMode::kBeam ? "beam" : "greedy";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::vector<morse_decoder::DecodingMode> modes = {morse_decoder::DecodingMode::kGreedy};
+  decoder_replay::ReplayOptions options;
+  bool verbose = false;
+  bool keep_log = false;
+  std::vector<std::string> paths;
+
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--beam") == 0) {
+      modes = {morse_decoder::DecodingMode::kBeam};
+    } else if (std::strcmp(argv[i], "--both") == 0) {
+      modes = {morse_decoder::DecodingMode::kGreedy, morse_decoder::DecodingMode::kBeam};
+    } else if (std::strcmp(argv[i], "--tick-us") == 0 && i + 1 < argc) {
+      options.tick_interval_us = std::strtoll(argv[++i], nullptr, 10);
+    } else if (std::strcmp(argv[i], "-v") == 0) {
+      verbose = true;
+    } else if (std::strcmp(argv[i], "--log") == 0) {
+      keep_log = true;
+    } else if (argv[i][0] == '-') {
+      PrintUsage();
+      return 2;
+    } else if (std::filesystem::is_directory(argv[i])) {
+      for (const auto& path : decoder_replay::ListFixtures(argv[i])) {
+        paths.push_back(path);
+      }
+    } else {
+      paths.emplace_back(argv[i]);
+    }
+  }
+  if (paths.empty() || options.tick_interval_us <= 0) {
+    PrintUsage();
+    return 2;
+  }
+
+  // The report keeps the original stdout; firmware logs go to /dev/null
+  FILE* report = stdout;
+  if (!keep_log) {
+    report = fdopen(dup(fileno(stdout)), "w");
+    if (report == nullptr || std::freopen("/dev/null", "w", stdout) == nullptr) {
+      report = stdout;
+    }
+  }
+
+  std::fprintf(report, "%-22s %4s %-6s %7s %6s %10s %10s %12s\n", "fixture", "wpm", "mode",
+               "CER", "budget", "lat_avg_ms", "lat_max_ms", "events/s");
+  int failures = 0;
+  for (const auto& path : paths) {
+    decoder_replay::Fixture fixture;
+    std::string error;
+    if (!decoder_replay::LoadFixture(path, &fixture, &error)) {
+      std::fprintf(stderr, "error: %s\n", error.c_str());
+      ++failures;
+      continue;
+    }
+    for (const auto mode : modes) {
+      options.mode = mode;
+      const auto result = decoder_replay::Replay(fixture, options);
+      const bool pass = result.cer <= fixture.max_cer;
+      std::fprintf(report, "%-22s %4" PRIu32 " %-6s %6.2f%% %5.1f%% %10.1f %10.1f %12.0f %s\n",
+                  fixture.name.c_str(), fixture.wpm, ModeName(mode), result.cer * 100.0,
+                  fixture.max_cer * 100.0, result.mean_latency_us / 1000.0,
+                  result.max_latency_us / 1000.0, result.events_per_second,
+                  pass ? "" : "FAIL");
+      if (verbose) {
+        std::fprintf(report, "  ref: %s\n  got: %s\n", fixture.text.c_str(), result.decoded.c_str());
+      }
+      if (!pass) {
+        ++failures;
+      }
+    }
+  }
+  std::fflush(report);
+  return failures == 0 ? 0 : 1;
+}
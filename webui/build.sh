@@ -15,4 +15,7 @@ export PATH="$(pwd)/node_modules/.bin:$PATH"
 # Run npm build
 npm run build
 
+# Per-chunk compressed size report; fails the build when a chunk exceeds its budget
+python3 ../scripts/webui/check_bundle_budget.py --dist dist
+
 echo "WebUI build completed successfully"
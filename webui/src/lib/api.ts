@@ -10,10 +10,16 @@ import type {
   DeviceStatus,
   SystemStats,
   KeyerStatus,
+  KeyerMemoryStatus,
+  KeyerMemoryAction,
   RemoteStatus,
   TimelineEventsResponse,
   TimelineConfig,
   DecoderStatus,
+  DecoderStats,
+  So2rStatus,
+  FirmwareInfo,
+  FirmwareUploadResult,
 } from './types';
 
 // Backend API schema format (flat parameter list)
@@ -229,6 +235,30 @@ export class ApiClient {
     return response.json();
   }
 
+  async getKeyerMemory(): Promise<KeyerMemoryStatus> {
+    const response = await fetch(`${this.baseUrl}/api/keyer/memory`);
+    if (!response.ok) {
+      throw new Error(`Failed to fetch paddle memories: ${response.statusText}`);
+    }
+    return response.json();
+  }
+
+  async keyerMemoryAction(
+    action: KeyerMemoryAction,
+    slot?: number,
+    speedPct?: number
+  ): Promise<{ message: string }> {
+    const response = await fetch(`${this.baseUrl}/api/keyer/memory`, {
+      method: 'POST',
+      headers: { 'Content-Type': 'application/json' },
+      body: JSON.stringify({ action, slot, speed_pct: speedPct }),
+    });
+    if (!response.ok) {
+      throw new Error(`Paddle memory ${action} failed: ${response.statusText}`);
+    }
+    return response.json();
+  }
+
   async getRemoteStatus(): Promise<RemoteStatus> {
     const response = await fetch(`${this.baseUrl}/api/remote/status`);
     if (!response.ok) {
@@ -292,6 +322,19 @@ export class ApiClient {
     return response.json();
   }
 
+  /** Binary timeline feed (see lib/timelineFeed.ts for the layout) */
+  async getTimelineFeed(since: number, limit: number = 1024): Promise<ArrayBuffer> {
+    const response = await fetch(
+      `${this.baseUrl}/api/timeline/feed?since=${since}&limit=${limit}`
+    );
+    if (!response.ok) {
+      throw new Error(
+        `Failed to fetch timeline feed: ${response.statusText}`
+      );
+    }
+    return response.arrayBuffer();
+  }
+
   async getTimelineConfig(): Promise<TimelineConfig> {
     const response = await fetch(`${this.baseUrl}/api/timeline/config`);
     if (!response.ok) {
@@ -312,6 +355,14 @@ export class ApiClient {
     return response.json();
   }
 
+  async getDecoderStats(): Promise<DecoderStats> {
+    const response = await fetch(`${this.baseUrl}/api/decoder/stats`);
+    if (!response.ok) {
+      throw new Error(`Failed to fetch decoder stats: ${response.statusText}`);
+    }
+    return response.json();
+  }
+
   async setDecoderEnabled(enabled: boolean): Promise<{ message: string }> {
     const response = await fetch(`${this.baseUrl}/api/decoder/enable`, {
       method: 'POST',
@@ -324,6 +375,26 @@ export class ApiClient {
     return response.json();
   }
 
+  async getSo2rStatus(): Promise<So2rStatus> {
+    const response = await fetch(`${this.baseUrl}/api/so2r`);
+    if (!response.ok) {
+      throw new Error(`Failed to fetch SO2R status: ${response.statusText}`);
+    }
+    return response.json();
+  }
+
+  async setSo2rFocus(channel: number): Promise<{ focus: number }> {
+    const response = await fetch(`${this.baseUrl}/api/so2r/focus`, {
+      method: 'POST',
+      headers: { 'Content-Type': 'application/json' },
+      body: JSON.stringify({ channel }),
+    });
+    if (!response.ok) {
+      throw new Error(`Failed to set SO2R focus: ${response.statusText}`);
+    }
+    return response.json();
+  }
+
   async enterBootloader(): Promise<{ message: string }> {
     const response = await fetch(`${this.baseUrl}/api/enter-bootloader`, {
       method: 'POST',
@@ -336,6 +407,48 @@ export class ApiClient {
     }
     return response.json();
   }
+
+  async getFirmwareInfo(): Promise<FirmwareInfo> {
+    const response = await fetch(`${this.baseUrl}/api/firmware/info`);
+    if (!response.ok) {
+      throw new Error(`Failed to get firmware info: ${response.statusText}`);
+    }
+    return response.json();
+  }
+
+  /**
+   * Stream a firmware image (.bin) to the inactive OTA partition.
+   * XMLHttpRequest rather than fetch for upload progress events.
+   */
+  uploadFirmware(
+    image: Blob,
+    sha256: string | null,
+    onProgress?: (sentBytes: number, totalBytes: number) => void
+  ): Promise<FirmwareUploadResult> {
+    return new Promise((resolve, reject) => {
+      const xhr = new XMLHttpRequest();
+      const query = sha256 ? `?sha256=${encodeURIComponent(sha256)}` : '';
+      xhr.open('POST', `${this.baseUrl}/api/firmware/upload${query}`);
+      xhr.setRequestHeader('Content-Type', 'application/octet-stream');
+      xhr.upload.onprogress = (event) => onProgress?.(event.loaded, event.total);
+      xhr.onerror = () => reject(new Error('Network error during upload'));
+      xhr.onload = () => {
+        let result: FirmwareUploadResult;
+        try {
+          result = JSON.parse(xhr.responseText);
+        } catch {
+          reject(new Error(xhr.statusText || 'Invalid response'));
+          return;
+        }
+        if (xhr.status >= 200 && xhr.status < 300 && result.success) {
+          resolve(result);
+        } else {
+          reject(new Error(result.message || xhr.statusText));
+        }
+      };
+      xhr.send(image);
+    });
+  }
 }
 
 // Default instance using relative URLs (same origin)
@@ -0,0 +1,105 @@
+// Decoder for the binary timeline feed (GET /api/timeline/feed).
+// Layout mirrors components/timeline/include/timeline/timeline_feed.hpp:
+//   header (32 bytes): u32 magic "TLB1", u16 version, u16 count, i64 base_us,
+//                      i64 server_time_us, u32 dropped_count, u32 reserved
+//   record (8 bytes):  u32 delta_us, u8 type, u8 arg1, u16 arg0
+// All fields little-endian.
+
+export const TIMELINE_FEED_MAGIC = 0x31424c54;
+export const TIMELINE_FEED_VERSION = 1;
+export const TIMELINE_FEED_HEADER_BYTES = 32;
+export const TIMELINE_FEED_RECORD_BYTES = 8;
+
+/** Device event type codes (timeline::EventType) */
+export const EventCode = {
+  PaddleEdge: 0,
+  RemoteEvent: 1,
+  Diagnostics: 2,
+  Audio: 3,
+  Keying: 4,
+  MemoryWindow: 5,
+  Latch: 6,
+  Squeeze: 7,
+  GapMarker: 8,
+  DecodedChar: 9,
+  Focus: 10,
+} as const;
+
+/** JSON type names (/api/timeline/events) to codes */
+export const EVENT_CODE_BY_NAME: Record<string, number> = {
+  paddle_edge: EventCode.PaddleEdge,
+  remote_event: EventCode.RemoteEvent,
+  diagnostics: EventCode.Diagnostics,
+  audio: EventCode.Audio,
+  keying: EventCode.Keying,
+  memory_window: EventCode.MemoryWindow,
+  latch: EventCode.Latch,
+  squeeze: EventCode.Squeeze,
+  gap_marker: EventCode.GapMarker,
+  decoded_char: EventCode.DecodedChar,
+  focus: EventCode.Focus,
+};
+
+export interface TimelineFeedPage {
+  count: number;
+  serverTimeUs: number;
+  droppedCount: number;
+  /** Timestamp of the last record (0 when the page is empty) */
+  lastTimestampUs: number;
+}
+
+export type TimelineEventSink = (
+  timestampUs: number,
+  type: number,
+  arg0: number,
+  arg1: number
+) => void;
+
+// i64 as a JS number: exact for timestamps below 2^53 µs (285 years of uptime)
+function readInt64(view: DataView, offset: number): number {
+  return view.getUint32(offset, true) + view.getInt32(offset + 4, true) * 0x100000000;
+}
+
+/**
+ * Decode one feed page, passing every record to sink in order.
+ * Throws on a malformed page (wrong magic/version or truncated records).
+ */
+export function decodeTimelineFeed(
+  buffer: ArrayBuffer,
+  sink: TimelineEventSink
+): TimelineFeedPage {
+  if (buffer.byteLength < TIMELINE_FEED_HEADER_BYTES) {
+    throw new Error('Timeline feed: truncated header');
+  }
+  const view = new DataView(buffer);
+  if (view.getUint32(0, true) !== TIMELINE_FEED_MAGIC) {
+    throw new Error('Timeline feed: bad magic');
+  }
+  if (view.getUint16(4, true) !== TIMELINE_FEED_VERSION) {
+    throw new Error('Timeline feed: unsupported version');
+  }
+  const count = view.getUint16(6, true);
+  if (buffer.byteLength < TIMELINE_FEED_HEADER_BYTES + count * TIMELINE_FEED_RECORD_BYTES) {
+    throw new Error('Timeline feed: truncated records');
+  }
+
+  const baseUs = readInt64(view, 8);
+  let lastTimestampUs = 0;
+  let offset = TIMELINE_FEED_HEADER_BYTES;
+  for (let i = 0; i < count; i++, offset += TIMELINE_FEED_RECORD_BYTES) {
+    lastTimestampUs = baseUs + view.getUint32(offset, true);
+    sink(
+      lastTimestampUs,
+      view.getUint8(offset + 4),
+      view.getUint16(offset + 6, true),
+      view.getUint8(offset + 5)
+    );
+  }
+
+  return {
+    count,
+    serverTimeUs: readInt64(view, 16),
+    droppedCount: view.getUint32(24, true),
+    lastTimestampUs,
+  };
+}
@@ -0,0 +1,264 @@
+// Canvas renderer for TimelineStore.
+//
+// Only what intersects the viewport is touched: interval tracks start at a binary
+// search and stop at the right edge, points likewise. When one pixel covers more than
+// kSummaryThresholdUs the tracks are drawn from the occupancy summaries (one bar per
+// bucket, height = duty cycle) and per-element annotations are skipped, so the cost
+// of a frame is bounded by the canvas width rather than by the capture length.
+
+import { EventCode } from './timelineFeed';
+import { SUMMARY_BUCKETS_US, Track, TimelineStore } from './timelineStore';
+
+export interface TimelineRenderOptions {
+  showMemoryWindow: boolean;
+  showLatch: boolean;
+  showSqueeze: boolean;
+  showGapMarkers: boolean;
+  alignDecodedText: boolean;
+}
+
+export interface TimelineViewport {
+  startUs: number;
+  endUs: number;
+}
+
+const kSummaryThresholdUs = 20_000;  // 20 ms per pixel (views longer than ~24 s)
+const kTrackLabels = ['DOT', 'DASH', 'OUT', 'LOGIC'];
+const kTrackColors: Record<number, string> = {
+  [Track.DitPaddle]: '#4169E1',
+  [Track.DahPaddle]: '#DC143C',
+  [Track.KeyOut]: '#32CD32',
+  [Track.DitMemory]: 'rgba(255, 255, 0, 0.2)',
+  [Track.DahMemory]: 'rgba(255, 136, 0, 0.2)',
+  [Track.Latch]: 'rgba(76, 175, 80, 0.15)',
+};
+// Decoded text colour by source (arg1): local, remote client, remote server
+const kSourceColors = ['#000', '#2980b9', '#8e44ad'];
+
+export class TimelineRenderer {
+  private readonly ctx: CanvasRenderingContext2D;
+  private readonly width: number;
+  private readonly height: number;
+  private readonly trackHeight: number;
+
+  constructor(canvas: HTMLCanvasElement, trackHeight: number) {
+    const ctx = canvas.getContext('2d');
+    if (!ctx) {
+      throw new Error('Canvas 2D context unavailable');
+    }
+    this.ctx = ctx;
+    this.width = canvas.width;
+    this.height = canvas.height;
+    this.trackHeight = trackHeight;
+  }
+
+  render(
+    store: TimelineStore,
+    view: TimelineViewport,
+    wpm: number,
+    options: TimelineRenderOptions
+  ): void {
+    const ctx = this.ctx;
+    const spanUs = Math.max(1, view.endUs - view.startUs);
+    const usPerPx = spanUs / this.width;
+    const toX = (ts: number) => ((ts - view.startUs) / spanUs) * this.width;
+    const summary = usPerPx >= kSummaryThresholdUs;
+
+    ctx.clearRect(0, 0, this.width, this.height);
+    this.drawGrid(view, usPerPx, wpm);
+    this.drawTrackBackgrounds();
+
+    const rows: [number, number][] = [
+      [Track.DitPaddle, 0],
+      [Track.DahPaddle, 1],
+      [Track.KeyOut, 2],
+    ];
+    if (options.showMemoryWindow) {
+      rows.push([Track.DitMemory, 3], [Track.DahMemory, 3]);
+    }
+    if (options.showLatch) {
+      rows.push([Track.Latch, 3]);
+    }
+    for (const [track, row] of rows) {
+      if (summary) {
+        this.drawSummary(store, track, row, view, usPerPx);
+      } else {
+        this.drawIntervals(store, track, row, view, toX);
+      }
+    }
+
+    this.drawPoints(store, view, toX, summary, options);
+  }
+
+  private drawGrid(view: TimelineViewport, usPerPx: number, wpm: number): void {
+    const ctx = this.ctx;
+    const ditUs = 1_200_000 / Math.max(1, wpm);
+    // Dit grid while dits are at least 4 px apart, otherwise a 1-2-5 time grid
+    let stepUs = ditUs;
+    if (ditUs / usPerPx < 4) {
+      const target = usPerPx * 80;
+      const magnitude = Math.pow(10, Math.floor(Math.log10(target)));
+      stepUs = [1, 2, 5, 10].map((m) => m * magnitude).find((s) => s >= target) ?? target;
+    }
+    const ditGrid = stepUs === ditUs;
+
+    const firstStep = Math.ceil(view.startUs / stepUs);
+    for (let n = firstStep; n * stepUs <= view.endUs; n++) {
+      const x = (n * stepUs - view.startUs) / usPerPx;
+      if (ditGrid && n % 7 === 0) {
+        ctx.strokeStyle = '#a0a0a0';
+        ctx.lineWidth = 2;
+      } else if (ditGrid && n % 3 === 0) {
+        ctx.strokeStyle = '#c0c0c0';
+        ctx.lineWidth = 1;
+      } else {
+        ctx.strokeStyle = '#e0e0e0';
+        ctx.lineWidth = ditGrid ? 0.5 : 1;
+      }
+      ctx.beginPath();
+      ctx.moveTo(x, 0);
+      ctx.lineTo(x, this.height);
+      ctx.stroke();
+    }
+  }
+
+  private drawTrackBackgrounds(): void {
+    const ctx = this.ctx;
+    ctx.globalAlpha = 0.5;
+    ctx.fillStyle = '#f5f5f5';
+    for (let row = 0; row < kTrackLabels.length; row++) {
+      ctx.fillRect(0, row * this.trackHeight, this.width, this.trackHeight);
+    }
+    ctx.globalAlpha = 1.0;
+    ctx.font = 'bold 14px Arial';
+    ctx.fillStyle = '#000';
+    ctx.textBaseline = 'alphabetic';
+    kTrackLabels.forEach((label, row) => ctx.fillText(label, 10, row * this.trackHeight + 20));
+  }
+
+  private drawIntervals(
+    store: TimelineStore,
+    track: number,
+    row: number,
+    view: TimelineViewport,
+    toX: (ts: number) => number
+  ): void {
+    const ctx = this.ctx;
+    const ring = store.intervals[track];
+    const y = row * this.trackHeight;
+    ctx.fillStyle = kTrackColors[track];
+
+    for (let i = ring.firstEndingAfter(view.startUs); i < ring.total; i++) {
+      const start = ring.start(i);
+      if (start > view.endUs) {
+        break;
+      }
+      const x1 = Math.max(0, toX(start));
+      const x2 = Math.min(this.width, toX(ring.end(i)));
+      ctx.fillRect(x1, y, Math.max(x2 - x1, 1), this.trackHeight);
+    }
+
+    // Still pressed / open: extend to the right edge of the data
+    const open = store.openStarts[track];
+    if (!Number.isNaN(open) && open <= view.endUs) {
+      const x1 = Math.max(0, toX(open));
+      const x2 = Math.min(this.width, toX(Math.min(view.endUs, store.lastTimestampUs)));
+      if (x2 > x1) {
+        ctx.fillRect(x1, y, x2 - x1, this.trackHeight);
+      }
+    }
+  }
+
+  private drawSummary(
+    store: TimelineStore,
+    track: number,
+    row: number,
+    view: TimelineViewport,
+    usPerPx: number
+  ): void {
+    const ctx = this.ctx;
+    // Finest level whose buckets are at least one pixel wide
+    let level = SUMMARY_BUCKETS_US.findIndex((us) => us >= usPerPx);
+    if (level < 0) {
+      level = SUMMARY_BUCKETS_US.length - 1;
+    }
+    const summary = store.summaries[track][level];
+    const bucketUs = summary.bucketUs;
+    const bucketPx = bucketUs / usPerPx;
+    const y = row * this.trackHeight;
+    ctx.fillStyle = kTrackColors[track];
+
+    const first = Math.floor(view.startUs / bucketUs);
+    const last = Math.floor(view.endUs / bucketUs);
+    for (let bucket = first; bucket <= last; bucket++) {
+      const fraction = Math.min(1, summary.fraction(bucket));
+      if (fraction <= 0) {
+        continue;
+      }
+      const x = (bucket * bucketUs - view.startUs) / usPerPx;
+      const h = Math.max(1, fraction * this.trackHeight);
+      ctx.fillRect(x, y + this.trackHeight - h, Math.max(bucketPx, 1), h);
+    }
+  }
+
+  private drawPoints(
+    store: TimelineStore,
+    view: TimelineViewport,
+    toX: (ts: number) => number,
+    summary: boolean,
+    options: TimelineRenderOptions
+  ): void {
+    const ctx = this.ctx;
+    const points = store.points;
+    const logicY = this.trackHeight * 3;
+    const textY = this.trackHeight * 4 + 10;
+    let lastSqueezeX = -1;
+    let lastTextX = -1000;
+
+    ctx.textBaseline = 'top';
+    for (let i = points.lowerBound(view.startUs); i < points.total; i++) {
+      const slot = points.slot(i);
+      const ts = points.timestamps[slot];
+      if (ts > view.endUs) {
+        break;
+      }
+      const x = toX(ts);
+      const type = points.types[slot];
+      const arg0 = points.arg0[slot];
+      const arg1 = points.arg1[slot];
+
+      if (type === EventCode.Squeeze && options.showSqueeze) {
+        // At most one symbol per pixel column when zoomed out
+        if (Math.floor(x) !== lastSqueezeX) {
+          lastSqueezeX = Math.floor(x);
+          ctx.font = '24px Arial';
+          ctx.fillStyle = '#FFD700';
+          ctx.fillText('⚡', x - 12, this.trackHeight - 29);
+        }
+      } else if (summary) {
+        continue;  // Per-element annotations are unreadable below 20 ms/px
+      } else if (type === EventCode.Latch && options.showLatch && arg1 === 1) {
+        ctx.font = '18px Arial';
+        ctx.fillStyle = '#4CAF50';
+        ctx.fillText('🔒', x - 9, logicY + this.trackHeight / 2 - 11);
+      } else if (type === EventCode.GapMarker && options.showGapMarkers && arg1 === 0) {
+        // Gap markers of the local key stream (arg1 = source, 0 = local)
+        ctx.strokeStyle = arg0 === 2 ? '#CC0000' : arg0 === 1 ? '#FF0000' : '#FF6666';
+        ctx.lineWidth = arg0 + 1;
+        ctx.globalAlpha = 0.6;
+        ctx.beginPath();
+        ctx.moveTo(x, 0);
+        ctx.lineTo(x, this.height);
+        ctx.stroke();
+        ctx.globalAlpha = 1.0;
+      } else if (type === EventCode.DecodedChar && options.alignDecodedText) {
+        const char = String.fromCharCode(arg0);
+        ctx.font = '16px "Courier New", monospace';
+        ctx.fillStyle = kSourceColors[arg1] ?? '#000';
+        ctx.fillText(char, x, textY + (x - lastTextX < 10 ? 20 : 0));
+        lastTextX = x + ctx.measureText(char).width;
+      }
+    }
+    ctx.textBaseline = 'alphabetic';
+  }
+}
@@ -0,0 +1,114 @@
+import { describe, it, expect } from 'vitest';
+import { OccupancySummary, TimelineStore, Track } from './timelineStore';
+import { EventCode, TIMELINE_FEED_MAGIC, decodeTimelineFeed } from './timelineFeed';
+
+describe('TimelineStore', () => {
+  it('pairs on/off edges into per-track intervals', () => {
+    const store = new TimelineStore({ intervalCapacity: 8, pointCapacity: 8 });
+    store.append(1000, EventCode.PaddleEdge, 0, 1);
+    store.append(61000, EventCode.PaddleEdge, 0, 0);
+    store.append(100000, EventCode.Keying, 0, 1);
+    store.append(280000, EventCode.Keying, 1, 0);
+    store.append(300000, EventCode.DecodedChar, 75, 0);
+
+    const dit = store.intervals[Track.DitPaddle];
+    expect(dit.total).toBe(1);
+    expect(dit.start(0)).toBe(1000);
+    expect(dit.end(0)).toBe(61000);
+    expect(store.intervals[Track.KeyOut].end(0)).toBe(280000);
+    expect(store.points.total).toBe(1);
+    expect(store.lastTimestampUs).toBe(300000);
+  });
+
+  it('keeps only the newest intervals and culls with binary search', () => {
+    const store = new TimelineStore({ intervalCapacity: 4 });
+    for (let i = 0; i < 10; i++) {
+      store.append(i * 200000, EventCode.Keying, 0, 1);
+      store.append(i * 200000 + 100000, EventCode.Keying, 0, 0);
+    }
+    const ring = store.intervals[Track.KeyOut];
+    expect(ring.first).toBe(6);
+    const index = ring.firstEndingAfter(1_450_000);
+    expect(ring.start(index)).toBe(1_400_000);
+  });
+
+  it('accumulates occupancy summaries', () => {
+    const summary = new OccupancySummary(1000, 5000);
+    summary.add(500, 2500);
+    expect(summary.fraction(0)).toBeCloseTo(0.5);
+    expect(summary.fraction(1)).toBeCloseTo(1);
+    expect(summary.fraction(2)).toBeCloseTo(0.5);
+
+    // Far ahead: old buckets fall out of the retained span
+    summary.add(100000, 100500);
+    expect(summary.fraction(1)).toBe(0);
+    expect(summary.fraction(100)).toBeCloseTo(0.5);
+  });
+
+  it('strips the SO2R input set from paddle edges', () => {
+    const store = new TimelineStore({ intervalCapacity: 8, pointCapacity: 8 });
+    store.append(1000, EventCode.PaddleEdge, (1 << 8) | 1, 1);
+    store.append(2000, EventCode.PaddleEdge, (1 << 8) | 1, 0);
+    store.append(3000, EventCode.PaddleEdge, (2 << 8) | 2, 1);
+
+    expect(store.intervals[Track.DahPaddle].total).toBe(1);
+    expect(store.intervals[Track.DitPaddle].total).toBe(0);
+  });
+
+  it('maps JSON events by type name', () => {
+    const store = new TimelineStore({ intervalCapacity: 8, pointCapacity: 8 });
+    store.appendJson([
+      { timestamp_us: 10, type: 'squeeze', arg0: 0, arg1: 1 },
+      { timestamp_us: 20, type: 'bogus', arg0: 0, arg1: 0 },
+    ]);
+    expect(store.points.total).toBe(1);
+    expect(store.points.types[0]).toBe(EventCode.Squeeze);
+  });
+});
+
+describe('decodeTimelineFeed', () => {
+  function page(records: [number, number, number, number][]): ArrayBuffer {
+    const buffer = new ArrayBuffer(32 + records.length * 8);
+    const view = new DataView(buffer);
+    view.setUint32(0, TIMELINE_FEED_MAGIC, true);
+    view.setUint16(4, 1, true);
+    view.setUint16(6, records.length, true);
+    view.setUint32(8, 705032704, true); // base_us = 5e9
+    view.setInt32(12, 1, true);
+    view.setUint32(16, 705132704, true); // server_time_us = 5e9 + 1e5
+    view.setInt32(20, 1, true);
+    view.setUint32(24, 3, true);
+    records.forEach(([delta, type, arg0, arg1], i) => {
+      view.setUint32(32 + i * 8, delta, true);
+      view.setUint8(36 + i * 8, type);
+      view.setUint8(37 + i * 8, arg1);
+      view.setUint16(38 + i * 8, arg0, true);
+    });
+    return buffer;
+  }
+
+  it('decodes header and records', () => {
+    const events: number[][] = [];
+    const result = decodeTimelineFeed(
+      page([
+        [0, EventCode.PaddleEdge, 1, 1],
+        [60000, EventCode.DecodedChar, 75, 2],
+      ]),
+      (...event) => events.push(event)
+    );
+    expect(result.count).toBe(2);
+    expect(result.serverTimeUs).toBe(5_000_100_000);
+    expect(result.droppedCount).toBe(3);
+    expect(result.lastTimestampUs).toBe(5_000_060_000);
+    expect(events).toEqual([
+      [5_000_000_000, EventCode.PaddleEdge, 1, 1],
+      [5_000_060_000, EventCode.DecodedChar, 75, 2],
+    ]);
+  });
+
+  it('rejects malformed pages', () => {
+    expect(() => decodeTimelineFeed(new ArrayBuffer(8), () => {})).toThrow();
+    const truncated = page([[0, 0, 0, 0]]).slice(0, 36);
+    expect(() => decodeTimelineFeed(truncated, () => {})).toThrow();
+  });
+});
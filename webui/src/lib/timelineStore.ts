@@ -0,0 +1,306 @@
+// Typed-array event store for the timeline page.
+//
+// Events are appended once and never copied: on/off pairs (paddles, key output,
+// memory windows, latch) become intervals per track, everything else (squeeze, gap
+// markers, decoded characters, remote edges) goes to a point ring. Every column is a
+// fixed-size ring of typed arrays, so an hour-long capture costs a few MB and no GC.
+//
+// Viewport culling: within one track intervals never overlap, so starts and ends are
+// both sorted and the first visible entry is a binary search away.
+//
+// Zoom: each interval track also keeps occupancy summaries (fraction of time "on"
+// per bucket) at several bucket widths, updated as intervals close. Zoomed far out
+// the renderer draws one bar per bucket instead of thousands of sub-pixel intervals.
+
+import { EventCode, EVENT_CODE_BY_NAME } from './timelineFeed';
+
+export const Track = {
+  DitPaddle: 0,
+  DahPaddle: 1,
+  KeyOut: 2,
+  DitMemory: 3,
+  DahMemory: 4,
+  Latch: 5,
+} as const;
+
+export const TRACK_COUNT = 6;
+
+/** Occupancy summary bucket widths (µs), finest first */
+export const SUMMARY_BUCKETS_US = [100_000, 1_000_000, 10_000_000];
+
+/** Default retention: > 1 h of fast keying on every ring */
+const DEFAULT_INTERVAL_CAPACITY = 1 << 17;
+const DEFAULT_POINT_CAPACITY = 1 << 17;
+const DEFAULT_SUMMARY_SPAN_US = 2 * 3600 * 1_000_000;
+
+/** Fixed-capacity ring of [start, end] intervals with sorted starts and ends */
+export class IntervalRing {
+  readonly capacity: number;
+  readonly starts: Float64Array;
+  readonly ends: Float64Array;
+  /** Intervals ever pushed; logical index i lives at slot i % capacity */
+  total = 0;
+
+  constructor(capacity: number) {
+    this.capacity = capacity;
+    this.starts = new Float64Array(capacity);
+    this.ends = new Float64Array(capacity);
+  }
+
+  get first(): number {
+    return Math.max(0, this.total - this.capacity);
+  }
+
+  push(start: number, end: number): void {
+    const slot = this.total % this.capacity;
+    this.starts[slot] = start;
+    this.ends[slot] = end;
+    this.total++;
+  }
+
+  start(index: number): number {
+    return this.starts[index % this.capacity];
+  }
+
+  end(index: number): number {
+    return this.ends[index % this.capacity];
+  }
+
+  /** First logical index whose interval ends at or after timeUs */
+  firstEndingAfter(timeUs: number): number {
+    let lo = this.first;
+    let hi = this.total;
+    while (lo < hi) {
+      const mid = (lo + hi) >>> 1;
+      if (this.end(mid) < timeUs) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    return lo;
+  }
+
+  clear(): void {
+    this.total = 0;
+  }
+}
+
+/** Ring of per-bucket "on" time for one bucket width */
+export class OccupancySummary {
+  readonly bucketUs: number;
+  private readonly values: Float32Array;
+  private newest = -1;
+
+  constructor(bucketUs: number, spanUs: number) {
+    this.bucketUs = bucketUs;
+    this.values = new Float32Array(Math.ceil(spanUs / bucketUs) + 1);
+  }
+
+  /** Add the on-time of [startUs, endUs) to the buckets it overlaps */
+  add(startUs: number, endUs: number): void {
+    const capacity = this.values.length;
+    let bucket = Math.floor(startUs / this.bucketUs);
+    const last = Math.floor(Math.max(startUs, endUs - 1) / this.bucketUs);
+    this.advance(last);
+    bucket = Math.max(bucket, this.newest - capacity + 1);
+    for (; bucket <= last; bucket++) {
+      const from = Math.max(startUs, bucket * this.bucketUs);
+      const to = Math.min(endUs, (bucket + 1) * this.bucketUs);
+      if (to > from) {
+        this.values[bucket % capacity] += to - from;
+      }
+    }
+  }
+
+  /** Fraction (0-1) of the bucket that was on; 0 outside the retained span */
+  fraction(bucket: number): number {
+    const capacity = this.values.length;
+    if (bucket > this.newest || bucket <= this.newest - capacity || bucket < 0) {
+      return 0;
+    }
+    return this.values[bucket % capacity] / this.bucketUs;
+  }
+
+  clear(): void {
+    this.values.fill(0);
+    this.newest = -1;
+  }
+
+  // Start a new newest bucket, zeroing the slots it recycles
+  private advance(bucket: number): void {
+    if (bucket <= this.newest) {
+      return;
+    }
+    const capacity = this.values.length;
+    const from = Math.max(this.newest + 1, bucket - capacity + 1);
+    for (let b = from; b <= bucket; b++) {
+      this.values[b % capacity] = 0;
+    }
+    this.newest = bucket;
+  }
+}
+
+/** Fixed-capacity ring of point events sorted by time */
+export class PointRing {
+  readonly capacity: number;
+  readonly timestamps: Float64Array;
+  readonly types: Uint8Array;
+  readonly arg0: Uint16Array;
+  readonly arg1: Uint8Array;
+  total = 0;
+
+  constructor(capacity: number) {
+    this.capacity = capacity;
+    this.timestamps = new Float64Array(capacity);
+    this.types = new Uint8Array(capacity);
+    this.arg0 = new Uint16Array(capacity);
+    this.arg1 = new Uint8Array(capacity);
+  }
+
+  get first(): number {
+    return Math.max(0, this.total - this.capacity);
+  }
+
+  push(timestampUs: number, type: number, arg0: number, arg1: number): void {
+    const slot = this.total % this.capacity;
+    this.timestamps[slot] = timestampUs;
+    this.types[slot] = type;
+    this.arg0[slot] = arg0;
+    this.arg1[slot] = arg1;
+    this.total++;
+  }
+
+  slot(index: number): number {
+    return index % this.capacity;
+  }
+
+  /** First logical index at or after timeUs */
+  lowerBound(timeUs: number): number {
+    let lo = this.first;
+    let hi = this.total;
+    while (lo < hi) {
+      const mid = (lo + hi) >>> 1;
+      if (this.timestamps[mid % this.capacity] < timeUs) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    return lo;
+  }
+
+  clear(): void {
+    this.total = 0;
+  }
+}
+
+export interface TimelineStoreOptions {
+  intervalCapacity?: number;
+  pointCapacity?: number;
+  summarySpanUs?: number;
+}
+
+export class TimelineStore {
+  readonly intervals: IntervalRing[] = [];
+  readonly summaries: OccupancySummary[][] = [];
+  readonly points: PointRing;
+  /** Start of the interval currently open on each track (NaN when off) */
+  readonly openStarts = new Float64Array(TRACK_COUNT).fill(NaN);
+  firstTimestampUs = NaN;
+  lastTimestampUs = 0;
+  /** Incremented on every change; renderers compare it to skip redundant frames */
+  revision = 0;
+
+  constructor(options: TimelineStoreOptions = {}) {
+    const intervalCapacity = options.intervalCapacity ?? DEFAULT_INTERVAL_CAPACITY;
+    const summarySpanUs = options.summarySpanUs ?? DEFAULT_SUMMARY_SPAN_US;
+    for (let track = 0; track < TRACK_COUNT; track++) {
+      this.intervals.push(new IntervalRing(intervalCapacity));
+      this.summaries.push(SUMMARY_BUCKETS_US.map((us) => new OccupancySummary(us, summarySpanUs)));
+    }
+    this.points = new PointRing(options.pointCapacity ?? DEFAULT_POINT_CAPACITY);
+  }
+
+  /** Append one device event (events must arrive in timestamp order) */
+  append(timestampUs: number, type: number, arg0: number, arg1: number): void {
+    if (Number.isNaN(this.firstTimestampUs)) {
+      this.firstTimestampUs = timestampUs;
+    }
+    this.lastTimestampUs = Math.max(this.lastTimestampUs, timestampUs);
+    this.revision++;
+
+    switch (type) {
+      case EventCode.PaddleEdge: {
+        // Low byte = line, high byte = SO2R input set. Straight key input (line 2)
+        // has no paddle track; it shows up on KeyOut
+        const line = arg0 & 0xff;
+        if (line <= 1) {
+          this.edge(line === 1 ? Track.DahPaddle : Track.DitPaddle, arg1 === 1, timestampUs);
+        }
+        break;
+      }
+      case EventCode.Keying:
+        // Dit and dah elements share the single TX output track
+        this.edge(Track.KeyOut, arg1 === 1, timestampUs);
+        break;
+      case EventCode.MemoryWindow:
+        this.edge(arg0 === 1 ? Track.DahMemory : Track.DitMemory, arg1 === 1, timestampUs);
+        break;
+      case EventCode.Latch:
+        this.edge(Track.Latch, arg1 === 1, timestampUs);
+        this.points.push(timestampUs, type, arg0, arg1);
+        break;
+      default:
+        this.points.push(timestampUs, type, arg0, arg1);
+        break;
+    }
+  }
+
+  /** Append events in the JSON shape of /api/timeline/events */
+  appendJson(events: { timestamp_us: number; type: string; arg0: number; arg1: number }[]): void {
+    for (const evt of events) {
+      const code = EVENT_CODE_BY_NAME[evt.type];
+      if (code !== undefined) {
+        this.append(evt.timestamp_us, code, evt.arg0, evt.arg1);
+      }
+    }
+  }
+
+  /** Number of retained point events plus closed intervals */
+  get size(): number {
+    let size = this.points.total - this.points.first;
+    for (const ring of this.intervals) {
+      size += ring.total - ring.first;
+    }
+    return size;
+  }
+
+  clear(): void {
+    for (const ring of this.intervals) ring.clear();
+    for (const levels of this.summaries) for (const level of levels) level.clear();
+    this.points.clear();
+    this.openStarts.fill(NaN);
+    this.firstTimestampUs = NaN;
+    this.lastTimestampUs = 0;
+    this.revision++;
+  }
+
+  private edge(track: number, on: boolean, timestampUs: number): void {
+    const open = this.openStarts[track];
+    if (on) {
+      if (Number.isNaN(open)) {
+        this.openStarts[track] = timestampUs;
+      }
+      return;
+    }
+    if (Number.isNaN(open)) {
+      return;  // Release without a press (capture started mid-element)
+    }
+    this.openStarts[track] = NaN;
+    this.intervals[track].push(open, timestampUs);
+    for (const level of this.summaries[track]) {
+      level.add(open, timestampUs);
+    }
+  }
+}
@@ -108,6 +108,21 @@ export interface KeyerStatus {
   total: number;
 }
 
+// Paddle memories (recorded key edge streams, one per message slot 1-10)
+export interface KeyerMemorySlot {
+  slot: number;
+  bytes: number;
+  edges: number;
+  duration_ms: number;
+}
+
+export interface KeyerMemoryStatus {
+  state: 'idle' | 'recording' | 'playing';
+  slots: KeyerMemorySlot[];
+}
+
+export type KeyerMemoryAction = 'record' | 'save' | 'play' | 'stop' | 'erase';
+
 // Remote CW API types
 export interface RemoteClientStatus {
   state: number; // 0=Idle, 1=Resolving, 2=Connecting, 3=Handshake, 4=Connected, 5=Error
@@ -157,9 +172,77 @@ export interface TimelineConfig {
 }
 
 // Decoder API types
+export type DecoderSource = 'local' | 'remote_client' | 'remote_server';
+
+export interface DecoderStream {
+  source: DecoderSource;
+  active: boolean; // any key edge received since boot
+  wpm: number;
+  pattern: string;
+  text: string;
+}
+
 export interface DecoderStatus {
   enabled: boolean;
   wpm: number;
   pattern: string;
   text: string;
+  streams?: DecoderStream[]; // every key stream (local first)
+}
+
+/** Per element class: [count, mean, stddev, p10, p50, p90] (durations in µs) */
+export type FistClassStats = [number, number, number, number, number, number];
+
+export interface DecoderStats {
+  ratio: number; // dah/dit (3.0 nominal)
+  weight: number; // % (50 nominal)
+  jitter: number; // mark CV %
+  gap_jitter: number; // intra/char gap CV %
+  char_gap: number; // dit units (3 nominal)
+  word_gap: number; // dit units (7 nominal)
+  wpm: number; // session speed
+  window_wpm: number; // recent speed
+  drift: number; // % (positive = speeding up)
+  window: number; // marks in the rolling window
+  dit: FistClassStats;
+  dah: FistClassStats;
+  intra: FistClassStats;
+  char: FistClassStats;
+  word: FistClassStats;
+}
+
+// SO2R API types
+export interface So2rChannel {
+  channel: number; // 0-based radio index
+  key_active: boolean;
+  speed_wpm: number;
+}
+
+export interface So2rStatus {
+  channel_count: number;
+  focus: number; // 0-based radio the main paddle drives
+  channels: So2rChannel[];
+}
+
+// Firmware OTA types
+export interface FirmwareInfo {
+  version: string;
+  running_partition: string;
+  ota_available: boolean;
+  update_partition?: string;
+  max_image_size?: number;
+  pending_verify: boolean;
+  update_in_progress: boolean;
+}
+
+export interface FirmwareUploadResult {
+  success: boolean;
+  message: string;
+  partition: string;
+  bytes: number;
+  duration_ms: number;
+  throughput_kbps: number;
+  heap_peak_bytes: number;
+  sha256: string;
+  restarting: boolean;
 }